@@ -96,6 +96,13 @@ def cpp_repositories():
         urls = ["https://github.com/google/googletest/archive/609281088cfefc76f9d0ce82e1ff6c30cc3591e5.zip"],
     )
 
+    git_repository(
+        name = "com_github_google_benchmark",
+        # v1.6.1
+        commit = "0d98dba29d66e93259db7daa53a9327df767a415",
+        remote = "https://github.com/google/benchmark.git",
+    )
+
     http_archive(
         name = "sentry_native",
         build_file = "//bazel/external:sentry_native.BUILD",
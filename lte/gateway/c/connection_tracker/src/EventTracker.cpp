@@ -14,13 +14,19 @@
 #include "lte/gateway/c/connection_tracker/src/EventTracker.hpp"
 
 #include <arpa/inet.h>
+#include <errno.h>
 #include <glog/logging.h>
 #include <libmnl/libmnl.h>
+#include <linux/filter.h>
 #include <linux/netfilter/nfnetlink_compat.h>
 #include <linux/netlink.h>
 #include <netinet/in.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <linux/netfilter/nfnetlink.h>
 #include <linux/netfilter/nfnetlink_conntrack.h>
@@ -28,14 +34,104 @@
 
 #include "lte/gateway/c/connection_tracker/src/PacketGenerator.hpp"
 #include "orc8r/gateway/c/common/logging/magma_logging.hpp"
+#include "orc8r/gateway/c/common/service303/MetricsHelpers.hpp"
+
+#define NETLINK_OVERRUN_COUNTER "connectiond_netlink_overruns"
+#define PACKETS_SENT_COUNTER "connectiond_packets_sent"
+#define PACKETS_DROPPED_COUNTER "connectiond_packets_dropped"
+// Time from reading the first event of a batch to sending its packets. The
+// time the event spent queued in the netlink socket is not included.
+#define EMIT_LATENCY_HISTOGRAM "connectiond_recv_to_emit_latency_us"
+#define LABEL_REASON "reason"
 
 static int data_cb(const struct nlmsghdr* nlh, void* data);
 
 namespace magma {
 namespace lte {
 
-EventTracker::EventTracker(std::shared_ptr<PacketGenerator> pkt_gen, int zone)
-    : pkt_gen_(pkt_gen), zone_(zone) {}
+EventTracker::EventTracker(std::shared_ptr<PacketGenerator> pkt_gen, int zone,
+                           size_t rcvbuf_bytes)
+    : pkt_gen_(pkt_gen),
+      zone_(zone),
+      rcvbuf_bytes_(rcvbuf_bytes),
+      reported_sent_(0),
+      reported_errors_(0) {}
+
+void EventTracker::set_rcvbuf(struct mnl_socket* nl, size_t bytes) {
+  int fd = mnl_socket_get_fd(nl);
+  int size = bytes;
+  // SO_RCVBUFFORCE ignores net.core.rmem_max but needs CAP_NET_ADMIN
+  if (setsockopt(fd, SOL_SOCKET, SO_RCVBUFFORCE, &size, sizeof(size)) < 0 &&
+      setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size)) < 0) {
+    MLOG(MERROR) << "Could not set netlink receive buffer to " << bytes
+                 << " bytes: " << strerror(errno);
+    return;
+  }
+  rcvbuf_bytes_ = bytes;
+  MLOG(MINFO) << "Netlink receive buffer set to " << bytes << " bytes";
+}
+
+bool EventTracker::attach_zone_filter(struct mnl_socket* nl) {
+  // Classic BPF runs on each event before it is queued on the socket. The
+  // SKF_AD_NLATTR extension looks up the CTA_ZONE attribute, whose value is
+  // loaded in host order by the 16 bit load.
+  struct sock_filter code[] = {
+      // A = offset of the first attribute, X = attribute type to find
+      BPF_STMT(BPF_LD | BPF_IMM,
+               NLMSG_LENGTH(0) + NLMSG_ALIGN(sizeof(struct nfgenmsg))),
+      BPF_STMT(BPF_LDX | BPF_IMM, CTA_ZONE),
+      BPF_STMT(BPF_LD | BPF_W | BPF_ABS,
+               (uint32_t)(SKF_AD_OFF + SKF_AD_NLATTR)),
+      BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 3, 0),
+      BPF_STMT(BPF_MISC | BPF_TAX, 0),
+      BPF_STMT(BPF_LD | BPF_H | BPF_IND, NLA_HDRLEN),
+      BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, (uint32_t)zone_, 1, 0),
+      BPF_STMT(BPF_RET | BPF_K, 0),
+      BPF_STMT(BPF_RET | BPF_K, 0xffffffff),
+  };
+  struct sock_fprog filter = {
+      .len = sizeof(code) / sizeof(code[0]),
+      .filter = code,
+  };
+  if (setsockopt(mnl_socket_get_fd(nl), SOL_SOCKET, SO_ATTACH_FILTER, &filter,
+                 sizeof(filter)) < 0) {
+    MLOG(MWARNING) << "Could not attach conntrack zone filter, filtering "
+                   << "in userspace: " << strerror(errno);
+    return false;
+  }
+  return true;
+}
+
+void EventTracker::handle_overrun(struct mnl_socket* nl) {
+  // The kernel dropped events, there is no way to get them back as the
+  // connections are already gone. Make room for the next burst.
+  increment_counter(NETLINK_OVERRUN_COUNTER, 1, size_t(0));
+  MLOG(MWARNING) << "Conntrack events lost, netlink receive buffer of "
+                 << rcvbuf_bytes_ << " bytes overrun";
+  if (rcvbuf_bytes_ < kMaxRcvbufBytes) {
+    set_rcvbuf(nl, std::min(rcvbuf_bytes_ * 2, kMaxRcvbufBytes));
+  }
+}
+
+void EventTracker::emit_packets(double recv_to_emit_us) {
+  pkt_gen_->flush();
+  uint64_t sent = pkt_gen_->packets_sent();
+  uint64_t errors = pkt_gen_->send_errors();
+  if (sent == reported_sent_ && errors == reported_errors_) {
+    return;
+  }
+  if (sent > reported_sent_) {
+    increment_counter(PACKETS_SENT_COUNTER, sent - reported_sent_, size_t(0));
+  }
+  if (errors > reported_errors_) {
+    increment_counter(PACKETS_DROPPED_COUNTER, errors - reported_errors_,
+                      size_t(1), LABEL_REASON, "send_error");
+  }
+  reported_sent_ = sent;
+  reported_errors_ = errors;
+  observe_histogram(EMIT_LATENCY_HISTOGRAM, recv_to_emit_us, size_t(0),
+                    size_t(6), 10., 100., 1000., 10000., 100000., 1000000.);
+}
 
 int EventTracker::init_conntrack_event_loop() {
   struct mnl_socket* nl;
@@ -48,26 +144,50 @@ int EventTracker::init_conntrack_event_loop() {
     exit(EXIT_FAILURE);
   }
 
-  if (mnl_socket_bind(nl,
-                      NF_NETLINK_CONNTRACK_NEW |
-                          // NF_NETLINK_CONNTRACK_UPDATE |
-                          NF_NETLINK_CONNTRACK_DESTROY,
-                      MNL_SOCKET_AUTOPID) < 0) {
+  // Only the destroy events generate packets
+  if (mnl_socket_bind(nl, NF_NETLINK_CONNTRACK_DESTROY, MNL_SOCKET_AUTOPID) <
+      0) {
     perror("mnl_socket_bind");
     exit(EXIT_FAILURE);
   }
+  set_rcvbuf(nl, rcvbuf_bytes_);
+  attach_zone_filter(nl);
+  int fd = mnl_socket_get_fd(nl);
 
   while (1) {
     ret = mnl_socket_recvfrom(nl, buf, sizeof(buf));
     if (ret == -1) {
+      if (errno == ENOBUFS) {
+        handle_overrun(nl);
+        continue;
+      }
+      if (errno == EINTR) {
+        continue;
+      }
       perror("mnl_socket_recvfrom");
       exit(EXIT_FAILURE);
     }
-    ret = mnl_cb_run(buf, ret, 0, 0, data_cb, (void*)this);
-    if (ret == -1) {
-      perror("mnl_cb_run");
-      exit(EXIT_FAILURE);
+    auto batch_start = std::chrono::steady_clock::now();
+
+    // Drain the events already queued without blocking, so that the packets
+    // of a burst go out in as few syscalls as possible
+    while (ret > 0) {
+      if (mnl_cb_run(buf, ret, 0, 0, data_cb, (void*)this) == -1) {
+        perror("mnl_cb_run");
+        exit(EXIT_FAILURE);
+      }
+      if (pkt_gen_->queued() >= pkt_gen_->batch_size()) {
+        break;
+      }
+      ret = recv(fd, buf, sizeof(buf), MSG_DONTWAIT);
+    }
+    if (ret == -1 && errno == ENOBUFS) {
+      handle_overrun(nl);
     }
+
+    emit_packets(std::chrono::duration<double, std::micro>(
+                     std::chrono::steady_clock::now() - batch_start)
+                     .count());
   }
 
   mnl_socket_close(nl);
@@ -149,10 +269,10 @@ static void parse_proto(const struct nlattr* nest,
     flow->l4_proto = mnl_attr_get_u8(tb[CTA_PROTO_NUM]);
   }
   if (tb[CTA_PROTO_SRC_PORT]) {
-    flow->sport = mnl_attr_get_u8(tb[CTA_PROTO_NUM]);
+    flow->sport = mnl_attr_get_u16(tb[CTA_PROTO_SRC_PORT]);
   }
   if (tb[CTA_PROTO_DST_PORT]) {
-    flow->dport = mnl_attr_get_u8(tb[CTA_PROTO_NUM]);
+    flow->dport = mnl_attr_get_u16(tb[CTA_PROTO_DST_PORT]);
   }
 }
 
@@ -222,7 +342,7 @@ static int data_attr_cb(const struct nlattr* attr, void* data) {
 static int data_cb(const struct nlmsghdr* nlh, void* data) {
   struct nlattr* tb[CTA_MAX + 1] = {};
   struct nfgenmsg* nfg = (struct nfgenmsg*)mnl_nlmsg_get_payload(nlh);
-  struct flow_information flow;
+  struct flow_information flow = {};
   struct in_addr src_ip;
   struct in_addr dst_ip;
 
@@ -248,24 +368,27 @@ static int data_cb(const struct nlmsghdr* nlh, void* data) {
   switch (nlh->nlmsg_type & 0xFF) {
     case IPCTNL_MSG_CT_NEW:
       if (nlh->nlmsg_flags & (NLM_F_CREATE | NLM_F_EXCL))
-        MLOG(MINFO) << "     [NEW] src=" << inet_ntoa(src_ip) << ":"
-                    << ntohs(flow.sport) << " dst=" << inet_ntoa(dst_ip) << ":"
-                    << ntohs(flow.dport) << " proto=" << flow.l4_proto;
+        MLOG(MDEBUG) << "     [NEW] src=" << inet_ntoa(src_ip) << ":"
+                     << ntohs(flow.sport) << " dst=" << inet_ntoa(dst_ip)
+                     << ":" << ntohs(flow.dport) << " proto=" << flow.l4_proto;
       else
         printf("%9s ", "[UPDATE] \n");
       break;
     case IPCTNL_MSG_CT_DELETE:
-      MLOG(MINFO) << "[DESTROY] src=" << inet_ntoa(src_ip) << ":"
-                  << ntohs(flow.sport) << " dst=" << inet_ntoa(dst_ip) << ":"
-                  << ntohs(flow.dport) << " proto=" << flow.l4_proto;
+      MLOG(MDEBUG) << "[DESTROY] src=" << inet_ntoa(src_ip) << ":"
+                   << ntohs(flow.sport) << " dst=" << inet_ntoa(dst_ip) << ":"
+                   << ntohs(flow.dport) << " proto=" << flow.l4_proto;
       break;
   }
 
   if (tb[CTA_MARK]) {
-    MLOG(MINFO) << "From zone " << mnl_attr_get_u16(tb[CTA_ZONE]);
+    MLOG(MDEBUG) << "From zone " << mnl_attr_get_u16(tb[CTA_ZONE]);
   }
 
-  ((magma::lte::EventTracker*)data)->pkt_gen_->send_packet(&flow);
+  if (!((magma::lte::EventTracker*)data)->pkt_gen_->queue_packet(&flow)) {
+    increment_counter(PACKETS_DROPPED_COUNTER, 1, size_t(1), LABEL_REASON,
+                      "unsupported_proto");
+  }
 
   return MNL_CB_OK;
 }
@@ -12,22 +12,46 @@
  */
 #pragma once
 
+#include <stddef.h>
+#include <stdint.h>
 #include <memory>
 
 #include "lte/gateway/c/connection_tracker/src/PacketGenerator.hpp"
 
+struct mnl_socket;
+
 namespace magma {
 namespace lte {
 class PacketGenerator;
 
 class EventTracker {
  public:
-  EventTracker(std::shared_ptr<PacketGenerator> pkt_gen, int zone);
+  /**
+   * @param rcvbuf_bytes - netlink socket receive buffer size, it is doubled
+   *                       after each overrun up to kMaxRcvbufBytes
+   */
+  EventTracker(std::shared_ptr<PacketGenerator> pkt_gen, int zone,
+               size_t rcvbuf_bytes = kDefaultRcvbufBytes);
 
   int init_conntrack_event_loop();
 
   std::shared_ptr<PacketGenerator> pkt_gen_;
   int zone_;
+
+  static constexpr size_t kDefaultRcvbufBytes = 8 * 1024 * 1024;
+  static constexpr size_t kMaxRcvbufBytes = 64 * 1024 * 1024;
+
+ private:
+  void set_rcvbuf(struct mnl_socket* nl, size_t bytes);
+  // Drops the events of other zones in the kernel instead of waking us up
+  bool attach_zone_filter(struct mnl_socket* nl);
+  void handle_overrun(struct mnl_socket* nl);
+  void emit_packets(double recv_to_emit_us);
+
+  size_t rcvbuf_bytes_;
+  // PacketGenerator counters already exported
+  uint64_t reported_sent_;
+  uint64_t reported_errors_;
 };
 
 }  // namespace lte
@@ -13,14 +13,17 @@
 
 #include "lte/gateway/c/connection_tracker/src/PacketGenerator.hpp"
 
+#include <arpa/inet.h>
+#include <errno.h>
 #include <glog/logging.h>
-#include <tins/ethernetII.h>
-#include <tins/ip.h>
-#include <tins/ip_address.h>
-#include <tins/packet_sender.h>
-#include <tins/pdu.h>
-#include <tins/tcp.h>
-#include <tins/udp.h>
+#include <linux/if_ether.h>
+#include <netinet/in.h>
+#include <netinet/ip.h>
+#include <netinet/tcp.h>
+#include <netinet/udp.h>
+#include <string.h>
+#include <tins/hw_address.h>
+#include <unistd.h>
 #include <iostream>
 #include <string>
 
@@ -29,45 +32,202 @@
 namespace magma {
 namespace lte {
 
-using Tins::EthernetII;
-using Tins::IP;
-using Tins::IPv4Address;
+using Tins::HWAddress;
 using Tins::NetworkInterface;
-using Tins::PacketSender;
-using Tins::TCP;
-using Tins::UDP;
+
+uint32_t csum_add(uint32_t sum, const void* data, size_t len) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i + 1 < len; i += 2) {
+    sum += (bytes[i] << 8) | bytes[i + 1];
+  }
+  if (len & 1) {
+    sum += bytes[len - 1] << 8;
+  }
+  return sum;
+}
+
+uint16_t csum_fold(uint32_t sum) {
+  while (sum >> 16) {
+    sum = (sum & 0xffff) + (sum >> 16);
+  }
+  return htons(~sum & 0xffff);
+}
+
+namespace {
+
+// Same defaults as the libtins IP and TCP PDUs previously used
+constexpr uint8_t kDefaultTtl = 128;
+constexpr uint16_t kDefaultTcpWindow = 32678;
+
+// Checksum of a TCP or UDP segment, including the IPv4 pseudo header
+uint16_t l4_checksum(const struct iphdr* ip, const void* l4, size_t l4_len) {
+  uint32_t sum = 0;
+  sum = csum_add(sum, &ip->saddr, sizeof(ip->saddr));
+  sum = csum_add(sum, &ip->daddr, sizeof(ip->daddr));
+  sum += ip->protocol;
+  sum += l4_len;
+  return csum_fold(csum_add(sum, l4, l4_len));
+}
+
+}  // namespace
 
 PacketGenerator::PacketGenerator(const std::string& iface_name,
                                  const std::string& pkt_dst_mac,
-                                 const std::string& pkt_src_mac)
+                                 const std::string& pkt_src_mac,
+                                 size_t batch_size)
     : iface_name_(iface_name),
       pkt_dst_mac_(pkt_dst_mac),
-      pkt_src_mac_(pkt_src_mac) {
+      pkt_src_mac_(pkt_src_mac),
+      sock_fd_(-1),
+      frames_(batch_size ? batch_size : kDefaultBatchSize,
+              std::vector<uint8_t>(kFrameSize)),
+      frame_lens_(frames_.size()),
+      iovs_(frames_.size()),
+      msgs_(frames_.size()),
+      queued_(0),
+      packets_sent_(0),
+      send_errors_(0) {
   iface_ = NetworkInterface(iface_name_);
+  build_template(pkt_dst_mac_, pkt_src_mac_);
+  open_socket(pkt_dst_mac_);
   MLOG(MINFO) << "Using interface " << iface_name_.c_str()
-              << " for pkt generation";
+              << " for pkt generation, batches of " << frames_.size()
+              << " packets";
 }
 
-bool PacketGenerator::send_packet(struct flow_information* flow) {
-  PacketSender sender;
+PacketGenerator::~PacketGenerator() {
+  if (sock_fd_ >= 0) {
+    close(sock_fd_);
+  }
+}
 
+void PacketGenerator::build_template(const std::string& pkt_dst_mac,
+                                     const std::string& pkt_src_mac) {
+  memset(template_, 0, sizeof(template_));
   // Random mac header for our internal packets
-  EthernetII eth_(pkt_dst_mac_, pkt_src_mac_);
-  eth_ /= IP(IPv4Address(flow->saddr), IPv4Address(flow->daddr));
+  struct ethhdr* eth = reinterpret_cast<struct ethhdr*>(template_);
+  HWAddress<ETH_ALEN>(pkt_dst_mac).copy(eth->h_dest);
+  HWAddress<ETH_ALEN>(pkt_src_mac).copy(eth->h_source);
+  eth->h_proto = htons(ETH_P_IP);
 
-  if (flow->l4_proto == 6) {
-    eth_ /= TCP(flow->dport, flow->sport);
-  } else if (flow->l4_proto == 17) {
-    eth_ /= UDP(flow->dport, flow->sport);
-  } else {
+  struct iphdr* ip = reinterpret_cast<struct iphdr*>(template_ + ETH_HLEN);
+  ip->version = 4;
+  ip->ihl = sizeof(struct iphdr) / 4;
+  ip->id = htons(1);
+  ip->ttl = kDefaultTtl;
+}
+
+bool PacketGenerator::open_socket(const std::string& pkt_dst_mac) {
+  // Protocol 0: the socket only transmits, it never receives a copy of the
+  // interface traffic
+  sock_fd_ = socket(AF_PACKET, SOCK_RAW, 0);
+  if (sock_fd_ < 0) {
+    MLOG(MERROR) << "Could not open packet socket: " << strerror(errno);
+    return false;
+  }
+  memset(&dst_addr_, 0, sizeof(dst_addr_));
+  dst_addr_.sll_family = AF_PACKET;
+  dst_addr_.sll_protocol = htons(ETH_P_IP);
+  dst_addr_.sll_ifindex = iface_.id();
+  dst_addr_.sll_halen = ETH_ALEN;
+  HWAddress<ETH_ALEN>(pkt_dst_mac).copy(dst_addr_.sll_addr);
+
+  for (size_t i = 0; i < frames_.size(); i++) {
+    iovs_[i].iov_base = frames_[i].data();
+    memset(&msgs_[i], 0, sizeof(msgs_[i]));
+    msgs_[i].msg_hdr.msg_name = &dst_addr_;
+    msgs_[i].msg_hdr.msg_namelen = sizeof(dst_addr_);
+    msgs_[i].msg_hdr.msg_iov = &iovs_[i];
+    msgs_[i].msg_hdr.msg_iovlen = 1;
+  }
+  return true;
+}
+
+bool PacketGenerator::queue_packet(const struct flow_information* flow) {
+  if (flow->l4_proto != IPPROTO_TCP && flow->l4_proto != IPPROTO_UDP) {
     MLOG(MDEBUG) << "Encountered unsupported protocol, not sending pkt";
     return false;
   }
+  if (queued_ == frames_.size()) {
+    flush();
+  }
 
-  sender.send(eth_, iface_);
+  uint8_t* frame = frames_[queued_].data();
+  memcpy(frame, template_, ETH_HLEN + sizeof(struct iphdr));
+  struct iphdr* ip = reinterpret_cast<struct iphdr*>(frame + ETH_HLEN);
+  uint8_t* l4 = frame + ETH_HLEN + sizeof(struct iphdr);
+  size_t l4_len;
 
+  ip->saddr = flow->saddr;
+  ip->daddr = flow->daddr;
+  ip->protocol = flow->l4_proto;
+  if (flow->l4_proto == IPPROTO_TCP) {
+    struct tcphdr* tcp = reinterpret_cast<struct tcphdr*>(l4);
+    l4_len = sizeof(*tcp);
+    memset(tcp, 0, l4_len);
+    tcp->source = flow->sport;
+    tcp->dest = flow->dport;
+    tcp->doff = l4_len / 4;
+    tcp->window = htons(kDefaultTcpWindow);
+    tcp->check = l4_checksum(ip, tcp, l4_len);
+  } else {
+    struct udphdr* udp = reinterpret_cast<struct udphdr*>(l4);
+    l4_len = sizeof(*udp);
+    udp->source = flow->sport;
+    udp->dest = flow->dport;
+    udp->len = htons(l4_len);
+    udp->check = 0;
+    udp->check = l4_checksum(ip, udp, l4_len);
+  }
+  ip->tot_len = htons(sizeof(struct iphdr) + l4_len);
+  ip->check = csum_fold(csum_add(0, ip, sizeof(struct iphdr)));
+
+  frame_lens_[queued_++] = ETH_HLEN + sizeof(struct iphdr) + l4_len;
   return true;
 }
 
+int PacketGenerator::flush() {
+  if (queued_ == 0) {
+    return 0;
+  }
+  size_t count = queued_;
+  queued_ = 0;
+  if (sock_fd_ < 0) {
+    send_errors_ += count;
+    return 0;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    iovs_[i].iov_len = frame_lens_[i];
+  }
+  size_t next = 0;
+  size_t sent = 0;
+  while (next < count) {
+    int ret = sendmmsg(sock_fd_, &msgs_[next], count - next, 0);
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      // sendmmsg stops at the first failed packet, skip it
+      MLOG(MERROR) << "Failed to send packet on " << iface_name_ << ": "
+                   << strerror(errno);
+      send_errors_++;
+      next++;
+      continue;
+    }
+    next += ret;
+    sent += ret;
+  }
+  packets_sent_ += sent;
+  return sent;
+}
+
+bool PacketGenerator::send_packet(struct flow_information* flow) {
+  if (!queue_packet(flow)) {
+    return false;
+  }
+  return flush() > 0;
+}
+
 }  // namespace lte
-}  // namespace magma
\ No newline at end of file
+}  // namespace magma
@@ -12,10 +12,15 @@
  */
 #pragma once
 
+#include <linux/if_packet.h>
+#include <stddef.h>
 #include <stdint.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
 #include <tins/network_interface.h>
 #include <tins/tins.h>
 #include <string>
+#include <vector>
 
 #include "orc8r/gateway/c/common/logging/magma_logging.hpp"
 
@@ -30,10 +35,27 @@ struct flow_information {
 namespace magma {
 namespace lte {
 
+/**
+ * Internet checksum (RFC 1071): csum_add adds the 16 bit big endian words of
+ * data to sum, csum_fold folds the carries and returns the complemented
+ * checksum in network order.
+ */
+uint32_t csum_add(uint32_t sum, const void* data, size_t len);
+uint16_t csum_fold(uint32_t sum);
+
+/**
+ * PacketGenerator builds the packets of terminated flows in preallocated
+ * frames, starting from a template holding the fixed Ethernet and IP header
+ * fields, and sends a batch of them with a single sendmmsg call on an
+ * AF_PACKET socket.
+ */
 class PacketGenerator {
  public:
   PacketGenerator(const std::string& iface_name, const std::string& pkt_dst_mac,
-                  const std::string& pkt_src_mac);
+                  const std::string& pkt_src_mac,
+                  size_t batch_size = kDefaultBatchSize);
+  ~PacketGenerator();
+
   /**
    * Send packet based on provided flow information
    * @param flow_information - flow_information
@@ -41,12 +63,53 @@ class PacketGenerator {
    */
   bool send_packet(struct flow_information* flow);
 
+  /**
+   * Build the packet of a flow in the next free frame. The batch is sent
+   * when it is full, otherwise on flush.
+   * @param flow_information - flow_information, ports in network order
+   * @return false if the protocol is not supported
+   */
+  bool queue_packet(const struct flow_information* flow);
+
+  /**
+   * Send the queued packets
+   * @return the number of packets sent
+   */
+  int flush();
+
+  size_t queued() const { return queued_; }
+  // Frame of the i-th queued packet, valid until the batch is sent
+  const uint8_t* queued_frame(size_t i) const { return frames_[i].data(); }
+  size_t queued_frame_len(size_t i) const { return frame_lens_[i]; }
+  size_t batch_size() const { return frames_.size(); }
+  uint64_t packets_sent() const { return packets_sent_; }
+  uint64_t send_errors() const { return send_errors_; }
+
+  static constexpr size_t kDefaultBatchSize = 64;
+
  private:
+  // Ethernet + IPv4 + TCP, the largest packet generated
+  static constexpr size_t kFrameSize = 14 + 20 + 20;
+
+  void build_template(const std::string& pkt_dst_mac,
+                      const std::string& pkt_src_mac);
+  bool open_socket(const std::string& pkt_dst_mac);
+
   std::string iface_name_;
   std::string pkt_dst_mac_;
   std::string pkt_src_mac_;
   Tins::NetworkInterface iface_;
+  int sock_fd_;
+  struct sockaddr_ll dst_addr_;
+  uint8_t template_[kFrameSize];
+  std::vector<std::vector<uint8_t>> frames_;
+  std::vector<size_t> frame_lens_;
+  std::vector<struct iovec> iovs_;
+  std::vector<struct mmsghdr> msgs_;
+  size_t queued_;
+  uint64_t packets_sent_;
+  uint64_t send_errors_;
 };
 
 }  // namespace lte
-}  // namespace magma
\ No newline at end of file
+}  // namespace magma
@@ -85,16 +85,24 @@ int main(void) {
   std::string pkt_dst_mac = config["pkt_dst_mac"].as<std::string>();
   std::string pkt_src_mac = config["pkt_src_mac"].as<std::string>();
   int zone = config["zone"].as<int>();
+  size_t netlink_rcvbuf_bytes =
+      config["netlink_rcvbuf_bytes"].IsDefined()
+          ? config["netlink_rcvbuf_bytes"].as<size_t>()
+          : magma::lte::EventTracker::kDefaultRcvbufBytes;
+  size_t pkt_batch_size =
+      config["pkt_batch_size"].IsDefined()
+          ? config["pkt_batch_size"].as<size_t>()
+          : magma::lte::PacketGenerator::kDefaultBatchSize;
 
   magma::service303::MagmaService server(CONNECTION_SERVICE,
                                          CONNECTIOND_VERSION);
   server.Start();
 
   auto pkt_generator = std::make_shared<magma::lte::PacketGenerator>(
-      interface_name, pkt_dst_mac, pkt_src_mac);
+      interface_name, pkt_dst_mac, pkt_src_mac, pkt_batch_size);
 
-  auto event_tracker =
-      std::make_shared<magma::lte::EventTracker>(pkt_generator, zone);
+  auto event_tracker = std::make_shared<magma::lte::EventTracker>(
+      pkt_generator, zone, netlink_rcvbuf_bytes);
 
   event_tracker->init_conntrack_event_loop();
 
@@ -0,0 +1,162 @@
+/**
+ * Copyright 2021 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <arpa/inet.h>
+#include <gtest/gtest.h>
+#include <linux/if_ether.h>
+#include <netinet/in.h>
+#include <netinet/ip.h>
+#include <netinet/tcp.h>
+#include <netinet/udp.h>
+#include <stdint.h>
+#include <memory>
+
+#include "lte/gateway/c/connection_tracker/src/PacketGenerator.hpp"
+
+namespace magma {
+namespace lte {
+
+namespace {
+const char* kDstMac = "02:00:00:00:00:01";
+const char* kSrcMac = "02:00:00:00:00:02";
+const size_t kBatchSize = 2;
+
+struct flow_information make_flow(uint32_t l4_proto, uint16_t dport) {
+  struct flow_information flow;
+  flow.saddr = inet_addr("192.168.128.12");
+  flow.daddr = inet_addr("8.8.8.8");
+  flow.l4_proto = l4_proto;
+  flow.sport = htons(51000);
+  flow.dport = htons(dport);
+  return flow;
+}
+}  // namespace
+
+class PacketGeneratorTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    // Packets are only queued, so the socket is not needed
+    pkt_generator = std::make_unique<PacketGenerator>("lo", kDstMac, kSrcMac,
+                                                      kBatchSize);
+  }
+
+  const struct iphdr* ip_header(size_t i) {
+    return reinterpret_cast<const struct iphdr*>(
+        pkt_generator->queued_frame(i) + ETH_HLEN);
+  }
+
+  std::unique_ptr<PacketGenerator> pkt_generator;
+};
+
+// Example of RFC 1071 section 3, with an odd length variant
+TEST_F(PacketGeneratorTest, TestChecksum) {
+  const uint8_t data[] = {0x00, 0x01, 0xf2, 0x03, 0xf4, 0xf5, 0xf6, 0xf7};
+  EXPECT_EQ(csum_add(0, data, sizeof(data)), 0x2ddf0u);
+  EXPECT_EQ(csum_fold(csum_add(0, data, sizeof(data))), htons(0x220d));
+  EXPECT_EQ(csum_fold(csum_add(0, data, 5)), htons(0x19fa));
+  EXPECT_EQ(csum_fold(0), htons(0xffff));
+}
+
+TEST_F(PacketGeneratorTest, TestTcpPacket) {
+  struct flow_information flow = make_flow(IPPROTO_TCP, 443);
+  ASSERT_TRUE(pkt_generator->queue_packet(&flow));
+  ASSERT_EQ(pkt_generator->queued(), 1u);
+  EXPECT_EQ(pkt_generator->queued_frame_len(0), 54u);
+
+  const uint8_t* frame = pkt_generator->queued_frame(0);
+  const struct ethhdr* eth = reinterpret_cast<const struct ethhdr*>(frame);
+  const uint8_t dst_mac[] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};
+  const uint8_t src_mac[] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x02};
+  EXPECT_EQ(memcmp(eth->h_dest, dst_mac, ETH_ALEN), 0);
+  EXPECT_EQ(memcmp(eth->h_source, src_mac, ETH_ALEN), 0);
+  EXPECT_EQ(eth->h_proto, htons(ETH_P_IP));
+
+  const struct iphdr* ip = ip_header(0);
+  EXPECT_EQ(ip->version, 4);
+  EXPECT_EQ(ip->ihl, 5);
+  EXPECT_EQ(ip->tot_len, htons(40));
+  EXPECT_EQ(ip->ttl, 128);
+  EXPECT_EQ(ip->protocol, IPPROTO_TCP);
+  EXPECT_EQ(ip->saddr, flow.saddr);
+  EXPECT_EQ(ip->daddr, flow.daddr);
+  EXPECT_EQ(ip->check, htons(0xea0a));
+
+  const struct tcphdr* tcp =
+      reinterpret_cast<const struct tcphdr*>(frame + ETH_HLEN + 20);
+  EXPECT_EQ(tcp->source, htons(51000));
+  EXPECT_EQ(tcp->dest, htons(443));
+  EXPECT_EQ(tcp->doff, 5);
+  EXPECT_EQ(tcp->window, htons(32678));
+  EXPECT_EQ(tcp->check, htons(0x1686));
+}
+
+TEST_F(PacketGeneratorTest, TestUdpPacket) {
+  struct flow_information flow = make_flow(IPPROTO_UDP, 53);
+  ASSERT_TRUE(pkt_generator->queue_packet(&flow));
+  EXPECT_EQ(pkt_generator->queued_frame_len(0), 42u);
+
+  const struct iphdr* ip = ip_header(0);
+  EXPECT_EQ(ip->tot_len, htons(28));
+  EXPECT_EQ(ip->protocol, IPPROTO_UDP);
+  EXPECT_EQ(ip->check, htons(0xea0b));
+
+  const struct udphdr* udp = reinterpret_cast<const struct udphdr*>(
+      pkt_generator->queued_frame(0) + ETH_HLEN + 20);
+  EXPECT_EQ(udp->source, htons(51000));
+  EXPECT_EQ(udp->dest, htons(53));
+  EXPECT_EQ(udp->len, htons(8));
+  EXPECT_EQ(udp->check, htons(0xe7ab));
+}
+
+TEST_F(PacketGeneratorTest, TestChecksumsVerify) {
+  struct flow_information flow = make_flow(IPPROTO_TCP, 8080);
+  ASSERT_TRUE(pkt_generator->queue_packet(&flow));
+
+  // Summing a header with its checksum folds to zero
+  const struct iphdr* ip = ip_header(0);
+  EXPECT_EQ(csum_fold(csum_add(0, ip, sizeof(*ip))), 0);
+
+  uint32_t sum = 0;
+  sum = csum_add(sum, &ip->saddr, sizeof(ip->saddr));
+  sum = csum_add(sum, &ip->daddr, sizeof(ip->daddr));
+  sum += IPPROTO_TCP + sizeof(struct tcphdr);
+  sum = csum_add(sum, pkt_generator->queued_frame(0) + ETH_HLEN + sizeof(*ip),
+                 sizeof(struct tcphdr));
+  EXPECT_EQ(csum_fold(sum), 0);
+}
+
+TEST_F(PacketGeneratorTest, TestUnsupportedProtocol) {
+  struct flow_information flow = make_flow(IPPROTO_ICMP, 0);
+  EXPECT_FALSE(pkt_generator->queue_packet(&flow));
+  EXPECT_EQ(pkt_generator->queued(), 0u);
+}
+
+TEST_F(PacketGeneratorTest, TestFullBatchIsSent) {
+  struct flow_information flow = make_flow(IPPROTO_UDP, 53);
+  ASSERT_TRUE(pkt_generator->queue_packet(&flow));
+  ASSERT_TRUE(pkt_generator->queue_packet(&flow));
+  EXPECT_EQ(pkt_generator->queued(), kBatchSize);
+
+  // The batch is full, it is sent before the packet is queued
+  flow.dport = htons(123);
+  ASSERT_TRUE(pkt_generator->queue_packet(&flow));
+  EXPECT_EQ(pkt_generator->queued(), 1u);
+  const struct udphdr* udp = reinterpret_cast<const struct udphdr*>(
+      pkt_generator->queued_frame(0) + ETH_HLEN + 20);
+  EXPECT_EQ(udp->dest, htons(123));
+
+  pkt_generator->flush();
+  EXPECT_EQ(pkt_generator->queued(), 0u);
+}
+}  // namespace lte
+}  // namespace magma
@@ -21,6 +21,7 @@
   \company Eurecom
 */
 
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdint.h>
 
@@ -29,6 +30,93 @@
 
 int errorCodeDecoder = 0;
 
+// Enough for the variable length IEs of a few nested messages, and for the
+// plain text of any uplink NAS PDU the S1AP task accepts
+#define TLV_DECODER_VIEWS_MAX 32
+#define TLV_DECODER_SCRATCH_SIZE 8192
+
+typedef struct tlv_decoder_arena_s {
+  int depth;
+  bool enabled;
+  uint32_t views;
+  uint32_t scratch;
+  struct tagbstring view[TLV_DECODER_VIEWS_MAX];
+  unsigned char scratch_data[TLV_DECODER_SCRATCH_SIZE];
+} tlv_decoder_arena_t;
+
+static __thread tlv_decoder_arena_t tlv_decoder_arena;
+
+//------------------------------------------------------------------------------
+static bstring tlv_decoder_view(unsigned char* data, uint32_t length) {
+  tlv_decoder_arena_t* arena = &tlv_decoder_arena;
+
+  if ((arena->depth == 0) || (arena->views == TLV_DECODER_VIEWS_MAX)) {
+    return NULL;
+  }
+  bstring view = &arena->view[arena->views++];
+  view->mlen = -1;
+  view->slen = length;
+  view->data = data;
+  return view;
+}
+
+//------------------------------------------------------------------------------
+tlv_decoder_views_t tlv_decoder_views_open(void) {
+  tlv_decoder_arena_t* arena = &tlv_decoder_arena;
+  tlv_decoder_views_t scope = {.enabled = arena->enabled,
+                               .views = arena->views,
+                               .scratch = arena->scratch};
+
+  arena->depth++;
+  arena->enabled = false;
+  return scope;
+}
+
+//------------------------------------------------------------------------------
+void tlv_decoder_views_close(tlv_decoder_views_t scope) {
+  tlv_decoder_arena_t* arena = &tlv_decoder_arena;
+
+  arena->depth--;
+  arena->enabled = scope.enabled;
+  arena->views = scope.views;
+  arena->scratch = scope.scratch;
+}
+
+//------------------------------------------------------------------------------
+bool tlv_decoder_views_enable(bool enable) {
+  bool previous = tlv_decoder_arena.enabled;
+
+  tlv_decoder_arena.enabled = enable;
+  return previous;
+}
+
+//------------------------------------------------------------------------------
+bstring tlv_decoder_views_scratch(uint32_t length) {
+  tlv_decoder_arena_t* arena = &tlv_decoder_arena;
+
+  if ((arena->depth == 0) ||
+      (length > TLV_DECODER_SCRATCH_SIZE - arena->scratch)) {
+    return NULL;
+  }
+  bstring scratch =
+      tlv_decoder_view(&arena->scratch_data[arena->scratch], length);
+  if (scratch) {
+    arena->scratch += length;
+  }
+  return scratch;
+}
+
+//------------------------------------------------------------------------------
+bstring tlv_decoder_views_own(bstring* bstr) {
+  bstring owned = *bstr;
+
+  if ((owned) && (owned->mlen <= 0)) {
+    owned = bstrcpy(owned);
+  }
+  *bstr = NULL;
+  return owned;
+}
+
 //------------------------------------------------------------------------------
 int decode_bstring(bstring* bstr, const uint16_t pdulen,
                    const uint8_t* const buffer, const uint32_t buflen) {
@@ -37,7 +125,13 @@ int decode_bstring(bstring* bstr, const uint16_t pdulen,
   }
 
   if ((bstr) && (buffer)) {
-    *bstr = blk2bstr(buffer, pdulen);
+    *bstr = NULL;
+    if (tlv_decoder_arena.enabled) {
+      *bstr = tlv_decoder_view((unsigned char*)buffer, pdulen);
+    }
+    if (*bstr == NULL) {
+      *bstr = blk2bstr(buffer, pdulen);
+    }
     return pdulen;
   } else {
     return TLV_BUFFER_TOO_SHORT;
@@ -23,6 +23,7 @@
 #ifndef FILE_TLV_DECODER_SEEN
 #define FILE_TLV_DECODER_SEEN
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -47,6 +48,41 @@ extern int errorCodeDecoder;
 int decode_bstring(bstring* octetstring, const uint16_t pdulen,
                    const uint8_t* const buffer, const uint32_t buflen);
 
+/*
+ * Decoder views
+ *
+ * While views are enabled in an open scope, decode_bstring returns
+ * write-protected bstrings that point into the decoded buffer instead of
+ * heap copies. They are not NUL terminated and bdestroy leaves them alone,
+ * so the existing free paths of the IEs are unchanged. The buffer must
+ * outlive the scope, and an IE kept past the scope must be taken with
+ * tlv_decoder_views_own.
+ *
+ * View headers and scratch space come from a per thread arena that is
+ * rewound when the scope is closed. When it runs out the decoder falls
+ * back to heap copies.
+ */
+typedef struct tlv_decoder_views_s {
+  bool enabled;
+  uint32_t views;
+  uint32_t scratch;
+} tlv_decoder_views_t;
+
+tlv_decoder_views_t tlv_decoder_views_open(void);
+
+void tlv_decoder_views_close(tlv_decoder_views_t scope);
+
+// Returns the previous setting, views are only produced in an open scope
+bool tlv_decoder_views_enable(bool enable);
+
+// Write-protected bstring of length bytes of scratch space valid until the
+// scope is closed, NULL if no scope is open or the arena is exhausted
+bstring tlv_decoder_views_scratch(uint32_t length);
+
+// Takes the decoded string out of *bstr: a view is copied, an owned string
+// is moved. *bstr is NULL on return.
+bstring tlv_decoder_views_own(bstring* bstr);
+
 bstring dump_bstring_xml(const bstring bstr);
 
 void tlv_decode_perror(void);
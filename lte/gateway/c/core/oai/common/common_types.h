@@ -39,6 +39,7 @@
 #define FILE_COMMON_TYPES_SEEN
 
 #include <inttypes.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -387,9 +388,13 @@ typedef struct {
   regional_subscription_t reg_sub[MAX_REGIONAL_SUB];
 } subscription_data_t;
 
+// Number-Of-Requested-Vectors is at most 5 (TS 29.272). The UE context holds
+// MAX_EPS_AUTH_VECTORS of them, the MME app caches the others.
+#define MAX_AUTH_INFO_VECTORS 5
+
 typedef struct authentication_info_s {
   uint8_t nb_of_vectors;
-  eutran_vector_t eutran_vector[MAX_EPS_AUTH_VECTORS];
+  eutran_vector_t eutran_vector[MAX_AUTH_INFO_VECTORS];
 } authentication_info_t;
 
 typedef struct m5g_authentication_info_s {
@@ -458,4 +463,22 @@ typedef struct tac_list_per_sac_s {
   tac_t tacs[MAX_TACS_PER_SAC];
 } tac_list_per_sac_t;
 
+/* Tracks the copy of a UE context held in the data store. The generation is
+ * bumped every time the context is reported modified and the context is only
+ * converted and written again when it moved past the persisted generation.
+ * A context that was never written has a null hash.
+ */
+typedef struct ue_state_sync_s {
+  uint64_t generation;            ///< Bumped on each modification
+  uint64_t persisted_generation;  ///< Generation of the stored copy
+  uint64_t version;               ///< Version of the stored copy
+  size_t hash;                    ///< Hash of the stored copy
+} ue_state_sync_t;
+
+#define UE_STATE_MARK_DIRTY(uE_CtX_pTr) ((uE_CtX_pTr)->state_sync.generation++)
+#define UE_STATE_IS_DIRTY(uE_CtX_pTr)     \
+  ((uE_CtX_pTr)->state_sync.hash == 0 ||  \
+   (uE_CtX_pTr)->state_sync.generation != \
+       (uE_CtX_pTr)->state_sync.persisted_generation)
+
 #endif /* FILE_COMMON_TYPES_SEEN */
@@ -100,13 +100,14 @@ int mme_config_find_mnc_length(const char mcc_digit1P, const char mcc_digit2P,
     return 0;
   }
 
-  while (plmn_index < mme_config.served_tai.nb_tai) {
-    if (mme_config.served_tai.plmn_mcc[plmn_index] == mcc) {
-      if ((mme_config.served_tai.plmn_mnc[plmn_index] == mnc2) &&
-          (mme_config.served_tai.plmn_mnc_len[plmn_index] == 2)) {
+  const served_tai_t* served_tai = &mme_config_get()->served_tai;
+  while (plmn_index < served_tai->nb_tai) {
+    if (served_tai->plmn_mcc[plmn_index] == mcc) {
+      if ((served_tai->plmn_mnc[plmn_index] == mnc2) &&
+          (served_tai->plmn_mnc_len[plmn_index] == 2)) {
         return 2;
-      } else if ((mme_config.served_tai.plmn_mnc[plmn_index] == mnc3) &&
-                 (mme_config.served_tai.plmn_mnc_len[plmn_index] == 3)) {
+      } else if ((served_tai->plmn_mnc[plmn_index] == mnc3) &&
+                 (served_tai->plmn_mnc_len[plmn_index] == 3)) {
         return 3;
       }
     }
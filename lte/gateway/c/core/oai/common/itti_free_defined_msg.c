@@ -245,6 +245,10 @@ void itti_free_msg_content(MessageDef* const message_p) {
       bdestroy_wrapper(&message_p->ittiMsg.sctp_data_ind.payload);
       break;
 
+    case UDP_DATA_IND_BATCH:
+      free_wrapper((void**)&message_p->ittiMsg.udp_data_ind_batch.buffer);
+      break;
+
     case SCTP_NEW_ASSOCIATION:
       bdestroy_wrapper(&message_p->ittiMsg.sctp_new_peer.ran_cp_ipaddr);
       break;
@@ -31,7 +31,7 @@ namespace lte {
 class RedisClient {
  public:
   explicit RedisClient(bool init_connection);
-  ~RedisClient() = default;
+  virtual ~RedisClient() = default;
 
   /**
    * Initializes a connection to the redis datastore configured in redis.yml
@@ -61,8 +61,9 @@ class RedisClient {
    * @param version
    * @return response code of operation
    */
-  status_code_e write_proto_str(const std::string& key,
-                                const std::string& proto_msg, uint64_t version);
+  virtual status_code_e write_proto_str(const std::string& key,
+                                        const std::string& proto_msg,
+                                        uint64_t version);
 
   /**
    * Converts protobuf Message and parses it to string
@@ -83,7 +84,8 @@ class RedisClient {
 
   int read_version(const std::string& key);
 
-  status_code_e clear_keys(const std::vector<std::string>& keys_to_clear);
+  virtual status_code_e clear_keys(
+      const std::vector<std::string>& keys_to_clear);
 
   std::vector<std::string> get_keys(const std::string& pattern);
 
@@ -0,0 +1,151 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the terms found in the LICENSE file in the root of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#include "lte/gateway/c/core/oai/common/redis_utils/redis_writer_pool.hpp"
+
+#include <utility>
+
+namespace magma {
+namespace lte {
+
+RedisWriterPool::RedisWriterPool(uint32_t num_workers, bool init_connection,
+                                 log_proto_t log_task)
+    : RedisWriterPool(
+          num_workers,
+          [init_connection] {
+            return std::make_unique<RedisClient>(init_connection);
+          },
+          log_task) {}
+
+RedisWriterPool::RedisWriterPool(uint32_t num_workers,
+                                 const ClientFactory& make_client,
+                                 log_proto_t log_task)
+    : failed_operations_(0), log_task_(log_task) {
+  for (uint32_t i = 0; i < num_workers; i++) {
+    auto worker = std::make_unique<Worker>();
+    worker->client = make_client();
+    worker->thread = std::thread(&RedisWriterPool::run, this, worker.get());
+    workers_.push_back(std::move(worker));
+  }
+}
+
+RedisWriterPool::~RedisWriterPool() {
+  for (auto& worker : workers_) {
+    {
+      std::lock_guard<std::mutex> lock(worker->mutex);
+      worker->stopping = true;
+    }
+    worker->queued.notify_one();
+  }
+  for (auto& worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+RedisWriterPool::Worker& RedisWriterPool::worker_for(const std::string& key) {
+  return *workers_[std::hash<std::string>{}(key) % workers_.size()];
+}
+
+void RedisWriterPool::queue_operation(Operation operation) {
+  Worker& worker = worker_for(operation.key);
+  {
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.queue.push_back(std::move(operation));
+  }
+  worker.queued.notify_one();
+}
+
+void RedisWriterPool::write_proto_str(const std::string& key,
+                                      std::string proto_str,
+                                      uint64_t version) {
+  queue_operation(
+      Operation{key, std::move(proto_str), version, false, false});
+}
+
+void RedisWriterPool::clear_keys(
+    const std::vector<std::string>& keys_to_clear) {
+  // One operation per key, the keys may belong to different workers
+  for (const auto& key : keys_to_clear) {
+    queue_operation(Operation{key, std::string(), 0, true, false});
+  }
+}
+
+void RedisWriterPool::flush() {
+  for (auto& worker : workers_) {
+    std::unique_lock<std::mutex> lock(worker->mutex);
+    worker->drained.wait(
+        lock, [&worker] { return worker->queue.empty() && !worker->busy; });
+  }
+}
+
+bool RedisWriterPool::take_failed(const std::string& key) {
+  Worker& worker = worker_for(key);
+  std::lock_guard<std::mutex> lock(worker.mutex);
+  return worker.failed_keys.erase(key) > 0;
+}
+
+void RedisWriterPool::run(Worker* worker) {
+  std::deque<Operation> batch;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(worker->mutex);
+      // The outcome of the last operation of a key wins. A failed removal is
+      // not retried, the key is gone from the caller's state.
+      for (const auto& operation : batch) {
+        if (operation.failed && !operation.clear) {
+          worker->failed_keys.insert(operation.key);
+        } else {
+          worker->failed_keys.erase(operation.key);
+        }
+      }
+      batch.clear();
+      worker->busy = false;
+      if (worker->queue.empty()) {
+        worker->drained.notify_all();
+        if (worker->stopping) {
+          return;
+        }
+        worker->queued.wait(lock, [worker] {
+          return !worker->queue.empty() || worker->stopping;
+        });
+        if (worker->queue.empty()) {
+          continue;
+        }
+      }
+      // Take everything queued, so the lock is not held during the writes
+      batch.swap(worker->queue);
+      worker->busy = true;
+    }
+    for (auto& operation : batch) {
+      status_code_e rc =
+          operation.clear
+              ? worker->client->clear_keys({operation.key})
+              : worker->client->write_proto_str(
+                    operation.key, operation.proto_str, operation.version);
+      if (rc != RETURNok) {
+        operation.failed = true;
+        failed_operations_++;
+        OAILOG_ERROR(log_task_, "Failed to %s state of %s in db",
+                     operation.clear ? "remove" : "write",
+                     operation.key.c_str());
+      }
+    }
+  }
+}
+
+}  // namespace lte
+}  // namespace magma
@@ -0,0 +1,123 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the terms found in the LICENSE file in the root of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+extern "C" {
+#include "lte/gateway/c/core/oai/common/log.h"
+}
+
+#include "lte/gateway/c/core/oai/common/redis_utils/redis_client.hpp"
+
+namespace magma {
+namespace lte {
+
+/**
+ * Writes state to redis from worker threads, so that the task thread does not
+ * wait for a redis round trip after each message.
+ *
+ * Each worker has its own redis connection. A key is always handled by the
+ * same worker, so the writes and deletions of one key, e.g. the state of one
+ * UE, are applied in the order they were queued. The caller learns of a
+ * failed write from take_failed() and writes the key again.
+ */
+class RedisWriterPool {
+ public:
+  using ClientFactory = std::function<std::unique_ptr<RedisClient>()>;
+
+  RedisWriterPool(uint32_t num_workers, bool init_connection,
+                  log_proto_t log_task);
+  // Each worker gets a client from make_client, e.g. a fake one in tests
+  RedisWriterPool(uint32_t num_workers, const ClientFactory& make_client,
+                  log_proto_t log_task);
+  // Applies the queued operations before returning
+  ~RedisWriterPool();
+
+  RedisWriterPool(const RedisWriterPool&) = delete;
+  RedisWriterPool& operator=(const RedisWriterPool&) = delete;
+
+  /**
+   * Queues the write of a serialized protobuf, see
+   * RedisClient::write_proto_str
+   */
+  void write_proto_str(const std::string& key, std::string proto_str,
+                       uint64_t version);
+
+  void clear_keys(const std::vector<std::string>& keys_to_clear);
+
+  /**
+   * Waits until the operations queued so far are applied, e.g. before the
+   * state is read back from redis
+   */
+  void flush();
+
+  /**
+   * Returns whether the last write of key applied so far failed, and forgets
+   * the failure: the caller is expected to queue the write again
+   */
+  bool take_failed(const std::string& key);
+
+  uint32_t num_workers() const { return workers_.size(); }
+  uint64_t failed_operations() const { return failed_operations_; }
+
+ private:
+  struct Operation {
+    std::string key;
+    std::string proto_str;
+    uint64_t version;
+    bool clear;
+    bool failed;
+  };
+
+  struct Worker {
+    std::unique_ptr<RedisClient> client;
+    std::mutex mutex;
+    // Signals queued operations and the stop request to the worker
+    std::condition_variable queued;
+    // Signals flush() that the queue is drained
+    std::condition_variable drained;
+    std::deque<Operation> queue;
+    // Keys whose last write failed, only keys of this worker
+    std::unordered_set<std::string> failed_keys;
+    bool busy = false;
+    bool stopping = false;
+    std::thread thread;
+  };
+
+  Worker& worker_for(const std::string& key);
+  void queue_operation(Operation operation);
+  void run(Worker* worker);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::atomic<uint64_t> failed_operations_;
+  log_proto_t log_task_;
+};
+
+}  // namespace lte
+}  // namespace magma
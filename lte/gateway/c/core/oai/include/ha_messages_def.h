@@ -12,3 +12,5 @@ limitations under the License.
 */
 
 MESSAGE_DEF(AGW_OFFLOAD_REQ, ha_agw_offload_req_t, ha_agw_offload_req)
+MESSAGE_DEF(AGW_OFFLOAD_UES_REQ, ha_agw_offload_ues_req_t,
+            ha_agw_offload_ues_req)
@@ -15,9 +15,13 @@ limitations under the License.
 
 #include <stdint.h>
 
+#include "lte/gateway/c/core/oai/common/common_types.h"
 #include "lte/gateway/c/core/oai/lib/3gpp/3gpp_23.003.h"
 
 #define AGW_OFFLOAD_REQ(mSGpTR) (mSGpTR)->ittiMsg.ha_agw_offload_req
+#define AGW_OFFLOAD_UES_REQ(mSGpTR) (mSGpTR)->ittiMsg.ha_agw_offload_ues_req
+
+#define HA_MAX_ENB_ASSOCIATIONS 8
 
 // ALL: offload all idle and connected UEs
 // ANY: offload any UE
@@ -34,3 +38,12 @@ typedef struct ha_agw_offload_req_s {
   uint32_t eNB_id;
   offload_type_t enb_offload_type;
 } ha_agw_offload_req_t;
+
+// Sent by HA to MME_APP, which owns the UE contexts to offload. HA resolves
+// the eNB_id filter of the request to the S1AP associations of that eNB.
+typedef struct ha_agw_offload_ues_req_s {
+  ha_agw_offload_req_t request;
+
+  uint32_t nb_sctp_assoc;
+  sctp_assoc_id_t sctp_assoc_id[HA_MAX_ENB_ASSOCIATIONS];
+} ha_agw_offload_ues_req_t;
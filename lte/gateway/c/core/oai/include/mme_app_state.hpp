@@ -53,7 +53,9 @@ void clear_mme_nas_state(void);
 
 // Returns UE MME state hashtable, indexed by IMSI
 hash_table_ts_t* get_mme_ue_state(void);
-// Persists UE MME state for subscriber into db
+// Marks UE MME state of subscriber modified, so that it is persisted again
+void mark_mme_ue_state_dirty(mme_app_desc_t* mme_app_desc_p, imsi64_t imsi64);
+// Persists UE MME state for subscriber into db if it was marked modified
 void put_mme_ue_state(mme_app_desc_t* mme_app_desc_p, imsi64_t imsi64,
                       bool force_ue_write);
 // Deletes entry for UE MME state on db
@@ -334,15 +334,29 @@ typedef struct sgs_context_s {
  * according to 3GPP TS.23.401 #5.7.2
  */
 typedef struct ue_mm_context_s {
-  /* msisdn: The basic MSISDN of the UE. The presence is dictated by its storage
-   *         in the HSS, set by S6A UPDATE LOCATION ANSWER
+  /* Identifiers and states read by every S1AP and NAS message come first, to
+   * share the first cache line
    */
-  bstring msisdn;
+  /* MME UE S1AP ID, Unique identity the UE within MME */
+  mme_ue_s1ap_id_t mme_ue_s1ap_id;
+
+  /* eNB UE S1AP ID,  Unique identity the UE within eNodeB */
+  enb_ue_s1ap_id_t enb_ue_s1ap_id : 24;
+  /* enb_s1ap_id_key = enb-ue-s1ap-id <24 bits> | enb-id <8 bits> */
+  enb_s1ap_id_key_t enb_s1ap_id_key;
+  /* SCTP assoc id */
+  sctp_assoc_id_t sctp_assoc_id_key;
+  teid_t mme_teid_s11;
 
   enum s1cause ue_context_rel_cause;
   mm_state_t mm_state;
   ecm_state_t ecm_state;
 
+  /* msisdn: The basic MSISDN of the UE. The presence is dictated by its storage
+   *         in the HSS, set by S6A UPDATE LOCATION ANSWER
+   */
+  bstring msisdn;
+
   /* Last known E-UTRAN cell, set by nas_attach_req_t */
   ecgi_t e_utran_cgi;
 
@@ -354,8 +368,10 @@ typedef struct ue_mm_context_s {
   /* TODO: add csg_membership */
   /* TODO Access mode: Access mode of last known ECGI when the UE was active */
 
-  /* apn_config_profile: set by S6A UPDATE LOCATION ANSWER */
-  apn_config_profile_t apn_config_profile;
+  /* apn_config_profile: set by S6A UPDATE LOCATION ANSWER, shared with the
+   * other UEs of the same profile, see mme_app_set_apn_config_profile
+   */
+  const apn_config_profile_t* apn_config_profile;
 
   /* charging_characteristics: set by S6A UPDATE LOCATION ANSWER */
   charging_characteristics_t default_charging_characteristics;
@@ -372,17 +388,6 @@ typedef struct ue_mm_context_s {
    *           subscriber's profile. See TS 23.003 [9] clause 9.1.2 for more
    */
   bstring apn_oi_replacement;
-  teid_t mme_teid_s11;
-  /* SCTP assoc id */
-  sctp_assoc_id_t sctp_assoc_id_key;
-
-  /* eNB UE S1AP ID,  Unique identity the UE within eNodeB */
-  enb_ue_s1ap_id_t enb_ue_s1ap_id : 24;
-  /* enb_s1ap_id_key = enb-ue-s1ap-id <24 bits> | enb-id <8 bits> */
-  enb_s1ap_id_key_t enb_s1ap_id_key;
-
-  /* MME UE S1AP ID, Unique identity the UE within MME */
-  mme_ue_s1ap_id_t mme_ue_s1ap_id;
 
   /* Subscribed UE-AMBR: The Maximum Aggregated uplink and downlink MBR values
    *           to be shared across all Non-GBR bearers according to the
@@ -478,6 +483,8 @@ typedef struct ue_mm_context_s {
   uint8_t nb_rabs;
   LIST_HEAD(s11_procedures_s, mme_app_s11_proc_s) * s11_procedures;
   itti_s1ap_initial_ue_message_t* initial_ue_message_for_invalid_enb_s1ap_id;
+  // Persisted copy of this context, see UE_STATE_MARK_DIRTY
+  ue_state_sync_t state_sync;
 } ue_mm_context_t;
 
 typedef struct mme_ue_context_s {
@@ -558,6 +565,13 @@ void mme_ue_context_update_coll_keys(mme_ue_context_t* const mme_ue_context_p,
                                      const s11_teid_t mme_s11_teid,
                                      const guti_t* const guti_p);
 
+/** \brief Move an UE context to the SCTP association of another eNB
+ * \param ue_context_p The UE context
+ * \param sctp_assoc_id The SCTP association the UE is now reached through
+ **/
+void mme_ue_context_update_sctp_assoc_id(ue_mm_context_t* const ue_context_p,
+                                         const sctp_assoc_id_t sctp_assoc_id);
+
 /** \brief dump MME associative collections
  **/
 
@@ -584,6 +598,12 @@ ue_mm_context_t* mme_create_new_ue_context(void);
 
 void mme_app_ue_context_free_content(ue_mm_context_t* const mme_ue_context_p);
 
+/** \brief Replace the APN configuration profile of the UE by the shared copy
+ * of profile, NULL clears it
+ **/
+void mme_app_set_apn_config_profile(ue_mm_context_t* const ue_context_p,
+                                    const apn_config_profile_t* const profile);
+
 /**
  * Release memory allocated by MmeNasStateManager through MmeNasStateConverter
  * and NasStateConverter for each UE context, this is called by
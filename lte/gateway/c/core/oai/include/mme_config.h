@@ -81,6 +81,7 @@
 #define MME_CONFIG_STRING_STATS_TIMER "STATS_TIMER_SEC"
 
 #define MME_CONFIG_STRING_USE_STATELESS "USE_STATELESS"
+#define MME_CONFIG_STRING_STATE_WRITER_THREADS "STATE_WRITER_THREADS"
 #define MME_CONFIG_STRING_ENABLE5G_FEATURES "ENABLE5G_FEATURES"
 #define MME_CONFIG_STRING_FULL_NETWORK_NAME "FULL_NETWORK_NAME"
 #define MME_CONFIG_STRING_SHORT_NETWORK_NAME "SHORT_NETWORK_NAME"
@@ -124,6 +125,7 @@
 #define MME_CONFIG_STRING_S1AP_CONFIG "S1AP"
 #define MME_CONFIG_STRING_S1AP_OUTCOME_TIMER "S1AP_OUTCOME_TIMER"
 #define MME_CONFIG_STRING_S1AP_PORT "S1AP_PORT"
+#define MME_CONFIG_STRING_S1AP_DECODER_THREADS "S1AP_DECODER_THREADS"
 
 #define MME_CONFIG_STRING_TAC_LIST "TAC_LIST"
 #define MME_CONFIG_STRING_GUAMFI_LIST "GUAMFI_LIST"
@@ -188,6 +190,12 @@
   "APN_CORRECTION_MAP_IMSI_PREFIX"
 #define MME_CONFIG_STRING_NAS_APN_CORRECTION_MAP_APN_OVERRIDE \
   "APN_CORRECTION_MAP_APN_OVERRIDE"
+#define MME_CONFIG_STRING_NAS_ENABLE_AUTH_VECTOR_CACHE \
+  "ENABLE_AUTH_VECTOR_CACHE"
+#define MME_CONFIG_STRING_NAS_AUTH_VECTOR_CACHE_SIZE "AUTH_VECTOR_CACHE_SIZE"
+#define MME_CONFIG_STRING_NAS_AUTH_VECTOR_CACHE_TTL "AUTH_VECTOR_CACHE_TTL"
+#define MME_CONFIG_STRING_NAS_AUTH_VECTOR_CACHE_REFILL_WATERMARK \
+  "AUTH_VECTOR_CACHE_REFILL_WATERMARK"
 
 #define MME_CONFIG_STRING_SGW_CONFIG "S-GW"
 
@@ -228,6 +236,13 @@
 #define MME_CONFIG_STRING_MME_APP_ZMQ_IDENT_TH "MME_APP_ZMQ_IDENT_TH"
 #define MME_CONFIG_STRING_MME_APP_ZMQ_SMC_TH "MME_APP_ZMQ_SMC_TH"
 
+// Pacing of eNB wide operations (eNB reset, SCTP shutdown)
+#define MME_CONFIG_STRING_BULK_SIGNALLING_UES_PER_TICK \
+  "BULK_SIGNALLING_UES_PER_TICK"
+#define MME_CONFIG_STRING_BULK_SIGNALLING_TICK_MS "BULK_SIGNALLING_TICK_MS"
+#define MME_CONFIG_STRING_BULK_SIGNALLING_MAX_UES_PER_SEC \
+  "BULK_SIGNALLING_MAX_UES_PER_SEC"
+
 // INBOUND ROAMING
 #define MME_CONFIG_STRING_FED_MODE_MAP "FEDERATED_MODE_MAP"
 #define MME_CONFIG_STRING_MODE "MODE"
@@ -268,6 +283,8 @@ typedef struct sctp_config_s {
 typedef struct s1ap_config_s {
   uint16_t port_number;
   uint8_t outcome_drop_timer_sec;
+  // Worker threads decoding the received PDUs, 0 decodes on the S1AP task
+  uint32_t decoder_threads;
 } s1ap_config_t;
 
 typedef struct ip_s {
@@ -305,6 +322,13 @@ typedef struct apn_map_config_s {
   apn_map_t apn_map[MAX_APN_CORRECTION_MAP_LIST];
 } apn_map_config_t;
 
+typedef struct auth_vector_cache_config_s {
+  bool enabled;
+  uint32_t size;              // spare vectors kept per subscriber
+  uint32_t ttl_sec;           // age after which a vector is dropped
+  uint32_t refill_watermark;  // refill when fewer vectors are left
+} auth_vector_cache_config_t;
+
 typedef struct nas_config_s {
   uint8_t prefered_integrity_algorithm[8];
   uint8_t prefered_ciphering_algorithm[8];
@@ -330,6 +354,7 @@ typedef struct nas_config_s {
   // apn correction
   bool enable_apn_correction;
   apn_map_config_t apn_map_config;
+  auth_vector_cache_config_t auth_vector_cache;
 } nas_config_t;
 
 typedef struct sgs_config_s {
@@ -383,9 +408,6 @@ typedef struct sac_to_tacs_map_config_s {
 } sac_to_tacs_map_config_t;
 
 typedef struct mme_config_s {
-  /* Reader/writer lock for this configuration */
-  pthread_rwlock_t rw_lock;
-
   bstring config_file;
   bstring pid_dir;
   bstring realm;
@@ -441,6 +463,8 @@ typedef struct mme_config_s {
   lai_t lai;
   fed_mode_map_config_t mode_map_config;
   bool use_stateless;
+  // Threads writing the state to redis, 0 to write from the MME_APP task
+  uint32_t state_writer_threads;
   bool use_ha;
   bool enable_gtpu_private_ip_correction;
   bool enable5g_features;
@@ -452,6 +476,10 @@ typedef struct mme_config_s {
   long mme_app_zmq_auth_th;
   long mme_app_zmq_ident_th;
   long mme_app_zmq_smc_th;
+
+  uint32_t bulk_signalling_ues_per_tick;
+  uint32_t bulk_signalling_tick_ms;
+  uint32_t bulk_signalling_max_ues_per_sec;
 } mme_config_t;
 
 extern mme_config_t mme_config;
@@ -460,6 +488,9 @@ void mme_config_init(mme_config_t*);
 int mme_config_parse_opt_line(int argc, char* argv[], mme_config_t* mme_config);
 int mme_config_parse_file(mme_config_t*);
 int mme_config_parse_string(const char* config_string, mme_config_t* config_pP);
+/* Returns -1 on an invalid configuration where the above exits the MME */
+int mme_config_parse_string_nonfatal(const char* config_string,
+                                     mme_config_t* config_pP);
 void mme_config_display(mme_config_t*);
 void create_partial_lists(mme_config_t* config_pP);
 void mme_config_exit(void);
@@ -469,11 +500,23 @@ void clear_served_tai_config(served_tai_t* served_tai);
 
 void free_partial_lists(partial_list_t* partialList, uint8_t num_par_lists);
 
-#define mme_config_read_lock(mMEcONFIG) \
-  pthread_rwlock_rdlock(&(mMEcONFIG)->rw_lock)
-#define mme_config_write_lock(mMEcONFIG) \
-  pthread_rwlock_wrlock(&(mMEcONFIG)->rw_lock)
-#define mme_config_unlock(mMEcONFIG) \
-  pthread_rwlock_unlock(&(mMEcONFIG)->rw_lock)
+/*
+ * Served TAIs and NAS timers can be reloaded at runtime, tasks read them from
+ * the snapshot returned here rather than from the mme_config global. A
+ * snapshot is never modified once published and stays valid for a grace
+ * period after it is replaced, so it must not be kept beyond the handling of
+ * the current message.
+ */
+const mme_config_t* mme_config_get(void);
+
+/*
+ * Parse config_string and publish the served TAIs and NAS timers it holds.
+ * The reload is refused if anything that needs a restart differs from the
+ * configuration in effect.
+ */
+int mme_config_reload_string(const char* config_string);
+
+/* Reload mme_config.config_file from a detached thread */
+void mme_config_reload(void);
 
 #endif /* FILE_MME_CONFIG_SEEN */
@@ -43,6 +43,14 @@ ue_description_t* s1ap_state_get_ue_mmeid(mme_ue_s1ap_id_t mme_ue_s1ap_id);
 
 ue_description_t* s1ap_state_get_ue_imsi(imsi64_t imsi64);
 
+/**
+ * Sets the S1AP state of a UE, marks the UE state dirty if it changed
+ * @param ue_ref UE context
+ * @param s1_ue_state new S1AP UE state
+ */
+void s1ap_set_ue_state(ue_description_t* ue_ref,
+                       enum s1_ue_state_s s1_ue_state);
+
 /**
  * Return unique composite id for S1AP UE context
  * @param sctp_assoc_id unique SCTP assoc id
@@ -123,6 +123,9 @@ typedef struct ue_description_s {
   // it's time sensitive; if the MME restarts during a HO procedure the RAN
   // will abort the procedure due to timeouts, rendering this state useless.
   s1ap_handover_state_t s1ap_handover_state;
+
+  // Persisted copy of this context, see UE_STATE_MARK_DIRTY
+  ue_state_sync_t state_sync;
 } ue_description_t;
 
 /* Maximum no. of Broadcast PLMNs. Value is 6
@@ -104,7 +104,9 @@ typedef struct s6a_auth_info_req_s {
   char imsi[IMSI_BCD_DIGITS_MAX + 1];
   uint8_t imsi_length;
   plmn_t visited_plmn;
-  /* Number of vectors to retrieve from HSS, should be equal to one */
+  /* Number of vectors to retrieve from HSS, one unless the spare vectors
+   * are cached, at most MAX_AUTH_INFO_VECTORS
+   */
   uint8_t nb_of_vectors;
 
   /* Bit to indicate that USIM has requested a re-synchronization of SQN */
@@ -40,6 +40,9 @@ typedef struct application_mme_app_stats_msg {
   uint32_t nb_default_eps_bearers;
   uint32_t nb_s1u_bearers;
   uint32_t nb_mme_app_last_msg_latency;
+  // Progress of the paced per UE work of eNB resets and SCTP shutdowns
+  uint32_t nb_bulk_signalling_ues_pending;
+  uint32_t nb_bulk_signalling_ues_processed;
 } application_mme_app_stats_msg_t;
 
 typedef struct application_s1ap_stats_msg {
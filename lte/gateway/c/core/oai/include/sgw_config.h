@@ -70,6 +70,7 @@
 #define SGW_CONFIG_STRING_OVS_PIPELINED_CONFIG_ENABLED \
   "PIPELINED_CONFIG_ENABLED"
 #define SGW_CONFIG_STRING_EBPF_ENABLED "EBPF_ENABLED"
+#define SGW_CONFIG_STRING_OVS_OF_BUNDLES "OF_BUNDLES"
 
 #define SPGW_ABORT_ON_ERROR true
 #define SPGW_WARN_ON_ERROR false
@@ -86,6 +87,8 @@ typedef struct ovs_config_s {
   bool gtp_echo;
   bool pipelined_managed_tbl0;
   bool gtp_csum;
+  // Install the flows of each tunnel in one atomic openflow bundle
+  bool of_bundles;
 } ovs_config_t;
 
 typedef struct sgw_config_s {
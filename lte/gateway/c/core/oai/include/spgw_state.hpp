@@ -53,7 +53,13 @@ hash_table_ts_t* get_spgw_teid_state(void);
 int read_spgw_ue_state_db(void);
 
 /**
- * Saves an UE context state to db
+ * Marks an UE context state modified, so that it is saved to db again
+ * @param imsi64
+ */
+void mark_spgw_ue_state_dirty(imsi64_t imsi64);
+
+/**
+ * Saves an UE context state to db if it was marked modified
  * @param s11_bearer_context_info SPGW ue context pointer
  * @param imsi64
  */
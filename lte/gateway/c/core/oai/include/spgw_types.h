@@ -75,6 +75,8 @@ typedef struct sgw_s11_teid_s {
 
 typedef struct spgw_ue_context_s {
   LIST_HEAD(teid_list_head_s, sgw_s11_teid_s) sgw_s11_teid_list;
+  // Persisted copy of this context, see UE_STATE_MARK_DIRTY
+  ue_state_sync_t state_sync;
 } spgw_ue_context_t;
 
 // Data entry for s11teid2mme
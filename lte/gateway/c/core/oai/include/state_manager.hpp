@@ -34,9 +34,12 @@ extern "C" {
 }
 #endif
 
+#include <memory>
 #include <unordered_map>
+#include <utility>
 #include "lte/gateway/c/core/oai/common/conversions.h"
 #include "lte/gateway/c/core/oai/common/redis_utils/redis_client.hpp"
+#include "lte/gateway/c/core/oai/common/redis_utils/redis_writer_pool.hpp"
 
 namespace {
 constexpr char IMSI_PREFIX[] = "IMSI";
@@ -88,6 +91,7 @@ class StateManager {
   virtual status_code_e read_state_from_db() {
 #if !MME_UNIT_TEST
     if (persist_state_enabled) {
+      flush_redis_writes();
       ProtoType state_proto = ProtoType();
       if (redis_client->read_proto(table_key, state_proto) != RETURNok) {
         OAILOG_DEBUG(LOG_MME_APP, "Failed to read proto from db \n");
@@ -107,6 +111,7 @@ class StateManager {
     if (!persist_state_enabled) {
       return RETURNok;
     }
+    flush_redis_writes();
     auto keys = redis_client->get_keys("IMSI*" + task_name + "*");
     for (const auto& key : keys) {
       ProtoUe ue_proto = ProtoUe();
@@ -115,11 +120,11 @@ class StateManager {
         return RETURNerror;
       }
 
-      // Update each UE state version from redis
-      this->ue_state_version[key] = redis_client->read_version(table_key);
-
       StateConverter::proto_to_ue(ue_proto, ue_context);
 
+      // Update the UE state version from redis
+      ue_context->state_sync.version = redis_client->read_version(key);
+
       hashtable_ts_insert(state_ue_ht, get_imsi_from_key(key),
                           (void*)ue_context);
       OAILOG_DEBUG(log_task, "Reading UE state from db for %s", key.c_str());
@@ -146,10 +151,17 @@ class StateManager {
       std::string proto_str;
       redis_client->serialize(state_proto, proto_str);
       std::size_t new_hash = std::hash<std::string>{}(proto_str);
-
-      if (new_hash != this->task_state_hash) {
-        if (redis_client->write_proto_str(
-                table_key, proto_str, this->task_state_version) != RETURNok) {
+      // The writers report failed writes, the state is then written again
+      bool write_failed =
+          redis_writers && redis_writers->take_failed(table_key);
+
+      if (write_failed || new_hash != this->task_state_hash) {
+        if (redis_writers) {
+          redis_writers->write_proto_str(table_key, std::move(proto_str),
+                                         this->task_state_version);
+        } else if (redis_client->write_proto_str(table_key, proto_str,
+                                                 this->task_state_version) !=
+                   RETURNok) {
           OAILOG_ERROR(log_task, "Failed to write state to db");
           return;
         }
@@ -161,12 +173,27 @@ class StateManager {
     }
   }
 
-  virtual void write_ue_state_to_db(const UeContextType* ue_context,
+  /**
+   * Writes UE state to db if it was marked dirty since it was last written,
+   * or if the writer threads failed to write it
+   * @param ue_context UE context, its state_sync is updated on write
+   * @param imsi_str IMSI of the UE
+   */
+  virtual void write_ue_state_to_db(UeContextType* ue_context,
                                     const std::string& imsi_str) {
     AssertFatal(
         is_initialized,
         "StateManager init() function should be called to initialize state");
 
+    ue_state_sync_t* state_sync = &ue_context->state_sync;
+    std::string key = IMSI_PREFIX + imsi_str + ":" + task_name;
+    // A write the writers failed to apply is retried even if the UE state did
+    // not change since
+    bool write_failed = redis_writers && redis_writers->take_failed(key);
+    if (!write_failed && !UE_STATE_IS_DIRTY(ue_context)) {
+      return;
+    }
+
 #if MME_BENCHMARK
     auto start = std::chrono::high_resolution_clock::now();
 #endif
@@ -183,14 +210,16 @@ class StateManager {
                      .count()
               << std::endl;
 #endif
-    if (new_hash != this->ue_state_hash[imsi_str]) {
-      std::string key = IMSI_PREFIX + imsi_str + ":" + task_name;
-
+    if (write_failed || new_hash != state_sync->hash) {
 #if MME_BENCHMARK
       start = std::chrono::high_resolution_clock::now();
 #endif
-      if (redis_client->write_proto_str(
-              key, proto_str, ue_state_version[imsi_str]) != RETURNok) {
+      if (redis_writers) {
+        redis_writers->write_proto_str(key, std::move(proto_str),
+                                       state_sync->version);
+      } else if (redis_client->write_proto_str(key, proto_str,
+                                               state_sync->version) !=
+                 RETURNok) {
         OAILOG_ERROR(log_task, "Failed to write UE state to db for IMSI %s",
                      imsi_str.c_str());
         return;
@@ -203,11 +232,12 @@ class StateManager {
                        .count()
                 << std::endl;
 #endif
-      this->ue_state_version[imsi_str]++;
-      this->ue_state_hash[imsi_str] = new_hash;
+      state_sync->version++;
+      state_sync->hash = new_hash;
       OAILOG_DEBUG(log_task, "Finished writing UE state for IMSI %s",
                    imsi_str.c_str());
     }
+    state_sync->persisted_generation = state_sync->generation;
   }
 
   std::string get_imsi_str(imsi64_t imsi64) {
@@ -228,6 +258,11 @@ class StateManager {
     if (persist_state_enabled) {
       std::vector<std::string> keys = {IMSI_PREFIX + imsi_str + ":" +
                                        task_name};
+      if (redis_writers) {
+        // Queued behind the pending writes of the UE
+        redis_writers->clear_keys(keys);
+        return;
+      }
       if (redis_client->clear_keys(keys) != RETURNok) {
         OAILOG_ERROR(log_task, "Failed to remove UE state from db");
         return;
@@ -243,6 +278,32 @@ class StateManager {
 
   bool is_persist_state_enabled() const { return persist_state_enabled; }
 
+  /**
+   * Moves the state writes to num_workers threads, the writes of one UE stay
+   * ordered. The task thread then no longer waits for redis after each
+   * message.
+   */
+  void start_redis_writers(uint32_t num_workers) {
+    if (persist_state_enabled && num_workers > 0) {
+#if !MME_UNIT_TEST
+      redis_writers =
+          std::make_unique<RedisWriterPool>(num_workers, true, log_task);
+#else
+      redis_writers =
+          std::make_unique<RedisWriterPool>(num_workers, false, log_task);
+#endif
+    }
+  }
+
+  // Applies the queued writes and stops the writer threads
+  void stop_redis_writers() { redis_writers.reset(); }
+
+  void flush_redis_writes() {
+    if (redis_writers) {
+      redis_writers->flush();
+    }
+  }
+
  protected:
   StateManager()
       : state_cache_p(nullptr),
@@ -252,9 +313,7 @@ class StateManager {
         state_dirty(false),
         persist_state_enabled(false),
         task_state_version(0),
-        ue_state_version(0),
         task_state_hash(0),
-        ue_state_hash(0),
         log_task(LOG_UTIL) {}
   virtual ~StateManager() = default;
 
@@ -276,18 +335,18 @@ class StateManager {
   hash_table_ts_t* state_ue_ht;
   // TODO: Revisit one shared connection for all types of state
   std::unique_ptr<RedisClient> redis_client;
+  // Set when the state is written from worker threads
+  std::unique_ptr<RedisWriterPool> redis_writers;
   // Flag for check asserting if the state has been initialized.
   bool is_initialized;
   // Flag for check asserting that write should be done after read.
   bool state_dirty;
   // Flag for enabling writing and reading to db.
   bool persist_state_enabled;
-  // State version counters for task and ue context
+  // State version counter and last written hash value for task state, the
+  // ones of each UE state are kept in the UE context
   uint64_t task_state_version;
-  std::unordered_map<std::string, uint64_t> ue_state_version;
-  // Last written hash values for task and ue context
   std::size_t task_state_hash;
-  std::unordered_map<std::string, std::size_t> ue_state_hash;
 
  protected:
   std::string table_key;
@@ -28,6 +28,8 @@
 #define UDP_INIT(mSGpTR) (mSGpTR)->ittiMsg.udp_init
 #define UDP_DATA_MAX_MSG_LEN \
   (4096) /**< Maximum supported gtpv2c packet length including header */
+#define UDP_DATA_IND_BATCH_MAX_DATAGRAMS \
+  (32) /**< Maximum number of datagrams in one UDP_DATA_IND_BATCH */
 
 typedef struct {
   struct in_addr* in_addr;
@@ -55,4 +57,23 @@ typedef struct {
   uint16_t peer_port;
 } udp_data_ind_t;
 
+typedef struct {
+  uint32_t buffer_offset; /**< Offset of the payload in the batch buffer */
+  uint32_t buffer_length;
+  union {
+    struct sockaddr_in addrv4;
+    struct sockaddr_in6 addrv6;
+  } sock_addr;
+  uint16_t peer_port;
+} udp_datagram_t;
+
+/* Datagrams read from one socket by a single recvmmsg call. The payloads are
+ * stored back to back in buffer, which is freed with the message. */
+typedef struct {
+  uint8_t* buffer;
+  uint16_t local_port;
+  uint32_t num_datagrams;
+  udp_datagram_t datagrams[UDP_DATA_IND_BATCH_MAX_DATAGRAMS];
+} udp_data_ind_batch_t;
+
 #endif /* FILE_UDP_MESSAGES_TYPES_SEEN */
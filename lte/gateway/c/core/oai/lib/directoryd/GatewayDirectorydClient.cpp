@@ -63,6 +63,20 @@ bool GatewayDirectoryServiceClient::UpdateRecord(
   return GatewayDirectoryServiceClient::updateRecordImpl(request, callback);
 }
 
+bool GatewayDirectoryServiceClient::UpdateRecord(
+    const std::string& id, const std::string& location,
+    const std::map<std::string, std::string>& fields,
+    std::function<void(Status, Void)> callback) {
+  UpdateRecordRequest request;
+  request.set_id(id);
+  request.set_location(location);
+  auto update_fields = request.mutable_fields();
+  for (const auto& field : fields) {
+    update_fields->insert({field.first, field.second});
+  }
+  return GatewayDirectoryServiceClient::updateRecordImpl(request, callback);
+}
+
 bool GatewayDirectoryServiceClient::UpdateRecordField(
     const std::string& id, const std::string& field_key,
     const std::string& field_value,
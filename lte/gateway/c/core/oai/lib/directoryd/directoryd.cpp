@@ -16,57 +16,139 @@
  */
 
 #include <grpcpp/impl/codegen/status.h>
+#include <map>
 #include <string>
 #include <iostream>
+#include <utility>
 
 #include "lte/gateway/c/core/oai/lib/directoryd/GatewayDirectorydClient.hpp"
 #include "lte/gateway/c/core/oai/lib/directoryd/directoryd.hpp"
+#include "orc8r/gateway/c/common/async_grpc/ReportQueue.hpp"
+#include "orc8r/gateway/c/common/service303/MetricsHelpers.hpp"
 #include "orc8r/protos/common.pb.h"
 #include "orc8r/protos/directoryd.pb.h"
 
-static void directoryd_rpc_call_done(const grpc::Status& status);
+namespace {
 
-bool directoryd_report_location(char* imsi) {
-  // Actual GW_ID will be filled in the cloud
+/*
+ * Pending changes to the directory record of a subscriber. A removal drops
+ * the updates queued before it, an update queued after a removal is sent
+ * once the record is deleted.
+ */
+struct RecordChange {
+  bool remove = false;
+  bool update = false;
+  std::string location;
+  std::map<std::string, std::string> fields;
+};
+
+using RecordQueue = magma::ReportQueue<std::string, RecordChange>;
+
+void merge_record_change(RecordChange& pending, RecordChange&& newer) {
+  if (newer.remove) {
+    pending.remove = true;
+    pending.update = false;
+    pending.location.clear();
+    pending.fields.clear();
+  }
+  if (newer.update) {
+    pending.update = true;
+    if (!newer.location.empty()) {
+      pending.location = std::move(newer.location);
+    }
+    for (auto& field : newer.fields) {
+      pending.fields[field.first] = std::move(field.second);
+    }
+  }
+}
+
+magma::ReportResult directoryd_rpc_result(const grpc::Status& status,
+                                          bool remove) {
+  if (status.ok() ||
+      (remove && status.error_code() == grpc::StatusCode::NOT_FOUND)) {
+    return magma::ReportResult::DELIVERED;
+  }
+  std::cerr << "Directoryd RPC failed with code " << status.error_code()
+            << ", msg: " << status.error_message() << std::endl;
+  if (status.error_code() == grpc::StatusCode::UNAVAILABLE ||
+      status.error_code() == grpc::StatusCode::DEADLINE_EXCEEDED) {
+    return magma::ReportResult::RETRY;
+  }
+  return magma::ReportResult::FAILED;
+}
+
+void send_record_update(const std::string& id, const RecordChange& change,
+                        RecordQueue::DoneFn done) {
   magma::GatewayDirectoryServiceClient::UpdateRecord(
-      "IMSI" + std::string(imsi), std::string("GW_ID"),
-      [&](grpc::Status status, magma::Void response) {
-        directoryd_rpc_call_done(status);
+      id, change.location, change.fields,
+      [done](grpc::Status status, magma::Void) {
+        done(directoryd_rpc_result(status, false));
       });
-  return true;
 }
 
-bool directoryd_remove_location(char* imsi) {
+void send_record_change(const std::string& id, const RecordChange& change,
+                        RecordQueue::DoneFn done) {
+  if (!change.remove) {
+    send_record_update(id, change, done);
+    return;
+  }
   magma::GatewayDirectoryServiceClient::DeleteRecord(
-      "IMSI" + std::string(imsi),
-      [&](grpc::Status status, magma::Void response) {
-        directoryd_rpc_call_done(status);
+      id, [id, change, done](grpc::Status status, magma::Void) {
+        magma::ReportResult result = directoryd_rpc_result(status, true);
+        if (result != magma::ReportResult::DELIVERED || !change.update) {
+          done(result);
+          return;
+        }
+        send_record_update(id, change, done);
       });
-  return true;
 }
 
-bool directoryd_update_location(char* imsi, char* location) {
-  magma::GatewayDirectoryServiceClient::UpdateRecord(
-      "IMSI" + std::string(imsi), std::string(location),
-      [&](grpc::Status status, magma::Void response) {
-        directoryd_rpc_call_done(status);
-      });
-  return true;
+RecordQueue& get_record_queue() {
+  // Never destroyed, RPC completions may still reach it at exit
+  static RecordQueue* queue = [] {
+    auto queue = new RecordQueue(
+        magma::ReportQueueConfig(), merge_record_change, send_record_change,
+        [](const char* reason) {
+          increment_counter("directoryd_reports_dropped", 1, 1, "reason",
+                            reason);
+        });
+    queue->start();
+    return queue;
+  }();
+  return *queue;
 }
 
-bool directoryd_update_record_field(char* imsi, char* key, char* value) {
+bool queue_record_change(char* imsi, RecordChange change) {
+  return get_record_queue().enqueue("IMSI" + std::string(imsi),
+                                    std::move(change));
+}
+
+}  // namespace
+
+bool directoryd_report_location(char* imsi) {
+  RecordChange change;
+  change.update = true;
   // Actual GW_ID will be filled in the cloud
-  magma::GatewayDirectoryServiceClient::UpdateRecordField(
-      "IMSI" + std::string(imsi), std::string(key), std::string(value),
-      [&](grpc::Status status, magma::Void response) {
-        directoryd_rpc_call_done(status);
-      });
-  return true;
+  change.location = "GW_ID";
+  return queue_record_change(imsi, std::move(change));
 }
 
-void directoryd_rpc_call_done(const grpc::Status& status) {
-  if (!status.ok() || !grpc::StatusCode::NOT_FOUND) {
-    std::cerr << "Directoryd RPC failed with code " << status.error_code()
-              << ", msg: " << status.error_message() << std::endl;
-  }
+bool directoryd_remove_location(char* imsi) {
+  RecordChange change;
+  change.remove = true;
+  return queue_record_change(imsi, std::move(change));
+}
+
+bool directoryd_update_location(char* imsi, char* location) {
+  RecordChange change;
+  change.update = true;
+  change.location = location;
+  return queue_record_change(imsi, std::move(change));
+}
+
+bool directoryd_update_record_field(char* imsi, char* key, char* value) {
+  RecordChange change;
+  change.update = true;
+  change.fields[key] = value;
+  return queue_record_change(imsi, std::move(change));
 }
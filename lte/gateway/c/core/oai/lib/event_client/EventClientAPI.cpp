@@ -17,12 +17,16 @@
 
 #include "lte/gateway/c/core/oai/lib/event_client/EventClientAPI.hpp"
 
-#include <iostream>
+#include <atomic>
 #include <thread>
+#include <utility>
 #include <grpcpp/support/status.h>
 #include <orc8r/protos/common.pb.h>
 
+#include "orc8r/gateway/c/common/async_grpc/ReportQueue.hpp"
 #include "orc8r/gateway/c/common/eventd/EventdClient.hpp"
+#include "orc8r/gateway/c/common/logging/magma_logging.hpp"
+#include "orc8r/gateway/c/common/service303/MetricsHelpers.hpp"
 
 using grpc::Status;
 using grpc::StatusCode::DEADLINE_EXCEEDED;
@@ -34,27 +38,58 @@ using magma::orc8r::Void;
 namespace magma {
 namespace lte {
 
+namespace {
+
+// Events are not merged, each gets its own key
+using EventQueue = ReportQueue<uint64_t, Event>;
+
+void send_event(const uint64_t& seq, const Event& event,
+                EventQueue::DoneFn done) {
+  AsyncEventdClient::getInstance().log_event(
+      event, [event, done](Status status, Void v) {
+        if (status.ok()) {
+          MLOG(MDEBUG) << "Success logging event: " << event.event_type();
+          done(ReportResult::DELIVERED);
+          return;
+        }
+        if (status.error_code() == DEADLINE_EXCEEDED ||
+            status.error_code() == UNAVAILABLE) {
+          // Suppress error logs if EventD is unavailable
+          done(ReportResult::RETRY);
+          return;
+        }
+        MLOG(MERROR) << "Failed to log event: " << event.event_type()
+                     << "; Status: " << status.error_message();
+        done(ReportResult::FAILED);
+      });
+}
+
+EventQueue& get_event_queue() {
+  // Never destroyed, RPC completions may still reach it at exit
+  static EventQueue* queue = [] {
+    return new EventQueue(
+        ReportQueueConfig(),
+        [](Event& pending, Event&& newer) { pending = std::move(newer); },
+        send_event, [](const char* reason) {
+          increment_counter("eventd_reports_dropped", 1, 1, "reason", reason);
+        });
+  }();
+  return *queue;
+}
+
+std::atomic<uint64_t> event_seq{0};
+
+}  // namespace
+
 void init_eventd_client() {
   auto& client = AsyncEventdClient::getInstance();
   std::thread resp_loop_thread([&]() { client.rpc_response_loop(); });
   resp_loop_thread.detach();
+  get_event_queue().start();
 }
 
 int log_event(const Event& event) {
-  AsyncEventdClient::getInstance().log_event(event, [=](Status status, Void v) {
-    if (status.ok()) {
-      std::cout << "[DEBUG] Success logging event: " << event.event_type()
-                << std::endl;
-      return 0;
-    }
-    if (status.error_code() == DEADLINE_EXCEEDED ||
-        status.error_code() == UNAVAILABLE) {
-      return 0;  // Suppress error logs if EventD is unavailable
-    }
-    std::cout << "[ERROR] Failed to log event: " << event.event_type()
-              << "; Status: " << status.error_message() << std::endl;
-    return int(status.error_code());
-  });
+  get_event_queue().enqueue(event_seq++, event);
   return 0;
 }
 
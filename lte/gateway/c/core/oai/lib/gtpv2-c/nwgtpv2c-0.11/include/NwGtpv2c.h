@@ -633,16 +633,17 @@ nw_rc_t nwGtpv2cProcessUlpReq(NW_IN nw_gtpv2c_stack_handle_t hGtpcStackHandle,
 
  @param[in] loop : ZMQ zloop_t pointer, unused .
  @param[in] timer_id : unused.
- @param[in] arg : Pointer timeout arguments.
+ @param[in] arg : Timer argument given to tmrStartCallback, the stack.
  @return NW_OK on success.
  */
 nw_rc_t nwGtpv2cProcessTimeoutExt(NW_IN zloop_t* loop, NW_IN int timer_id,
                                   NW_IN void* arg);
 
 /**
- Process Timer timeout Request from Timer Manager
+ Process Timer timeout Request from Timer Manager. The stack runs a single
+ timer of the Timer Manager at a time and expires all its due timers here.
 
- @param[in] arg : Pointer timeout arguments.
+ @param[in] arg : Timer argument given to tmrStartCallback, the stack.
  @return NW_OK on success.
  */
 nw_rc_t nwGtpv2cProcessTimeout(void* arg);
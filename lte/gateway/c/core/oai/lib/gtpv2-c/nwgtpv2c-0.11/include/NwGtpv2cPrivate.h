@@ -85,6 +85,55 @@ extern "C" {
     }                                                                      \
   } while (0)
 
+/*--------------------------------------------------------------------------*
+ *  T R A N S A C T I O N   A N D   T I M E R   T A B L E S                 *
+ *--------------------------------------------------------------------------*/
+
+#define NW_GTPV2C_TRXN_MAP_INITIAL_SIZE (1024)
+#define NW_GTPV2C_TRXN_MAP_LOAD_FACTOR (2)
+
+/**
+ * Outstanding transactions hashed on peer address and sequence number. The
+ * number of buckets is a power of 2 and doubles when the average chain gets
+ * longer than NW_GTPV2C_TRXN_MAP_LOAD_FACTOR.
+ */
+
+LIST_HEAD(nw_gtpv2c_trxn_list_s, nw_gtpv2c_trxn_s);
+
+typedef struct nw_gtpv2c_trxn_map_s {
+  struct nw_gtpv2c_trxn_list_s* buckets;
+  uint32_t size;
+  uint32_t count;
+  bool matchPeerPort; /**< RX transactions are also keyed on the peer port */
+} nw_gtpv2c_trxn_map_t;
+
+#define NW_GTPV2C_TMR_WHEEL_TICK_MS (10)
+#define NW_GTPV2C_TMR_WHEEL_INITIAL_SIZE (1024)
+#define NW_GTPV2C_TMR_WHEEL_LOAD_FACTOR (4)
+
+/**
+ * Hashed timing wheel of NW_GTPV2C_TMR_WHEEL_TICK_MS ticks. A timer sits in
+ * the slot of its expiry tick modulo the number of slots, so timers further
+ * than one revolution away share slots with earlier ones and are skipped
+ * until their tick is reached. The number of slots is a power of 2 and
+ * doubles when the average slot holds more than
+ * NW_GTPV2C_TMR_WHEEL_LOAD_FACTOR timers. Only one timer of the ULP timer
+ * manager runs per stack, armed for the next slot holding timers.
+ */
+
+LIST_HEAD(nw_gtpv2c_timeout_info_list_s, nw_gtpv2c_timeout_info_s);
+
+typedef struct nw_gtpv2c_timer_wheel_s {
+  struct nw_gtpv2c_timeout_info_list_s* slots;
+  uint32_t size;
+  uint32_t count;
+  uint64_t currTick;  /**< Ticks up to this one have expired */
+  bool expiring;      /**< Growing is deferred while timers expire */
+  bool ulpTmrRunning; /**< The ULP timer is armed for ulpTmrTick */
+  uint64_t ulpTmrTick;
+  nw_gtpv2c_timer_handle_t hUlpTmr;
+} nw_gtpv2c_timer_wheel_t;
+
 /*--------------------------------------------------------------------------*
  *  G T P V 2 C   S T A C K   O B J E C T   T Y P E    D E F I N I T I O N  *
  *--------------------------------------------------------------------------*/
@@ -106,15 +155,17 @@ typedef struct nw_gtpv2c_stack_s {
   uint32_t restartCounter;
 
   nw_gtpv2c_msg_ie_parse_info_t* pGtpv2cMsgIeParseInfo[NW_GTP_MSG_END];
-  struct nw_gtpv2c_timeout_info_s* activeTimerInfo;
 
   RB_HEAD(NwGtpv2cTunnelMap, nw_gtpv2c_tunnel_s) tunnelMap;
-  RB_HEAD(NwGtpv2cOutstandingTxSeqNumTrxnMap, nw_gtpv2c_trxn_s)
-  outstandingTxSeqNumMap;
-  RB_HEAD(NwGtpv2cOutstandingRxSeqNumTrxnMap, nw_gtpv2c_trxn_s)
-  outstandingRxSeqNumMap;
-  RB_HEAD(NwGtpv2cActiveTimerList, nw_gtpv2c_timeout_info_s) activeTimerList;
-  NwPtrT hTmrMinHeap;
+  nw_gtpv2c_trxn_map_t outstandingTxSeqNumMap;
+  nw_gtpv2c_trxn_map_t outstandingRxSeqNumMap;
+  nw_gtpv2c_timer_wheel_t timerWheel;
+
+  /* Free lists of the stack, only touched by the thread running it */
+  struct nw_gtpv2c_msg_s* pMsgPool;
+  struct nw_gtpv2c_trxn_s* pTrxnPool;
+  struct nw_gtpv2c_timeout_info_s* pTimeoutInfoPool;
+  struct nw_gtpv2c_tunnel_s* pTunnelPool;
 } nw_gtpv2c_stack_t;
 
 /*--------------------------------------------------------------------------*
@@ -127,14 +178,11 @@ typedef struct nw_gtpv2c_stack_s {
 
 typedef struct nw_gtpv2c_timeout_info_s {
   nw_gtpv2c_stack_handle_t hStack;
-  struct timeval tvTimeout;
+  uint64_t expiryTick; /**< 0 when the timer is not running */
   uint32_t tmrType;
   void* timeoutArg;
   nw_rc_t (*timeoutCallbackFunc)(void*);
-  nw_gtpv2c_timer_handle_t hTimer;
-  RB_ENTRY(nw_gtpv2c_timeout_info_s)
-  activeTimerListRbtNode; /**< RB Tree Data Structure Node        */
-  uint32_t timerMinHeapIndex;
+  LIST_ENTRY(nw_gtpv2c_timeout_info_s) wheelNode;
   struct nw_gtpv2c_timeout_info_s* next;
 } nw_gtpv2c_timeout_info_t;
 
@@ -196,10 +244,8 @@ typedef struct nw_gtpv2c_trxn_s {
   nw_gtpv2c_tunnel_handle_t hTunnel; /**< Handle to local tunnel context     */
   nw_gtpv2c_ulp_trxn_handle_t hUlpTrxn; /**< Handle to ULP tunnel context */
   uint8_t trx_flags; /**< Flags in the trx to be signalized back. */
-  RB_ENTRY(nw_gtpv2c_trxn_s)
-  outstandingTxSeqNumMapRbtNode; /**< RB Tree Data Structure Node        */
-  RB_ENTRY(nw_gtpv2c_trxn_s)
-  outstandingRxSeqNumMapRbtNode; /**< RB Tree Data Structure Node        */
+  LIST_ENTRY(nw_gtpv2c_trxn_s)
+  trxnMapNode; /**< In the outstanding TX or RX transaction map */
   struct nw_gtpv2c_trxn_s* next;
 } nw_gtpv2c_trxn_t;
 
@@ -220,12 +266,6 @@ typedef struct NwGtpv2cPathS {
 
 RB_PROTOTYPE(NwGtpv2cTunnelMap, nw_gtpv2c_tunnel_s, tunnelMapRbtNode,
              nwGtpv2cCompareTunnel)
-RB_PROTOTYPE(NwGtpv2cOutstandingTxSeqNumTrxnMap, nw_gtpv2c_trxn_s,
-             outstandingTxSeqNumMapRbtNode, nwGtpv2cCompareSeqNum)
-RB_PROTOTYPE(NwGtpv2cOutstandingRxSeqNumTrxnMap, nw_gtpv2c_trxn_s,
-             outstandingRxSeqNumMapRbtNode, nwGtpv2cCompareSeqNum)
-RB_PROTOTYPE(NwGtpv2cActiveTimerList, nw_gtpv2c_timeout_info_s,
-             activeTimerListRbtNode, nwGtpv2cCompareOutstandingTxRexmitTime)
 
 /**
  * Start Timer with ULP Timer Manager
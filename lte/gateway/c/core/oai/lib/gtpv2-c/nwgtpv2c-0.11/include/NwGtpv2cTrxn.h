@@ -78,6 +78,58 @@ nw_gtpv2c_trxn_t* nwGtpv2cTrxnOutstandingRxNew(NW_IN nw_gtpv2c_stack_t* pStack,
 
 nw_rc_t nwGtpv2cTrxnDelete(NW_INOUT nw_gtpv2c_trxn_t** ppTrxn);
 
+/**
+ * Initialize an empty outstanding transaction map.
+ *
+ * @param[in] map : Pointer to the map.
+ * @param[in] matchPeerPort : Whether the peer port is part of the key.
+ * @return NW_OK on success.
+ */
+
+nw_rc_t nwGtpv2cTrxnMapInit(NW_INOUT nw_gtpv2c_trxn_map_t* map,
+                            NW_IN bool matchPeerPort);
+
+/**
+ * Free the map with the transactions left in it, for the destruction of the
+ * stack.
+ *
+ * @param[in] map : Pointer to the map.
+ */
+
+void nwGtpv2cTrxnMapPurge(NW_INOUT nw_gtpv2c_trxn_map_t* map);
+
+/**
+ * Insert a transaction in the map.
+ *
+ * @param[in] map : Pointer to the map.
+ * @param[in] thiz : Transaction to insert.
+ * @return NULL on success, else the transaction with the same key.
+ */
+
+nw_gtpv2c_trxn_t* nwGtpv2cTrxnMapInsert(NW_INOUT nw_gtpv2c_trxn_map_t* map,
+                                        NW_IN nw_gtpv2c_trxn_t* thiz);
+
+/**
+ * Find the transaction with the same key as key.
+ *
+ * @param[in] map : Pointer to the map.
+ * @param[in] key : Transaction holding the peer and the sequence number.
+ * @return The transaction or NULL.
+ */
+
+nw_gtpv2c_trxn_t* nwGtpv2cTrxnMapFind(NW_IN nw_gtpv2c_trxn_map_t* map,
+                                      NW_IN nw_gtpv2c_trxn_t* key);
+
+/**
+ * Remove a transaction inserted in the map.
+ *
+ * @param[in] map : Pointer to the map.
+ * @param[in] thiz : Transaction to remove.
+ */
+
+void nwGtpv2cTrxnMapRemove(NW_INOUT nw_gtpv2c_trxn_map_t* map,
+                           NW_IN nw_gtpv2c_trxn_t* thiz);
+
 /**
  * Start timer to wait before pruginf a req tran for which response has been
  * sent
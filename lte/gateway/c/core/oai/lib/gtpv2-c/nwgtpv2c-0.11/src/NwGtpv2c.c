@@ -34,6 +34,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <inttypes.h>
 #include <stdbool.h>
 
@@ -51,38 +52,6 @@
 #include "lte/gateway/c/core/oai/lib/gtpv2-c/nwgtpv2c-0.11/shared/NwTypes.h"
 #include "lte/gateway/c/core/oai/lib/gtpv2-c/nwgtpv2c-0.11/shared/NwUtils.h"
 
-#ifdef _NWGTPV2C_HAVE_TIMERADD
-#define NW_GTPV2C_TIMER_ADD(tvp, uvp, vvp) timeradd((tvp), (uvp), (vvp))
-#define NW_GTPV2C_TIMER_SUB(tvp, uvp, vvp) timersub((tvp), (uvp), (vvp))
-#define NW_GTPV2C_TIMER_CMP_P(a, b, CMP) timercmp(a, b, CMP)
-#else
-
-#define NW_GTPV2C_TIMER_ADD(tvp, uvp, vvp)            \
-  do {                                                \
-    (vvp)->tv_sec = (tvp)->tv_sec + (uvp)->tv_sec;    \
-    (vvp)->tv_usec = (tvp)->tv_usec + (uvp)->tv_usec; \
-    if ((vvp)->tv_usec >= 1000000) {                  \
-      (vvp)->tv_sec++;                                \
-      (vvp)->tv_usec -= 1000000;                      \
-    }                                                 \
-  } while (0)
-
-#define NW_GTPV2C_TIMER_SUB(tvp, uvp, vvp)            \
-  do {                                                \
-    (vvp)->tv_sec = (tvp)->tv_sec - (uvp)->tv_sec;    \
-    (vvp)->tv_usec = (tvp)->tv_usec - (uvp)->tv_usec; \
-    if ((vvp)->tv_usec < 0) {                         \
-      (vvp)->tv_sec--;                                \
-      (vvp)->tv_usec += 1000000;                      \
-    }                                                 \
-  } while (0)
-
-#define NW_GTPV2C_TIMER_CMP_P(a, b, CMP)                         \
-  (((a)->tv_sec == (b)->tv_sec) ? ((a)->tv_usec CMP(b)->tv_usec) \
-                                : ((a)->tv_sec CMP(b)->tv_sec))
-
-#endif
-
 #define NW_GTPV2C_INIT_MSG_IE_PARSE_INFO(__thiz, __msgType)               \
   do {                                                                    \
     __thiz->pGtpv2cMsgIeParseInfo[__msgType] = nwGtpv2cMsgIeParseInfoNew( \
@@ -95,118 +64,146 @@
 extern "C" {
 #endif
 
-static nw_gtpv2c_timeout_info_t* gpGtpv2cTimeoutInfoPool = NULL;
-
-typedef struct {
-  int currSize;
-  int maxSize;
-  nw_gtpv2c_timeout_info_t** pHeap;
-} NwGtpv2cTmrMinHeapT;
-
-#define NW_HEAP_PARENT_INDEX(__child) (((__child)-1) / 2)
-
-NwGtpv2cTmrMinHeapT* nwGtpv2cTmrMinHeapNew(int maxSize) {
-  NwGtpv2cTmrMinHeapT* thiz =
-      (NwGtpv2cTmrMinHeapT*)malloc(sizeof(NwGtpv2cTmrMinHeapT));
+/*---------------------------------------------------------------------------
+   Timer wheel
+  --------------------------------------------------------------------------*/
 
-  if (thiz) {
-    thiz->currSize = 0;
-    thiz->maxSize = maxSize;
-    thiz->pHeap = (nw_gtpv2c_timeout_info_t**)malloc(
-        maxSize * sizeof(nw_gtpv2c_timeout_info_t*));
-  }
+static uint64_t nwGtpv2cTmrWheelNow(void) {
+  struct timespec ts;
 
-  return thiz;
+  NW_ASSERT(clock_gettime(CLOCK_MONOTONIC, &ts) == 0);
+  return ((uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000) /
+         NW_GTPV2C_TMR_WHEEL_TICK_MS;
 }
 
-void nwGtpv2cTmrMinHeapDelete(NwGtpv2cTmrMinHeapT* thiz) {
-  free_wrapper((void**)&thiz->pHeap);
-  free_wrapper((void**)&thiz);
+static nw_rc_t nwGtpv2cTmrWheelInit(nw_gtpv2c_timer_wheel_t* wheel) {
+  memset(wheel, 0, sizeof(*wheel));
+  wheel->slots = calloc(NW_GTPV2C_TMR_WHEEL_INITIAL_SIZE,
+                        sizeof(struct nw_gtpv2c_timeout_info_list_s));
+  wheel->size = NW_GTPV2C_TMR_WHEEL_INITIAL_SIZE;
+  return wheel->slots ? NW_OK : NW_FAILURE;
 }
 
-static nw_rc_t nwGtpv2cTmrMinHeapInsert(NwGtpv2cTmrMinHeapT* thiz,
-                                        nw_gtpv2c_timeout_info_t* pTimerEvent) {
-  int holeIndex = thiz->currSize++;
+static void nwGtpv2cTmrWheelInsert(nw_gtpv2c_timer_wheel_t* wheel,
+                                   nw_gtpv2c_timeout_info_t* timeoutInfo) {
+  LIST_INSERT_HEAD(
+      &wheel->slots[timeoutInfo->expiryTick & (wheel->size - 1)],
+      timeoutInfo, wheelNode);
+}
 
-  NW_ASSERT(thiz->currSize < thiz->maxSize);
+static void nwGtpv2cTmrWheelGrow(nw_gtpv2c_timer_wheel_t* wheel) {
+  struct nw_gtpv2c_timeout_info_list_s* oldSlots = wheel->slots;
+  uint32_t oldSize = wheel->size;
+  nw_gtpv2c_timeout_info_t* timeoutInfo;
 
-  while ((holeIndex > 0) &&
-         NW_GTPV2C_TIMER_CMP_P(
-             &(thiz->pHeap[NW_HEAP_PARENT_INDEX(holeIndex)])->tvTimeout,
-             &(pTimerEvent->tvTimeout), >)) {
-    thiz->pHeap[holeIndex] = thiz->pHeap[NW_HEAP_PARENT_INDEX(holeIndex)];
-    thiz->pHeap[holeIndex]->timerMinHeapIndex = holeIndex;
-    holeIndex = NW_HEAP_PARENT_INDEX(holeIndex);
+  wheel->slots =
+      calloc(2 * oldSize, sizeof(struct nw_gtpv2c_timeout_info_list_s));
+  if (!wheel->slots) {
+    // Keep the crowded slots, the timers still expire on time
+    wheel->slots = oldSlots;
+    return;
   }
+  wheel->size = 2 * oldSize;
+  for (uint32_t i = 0; i < oldSize; i++) {
+    while ((timeoutInfo = LIST_FIRST(&oldSlots[i])) != NULL) {
+      LIST_REMOVE(timeoutInfo, wheelNode);
+      nwGtpv2cTmrWheelInsert(wheel, timeoutInfo);
+    }
+  }
+  free_wrapper((void**)&oldSlots);
+}
 
-  thiz->pHeap[holeIndex] = pTimerEvent;
-  pTimerEvent->timerMinHeapIndex = holeIndex;
-  return holeIndex;
+/**
+  Arm the timer of the ULP timer manager for tick, replacing the running one.
+*/
+static nw_rc_t nwGtpv2cTmrWheelArm(nw_gtpv2c_stack_t* thiz, uint64_t tick,
+                                   uint64_t now) {
+  nw_gtpv2c_timer_wheel_t* wheel = &thiz->timerWheel;
+  nw_rc_t rc;
+
+  if (wheel->ulpTmrRunning) {
+    rc = thiz->tmrMgr.tmrStopCallback(thiz->tmrMgr.tmrMgrHandle,
+                                      wheel->hUlpTmr);
+    NW_ASSERT(NW_OK == rc);
+    wheel->ulpTmrRunning = false;
+  }
+  rc = thiz->tmrMgr.tmrStartCallback(
+      thiz->tmrMgr.tmrMgrHandle,
+      (tick > now) ? (tick - now) * NW_GTPV2C_TMR_WHEEL_TICK_MS : 0,
+      NW_GTPV2C_TMR_TYPE_ONE_SHOT, (void*)thiz, &wheel->hUlpTmr);
+  if (NW_OK == rc) {
+    wheel->ulpTmrRunning = true;
+    wheel->ulpTmrTick = tick;
+  }
+  return rc;
 }
 
-#define NW_MIN_HEAP_INDEX_INVALID (0xFFFFFFFF)
-static nw_rc_t nwGtpv2cTmrMinHeapRemove(NwGtpv2cTmrMinHeapT* thiz,
-                                        int minHeapIndex) {
-  nw_gtpv2c_timeout_info_t* pTimerEvent = NULL;
-  int holeIndex = minHeapIndex;
-  int minChild = 0, maxChild = 0;
-
-  if (minHeapIndex == NW_MIN_HEAP_INDEX_INVALID) return NW_FAILURE;
-
-  if (minHeapIndex < thiz->currSize) {
-    thiz->pHeap[minHeapIndex]->timerMinHeapIndex = NW_MIN_HEAP_INDEX_INVALID;
-    thiz->currSize--;
-    pTimerEvent = thiz->pHeap[thiz->currSize];
-    holeIndex = minHeapIndex;
-    minChild = (2 * holeIndex) + 1;
-    maxChild = minChild + 1;
-
-    while ((maxChild) <= thiz->currSize) {
-      if (NW_GTPV2C_TIMER_CMP_P(&(thiz->pHeap[minChild]->tvTimeout),
-                                &(thiz->pHeap[maxChild]->tvTimeout), >))
-        minChild = maxChild;
-
-      if (NW_GTPV2C_TIMER_CMP_P(&(pTimerEvent->tvTimeout),
-                                &(thiz->pHeap[minChild]->tvTimeout), <)) {
-        break;
-      }
+/**
+  Tick of the first slot holding timers. Timers of later revolutions make it
+  earlier than their expiry, the wake up then only moves the wheel forward.
+*/
+static uint64_t nwGtpv2cTmrWheelNextTick(nw_gtpv2c_timer_wheel_t* wheel) {
+  uint64_t tick = wheel->currTick + 1;
 
-      thiz->pHeap[holeIndex] = thiz->pHeap[minChild];
-      thiz->pHeap[holeIndex]->timerMinHeapIndex = holeIndex;
-      holeIndex = minChild;
-      minChild = (2 * holeIndex) + 1;
-      maxChild = minChild + 1;
+  for (uint32_t i = 0; i < wheel->size; i++, tick++) {
+    if (!LIST_EMPTY(&wheel->slots[tick & (wheel->size - 1)])) {
+      return tick;
     }
+  }
+  return tick;
+}
 
-    while ((holeIndex > 0) &&
-           NW_GTPV2C_TIMER_CMP_P(
-               &((thiz->pHeap[NW_HEAP_PARENT_INDEX(holeIndex)])->tvTimeout),
-               &(pTimerEvent->tvTimeout), >)) {
-      thiz->pHeap[holeIndex] = thiz->pHeap[NW_HEAP_PARENT_INDEX(holeIndex)];
-      thiz->pHeap[holeIndex]->timerMinHeapIndex = holeIndex;
-      holeIndex = NW_HEAP_PARENT_INDEX(holeIndex);
-    }
+/**
+  Fire the timers expired at now. The callbacks may start and stop timers,
+  so the scan of a slot restarts after each of them.
+*/
+static void nwGtpv2cTmrWheelExpire(nw_gtpv2c_stack_t* thiz, uint64_t now) {
+  nw_gtpv2c_timer_wheel_t* wheel = &thiz->timerWheel;
+  nw_gtpv2c_timeout_info_t* timeoutInfo;
+  uint64_t tick = wheel->currTick + 1;
 
-    if (holeIndex < thiz->currSize) {
-      thiz->pHeap[holeIndex] = pTimerEvent;
-      pTimerEvent->timerMinHeapIndex = holeIndex;
+  // Late by a revolution or more: every slot is visited once
+  if (now - wheel->currTick > wheel->size) {
+    tick = now - wheel->size + 1;
+  }
+  wheel->expiring = true;
+  for (; tick <= now; tick++) {
+    timeoutInfo = LIST_FIRST(&wheel->slots[tick & (wheel->size - 1)]);
+    while (timeoutInfo) {
+      if (timeoutInfo->expiryTick > now) {
+        timeoutInfo = LIST_NEXT(timeoutInfo, wheelNode);
+        continue;
+      }
+      LIST_REMOVE(timeoutInfo, wheelNode);
+      wheel->count--;
+      timeoutInfo->expiryTick = 0;
+      timeoutInfo->next = thiz->pTimeoutInfoPool;
+      thiz->pTimeoutInfoPool = timeoutInfo;
+      timeoutInfo->timeoutCallbackFunc(timeoutInfo->timeoutArg);
+      timeoutInfo = LIST_FIRST(&wheel->slots[tick & (wheel->size - 1)]);
     }
-
-    thiz->pHeap[thiz->currSize] = NULL;
-    return NW_OK;
   }
-
-  return NW_FAILURE;
+  wheel->currTick = now;
+  wheel->expiring = false;
+  if (wheel->count > wheel->size * NW_GTPV2C_TMR_WHEEL_LOAD_FACTOR) {
+    nwGtpv2cTmrWheelGrow(wheel);
+  }
 }
 
-static nw_gtpv2c_timeout_info_t* nwGtpv2cTmrMinHeapPeek(
-    NwGtpv2cTmrMinHeapT* thiz) {
-  if (thiz->currSize) {
-    return thiz->pHeap[0];
-  }
+static void nwGtpv2cTmrWheelPurge(nw_gtpv2c_stack_t* thiz) {
+  nw_gtpv2c_timer_wheel_t* wheel = &thiz->timerWheel;
+  nw_gtpv2c_timeout_info_t* timeoutInfo;
 
-  return NULL;
+  for (uint32_t i = 0; wheel->slots && i < wheel->size; i++) {
+    while ((timeoutInfo = LIST_FIRST(&wheel->slots[i])) != NULL) {
+      LIST_REMOVE(timeoutInfo, wheelNode);
+      NW_GTPV2C_FREE(thiz, timeoutInfo);
+    }
+  }
+  free_wrapper((void**)&wheel->slots);
+  wheel->count = 0;
 }
+
 /*--------------------------------------------------------------------------*
                       P R I V A T E    F U N C T I O N S
   --------------------------------------------------------------------------*/
@@ -393,130 +390,6 @@ static inline int32_t nwGtpv2cCompareTunnel(struct nw_gtpv2c_tunnel_s* a,
 RB_GENERATE(NwGtpv2cTunnelMap, nw_gtpv2c_tunnel_s, tunnelMapRbtNode,
             nwGtpv2cCompareTunnel)
 
-/*---------------------------------------------------------------------------
-   Transaction RBTree Search Data Structure
-  --------------------------------------------------------------------------*/
-/**
-  Comparator funtion for comparing two outstancing TX transactions.
-
-  @param[in] a: Pointer to session a.
-  @param[in] b: Pointer to session b.
-  @return  An integer greater than, equal to or less than zero according to
-  whether the object pointed to by a is greater than, equal to or less than the
-  object pointed to by b.
-*/
-static inline int32_t nwGtpv2cCompareOutstandingTxSeqNumTrxn(
-    struct nw_gtpv2c_trxn_s* a, struct nw_gtpv2c_trxn_s* b) {
-  if (a->seqNum > b->seqNum) return 1;
-
-  if (a->seqNum < b->seqNum) return -1;
-
-  /** Compare the sa_family. */
-  if (((struct sockaddr*)&a->peer_ip)->sa_family >
-      ((struct sockaddr*)&b->peer_ip)->sa_family)
-    return 1;
-
-  if (((struct sockaddr*)&a->peer_ip)->sa_family <
-      ((struct sockaddr*)&b->peer_ip)->sa_family)
-    return -1;
-
-  /** compare the address. */
-  if (((struct sockaddr*)&a->peer_ip)->sa_family == AF_INET) {
-    if (((struct sockaddr_in*)&a->peer_ip)->sin_addr.s_addr >
-        ((struct sockaddr_in*)&b->peer_ip)->sin_addr.s_addr)
-      return 1;
-
-    if (((struct sockaddr_in*)&a->peer_ip)->sin_addr.s_addr <
-        ((struct sockaddr_in*)&b->peer_ip)->sin_addr.s_addr)
-      return -1;
-  } else {
-    DevAssert(((struct sockaddr*)&a->peer_ip)->sa_family == AF_INET6);
-    /** Should return 1 if a is bigger. */
-    return memcmp(((struct sockaddr_in6*)&a->peer_ip)->sin6_addr.s6_addr,
-                  ((struct sockaddr_in6*)&b->peer_ip)->sin6_addr.s6_addr, 16);
-  }
-
-  return 0;
-}
-
-RB_GENERATE(NwGtpv2cOutstandingTxSeqNumTrxnMap, nw_gtpv2c_trxn_s,
-            outstandingTxSeqNumMapRbtNode,
-            nwGtpv2cCompareOutstandingTxSeqNumTrxn)
-
-/**
-  Comparator funtion for comparing outstanding RX transactions.
-
-  @param[in] a: Pointer to session a.
-  @param[in] b: Pointer to session b.
-  @return  An integer greater than, equal to or less than zero according to
-  whether the object pointed to by a is greater than, equal to or less than the
-  object pointed to by b.
-*/
-static inline int32_t nwGtpv2cCompareOutstandingRxSeqNumTrxn(
-    struct nw_gtpv2c_trxn_s* a, struct nw_gtpv2c_trxn_s* b) {
-  if (a->seqNum > b->seqNum) return 1;
-
-  if (a->seqNum < b->seqNum) return -1;
-  /** Compare the sa_family. */
-  if (((struct sockaddr*)&a->peer_ip)->sa_family >
-      ((struct sockaddr*)&b->peer_ip)->sa_family)
-    return 1;
-
-  if (((struct sockaddr*)&a->peer_ip)->sa_family <
-      ((struct sockaddr*)&b->peer_ip)->sa_family)
-    return -1;
-
-  /** compare the address. */
-  if (((struct sockaddr*)&a->peer_ip)->sa_family == AF_INET) {
-    if (((struct sockaddr_in*)&a->peer_ip)->sin_addr.s_addr >
-        ((struct sockaddr_in*)&b->peer_ip)->sin_addr.s_addr)
-      return 1;
-
-    if (((struct sockaddr_in*)&a->peer_ip)->sin_addr.s_addr <
-        ((struct sockaddr_in*)&b->peer_ip)->sin_addr.s_addr)
-      return -1;
-  } else {
-    DevAssert(((struct sockaddr*)&a->peer_ip)->sa_family == AF_INET6);
-    /** Should return 1 if a is bigger. */
-    return memcmp(((struct sockaddr_in6*)&a->peer_ip)->sin6_addr.s6_addr,
-                  ((struct sockaddr_in6*)&b->peer_ip)->sin6_addr.s6_addr, 16);
-  }
-
-  if (a->peerPort > b->peerPort) return 1;
-
-  if (a->peerPort < b->peerPort) return -1;
-
-  return 0;
-}
-
-RB_GENERATE(NwGtpv2cOutstandingRxSeqNumTrxnMap, nw_gtpv2c_trxn_s,
-            outstandingRxSeqNumMapRbtNode,
-            nwGtpv2cCompareOutstandingRxSeqNumTrxn)
-
-/*---------------------------------------------------------------------------
-   Timer RB-tree data structure.
-  --------------------------------------------------------------------------*/
-/**
-  Comparator funtion for comparing two outstancing TX transactions.
-
-  @param[in] a: Pointer to session a.
-  @param[in] b: Pointer to session b.
-  @return  An integer greater than, equal to or less than zero according to
-  whether the object pointed to by a is greater than, equal to or less than the
-  object pointed to by b.
-*/
-static inline int32_t nwGtpv2cCompareOutstandingTxRexmitTime(
-    struct nw_gtpv2c_timeout_info_s* a, struct nw_gtpv2c_timeout_info_s* b) {
-  if (NW_GTPV2C_TIMER_CMP_P(&a->tvTimeout, &b->tvTimeout, >)) return 1;
-
-  if (NW_GTPV2C_TIMER_CMP_P(&a->tvTimeout, &b->tvTimeout, <)) return -1;
-
-  return 0;
-}
-
-RB_GENERATE(NwGtpv2cActiveTimerList, nw_gtpv2c_timeout_info_s,
-            activeTimerListRbtNode, nwGtpv2cCompareOutstandingTxRexmitTime)
-
 /**
    Send msg to peer via data request to UDP Entity
 
@@ -770,10 +643,9 @@ static nw_rc_t nwGtpv2cHandleUlpInitialReq(NW_IN nw_gtpv2c_stack_t* thiz,
       rc = nwGtpv2cTrxnStartPeerRspWaitTimer(pTrxn);  // Start guard timer
       NW_ASSERT(NW_OK == rc);
 
-      // Insert into search tree
+      // Insert into the outstanding transaction map
 
-      pTrxn = RB_INSERT(NwGtpv2cOutstandingTxSeqNumTrxnMap,
-                        &(thiz->outstandingTxSeqNumMap), pTrxn);
+      pTrxn = nwGtpv2cTrxnMapInsert(&thiz->outstandingTxSeqNumMap, pTrxn);
       NW_ASSERT(pTrxn == NULL);
     } else {
       rc = nwGtpv2cTrxnDelete(&pTrxn);
@@ -826,10 +698,9 @@ static nw_rc_t nwGtpv2cHandleUlpTriggeredReq(
       rc = nwGtpv2cTrxnStartPeerRspWaitTimer(pTrxn);
       NW_ASSERT(NW_OK == rc);
 
-      // Insert into search tree
+      // Insert into the outstanding transaction map
 
-      RB_INSERT(NwGtpv2cOutstandingTxSeqNumTrxnMap,
-                &(thiz->outstandingTxSeqNumMap), pTrxn);
+      nwGtpv2cTrxnMapInsert(&thiz->outstandingTxSeqNumMap, pTrxn);
 
       if (!pUlpReq->u_api_info.triggeredReqInfo.hTunnel) {
         rc = nwGtpv2cCreateLocalTunnel(
@@ -988,8 +859,7 @@ static nw_rc_t nwGtpv2cHandleUlpTriggeredAck(
 
   /** A transaction of the initial request (cmd) for the triggered request
    * should exist. */
-  pAckTrxn = RB_FIND(NwGtpv2cOutstandingTxSeqNumTrxnMap,
-                     &(thiz->outstandingTxSeqNumMap), &keyTrxn);
+  pAckTrxn = nwGtpv2cTrxnMapFind(&thiz->outstandingTxSeqNumMap, &keyTrxn);
 
   if (pAckTrxn) {
     OAILOG_INFO(
@@ -1370,16 +1240,14 @@ static nw_rc_t nwGtpv2cHandleTriggeredReq(
 
   /** A transaction of the initial request (cmd) for the triggered request
    * should exist. */
-  pTrxn = RB_FIND(NwGtpv2cOutstandingTxSeqNumTrxnMap,
-                  &(thiz->outstandingTxSeqNumMap), &keyTrxn);
+  pTrxn = nwGtpv2cTrxnMapFind(&thiz->outstandingTxSeqNumMap, &keyTrxn);
 
   if (pTrxn) {
     /**
      * We remove the transaction of the initial request and create a new
      * transaction the the received triggered request.
      */
-    RB_REMOVE(NwGtpv2cOutstandingTxSeqNumTrxnMap,
-              &(thiz->outstandingTxSeqNumMap), pTrxn);
+    nwGtpv2cTrxnMapRemove(&thiz->outstandingTxSeqNumMap, pTrxn);
     rc = nwGtpv2cTrxnDelete(&pTrxn);
     NW_ASSERT(NW_OK == rc);
   } else {
@@ -1469,8 +1337,7 @@ static nw_rc_t nwGtpv2cHandleTriggeredRsp(
       "%x.\n",
       msgType, msgBufLen, keyTrxn.seqNum);
 
-  pTrxn = RB_FIND(NwGtpv2cOutstandingTxSeqNumTrxnMap,
-                  &(thiz->outstandingTxSeqNumMap), &keyTrxn);
+  pTrxn = nwGtpv2cTrxnMapFind(&thiz->outstandingTxSeqNumMap, &keyTrxn);
   uint8_t trx_flags = 0;
   if (pTrxn) {
     uint32_t hUlpTunnel;
@@ -1538,8 +1405,7 @@ static nw_rc_t nwGtpv2cHandleTriggeredRsp(
           "%x in conclusion (not late response). \n",
           msgType, keyTrxn.seqNum);
       /** Remove the transaction. */
-      RB_REMOVE(NwGtpv2cOutstandingTxSeqNumTrxnMap,
-                &(thiz->outstandingTxSeqNumMap), pTrxn);
+      nwGtpv2cTrxnMapRemove(&thiz->outstandingTxSeqNumMap, pTrxn);
       rc = nwGtpv2cTrxnDelete(&pTrxn);
       NW_ASSERT(NW_OK == rc);
       remove = false;
@@ -1563,6 +1429,44 @@ static nw_rc_t nwGtpv2cHandleTriggeredRsp(
   return rc;
 }
 
+/**
+  Free the tunnels, the outstanding transactions, the running timers and the
+  pools of the stack.
+
+  @param[in] thiz : Stack context
+*/
+
+static void nwGtpv2cStackPurge(NW_IN nw_gtpv2c_stack_t* thiz) {
+  nw_gtpv2c_msg_t* pMsg;
+  nw_gtpv2c_trxn_t* pTrxn;
+  nw_gtpv2c_timeout_info_t* timeoutInfo;
+  nw_gtpv2c_tunnel_t* pTunnel;
+
+  while ((pTunnel = RB_MIN(NwGtpv2cTunnelMap, &thiz->tunnelMap)) != NULL) {
+    RB_REMOVE(NwGtpv2cTunnelMap, &thiz->tunnelMap, pTunnel);
+    NW_GTPV2C_FREE(thiz, pTunnel);
+  }
+  nwGtpv2cTrxnMapPurge(&thiz->outstandingTxSeqNumMap);
+  nwGtpv2cTrxnMapPurge(&thiz->outstandingRxSeqNumMap);
+  nwGtpv2cTmrWheelPurge(thiz);
+  while ((pMsg = thiz->pMsgPool) != NULL) {
+    thiz->pMsgPool = pMsg->next;
+    NW_GTPV2C_FREE(thiz, pMsg);
+  }
+  while ((pTrxn = thiz->pTrxnPool) != NULL) {
+    thiz->pTrxnPool = pTrxn->next;
+    NW_GTPV2C_FREE(thiz, pTrxn);
+  }
+  while ((timeoutInfo = thiz->pTimeoutInfoPool) != NULL) {
+    thiz->pTimeoutInfoPool = timeoutInfo->next;
+    NW_GTPV2C_FREE(thiz, timeoutInfo);
+  }
+  while ((pTunnel = thiz->pTunnelPool) != NULL) {
+    thiz->pTunnelPool = pTunnel->next;
+    NW_GTPV2C_FREE(thiz, pTunnel);
+  }
+}
+
 /*--------------------------------------------------------------------------*
                        P U B L I C   F U N C T I O N S
   --------------------------------------------------------------------------*/
@@ -1585,12 +1489,16 @@ nw_rc_t nwGtpv2cInitialize(
     thiz->seqNum = ((uint32_t)thiz) & 0x0000FFFF;
     OAI_GCC_DIAG_ON("-Wpointer-to-int-cast");
     RB_INIT(&(thiz->tunnelMap));
-    RB_INIT(&(thiz->outstandingTxSeqNumMap));
-    RB_INIT(&(thiz->outstandingRxSeqNumMap));
-    RB_INIT(&(thiz->activeTimerList));
-    OAI_GCC_DIAG_OFF("-Wpointer-to-int-cast");
-    thiz->hTmrMinHeap = (NwPtrT)nwGtpv2cTmrMinHeapNew(10000);
-    OAI_GCC_DIAG_ON("-Wpointer-to-int-cast");
+    if (nwGtpv2cTrxnMapInit(&thiz->outstandingTxSeqNumMap, false) != NW_OK ||
+        nwGtpv2cTrxnMapInit(&thiz->outstandingRxSeqNumMap, true) != NW_OK ||
+        nwGtpv2cTmrWheelInit(&thiz->timerWheel) != NW_OK) {
+      nwGtpv2cTrxnMapPurge(&thiz->outstandingTxSeqNumMap);
+      nwGtpv2cTrxnMapPurge(&thiz->outstandingRxSeqNumMap);
+      nwGtpv2cTmrWheelPurge(thiz);
+      free_wrapper((void**)&thiz);
+      *hGtpcStackHandle = 0;
+      return NW_FAILURE;
+    }
     NW_GTPV2C_INIT_MSG_IE_PARSE_INFO(thiz, NW_GTP_ECHO_RSP);
 
     // For S11 interface
@@ -1762,11 +1670,7 @@ nw_rc_t nwGtpv2cFinalize(NW_IN nw_gtpv2c_stack_handle_t hGtpcStackHandle) {
       ((nw_gtpv2c_stack_t*)hGtpcStackHandle)
           ->pGtpv2cMsgIeParseInfo[NW_GTP_IDENTIFICATION_RSP]);
 
-  OAI_GCC_DIAG_OFF("-Wint-to-pointer-cast");
-  nwGtpv2cTmrMinHeapDelete(
-      (NwGtpv2cTmrMinHeapT*)((nw_gtpv2c_stack_t*)hGtpcStackHandle)
-          ->hTmrMinHeap);
-  OAI_GCC_DIAG_ON("-Wint-to-pointer-cast");
+  nwGtpv2cStackPurge((nw_gtpv2c_stack_t*)hGtpcStackHandle);
   free_wrapper((void**)&hGtpcStackHandle);
   return NW_OK;
 }
@@ -2070,138 +1974,31 @@ nw_rc_t nwGtpv2cProcessUlpReq(NW_IN nw_gtpv2c_stack_handle_t hGtpcStackHandle,
   OAILOG_FUNC_RETURN(LOG_GTPV2C, rc);
 }
 
-/**
-   Process Timer timeout Request from Timer ULP Manager
-*/
-
-nw_rc_t nwGtpv2cProcessTimeoutOld(void* arg) {
-  nw_rc_t rc = NW_FAILURE;
-  nw_gtpv2c_stack_t* thiz = NULL;
-  nw_gtpv2c_timeout_info_t* timeoutInfo = (nw_gtpv2c_timeout_info_t*)arg;
-  nw_gtpv2c_timeout_info_t* pNextTimeoutInfo = NULL;
-  struct timeval tv = {0};
-
-  NW_ASSERT(timeoutInfo != NULL);
-  thiz = (nw_gtpv2c_stack_t*)(((nw_gtpv2c_timeout_info_t*)timeoutInfo)->hStack);
-  NW_ASSERT(thiz != NULL);
-  OAILOG_FUNC_IN(LOG_GTPV2C);
-
-  if (thiz->activeTimerInfo == timeoutInfo) {
-    thiz->activeTimerInfo = NULL;
-    RB_REMOVE(NwGtpv2cActiveTimerList, &(thiz->activeTimerList), timeoutInfo);
-    timeoutInfo->next = gpGtpv2cTimeoutInfoPool;
-    gpGtpv2cTimeoutInfoPool = timeoutInfo;
-    rc = ((timeoutInfo)->timeoutCallbackFunc)(timeoutInfo->timeoutArg);
-  } else {
-    OAILOG_WARNING(
-        LOG_GTPV2C,
-        "Received timeout event from ULP for non-existent timeoutInfo 0x%p and "
-        "activeTimer 0x%p!\n",
-        timeoutInfo, thiz->activeTimerInfo);
-    OAILOG_FUNC_RETURN(LOG_GTPV2C, NW_OK);
-  }
-
-  NW_ASSERT(gettimeofday(&tv, NULL) == 0);
-
-  for ((timeoutInfo) =
-           RB_MIN(NwGtpv2cActiveTimerList, &(thiz->activeTimerList));
-       (timeoutInfo) != NULL;) {
-    if (NW_GTPV2C_TIMER_CMP_P(&timeoutInfo->tvTimeout, &tv, >)) break;
-
-    pNextTimeoutInfo =
-        RB_NEXT(NwGtpv2cActiveTimerList, &(thiz->activeTimerList), timeoutInfo);
-    RB_REMOVE(NwGtpv2cActiveTimerList, &(thiz->activeTimerList), timeoutInfo);
-    timeoutInfo->next = gpGtpv2cTimeoutInfoPool;
-    gpGtpv2cTimeoutInfoPool = timeoutInfo;
-    rc = ((timeoutInfo)->timeoutCallbackFunc)(timeoutInfo->timeoutArg);
-    timeoutInfo = pNextTimeoutInfo;
-  }
-
-  // activeTimerInfo may be reset by the timeoutCallbackFunc call above
-  if (thiz->activeTimerInfo == NULL) {
-    timeoutInfo = RB_MIN(NwGtpv2cActiveTimerList, &(thiz->activeTimerList));
-
-    if (timeoutInfo) {
-      NW_GTPV2C_TIMER_SUB(&timeoutInfo->tvTimeout, &tv, &tv);
-      rc = thiz->tmrMgr.tmrStartCallback(
-          thiz->tmrMgr.tmrMgrHandle, tv.tv_sec * 1000 + tv.tv_usec / 1000,
-          timeoutInfo->tmrType, (void*)timeoutInfo, &timeoutInfo->hTimer);
-      NW_ASSERT(NW_OK == rc);
-      thiz->activeTimerInfo = timeoutInfo;
-    }
-  }
-
-  OAILOG_FUNC_RETURN(LOG_GTPV2C, rc);
-}
-
 nw_rc_t nwGtpv2cProcessTimeoutExt(zloop_t* loop, int timer_id, void* arg) {
   return nwGtpv2cProcessTimeout(arg);
 }
 
+/**
+   Process Timer timeout Request from Timer ULP Manager
+*/
+
 nw_rc_t nwGtpv2cProcessTimeout(void* arg) {
-  nw_rc_t rc = NW_FAILURE;
-  nw_gtpv2c_stack_t* thiz = NULL;
-  nw_gtpv2c_timeout_info_t* timeoutInfo = (nw_gtpv2c_timeout_info_t*)arg;
-  struct timeval tv = {0};
+  nw_rc_t rc = NW_OK;
+  nw_gtpv2c_stack_t* thiz = (nw_gtpv2c_stack_t*)arg;
+  nw_gtpv2c_timer_wheel_t* wheel;
+  uint64_t now;
 
-  NW_ASSERT(timeoutInfo != NULL);
-  thiz = (nw_gtpv2c_stack_t*)(timeoutInfo->hStack);
   NW_ASSERT(thiz != NULL);
   OAILOG_FUNC_IN(LOG_GTPV2C);
-
-  if (thiz->activeTimerInfo == timeoutInfo) {
-    thiz->activeTimerInfo = NULL;
-    OAI_GCC_DIAG_OFF("-Wint-to-pointer-cast");
-    rc = nwGtpv2cTmrMinHeapRemove((NwGtpv2cTmrMinHeapT*)thiz->hTmrMinHeap,
-                                  timeoutInfo->timerMinHeapIndex);
-    OAI_GCC_DIAG_ON("-Wint-to-pointer-cast");
-    timeoutInfo->next = gpGtpv2cTimeoutInfoPool;
-    gpGtpv2cTimeoutInfoPool = timeoutInfo;
-    rc = ((timeoutInfo)->timeoutCallbackFunc)(timeoutInfo->timeoutArg);
-  } else {
-    OAILOG_WARNING(LOG_GTPV2C,
-                   "Received timeout event from ULP for "
-                   "non-existent timeoutInfo 0x%p and activeTimer 0x%p!\n",
-                   timeoutInfo, thiz->activeTimerInfo);
-    OAILOG_FUNC_RETURN(LOG_GTPV2C, NW_OK);
-  }
-
-  NW_ASSERT(gettimeofday(&tv, NULL) == 0);
-  OAI_GCC_DIAG_OFF("-Wint-to-pointer-cast");
-  timeoutInfo = nwGtpv2cTmrMinHeapPeek((NwGtpv2cTmrMinHeapT*)thiz->hTmrMinHeap);
-  OAI_GCC_DIAG_ON("-Wint-to-pointer-cast");
-
-  while ((timeoutInfo) != NULL) {
-    if (NW_GTPV2C_TIMER_CMP_P(&timeoutInfo->tvTimeout, &tv, >)) break;
-
-    OAI_GCC_DIAG_OFF("-Wint-to-pointer-cast");
-    rc = nwGtpv2cTmrMinHeapRemove((NwGtpv2cTmrMinHeapT*)thiz->hTmrMinHeap,
-                                  timeoutInfo->timerMinHeapIndex);
-    OAI_GCC_DIAG_ON("-Wint-to-pointer-cast");
-    timeoutInfo->next = gpGtpv2cTimeoutInfoPool;
-    gpGtpv2cTimeoutInfoPool = timeoutInfo;
-    rc = ((timeoutInfo)->timeoutCallbackFunc)(timeoutInfo->timeoutArg);
-    OAI_GCC_DIAG_OFF("-Wint-to-pointer-cast");
-    timeoutInfo =
-        nwGtpv2cTmrMinHeapPeek((NwGtpv2cTmrMinHeapT*)thiz->hTmrMinHeap);
-    OAI_GCC_DIAG_ON("-Wint-to-pointer-cast");
-  }
-
-  // activeTimerInfo may be reset by the timeoutCallbackFunc call above
-  if (thiz->activeTimerInfo == NULL) {
-    OAI_GCC_DIAG_OFF("-Wint-to-pointer-cast");
-    timeoutInfo =
-        nwGtpv2cTmrMinHeapPeek((NwGtpv2cTmrMinHeapT*)thiz->hTmrMinHeap);
-    OAI_GCC_DIAG_ON("-Wint-to-pointer-cast");
-
-    if (timeoutInfo) {
-      NW_GTPV2C_TIMER_SUB(&timeoutInfo->tvTimeout, &tv, &tv);
-      rc = thiz->tmrMgr.tmrStartCallback(
-          thiz->tmrMgr.tmrMgrHandle, tv.tv_sec * 1000 + tv.tv_usec / 1000,
-          timeoutInfo->tmrType, (void*)timeoutInfo, &timeoutInfo->hTimer);
-      NW_ASSERT(NW_OK == rc);
-      thiz->activeTimerInfo = timeoutInfo;
-    }
+  wheel = &thiz->timerWheel;
+  wheel->ulpTmrRunning = false;
+  now = nwGtpv2cTmrWheelNow();
+  nwGtpv2cTmrWheelExpire(thiz, now);
+
+  // Timers started by the callbacks are only armed here
+  if (wheel->count) {
+    rc = nwGtpv2cTmrWheelArm(thiz, nwGtpv2cTmrWheelNextTick(wheel), now);
+    NW_ASSERT(NW_OK == rc);
   }
 
   OAILOG_FUNC_RETURN(LOG_GTPV2C, rc);
@@ -2217,77 +2014,52 @@ nw_rc_t nwGtpv2cStartTimer(nw_gtpv2c_stack_t* thiz, uint32_t timeoutSec,
                            void* timeoutCallbackArg,
                            nw_gtpv2c_timer_handle_t* phTimer) {
   nw_rc_t rc = NW_OK;
-  struct timeval tv = {0};
+  nw_gtpv2c_timer_wheel_t* wheel = &thiz->timerWheel;
   nw_gtpv2c_timeout_info_t* timeoutInfo = NULL;
+  uint64_t now, ticks;
 
   OAILOG_FUNC_IN(LOG_GTPV2C);
 
-  if (gpGtpv2cTimeoutInfoPool) {
-    timeoutInfo = gpGtpv2cTimeoutInfoPool;
-    gpGtpv2cTimeoutInfoPool = gpGtpv2cTimeoutInfoPool->next;
+  if (thiz->pTimeoutInfoPool) {
+    timeoutInfo = thiz->pTimeoutInfoPool;
+    thiz->pTimeoutInfoPool = timeoutInfo->next;
   } else {
     NW_GTPV2C_MALLOC(thiz, sizeof(nw_gtpv2c_timeout_info_t), timeoutInfo,
                      nw_gtpv2c_timeout_info_t*);
   }
 
   if (timeoutInfo) {
+    now = nwGtpv2cTmrWheelNow();
+    if (!wheel->count && !wheel->expiring) {
+      // Nothing to expire in between, skip the idle ticks
+      wheel->currTick = now;
+    }
+    // Rounded up, a timer never expires early
+    ticks = ((uint64_t)timeoutSec * 1000 + timeoutUsec / 1000 +
+             NW_GTPV2C_TMR_WHEEL_TICK_MS - 1) /
+            NW_GTPV2C_TMR_WHEEL_TICK_MS;
     timeoutInfo->tmrType = tmrType;
     timeoutInfo->timeoutArg = timeoutCallbackArg;
     timeoutInfo->timeoutCallbackFunc = timeoutCallbackFunc;
     timeoutInfo->hStack = (nw_gtpv2c_stack_handle_t)thiz;
-    NW_ASSERT(gettimeofday(&tv, NULL) == 0);
-    NW_ASSERT(gettimeofday(&timeoutInfo->tvTimeout, NULL) == 0);
-    timeoutInfo->tvTimeout.tv_sec = timeoutSec;
-    timeoutInfo->tvTimeout.tv_usec = timeoutUsec;
-    NW_GTPV2C_TIMER_ADD(&tv, &timeoutInfo->tvTimeout, &timeoutInfo->tvTimeout);
-    OAI_GCC_DIAG_OFF("-Wint-to-pointer-cast");
-    rc = nwGtpv2cTmrMinHeapInsert((NwGtpv2cTmrMinHeapT*)thiz->hTmrMinHeap,
-                                  timeoutInfo);
-    OAI_GCC_DIAG_ON("-Wint-to-pointer-cast");
-#if 0
-
-      do {
-        collision = RB_INSERT (NwGtpv2cActiveTimerList, &(thiz->activeTimerList), timeoutInfo);
-
-        if (!collision)
-          break;
-
-        OAILOG_WARNING (LOG_GTPV2C,  "timer collision!\n");
-        timeoutInfo->tvTimeout.tv_usec++;       /* HACK: In case there is a collision, schedule this event 1 usec later */
-
-        if (timeoutInfo->tvTimeout.tv_usec > (999999 /*1000000 - 1 */ )) {
-          timeoutInfo->tvTimeout.tv_usec = 0;
-          timeoutInfo->tvTimeout.tv_sec++;
-        }
-      } while (1);
-
-#endif
-
-    if (thiz->activeTimerInfo) {
-      if (NW_GTPV2C_TIMER_CMP_P(&(thiz->activeTimerInfo->tvTimeout),
-                                &(timeoutInfo->tvTimeout), >)) {
-        //          OAILOG_DEBUG (LOG_GTPV2C, "Stopping active timer 0x%"
-        //          PRIxPTR " for info 0x%p!\n", thiz->activeTimerInfo->hTimer,
-        //          thiz->activeTimerInfo);
-        rc = thiz->tmrMgr.tmrStopCallback(thiz->tmrMgr.tmrMgrHandle,
-                                          thiz->activeTimerInfo->hTimer);
-        NW_ASSERT(NW_OK == rc);
-      } else {
-        OAILOG_DEBUG(LOG_GTPV2C,
-                     "Already Started timer 0x%" PRIxPTR " for info 0x%p!\n",
-                     thiz->activeTimerInfo->hTimer, thiz->activeTimerInfo);
-        *phTimer = (nw_gtpv2c_timer_handle_t)timeoutInfo;
-        OAILOG_FUNC_RETURN(LOG_GTPV2C, NW_OK);
-      }
+    timeoutInfo->expiryTick = now + (ticks ? ticks : 1);
+    if (wheel->count >= wheel->size * NW_GTPV2C_TMR_WHEEL_LOAD_FACTOR &&
+        !wheel->expiring) {
+      nwGtpv2cTmrWheelGrow(wheel);
     }
+    nwGtpv2cTmrWheelInsert(wheel, timeoutInfo);
+    wheel->count++;
 
-    rc = thiz->tmrMgr.tmrStartCallback(
-        thiz->tmrMgr.tmrMgrHandle, timeoutSec * 1000 + timeoutUsec / 1000,
-        tmrType, (void*)timeoutInfo, &timeoutInfo->hTimer);
-    OAILOG_DEBUG(LOG_GTPV2C, "Started timer 0x%" PRIxPTR " for info 0x%p!\n",
-                 timeoutInfo->hTimer, timeoutInfo);
-    NW_ASSERT(NW_OK == rc);
-    thiz->activeTimerInfo = timeoutInfo;
+    if (!wheel->expiring && (!wheel->ulpTmrRunning ||
+                             timeoutInfo->expiryTick < wheel->ulpTmrTick)) {
+      rc = nwGtpv2cTmrWheelArm(thiz, timeoutInfo->expiryTick, now);
+      NW_ASSERT(NW_OK == rc);
+      OAILOG_DEBUG(LOG_GTPV2C,
+                   "Started timer 0x%" PRIxPTR " for info 0x%p!\n",
+                   wheel->hUlpTmr, timeoutInfo);
+    }
+  } else {
+    rc = NW_FAILURE;
   }
 
   *phTimer = (nw_gtpv2c_timer_handle_t)timeoutInfo;
@@ -2300,60 +2072,34 @@ nw_rc_t nwGtpv2cStartTimer(nw_gtpv2c_stack_t* thiz, uint32_t timeoutSec,
 nw_rc_t nwGtpv2cStopTimer(nw_gtpv2c_stack_t* thiz,
                           nw_gtpv2c_timer_handle_t hTimer) {
   nw_rc_t rc = NW_OK;
-  struct timeval tv;
+  nw_gtpv2c_timer_wheel_t* wheel;
   nw_gtpv2c_timeout_info_t* timeoutInfo;
 
   NW_ASSERT(thiz != NULL);
   OAILOG_FUNC_IN(LOG_GTPV2C);
+  wheel = &thiz->timerWheel;
   timeoutInfo = (nw_gtpv2c_timeout_info_t*)hTimer;
-  OAI_GCC_DIAG_OFF("-Wint-to-pointer-cast");
-  rc = nwGtpv2cTmrMinHeapRemove((NwGtpv2cTmrMinHeapT*)thiz->hTmrMinHeap,
-                                timeoutInfo->timerMinHeapIndex);
-  OAI_GCC_DIAG_ON("-Wint-to-pointer-cast");
-  timeoutInfo->next = gpGtpv2cTimeoutInfoPool;
-  gpGtpv2cTimeoutInfoPool = timeoutInfo;
-  //    OAILOG_DEBUG (LOG_GTPV2C, "Stopping active timer 0x%" PRIxPTR " for info
-  //    0x%p!\n", timeoutInfo->hTimer, timeoutInfo);
-
-  if (thiz->activeTimerInfo == timeoutInfo) {
-    OAILOG_DEBUG(LOG_GTPV2C,
-                 "Stopping active timer 0x%" PRIxPTR " for info 0x%p!\n",
-                 timeoutInfo->hTimer, timeoutInfo);
+
+  if (!timeoutInfo->expiryTick) {
+    OAILOG_WARNING(LOG_GTPV2C, "Stopping expired timer info 0x%p!\n",
+                   timeoutInfo);
+    OAILOG_FUNC_RETURN(LOG_GTPV2C, NW_FAILURE);
+  }
+  LIST_REMOVE(timeoutInfo, wheelNode);
+  wheel->count--;
+  timeoutInfo->expiryTick = 0;
+  timeoutInfo->next = thiz->pTimeoutInfoPool;
+  thiz->pTimeoutInfoPool = timeoutInfo;
+
+  // Otherwise the ULP timer is left running, it only moves the wheel forward
+  if (!wheel->count && wheel->ulpTmrRunning) {
     rc = thiz->tmrMgr.tmrStopCallback(thiz->tmrMgr.tmrMgrHandle,
-                                      timeoutInfo->hTimer);
-    thiz->activeTimerInfo = NULL;
+                                      wheel->hUlpTmr);
+    wheel->ulpTmrRunning = false;
     if (NW_OK != rc) {
       OAILOG_ERROR(LOG_GTPV2C,
-                   "Stopping active timer 0x%" PRIxPTR
-                   " for info 0x%p failed!\n",
-                   timeoutInfo->hTimer, timeoutInfo);
-    } else
-      OAILOG_INFO(LOG_GTPV2C,
-                  "Stopped active timer 0x%" PRIxPTR " for info 0x%p!\n",
-                  timeoutInfo->hTimer, timeoutInfo);
-    OAI_GCC_DIAG_OFF("-Wint-to-pointer-cast");
-    timeoutInfo =
-        nwGtpv2cTmrMinHeapPeek((NwGtpv2cTmrMinHeapT*)thiz->hTmrMinHeap);
-    OAI_GCC_DIAG_ON("-Wint-to-pointer-cast");
-
-    if (timeoutInfo) {
-      NW_ASSERT(gettimeofday(&tv, NULL) == 0);
-
-      if (NW_GTPV2C_TIMER_CMP_P(&timeoutInfo->tvTimeout, &tv, <)) {
-        thiz->activeTimerInfo = timeoutInfo;
-        rc = nwGtpv2cProcessTimeout(timeoutInfo);
-        NW_ASSERT(NW_OK == rc);
-      } else {
-        NW_GTPV2C_TIMER_SUB(&timeoutInfo->tvTimeout, &tv, &tv);
-        rc = thiz->tmrMgr.tmrStartCallback(
-            thiz->tmrMgr.tmrMgrHandle, tv.tv_sec * 1000 + tv.tv_usec / 1000,
-            timeoutInfo->tmrType, (void*)timeoutInfo, &timeoutInfo->hTimer);
-        NW_ASSERT(NW_OK == rc);
-        OAILOG_DEBUG(LOG_GTPV2C,
-                     "Started timer 0x%" PRIxPTR " for info 0x%p!\n",
-                     timeoutInfo->hTimer, timeoutInfo);
-        thiz->activeTimerInfo = timeoutInfo;
-      }
+                   "Stopping active timer 0x%" PRIxPTR " failed!\n",
+                   wheel->hUlpTmr);
     }
   }
 
@@ -58,8 +58,6 @@ extern "C" {
                        P R I V A T E     F U N C T I O N S
   ----------------------------------------------------------------------------*/
 
-static nw_gtpv2c_msg_t* gpGtpv2cMsgPool = NULL;
-
 /*----------------------------------------------------------------------------*
                          P U B L I C   F U N C T I O N S
   ----------------------------------------------------------------------------*/
@@ -72,9 +70,9 @@ nw_rc_t nwGtpv2cMsgNew(NW_IN nw_gtpv2c_stack_handle_t hGtpcStackHandle,
   nw_gtpv2c_msg_t* pMsg;
   NW_ASSERT(pStack);
 
-  if (gpGtpv2cMsgPool) {
-    pMsg = gpGtpv2cMsgPool;
-    gpGtpv2cMsgPool = gpGtpv2cMsgPool->next;
+  if (pStack->pMsgPool) {
+    pMsg = pStack->pMsgPool;
+    pStack->pMsgPool = pMsg->next;
     memset(pMsg, 0, sizeof(nw_gtpv2c_msg_t));
   } else {
     NW_GTPV2C_MALLOC(pStack, sizeof(nw_gtpv2c_msg_t), pMsg, nw_gtpv2c_msg_t*);
@@ -106,9 +104,9 @@ nw_rc_t nwGtpv2cMsgFromBufferNew(
 
   NW_ASSERT(pStack);
 
-  if (gpGtpv2cMsgPool) {
-    pMsg = gpGtpv2cMsgPool;
-    gpGtpv2cMsgPool = gpGtpv2cMsgPool->next;
+  if (pStack->pMsgPool) {
+    pMsg = pStack->pMsgPool;
+    pStack->pMsgPool = pMsg->next;
     memset(pMsg, 0, sizeof(nw_gtpv2c_msg_t));
   } else {
     NW_GTPV2C_MALLOC(pStack, sizeof(nw_gtpv2c_msg_t), pMsg, nw_gtpv2c_msg_t*);
@@ -141,11 +139,15 @@ nw_rc_t nwGtpv2cMsgFromBufferNew(
 
 nw_rc_t nwGtpv2cMsgDelete(NW_IN nw_gtpv2c_stack_handle_t hGtpcStackHandle,
                           NW_IN nw_gtpv2c_msg_handle_t hMsg) {
+  nw_gtpv2c_msg_t* pMsg = (nw_gtpv2c_msg_t*)hMsg;
+  // Back to the pool of the stack the message was allocated from
+  nw_gtpv2c_stack_t* pStack = (nw_gtpv2c_stack_t*)pMsg->hStack;
+
   OAILOG_DEBUG(LOG_GTPV2C, "Purging message 0x%" PRIxPTR "!\n", hMsg);
-  ((nw_gtpv2c_msg_t*)hMsg)->next = gpGtpv2cMsgPool;
-  gpGtpv2cMsgPool = (nw_gtpv2c_msg_t*)hMsg;
+  pMsg->next = pStack->pMsgPool;
+  pStack->pMsgPool = pMsg;
   OAILOG_DEBUG(LOG_GTPV2C, "Message pool %p! Next element %p !\n",
-               gpGtpv2cMsgPool, gpGtpv2cMsgPool->next);
+               pStack->pMsgPool, pStack->pMsgPool->next);
 
   return NW_OK;
 }
@@ -32,6 +32,7 @@
   ----------------------------------------------------------------------------*/
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
 
@@ -54,12 +55,76 @@
 extern "C" {
 #endif
 
-static nw_gtpv2c_trxn_t* gpGtpv2cTrxnPool = NULL;
-
 /*--------------------------------------------------------------------------*
                      P R I V A T E      F U N C T I O N S
   --------------------------------------------------------------------------*/
 
+/*---------------------------------------------------------------------------
+   Outstanding transaction map
+  --------------------------------------------------------------------------*/
+
+static uint32_t nwGtpv2cTrxnMapHash(const nw_gtpv2c_trxn_map_t* map,
+                                    const nw_gtpv2c_trxn_t* trxn) {
+  const struct sockaddr* peer = (const struct sockaddr*)&trxn->peer_ip;
+  uint32_t hash = trxn->seqNum;
+
+  if (peer->sa_family == AF_INET) {
+    hash ^= trxn->peer_ip.addrv4.sin_addr.s_addr;
+  } else {
+    const uint32_t* addr =
+        (const uint32_t*)trxn->peer_ip.addrv6.sin6_addr.s6_addr;
+    hash ^= addr[0] ^ addr[1] ^ addr[2] ^ addr[3];
+  }
+  if (map->matchPeerPort) {
+    hash ^= trxn->peerPort << 16;
+  }
+  // Fibonacci hashing spreads the consecutive sequence numbers
+  return (hash * 2654435769u) & (map->size - 1);
+}
+
+static bool nwGtpv2cTrxnMapMatch(const nw_gtpv2c_trxn_map_t* map,
+                                 const nw_gtpv2c_trxn_t* a,
+                                 const nw_gtpv2c_trxn_t* b) {
+  const struct sockaddr* peerA = (const struct sockaddr*)&a->peer_ip;
+  const struct sockaddr* peerB = (const struct sockaddr*)&b->peer_ip;
+
+  if (a->seqNum != b->seqNum || peerA->sa_family != peerB->sa_family) {
+    return false;
+  }
+  if (map->matchPeerPort && a->peerPort != b->peerPort) {
+    return false;
+  }
+  if (peerA->sa_family == AF_INET) {
+    return a->peer_ip.addrv4.sin_addr.s_addr ==
+           b->peer_ip.addrv4.sin_addr.s_addr;
+  }
+  return memcmp(a->peer_ip.addrv6.sin6_addr.s6_addr,
+                b->peer_ip.addrv6.sin6_addr.s6_addr, 16) == 0;
+}
+
+static void nwGtpv2cTrxnMapGrow(nw_gtpv2c_trxn_map_t* map) {
+  struct nw_gtpv2c_trxn_list_s* oldBuckets = map->buckets;
+  uint32_t oldSize = map->size;
+  struct nw_gtpv2c_trxn_list_s* buckets =
+      calloc(2 * oldSize, sizeof(struct nw_gtpv2c_trxn_list_s));
+
+  if (!buckets) {
+    // Keep the longer chains, lookups stay correct
+    return;
+  }
+  map->buckets = buckets;
+  map->size = 2 * oldSize;
+  for (uint32_t i = 0; i < oldSize; i++) {
+    nw_gtpv2c_trxn_t* trxn;
+    while ((trxn = LIST_FIRST(&oldBuckets[i])) != NULL) {
+      LIST_REMOVE(trxn, trxnMapNode);
+      LIST_INSERT_HEAD(&map->buckets[nwGtpv2cTrxnMapHash(map, trxn)], trxn,
+                       trxnMapNode);
+    }
+  }
+  free(oldBuckets);
+}
+
 /*---------------------------------------------------------------------------
    Send msg retransmission to peer via data request to UDP Entity
   --------------------------------------------------------------------------*/
@@ -93,8 +158,7 @@ static nw_rc_t nwGtpv2cTrxnPeerRspWaitTimeout(void* arg) {
         "Transaction transaction %p (seqNo=0x%x) was acknowledged. Removing "
         "for timeout. \n",
         thiz, thiz->seqNum);
-    RB_REMOVE(NwGtpv2cOutstandingTxSeqNumTrxnMap,
-              &(pStack->outstandingTxSeqNumMap), thiz);
+    nwGtpv2cTrxnMapRemove(&pStack->outstandingTxSeqNumMap, thiz);
     rc = nwGtpv2cTrxnDelete(&thiz);
     return rc;
   }
@@ -118,8 +182,7 @@ static nw_rc_t nwGtpv2cTrxnPeerRspWaitTimeout(void* arg) {
           "Tunnel for local-TEID 0x%x is removed for request transaction %p "
           "(seqNo=0x%x)! Removing the trx and ignoring timeout. \n",
           thiz->teidLocal, thiz, thiz->seqNum);
-      RB_REMOVE(NwGtpv2cOutstandingTxSeqNumTrxnMap,
-                &(pStack->outstandingTxSeqNumMap), thiz);
+      nwGtpv2cTrxnMapRemove(&pStack->outstandingTxSeqNumMap, thiz);
       rc = nwGtpv2cTrxnDelete(&thiz);
     }
   } else {
@@ -140,8 +203,7 @@ static nw_rc_t nwGtpv2cTrxnPeerRspWaitTimeout(void* arg) {
     /** Set the flags. */
     ulpApi.u_api_info.rspFailureInfo.trx_flags = thiz->trx_flags;
     OAILOG_ERROR(LOG_GTPV2C, "N3 retries expired for transaction %p\n", thiz);
-    RB_REMOVE(NwGtpv2cOutstandingTxSeqNumTrxnMap,
-              &(pStack->outstandingTxSeqNumMap), thiz);
+    nwGtpv2cTrxnMapRemove(&pStack->outstandingTxSeqNumMap, thiz);
     rc = nwGtpv2cTrxnDelete(&thiz);
     rc = pStack->ulp.ulpReqCallback(pStack->ulp.hUlp, &ulpApi);
   }
@@ -164,8 +226,7 @@ static nw_rc_t nwGtpv2cTrxnDuplicateRequestWaitTimeout(void* arg) {
       "%d\n",
       thiz, thiz->seqNum);
   thiz->hRspTmr = 0;
-  RB_REMOVE(NwGtpv2cOutstandingRxSeqNumTrxnMap,
-            &(pStack->outstandingRxSeqNumMap), thiz);
+  nwGtpv2cTrxnMapRemove(&pStack->outstandingRxSeqNumMap, thiz);
   rc = nwGtpv2cTrxnDelete(&thiz);
   NW_ASSERT(NW_OK == rc);
   return rc;
@@ -235,9 +296,9 @@ static nw_rc_t nwGtpv2cTrxnStopPeerRspTimer(nw_gtpv2c_trxn_t* thiz) {
 nw_gtpv2c_trxn_t* nwGtpv2cTrxnNew(NW_IN nw_gtpv2c_stack_t* thiz) {
   nw_gtpv2c_trxn_t* pTrxn;
 
-  if (gpGtpv2cTrxnPool) {
-    pTrxn = gpGtpv2cTrxnPool;
-    gpGtpv2cTrxnPool = gpGtpv2cTrxnPool->next;
+  if (thiz->pTrxnPool) {
+    pTrxn = thiz->pTrxnPool;
+    thiz->pTrxnPool = pTrxn->next;
   } else {
     NW_GTPV2C_MALLOC(thiz, sizeof(nw_gtpv2c_trxn_t), pTrxn, nw_gtpv2c_trxn_t*);
   }
@@ -246,8 +307,8 @@ nw_gtpv2c_trxn_t* nwGtpv2cTrxnNew(NW_IN nw_gtpv2c_stack_t* thiz) {
     OAILOG_DEBUG(
         LOG_GTPV2C,
         "Created not trx without seqNum as transaction %p. Head %p, Next %p\n",
-        pTrxn, gpGtpv2cTrxnPool,
-        (gpGtpv2cTrxnPool) ? gpGtpv2cTrxnPool->next : NULL);
+        pTrxn, thiz->pTrxnPool,
+        (thiz->pTrxnPool) ? thiz->pTrxnPool->next : NULL);
 
     pTrxn->pStack = thiz;
     pTrxn->pMsg = NULL;
@@ -276,9 +337,9 @@ nw_gtpv2c_trxn_t* nwGtpv2cTrxnWithSeqNumNew(NW_IN nw_gtpv2c_stack_t* thiz,
                                             NW_IN uint32_t seqNum) {
   nw_gtpv2c_trxn_t* pTrxn;
 
-  if (gpGtpv2cTrxnPool) {
-    pTrxn = gpGtpv2cTrxnPool;
-    gpGtpv2cTrxnPool = gpGtpv2cTrxnPool->next;
+  if (thiz->pTrxnPool) {
+    pTrxn = thiz->pTrxnPool;
+    thiz->pTrxnPool = pTrxn->next;
   } else {
     NW_GTPV2C_MALLOC(thiz, sizeof(nw_gtpv2c_trxn_t), pTrxn, nw_gtpv2c_trxn_t*);
   }
@@ -287,8 +348,8 @@ nw_gtpv2c_trxn_t* nwGtpv2cTrxnWithSeqNumNew(NW_IN nw_gtpv2c_stack_t* thiz,
     OAILOG_DEBUG(
         LOG_GTPV2C,
         "Created new trx with seqNum %p as transaction %u. Head %p, Next %p\n",
-        pTrxn, seqNum, gpGtpv2cTrxnPool,
-        (gpGtpv2cTrxnPool) ? gpGtpv2cTrxnPool->next : NULL);
+        pTrxn, seqNum, thiz->pTrxnPool,
+        (thiz->pTrxnPool) ? thiz->pTrxnPool->next : NULL);
 
     pTrxn->pStack = thiz;
     pTrxn->pMsg = NULL;
@@ -324,9 +385,9 @@ nw_gtpv2c_trxn_t* nwGtpv2cTrxnOutstandingRxNew(NW_IN nw_gtpv2c_stack_t* thiz,
 
   // todo: ipv6 for retransmission1
 
-  if (gpGtpv2cTrxnPool) {
-    pTrxn = gpGtpv2cTrxnPool;
-    gpGtpv2cTrxnPool = gpGtpv2cTrxnPool->next;
+  if (thiz->pTrxnPool) {
+    pTrxn = thiz->pTrxnPool;
+    thiz->pTrxnPool = pTrxn->next;
   } else {
     NW_GTPV2C_MALLOC(thiz, sizeof(nw_gtpv2c_trxn_t), pTrxn, nw_gtpv2c_trxn_t*);
   }
@@ -334,7 +395,7 @@ nw_gtpv2c_trxn_t* nwGtpv2cTrxnOutstandingRxNew(NW_IN nw_gtpv2c_stack_t* thiz,
   if (pTrxn) {
     OAILOG_DEBUG(
         LOG_GTPV2C, "Received new Rx transaction %p, Head %p, Next %p\n", pTrxn,
-        gpGtpv2cTrxnPool, (gpGtpv2cTrxnPool) ? gpGtpv2cTrxnPool->next : NULL);
+        thiz->pTrxnPool, (thiz->pTrxnPool) ? thiz->pTrxnPool->next : NULL);
 
     pTrxn->pStack = thiz;
     pTrxn->maxRetries = 2;
@@ -347,8 +408,7 @@ nw_gtpv2c_trxn_t* nwGtpv2cTrxnOutstandingRxNew(NW_IN nw_gtpv2c_stack_t* thiz,
     pTrxn->pMsg = NULL;
     pTrxn->hRspTmr = 0;
     pTrxn->pt_trx = false;
-    pCollision = RB_INSERT(NwGtpv2cOutstandingRxSeqNumTrxnMap,
-                           &(thiz->outstandingRxSeqNumMap), pTrxn);
+    pCollision = nwGtpv2cTrxnMapInsert(&thiz->outstandingRxSeqNumMap, pTrxn);
 
     if (pCollision) {
       OAILOG_WARNING(
@@ -387,6 +447,104 @@ nw_gtpv2c_trxn_t* nwGtpv2cTrxnOutstandingRxNew(NW_IN nw_gtpv2c_stack_t* thiz,
   return (pTrxn);
 }
 
+/**
+   Initialize an empty outstanding transaction map
+
+   @param[in] map : Pointer to the map.
+   @param[in] matchPeerPort : Whether the peer port is part of the key.
+   @return NW_OK on success.
+*/
+nw_rc_t nwGtpv2cTrxnMapInit(NW_INOUT nw_gtpv2c_trxn_map_t* map,
+                            NW_IN bool matchPeerPort) {
+  map->buckets = calloc(NW_GTPV2C_TRXN_MAP_INITIAL_SIZE,
+                        sizeof(struct nw_gtpv2c_trxn_list_s));
+  map->size = NW_GTPV2C_TRXN_MAP_INITIAL_SIZE;
+  map->count = 0;
+  map->matchPeerPort = matchPeerPort;
+  return map->buckets ? NW_OK : NW_FAILURE;
+}
+
+/**
+   Free the map with the transactions left in it, their timers are not
+   stopped. Only for the destruction of the stack.
+
+   @param[in] map : Pointer to the map.
+*/
+void nwGtpv2cTrxnMapPurge(NW_INOUT nw_gtpv2c_trxn_map_t* map) {
+  nw_gtpv2c_trxn_t* trxn;
+
+  for (uint32_t i = 0; map->buckets && i < map->size; i++) {
+    while ((trxn = LIST_FIRST(&map->buckets[i])) != NULL) {
+      LIST_REMOVE(trxn, trxnMapNode);
+      if (trxn->pMsg) {
+        NW_GTPV2C_FREE(trxn->pStack, trxn->pMsg);
+      }
+      NW_GTPV2C_FREE(trxn->pStack, trxn);
+    }
+  }
+  free(map->buckets);
+  map->buckets = NULL;
+  map->size = 0;
+  map->count = 0;
+}
+
+/**
+   Insert a transaction in the map
+
+   @param[in] map : Pointer to the map.
+   @param[in] thiz : Transaction to insert.
+   @return NULL on success, else the transaction with the same key which is
+   left in place.
+*/
+nw_gtpv2c_trxn_t* nwGtpv2cTrxnMapInsert(NW_INOUT nw_gtpv2c_trxn_map_t* map,
+                                        NW_IN nw_gtpv2c_trxn_t* thiz) {
+  nw_gtpv2c_trxn_t* pCollision = nwGtpv2cTrxnMapFind(map, thiz);
+
+  if (pCollision) {
+    return pCollision;
+  }
+  if (map->count >= map->size * NW_GTPV2C_TRXN_MAP_LOAD_FACTOR) {
+    nwGtpv2cTrxnMapGrow(map);
+  }
+  LIST_INSERT_HEAD(&map->buckets[nwGtpv2cTrxnMapHash(map, thiz)], thiz,
+                   trxnMapNode);
+  map->count++;
+  return NULL;
+}
+
+/**
+   Find the transaction with the peer address, peer port if part of the key,
+   and sequence number of key
+
+   @param[in] map : Pointer to the map.
+   @param[in] key : Transaction holding the key.
+   @return The transaction or NULL.
+*/
+nw_gtpv2c_trxn_t* nwGtpv2cTrxnMapFind(NW_IN nw_gtpv2c_trxn_map_t* map,
+                                      NW_IN nw_gtpv2c_trxn_t* key) {
+  nw_gtpv2c_trxn_t* trxn;
+
+  LIST_FOREACH(trxn, &map->buckets[nwGtpv2cTrxnMapHash(map, key)],
+               trxnMapNode) {
+    if (nwGtpv2cTrxnMapMatch(map, trxn, key)) {
+      return trxn;
+    }
+  }
+  return NULL;
+}
+
+/**
+   Remove a transaction inserted in the map
+
+   @param[in] map : Pointer to the map.
+   @param[in] thiz : Transaction to remove.
+*/
+void nwGtpv2cTrxnMapRemove(NW_INOUT nw_gtpv2c_trxn_map_t* map,
+                           NW_IN nw_gtpv2c_trxn_t* thiz) {
+  LIST_REMOVE(thiz, trxnMapNode);
+  map->count--;
+}
+
 /**
    Destructor
 
@@ -417,15 +575,15 @@ nw_rc_t nwGtpv2cTrxnDelete(NW_INOUT nw_gtpv2c_trxn_t** pthiz) {
   OAILOG_DEBUG(
       LOG_GTPV2C,
       "Purging  transaction %p with seqNum %d. (before) Head %p, Next %p. \n",
-      thiz, thiz->seqNum, gpGtpv2cTrxnPool,
-      (gpGtpv2cTrxnPool) ? gpGtpv2cTrxnPool->next : 0);
-  thiz->next = gpGtpv2cTrxnPool;
-  gpGtpv2cTrxnPool = thiz;
+      thiz, thiz->seqNum, pStack->pTrxnPool,
+      (pStack->pTrxnPool) ? pStack->pTrxnPool->next : 0);
+  thiz->next = pStack->pTrxnPool;
+  pStack->pTrxnPool = thiz;
   *pthiz = NULL;
 
   OAILOG_DEBUG(LOG_GTPV2C, "After purging  transaction %p, Head %p, Next %p\n",
-               thiz, gpGtpv2cTrxnPool,
-               (gpGtpv2cTrxnPool) ? gpGtpv2cTrxnPool->next : NULL);
+               thiz, pStack->pTrxnPool,
+               (pStack->pTrxnPool) ? pStack->pTrxnPool->next : NULL);
 
   return rc;
 }
@@ -0,0 +1,219 @@
+/*
+Copyright 2020 The Magma Authors.
+
+This source code is licensed under the BSD-style license found in the
+LICENSE file in the root directory of this source tree.
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "lte/gateway/c/core/oai/lib/itti/itti_paced_queue.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "lte/gateway/c/core/common/assertions.h"
+#include "lte/gateway/c/core/common/dynamic_memory_check.h"
+
+#define PACED_QUEUE_DEFAULT_ITEMS_PER_TICK 64
+#define PACED_QUEUE_DEFAULT_TICK_MS 10
+#define PACED_QUEUE_TIMER_INACTIVE_ID (-1)
+#define PACED_QUEUE_MICROS_PER_SEC 1000000
+
+static const char* const priority_names[PACED_QUEUE_PRIORITY_MAX] = {
+    "high", "normal", "low"};
+
+uint64_t paced_queue_now_us(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * PACED_QUEUE_MICROS_PER_SEC +
+         (uint64_t)now.tv_nsec / 1000;
+}
+
+void paced_queue_init(paced_queue_t* queue, task_zmq_ctx_t* task_zmq_ctx,
+                      log_proto_t log_proto,
+                      const paced_queue_config_t* config) {
+  memset(queue, 0, sizeof(*queue));
+  queue->task_zmq_ctx = task_zmq_ctx;
+  queue->log_proto = log_proto;
+  queue->timer_id = PACED_QUEUE_TIMER_INACTIVE_ID;
+  if (config) {
+    queue->config = *config;
+  }
+  if (queue->config.items_per_tick == 0) {
+    queue->config.items_per_tick = PACED_QUEUE_DEFAULT_ITEMS_PER_TICK;
+  }
+  if (queue->config.tick_ms == 0) {
+    queue->config.tick_ms = PACED_QUEUE_DEFAULT_TICK_MS;
+  }
+  // Start with a full bucket so that the first slice is not delayed
+  queue->tokens =
+      (uint64_t)queue->config.items_per_tick * PACED_QUEUE_MICROS_PER_SEC;
+  queue->last_refill_us = paced_queue_now_us();
+  for (int i = 0; i < PACED_QUEUE_PRIORITY_MAX; i++) {
+    STAILQ_INIT(&queue->jobs[i]);
+  }
+}
+
+static uint32_t paced_queue_slice_budget(paced_queue_t* queue,
+                                         uint64_t now_us) {
+  if (queue->config.max_items_per_sec == 0) {
+    return queue->config.items_per_tick;
+  }
+  // The bucket holds at most one slice, so that an idle period does not
+  // allow a burst above the configured rate
+  uint64_t capacity =
+      (uint64_t)queue->config.items_per_tick * PACED_QUEUE_MICROS_PER_SEC;
+  if (now_us > queue->last_refill_us) {
+    queue->tokens +=
+        (now_us - queue->last_refill_us) * queue->config.max_items_per_sec;
+    if (queue->tokens > capacity) {
+      queue->tokens = capacity;
+    }
+  }
+  queue->last_refill_us = now_us;
+  return (uint32_t)(queue->tokens / PACED_QUEUE_MICROS_PER_SEC);
+}
+
+static paced_queue_job_t* paced_queue_next_job(paced_queue_t* queue) {
+  for (int i = 0; i < PACED_QUEUE_PRIORITY_MAX; i++) {
+    if (!STAILQ_EMPTY(&queue->jobs[i])) {
+      return STAILQ_FIRST(&queue->jobs[i]);
+    }
+  }
+  return NULL;
+}
+
+static void paced_queue_stop_timer(paced_queue_t* queue) {
+  if (queue->timer_id != PACED_QUEUE_TIMER_INACTIVE_ID) {
+    stop_timer(queue->task_zmq_ctx, queue->timer_id);
+    queue->timer_id = PACED_QUEUE_TIMER_INACTIVE_ID;
+  }
+}
+
+static void paced_queue_complete_job(paced_queue_t* queue,
+                                     paced_queue_job_t* job, uint64_t now_us) {
+  STAILQ_REMOVE_HEAD(&queue->jobs[job->priority], entries);
+  queue->stats.jobs_pending--;
+  queue->stats.jobs_completed++;
+  OAILOG_INFO(queue->log_proto,
+              "Paced job %s (%s priority) done: %u items in %" PRIu64
+              " ms, %u items pending in other jobs\n",
+              job->name, priority_names[job->priority], job->num_items,
+              (now_us - job->submit_time_us) / 1000,
+              queue->stats.items_pending);
+  if (job->done_fn) {
+    job->done_fn(job->ctx, true);
+  }
+  free_wrapper((void**)&job);
+}
+
+uint32_t paced_queue_run_slice(paced_queue_t* queue, uint64_t now_us) {
+  uint32_t budget = paced_queue_slice_budget(queue, now_us);
+  uint32_t processed = 0;
+  paced_queue_job_t* job = NULL;
+
+  queue->stats.ticks++;
+  while (processed < budget && (job = paced_queue_next_job(queue))) {
+    while (processed < budget && job->next_item < job->num_items) {
+      job->item_fn(job->ctx, job->next_item++);
+      processed++;
+      queue->stats.items_pending--;
+    }
+    if (job->next_item == job->num_items) {
+      paced_queue_complete_job(queue, job, now_us);
+    }
+  }
+  queue->stats.items_processed += processed;
+  if (queue->config.max_items_per_sec) {
+    queue->tokens -= (uint64_t)processed * PACED_QUEUE_MICROS_PER_SEC;
+  }
+
+  if (processed && (job = paced_queue_next_job(queue))) {
+    OAILOG_DEBUG(queue->log_proto,
+                 "Paced job %s: %u/%u items done, %u items pending\n",
+                 job->name, job->next_item, job->num_items,
+                 queue->stats.items_pending);
+  }
+  return processed;
+}
+
+static int paced_queue_handle_tick(zloop_t* loop, int timer_id, void* arg) {
+  paced_queue_t* queue = (paced_queue_t*)arg;
+
+  paced_queue_run_slice(queue, paced_queue_now_us());
+  if (queue->stats.jobs_pending == 0) {
+    paced_queue_stop_timer(queue);
+  }
+  return 0;
+}
+
+void paced_queue_submit(paced_queue_t* queue, const char* name,
+                        paced_queue_priority_t priority, uint32_t num_items,
+                        paced_queue_item_fn item_fn,
+                        paced_queue_done_fn done_fn, void* ctx) {
+  DevAssert(priority < PACED_QUEUE_PRIORITY_MAX);
+  DevAssert(item_fn);
+
+  queue->stats.jobs_submitted++;
+  if (num_items == 0) {
+    queue->stats.jobs_completed++;
+    if (done_fn) {
+      done_fn(ctx, true);
+    }
+    return;
+  }
+
+  paced_queue_job_t* job = calloc(1, sizeof(*job));
+  DevAssert(job);
+  strncpy(job->name, name, sizeof(job->name) - 1);
+  job->priority = priority;
+  job->num_items = num_items;
+  job->submit_time_us = paced_queue_now_us();
+  job->item_fn = item_fn;
+  job->done_fn = done_fn;
+  job->ctx = ctx;
+  STAILQ_INSERT_TAIL(&queue->jobs[priority], job, entries);
+
+  queue->stats.jobs_pending++;
+  queue->stats.items_pending += num_items;
+  queue->stats.items_submitted += num_items;
+  OAILOG_INFO(queue->log_proto,
+              "Paced job %s (%s priority) queued with %u items, %u items "
+              "pending\n",
+              job->name, priority_names[priority], num_items,
+              queue->stats.items_pending);
+
+  if (queue->task_zmq_ctx &&
+      queue->timer_id == PACED_QUEUE_TIMER_INACTIVE_ID) {
+    queue->timer_id =
+        start_timer(queue->task_zmq_ctx, queue->config.tick_ms,
+                    TIMER_REPEAT_FOREVER, paced_queue_handle_tick, queue);
+  }
+}
+
+void paced_queue_destroy(paced_queue_t* queue) {
+  paced_queue_stop_timer(queue);
+  for (int i = 0; i < PACED_QUEUE_PRIORITY_MAX; i++) {
+    while (!STAILQ_EMPTY(&queue->jobs[i])) {
+      paced_queue_job_t* job = STAILQ_FIRST(&queue->jobs[i]);
+      STAILQ_REMOVE_HEAD(&queue->jobs[i], entries);
+      OAILOG_WARNING(queue->log_proto,
+                     "Dropping paced job %s with %u of %u items pending\n",
+                     job->name, job->num_items - job->next_item,
+                     job->num_items);
+      if (job->done_fn) {
+        job->done_fn(job->ctx, false);
+      }
+      free_wrapper((void**)&job);
+    }
+  }
+  queue->stats.jobs_pending = 0;
+  queue->stats.items_pending = 0;
+}
@@ -0,0 +1,139 @@
+/*
+Copyright 2020 The Magma Authors.
+
+This source code is licensed under the BSD-style license found in the
+LICENSE file in the root directory of this source tree.
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include "lte/gateway/c/core/oai/common/log.h"
+#include "lte/gateway/c/core/oai/common/queue.h"
+#include "lte/gateway/c/core/oai/lib/itti/intertask_interface.h"
+
+/* Description: A paced queue runs bulk work (e.g. releasing every UE of an
+ * eNB) on a task's event loop in bounded slices, one slice per timer tick,
+ * so that the messages received between two ticks are still handled while a
+ * large job is in progress. Each job is a number of items that are processed
+ * in order by calling the job's item callback with the item index; the done
+ * callback is called once after the last item.
+ *
+ * A slice processes at most items_per_tick items, taken from the oldest job
+ * of the highest priority that has pending work. When max_items_per_sec is
+ * not zero, a token bucket additionally limits the sustained rate.
+ *
+ * The queue is not thread safe and must only be used from the thread of the
+ * task owning the event loop.
+ */
+
+#define PACED_QUEUE_JOB_NAME_MAX_LENGTH 32
+
+typedef enum paced_queue_priority_e {
+  PACED_QUEUE_PRIORITY_HIGH = 0,
+  PACED_QUEUE_PRIORITY_NORMAL,
+  PACED_QUEUE_PRIORITY_LOW,
+  PACED_QUEUE_PRIORITY_MAX,
+} paced_queue_priority_t;
+
+typedef void (*paced_queue_item_fn)(void* job_ctx, uint32_t item_index);
+/* completed is false when the job is dropped by paced_queue_destroy before
+ * all of its items were processed */
+typedef void (*paced_queue_done_fn)(void* job_ctx, bool completed);
+
+typedef struct paced_queue_config_s {
+  uint32_t items_per_tick;
+  uint32_t tick_ms;
+  uint32_t max_items_per_sec;  // 0 means no limit
+} paced_queue_config_t;
+
+typedef struct paced_queue_stats_s {
+  uint64_t jobs_submitted;
+  uint64_t jobs_completed;
+  uint64_t items_submitted;
+  uint64_t items_processed;
+  uint64_t ticks;
+  uint32_t items_pending;
+  uint32_t jobs_pending;
+} paced_queue_stats_t;
+
+typedef struct paced_queue_job_s {
+  char name[PACED_QUEUE_JOB_NAME_MAX_LENGTH];
+  paced_queue_priority_t priority;
+  uint32_t num_items;
+  uint32_t next_item;
+  uint64_t submit_time_us;
+  paced_queue_item_fn item_fn;
+  paced_queue_done_fn done_fn;
+  void* ctx;
+  STAILQ_ENTRY(paced_queue_job_s) entries;
+} paced_queue_job_t;
+
+typedef struct paced_queue_s {
+  task_zmq_ctx_t* task_zmq_ctx;  // NULL if slices are run by the caller
+  log_proto_t log_proto;
+  paced_queue_config_t config;
+  int timer_id;
+  // Token bucket, in millionths of an item
+  uint64_t tokens;
+  uint64_t last_refill_us;
+  paced_queue_stats_t stats;
+  STAILQ_HEAD(paced_queue_jobs_s, paced_queue_job_s)
+  jobs[PACED_QUEUE_PRIORITY_MAX];
+} paced_queue_t;
+
+/** \brief Initialize a paced queue
+ \param queue Queue to initialize
+ \param task_zmq_ctx Context of the task whose event loop runs the ticks, or
+ NULL to run the slices with paced_queue_run_slice only
+ \param log_proto Log component used for progress logs
+ \param config Pacing parameters, zero values are replaced by defaults
+ **/
+void paced_queue_init(paced_queue_t* queue, task_zmq_ctx_t* task_zmq_ctx,
+                      log_proto_t log_proto,
+                      const paced_queue_config_t* config);
+
+/** \brief Queue a job and start the tick timer if it is not running
+ \param queue Paced queue
+ \param name Job name used in logs
+ \param priority Job priority
+ \param num_items Number of items, the done callback is called immediately if
+ it is 0
+ \param item_fn Called for each item, in order
+ \param done_fn Called once all items are processed, may be NULL
+ \param ctx Data passed to the callbacks, owned by the caller
+ **/
+void paced_queue_submit(paced_queue_t* queue, const char* name,
+                        paced_queue_priority_t priority, uint32_t num_items,
+                        paced_queue_item_fn item_fn,
+                        paced_queue_done_fn done_fn, void* ctx);
+
+/** \brief Process one slice of pending items
+ \param queue Paced queue
+ \param now_us Current monotonic time in microseconds, for the rate limit
+ @returns Number of items processed
+ **/
+uint32_t paced_queue_run_slice(paced_queue_t* queue, uint64_t now_us);
+
+/** \brief Current monotonic time in microseconds **/
+uint64_t paced_queue_now_us(void);
+
+/** \brief Stop the tick timer and drop every pending job, calling their done
+ callbacks with completed set to false
+ **/
+void paced_queue_destroy(paced_queue_t* queue);
+
+#ifdef __cplusplus
+}
+#endif
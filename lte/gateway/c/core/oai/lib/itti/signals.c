@@ -59,6 +59,7 @@
 #endif
 
 static sigset_t set;
+static void (*reload_handler)(void) = NULL;
 
 #if LINK_GCOV
 void gcov_flush(void);
@@ -104,6 +105,10 @@ static int get_thread_count(pid_t pid) {
   return num_threads;
 }
 
+void signal_set_reload_handler(void (*handler)(void)) {
+  reload_handler = handler;
+}
+
 int signal_mask(void) {
   /*
    * We set the signal mask to avoid threads other than the main thread
@@ -118,6 +123,9 @@ int signal_mask(void) {
   sigaddset(&set, SIGABRT);
   sigaddset(&set, SIGINT);
   sigaddset(&set, SIGTERM);
+  if (reload_handler) {
+    sigaddset(&set, SIGHUP);
+  }
 
   if (sigprocmask(SIG_BLOCK, &set, NULL) < 0) {
     perror("sigprocmask");
@@ -135,6 +143,9 @@ int signal_handle(int* end, task_zmq_ctx_t* task_ctx) {
   sigaddset(&set, SIGABRT);
   sigaddset(&set, SIGINT);
   sigaddset(&set, SIGTERM);
+  if (reload_handler) {
+    sigaddset(&set, SIGHUP);
+  }
 
   if (sigprocmask(SIG_BLOCK, &set, NULL) < 0) {
     perror("sigprocmask");
@@ -160,6 +171,11 @@ int signal_handle(int* end, task_zmq_ctx_t* task_ctx) {
       backtrace_handle_signal(&info);
       break;
 
+    case SIGHUP:
+      SIG_DEBUG("Received SIGHUP\n");
+      reload_handler();
+      break;
+
     case SIGINT:
     case SIGTERM:
       printf("Received SIGINT or SIGTERM\n");
@@ -33,6 +33,9 @@
 
 int signal_mask(void);
 
+/* Call handler on SIGHUP, must be set before signal_mask() */
+void signal_set_reload_handler(void (*handler)(void));
+
 int signal_handle(int* end, task_zmq_ctx_t* task_ctx);
 
 #endif /* SIGNALS_H_ */
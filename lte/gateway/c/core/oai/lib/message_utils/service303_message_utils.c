@@ -56,6 +56,12 @@ int send_mme_app_stats_to_service303(
       stats_msg->nb_s1u_bearers;
   message_p->ittiMsg.application_mme_app_stats_msg.nb_mme_app_last_msg_latency =
       stats_msg->nb_mme_app_last_msg_latency;
+  message_p->ittiMsg.application_mme_app_stats_msg
+      .nb_bulk_signalling_ues_pending =
+      stats_msg->nb_bulk_signalling_ues_pending;
+  message_p->ittiMsg.application_mme_app_stats_msg
+      .nb_bulk_signalling_ues_processed =
+      stats_msg->nb_bulk_signalling_ues_processed;
   return send_msg_to_task(task_zmq_ctx_p, TASK_SERVICE303, message_p);
 }
 
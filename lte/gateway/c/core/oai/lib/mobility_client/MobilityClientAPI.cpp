@@ -43,6 +43,8 @@ using magma::lte::MobilityServiceClient;
 
 extern task_zmq_ctx_t grpc_service_task_zmq_ctx;
 
+static pgw_ip_allocation_handler_t ip_allocation_handler = NULL;
+
 static void handle_allocate_ipv4_address_status(
     const grpc::Status& status, struct in_addr inaddr, int vlan,
     const char* imsi, const char* apn, const char* pdn_type,
@@ -65,9 +67,17 @@ int get_assigned_ipv4_block(int index, struct in_addr* netaddr,
   return status;
 }
 
+void pgw_set_ip_allocation_handler(pgw_ip_allocation_handler_t handler) {
+  ip_allocation_handler = handler;
+}
+
 int pgw_handle_allocate_ipv4_address(const char* subscriber_id, const char* apn,
                                      const char* pdn_type, teid_t context_teid,
                                      ebi_t eps_bearer_id) {
+  if (ip_allocation_handler) {
+    return ip_allocation_handler(subscriber_id, apn, pdn_type, context_teid,
+                                 eps_bearer_id);
+  }
 #if MME_UNIT_TEST
   return RETURNok;  // skip this call for unit testing
 #endif
@@ -179,6 +189,10 @@ int get_subscriber_id_from_ipv4(const struct in_addr* addr,
 int pgw_handle_allocate_ipv6_address(const char* subscriber_id, const char* apn,
                                      const char* pdn_type, teid_t context_teid,
                                      ebi_t eps_bearer_id) {
+  if (ip_allocation_handler) {
+    return ip_allocation_handler(subscriber_id, apn, pdn_type, context_teid,
+                                 eps_bearer_id);
+  }
 #if MME_UNIT_TEST
   return RETURNok;
 #endif
@@ -273,6 +287,10 @@ int pgw_handle_allocate_ipv4v6_address(const char* subscriber_id,
                                        const char* apn, const char* pdn_type,
                                        teid_t context_teid,
                                        ebi_t eps_bearer_id) {
+  if (ip_allocation_handler) {
+    return ip_allocation_handler(subscriber_id, apn, pdn_type, context_teid,
+                                 eps_bearer_id);
+  }
 #if MME_UNIT_TEST
   return RETURNok;
 #endif
@@ -169,6 +169,23 @@ int pgw_handle_allocate_ipv4v6_address(const char* subscriber_id,
                                        teid_t context_teid,
                                        ebi_t eps_bearer_id);
 
+/*
+ * Requests an IP address for the PGW in place of MobilityServiceClient, with
+ * the arguments of the pgw_handle_allocate_* functions
+ */
+typedef int (*pgw_ip_allocation_handler_t)(const char* subscriber_id,
+                                           const char* apn,
+                                           const char* pdn_type,
+                                           teid_t context_teid,
+                                           ebi_t eps_bearer_id);
+
+/*
+ * Replace the gRPC requests to mobilityd, for unit tests and the load
+ * generator. The handler answers with an IP_ALLOCATION_RESPONSE to the
+ * SPGW task. NULL restores the requests.
+ */
+void pgw_set_ip_allocation_handler(pgw_ip_allocation_handler_t handler);
+
 #ifdef __cplusplus
 }
 #endif
@@ -414,4 +414,21 @@ int AddArpFlowEvent::get_flow_precedence() const { return flow_precedence_; }
 
 const std::string& AddArpFlowEvent::get_imsi() const { return imsi_; }
 
+FlowsInstalledEvent::FlowsInstalledEvent(gtp_flows_installed_cb_t cb,
+                                         void* arg)
+    : ExternalEvent(EVENT_FLOWS_INSTALLED), cb_(cb), arg_(arg) {}
+
+gtp_flows_installed_cb_t FlowsInstalledEvent::get_callback() const {
+  return cb_;
+}
+
+void* FlowsInstalledEvent::get_callback_arg() const { return arg_; }
+
+SendEndMarkerEvent::SendEndMarkerEvent(const struct in_addr enb, uint32_t tei)
+    : ExternalEvent(EVENT_SEND_END_MARKER), enb_(enb), tei_(tei) {}
+
+const struct in_addr& SendEndMarkerEvent::get_enb_ip() const { return enb_; }
+
+uint32_t SendEndMarkerEvent::get_tei() const { return tei_; }
+
 }  // namespace openflow
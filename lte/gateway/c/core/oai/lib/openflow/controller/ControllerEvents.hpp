@@ -40,6 +40,8 @@ enum ControllerEventType {
   EVENT_ADD_GTP_S8_TUNNEL,
   EVENT_DELETE_GTP_S8_TUNNEL,
   EVENT_ADD_DL_ARP,
+  EVENT_FLOWS_INSTALLED,
+  EVENT_SEND_END_MARKER,
 };
 
 /**
@@ -349,4 +351,36 @@ class AddArpFlowEvent : public ExternalEvent {
   const std::string imsi_;
 };
 
+/*
+ * Event triggered by SPGW to learn when the flows of the tunnel events sent
+ * before have been applied by the switch
+ */
+class FlowsInstalledEvent : public ExternalEvent {
+ public:
+  FlowsInstalledEvent(gtp_flows_installed_cb_t cb, void* arg);
+
+  gtp_flows_installed_cb_t get_callback() const;
+  void* get_callback_arg() const;
+
+ private:
+  gtp_flows_installed_cb_t cb_;
+  void* arg_;
+};
+
+/*
+ * Event triggered by SPGW to send a GTP end marker to the eNodeB of a tunnel
+ * when its downlink path is switched
+ */
+class SendEndMarkerEvent : public ExternalEvent {
+ public:
+  SendEndMarkerEvent(const struct in_addr enb, uint32_t tei);
+
+  const struct in_addr& get_enb_ip() const;
+  uint32_t get_tei() const;
+
+ private:
+  const struct in_addr enb_;
+  const uint32_t tei_;
+};
+
 }  // namespace openflow
@@ -15,6 +15,8 @@
  *      contact@openairinterface.org
  */
 
+#include <errno.h>
+
 #include "lte/gateway/c/core/oai/lib/openflow/controller/OpenflowController.hpp"
 #include "lte/gateway/c/core/oai/lib/openflow/controller/PagingApplication.hpp"
 #include "lte/gateway/c/core/oai/lib/openflow/controller/BaseApplication.hpp"
@@ -32,6 +34,8 @@ static const int OF13P_LOCAL = 0xfffffffe;
 namespace {
 openflow::OpenflowController ctrl(CONTROLLER_ADDR, CONTROLLER_PORT, NUM_WORKERS,
                                   false);
+// Set once the controller is started, to check for end marker support
+openflow::GTPApplication* gtp_application = nullptr;
 }
 
 int start_of_controller(bool persist_state) {
@@ -53,7 +57,8 @@ int start_of_controller(bool persist_state) {
       spgw_config.sgw_config.ovs_config.mtr_port_num,
       spgw_config.sgw_config.ovs_config.internal_sampling_port_num,
       spgw_config.sgw_config.ovs_config.internal_sampling_fwd_tbl_num,
-      uplink_port_num_);
+      uplink_port_num_, spgw_config.sgw_config.ovs_config.of_bundles);
+  gtp_application = &gtp_app;
   // Base app registers first, because it deletes/creates default flow
   ctrl.register_for_event(&base_app, openflow::EVENT_SWITCH_UP);
   ctrl.register_for_event(&base_app, openflow::EVENT_ERROR);
@@ -69,6 +74,8 @@ int start_of_controller(bool persist_state) {
   ctrl.register_for_event(&gtp_app, openflow::EVENT_DISCARD_DATA_ON_GTP_TUNNEL);
   ctrl.register_for_event(&gtp_app, openflow::EVENT_FORWARD_DATA_ON_GTP_TUNNEL);
   ctrl.register_for_event(&gtp_app, openflow::EVENT_ADD_DL_ARP);
+  ctrl.register_for_event(&gtp_app, openflow::EVENT_FLOWS_INSTALLED);
+  ctrl.register_for_event(&gtp_app, openflow::EVENT_SEND_END_MARKER);
   ctrl.start();
   OAILOG_INFO(LOG_GTPV1U, "Started openflow controller\n");
 #define CONNECTION_WAIT_TIME 300
@@ -203,3 +210,21 @@ int openflow_controller_delete_paging_rule(struct in_addr ue_ip,
   ctrl.inject_external_event(paging_event, external_event_callback);
   OAILOG_FUNC_RETURN(LOG_GTPV1U, RETURNok);
 }
+
+int openflow_controller_flows_installed(gtp_flows_installed_cb_t cb,
+                                        void* arg) {
+  auto flows_installed =
+      std::make_shared<openflow::FlowsInstalledEvent>(cb, arg);
+  ctrl.inject_external_event(flows_installed, external_event_callback);
+  OAILOG_FUNC_RETURN(LOG_GTPV1U, RETURNok);
+}
+
+int openflow_controller_send_end_marker(struct in_addr enb, uint32_t tei) {
+  if (gtp_application == nullptr ||
+      !gtp_application->is_end_marker_supported()) {
+    OAILOG_FUNC_RETURN(LOG_GTPV1U, -ENODEV);
+  }
+  auto end_marker = std::make_shared<openflow::SendEndMarkerEvent>(enb, tei);
+  ctrl.inject_external_event(end_marker, external_event_callback);
+  OAILOG_FUNC_RETURN(LOG_GTPV1U, RETURNok);
+}
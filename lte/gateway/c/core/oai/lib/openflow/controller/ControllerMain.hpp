@@ -72,6 +72,19 @@ int openflow_controller_del_gtp_s8_tunnel(struct in_addr ue,
                                           uint32_t enb_gtp_port,
                                           uint32_t pgw_gtp_port);
 
+/*
+ * Call cb once the switch has applied the flows of every tunnel event sent
+ * before. cb runs on the openflow controller thread.
+ */
+int openflow_controller_flows_installed(gtp_flows_installed_cb_t cb,
+                                        void* arg);
+
+/*
+ * Send a GTP end marker to enb on the tunnel tei, from the gtp port of the
+ * switch. Returns -ENODEV once the switch has rejected an end marker.
+ */
+int openflow_controller_send_end_marker(struct in_addr enb, uint32_t tei);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,174 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the terms found in the LICENSE file in the root of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#include "lte/gateway/c/core/oai/lib/openflow/controller/FlowModBatch.hpp"
+
+#include <utility>
+
+namespace openflow {
+
+namespace {
+const size_t OF_HEADER_LEN = 8;
+const size_t OF_XID_OFFSET = 4;
+// Header, experimenter id, experimenter type, bundle id, type/pad and flags
+const size_t BUNDLE_MSG_LEN = 24;
+const size_t MAX_OF_MSG_LEN = 0xffff;
+// Start away from the small ids libfluid uses for its own requests
+const uint32_t FIRST_XID = 0x40000000;
+}  // namespace
+
+const uint8_t FlowModBatch::OF_13_VERSION;
+const uint8_t FlowModBatch::OFPT_EXPERIMENTER;
+const uint8_t FlowModBatch::OFPT_BARRIER_REQUEST;
+const uint32_t FlowModBatch::ONF_EXPERIMENTER_ID;
+const uint32_t FlowModBatch::ONFT_BUNDLE_CONTROL;
+const uint32_t FlowModBatch::ONFT_BUNDLE_ADD_MESSAGE;
+const uint16_t FlowModBatch::BUNDLE_OPEN_REQUEST;
+const uint16_t FlowModBatch::BUNDLE_COMMIT_REQUEST;
+const uint16_t FlowModBatch::BUNDLE_FLAG_ATOMIC;
+const uint16_t FlowModBatch::BUNDLE_FLAG_ORDERED;
+
+FlowModBatch::FlowModBatch()
+    : next_xid_(FIRST_XID),
+      barrier_start_xid_(FIRST_XID),
+      in_bundle_(false),
+      bundle_id_(0) {}
+
+uint32_t FlowModBatch::next_xid() {
+  uint32_t xid = next_xid_++;
+  if (next_xid_ == 0) {
+    next_xid_ = FIRST_XID;
+  }
+  return xid;
+}
+
+void FlowModBatch::append_u16(uint16_t value) {
+  buffer_.push_back(value >> 8);
+  buffer_.push_back(value & 0xff);
+}
+
+void FlowModBatch::append_u32(uint32_t value) {
+  append_u16(value >> 16);
+  append_u16(value & 0xffff);
+}
+
+void FlowModBatch::append_header(uint8_t type, uint16_t length, uint32_t xid) {
+  buffer_.push_back(OF_13_VERSION);
+  buffer_.push_back(type);
+  append_u16(length);
+  append_u32(xid);
+}
+
+void FlowModBatch::append_bundle_control(uint16_t type) {
+  append_header(OFPT_EXPERIMENTER, BUNDLE_MSG_LEN, next_xid());
+  append_u32(ONF_EXPERIMENTER_ID);
+  append_u32(ONFT_BUNDLE_CONTROL);
+  append_u32(bundle_id_);
+  append_u16(type);
+  append_u16(BUNDLE_FLAG_ATOMIC | BUNDLE_FLAG_ORDERED);
+}
+
+void FlowModBatch::add_message(const uint8_t* msg, size_t len) {
+  if (len < OF_HEADER_LEN) {
+    return;
+  }
+  uint32_t xid = next_xid();
+  // The message inside a bundle add must have the xid of the bundle add, a
+  // message too long to be wrapped is sent on its own
+  if (in_bundle_ && len + BUNDLE_MSG_LEN <= MAX_OF_MSG_LEN) {
+    append_header(OFPT_EXPERIMENTER, len + BUNDLE_MSG_LEN, xid);
+    append_u32(ONF_EXPERIMENTER_ID);
+    append_u32(ONFT_BUNDLE_ADD_MESSAGE);
+    append_u32(bundle_id_);
+    append_u16(0);  // pad
+    append_u16(BUNDLE_FLAG_ATOMIC | BUNDLE_FLAG_ORDERED);
+  }
+  size_t offset = buffer_.size();
+  buffer_.insert(buffer_.end(), msg, msg + len);
+  buffer_[offset + OF_XID_OFFSET] = xid >> 24;
+  buffer_[offset + OF_XID_OFFSET + 1] = (xid >> 16) & 0xff;
+  buffer_[offset + OF_XID_OFFSET + 2] = (xid >> 8) & 0xff;
+  buffer_[offset + OF_XID_OFFSET + 3] = xid & 0xff;
+}
+
+void FlowModBatch::open_bundle() {
+  if (in_bundle_) {
+    return;
+  }
+  bundle_id_++;
+  in_bundle_ = true;
+  append_bundle_control(BUNDLE_OPEN_REQUEST);
+}
+
+void FlowModBatch::commit_bundle() {
+  if (!in_bundle_) {
+    return;
+  }
+  append_bundle_control(BUNDLE_COMMIT_REQUEST);
+  in_bundle_ = false;
+}
+
+void FlowModBatch::add_barrier(BarrierCallback cb) {
+  uint32_t xid = next_xid();
+  append_header(OFPT_BARRIER_REQUEST, OF_HEADER_LEN, xid);
+  barriers_[xid] = PendingBarrier{barrier_start_xid_, std::move(cb), false};
+  barrier_start_xid_ = next_xid_;
+}
+
+std::vector<uint8_t> FlowModBatch::take() {
+  std::vector<uint8_t> bytes;
+  bytes.swap(buffer_);
+  return bytes;
+}
+
+FlowModBatch::Completion FlowModBatch::handle_barrier_reply(uint32_t xid) {
+  auto it = barriers_.find(xid);
+  if (it == barriers_.end()) {
+    return Completion();
+  }
+  auto cb = std::move(it->second.cb);
+  bool success = !it->second.failed;
+  barriers_.erase(it);
+  return [cb, success]() {
+    if (cb) cb(success);
+  };
+}
+
+void FlowModBatch::handle_error(uint32_t xid) {
+  // The first barrier sent after the failed message covers it
+  auto it = barriers_.lower_bound(xid);
+  if (it != barriers_.end() && xid >= it->second.first_xid) {
+    it->second.failed = true;
+  }
+}
+
+std::vector<FlowModBatch::Completion> FlowModBatch::fail_all() {
+  std::vector<Completion> completions;
+  for (auto& it : barriers_) {
+    auto cb = std::move(it.second.cb);
+    completions.push_back([cb]() {
+      if (cb) cb(false);
+    });
+  }
+  barriers_.clear();
+  buffer_.clear();
+  in_bundle_ = false;
+  barrier_start_xid_ = next_xid_;
+  return completions;
+}
+
+}  // namespace openflow
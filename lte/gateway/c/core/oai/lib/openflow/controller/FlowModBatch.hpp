@@ -0,0 +1,140 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the terms found in the LICENSE file in the root of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace openflow {
+
+/**
+ * Write buffer for the openflow messages sent to one switch connection.
+ * Packed messages are appended to a single buffer, so that everything sent
+ * during an event loop pass goes out in one write.
+ *
+ * Every message is given a new transaction id, which lets the batch match
+ * the errors and barrier replies of the switch to the messages they refer
+ * to. Messages can be grouped in a bundle, which the switch applies
+ * atomically when it is committed. The controller speaks OpenFlow 1.3, so
+ * bundles use the ONF extension (EXT-230) that OVS supports for 1.3.
+ */
+class FlowModBatch {
+ public:
+  // Called with false if the switch rejected any message of the barrier
+  using BarrierCallback = std::function<void(bool success)>;
+  // Barrier callbacks bound to their result. They are returned instead of
+  // being called so that the owner of the batch can release its locks first.
+  using Completion = std::function<void()>;
+
+  static const uint8_t OF_13_VERSION = 4;
+  static const uint8_t OFPT_EXPERIMENTER = 4;
+  static const uint8_t OFPT_BARRIER_REQUEST = 20;
+  static const uint32_t ONF_EXPERIMENTER_ID = 0x4f4e4600;
+  static const uint32_t ONFT_BUNDLE_CONTROL = 2300;
+  static const uint32_t ONFT_BUNDLE_ADD_MESSAGE = 2301;
+  static const uint16_t BUNDLE_OPEN_REQUEST = 0;
+  static const uint16_t BUNDLE_COMMIT_REQUEST = 4;
+  static const uint16_t BUNDLE_FLAG_ATOMIC = 1;
+  static const uint16_t BUNDLE_FLAG_ORDERED = 2;
+
+  FlowModBatch();
+
+  /**
+   * Queue a packed openflow message. Its transaction id is replaced, and it
+   * is wrapped in a bundle add message if a bundle is open.
+   *
+   * @param msg - the packed message, starting with its openflow header
+   * @param len - the length of the message
+   */
+  void add_message(const uint8_t* msg, size_t len);
+
+  /**
+   * Open a bundle, the messages added until commit_bundle are applied by the
+   * switch all at once or not at all. Bundles cannot be nested.
+   */
+  void open_bundle();
+
+  void commit_bundle();
+
+  /**
+   * Queue a barrier request. The callback is called when the switch has
+   * processed every message queued before the barrier, or with false when
+   * the connection is lost before.
+   */
+  void add_barrier(BarrierCallback cb);
+
+  /**
+   * Take the queued bytes, leaving the batch empty
+   */
+  std::vector<uint8_t> take();
+
+  bool empty() const { return buffer_.empty(); }
+
+  size_t size() const { return buffer_.size(); }
+
+  bool in_bundle() const { return in_bundle_; }
+
+  size_t pending_barriers() const { return barriers_.size(); }
+
+  /**
+   * Complete the barrier with the transaction id xid
+   * @return the completion of the barrier, empty if it was not sent by this
+   *         batch
+   */
+  Completion handle_barrier_reply(uint32_t xid);
+
+  /**
+   * Record an error of the switch, the barrier that covers the failed
+   * message will complete with false
+   */
+  void handle_error(uint32_t xid);
+
+  /**
+   * Drop the queued bytes and fail every pending barrier, e.g. because the
+   * connection was closed
+   * @return the completions of the pending barriers
+   */
+  std::vector<Completion> fail_all();
+
+ private:
+  struct PendingBarrier {
+    uint32_t first_xid;
+    BarrierCallback cb;
+    bool failed;
+  };
+
+  uint32_t next_xid();
+  void append_header(uint8_t type, uint16_t length, uint32_t xid);
+  void append_u16(uint16_t value);
+  void append_u32(uint32_t value);
+  void append_bundle_control(uint16_t type);
+
+  std::vector<uint8_t> buffer_;
+  uint32_t next_xid_;
+  // First transaction id not covered by a barrier yet
+  uint32_t barrier_start_xid_;
+  bool in_bundle_;
+  uint32_t bundle_id_;
+  // Keyed by the transaction id of the barrier request
+  std::map<uint32_t, PendingBarrier> barriers_;
+};
+
+}  // namespace openflow
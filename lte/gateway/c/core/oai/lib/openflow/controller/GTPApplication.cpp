@@ -17,6 +17,7 @@
 
 #include <netinet/ip.h>
 #include <arpa/inet.h>
+#include <string.h>
 #include <string>
 
 #include "lte/gateway/c/core/oai/lib/openflow/controller/GTPApplication.hpp"
@@ -35,20 +36,104 @@ namespace openflow {
 const std::string GTPApplication::GTP_PORT_MAC = "02:00:00:00:00:01";
 const std::uint16_t OFPVID_PRESENT = 0x1000;
 
+namespace {
+
+const uint16_t OFPXMC_EXPERIMENTER = 0xffff;
+const uint32_t NX_VENDOR_ID = 0x00002320;
+// GTP-U header fields of the tunnel metadata, from the GTP patch of OVS
+const uint8_t NXOXM_ET_GTPU_FLAGS = 15;
+const uint8_t NXOXM_ET_GTPU_MSGTYPE = 16;
+const uint8_t GTPU_FLAGS_END_MARKER = 0x30;
+const uint8_t GTPU_MSGTYPE_END_MARKER = 0xfe;
+
+// Ethernet header of the packet out, the GTP port only sends the tunnel
+// header built from the metadata
+const uint8_t END_MARKER_PACKET[] = {0x50, 0x54, 0x00, 0x00, 0x00, 0x0a, 0x50,
+                                     0x54, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00};
+
+/*
+ * One byte Nicira experimenter field, libfluid has no support for the
+ * experimenter OXM class
+ */
+class NXOXMTunnelGtpu : public of13::OXMTLV {
+ public:
+  NXOXMTunnelGtpu(uint8_t field, uint8_t value)
+      : OXMTLV(OFPXMC_EXPERIMENTER, field, false, PAYLOAD_LEN),
+        value_(value) {}
+
+  bool equals(const OXMTLV& other) {
+    if (const NXOXMTunnelGtpu* field =
+            dynamic_cast<const NXOXMTunnelGtpu*>(&other)) {
+      return OXMTLV::equals(other) && value_ == field->value_;
+    }
+    return false;
+  }
+
+  OXMTLV& operator=(const OXMTLV& field) {
+    const NXOXMTunnelGtpu& dst = dynamic_cast<const NXOXMTunnelGtpu&>(field);
+    OXMTLV::operator=(field);
+    value_ = dst.value_;
+    return *this;
+  }
+
+  NXOXMTunnelGtpu* clone() const { return new NXOXMTunnelGtpu(*this); }
+
+  size_t pack(uint8_t* buffer) {
+    OXMTLV::pack(buffer);
+    uint32_t experimenter = htonl(NX_VENDOR_ID);
+    memcpy(buffer + of13::OFP_OXM_HEADER_LEN, &experimenter,
+           sizeof(experimenter));
+    buffer[of13::OFP_OXM_HEADER_LEN + sizeof(experimenter)] = value_;
+    return of13::OFP_OXM_HEADER_LEN + PAYLOAD_LEN;
+  }
+
+  of_error unpack(uint8_t* buffer) {
+    OXMTLV::unpack(buffer);
+    // The header length covers the experimenter id and the value
+    if (length() != PAYLOAD_LEN) {
+      return openflow_error(of13::OFPET_BAD_MATCH, of13::OFPBMC_BAD_LEN);
+    }
+    uint32_t experimenter;
+    memcpy(&experimenter, buffer + of13::OFP_OXM_HEADER_LEN,
+           sizeof(experimenter));
+    if (ntohl(experimenter) != NX_VENDOR_ID) {
+      return openflow_error(of13::OFPET_BAD_MATCH, of13::OFPBMC_BAD_FIELD);
+    }
+    value_ = buffer[of13::OFP_OXM_HEADER_LEN + sizeof(NX_VENDOR_ID)];
+    return 0;
+  }
+
+ private:
+  static const uint8_t PAYLOAD_LEN = sizeof(NX_VENDOR_ID) + sizeof(uint8_t);
+  uint8_t value_;
+};
+
+}  // namespace
+
 GTPApplication::GTPApplication(const std::string& uplink_mac,
                                uint32_t gtp_port_num, uint32_t mtr_port_num,
                                uint32_t internal_sampling_port_num,
                                uint32_t internal_sampling_fwd_tbl_num,
-                               uint32_t uplink_port_num)
+                               uint32_t uplink_port_num, bool use_bundles)
     : uplink_mac_(uplink_mac),
       gtp0_port_num_(gtp_port_num),
       mtr_port_num_(mtr_port_num),
       internal_sampling_port_num_(internal_sampling_port_num),
       internal_sampling_fwd_tbl_num_(internal_sampling_fwd_tbl_num),
-      uplink_port_num_(uplink_port_num) {}
+      uplink_port_num_(uplink_port_num),
+      use_bundles_(use_bundles),
+      end_marker_checked_(false),
+      end_marker_supported_(true) {}
 
 void GTPApplication::event_callback(const ControllerEvent& ev,
                                     const OpenflowMessenger& messenger) {
+  bool bundle = use_bundles_ && (ev.get_type() == EVENT_ADD_GTP_TUNNEL ||
+                                 ev.get_type() == EVENT_DELETE_GTP_TUNNEL ||
+                                 ev.get_type() == EVENT_ADD_GTP_S8_TUNNEL ||
+                                 ev.get_type() == EVENT_DELETE_GTP_S8_TUNNEL);
+  if (bundle) {
+    messenger.begin_bundle(ev.get_connection());
+  }
   if (ev.get_type() == EVENT_ADD_GTP_TUNNEL) {
     auto add_tunnel_event = static_cast<const AddGTPTunnelEvent&>(ev);
     add_uplink_tunnel_flow(add_tunnel_event, messenger);
@@ -111,6 +196,60 @@ void GTPApplication::event_callback(const ControllerEvent& ev,
     auto add_arp_event = static_cast<const AddArpFlowEvent&>(ev);
     add_downlink_arp_flow_paging_event(add_arp_event, messenger,
                                        uplink_port_num_);
+  } else if (ev.get_type() == EVENT_FLOWS_INSTALLED) {
+    auto flows_installed_event = static_cast<const FlowsInstalledEvent&>(ev);
+    gtp_flows_installed_cb_t cb = flows_installed_event.get_callback();
+    void* arg = flows_installed_event.get_callback_arg();
+    messenger.send_barrier(ev.get_connection(),
+                           [cb, arg](bool success) { cb(arg, success); });
+  } else if (ev.get_type() == EVENT_SEND_END_MARKER) {
+    auto end_marker_event = static_cast<const SendEndMarkerEvent&>(ev);
+    send_end_marker(end_marker_event, messenger);
+  }
+  if (bundle) {
+    messenger.commit_bundle(ev.get_connection());
+  }
+}
+
+bool GTPApplication::is_end_marker_supported() const {
+  return end_marker_supported_;
+}
+
+void GTPApplication::send_end_marker(const SendEndMarkerEvent& ev,
+                                     const OpenflowMessenger& messenger) {
+  if (!end_marker_supported_) {
+    return;
+  }
+  of13::PacketOut packet_out(0, OFP_NO_BUFFER, of13::OFPP_LOCAL);
+  packet_out.data((void*)END_MARKER_PACKET, sizeof(END_MARKER_PACKET));
+
+  of13::SetFieldAction set_tunnel_id(new of13::TUNNELId(ev.get_tei()));
+  packet_out.add_action(set_tunnel_id);
+  of13::SetFieldAction set_tunnel_dst(
+      new of13::TunnelIPv4Dst(ev.get_enb_ip().s_addr));
+  packet_out.add_action(set_tunnel_dst);
+  of13::SetFieldAction set_msgtype(
+      new NXOXMTunnelGtpu(NXOXM_ET_GTPU_MSGTYPE, GTPU_MSGTYPE_END_MARKER));
+  packet_out.add_action(set_msgtype);
+  of13::SetFieldAction set_flags(
+      new NXOXMTunnelGtpu(NXOXM_ET_GTPU_FLAGS, GTPU_FLAGS_END_MARKER));
+  packet_out.add_action(set_flags);
+  of13::OutputAction output(gtp0_port_num_, of13::OFPCML_NO_BUFFER);
+  packet_out.add_action(output);
+
+  messenger.send_of_msg(packet_out, ev.get_connection());
+
+  // The GTP-U fields need the GTP patch of OVS, stop sending end markers if
+  // the switch rejects the first one
+  if (!end_marker_checked_) {
+    end_marker_checked_ = true;
+    messenger.send_barrier(ev.get_connection(), [this](bool success) {
+      if (!success) {
+        OAILOG_ERROR(LOG_GTPV1U,
+                     "Switch does not support GTP end markers, disabling\n");
+        end_marker_supported_ = false;
+      }
+    });
   }
 }
 
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include <gmp.h>  // gross but necessary to link spgw_config.h
 
 #include "lte/gateway/c/core/oai/lib/openflow/controller/OpenflowController.hpp"
@@ -33,7 +35,7 @@ class GTPApplication : public Application {
   GTPApplication(const std::string& uplink_mac, uint32_t gtp_port_num,
                  uint32_t mtr_port_num, uint32_t internal_sampling_port_num,
                  uint32_t internal_sampling_fwd_tbl_num,
-                 uint32_t uplink_port_num);
+                 uint32_t uplink_port_num, bool use_bundles = false);
 
  private:
   /**
@@ -169,6 +171,19 @@ class GTPApplication : public Application {
   void add_tunnel_match(of13::FlowMod& uplink_fm, uint32_t gtp_port,
                         uint32_t i_tei);
 
+  /*
+   * Send a GTP end marker on the tunnel, as a packet out of the gtp port
+   * with the tunnel metadata set
+   * @param ev - SendEndMarkerEvent containing the enb ip and tunnel id
+   */
+  void send_end_marker(const SendEndMarkerEvent& ev,
+                       const OpenflowMessenger& messenger);
+
+  /*
+   * Whether end markers can be sent, false once the switch has rejected one
+   */
+  bool is_end_marker_supported() const;
+
  private:
   static const uint32_t DEFAULT_PRIORITY = 10;
   static const std::string GTP_PORT_MAC;
@@ -190,6 +205,11 @@ class GTPApplication : public Application {
   const uint64_t cookie = 1;
 
   const uint32_t uplink_port_num_;
+  // Install the flows of a tunnel atomically, in an openflow bundle
+  const bool use_bundles_;
+  // Whether the switch accepted an end marker, checked on the first one
+  bool end_marker_checked_;
+  std::atomic<bool> end_marker_supported_;
 
   void add_downlink_arp_flow_action(fluid_base::OFConnection* conn,
                                     const std::string imsi_,
@@ -15,6 +15,7 @@
  *      contact@openairinterface.org
  */
 
+#include <arpa/inet.h>
 #include <thread>
 #include <mutex>
 #include <chrono>
@@ -50,7 +51,7 @@ OpenflowController::OpenflowController(const char* address, const int port,
                                        const int n_workers, bool secure)
     : OpenflowController(
           address, port, n_workers, secure,
-          std::shared_ptr<DefaultMessenger>(new DefaultMessenger())) {}
+          std::shared_ptr<BatchingMessenger>(new BatchingMessenger())) {}
 
 void OpenflowController::register_for_event(Application* app,
                                             ControllerEventType event_type) {
@@ -81,7 +82,12 @@ void OpenflowController::message_callback(OFConnection* ofconn, uint8_t type,
         "Send signal that Controller is connected to switch to all waiting "
         "threads \n");
     dispatch_event(SwitchUpEvent(ofconn, *this, data, len));
+  } else if (type == OFPT_BARRIER_REPLY_TYPE) {
+    auto header = reinterpret_cast<struct ofp_header*>(data);
+    messenger_->handle_barrier_reply(ofconn, ntohl(header->xid));
   } else if (type == OFPT_ERROR) {
+    auto header = reinterpret_cast<struct ofp_header*>(data);
+    messenger_->handle_error(ofconn, ntohl(header->xid));
     dispatch_event(
         ErrorEvent(ofconn, reinterpret_cast<struct ofp_error_msg*>(data)));
   } else {
@@ -92,6 +98,7 @@ void OpenflowController::connection_callback(OFConnection* ofconn,
                                              OFConnection::Event type) {
   if (type == OFConnection::EVENT_CLOSED || type == OFConnection::EVENT_DEAD) {
     OAILOG_ERROR(LOG_GTPV1U, "Openflow controller lost connection to switch\n");
+    messenger_->connection_closed(ofconn);
     dispatch_event(SwitchDownEvent(ofconn));
   }
 }
@@ -44,7 +44,8 @@ class Application {
 enum OF_MESSAGE_TYPES {
   OFPT_ERROR = 1,
   OFPT_FEATURES_REPLY_TYPE = 6,
-  OFPT_PACKET_IN_TYPE = 10
+  OFPT_PACKET_IN_TYPE = 10,
+  OFPT_BARRIER_REPLY_TYPE = 21
 };
 
 class OpenflowController : public fluid_base::OFServer {
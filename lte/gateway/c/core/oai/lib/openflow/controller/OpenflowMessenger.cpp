@@ -17,8 +17,19 @@
 
 #include "lte/gateway/c/core/oai/lib/openflow/controller/OpenflowMessenger.hpp"
 
+#include <vector>
+
 namespace openflow {
 
+namespace {
+struct FlushRequest {
+  const BatchingMessenger* messenger;
+  fluid_base::OFConnection* ofconn;
+};
+}  // namespace
+
+const size_t BatchingMessenger::MAX_BATCH_BYTES;
+
 fluid_msg::of13::FlowMod DefaultMessenger::create_default_flow_mod(
     uint8_t table_id, fluid_msg::of13::ofp_flow_mod_command command,
     uint16_t priority) const {
@@ -48,4 +59,118 @@ void DefaultMessenger::send_of_msg(fluid_msg::OFMsg& of_msg,
   fluid_msg::OFMsg::free_buffer(buffer);
 }
 
+BatchingMessenger::ConnectionBatch& BatchingMessenger::get_batch(
+    fluid_base::OFConnection* ofconn) const {
+  auto& conn_batch = batches_[ofconn];
+  if (!conn_batch.flush_scheduled) {
+    // Runs once the events already pending in this loop pass are handled
+    conn_batch.flush_scheduled = true;
+    auto request = std::make_shared<FlushRequest>();
+    request->messenger = this;
+    request->ofconn = ofconn;
+    ofconn->add_immediate_event(flush_callback, request);
+  }
+  return conn_batch;
+}
+
+void BatchingMessenger::flush_locked(fluid_base::OFConnection* ofconn,
+                                     ConnectionBatch& conn_batch) const {
+  if (conn_batch.batch.empty()) {
+    return;
+  }
+  std::vector<uint8_t> bytes = conn_batch.batch.take();
+  ofconn->send(bytes.data(), bytes.size());
+}
+
+void* BatchingMessenger::flush_callback(std::shared_ptr<void> data) {
+  auto request = std::static_pointer_cast<FlushRequest>(data);
+  const BatchingMessenger* messenger = request->messenger;
+  std::lock_guard<std::mutex> lock(messenger->mutex_);
+  auto it = messenger->batches_.find(request->ofconn);
+  // The connection may have been closed since the flush was scheduled
+  if (it != messenger->batches_.end()) {
+    it->second.flush_scheduled = false;
+    messenger->flush_locked(request->ofconn, it->second);
+  }
+  return NULL;
+}
+
+void BatchingMessenger::send_of_msg(fluid_msg::OFMsg& of_msg,
+                                    fluid_base::OFConnection* ofconn) const {
+  uint8_t* buffer = of_msg.pack();
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& conn_batch = get_batch(ofconn);
+  conn_batch.batch.add_message(buffer, of_msg.length());
+  fluid_msg::OFMsg::free_buffer(buffer);
+  if (conn_batch.batch.size() >= MAX_BATCH_BYTES) {
+    flush_locked(ofconn, conn_batch);
+  }
+}
+
+void BatchingMessenger::begin_bundle(fluid_base::OFConnection* ofconn) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  get_batch(ofconn).batch.open_bundle();
+}
+
+void BatchingMessenger::commit_bundle(fluid_base::OFConnection* ofconn) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  get_batch(ofconn).batch.commit_bundle();
+}
+
+void BatchingMessenger::send_barrier(fluid_base::OFConnection* ofconn,
+                                     FlowModBatch::BarrierCallback cb) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  get_batch(ofconn).batch.add_barrier(std::move(cb));
+}
+
+void BatchingMessenger::handle_barrier_reply(fluid_base::OFConnection* ofconn,
+                                             uint32_t xid) const {
+  FlowModBatch::Completion completion;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = batches_.find(ofconn);
+    if (it == batches_.end()) {
+      return;
+    }
+    completion = it->second.batch.handle_barrier_reply(xid);
+  }
+  if (completion) {
+    completion();
+  }
+}
+
+void BatchingMessenger::handle_error(fluid_base::OFConnection* ofconn,
+                                     uint32_t xid) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = batches_.find(ofconn);
+  if (it != batches_.end()) {
+    it->second.batch.handle_error(xid);
+  }
+}
+
+void BatchingMessenger::connection_closed(
+    fluid_base::OFConnection* ofconn) const {
+  std::vector<FlowModBatch::Completion> completions;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = batches_.find(ofconn);
+    if (it == batches_.end()) {
+      return;
+    }
+    completions = it->second.batch.fail_all();
+    batches_.erase(it);
+  }
+  for (auto& completion : completions) {
+    completion();
+  }
+}
+
+void BatchingMessenger::flush(fluid_base::OFConnection* ofconn) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = batches_.find(ofconn);
+  if (it != batches_.end()) {
+    flush_locked(ofconn, it->second);
+  }
+}
+
 }  // namespace openflow
@@ -17,9 +17,16 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 #include <fluid/of13msg.hh>
 #include <fluid/OFServer.hh>
 
+#include "lte/gateway/c/core/oai/lib/openflow/controller/FlowModBatch.hpp"
+
 namespace openflow {
 /**
  * Abstract helper class with libfluid message utilities
@@ -47,6 +54,37 @@ class OpenflowMessenger {
    */
   virtual void send_of_msg(fluid_msg::OFMsg& of_msg,
                            fluid_base::OFConnection* ofconn) const {}
+
+  /**
+   * Group the messages sent to ofconn until commit_bundle, so that the switch
+   * applies them atomically. Messengers without bundle support send the
+   * messages as they come.
+   */
+  virtual void begin_bundle(fluid_base::OFConnection* ofconn) const {}
+
+  virtual void commit_bundle(fluid_base::OFConnection* ofconn) const {}
+
+  /**
+   * Call cb once the switch has processed every message sent to ofconn so
+   * far, with false if any of them failed. Messengers that do not track the
+   * replies of the switch call it right away.
+   */
+  virtual void send_barrier(fluid_base::OFConnection* ofconn,
+                            FlowModBatch::BarrierCallback cb) const {
+    cb(true);
+  }
+
+  /**
+   * Replies of the switch and connection changes, forwarded by the controller
+   * for messengers that track them
+   */
+  virtual void handle_barrier_reply(fluid_base::OFConnection* ofconn,
+                                    uint32_t xid) const {}
+
+  virtual void handle_error(fluid_base::OFConnection* ofconn,
+                            uint32_t xid) const {}
+
+  virtual void connection_closed(fluid_base::OFConnection* ofconn) const {}
 };
 
 /**
@@ -62,4 +100,55 @@ class DefaultMessenger : public OpenflowMessenger {
                    fluid_base::OFConnection* ofconn) const;
 };
 
+/**
+ * Messenger that coalesces the messages sent to a connection during an event
+ * loop pass and writes them at the end of the pass, in one buffer. It must
+ * only be used from the event loop of the connections.
+ */
+class BatchingMessenger : public DefaultMessenger {
+ public:
+  // Write a batch right away once it gets this large
+  static const size_t MAX_BATCH_BYTES = 64 * 1024;
+
+  void send_of_msg(fluid_msg::OFMsg& of_msg,
+                   fluid_base::OFConnection* ofconn) const;
+
+  void begin_bundle(fluid_base::OFConnection* ofconn) const;
+
+  void commit_bundle(fluid_base::OFConnection* ofconn) const;
+
+  void send_barrier(fluid_base::OFConnection* ofconn,
+                    FlowModBatch::BarrierCallback cb) const;
+
+  void handle_barrier_reply(fluid_base::OFConnection* ofconn,
+                            uint32_t xid) const;
+
+  void handle_error(fluid_base::OFConnection* ofconn, uint32_t xid) const;
+
+  void connection_closed(fluid_base::OFConnection* ofconn) const;
+
+  /**
+   * Write the queued messages of ofconn
+   */
+  void flush(fluid_base::OFConnection* ofconn) const;
+
+ private:
+  struct ConnectionBatch {
+    FlowModBatch batch;
+    bool flush_scheduled = false;
+  };
+
+  static void* flush_callback(std::shared_ptr<void> data);
+
+  // Must be called with mutex_ held
+  ConnectionBatch& get_batch(fluid_base::OFConnection* ofconn) const;
+  void flush_locked(fluid_base::OFConnection* ofconn,
+                    ConnectionBatch& conn_batch) const;
+
+  // The controller only hands a const messenger to the applications
+  mutable std::mutex mutex_;
+  mutable std::unordered_map<fluid_base::OFConnection*, ConnectionBatch>
+      batches_;
+};
+
 }  // namespace openflow
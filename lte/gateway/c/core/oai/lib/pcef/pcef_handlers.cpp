@@ -42,6 +42,8 @@ extern task_zmq_ctx_t grpc_service_task_zmq_ctx;
 
 #define ULI_DATA_SIZE 13
 
+static pcef_create_session_handler_t create_session_handler = nullptr;
+
 // TODO Clean up pcef_create_session_data structure to include
 // imsi/ip/bearer_id etc.
 static void pcef_fill_create_session_req(
@@ -132,9 +134,17 @@ status_code_e send_itti_pcef_create_session_response(
   return send_msg_to_task(&grpc_service_task_zmq_ctx, TASK_SPGW_APP, message_p);
 }
 
+void pcef_set_create_session_handler(pcef_create_session_handler_t handler) {
+  create_session_handler = handler;
+}
+
 void pcef_create_session(const char* imsi, const char* ip4, const char* ip6,
                          const pcef_create_session_data* session_data,
                          s5_create_session_request_t session_request) {
+  if (create_session_handler) {
+    create_session_handler(imsi, ip4, ip6, session_data, session_request);
+    return;
+  }
   auto imsi_str = std::string(imsi);
   std::string ip4_str, ip6_str;
 
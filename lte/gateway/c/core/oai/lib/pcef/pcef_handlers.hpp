@@ -61,6 +61,22 @@ void pcef_create_session(const char* imsi, const char* ip4, const char* ip6,
                          const struct pcef_create_session_data* session_data,
                          s5_create_session_request_t bearer_request);
 
+/**
+ * Creates the session in place of the PCEFClient, with the arguments of
+ * pcef_create_session
+ */
+typedef void (*pcef_create_session_handler_t)(
+    const char* imsi, const char* ip4, const char* ip6,
+    const struct pcef_create_session_data* session_data,
+    s5_create_session_request_t session_request);
+
+/**
+ * Replace the gRPC requests to sessiond, for unit tests and the load
+ * generator. The handler answers with a PCEF_CREATE_SESSION_RESPONSE to the
+ * SPGW task. NULL restores the requests.
+ */
+void pcef_set_create_session_handler(pcef_create_session_handler_t handler);
+
 /**
  * pcef_end_session is a *synchronous* call that ends the UE session in the
  * PCEF and returns true if successful.
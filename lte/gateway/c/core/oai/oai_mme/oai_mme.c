@@ -52,6 +52,7 @@
 #include "lte/gateway/c/core/oai/lib/bstr/bstrlib.h"
 #include "lte/gateway/c/core/oai/lib/itti/intertask_interface.h"
 #include "lte/gateway/c/core/oai/lib/itti/intertask_interface_types.h"
+#include "lte/gateway/c/core/oai/lib/itti/signals.h"
 #if EMBEDDED_SGW
 #include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_embedded_spgw.h"
 #include "lte/gateway/c/core/oai/include/spgw_config.h"
@@ -97,6 +98,8 @@ int main(int argc, char* argv[]) {
   CHECK_INIT_RETURN(OAILOG_INIT(MME_CONFIG_STRING_MME_CONFIG,
                                 OAILOG_LEVEL_DEBUG, MAX_LOG_PROTOS));
   CHECK_INIT_RETURN(shared_log_init(MAX_LOG_PROTOS));
+  // SIGHUP reloads the served TAIs and NAS timers
+  signal_set_reload_handler(mme_config_reload);
   CHECK_INIT_RETURN(itti_init(TASK_MAX, THREAD_MAX, MESSAGES_ID_MAX, tasks_info,
                               messages_info, NULL, NULL));
 
@@ -58,6 +58,7 @@ static int handle_message(zloop_t* loop, zsock_t* reader, void* arg) {
   imsi64_t imsi64 = itti_get_associated_imsi(received_message_p);
   amf_app_desc_t* amf_app_desc_p = get_amf_nas_state(false);
   bool is_task_state_same = false;
+  bool is_ue_state_same = false;
   bool force_ue_write = false;
 
   OAILOG_INFO(LOG_AMF_APP, "Received msg from :[%s] id:[%d] name:[%s]\n",
@@ -182,8 +183,12 @@ static int handle_message(zloop_t* loop, zsock_t* reader, void* arg) {
     default:
       OAILOG_DEBUG(LOG_AMF_APP, "default message received");
       is_task_state_same = true;
+      is_ue_state_same = true;
       break;
   }
+  if (!is_ue_state_same) {
+    mark_amf_ue_state_dirty(amf_app_desc_p, imsi64);
+  }
   put_amf_ue_state(amf_app_desc_p, imsi64, force_ue_write);
   if (!is_task_state_same) {
     put_amf_nas_state();
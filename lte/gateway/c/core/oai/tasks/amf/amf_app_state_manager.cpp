@@ -205,6 +205,23 @@ void AmfNasStateManager::clear_db_state() {
   OAILOG_FUNC_OUT(LOG_AMF_APP);
 }
 
+void mark_amf_ue_state_dirty(amf_app_desc_t* amf_app_desc_p,
+                             imsi64_t imsi64) {
+  OAILOG_FUNC_IN(LOG_AMF_APP);
+  amf_ue_ngap_id_t ue_id;
+  if ((imsi64 == INVALID_IMSI64) ||
+      (!get_amf_ue_id_from_imsi(&amf_app_desc_p->amf_ue_contexts, imsi64,
+                                &ue_id))) {
+    OAILOG_FUNC_OUT(LOG_AMF_APP);
+  }
+  ue_m5gmm_context_t* ue_context_p =
+      amf_ue_context_exists_amf_ue_ngap_id((amf_ue_ngap_id_t)ue_id);
+  if (ue_context_p) {
+    UE_STATE_MARK_DIRTY(ue_context_p);
+  }
+  OAILOG_FUNC_OUT(LOG_AMF_APP);
+}
+
 void put_amf_ue_state(amf_app_desc_t* amf_app_desc_p, imsi64_t imsi64,
                       bool force_ue_write) {
   OAILOG_FUNC_IN(LOG_AMF_APP);
@@ -227,8 +244,8 @@ void put_amf_ue_state(amf_app_desc_t* amf_app_desc_p, imsi64_t imsi64,
   OAILOG_FUNC_OUT(LOG_AMF_APP);
 }
 
-void AmfNasStateManager::write_ue_state_to_db(
-    const ue_m5gmm_context_t* ue_context, const std::string& imsi_str) {
+void AmfNasStateManager::write_ue_state_to_db(ue_m5gmm_context_t* ue_context,
+                                              const std::string& imsi_str) {
   OAILOG_FUNC_IN(LOG_AMF_APP);
 #if !MME_UNIT_TEST
   /* Data store is Redis db. In this case actual call is made to Redis db */
@@ -236,13 +253,16 @@ void AmfNasStateManager::write_ue_state_to_db(
 #else
   /* Data store is a map defined in AmfClientServicer.In this case call is NOT
    * made to Redis db */
+  if (!UE_STATE_IS_DIRTY(ue_context)) {
+    OAILOG_FUNC_OUT(LOG_AMF_APP);
+  }
   std::string proto_str;
   magma::lte::oai::UeContext ue_proto = magma::lte::oai::UeContext();
   AmfNasStateConverter::ue_to_proto(ue_context, &ue_proto);
   redis_client->serialize(ue_proto, proto_str);
   std::size_t new_hash = std::hash<std::string>{}(proto_str);
 
-  if (new_hash != this->ue_state_hash[imsi_str]) {
+  if (new_hash != ue_context->state_sync.hash) {
     std::string key = IMSI_PREFIX + imsi_str + ":" + task_name;
     if (AMFClientServicer::getInstance().map_imsi_ue_proto_str.insert(
             key, proto_str) != magma::MAP_OK) {
@@ -251,11 +271,13 @@ void AmfNasStateManager::write_ue_state_to_db(
       OAILOG_FUNC_OUT(LOG_AMF_APP);
     }
 
-    this->ue_state_version[imsi_str]++;
-    this->ue_state_hash[imsi_str] = new_hash;
+    ue_context->state_sync.version++;
+    ue_context->state_sync.hash = new_hash;
     OAILOG_DEBUG(log_task, "Finished writing UE state for IMSI %s",
                  imsi_str.c_str());
   }
+  ue_context->state_sync.persisted_generation =
+      ue_context->state_sync.generation;
 #endif
   OAILOG_FUNC_OUT(LOG_AMF_APP);
 }
@@ -276,10 +298,10 @@ status_code_e AmfNasStateManager::read_ue_state_from_db() {
       OAILOG_FUNC_RETURN(LOG_AMF_APP, RETURNerror);
     }
 
-    // Update each UE state version from redis
-    this->ue_state_version[key] = redis_client->read_version(table_key);
     ue_m5gmm_context_t* ue_context_p = new ue_m5gmm_context_t();
     AmfNasStateConverter::proto_to_ue(ue_proto, ue_context_p);
+    // Update the UE state version from redis
+    ue_context_p->state_sync.version = redis_client->read_version(key);
     state_ue_map.insert(ue_context_p->amf_ue_ngap_id, ue_context_p);
     OAILOG_DEBUG(log_task, "Reading UE state from db for %s", key.c_str());
   }
@@ -70,7 +70,10 @@ void clear_amf_nas_state();
 // Retrieving respective global hash table
 map_uint64_ue_context_t* get_amf_ue_state();
 
-// Persists UE AMF state for subscriber into db
+// Marks UE AMF state of subscriber modified, so that it is persisted again
+void mark_amf_ue_state_dirty(magma5g::amf_app_desc_t* amf_app_desc_p,
+                             imsi64_t imsi64);
+// Persists UE AMF state for subscriber into db if it was marked modified
 void put_amf_ue_state(magma5g::amf_app_desc_t* amf_app_desc_p, imsi64_t imsi64,
                       bool force_ue_write);
 // Deletes entry for UE AMF state on db
@@ -128,7 +131,7 @@ class AmfNasStateManager
   void write_state_to_db() override;
   status_code_e read_state_from_db() override;
 
-  void write_ue_state_to_db(const ue_m5gmm_context_t* ue_context,
+  void write_ue_state_to_db(ue_m5gmm_context_t* ue_context,
                             const std::string& imsi_str) override;
   status_code_e read_ue_state_from_db() override;
 
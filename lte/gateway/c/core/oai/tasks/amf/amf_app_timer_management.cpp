@@ -18,6 +18,7 @@ extern "C" {
 #include "lte/gateway/c/core/oai/common/common_types.h"
 }
 #include "lte/gateway/c/core/oai/tasks/amf/amf_app_timer_management.hpp"
+#include "lte/gateway/c/core/oai/tasks/amf/amf_app_ue_context_and_proc.hpp"
 //--C++ includes ---------------------------------------------------------------
 #include <utility>
 #include <stdexcept>
@@ -41,9 +42,25 @@ void amf_app_stop_timer(int timer_id) {
   OAILOG_FUNC_OUT(LOG_AMF_APP);
 }
 
+//------------------------------------------------------------------------------
+// Expiry handlers run from the event loop rather than handle_message, the UE
+// they are about to modify is marked here so that the next write persists it
+static void amf_mark_timer_ue_state_dirty(amf_ue_ngap_id_t ue_id) {
+  ue_m5gmm_context_s* ue_context_p =
+      amf_ue_context_exists_amf_ue_ngap_id(ue_id);
+  if (ue_context_p) {
+    UE_STATE_MARK_DIRTY(ue_context_p);
+  }
+}
+
 //------------------------------------------------------------------------------
 bool amf_pop_timer_arg(int timer_id, timer_arg_t* arg) {
-  return magma5g::AmfUeContext::Instance().PopTimerArgById(timer_id, arg);
+  bool result =
+      magma5g::AmfUeContext::Instance().PopTimerArgById(timer_id, arg);
+  if (result) {
+    amf_mark_timer_ue_state_dirty((amf_ue_ngap_id_t)*arg);
+  }
+  return result;
 }
 
 //------------------------------------------------------------------------------
@@ -98,7 +115,12 @@ void amf_pdu_stop_timer(int timer_id) {
 
 //------------------------------------------------------------------------------
 bool amf_pop_pdu_timer_arg(int timer_id, ue_pdu_id_t* arg) {
-  return magma5g::AmfUeContext::Instance().PopPduTimerArgById(timer_id, arg);
+  bool result =
+      magma5g::AmfUeContext::Instance().PopPduTimerArgById(timer_id, arg);
+  if (result) {
+    amf_mark_timer_ue_state_dirty(arg->ue_id);
+  }
+  return result;
 }
 
 //------------------------------------------------------------------------------
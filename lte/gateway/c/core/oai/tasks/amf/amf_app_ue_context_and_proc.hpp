@@ -423,6 +423,9 @@ typedef struct ue_m5gmm_context_s {
   m5g_uecontextrequest_t ue_context_request;
 
   bool pending_service_response;
+
+  // Persisted copy of this context, see UE_STATE_MARK_DIRTY
+  ue_state_sync_t state_sync;
 } ue_m5gmm_context_t;
 
 // Map- Key: uint64_t , Data: ue_m5gmm_context_s*
@@ -0,0 +1,196 @@
+/**
+ * Copyright 2022 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "lte/gateway/c/core/oai/tasks/gtpv1-u/gtp_tunnel_ebpf.hpp"
+
+#include <arpa/inet.h>
+#include <stdlib.h>
+#include <string.h>
+#include <memory>
+#include <mutex>
+
+extern "C" {
+#include "lte/gateway/c/core/oai/common/log.h"
+}
+
+#include "orc8r/gateway/c/common/ebpf/EbpfMap.h"
+#include "orc8r/gateway/c/common/ebpf/EbpfMapBackend.hpp"
+#include "orc8r/gateway/c/common/ebpf/EbpfMapSync.hpp"
+
+#define DL_MAP_PATH "/sys/fs/bpf/dl_map"
+#define UL_MAP_PATH "/sys/fs/bpf/ul_map"
+
+using magma::ebpf::MapSync;
+using magma::ebpf::SyscallMapBackend;
+
+namespace {
+
+using DlMap = MapSync<struct dl_map_key, struct dl_map_info>;
+using UlMap = MapSync<struct ul_map_key, struct ul_map_info>;
+
+std::mutex ebpf_maps_mutex;
+std::unique_ptr<DlMap> dl_map;
+std::unique_ptr<UlMap> ul_map;
+bool dl_map_reconciling = false;
+DlMap::Entries dl_map_desired;
+
+// The byte counter is maintained by the datapath and is not compared
+bool same_dl_entry(const dl_map_info& desired, const dl_map_info& current) {
+  return desired.remote_ipv4 == current.remote_ipv4 &&
+         desired.tunnel_id == current.tunnel_id &&
+         memcmp(desired.user_data, current.user_data,
+                sizeof(desired.user_data)) == 0;
+}
+
+bool same_ul_entry(const ul_map_info& desired, const ul_map_info& current) {
+  return desired.mark == current.mark &&
+         desired.e_if_index == current.e_if_index &&
+         memcmp(desired.mac_src, current.mac_src, sizeof(desired.mac_src)) ==
+             0 &&
+         memcmp(desired.mac_dst, current.mac_dst, sizeof(desired.mac_dst)) ==
+             0;
+}
+
+template <typename Map>
+int read_usage(Map* map, gtp_ebpf_ue_usage_t** usage) {
+  *usage = nullptr;
+  if (!map) {
+    return 0;
+  }
+  typename Map::Entries entries;
+  int rc = map->read_all(&entries);
+  if (rc < 0) {
+    OAILOG_ERROR(LOG_GTPV1U, "Failed to read eBPF map counters: %s\n",
+                 strerror(-rc));
+    return rc;
+  }
+  if (entries.empty()) {
+    return 0;
+  }
+  *usage = (gtp_ebpf_ue_usage_t*)calloc(entries.size(), sizeof(**usage));
+  int count = 0;
+  for (const auto& it : entries) {
+    (*usage)[count].ue.s_addr = ntohl(it.first.ue_ip);
+    (*usage)[count].bytes = it.second.bytes;
+    count++;
+  }
+  return count;
+}
+
+}  // namespace
+
+int gtp_ebpf_maps_init(void) {
+  std::lock_guard<std::mutex> lock(ebpf_maps_mutex);
+  auto dl_backend =
+      SyscallMapBackend<dl_map_key, dl_map_info>::open_pinned(DL_MAP_PATH);
+  if (!dl_backend) {
+    OAILOG_ERROR(LOG_GTPV1U, "Could not open eBPF map %s\n", DL_MAP_PATH);
+    return -1;
+  }
+  dl_map.reset(new DlMap(std::move(dl_backend), same_dl_entry));
+
+  // The uplink map belongs to pipelined, it is only read for its counters
+  auto ul_backend =
+      SyscallMapBackend<ul_map_key, ul_map_info>::open_pinned(UL_MAP_PATH);
+  if (ul_backend) {
+    ul_map.reset(new UlMap(std::move(ul_backend), same_ul_entry));
+  }
+  return 0;
+}
+
+void gtp_ebpf_maps_uninit(void) {
+  std::lock_guard<std::mutex> lock(ebpf_maps_mutex);
+  dl_map.reset();
+  ul_map.reset();
+  dl_map_desired.clear();
+  dl_map_reconciling = false;
+}
+
+void gtp_ebpf_dl_map_add(struct in_addr ue, struct in_addr enb,
+                         uint32_t o_tei, const uint8_t* user_data,
+                         size_t user_data_len) {
+  struct dl_map_info val = {htonl(enb.s_addr), o_tei, 0, {}};
+  if (user_data_len > sizeof(val.user_data)) {
+    return;
+  }
+  memcpy(val.user_data, user_data, user_data_len);
+  struct dl_map_key key = {htonl(ue.s_addr)};
+
+  std::lock_guard<std::mutex> lock(ebpf_maps_mutex);
+  if (dl_map_reconciling) {
+    dl_map_desired[key] = val;
+  } else if (dl_map) {
+    dl_map->set(key, val);
+  }
+}
+
+void gtp_ebpf_dl_map_delete(struct in_addr ue) {
+  struct dl_map_key key = {htonl(ue.s_addr)};
+
+  std::lock_guard<std::mutex> lock(ebpf_maps_mutex);
+  if (dl_map_reconciling) {
+    dl_map_desired.erase(key);
+  } else if (dl_map) {
+    dl_map->erase(key);
+  }
+}
+
+int gtp_ebpf_dl_map_flush(void) {
+  std::lock_guard<std::mutex> lock(ebpf_maps_mutex);
+  if (!dl_map || dl_map_reconciling || dl_map->pending() == 0) {
+    return 0;
+  }
+  int rc = dl_map->flush();
+  if (rc < 0) {
+    OAILOG_ERROR(LOG_GTPV1U, "Failed to update eBPF map %s: %s\n",
+                 DL_MAP_PATH, strerror(-rc));
+  }
+  return rc;
+}
+
+void gtp_ebpf_dl_map_reconcile_begin(void) {
+  std::lock_guard<std::mutex> lock(ebpf_maps_mutex);
+  dl_map_desired.clear();
+  dl_map_reconciling = true;
+}
+
+int gtp_ebpf_dl_map_reconcile_end(void) {
+  std::lock_guard<std::mutex> lock(ebpf_maps_mutex);
+  dl_map_reconciling = false;
+  if (!dl_map) {
+    dl_map_desired.clear();
+    return 0;
+  }
+  int rc = dl_map->reconcile(dl_map_desired);
+  if (rc < 0) {
+    OAILOG_ERROR(LOG_GTPV1U, "Failed to reconcile eBPF map %s: %s\n",
+                 DL_MAP_PATH, strerror(-rc));
+  } else {
+    OAILOG_INFO(LOG_GTPV1U,
+                "Reconciled eBPF map %s with %zu restored tunnels, %d entries "
+                "changed\n",
+                DL_MAP_PATH, dl_map_desired.size(), rc);
+  }
+  dl_map_desired.clear();
+  return rc;
+}
+
+int gtp_ebpf_read_dl_usage(gtp_ebpf_ue_usage_t** usage) {
+  std::lock_guard<std::mutex> lock(ebpf_maps_mutex);
+  return read_usage(dl_map.get(), usage);
+}
+
+int gtp_ebpf_read_ul_usage(gtp_ebpf_ue_usage_t** usage) {
+  std::lock_guard<std::mutex> lock(ebpf_maps_mutex);
+  return read_usage(ul_map.get(), usage);
+}
@@ -0,0 +1,61 @@
+/**
+ * Copyright 2022 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* File : gtp_tunnel_ebpf.hpp
+ */
+
+#pragma once
+
+#include <netinet/in.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Description: Writes of the GTP downlink eBPF map (dl_map) are queued and
+ * applied in batches by gtp_ebpf_dl_map_flush. After a restart, the map is
+ * reconciled with the tunnels restored from SPGW state: the tunnels added
+ * between gtp_ebpf_dl_map_reconcile_begin and gtp_ebpf_dl_map_reconcile_end
+ * are the desired content of the map and everything else is deleted.
+ */
+
+typedef struct gtp_ebpf_ue_usage_s {
+  struct in_addr ue;
+  uint64_t bytes;
+} gtp_ebpf_ue_usage_t;
+
+// Open the pinned maps, returns -1 if the dl_map does not exist
+int gtp_ebpf_maps_init(void);
+void gtp_ebpf_maps_uninit(void);
+
+void gtp_ebpf_dl_map_add(struct in_addr ue, struct in_addr enb,
+                         uint32_t o_tei, const uint8_t* user_data,
+                         size_t user_data_len);
+void gtp_ebpf_dl_map_delete(struct in_addr ue);
+// Returns 0, or -errno if the kernel rejected the writes
+int gtp_ebpf_dl_map_flush(void);
+
+void gtp_ebpf_dl_map_reconcile_begin(void);
+// Returns the number of entries written or deleted, or -errno
+int gtp_ebpf_dl_map_reconcile_end(void);
+
+/* Byte counters of the downlink and uplink maps per UE. Returns the number of
+ * UEs, *usage is allocated and must be freed by the caller. */
+int gtp_ebpf_read_dl_usage(gtp_ebpf_ue_usage_t** usage);
+int gtp_ebpf_read_ul_usage(gtp_ebpf_ue_usage_t** usage);
+
+#ifdef __cplusplus
+}
+#endif
@@ -27,16 +27,14 @@
 #include "lte/gateway/c/core/oai/lib/3gpp/3gpp_23.003.h"
 #include "lte/gateway/c/core/oai/lib/bstr/bstrlib.h"
 #include "lte/gateway/c/core/oai/lib/openflow/controller/ControllerMain.hpp"
+#include "lte/gateway/c/core/oai/tasks/gtpv1-u/gtp_tunnel_ebpf.hpp"
 #include "lte/gateway/c/core/oai/tasks/gtpv1-u/gtpv1u.h"
-#include "orc8r/gateway/c/common/ebpf/EbpfMapUtils.h"
 
 extern struct gtp_tunnel_ops gtp_tunnel_ops;
 
 // Tunnel port related functionality
 static const char* ovs_gtp_type;
 
-static int ebpf_fd;
-
 #define MAX_GTP_PORT_NAME_LENGTH 39
 
 #define INIT_GTP_TABLE_SIZE 64
@@ -278,6 +276,7 @@ int openflow_uninit(void) {
   if ((ret = stop_of_controller()) < 0) {
     OAILOG_ERROR(LOG_GTPV1U, "Could not stop openflow controller on uninit\n");
   }
+  gtp_ebpf_maps_uninit();
   return ret;
 }
 
@@ -285,7 +284,9 @@ int openflow_init(struct in_addr* ue_net, uint32_t mask, int mtu, int* fd0,
                   int* fd1u, bool persist_state) {
   AssertFatal(start_of_controller(persist_state) >= 0,
               "Could not start openflow controller\n");
-  ebpf_fd = get_map_fd();
+  if (spgw_config.sgw_config.ebpf_enabled && gtp_ebpf_maps_init() < 0) {
+    OAILOG_ERROR(LOG_GTPV1U, "eBPF datapath maps are not available\n");
+  }
   return 0;
 }
 
@@ -305,8 +306,8 @@ int openflow_add_tunnel(struct in_addr ue, struct in6_addr* ue_ipv6, int vlan,
     OAILOG_INFO(LOG_GTPV1U, "Adding UE EBPF ENTRY %d, %d htonl %d \n",
                 ue.s_addr, o_tei, htonl(o_tei));
     if (ue.s_addr != INADDR_ANY && enb.s_addr != INADDR_ANY) {
-      add_ebpf_dl_map_entry(ebpf_fd, ue, enb, o_tei, imsi.digit,
-                            sizeof(imsi.digit));
+      gtp_ebpf_dl_map_add(ue, enb, o_tei, imsi.digit, sizeof(imsi.digit));
+      gtp_ebpf_dl_map_flush();
     }
     // TODO add IPv6 support
   }
@@ -324,7 +325,8 @@ int openflow_del_tunnel(struct in_addr enb, struct in6_addr* enb_ipv6,
 
   if (spgw_config.sgw_config.ebpf_enabled) {
     if (ue.s_addr != INADDR_ANY && enb.s_addr != INADDR_ANY) {
-      delete_ebpf_dl_map_entry(ebpf_fd, ue);
+      gtp_ebpf_dl_map_delete(ue);
+      gtp_ebpf_dl_map_flush();
     }
     // TODO add IPv6 support
   }
@@ -387,52 +389,23 @@ int openflow_delete_paging_rule(struct in_addr ue, struct in6_addr* ue_ipv6) {
  * Send packet marker to enodeB @enb for tunnel @tei.
  */
 int openflow_send_end_marker(struct in_addr enb, uint32_t tei) {
-  static bool end_marker_supported = true;
-  char end_marker_cmd[2048];
-  int rc;
-
-  // End marker needs OVS patch from magma repo, check if it has
-  // worked on this host before trying the cmd.
-  if (!end_marker_supported) {
-    return -ENODEV;
-  }
-
   if (tei == 0 || (uint32_t)enb.s_addr == 0) {
     // No need to send end marker for tunnel with zero tunnel metadata.
     return 0;
   }
-  // use a ethernet packet just to make packet out happy.
-  rc = snprintf(
-      end_marker_cmd, sizeof(end_marker_cmd),
-      "sudo ovs-ofctl packet-out gtp_br0 "
-      "'in_port=local packet=50540000000a5054000000008000,"
-      "actions=load:%" PRIu32
-      "->tun_id[0..31],"
-      "set_field:%s->tun_dst,"
-      "set_field:0xfe->tun_gtpu_msgtype,set_field:0x30->tun_gtpu_flags,output:"
-      "gtp0'",
-      tei, inet_ntoa(enb));
-
-  if (rc < 0) {
-    OAILOG_ERROR(LOG_GTPV1U, "end marker cmd: format error %d", rc);
-    return rc;
-  }
-  rc = system(end_marker_cmd);
-  if (rc != 0) {
-    OAILOG_ERROR(LOG_GTPV1U, "end marker cmd: [%s] failed: %d", end_marker_cmd,
-                 rc);
-    end_marker_supported = false;
-  } else {
-    OAILOG_DEBUG(LOG_GTPV1U, "End marker sent: tei %" PRIu32 " tun_dst %s", tei,
-                 inet_ntoa(enb));
-  }
-  return rc;
+  // End marker needs OVS patch from magma repo, the controller stops sending
+  // them and this returns -ENODEV once the switch has rejected one.
+  return openflow_controller_send_end_marker(enb, tei);
 }
 
 const char* openflow_get_dev_name(void) {
   return bdata(spgw_config.sgw_config.ovs_config.bridge_name);
 }
 
+int openflow_flows_installed(gtp_flows_installed_cb_t cb, void* arg) {
+  return openflow_controller_flows_installed(cb, arg);
+}
+
 static const struct gtp_tunnel_ops openflow_ops = {
     .init = openflow_init,
     .uninit = openflow_uninit,
@@ -447,6 +420,7 @@ static const struct gtp_tunnel_ops openflow_ops = {
     .delete_paging_rule = openflow_delete_paging_rule,
     .send_end_marker = openflow_send_end_marker,
     .get_dev_name = openflow_get_dev_name,
+    .flows_installed = openflow_flows_installed,
 };
 
 const struct gtp_tunnel_ops* gtp_tunnel_ops_init_openflow(void) {
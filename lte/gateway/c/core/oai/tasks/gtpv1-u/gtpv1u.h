@@ -129,7 +129,16 @@ struct ip_flow_dl {
  * int (*send_end_marker) (struct in_addr enb, uint32_t i_tei);
  *        @enb: eNB IP address
  *        @i_tei: RX GTP Tunnel ID
+ *
+ * int (*flows_installed)(gtp_flows_installed_cb_t cb, void* arg);
+ *     Optional. Call cb once the datapath applied every tunnel change
+ *     requested before, with success false if any of them failed. The
+ *     callback runs on a thread of the datapath backend and must not block.
+ *        @cb: completion callback
+ *        @arg: passed to cb
  */
+typedef void (*gtp_flows_installed_cb_t)(void* arg, bool success);
+
 struct gtp_tunnel_ops {
   int (*init)(struct in_addr* ue_net, uint32_t mask, int mtu, int* fd0,
               int* fd1u, bool persist_state);
@@ -162,6 +171,7 @@ struct gtp_tunnel_ops {
   int (*delete_paging_rule)(struct in_addr ue, struct in6_addr* ue_ipv6);
   int (*send_end_marker)(struct in_addr enbode, uint32_t i_tei);
   const char* (*get_dev_name)(void);
+  int (*flows_installed)(gtp_flows_installed_cb_t cb, void* arg);
 };
 
 const struct gtp_tunnel_ops* gtp_tunnel_ops_init_openflow(void);
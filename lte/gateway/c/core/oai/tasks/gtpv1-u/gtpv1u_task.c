@@ -30,8 +30,10 @@
 #include "lte/gateway/c/core/oai/common/log.h"
 #include "lte/gateway/c/core/oai/include/pgw_config.h"
 #include "lte/gateway/c/core/oai/include/spgw_config.h"
+#include "lte/gateway/c/core/oai/include/spgw_state.hpp"
 #include "lte/gateway/c/core/oai/lib/itti/intertask_interface.h"
 #include "lte/gateway/c/core/oai/lib/itti/intertask_interface_types.h"
+#include "lte/gateway/c/core/oai/tasks/gtpv1-u/gtp_tunnel_ebpf.hpp"
 #include "lte/gateway/c/core/oai/tasks/gtpv1-u/gtp_tunnel_upf.h"
 #include "lte/gateway/c/core/oai/tasks/gtpv1-u/gtpv1u.h"
 #include "lte/gateway/c/core/oai/tasks/gtpv1-u/gtpv1u_sgw_defs.h"
@@ -105,6 +107,50 @@ static bool ue_ip_is_in_subnet(struct in_addr _net, int mask,
   return true;
 }
 
+static bool restore_ebpf_dl_tunnel(const hash_key_t keyP,
+                                   void* const elementP, void* parameterP,
+                                   void** resultP) {
+  s_plus_p_gw_eps_bearer_context_information_t* spgw_context =
+      (s_plus_p_gw_eps_bearer_context_information_t*)elementP;
+  sgw_eps_bearer_context_information_t* sgw_context =
+      &spgw_context->sgw_eps_bearer_context_information;
+
+  for (int i = 0; i < BEARERS_PER_UE; i++) {
+    sgw_eps_bearer_ctxt_t* bearer =
+        sgw_context->pdn_connection.sgw_eps_bearers_array[i];
+    // The downlink map only holds the default bearer of each UE
+    if (!bearer ||
+        bearer->eps_bearer_id != sgw_context->pdn_connection.default_bearer) {
+      continue;
+    }
+    struct in_addr ue = bearer->paa.ipv4_address;
+    struct in_addr enb = bearer->enb_ip_address_S1u.address.ipv4_address;
+    if (ue.s_addr != INADDR_ANY && enb.s_addr != INADDR_ANY &&
+        bearer->enb_teid_S1u) {
+      gtp_ebpf_dl_map_add(ue, enb, bearer->enb_teid_S1u,
+                          sgw_context->imsi.digit,
+                          sizeof(sgw_context->imsi.digit));
+    }
+  }
+  return false;
+}
+
+/**
+ * Align the eBPF downlink map with the sessions restored from state, so that
+ * the entries of sessions released while the service was down are removed
+ * and the ones still active are not rewritten.
+ */
+static void reconcile_ebpf_dl_map(void) {
+  hash_table_ts_t* state_teid_ht = get_spgw_teid_state();
+  if (!state_teid_ht) {
+    return;
+  }
+  gtp_ebpf_dl_map_reconcile_begin();
+  hashtable_ts_apply_callback_on_elements(state_teid_ht, restore_ebpf_dl_tunnel,
+                                          NULL, NULL);
+  gtp_ebpf_dl_map_reconcile_end();
+}
+
 //------------------------------------------------------------------------------
 int gtpv1u_init(spgw_state_t* spgw_state_p, spgw_config_t* spgw_config,
                 bool persist_state) {
@@ -154,6 +200,11 @@ int gtpv1u_init(spgw_state_t* spgw_state_p, spgw_config_t* spgw_config,
                        &spgw_state_p->gtpv1u_data.fd0,
                        &spgw_state_p->gtpv1u_data.fd1u, persist_state);
 
+  if (spgw_config->sgw_config.ebpf_enabled &&
+      !spgw_config->sgw_config.ovs_config.pipelined_managed_tbl0) {
+    reconcile_ebpf_dl_map();
+  }
+
   // END-GTP quick integration only for evaluation purpose
 
   // Add route to avoid updating routing during UE attach.
@@ -33,7 +33,8 @@ status_code_e ha_init(const mme_config_t* mme_config);
 bool sync_up_with_orc8r(void);
 
 /*
- * Sends a S1AP_UE_CONTEXT_RELEASE_REQ message to MME.
+ * Sends the offload request to MME_APP, with the S1AP associations of the
+ * requested eNB.
  */
 void handle_agw_offload_req(ha_agw_offload_req_t* offload_req);
 
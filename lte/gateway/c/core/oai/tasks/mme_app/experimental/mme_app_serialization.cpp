@@ -160,6 +160,7 @@ void mme_app_deallocate_ues(mme_app_desc_t* mme_app_desc,
 void mme_app_serialize_ues(mme_app_desc_t* mme_app_desc,
                            const std::vector<ue_mm_context_t*>& contexts) {
   for (auto it = contexts.begin(); it != contexts.end(); ++it) {
+    UE_STATE_MARK_DIRTY(*it);
     put_mme_ue_state(mme_app_desc, (*it)->emm_context.saved_imsi64, true);
   }
 }
@@ -106,10 +106,9 @@ status_code_e select_pdn_type(struct apn_configuration_s* apn_config,
 }
 
 //------------------------------------------------------------------------------
-struct apn_configuration_s* mme_app_select_apn(
+const struct apn_configuration_s* mme_app_select_apn(
     ue_mm_context_t* const ue_context, int* esm_cause) {
-  context_identifier_t default_context_identifier =
-      ue_context->apn_config_profile.context_identifier;
+  const apn_config_profile_t* profile = ue_context->apn_config_profile;
   int index;
   int rc = RETURNok;
 
@@ -118,72 +117,73 @@ struct apn_configuration_s* mme_app_select_apn(
   esm_proc_pdn_type_t ue_selected_pdn_type =
       ue_context->emm_context.esm_ctx.esm_proc_data->pdn_type;
 
-  for (index = 0; index < ue_context->apn_config_profile.nb_apns; index++) {
+  if (!profile) {
+    *esm_cause = ESM_CAUSE_UNKNOWN_ACCESS_POINT_NAME;
+    return NULL;
+  }
+  for (index = 0; index < profile->nb_apns; index++) {
+    const struct apn_configuration_s* apn_config =
+        &profile->apn_configuration[index];
     if (!ue_selected_apn) {
       /*
        * OK we got our default APN
        */
-      if (ue_context->apn_config_profile.apn_configuration[index]
-              .context_identifier == default_context_identifier) {
-        // Select PDN Type
-        rc = select_pdn_type(
-            &ue_context->apn_config_profile.apn_configuration[index],
-            ue_selected_pdn_type, esm_cause);
-        if (*esm_cause == ESM_CAUSE_UNKNOWN_PDN_TYPE || rc == RETURNerror) {
-          return NULL;
-        }
-        OAILOG_INFO(
-            LOG_MME_APP,
-            "Selected APN <%s>, PDN Type <%d> for UE " IMSI_64_FMT "\n",
-            ue_context->apn_config_profile.apn_configuration[index]
-                .service_selection,
-            ue_context->apn_config_profile.apn_configuration[index].pdn_type,
-            ue_context->emm_context._imsi64);
-        return &ue_context->apn_config_profile.apn_configuration[index];
+      if (apn_config->context_identifier == profile->context_identifier) {
+        break;
       }
     } else {
       /*
        * OK we got the UE selected APN
        */
-      if (biseqcaselessblk(
-              ue_selected_apn,
-              ue_context->apn_config_profile.apn_configuration[index]
-                  .service_selection,
-              strlen(ue_context->apn_config_profile.apn_configuration[index]
-                         .service_selection)) == 1) {
-        // Select PDN Type
-        rc = select_pdn_type(
-            &ue_context->apn_config_profile.apn_configuration[index],
-            ue_selected_pdn_type, esm_cause);
-        if (*esm_cause == ESM_CAUSE_UNKNOWN_PDN_TYPE || rc == RETURNerror) {
-          return NULL;
-        }
-        OAILOG_INFO(
-            LOG_MME_APP,
-            "Selected APN <%s>, PDN Type <%d> for UE " IMSI_64_FMT "\n",
-            ue_context->apn_config_profile.apn_configuration[index]
-                .service_selection,
-            ue_context->apn_config_profile.apn_configuration[index].pdn_type,
-            ue_context->emm_context._imsi64);
-
-        return &ue_context->apn_config_profile.apn_configuration[index];
+      if (biseqcaselessblk(ue_selected_apn, apn_config->service_selection,
+                           strlen(apn_config->service_selection)) == 1) {
+        break;
       }
     }
   }
-  *esm_cause = ESM_CAUSE_UNKNOWN_ACCESS_POINT_NAME;
-  return NULL;
+  if (index == profile->nb_apns) {
+    *esm_cause = ESM_CAUSE_UNKNOWN_ACCESS_POINT_NAME;
+    return NULL;
+  }
+
+  // Select PDN Type, the shared profile is read only so the selected type is
+  // set on a copy which replaces the profile of the UE
+  apn_config_profile_t selected = *profile;
+  rc = select_pdn_type(&selected.apn_configuration[index],
+                       ue_selected_pdn_type, esm_cause);
+  if (*esm_cause == ESM_CAUSE_UNKNOWN_PDN_TYPE || rc == RETURNerror) {
+    return NULL;
+  }
+  if (selected.apn_configuration[index].pdn_type !=
+      profile->apn_configuration[index].pdn_type) {
+    mme_app_set_apn_config_profile(ue_context, &selected);
+    profile = ue_context->apn_config_profile;
+    if (!profile) {
+      return NULL;
+    }
+  }
+  OAILOG_INFO(LOG_MME_APP,
+              "Selected APN <%s>, PDN Type <%d> for UE " IMSI_64_FMT "\n",
+              profile->apn_configuration[index].service_selection,
+              profile->apn_configuration[index].pdn_type,
+              ue_context->emm_context._imsi64);
+  return &profile->apn_configuration[index];
 }
 
 //------------------------------------------------------------------------------
-struct apn_configuration_s* mme_app_get_apn_config(
+const struct apn_configuration_s* mme_app_get_apn_config(
     ue_mm_context_t* const ue_context,
     const context_identifier_t context_identifier) {
+  const apn_config_profile_t* profile = ue_context->apn_config_profile;
   int index;
 
-  for (index = 0; index < ue_context->apn_config_profile.nb_apns; index++) {
-    if (ue_context->apn_config_profile.apn_configuration[index]
-            .context_identifier == context_identifier) {
-      return &ue_context->apn_config_profile.apn_configuration[index];
+  if (!profile) {
+    return NULL;
+  }
+  for (index = 0; index < profile->nb_apns; index++) {
+    if (profile->apn_configuration[index].context_identifier ==
+        context_identifier) {
+      return &profile->apn_configuration[index];
     }
   }
   return NULL;
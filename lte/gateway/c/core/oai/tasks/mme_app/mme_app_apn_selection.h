@@ -43,10 +43,10 @@
 #include "lte/gateway/c/core/oai/include/mme_app_ue_context.h"
 #include "lte/gateway/c/core/oai/tasks/nas/esm/esm_proc.h"
 
-struct apn_configuration_s* mme_app_select_apn(
+const struct apn_configuration_s* mme_app_select_apn(
     ue_mm_context_t* const ue_context, int* esm_cause);
 
-struct apn_configuration_s* mme_app_get_apn_config(
+const struct apn_configuration_s* mme_app_get_apn_config(
     ue_mm_context_t* const ue_context,
     const context_identifier_t context_identifier);
 
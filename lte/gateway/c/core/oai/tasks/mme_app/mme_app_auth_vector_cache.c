@@ -0,0 +1,353 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the terms found in the LICENSE file in the root of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+/*! \file mme_app_auth_vector_cache.c
+ * \brief Per IMSI cache of spare E-UTRAN authentication vectors
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "lte/gateway/c/core/common/assertions.h"
+#include "lte/gateway/c/core/common/dynamic_memory_check.h"
+#include "lte/gateway/c/core/oai/common/log.h"
+#include "lte/gateway/c/core/oai/lib/3gpp/3gpp_33.401.h"
+#include "lte/gateway/c/core/oai/lib/bstr/bstrlib.h"
+#include "lte/gateway/c/core/oai/lib/hashtable/hashtable.h"
+#include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_auth_vector_cache.h"
+
+typedef struct cached_vector_s {
+  time_t fetched_sec;
+  eutran_vector_t vector;
+} cached_vector_t;
+
+typedef struct auth_vector_cache_entry_s {
+  uint8_t nb_vectors;
+  // Answers of the refills pending when the vectors were flushed
+  uint8_t stale_answers;
+  bool refill_pending;
+  time_t refill_sent_sec;
+  cached_vector_t vectors[MAX_AUTH_INFO_VECTORS];  // oldest first
+} auth_vector_cache_entry_t;
+
+static struct {
+  pthread_mutex_t lock;
+  auth_vector_cache_config_t config;
+  hash_table_ts_t* entries;  // imsi64 -> auth_vector_cache_entry_t
+} auth_vector_cache = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+//------------------------------------------------------------------------------
+static time_t auth_vector_cache_now(void) {
+  struct timespec now = {0};
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec;
+}
+
+//------------------------------------------------------------------------------
+static bool auth_vector_cache_refill_in_flight(
+    const auth_vector_cache_entry_t* const entry, const time_t now) {
+  // A refill whose answer did not come back within Ts6a is considered lost
+  return entry->refill_pending &&
+         ((now - entry->refill_sent_sec) * 1000 <
+          mme_config_get()->nas_config.ts6a_msec);
+}
+
+//------------------------------------------------------------------------------
+static void auth_vector_cache_drop_expired(
+    auth_vector_cache_entry_t* const entry, const time_t now) {
+  uint8_t expired = 0;
+  while ((expired < entry->nb_vectors) &&
+         (now - entry->vectors[expired].fetched_sec >=
+          auth_vector_cache.config.ttl_sec)) {
+    expired++;
+  }
+  if (expired) {
+    entry->nb_vectors -= expired;
+    memmove(&entry->vectors[0], &entry->vectors[expired],
+            entry->nb_vectors * sizeof(cached_vector_t));
+  }
+}
+
+//------------------------------------------------------------------------------
+static bool auth_vector_cache_entry_unused(
+    const auth_vector_cache_entry_t* const entry, const time_t now) {
+  return !entry->nb_vectors && !entry->stale_answers &&
+         !auth_vector_cache_refill_in_flight(entry, now);
+}
+
+//------------------------------------------------------------------------------
+static auth_vector_cache_entry_t* auth_vector_cache_get(const imsi64_t imsi64,
+                                                        const bool create) {
+  auth_vector_cache_entry_t* entry = NULL;
+
+  if (!auth_vector_cache.entries) {
+    return NULL;
+  }
+  if (hashtable_ts_get(auth_vector_cache.entries, (const hash_key_t)imsi64,
+                       (void**)&entry) == HASH_TABLE_OK) {
+    return entry;
+  }
+  if (!create) {
+    return NULL;
+  }
+  entry = calloc(1, sizeof(auth_vector_cache_entry_t));
+  if (!entry) {
+    return NULL;
+  }
+  if (hashtable_ts_insert(auth_vector_cache.entries, (const hash_key_t)imsi64,
+                          entry) != HASH_TABLE_OK) {
+    free_wrapper((void**)&entry);
+    return NULL;
+  }
+  return entry;
+}
+
+//------------------------------------------------------------------------------
+void mme_app_auth_vector_cache_init(const auth_vector_cache_config_t* config,
+                                    uint32_t max_subscribers) {
+  pthread_mutex_lock(&auth_vector_cache.lock);
+  auth_vector_cache.config = *config;
+  if (!config->enabled) {
+    pthread_mutex_unlock(&auth_vector_cache.lock);
+    return;
+  }
+  if ((config->size < 1) || (config->size > MAX_AUTH_INFO_VECTORS)) {
+    OAILOG_WARNING(LOG_MME_APP,
+                   "Authentication vector cache size %u out of [1, %u]\n",
+                   config->size, MAX_AUTH_INFO_VECTORS);
+    auth_vector_cache.config.size =
+        (config->size < 1) ? 1 : MAX_AUTH_INFO_VECTORS;
+  }
+  if (config->refill_watermark > auth_vector_cache.config.size) {
+    auth_vector_cache.config.refill_watermark = auth_vector_cache.config.size;
+  }
+  bstring name = bfromcstr("mme_app_auth_vector_cache");
+  auth_vector_cache.entries =
+      hashtable_ts_create(max_subscribers, NULL, free_wrapper, name);
+  bdestroy_wrapper(&name);
+  if (!auth_vector_cache.entries) {
+    OAILOG_ERROR(LOG_MME_APP,
+                 "Failed to allocate the authentication vector cache\n");
+    auth_vector_cache.config.enabled = false;
+  } else {
+    auth_vector_cache.entries->log_enabled = false;
+  }
+  pthread_mutex_unlock(&auth_vector_cache.lock);
+}
+
+//------------------------------------------------------------------------------
+void mme_app_auth_vector_cache_exit(void) {
+  pthread_mutex_lock(&auth_vector_cache.lock);
+  if (auth_vector_cache.entries) {
+    hashtable_ts_destroy(auth_vector_cache.entries);
+    auth_vector_cache.entries = NULL;
+  }
+  auth_vector_cache.config.enabled = false;
+  pthread_mutex_unlock(&auth_vector_cache.lock);
+}
+
+//------------------------------------------------------------------------------
+bool mme_app_auth_vector_cache_enabled(void) {
+  return auth_vector_cache.config.enabled;
+}
+
+//------------------------------------------------------------------------------
+uint8_t mme_app_auth_vector_cache_nb_vectors_to_fetch(void) {
+  if (!auth_vector_cache.config.enabled) {
+    return MAX_EPS_AUTH_VECTORS;
+  }
+  uint32_t nb_vectors = MAX_EPS_AUTH_VECTORS + auth_vector_cache.config.size;
+  return (nb_vectors > MAX_AUTH_INFO_VECTORS) ? MAX_AUTH_INFO_VECTORS
+                                              : (uint8_t)nb_vectors;
+}
+
+//------------------------------------------------------------------------------
+bool mme_app_auth_vector_cache_pop(imsi64_t imsi64, eutran_vector_t* vector) {
+  bool hit = false;
+  time_t now = auth_vector_cache_now();
+
+  pthread_mutex_lock(&auth_vector_cache.lock);
+  auth_vector_cache_entry_t* entry = auth_vector_cache_get(imsi64, false);
+  if (entry) {
+    auth_vector_cache_drop_expired(entry, now);
+    if (entry->nb_vectors) {
+      *vector = entry->vectors[0].vector;
+      entry->nb_vectors--;
+      memmove(&entry->vectors[0], &entry->vectors[1],
+              entry->nb_vectors * sizeof(cached_vector_t));
+      hit = true;
+    }
+  }
+  pthread_mutex_unlock(&auth_vector_cache.lock);
+  return hit;
+}
+
+//------------------------------------------------------------------------------
+void mme_app_auth_vector_cache_push(imsi64_t imsi64,
+                                    const eutran_vector_t* vectors,
+                                    uint8_t nb_vectors) {
+  time_t now = auth_vector_cache_now();
+
+  pthread_mutex_lock(&auth_vector_cache.lock);
+  auth_vector_cache_entry_t* entry = auth_vector_cache_get(imsi64, true);
+  if (!entry) {
+    pthread_mutex_unlock(&auth_vector_cache.lock);
+    OAILOG_ERROR(LOG_MME_APP,
+                 "Failed to cache authentication vectors for " IMSI_64_FMT
+                 "\n",
+                 imsi64);
+    return;
+  }
+  auth_vector_cache_drop_expired(entry, now);
+  for (uint8_t i = 0; i < nb_vectors; i++) {
+    if (entry->nb_vectors == auth_vector_cache.config.size) {
+      entry->nb_vectors--;
+      memmove(&entry->vectors[0], &entry->vectors[1],
+              entry->nb_vectors * sizeof(cached_vector_t));
+    }
+    entry->vectors[entry->nb_vectors].fetched_sec = now;
+    entry->vectors[entry->nb_vectors].vector = vectors[i];
+    entry->nb_vectors++;
+  }
+  pthread_mutex_unlock(&auth_vector_cache.lock);
+}
+
+//------------------------------------------------------------------------------
+uint8_t mme_app_auth_vector_cache_start_refill(imsi64_t imsi64) {
+  uint8_t nb_vectors = 0;
+  time_t now = auth_vector_cache_now();
+
+  if (!auth_vector_cache.config.enabled) {
+    return 0;
+  }
+  pthread_mutex_lock(&auth_vector_cache.lock);
+  auth_vector_cache_entry_t* entry = auth_vector_cache_get(imsi64, true);
+  if (entry) {
+    auth_vector_cache_drop_expired(entry, now);
+    if ((entry->nb_vectors < auth_vector_cache.config.refill_watermark) &&
+        !auth_vector_cache_refill_in_flight(entry, now)) {
+      nb_vectors = auth_vector_cache.config.size - entry->nb_vectors;
+      entry->refill_pending = true;
+      entry->refill_sent_sec = now;
+    }
+  }
+  pthread_mutex_unlock(&auth_vector_cache.lock);
+  return nb_vectors;
+}
+
+//------------------------------------------------------------------------------
+bool mme_app_auth_vector_cache_refill_done(imsi64_t imsi64) {
+  bool fresh = true;
+
+  pthread_mutex_lock(&auth_vector_cache.lock);
+  auth_vector_cache_entry_t* entry = auth_vector_cache_get(imsi64, false);
+  if (entry) {
+    if (entry->stale_answers) {
+      entry->stale_answers--;
+      fresh = false;
+    } else {
+      entry->refill_pending = false;
+    }
+  }
+  pthread_mutex_unlock(&auth_vector_cache.lock);
+  return fresh;
+}
+
+//------------------------------------------------------------------------------
+bool mme_app_auth_vector_cache_drop_stale_answer(imsi64_t imsi64) {
+  bool stale = false;
+
+  pthread_mutex_lock(&auth_vector_cache.lock);
+  auth_vector_cache_entry_t* entry = auth_vector_cache_get(imsi64, false);
+  if (entry && entry->stale_answers) {
+    entry->stale_answers--;
+    stale = true;
+  }
+  pthread_mutex_unlock(&auth_vector_cache.lock);
+  return stale;
+}
+
+//------------------------------------------------------------------------------
+void mme_app_auth_vector_cache_flush(imsi64_t imsi64) {
+  time_t now = auth_vector_cache_now();
+
+  pthread_mutex_lock(&auth_vector_cache.lock);
+  auth_vector_cache_entry_t* entry = auth_vector_cache_get(imsi64, false);
+  if (entry) {
+    entry->nb_vectors = 0;
+    if (auth_vector_cache_refill_in_flight(entry, now)) {
+      entry->stale_answers++;
+    }
+    entry->refill_pending = false;
+    if (auth_vector_cache_entry_unused(entry, now)) {
+      hashtable_ts_free(auth_vector_cache.entries, (const hash_key_t)imsi64);
+    }
+  }
+  pthread_mutex_unlock(&auth_vector_cache.lock);
+}
+
+//------------------------------------------------------------------------------
+void mme_app_auth_vector_cache_purge_expired(void) {
+  time_t now = auth_vector_cache_now();
+  uint32_t nb_purged = 0;
+
+  pthread_mutex_lock(&auth_vector_cache.lock);
+  if (!auth_vector_cache.entries || !auth_vector_cache.entries->num_elements) {
+    pthread_mutex_unlock(&auth_vector_cache.lock);
+    return;
+  }
+  hashtable_key_array_t* keys =
+      hashtable_ts_get_keys(auth_vector_cache.entries);
+  for (int i = 0; keys && (i < keys->num_keys); i++) {
+    auth_vector_cache_entry_t* entry = NULL;
+    if (hashtable_ts_get(auth_vector_cache.entries, keys->keys[i],
+                         (void**)&entry) != HASH_TABLE_OK) {
+      continue;
+    }
+    auth_vector_cache_drop_expired(entry, now);
+    // Stale answers that never came back are forgotten with the entry
+    if (!entry->nb_vectors &&
+        !auth_vector_cache_refill_in_flight(entry, now)) {
+      hashtable_ts_free(auth_vector_cache.entries, keys->keys[i]);
+      nb_purged++;
+    }
+  }
+  pthread_mutex_unlock(&auth_vector_cache.lock);
+  if (keys) {
+    FREE_HASHTABLE_KEY_ARRAY(keys);
+  }
+  if (nb_purged) {
+    OAILOG_DEBUG(LOG_MME_APP,
+                 "Purged the authentication vectors of %u subscribers\n",
+                 nb_purged);
+  }
+}
+
+//------------------------------------------------------------------------------
+uint32_t mme_app_auth_vector_cache_nb_subscribers(void) {
+  uint32_t count = 0;
+  pthread_mutex_lock(&auth_vector_cache.lock);
+  if (auth_vector_cache.entries) {
+    count = auth_vector_cache.entries->num_elements;
+  }
+  pthread_mutex_unlock(&auth_vector_cache.lock);
+  return count;
+}
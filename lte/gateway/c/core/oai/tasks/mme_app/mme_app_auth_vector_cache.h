@@ -0,0 +1,108 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the terms found in the LICENSE file in the root of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+/*! \file mme_app_auth_vector_cache.h
+ * \brief Per IMSI cache of spare E-UTRAN authentication vectors
+ *
+ * Without a vector in the UE context, an attach waits for an S6a
+ * Authentication Information round trip before the Authentication Request is
+ * sent. With the cache enabled the MME asks the HSS for a batch of vectors,
+ * uses the first one and keeps the others here, keyed by IMSI, so that they
+ * outlive the UE context. Vectors are handed out oldest first and dropped
+ * once older than the TTL. A new batch is requested in the background when a
+ * subscriber has fewer vectors left than the refill watermark.
+ *
+ * TS 33.401 6.1.2 NOTE 2 recommends fetching one vector at a time: a USIM
+ * without the optional SQN management of TS 33.102 Annex C rejects vectors
+ * used out of order. A synchronisation failure therefore flushes the
+ * subscriber's vectors, and the cache is disabled by default.
+ *
+ * The cache is not part of the UE state saved to Redis and starts empty.
+ */
+
+#ifndef FILE_MME_APP_AUTH_VECTOR_CACHE_SEEN
+#define FILE_MME_APP_AUTH_VECTOR_CACHE_SEEN
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "lte/gateway/c/core/oai/common/common_types.h"
+#include "lte/gateway/c/core/oai/common/security_types.h"
+#include "lte/gateway/c/core/oai/include/mme_config.h"
+
+// Period of the removal of expired vectors
+#define MME_APP_AUTH_VECTOR_CACHE_PURGE_SEC 60
+
+/* max_subscribers sizes the hash table, it is not a limit */
+void mme_app_auth_vector_cache_init(const auth_vector_cache_config_t* config,
+                                    uint32_t max_subscribers);
+
+void mme_app_auth_vector_cache_exit(void);
+
+bool mme_app_auth_vector_cache_enabled(void);
+
+/*
+ * Number of vectors to request from the HSS for a UE that has none: the UE's
+ * vector plus enough to fill the cache.
+ */
+uint8_t mme_app_auth_vector_cache_nb_vectors_to_fetch(void);
+
+/* Move the oldest unexpired vector of imsi64 to vector, false on a miss */
+bool mme_app_auth_vector_cache_pop(imsi64_t imsi64, eutran_vector_t* vector);
+
+/*
+ * Append vectors fetched from the HSS for imsi64. When the cache is full the
+ * oldest vectors are dropped.
+ */
+void mme_app_auth_vector_cache_push(imsi64_t imsi64,
+                                    const eutran_vector_t* vectors,
+                                    uint8_t nb_vectors);
+
+/*
+ * Returns the number of vectors the caller must request from the HSS to
+ * refill the cache of imsi64, and marks the refill pending. Returns 0 when
+ * above the watermark or when a refill is already pending.
+ */
+uint8_t mme_app_auth_vector_cache_start_refill(imsi64_t imsi64);
+
+/*
+ * Account for an Authentication Information Answer for imsi64 that no UE
+ * waits for. Returns false when the answer is stale and must be dropped.
+ */
+bool mme_app_auth_vector_cache_refill_done(imsi64_t imsi64);
+
+/*
+ * Account for an Authentication Information Answer for imsi64 that a UE
+ * waits for. Returns true when the answer is instead the one of a refill
+ * requested before the last flush. It is then stale and must be dropped.
+ */
+bool mme_app_auth_vector_cache_drop_stale_answer(imsi64_t imsi64);
+
+/*
+ * Drop the vectors of imsi64 after a synchronisation failure. Refills still
+ * pending are expected to return stale vectors, their answers are dropped.
+ * This assumes the HSS answers the requests for one IMSI in order.
+ */
+void mme_app_auth_vector_cache_flush(imsi64_t imsi64);
+
+/* Drop the expired vectors and the subscribers left without any */
+void mme_app_auth_vector_cache_purge_expired(void);
+
+/* Number of subscribers with an entry, for the tests */
+uint32_t mme_app_auth_vector_cache_nb_subscribers(void);
+
+#endif /* FILE_MME_APP_AUTH_VECTOR_CACHE_SEEN */
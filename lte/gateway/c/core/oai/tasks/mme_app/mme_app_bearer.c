@@ -571,7 +571,7 @@ imsi64_t update_ue_context_and_indicate_to_nas(
     itti_s1ap_initial_ue_message_t* const initial_pP, bool is_mm_ctx_new) {
   OAILOG_FUNC_IN(LOG_MME_APP);
   imsi64_t imsi64 = INVALID_IMSI64;
-  ue_context_p->sctp_assoc_id_key = initial_pP->sctp_assoc_id;
+  mme_ue_context_update_sctp_assoc_id(ue_context_p, initial_pP->sctp_assoc_id);
   ue_context_p->e_utran_cgi = initial_pP->ecgi;
   // Notify S1AP about the mapping between mme_ue_s1ap_id and
   // sctp assoc id + enb_ue_s1ap_id
@@ -2028,6 +2028,7 @@ status_code_e mme_app_handle_mobile_reachability_timer_expiry(zloop_t* loop,
   // Write updated timer details to redis db directly as there is no UE state
   // change for triggering the update
   mme_app_desc_t* mme_app_desc_p = get_mme_nas_state(false);
+  UE_STATE_MARK_DIRTY(ue_context_p);
   put_mme_ue_state(mme_app_desc_p, ue_context_p->emm_context._imsi64, true);
 
   OAILOG_FUNC_RETURN(LOG_MME_APP, RETURNok);
@@ -2163,7 +2164,6 @@ bool mme_app_construct_guti(const plmn_t* const plmn_p,
       "id "
       "from MME Conf: %u, %u \n",
       s_tmsi_p->m_tmsi, s_tmsi_p->mme_code);
-  mme_config_read_lock(&mme_config);
   /*
    * Check number of MMEs in the pool.
    * At present it is assumed that one MME is supported in MME pool but in case
@@ -2201,7 +2201,6 @@ bool mme_app_construct_guti(const plmn_t* const plmn_p,
     guti_p->gummei.mme_gid = mme_config.gummei.gummei[num_mme].mme_gid;
     is_guti_valid = true;
   }
-  mme_config_unlock(&mme_config);
   return is_guti_valid;
 }
 
@@ -2286,9 +2285,8 @@ status_code_e mme_app_paging_request_helper(ue_mm_context_t* ue_context_p,
   paging_request->domain_indicator = domain_indicator;
 
   // Send TAI List
-  paging_request->tai_list_count =
-      ue_context_p->emm_context._tai_list.numberoflists;
-  tai_list_t* tai_list = &ue_context_p->emm_context._tai_list;
+  const tai_list_t* tai_list = ue_context_p->emm_context._tai_list;
+  paging_request->tai_list_count = tai_list ? tai_list->numberoflists : 0;
   paging_tai_list_t* p_tai_list = NULL;
   for (int tai_list_idx = 0; tai_list_idx < paging_request->tai_list_count;
        tai_list_idx++) {
@@ -3641,7 +3639,8 @@ void mme_app_handle_handover_notify(
   }
 
   // Update sctp assoc id and ecgi
-  ue_context_p->sctp_assoc_id_key = handover_notify_p->target_sctp_assoc_id;
+  mme_ue_context_update_sctp_assoc_id(ue_context_p,
+                                      handover_notify_p->target_sctp_assoc_id);
   ue_context_p->e_utran_cgi = handover_notify_p->ecgi;
 
   // generate the Modify Bearer Request
@@ -3791,7 +3790,8 @@ void mme_app_handle_path_switch_request(
         ue_context_p->mme_ue_s1ap_id, ue_context_p->emm_context._imsi64,
         ue_context_p->mme_teid_s11, &ue_context_p->emm_context._guti);
   }
-  ue_context_p->sctp_assoc_id_key = path_switch_req_p->sctp_assoc_id;
+  mme_ue_context_update_sctp_assoc_id(ue_context_p,
+                                      path_switch_req_p->sctp_assoc_id);
   ue_context_p->e_utran_cgi = path_switch_req_p->ecgi;
 
   /* Security capabilities IE within s1ap message, Path Switch Request is of
@@ -4182,7 +4182,7 @@ void mme_app_handle_path_switch_req_failure(ue_mm_context_t* ue_context_p) {
 }
 
 void mme_app_update_paging_tai_list(paging_tai_list_t* p_tai_list,
-                                    partial_tai_list_t* tai_list,
+                                    const partial_tai_list_t* tai_list,
                                     uint8_t num_of_tac) {
   OAILOG_FUNC_IN(LOG_MME_APP);
   OAILOG_DEBUG(LOG_MME_APP, "Updating TAI list\n");
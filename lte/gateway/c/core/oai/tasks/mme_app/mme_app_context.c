@@ -37,6 +37,7 @@
 #include <sys/time.h>
 #include <time.h>
 
+#include "lte/gateway/c/core/common/assertions.h"
 #include "lte/gateway/c/core/common/common_defs.h"
 #include "lte/gateway/c/core/common/dynamic_memory_check.h"
 #include "lte/gateway/c/core/oai/common/common_types.h"
@@ -61,9 +62,11 @@
 #include "lte/gateway/c/core/oai/lib/itti/itti_types.h"
 #include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_bearer_context.h"
 #include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_defs.h"
+#include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_enb_ue_index.hpp"
 #include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_itti_messaging.h"
 #include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_pdn_context.h"
 #include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_procedures.h"
+#include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_shared_ue_data.h"
 #include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_timer.h"
 #include "lte/gateway/c/core/oai/tasks/nas/api/mme/mme_api.h"
 #include "lte/gateway/c/core/oai/tasks/nas/emm/emm_data.h"
@@ -138,10 +141,10 @@ ue_mm_context_t* mme_create_new_ue_context(void) {
   new_p->mobile_reachability_timer.id = MME_APP_TIMER_INACTIVE_ID;
   new_p->implicit_detach_timer.id = MME_APP_TIMER_INACTIVE_ID;
 
-  new_p->initial_context_setup_rsp_timer =
-      (nas_timer_t){MME_APP_TIMER_INACTIVE_ID, mme_config.nas_config.tics_msec};
+  new_p->initial_context_setup_rsp_timer = (nas_timer_t){
+      MME_APP_TIMER_INACTIVE_ID, mme_config_get()->nas_config.tics_msec};
   new_p->paging_response_timer = (nas_timer_t){
-      MME_APP_TIMER_INACTIVE_ID, mme_config.nas_config.tpaging_msec};
+      MME_APP_TIMER_INACTIVE_ID, mme_config_get()->nas_config.tpaging_msec};
   new_p->ulr_response_timer = (nas_timer_t){MME_APP_TIMER_INACTIVE_ID,
                                             MME_APP_ULR_RESPONSE_TIMER_VALUE};
   new_p->ue_context_modification_timer = (nas_timer_t){
@@ -190,11 +193,21 @@ void mme_app_ue_sgs_context_free_content(sgs_context_t* const sgs_context_p,
   }
 }
 
+//------------------------------------------------------------------------------
+void mme_app_set_apn_config_profile(ue_mm_context_t* const ue_context_p,
+                                    const apn_config_profile_t* const profile) {
+  const apn_config_profile_t* previous = ue_context_p->apn_config_profile;
+  ue_context_p->apn_config_profile =
+      profile ? mme_app_share_apn_config_profile(profile) : NULL;
+  mme_app_release_apn_config_profile(&previous);
+}
+
 //------------------------------------------------------------------------------
 void mme_app_ue_context_free_content(ue_mm_context_t* const ue_context_p) {
   bdestroy_wrapper(&ue_context_p->msisdn);
   bdestroy_wrapper(&ue_context_p->ue_radio_capability);
   bdestroy_wrapper(&ue_context_p->apn_oi_replacement);
+  mme_app_release_apn_config_profile(&ue_context_p->apn_config_profile);
 
   // Stop Mobile reachability timer,if running
   if (ue_context_p->mobile_reachability_timer.id != MME_APP_TIMER_INACTIVE_ID) {
@@ -443,6 +456,9 @@ void mme_ue_context_update_coll_keys(
       h_rc = hashtable_ts_insert(mme_state_ue_id_ht,
                                  (const hash_key_t)mme_ue_s1ap_id,
                                  (void*)ue_context_p);
+      mme_app_enb_ue_index_remove(ue_context_p->sctp_assoc_id_key,
+                                  ue_context_p->mme_ue_s1ap_id);
+      mme_app_enb_ue_index_add(ue_context_p->sctp_assoc_id_key, mme_ue_s1ap_id);
 
       if (HASH_TABLE_OK != h_rc) {
         OAILOG_ERROR_UE(LOG_MME_APP, imsi,
@@ -552,6 +568,16 @@ void mme_ue_context_update_coll_keys(
   OAILOG_FUNC_OUT(LOG_MME_APP);
 }
 
+//------------------------------------------------------------------------------
+void mme_ue_context_update_sctp_assoc_id(ue_mm_context_t* const ue_context_p,
+                                         const sctp_assoc_id_t sctp_assoc_id) {
+  if (INVALID_MME_UE_S1AP_ID != ue_context_p->mme_ue_s1ap_id) {
+    mme_app_enb_ue_index_move(ue_context_p->mme_ue_s1ap_id,
+                              ue_context_p->sctp_assoc_id_key, sctp_assoc_id);
+  }
+  ue_context_p->sctp_assoc_id_key = sctp_assoc_id;
+}
+
 //------------------------------------------------------------------------------
 void mme_ue_context_dump_coll_keys(const mme_ue_context_t* mme_ue_contexts_p) {
   bstring tmp = bfromcstr(" ");
@@ -650,6 +676,8 @@ status_code_e mme_insert_ue_context(
                      ue_context_p, ue_context_p->mme_ue_s1ap_id);
       OAILOG_FUNC_RETURN(LOG_MME_APP, RETURNerror);
     }
+    mme_app_enb_ue_index_add(ue_context_p->sctp_assoc_id_key,
+                             ue_context_p->mme_ue_s1ap_id);
 
     // filled IMSI
     if (ue_context_p->emm_context._imsi64) {
@@ -812,6 +840,8 @@ void mme_remove_ue_context(mme_ue_context_t* const mme_ue_context_p,
   }
   // filled NAS UE ID/ MME UE S1AP ID
   if (INVALID_MME_UE_S1AP_ID != ue_context_p->mme_ue_s1ap_id) {
+    mme_app_enb_ue_index_remove(ue_context_p->sctp_assoc_id_key,
+                                ue_context_p->mme_ue_s1ap_id);
     hash_rc = hashtable_ts_remove(
         mme_state_ue_id_ht, (const hash_key_t)ue_context_p->mme_ue_s1ap_id,
         (void**)&ue_context_p);
@@ -864,7 +894,7 @@ void mme_ue_context_update_ue_sig_connection_state(
         "= " MME_UE_S1AP_ID_FMT "\n",
         ue_context_p->mme_ue_s1ap_id);
 
-    if (mme_config.nas_config.t3412_min > 0) {
+    if (mme_config_get()->nas_config.t3412_min > 0) {
       // Start Mobile reachability timer only if periodic TAU timer is not
       // disabled
       if (ue_context_p->mobile_reachability_timer.id ==
@@ -1047,36 +1077,66 @@ void mme_app_handle_s1ap_ue_context_modification_resp(
   OAILOG_FUNC_OUT(LOG_MME_APP);
 }
 //------------------------------------------------------------------------------
+// The UEs of a lost eNB are released on the bulk signalling queue, a slice at
+// a time, so that the other eNBs are still served while a large eNB is
+// cleaned up
+static void mme_app_release_deregistered_ue(void* ctx, uint32_t index) {
+  itti_s1ap_eNB_deregistered_ind_t* eNB_deregistered_ind =
+      (itti_s1ap_eNB_deregistered_ind_t*)ctx;
+  mme_app_handle_s1ap_ue_context_release(
+      eNB_deregistered_ind->mme_ue_s1ap_id[index],
+      eNB_deregistered_ind->enb_ue_s1ap_id[index], eNB_deregistered_ind->enb_id,
+      S1AP_SCTP_SHUTDOWN_OR_RESET);
+}
+
+static void mme_app_enb_deregister_done(void* ctx, bool completed) {
+  if (completed) {
+    // The releases run from the queue's timer rather than handle_message
+    put_mme_nas_state();
+  }
+  free_wrapper(&ctx);
+}
+
 void mme_app_handle_enb_deregister_ind(
     const itti_s1ap_eNB_deregistered_ind_t* const eNB_deregistered_ind) {
-  for (int i = 0; i < eNB_deregistered_ind->nb_ue_to_deregister; i++) {
-    mme_app_handle_s1ap_ue_context_release(
-        eNB_deregistered_ind->mme_ue_s1ap_id[i],
-        eNB_deregistered_ind->enb_ue_s1ap_id[i], eNB_deregistered_ind->enb_id,
-        S1AP_SCTP_SHUTDOWN_OR_RESET);
-  }
+  itti_s1ap_eNB_deregistered_ind_t* job_ctx =
+      calloc(1, sizeof(itti_s1ap_eNB_deregistered_ind_t));
+  DevAssert(job_ctx);
+  memcpy(job_ctx, eNB_deregistered_ind,
+         sizeof(itti_s1ap_eNB_deregistered_ind_t));
+  paced_queue_submit(&mme_app_bulk_queue, "enb_deregister",
+                     PACED_QUEUE_PRIORITY_NORMAL,
+                     eNB_deregistered_ind->nb_ue_to_deregister,
+                     mme_app_release_deregistered_ue,
+                     mme_app_enb_deregister_done, job_ctx);
 }
 
 //------------------------------------------------------------------------------
-void mme_app_handle_enb_reset_req(
-    const itti_s1ap_enb_initiated_reset_req_t* const enb_reset_req) {
+static void mme_app_release_reset_ue(void* ctx, uint32_t index) {
+  itti_s1ap_enb_initiated_reset_req_t* enb_reset_req =
+      (itti_s1ap_enb_initiated_reset_req_t*)ctx;
+  mme_app_handle_s1ap_ue_context_release(
+      enb_reset_req->ue_to_reset_list[index].mme_ue_s1ap_id,
+      enb_reset_req->ue_to_reset_list[index].enb_ue_s1ap_id,
+      enb_reset_req->enb_id, S1AP_SCTP_SHUTDOWN_OR_RESET);
+}
+
+// The Reset Ack is sent once every UE of the request has been released
+static void mme_app_enb_reset_done(void* ctx, bool completed) {
+  itti_s1ap_enb_initiated_reset_req_t* enb_reset_req =
+      (itti_s1ap_enb_initiated_reset_req_t*)ctx;
   MessageDef* msg;
   itti_s1ap_enb_initiated_reset_ack_t* reset_ack;
 
-  OAILOG_INFO(LOG_MME_APP,
-              " eNB Reset request received. eNB id = %d, reset_type  %d \n ",
-              enb_reset_req->enb_id, enb_reset_req->s1ap_reset_type);
-  if (enb_reset_req->ue_to_reset_list == NULL) {
-    OAILOG_ERROR(LOG_MME_APP,
-                 "Invalid UE list received in eNB Reset Request\n");
-    OAILOG_FUNC_OUT(LOG_MME_APP);
-  }
-
-  for (int i = 0; i < enb_reset_req->num_ue; i++) {
-    mme_app_handle_s1ap_ue_context_release(
-        enb_reset_req->ue_to_reset_list[i].mme_ue_s1ap_id,
-        enb_reset_req->ue_to_reset_list[i].enb_ue_s1ap_id,
-        enb_reset_req->enb_id, S1AP_SCTP_SHUTDOWN_OR_RESET);
+  if (!completed) {
+    // The job is only dropped by paced_queue_destroy in mme_app_exit, when
+    // the MME is terminating. Some UEs were not released, so the Reset Ack
+    // would be wrong, and S1AP is terminating as well. The SCTP association
+    // goes down with the MME and the eNB resets its UEs when it sets up S1
+    // again.
+    free_wrapper((void**)&enb_reset_req->ue_to_reset_list);
+    free_wrapper(&ctx);
+    return;
   }
 
   // Send Reset Ack to S1AP module
@@ -1096,6 +1156,31 @@ void mme_app_handle_enb_reset_req(
   OAILOG_INFO(LOG_MME_APP,
               " Reset Ack sent to S1AP. eNB id = %d, reset_type  %d \n ",
               enb_reset_req->enb_id, enb_reset_req->s1ap_reset_type);
+  put_mme_nas_state();
+  free_wrapper(&ctx);
+}
+
+//------------------------------------------------------------------------------
+void mme_app_handle_enb_reset_req(
+    const itti_s1ap_enb_initiated_reset_req_t* const enb_reset_req) {
+  itti_s1ap_enb_initiated_reset_req_t* job_ctx;
+
+  OAILOG_INFO(LOG_MME_APP,
+              " eNB Reset request received. eNB id = %d, reset_type  %d \n ",
+              enb_reset_req->enb_id, enb_reset_req->s1ap_reset_type);
+  if (enb_reset_req->ue_to_reset_list == NULL) {
+    OAILOG_ERROR(LOG_MME_APP,
+                 "Invalid UE list received in eNB Reset Request\n");
+    OAILOG_FUNC_OUT(LOG_MME_APP);
+  }
+
+  // The eNB is waiting for the Reset Ack, so resets go before other bulk work
+  job_ctx = calloc(1, sizeof(itti_s1ap_enb_initiated_reset_req_t));
+  DevAssert(job_ctx);
+  memcpy(job_ctx, enb_reset_req, sizeof(itti_s1ap_enb_initiated_reset_req_t));
+  paced_queue_submit(&mme_app_bulk_queue, "enb_reset",
+                     PACED_QUEUE_PRIORITY_HIGH, enb_reset_req->num_ue,
+                     mme_app_release_reset_ue, mme_app_enb_reset_done, job_ctx);
 
   OAILOG_FUNC_OUT(LOG_MME_APP);
 }
@@ -1315,6 +1400,7 @@ static void mme_app_handle_s1ap_ue_context_release(
   // Set the UE context release cause in UE context. This is used while
   // constructing UE Context Release Command
   ue_mm_context->ue_context_rel_cause = cause;
+  UE_STATE_MARK_DIRTY(ue_mm_context);
 
   if (ue_mm_context->ecm_state == ECM_IDLE) {
     // This case could happen during sctp reset, before the UE could move to
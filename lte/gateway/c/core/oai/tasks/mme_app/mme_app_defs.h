@@ -31,6 +31,7 @@
 #define FILE_MME_APP_DEFS_SEEN
 
 #include "lte/gateway/c/core/oai/lib/itti/intertask_interface.h"
+#include "lte/gateway/c/core/oai/lib/itti/itti_paced_queue.h"
 
 #include "lte/gateway/c/core/oai/include/mme_app_desc.h"
 #include "lte/gateway/c/core/oai/include/mme_app_ue_context.h"
@@ -52,6 +53,8 @@
   (mme_congestion_params.mme_app_zmq_smc_th)  // microseconds
 
 extern task_zmq_ctx_t mme_app_task_zmq_ctx;
+// Paces the per UE work of eNB wide operations
+extern paced_queue_t mme_app_bulk_queue;
 
 typedef struct mme_congestion_params_s {
   long mme_app_zmq_congest_th;
@@ -331,7 +334,7 @@ status_code_e emm_send_cs_domain_attach_or_tau_accept(
     struct ue_mm_context_s* ue_context_p);
 
 void mme_app_update_paging_tai_list(paging_tai_list_t* p_tai_list,
-                                    partial_tai_list_t* tai_list,
+                                    const partial_tai_list_t* tai_list,
                                     uint8_t num_of_tac);
 
 void send_delete_dedicated_bearer_rsp(struct ue_mm_context_s* ue_context_p,
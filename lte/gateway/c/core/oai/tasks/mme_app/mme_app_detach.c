@@ -95,10 +95,8 @@ void mme_app_send_delete_session_request(
   OAI_GCC_DIAG_ON("-Wpointer-to-int-cast");
   S11_DELETE_SESSION_REQUEST(message_p).sender_fteid_for_cp.interface_type =
       S11_MME_GTP_C;
-  mme_config_read_lock(&mme_config);
   S11_DELETE_SESSION_REQUEST(message_p).sender_fteid_for_cp.ipv4_address =
       mme_config.ip.s11_mme_v4;
-  mme_config_unlock(&mme_config);
   S11_DELETE_SESSION_REQUEST(message_p).sender_fteid_for_cp.ipv4 = 1;
   S11_DELETE_SESSION_REQUEST(message_p).indication_flags.oi = 1;
 
@@ -109,10 +107,8 @@ void mme_app_send_delete_session_request(
       ->s_gw_address_s11_s4.address.ipv4_address.s_addr =
       mme_config.e_dns_emulation.sgw_ip_addr[0].s_addr;
   S11_DELETE_SESSION_REQUEST(message_p).trxn = NULL;
-  mme_config_read_lock(&mme_config);
   S11_DELETE_SESSION_REQUEST(message_p).peer_ip =
       ue_context_p->pdn_contexts[cid]->s_gw_address_s11_s4.address.ipv4_address;
-  mme_config_unlock(&mme_config);
 
   mme_app_get_user_location_information(
       &(S11_DELETE_SESSION_REQUEST(message_p).uli), ue_context_p);
@@ -0,0 +1,93 @@
+/*
+Copyright 2020 The Magma Authors.
+
+This source code is licensed under the BSD-style license found in the
+LICENSE file in the root directory of this source tree.
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <stdlib.h>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_enb_ue_index.hpp"
+
+extern "C" {
+#include "lte/gateway/c/core/common/assertions.h"
+#include "lte/gateway/c/core/oai/common/log.h"
+}
+
+namespace {
+typedef std::unordered_map<sctp_assoc_id_t,
+                           std::unordered_set<mme_ue_s1ap_id_t>>
+    EnbUeMap;
+
+// Only accessed from the MME_APP task, like the UE contexts it indexes
+EnbUeMap enb_ue_map;
+
+void remove_ue(sctp_assoc_id_t sctp_assoc_id,
+               mme_ue_s1ap_id_t mme_ue_s1ap_id) {
+  auto itr_map = enb_ue_map.find(sctp_assoc_id);
+  if (itr_map == enb_ue_map.end()) {
+    return;
+  }
+  itr_map->second.erase(mme_ue_s1ap_id);
+  if (itr_map->second.empty()) {
+    enb_ue_map.erase(itr_map);
+  }
+}
+}  // namespace
+
+void mme_app_enb_ue_index_add(sctp_assoc_id_t sctp_assoc_id,
+                              mme_ue_s1ap_id_t mme_ue_s1ap_id) {
+  enb_ue_map[sctp_assoc_id].insert(mme_ue_s1ap_id);
+  OAILOG_TRACE(LOG_MME_APP,
+               "Indexed ue_id " MME_UE_S1AP_ID_FMT " on sctp_assoc_id %u\n",
+               mme_ue_s1ap_id, sctp_assoc_id);
+}
+
+void mme_app_enb_ue_index_remove(sctp_assoc_id_t sctp_assoc_id,
+                                 mme_ue_s1ap_id_t mme_ue_s1ap_id) {
+  remove_ue(sctp_assoc_id, mme_ue_s1ap_id);
+}
+
+void mme_app_enb_ue_index_move(mme_ue_s1ap_id_t mme_ue_s1ap_id,
+                               sctp_assoc_id_t old_sctp_assoc_id,
+                               sctp_assoc_id_t new_sctp_assoc_id) {
+  if (old_sctp_assoc_id == new_sctp_assoc_id) {
+    return;
+  }
+  remove_ue(old_sctp_assoc_id, mme_ue_s1ap_id);
+  enb_ue_map[new_sctp_assoc_id].insert(mme_ue_s1ap_id);
+}
+
+uint32_t mme_app_enb_ue_index_get_ues(sctp_assoc_id_t sctp_assoc_id,
+                                      mme_ue_s1ap_id_t** ue_id_list) {
+  if (ue_id_list) {
+    *ue_id_list = NULL;
+  }
+  auto itr_map = enb_ue_map.find(sctp_assoc_id);
+  if (itr_map == enb_ue_map.end()) {
+    return 0;
+  }
+  uint32_t num_ues = itr_map->second.size();
+  if (ue_id_list) {
+    *ue_id_list =
+        (mme_ue_s1ap_id_t*)calloc(num_ues, sizeof(mme_ue_s1ap_id_t));
+    AssertFatal(*ue_id_list != NULL, "UE id list allocation failed");
+    uint32_t i = 0;
+    for (const auto& ue_id : itr_map->second) {
+      (*ue_id_list)[i++] = ue_id;
+    }
+  }
+  return num_ues;
+}
+
+void mme_app_enb_ue_index_clear(void) {
+  enb_ue_map.clear();
+}
@@ -0,0 +1,43 @@
+/*
+Copyright 2020 The Magma Authors.
+
+This source code is licensed under the BSD-style license found in the
+LICENSE file in the root directory of this source tree.
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#pragma once
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include "lte/gateway/c/core/oai/common/common_types.h"
+#include "lte/gateway/c/core/oai/lib/3gpp/3gpp_36.401.h"
+
+/* Description: MME_APP keeps the mme_ue_s1ap_id of every UE context under the
+ * SCTP association of the eNB it was last connected through
+ * (ue_mm_context_t.sctp_assoc_id_key), so that eNB wide operations only visit
+ * the UEs of that eNB. The index is in-memory only and is rebuilt from the UE
+ * contexts when they are restored from the data store.
+ */
+void mme_app_enb_ue_index_add(sctp_assoc_id_t sctp_assoc_id,
+                              mme_ue_s1ap_id_t mme_ue_s1ap_id);
+void mme_app_enb_ue_index_remove(sctp_assoc_id_t sctp_assoc_id,
+                                 mme_ue_s1ap_id_t mme_ue_s1ap_id);
+void mme_app_enb_ue_index_move(mme_ue_s1ap_id_t mme_ue_s1ap_id,
+                               sctp_assoc_id_t old_sctp_assoc_id,
+                               sctp_assoc_id_t new_sctp_assoc_id);
+/* Returns the number of UEs on the association. When ue_id_list is not NULL,
+ * it is set to a copy of their mme_ue_s1ap_ids that the caller must free. */
+uint32_t mme_app_enb_ue_index_get_ues(sctp_assoc_id_t sctp_assoc_id,
+                                      mme_ue_s1ap_id_t** ue_id_list);
+void mme_app_enb_ue_index_clear(void);
+#ifdef __cplusplus
+}
+#endif
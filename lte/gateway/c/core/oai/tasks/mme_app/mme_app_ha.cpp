@@ -15,6 +15,8 @@
  *      contact@openairinterface.org
  */
 
+#include <vector>
+
 extern "C" {
 #include "lte/gateway/c/core/oai/common/log.h"
 #include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_ha.hpp"
@@ -24,8 +26,12 @@ extern "C" {
 #include "lte/gateway/c/core/oai/common/common_types.h"
 #include "lte/gateway/c/core/oai/lib/itti/intertask_interface_types.h"
 #include "lte/gateway/c/core/oai/lib/itti/itti_types.h"
+#include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_defs.h"
 }
 
+#include "lte/gateway/c/core/oai/include/mme_app_state.hpp"
+#include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_enb_ue_index.hpp"
+
 extern task_zmq_ctx_t mme_app_task_zmq_ctx;
 
 void mme_app_handle_ue_offload(ue_mm_context_t* ue_context_p) {
@@ -42,3 +48,137 @@ void mme_app_handle_ue_offload(ue_mm_context_t* ue_context_p) {
   send_msg_to_task(&mme_app_task_zmq_ctx, TASK_HA, message_p);
   return;
 }
+
+// Returns true if no other UE needs to be offloaded for this request
+static bool trigger_agw_offload_for_ue(
+    mme_app_desc_t* mme_app_desc_p, ue_mm_context_t* ue_context_p,
+    uint32_t enb_id, const ha_agw_offload_req_t* offload_request) {
+  bool any_flag = false;  // true if we tried offloading any UE
+
+  offload_type_t enb_offtype = offload_request->enb_offload_type;
+  // When a UE is in ECM_CONNECTED state, we can direcly start offloading.
+  // For a UE in ECM_IDLE mode however, we need to first page the user and
+  // then we can offload it.
+  if ((ue_context_p->ecm_state == ECM_CONNECTED) &&
+      ((enb_offtype == ALL) || (enb_offtype == ANY) ||
+       (enb_offtype == ANY_CONNECTED))) {
+    itti_s1ap_ue_context_release_req_t release_req = {0};
+    release_req.mme_ue_s1ap_id = ue_context_p->mme_ue_s1ap_id;
+    release_req.enb_ue_s1ap_id = ue_context_p->enb_ue_s1ap_id;
+    release_req.enb_id = enb_id;
+    release_req.relCause = S1AP_NAS_MME_OFFLOADING;
+
+    OAILOG_INFO(LOG_MME_APP,
+                "Processing IMSI64: " IMSI_64_FMT
+                " Requested IMSI: %s, MME UE ID: " MME_UE_S1AP_ID_FMT
+                ", ENB UE ID: " ENB_UE_S1AP_ID_FMT
+                " , UE Context ENB ID: %d, UE Context cell id: %d, S1AP "
+                "ENB ID: %d",
+                ue_context_p->emm_context._imsi64, offload_request->imsi,
+                ue_context_p->mme_ue_s1ap_id, ue_context_p->enb_ue_s1ap_id,
+                ue_context_p->e_utran_cgi.cell_identity.enb_id,
+                ue_context_p->e_utran_cgi.cell_identity.cell_id, enb_id);
+    OAILOG_INFO(LOG_MME_APP,
+                "UE Context Release procedure initiated for IMSI%s",
+                offload_request->imsi);
+    mme_app_handle_s1ap_ue_context_release_req(&release_req);
+    any_flag = true;
+  } else if ((ue_context_p->ecm_state == ECM_IDLE) &&
+             (ue_context_p->mm_state == UE_REGISTERED) &&
+             ((enb_offtype == ALL) || (enb_offtype == ANY) ||
+              (enb_offtype == ANY_IDLE))) {
+    // Upon connection re-establishment, this release cause value will
+    // be checked and cleared by MME APP to send offload request.
+    ue_context_p->ue_context_rel_cause = S1AP_NAS_MME_PENDING_OFFLOADING;
+
+    char imsi[IMSI_BCD_DIGITS_MAX + 1] = {0};
+    IMSI64_TO_STRING(ue_context_p->emm_context._imsi64, imsi,
+                     ue_context_p->emm_context._imsi.length);
+
+    OAILOG_INFO(LOG_MME_APP, "Paging procedure initiated for IMSI%s", imsi);
+    itti_s11_paging_request_t paging_request = {0};
+    paging_request.imsi = imsi;
+    mme_app_handle_initial_paging_request(mme_app_desc_p, &paging_request);
+    UE_STATE_MARK_DIRTY(ue_context_p);
+    put_mme_ue_state(mme_app_desc_p, ue_context_p->emm_context._imsi64, true);
+    any_flag = true;
+  }
+
+  // Check if iterations should be stopped as single match was
+  // sufficient.
+  if (any_flag && ((enb_offtype == ANY) || (enb_offtype == ANY_CONNECTED) ||
+                   (enb_offtype == ANY_IDLE))) {
+    return true;
+  }
+  return false;
+}
+
+// Offload of the UEs of an eNB, run on mme_app_bulk_queue a slice at a time
+struct enb_offload_job_t {
+  ha_agw_offload_req_t request;
+  imsi64_t handled_imsi64;
+  std::vector<mme_ue_s1ap_id_t> ues;
+  bool done;
+};
+
+static void offload_enb_ue(void* ctx, uint32_t index) {
+  auto* job = static_cast<enb_offload_job_t*>(ctx);
+  if (job->done) {
+    return;  // a single UE was requested and it was already offloaded
+  }
+  ue_mm_context_t* ue_context_p =
+      mme_ue_context_exists_mme_ue_s1ap_id(job->ues[index]);
+  if (ue_context_p == NULL) {
+    return;  // released since the job was queued
+  }
+  if (ue_context_p->emm_context._imsi64 == job->handled_imsi64) {
+    return;  // already handled when the request was received
+  }
+  job->done = trigger_agw_offload_for_ue(get_mme_nas_state(false), ue_context_p,
+                                         job->request.eNB_id, &job->request);
+}
+
+static void offload_enb_done(void* ctx, bool completed) {
+  if (completed) {
+    // The releases run from the queue's timer rather than handle_message
+    put_mme_nas_state();
+  }
+  delete static_cast<enb_offload_job_t*>(ctx);
+}
+
+void mme_app_handle_agw_offload_req(
+    mme_app_desc_t* mme_app_desc_p,
+    const ha_agw_offload_ues_req_t* offload_ues_req) {
+  const ha_agw_offload_req_t* offload_req = &offload_ues_req->request;
+  imsi64_t imsi64 = INVALID_IMSI64;
+
+  IMSI_STRING_TO_IMSI64(offload_req->imsi, &imsi64);
+  if (imsi64 != INVALID_IMSI64) {
+    ue_mm_context_t* ue_context_p =
+        mme_ue_context_exists_imsi(&mme_app_desc_p->mme_ue_contexts, imsi64);
+    if (ue_context_p &&
+        trigger_agw_offload_for_ue(
+            mme_app_desc_p, ue_context_p,
+            ue_context_p->e_utran_cgi.cell_identity.enb_id, offload_req)) {
+      return;
+    }
+  }
+
+  if (offload_ues_req->nb_sctp_assoc == 0) {
+    return;
+  }
+  auto* job = new enb_offload_job_t();
+  job->request = *offload_req;
+  job->handled_imsi64 = imsi64;
+  job->done = false;
+  for (uint32_t i = 0; i < offload_ues_req->nb_sctp_assoc; i++) {
+    mme_ue_s1ap_id_t* ue_id_list = NULL;
+    uint32_t num_ues = mme_app_enb_ue_index_get_ues(
+        offload_ues_req->sctp_assoc_id[i], &ue_id_list);
+    job->ues.insert(job->ues.end(), ue_id_list, ue_id_list + num_ues);
+    free(ue_id_list);
+  }
+  paced_queue_submit(&mme_app_bulk_queue, "agw_offload",
+                     PACED_QUEUE_PRIORITY_LOW, job->ues.size(), offload_enb_ue,
+                     offload_enb_done, job);
+}
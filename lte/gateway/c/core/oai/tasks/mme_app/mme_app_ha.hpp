@@ -17,6 +17,16 @@
 
 #pragma once
 
+#include "lte/gateway/c/core/oai/include/ha_messages_types.h"
+#include "lte/gateway/c/core/oai/include/mme_app_desc.h"
 #include "lte/gateway/c/core/oai/include/mme_app_ue_context.h"
 
 void mme_app_handle_ue_offload(ue_mm_context_t* ue_context_p);
+
+/*
+ * Offloads the UEs selected by an HA offload request. The UEs of the
+ * requested eNB are offloaded on the bulk signalling queue.
+ */
+void mme_app_handle_agw_offload_req(
+    mme_app_desc_t* mme_app_desc_p,
+    const ha_agw_offload_ues_req_t* offload_ues_req);
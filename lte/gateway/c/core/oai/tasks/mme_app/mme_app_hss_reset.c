@@ -78,6 +78,7 @@ status_code_e mme_app_handle_s6a_reset_req(
            * hss has restarted and MME shall send ULR to hss
            */
           ue_context_p->location_info_confirmed_in_hss = true;
+          UE_STATE_MARK_DIRTY(ue_context_p);
           /*
            * set the sgs context flag: neaf to indicate that,
            * hss has restarted and MME shall send SGS Ue Activity Indication to
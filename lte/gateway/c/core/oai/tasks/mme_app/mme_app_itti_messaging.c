@@ -313,7 +313,6 @@ status_code_e mme_app_send_s11_create_session_req(
   session_request_p->sender_fteid_for_cp.teid =
       (teid_t)ue_mm_context->mme_ue_s1ap_id;
   session_request_p->sender_fteid_for_cp.interface_type = S11_MME_GTP_C;
-  mme_config_read_lock(&mme_config);
   if (session_request_p->pdn_type == IPv4 ||
       session_request_p->pdn_type == IPv4_AND_v6) {
     session_request_p->sender_fteid_for_cp.ipv4_address.s_addr =
@@ -326,7 +325,6 @@ status_code_e mme_app_send_s11_create_session_req(
 
     session_request_p->sender_fteid_for_cp.ipv6 = 1;
   }
-  mme_config_unlock(&mme_config);
 
   // ue_mm_context->mme_teid_s11 = session_request_p->sender_fteid_for_cp.teid;
   ue_mm_context->pdn_contexts[pdn_cid]->s_gw_teid_s11_s4 = 0;
@@ -336,8 +334,10 @@ status_code_e mme_app_send_s11_create_session_req(
       ue_mm_context->emm_context._imsi64,
       session_request_p->sender_fteid_for_cp.teid,  // mme_teid_s11 is new
       &ue_mm_context->emm_context._guti);
-  struct apn_configuration_s* selected_apn_config_p = mme_app_get_apn_config(
-      ue_mm_context, ue_mm_context->pdn_contexts[pdn_cid]->context_identifier);
+  const struct apn_configuration_s* selected_apn_config_p =
+      mme_app_get_apn_config(
+          ue_mm_context,
+          ue_mm_context->pdn_contexts[pdn_cid]->context_identifier);
 
   memcpy(session_request_p->apn, selected_apn_config_p->service_selection,
          selected_apn_config_p->service_selection_length);
@@ -367,7 +367,7 @@ status_code_e mme_app_send_s11_create_session_req(
     uint8_t j;
 
     for (j = 0; j < selected_apn_config_p->nb_ip_address; j++) {
-      ip_address_t* ip_address = &selected_apn_config_p->ip_address[j];
+      const ip_address_t* ip_address = &selected_apn_config_p->ip_address[j];
 
       if (ip_address->pdn_type == IPv4) {
         session_request_p->paa.ipv4_address.s_addr =
@@ -336,9 +336,8 @@ status_code_e mme_app_handle_s6a_update_location_ans(
 
   ue_mm_context->rau_tau_timer = ula_pP->subscription_data.rau_tau_timer;
   ue_mm_context->network_access_mode = ula_pP->subscription_data.access_mode;
-  memcpy(&ue_mm_context->apn_config_profile,
-         &ula_pP->subscription_data.apn_config_profile,
-         sizeof(apn_config_profile_t));
+  mme_app_set_apn_config_profile(ue_mm_context,
+                                 &ula_pP->subscription_data.apn_config_profile);
   memcpy(&ue_mm_context->default_charging_characteristics,
          &ula_pP->subscription_data.default_charging_characteristics,
          sizeof(charging_characteristics_t));
@@ -353,18 +352,18 @@ status_code_e mme_app_handle_s6a_update_location_ans(
    */
   ue_mm_context->mobile_reachability_timer.id = MME_APP_TIMER_INACTIVE_ID;
   ue_mm_context->implicit_detach_timer.id = MME_APP_TIMER_INACTIVE_ID;
+  const nas_config_t* nas_config = &mme_config_get()->nas_config;
 #if !MME_UNIT_TEST
   ue_mm_context->mobile_reachability_timer.msec =
-      ((mme_config.nas_config.t3412_min) +
+      ((nas_config->t3412_min) +
        MME_APP_DELTA_T3412_REACHABILITY_TIMER) *
       60000;
   ue_mm_context->implicit_detach_timer.msec =
       (ue_mm_context->mobile_reachability_timer.msec) +
       MME_APP_DELTA_REACHABILITY_IMPLICIT_DETACH_TIMER * 60000;
 #else  /* !MME_UNIT_TEST */
-  ue_mm_context->mobile_reachability_timer.msec =
-      mme_config.nas_config.t3412_msec;
-  ue_mm_context->implicit_detach_timer.msec = mme_config.nas_config.t3412_msec;
+  ue_mm_context->mobile_reachability_timer.msec = nas_config->t3412_msec;
+  ue_mm_context->implicit_detach_timer.msec = nas_config->t3412_msec;
 #endif /* !MME_UNIT_TEST */
 
   /*
@@ -44,6 +44,7 @@
 #include "lte/gateway/c/core/oai/lib/itti/intertask_interface.h"
 #include "lte/gateway/c/core/oai/lib/itti/intertask_interface_types.h"
 #include "lte/gateway/c/core/oai/lib/message_utils/service303_message_utils.h"
+#include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_auth_vector_cache.h"
 #include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_defs.h"
 #include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_edns_emulation.h"
 #include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_extern.h"
@@ -58,6 +59,7 @@ static void check_mme_healthy_and_notify_service(void);
 static bool is_mme_app_healthy(void);
 static void mme_app_exit(void);
 static void start_stats_timer(void);
+static void start_auth_vector_cache_timer(void);
 
 bool mme_hss_associated = false;
 bool mme_sctp_bounded = false;
@@ -67,6 +69,9 @@ long mme_app_last_msg_latency;
 long pre_mme_task_msg_latency;
 static long epc_stats_timer_id;
 static size_t epc_stats_timer_sec = 60;
+static long auth_vector_cache_timer_id = -1;
+static paced_queue_config_t mme_app_bulk_queue_config;
+paced_queue_t mme_app_bulk_queue;
 
 mme_congestion_params_t mme_congestion_params;
 
@@ -76,6 +81,7 @@ static int handle_message(zloop_t* loop, zsock_t* reader, void* arg) {
   mme_app_desc_t* mme_app_desc_p = get_mme_nas_state(false);
 
   bool is_task_state_same = false;
+  bool is_ue_state_same = false;
   bool force_ue_write = false;
 
   mme_app_last_msg_latency =
@@ -88,6 +94,7 @@ static int handle_message(zloop_t* loop, zsock_t* reader, void* arg) {
   switch (ITTI_MSG_ID(received_message_p)) {
     case MESSAGE_TEST: {
       OAI_FPRINTF_INFO("TASK_MME_APP received MESSAGE_TEST\n");
+      is_ue_state_same = true;
     } break;
 
     case MME_APP_INITIAL_CONTEXT_SETUP_RSP: {
@@ -243,6 +250,13 @@ static int handle_message(zloop_t* loop, zsock_t* reader, void* arg) {
       is_task_state_same = true;
     } break;
 
+    case AGW_OFFLOAD_UES_REQ: {
+      // The UEs are offloaded, and persisted, by the bulk queue job
+      mme_app_handle_agw_offload_req(
+          mme_app_desc_p, &AGW_OFFLOAD_UES_REQ(received_message_p));
+      is_ue_state_same = true;
+    } break;
+
     case S11_PAGING_REQUEST: {
       OAILOG_DEBUG(LOG_MME_APP, "MME handling paging request \n");
       imsi64 = mme_app_handle_initial_paging_request(
@@ -291,6 +305,7 @@ static int handle_message(zloop_t* loop, zsock_t* reader, void* arg) {
     case ACTIVATE_MESSAGE: {
       mme_hss_associated = true;
       is_task_state_same = true;
+      is_ue_state_same = true;
       check_mme_healthy_and_notify_service();
     } break;
 
@@ -299,6 +314,7 @@ static int handle_message(zloop_t* loop, zsock_t* reader, void* arg) {
           &received_message_p->ittiMsg.sctp_mme_server_initialized.successful;
       check_mme_healthy_and_notify_service();
       is_task_state_same = true;
+      is_ue_state_same = true;
     } break;
 
     case S6A_PURGE_UE_ANS: {
@@ -469,6 +485,7 @@ static int handle_message(zloop_t* loop, zsock_t* reader, void* arg) {
           MME_APP_TEST_PROTOBUF_SERIALIZATION(received_message_p).num_ues);
       force_ue_write = false;
       is_task_state_same = true;
+      is_ue_state_same = true;
     } break;
 #endif
     case TERMINATE_MESSAGE: {
@@ -486,9 +503,13 @@ static int handle_message(zloop_t* loop, zsock_t* reader, void* arg) {
       OAILOG_ERROR(
           LOG_MME_APP, "Unknown message (%s) received with message Id: %d\n",
           ITTI_MSG_NAME(received_message_p), ITTI_MSG_ID(received_message_p));
+      is_ue_state_same = true;
     } break;
   }
 
+  if (!is_ue_state_same) {
+    mark_mme_ue_state_dirty(mme_app_desc_p, imsi64);
+  }
   put_mme_ue_state(mme_app_desc_p, imsi64, force_ue_write);
 
   if (!is_task_state_same) {
@@ -508,10 +529,13 @@ static void* mme_app_thread(__attribute__((unused)) void* args) {
       (task_id_t[]){TASK_SPGW_APP, TASK_SGS, TASK_SMS_ORC8R, TASK_S11, TASK_S6A,
                     TASK_S1AP, TASK_SERVICE303, TASK_HA, TASK_SGW_S8},
       9, handle_message, &mme_app_task_zmq_ctx);
+  paced_queue_init(&mme_app_bulk_queue, &mme_app_task_zmq_ctx, LOG_MME_APP,
+                   &mme_app_bulk_queue_config);
 
   // Service started, but not healthy yet
   send_app_health_to_service303(&mme_app_task_zmq_ctx, TASK_MME_APP, false);
   start_stats_timer();
+  start_auth_vector_cache_timer();
 
   zloop_start(mme_app_task_zmq_ctx.event_loop);
   AssertFatal(0,
@@ -552,6 +576,15 @@ status_code_e mme_app_init(const mme_config_t* mme_config_p) {
   // Initialize global stats timer
   epc_stats_timer_sec = (size_t)mme_config_p->stats_timer_sec;
 
+  mme_app_bulk_queue_config.items_per_tick =
+      mme_config_p->bulk_signalling_ues_per_tick;
+  mme_app_bulk_queue_config.tick_ms = mme_config_p->bulk_signalling_tick_ms;
+  mme_app_bulk_queue_config.max_items_per_sec =
+      mme_config_p->bulk_signalling_max_ues_per_sec;
+
+  mme_app_auth_vector_cache_init(&mme_config_p->nas_config.auth_vector_cache,
+                                 mme_config_p->max_ues);
+
   /*
    * Create the thread associated with MME applicative layer
    */
@@ -572,6 +605,10 @@ static int handle_stats_timer(zloop_t* loop, int id, void* arg) {
   stats_msg.nb_default_eps_bearers = mme_app_desc_p->nb_default_eps_bearers;
   stats_msg.nb_s1u_bearers = mme_app_desc_p->nb_s1u_bearers;
   stats_msg.nb_mme_app_last_msg_latency = mme_app_last_msg_latency;
+  stats_msg.nb_bulk_signalling_ues_pending =
+      mme_app_bulk_queue.stats.items_pending;
+  stats_msg.nb_bulk_signalling_ues_processed =
+      mme_app_bulk_queue.stats.items_processed;
 
   return send_mme_app_stats_to_service303(&mme_app_task_zmq_ctx, TASK_MME_APP,
                                           &stats_msg);
@@ -583,6 +620,19 @@ static void start_stats_timer(void) {
                   TIMER_REPEAT_FOREVER, handle_stats_timer, NULL);
 }
 
+static int handle_auth_vector_cache_timer(zloop_t* loop, int id, void* arg) {
+  mme_app_auth_vector_cache_purge_expired();
+  return 0;
+}
+
+static void start_auth_vector_cache_timer(void) {
+  if (mme_app_auth_vector_cache_enabled()) {
+    auth_vector_cache_timer_id = start_timer(
+        &mme_app_task_zmq_ctx, 1000 * MME_APP_AUTH_VECTOR_CACHE_PURGE_SEC,
+        TIMER_REPEAT_FOREVER, handle_auth_vector_cache_timer, NULL);
+  }
+}
+
 static void check_mme_healthy_and_notify_service(void) {
   if (is_mme_app_healthy()) {
     send_app_health_to_service303(&mme_app_task_zmq_ctx, TASK_MME_APP, true);
@@ -596,6 +646,11 @@ static bool is_mme_app_healthy(void) {
 //------------------------------------------------------------------------------
 static void mme_app_exit(void) {
   stop_timer(&mme_app_task_zmq_ctx, epc_stats_timer_id);
+  if (auth_vector_cache_timer_id != -1) {
+    stop_timer(&mme_app_task_zmq_ctx, auth_vector_cache_timer_id);
+  }
+  mme_app_auth_vector_cache_exit();
+  paced_queue_destroy(&mme_app_bulk_queue);
   mme_app_edns_exit();
   clear_mme_nas_state();
   // Clean-up NAS module
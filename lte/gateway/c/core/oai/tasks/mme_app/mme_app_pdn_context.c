@@ -70,7 +70,7 @@ pdn_context_t* mme_app_create_pdn_context(
     pdn_context_t* pdn_context = calloc(1, sizeof(*pdn_context));
 
     if (pdn_context) {
-      struct apn_configuration_s* apn_configuration =
+      const struct apn_configuration_s* apn_configuration =
           mme_app_get_apn_config(ue_mm_context, context_identifier);
       if (apn_configuration) {
         mme_app_pdn_context_init(ue_mm_context, pdn_context);
@@ -119,6 +119,7 @@ bool mme_app_handle_reset_indication(const hash_key_t keyP,
     OAILOG_FUNC_RETURN(LOG_MME_APP, false);
   }
 
+  UE_STATE_MARK_DIRTY(ue_context_p);
   ue_context_p->sgs_context->sgsap_msg = NULL; /* sgs message */
   sgs_fsm.primitive = _SGS_RESET_INDICATION;
   sgs_fsm.ue_id = ue_context_p->mme_ue_s1ap_id;
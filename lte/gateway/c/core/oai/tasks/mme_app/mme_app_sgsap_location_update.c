@@ -66,7 +66,6 @@ void mme_app_update_granted_service_for_ue(ue_mm_context_t* ue_context) {
   OAILOG_FUNC_IN(LOG_MME_APP);
   additional_updt_t additional_update_type =
       (additional_updt_t)ue_context->emm_context.additional_update_type;
-  mme_config_read_lock(&mme_config);
 
   if ((additional_update_type != MME_APP_SMS_ONLY) &&
       !(strcmp((const char*)mme_config.non_eps_service_control->data,
@@ -92,7 +91,6 @@ void mme_app_update_granted_service_for_ue(ue_mm_context_t* ue_context) {
         ADDITIONAL_UPDT_RES_SMS_ONLY;
     ue_context->emm_context.csfbparams.presencemask |= ADD_UPDATE_TYPE;
   }
-  mme_config_unlock(&mme_config);
   OAILOG_FUNC_OUT(LOG_MME_APP);
 }
 
@@ -458,7 +456,6 @@ status_code_e send_itti_sgsap_location_update_req(
     }
   }
   // New LAI - Retrieve from conf
-  mme_config_read_lock(&mme_config);
   sgsap_location_update_req->newlaicsfb.mccdigit1 = mme_config.lai.mccdigit1;
   sgsap_location_update_req->newlaicsfb.mccdigit2 = mme_config.lai.mccdigit2;
   sgsap_location_update_req->newlaicsfb.mccdigit3 = mme_config.lai.mccdigit3;
@@ -466,7 +463,6 @@ status_code_e send_itti_sgsap_location_update_req(
   sgsap_location_update_req->newlaicsfb.mncdigit2 = mme_config.lai.mncdigit2;
   sgsap_location_update_req->newlaicsfb.mncdigit3 = mme_config.lai.mncdigit3;
   sgsap_location_update_req->newlaicsfb.lac = mme_config.lai.lac;
-  mme_config_unlock(&mme_config);
 
   // IMEISV
   sgsap_location_update_req->presencemask |= SGSAP_IMEISV;
@@ -0,0 +1,194 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the terms found in the LICENSE file in the root of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+/*! \file mme_app_shared_ue_data.c
+ * \brief Read-only UE data shared between UE contexts
+ */
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lte/gateway/c/core/common/dynamic_memory_check.h"
+#include "lte/gateway/c/core/oai/common/log.h"
+#include "lte/gateway/c/core/oai/lib/bstr/bstrlib.h"
+#include "lte/gateway/c/core/oai/lib/hashtable/obj_hashtable.h"
+#include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_shared_ue_data.h"
+
+// Few distinct values are expected, one per subscription profile
+#define SHARED_UE_DATA_HTBL_SZ 64
+
+typedef struct shared_entry_s {
+  uint32_t refcount;
+  uint32_t size;
+  uint64_t data[];
+} shared_entry_t;
+
+// The copies are keyed by their content, data is the shared_entry_t
+typedef struct shared_store_s {
+  pthread_mutex_t lock;
+  const char* name;
+  obj_hash_table_t* entries;
+} shared_store_t;
+
+static shared_store_t apn_config_profiles = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .name = "mme_app_shared_apn_config_profiles",
+};
+static shared_store_t tai_lists = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .name = "mme_app_shared_tai_lists",
+};
+
+//------------------------------------------------------------------------------
+// FNV-1a, the default obj_hashtable hash xors 4 byte words which collides on
+// mostly zero structures
+static hash_size_t shared_entry_hash(const void* const key, const int size) {
+  const uint8_t* bytes = (const uint8_t*)key;
+  uint32_t hash = 2166136261u;
+  for (int i = 0; i < size; i++) {
+    hash = (hash ^ bytes[i]) * 16777619u;
+  }
+  return hash;
+}
+
+//------------------------------------------------------------------------------
+static const void* shared_store_get(shared_store_t* const store,
+                                    const void* const value,
+                                    const uint32_t size) {
+  shared_entry_t* entry = NULL;
+
+  pthread_mutex_lock(&store->lock);
+  if (!store->entries) {
+    bstring name = bfromcstr(store->name);
+    store->entries = obj_hashtable_create(
+        SHARED_UE_DATA_HTBL_SZ, shared_entry_hash, NULL, NULL, name);
+    bdestroy_wrapper(&name);
+    if (!store->entries) {
+      pthread_mutex_unlock(&store->lock);
+      return NULL;
+    }
+    store->entries->log_enabled = false;
+  }
+  if (obj_hashtable_get(store->entries, value, size, (void**)&entry) ==
+      HASH_TABLE_OK) {
+    entry->refcount++;
+    pthread_mutex_unlock(&store->lock);
+    return entry->data;
+  }
+  entry = malloc(sizeof(shared_entry_t) + size);
+  if (!entry) {
+    pthread_mutex_unlock(&store->lock);
+    return NULL;
+  }
+  entry->refcount = 1;
+  entry->size = size;
+  memcpy(entry->data, value, size);
+  if (obj_hashtable_insert(store->entries, entry->data, size, entry) !=
+      HASH_TABLE_OK) {
+    free_wrapper((void**)&entry);
+    pthread_mutex_unlock(&store->lock);
+    return NULL;
+  }
+  pthread_mutex_unlock(&store->lock);
+  return entry->data;
+}
+
+//------------------------------------------------------------------------------
+static void shared_store_put(shared_store_t* const store,
+                             const void* const value) {
+  shared_entry_t* entry =
+      (shared_entry_t*)((uint8_t*)value - offsetof(shared_entry_t, data));
+
+  pthread_mutex_lock(&store->lock);
+  if (--entry->refcount == 0) {
+    // Frees the entry with the key copy
+    obj_hashtable_free(store->entries, entry->data, entry->size);
+  }
+  pthread_mutex_unlock(&store->lock);
+}
+
+//------------------------------------------------------------------------------
+static uint32_t shared_store_count(shared_store_t* const store) {
+  uint32_t count = 0;
+  pthread_mutex_lock(&store->lock);
+  if (store->entries) {
+    count = store->entries->num_elements;
+  }
+  pthread_mutex_unlock(&store->lock);
+  return count;
+}
+
+//------------------------------------------------------------------------------
+const apn_config_profile_t* mme_app_share_apn_config_profile(
+    const apn_config_profile_t* const profile) {
+  // Equal profiles must compare equal byte for byte, so the unused
+  // configurations are cleared
+  apn_config_profile_t key = *profile;
+  if (key.nb_apns < MAX_APN_PER_UE) {
+    memset(&key.apn_configuration[key.nb_apns], 0,
+           (MAX_APN_PER_UE - key.nb_apns) * sizeof(apn_configuration_t));
+  }
+  const apn_config_profile_t* shared =
+      shared_store_get(&apn_config_profiles, &key, sizeof(key));
+  if (!shared) {
+    OAILOG_ERROR(LOG_MME_APP, "Failed to share APN configuration profile\n");
+  }
+  return shared;
+}
+
+//------------------------------------------------------------------------------
+void mme_app_release_apn_config_profile(const apn_config_profile_t** profile) {
+  if (*profile) {
+    shared_store_put(&apn_config_profiles, *profile);
+    *profile = NULL;
+  }
+}
+
+//------------------------------------------------------------------------------
+const tai_list_t* mme_app_share_tai_list(const tai_list_t* const tai_list) {
+  tai_list_t key = *tai_list;
+  if (key.numberoflists < TRACKING_AREA_IDENTITY_LIST_MAXIMUM_NUM_TAI) {
+    memset(&key.partial_tai_list[key.numberoflists], 0,
+           (TRACKING_AREA_IDENTITY_LIST_MAXIMUM_NUM_TAI - key.numberoflists) *
+               sizeof(partial_tai_list_t));
+  }
+  const tai_list_t* shared = shared_store_get(&tai_lists, &key, sizeof(key));
+  if (!shared) {
+    OAILOG_ERROR(LOG_MME_APP, "Failed to share TAI list\n");
+  }
+  return shared;
+}
+
+//------------------------------------------------------------------------------
+void mme_app_release_tai_list(const tai_list_t** tai_list) {
+  if (*tai_list) {
+    shared_store_put(&tai_lists, *tai_list);
+    *tai_list = NULL;
+  }
+}
+
+//------------------------------------------------------------------------------
+uint32_t mme_app_shared_apn_config_profiles_count(void) {
+  return shared_store_count(&apn_config_profiles);
+}
+
+//------------------------------------------------------------------------------
+uint32_t mme_app_shared_tai_lists_count(void) {
+  return shared_store_count(&tai_lists);
+}
@@ -0,0 +1,54 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the terms found in the LICENSE file in the root of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+/*! \file mme_app_shared_ue_data.h
+ * \brief Read-only UE data shared between UE contexts
+ *
+ * The APN configuration profile and the TAI list are the two largest members
+ * of a UE context, yet almost every subscriber of a gateway carries the same
+ * ones. They are stored once here, reference counted, and the UE contexts
+ * only keep a pointer to the shared copy. A shared copy must never be
+ * modified: build a new value and share it instead.
+ */
+
+#ifndef FILE_MME_APP_SHARED_UE_DATA_SEEN
+#define FILE_MME_APP_SHARED_UE_DATA_SEEN
+
+#include <stdint.h>
+
+#include "lte/gateway/c/core/oai/common/common_types.h"
+#include "lte/gateway/c/core/oai/tasks/nas/ies/TrackingAreaIdentityList.h"
+
+/*
+ * Return the shared copy equal to profile, creating it if needed, with one
+ * more reference. Returns NULL if the copy could not be allocated.
+ */
+const apn_config_profile_t* mme_app_share_apn_config_profile(
+    const apn_config_profile_t* const profile);
+
+/* Drop the reference held in *profile and set it to NULL */
+void mme_app_release_apn_config_profile(const apn_config_profile_t** profile);
+
+const tai_list_t* mme_app_share_tai_list(const tai_list_t* const tai_list);
+
+void mme_app_release_tai_list(const tai_list_t** tai_list);
+
+/* Number of distinct shared copies, for the statistics and the tests */
+uint32_t mme_app_shared_apn_config_profiles_count(void);
+uint32_t mme_app_shared_tai_lists_count(void);
+
+#endif /* FILE_MME_APP_SHARED_UE_DATA_SEEN */
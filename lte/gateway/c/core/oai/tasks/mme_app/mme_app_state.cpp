@@ -52,12 +52,25 @@ void put_mme_nas_state() {
  * Release the memory allocated for the MME NAS state, this does not clean the
  * state persisted in data store
  */
-void clear_mme_nas_state() { MmeNasStateManager::getInstance().free_state(); }
+void clear_mme_nas_state() {
+  MmeNasStateManager::getInstance().stop_redis_writers();
+  MmeNasStateManager::getInstance().free_state();
+}
 
 hash_table_ts_t* get_mme_ue_state() {
   return MmeNasStateManager::getInstance().get_ue_state_ht();
 }
 
+void mark_mme_ue_state_dirty(mme_app_desc_t* mme_app_desc_p, imsi64_t imsi64) {
+  if (imsi64 != INVALID_IMSI64) {
+    ue_mm_context_t* ue_context =
+        mme_ue_context_exists_imsi(&mme_app_desc_p->mme_ue_contexts, imsi64);
+    if (ue_context) {
+      UE_STATE_MARK_DIRTY(ue_context);
+    }
+  }
+}
+
 void put_mme_ue_state(mme_app_desc_t* mme_app_desc_p, imsi64_t imsi64,
                       bool force_ue_write) {
   if (MmeNasStateManager::getInstance().is_persist_state_enabled()) {
@@ -500,9 +500,11 @@ void MmeNasStateConverter::ue_context_to_proto(
   char lai_bytes[IE_LENGTH_LAI];
   lai_to_bytes(&state_ue_context->lai, lai_bytes);
   ue_context_proto->set_lai(lai_bytes, IE_LENGTH_LAI);
-  StateConverter::apn_config_profile_to_proto(
-      state_ue_context->apn_config_profile,
-      ue_context_proto->mutable_apn_config());
+  if (state_ue_context->apn_config_profile) {
+    StateConverter::apn_config_profile_to_proto(
+        *state_ue_context->apn_config_profile,
+        ue_context_proto->mutable_apn_config());
+  }
   ue_context_proto->set_subscriber_status(state_ue_context->subscriber_status);
   ue_context_proto->set_network_access_mode(
       state_ue_context->network_access_mode);
@@ -589,8 +591,13 @@ void MmeNasStateConverter::proto_to_ue_mm_context(
   state_ue_mm_context->cell_age = ue_context_proto.cell_age();
   bytes_to_lai(ue_context_proto.lai().c_str(), &state_ue_mm_context->lai);
 
-  StateConverter::proto_to_apn_config_profile(
-      ue_context_proto.apn_config(), &state_ue_mm_context->apn_config_profile);
+  state_ue_mm_context->apn_config_profile = nullptr;
+  if (ue_context_proto.has_apn_config()) {
+    apn_config_profile_t apn_config_profile = {};
+    StateConverter::proto_to_apn_config_profile(ue_context_proto.apn_config(),
+                                                &apn_config_profile);
+    mme_app_set_apn_config_profile(state_ue_mm_context, &apn_config_profile);
+  }
 
   state_ue_mm_context->subscriber_status =
       (subscriber_status_t)ue_context_proto.subscriber_status();
@@ -653,15 +660,15 @@ void MmeNasStateConverter::proto_to_ue_mm_context(
   state_ue_mm_context->mobile_reachability_timer.id = MME_APP_TIMER_INACTIVE_ID;
   state_ue_mm_context->implicit_detach_timer.id = MME_APP_TIMER_INACTIVE_ID;
   state_ue_mm_context->mobile_reachability_timer.msec =
-      ((mme_config.nas_config.t3412_min) +
+      ((mme_config_get()->nas_config.t3412_min) +
        MME_APP_DELTA_T3412_REACHABILITY_TIMER) *
       60000;
   state_ue_mm_context->implicit_detach_timer.msec =
       (state_ue_mm_context->mobile_reachability_timer.msec) +
       MME_APP_DELTA_REACHABILITY_IMPLICIT_DETACH_TIMER * 60000;
 
-  state_ue_mm_context->initial_context_setup_rsp_timer =
-      (nas_timer_t){MME_APP_TIMER_INACTIVE_ID, mme_config.nas_config.tics_msec};
+  state_ue_mm_context->initial_context_setup_rsp_timer = (nas_timer_t){
+      MME_APP_TIMER_INACTIVE_ID, mme_config_get()->nas_config.tics_msec};
   state_ue_mm_context->paging_response_timer = (nas_timer_t){
       MME_APP_TIMER_INACTIVE_ID, MME_APP_PAGING_RESPONSE_TIMER_VALUE};
   state_ue_mm_context->ulr_response_timer = (nas_timer_t){
@@ -23,6 +23,7 @@ extern "C" {
 #include "lte/gateway/c/core/oai/tasks/nas/emm/emm_proc.h"
 }
 
+#include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_enb_ue_index.hpp"
 #include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_state_manager.hpp"
 
 namespace {
@@ -76,6 +77,7 @@ int MmeNasStateManager::initialize_state(const mme_config_t* mme_config_p) {
   int rc = read_state_from_db();
   read_ue_state_from_db();
   create_mme_ueip_imsi_map();
+  start_redis_writers(mme_config_p->state_writer_threads);
   is_initialized = true;
   return rc;
 }
@@ -192,6 +194,7 @@ void MmeNasStateManager::clear_mme_nas_hashtables() {
   }
 
   hashtable_ts_destroy(state_ue_ht);
+  mme_app_enb_ue_index_clear();
   hashtable_uint64_ts_destroy(
       state_cache_p->mme_ue_contexts.imsi_mme_ue_id_htbl);
   hashtable_uint64_ts_destroy(
@@ -215,6 +218,7 @@ void MmeNasStateManager::free_state() {
 status_code_e MmeNasStateManager::read_ue_state_from_db() {
 #if !MME_UNIT_TEST
   if (persist_state_enabled) {
+    flush_redis_writes();
     auto keys = redis_client->get_keys("IMSI*" + task_name + "*");
     for (const auto& key : keys) {
       OAILOG_DEBUG(log_task, "Reading UE state from db for %s", key.c_str());
@@ -235,6 +239,8 @@ status_code_e MmeNasStateManager::read_ue_state_from_db() {
                      ue_context->mme_ue_s1ap_id,
                      hashtable_rc_code2string(h_rc));
       } else {
+        mme_app_enb_ue_index_add(ue_context->sctp_assoc_id_key,
+                                 ue_context->mme_ue_s1ap_id);
         OAILOG_DEBUG(
             log_task,
             "Inserted UE state with key mme_ue_s1ap_id " MME_UE_S1AP_ID_FMT,
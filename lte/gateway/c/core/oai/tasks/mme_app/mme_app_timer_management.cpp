@@ -61,6 +61,7 @@ void mme_app_resume_timer(struct ue_mm_context_s* const ue_mm_context_pP,
   if (timer->msec <= elapsed_time_in_ms) {
     // In this case, the timer has no id since it is just getting resumed, pass
     // the UE context to expiry handler
+    UE_STATE_MARK_DIRTY(ue_mm_context_pP);
     timer_expiry_handler(mme_app_task_zmq_ctx.event_loop, timer->id,
                          reinterpret_cast<void*>(ue_mm_context_pP));
     OAILOG_FUNC_OUT(LOG_MME_APP);
@@ -94,8 +95,22 @@ void mme_app_resume_timer(struct ue_mm_context_s* const ue_mm_context_pP,
   OAILOG_FUNC_OUT(LOG_MME_APP);
 }
 //------------------------------------------------------------------------------
+// Expiry handlers run from the event loop rather than handle_message, the UE
+// they are about to modify is marked here so that the next write persists it
+static void mme_mark_timer_ue_state_dirty(mme_ue_s1ap_id_t ue_id) {
+  ue_mm_context_t* ue_context_p = mme_ue_context_exists_mme_ue_s1ap_id(ue_id);
+  if (ue_context_p) {
+    UE_STATE_MARK_DIRTY(ue_context_p);
+  }
+}
+
 bool mme_pop_timer_arg(int timer_id, timer_arg_t* arg) {
-  return magma::lte::MmeUeContext::Instance().PopTimerById(timer_id, arg);
+  bool result =
+      magma::lte::MmeUeContext::Instance().PopTimerById(timer_id, arg);
+  if (result) {
+    mme_mark_timer_ue_state_dirty(arg->ue_id);
+  }
+  return result;
 }
 
 bool mme_pop_timer_arg_ue_id(int timer_id, mme_ue_s1ap_id_t* ue_id) {
@@ -103,6 +118,9 @@ bool mme_pop_timer_arg_ue_id(int timer_id, mme_ue_s1ap_id_t* ue_id) {
   bool result =
       magma::lte::MmeUeContext::Instance().PopTimerById(timer_id, &arg);
   *ue_id = arg.ue_id;
+  if (result) {
+    mme_mark_timer_ue_state_dirty(arg.ue_id);
+  }
   return result;
 }
 
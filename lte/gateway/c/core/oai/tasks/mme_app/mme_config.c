@@ -46,6 +46,7 @@
 #include <string.h>
 #include <arpa/inet.h> /* To provide inet_addr */
 #include <pthread.h>
+#include <time.h>
 #include <libconfig.h>
 #include <netinet/in.h>
 
@@ -69,9 +70,9 @@
 #if EMBEDDED_SGW
 #include "lte/gateway/c/core/oai/include/sgw_config.h"
 #endif
-static bool parse_bool(const char* str);
+static bool parse_bool(const char* str, const char** bad_bool);
 
-struct mme_config_s mme_config = {.rw_lock = PTHREAD_RWLOCK_INITIALIZER, 0};
+struct mme_config_s mme_config = {0};
 
 void log_config_init(log_config_t* log_conf) {
   memset(log_conf, 0, sizeof(*log_conf));
@@ -119,6 +120,7 @@ void ipv4_config_init(ip_t* ip) {
 void s1ap_config_init(s1ap_config_t* s1ap_conf) {
   s1ap_conf->port_number = S1AP_PORT_NUMBER;
   s1ap_conf->outcome_drop_timer_sec = S1AP_OUTCOME_TIMER_DEFAULT;
+  s1ap_conf->decoder_threads = 0;
 }
 
 void s6a_config_init(s6a_config_t* s6a_conf) {
@@ -165,6 +167,10 @@ void nas_config_init(nas_config_t* nas_conf) {
   nas_conf->disable_esm_information = false;
   nas_conf->enable_apn_correction = false;
   apn_map_config_init(&nas_conf->apn_map_config);
+  nas_conf->auth_vector_cache.enabled = false;
+  nas_conf->auth_vector_cache.size = 4;
+  nas_conf->auth_vector_cache.ttl_sec = 3600;
+  nas_conf->auth_vector_cache.refill_watermark = 1;
 }
 
 void gummei_config_init(gummei_config_t* gummei_conf) {
@@ -209,8 +215,6 @@ void sac_to_tacs_map_config_init(sac_to_tacs_map_config_t* sac_to_tacs_map) {
 void mme_config_init(mme_config_t* config) {
   memset(config, 0, sizeof(*config));
 
-  pthread_rwlock_init(&config->rw_lock, NULL);
-
   config->config_file = NULL;
   config->max_enbs = 2;
   config->max_ues = 2;
@@ -224,6 +228,9 @@ void mme_config_init(mme_config_t* config) {
   config->mme_app_zmq_auth_th = LONG_MAX;
   config->mme_app_zmq_ident_th = LONG_MAX;
   config->mme_app_zmq_smc_th = LONG_MAX;
+  config->bulk_signalling_ues_per_tick = 64;
+  config->bulk_signalling_tick_ms = 10;
+  config->bulk_signalling_max_ues_per_sec = 0;
 
   log_config_init(&config->log_config);
   eps_network_feature_config_init(&config->eps_network_feature_support);
@@ -293,9 +300,292 @@ void free_mme_config(mme_config_t* mme_config) {
   }
 }
 
+//------------------------------------------------------------------------------
+// Snapshots retired by a reload that a task may still be reading
+#define MME_CONFIG_RETIRED_MAX 4
+// Way longer than any task takes to handle a message
+#define MME_CONFIG_GRACE_PERIOD_SEC 10
+
+typedef struct mme_config_retired_s {
+  mme_config_t* config;
+  time_t retire_time;
+} mme_config_retired_t;
+
+// The mme_config global is published until the first reload
+static mme_config_t* mme_config_snapshot = &mme_config;
+// Serializes the reloads, readers never take it
+static pthread_mutex_t mme_config_reload_mutex = PTHREAD_MUTEX_INITIALIZER;
+static mme_config_retired_t mme_config_retired[MME_CONFIG_RETIRED_MAX];
+
+//------------------------------------------------------------------------------
+const mme_config_t* mme_config_get(void) {
+  return __atomic_load_n(&mme_config_snapshot, __ATOMIC_ACQUIRE);
+}
+
+static time_t mme_config_now(void) {
+  struct timespec now = {0};
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec;
+}
+
+// A snapshot owns its served TAIs and partial lists, everything else is
+// borrowed from the mme_config global
+static void mme_config_snapshot_free(mme_config_t* snapshot) {
+  if (snapshot == &mme_config) return;
+  clear_served_tai_config(&snapshot->served_tai);
+  free_partial_lists(snapshot->partial_list, snapshot->num_par_lists);
+  free_wrapper((void**)&snapshot);
+}
+
+// Frees the snapshots retired for longer than the grace period and returns a
+// free slot, NULL if every slot holds a snapshot that may still be read
+static mme_config_retired_t* mme_config_reclaim_retired(time_t now) {
+  mme_config_retired_t* free_slot = NULL;
+
+  for (int i = 0; i < MME_CONFIG_RETIRED_MAX; i++) {
+    mme_config_retired_t* retired = &mme_config_retired[i];
+    if (retired->config &&
+        (now - retired->retire_time) >= MME_CONFIG_GRACE_PERIOD_SEC) {
+      mme_config_snapshot_free(retired->config);
+      retired->config = NULL;
+    }
+    if (!retired->config && !free_slot) {
+      free_slot = retired;
+    }
+  }
+  return free_slot;
+}
+
+static bool mme_config_bstring_equal(const_bstring a, const_bstring b) {
+  if (!a || !b) return a == b;
+  return (blength(a) == blength(b)) && !memcmp(a->data, b->data, blength(a));
+}
+
+static bool mme_config_keeps(bool unchanged, const char* setting) {
+  if (!unchanged) {
+    OAILOG_ERROR(LOG_CONFIG, "Changing %s needs an MME restart\n", setting);
+  }
+  return unchanged;
+}
+
+static bool mme_config_auth_vector_cache_equal(
+    const auth_vector_cache_config_t* a, const auth_vector_cache_config_t* b) {
+  return (a->enabled == b->enabled) && (a->size == b->size) &&
+         (a->ttl_sec == b->ttl_sec) &&
+         (a->refill_watermark == b->refill_watermark);
+}
+
+static bool mme_config_gummei_equal(const gummei_config_t* a,
+                                    const gummei_config_t* b) {
+  if (a->nb != b->nb) return false;
+  for (int i = 0; i < a->nb; i++) {
+    if ((a->gummei[i].mme_code != b->gummei[i].mme_code) ||
+        (a->gummei[i].mme_gid != b->gummei[i].mme_gid) ||
+        memcmp(&a->gummei[i].plmn, &b->gummei[i].plmn, sizeof(plmn_t))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool mme_config_ip_equal(const ip_t* a, const ip_t* b) {
+  return mme_config_bstring_equal(a->if_name_s1_mme, b->if_name_s1_mme) &&
+         (a->s1_mme_v4.s_addr == b->s1_mme_v4.s_addr) &&
+         !memcmp(&a->s1_mme_v6, &b->s1_mme_v6, sizeof(a->s1_mme_v6)) &&
+         (a->s1_ipv6_enabled == b->s1_ipv6_enabled) &&
+         mme_config_bstring_equal(a->if_name_s11, b->if_name_s11) &&
+         (a->s11_mme_v4.s_addr == b->s11_mme_v4.s_addr) &&
+         !memcmp(&a->s11_mme_v6, &b->s11_mme_v6, sizeof(a->s11_mme_v6)) &&
+         (a->port_s11 == b->port_s11);
+}
+
+/*
+ * Only the served TAIs and the NAS timers are reloadable. The GUMMEIs are
+ * copied to the NAS layer at init and are part of every GUTI allocated, the
+ * rest is bound to sockets, tasks or state created at startup.
+ */
+static bool mme_config_reloadable(const mme_config_t* current,
+                                  const mme_config_t* next) {
+  bool reloadable = true;
+
+  reloadable &=
+      mme_config_keeps(mme_config_gummei_equal(&current->gummei, &next->gummei),
+                       MME_CONFIG_STRING_GUMMEI_LIST);
+  reloadable &= mme_config_keeps(mme_config_ip_equal(&current->ip, &next->ip),
+                                 MME_CONFIG_STRING_NETWORK_INTERFACES_CONFIG);
+  reloadable &= mme_config_keeps(
+      mme_config_bstring_equal(current->realm, next->realm),
+      MME_CONFIG_STRING_REALM);
+  reloadable &= mme_config_keeps(current->max_enbs == next->max_enbs,
+                                 MME_CONFIG_STRING_MAXENB);
+  reloadable &= mme_config_keeps(current->max_ues == next->max_ues,
+                                 MME_CONFIG_STRING_MAXUE);
+  reloadable &=
+      mme_config_keeps(current->relative_capacity == next->relative_capacity,
+                       MME_CONFIG_STRING_RELATIVE_CAPACITY);
+  reloadable &= mme_config_keeps(
+      (current->s1ap_config.port_number == next->s1ap_config.port_number) &&
+          (current->s1ap_config.outcome_drop_timer_sec ==
+           next->s1ap_config.outcome_drop_timer_sec) &&
+          (current->s1ap_config.decoder_threads ==
+           next->s1ap_config.decoder_threads),
+      MME_CONFIG_STRING_S1AP_CONFIG);
+  reloadable &= mme_config_keeps(
+      mme_config_bstring_equal(current->sctp_config.upstream_sctp_sock,
+                               next->sctp_config.upstream_sctp_sock) &&
+          mme_config_bstring_equal(current->sctp_config.downstream_sctp_sock,
+                                   next->sctp_config.downstream_sctp_sock),
+      MME_CONFIG_STRING_SCTP_CONFIG);
+  reloadable &= mme_config_keeps(
+      mme_config_bstring_equal(current->s6a_config.hss_host_name,
+                               next->s6a_config.hss_host_name) &&
+          mme_config_bstring_equal(current->s6a_config.hss_realm,
+                                   next->s6a_config.hss_realm),
+      MME_CONFIG_STRING_S6A_CONFIG);
+  reloadable &= mme_config_keeps(
+      mme_config_bstring_equal(current->non_eps_service_control,
+                               next->non_eps_service_control),
+      MME_CONFIG_STRING_NON_EPS_SERVICE_CONTROL);
+  reloadable &= mme_config_keeps(current->use_stateless == next->use_stateless,
+                                 MME_CONFIG_STRING_USE_STATELESS);
+  reloadable &= mme_config_keeps(
+      current->state_writer_threads == next->state_writer_threads,
+      MME_CONFIG_STRING_STATE_WRITER_THREADS);
+  reloadable &= mme_config_keeps(current->use_ha == next->use_ha,
+                                 MME_CONFIG_STRING_USE_HA);
+  reloadable &=
+      mme_config_keeps(current->enable5g_features == next->enable5g_features,
+                       MME_CONFIG_STRING_ENABLE5G_FEATURES);
+  reloadable &= mme_config_keeps(
+      mme_config_auth_vector_cache_equal(&current->nas_config.auth_vector_cache,
+                                         &next->nas_config.auth_vector_cache),
+      MME_CONFIG_STRING_NAS_ENABLE_AUTH_VECTOR_CACHE);
+
+  if (next->served_tai.nb_tai < MIN_TAI_SUPPORTED || !next->partial_list) {
+    OAILOG_ERROR(LOG_CONFIG, "Reloaded %s is empty\n",
+                 MME_CONFIG_STRING_TAI_LIST);
+    reloadable = false;
+  }
+  for (int i = 0; i < next->served_tai.nb_tai; i++) {
+    if (!TAC_IS_VALID(next->served_tai.tac[i])) {
+      OAILOG_ERROR(LOG_CONFIG, "Reloaded %s has invalid TAC " TAC_FMT "\n",
+                   MME_CONFIG_STRING_TAI_LIST, next->served_tai.tac[i]);
+      reloadable = false;
+    }
+  }
+  return reloadable;
+}
+
+static void mme_config_copy_nas_timers(nas_config_t* dst,
+                                       const nas_config_t* src) {
+  dst->t3402_min = src->t3402_min;
+  dst->t3412_min = src->t3412_min;
+  dst->t3412_msec = src->t3412_msec;
+  dst->t3422_msec = src->t3422_msec;
+  dst->t3450_msec = src->t3450_msec;
+  dst->t3460_msec = src->t3460_msec;
+  dst->t3470_msec = src->t3470_msec;
+  dst->t3485_msec = src->t3485_msec;
+  dst->t3486_msec = src->t3486_msec;
+  dst->t3489_msec = src->t3489_msec;
+  dst->t3495_msec = src->t3495_msec;
+  dst->ts6a_msec = src->ts6a_msec;
+  dst->tics_msec = src->tics_msec;
+  dst->tpaging_msec = src->tpaging_msec;
+}
+
+//------------------------------------------------------------------------------
+int mme_config_reload_string(const char* config_string) {
+  mme_config_t next = {0};
+  int rc = RETURNerror;
+
+  pthread_mutex_lock(&mme_config_reload_mutex);
+  time_t now = mme_config_now();
+  mme_config_retired_t* retired = mme_config_reclaim_retired(now);
+  if (!retired) {
+    OAILOG_ERROR(LOG_CONFIG,
+                 "Not reloading MME configuration, reloaded too often\n");
+    pthread_mutex_unlock(&mme_config_reload_mutex);
+    return RETURNerror;
+  }
+
+  mme_config_t* current = mme_config_snapshot;
+  mme_config_init(&next);
+  next.config_file = bstrcpy(mme_config.config_file);
+  // A running MME keeps the configuration in effect on any error
+  if ((mme_config_parse_string_nonfatal(config_string, &next) == 0) &&
+      mme_config_reloadable(current, &next)) {
+    mme_config_t* snapshot = calloc(1, sizeof(*snapshot));
+    *snapshot = *current;
+    snapshot->served_tai = next.served_tai;
+    memset(&next.served_tai, 0, sizeof(next.served_tai));
+    snapshot->partial_list = next.partial_list;
+    snapshot->num_par_lists = next.num_par_lists;
+    next.partial_list = NULL;
+    next.num_par_lists = 0;
+    mme_config_copy_nas_timers(&snapshot->nas_config, &next.nas_config);
+
+    __atomic_store_n(&mme_config_snapshot, snapshot, __ATOMIC_RELEASE);
+    retired->config = current;
+    retired->retire_time = now;
+    OAILOG_INFO(LOG_CONFIG,
+                "Reloaded MME configuration with %d served TAIs\n",
+                snapshot->served_tai.nb_tai);
+    rc = RETURNok;
+  } else {
+    OAILOG_ERROR(LOG_CONFIG, "Not reloading MME configuration\n");
+  }
+  free_mme_config(&next);
+  pthread_mutex_unlock(&mme_config_reload_mutex);
+  return rc;
+}
+
+static void* mme_config_reload_thread(__attribute__((unused)) void* args) {
+  FILE* fp = fopen(bdata(mme_config.config_file), "r");
+  if (fp == NULL) {
+    OAILOG_ERROR(LOG_CONFIG,
+                 "Failed to open MME configuration file at path: %s\n",
+                 bdata(mme_config.config_file));
+    return NULL;
+  }
+  bstring buff = bread((bNread)fread, fp);
+  fclose(fp);
+  if (buff == NULL) {
+    OAILOG_ERROR(LOG_CONFIG,
+                 "Failed to read MME configuration file at path: %s\n",
+                 bdata(mme_config.config_file));
+    return NULL;
+  }
+  mme_config_reload_string(bdata(buff));
+  bdestroy_wrapper(&buff);
+  return NULL;
+}
+
+//------------------------------------------------------------------------------
+void mme_config_reload(void) {
+  pthread_t thread;
+  pthread_attr_t attr;
+
+  pthread_attr_init(&attr);
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+  if (pthread_create(&thread, &attr, mme_config_reload_thread, NULL)) {
+    OAILOG_ERROR(LOG_CONFIG, "Failed to start MME configuration reload\n");
+  }
+  pthread_attr_destroy(&attr);
+}
+
 //------------------------------------------------------------------------------
 void mme_config_exit(void) {
-  pthread_rwlock_destroy(&mme_config.rw_lock);
+  pthread_mutex_lock(&mme_config_reload_mutex);
+  for (int i = 0; i < MME_CONFIG_RETIRED_MAX; i++) {
+    if (mme_config_retired[i].config) {
+      mme_config_snapshot_free(mme_config_retired[i].config);
+      mme_config_retired[i].config = NULL;
+    }
+  }
+  mme_config_snapshot_free(mme_config_snapshot);
+  mme_config_snapshot = &mme_config;
+  pthread_mutex_unlock(&mme_config_reload_mutex);
   free_mme_config(&mme_config);
 }
 
@@ -456,6 +746,39 @@ void create_partial_lists(mme_config_t* config_pP) {
   return;
 }
 
+/*
+ * An invalid setting exits the MME when the configuration is parsed at
+ * startup, it only fails the parsing of a configuration reloaded at runtime
+ */
+#define MME_CONFIG_FATAL(...)              \
+  do {                                     \
+    if (fatal) {                           \
+      Fatal(__VA_ARGS__);                  \
+    }                                      \
+    OAILOG_ERROR(LOG_CONFIG, __VA_ARGS__); \
+    goto error;                            \
+  } while (0)
+
+#define MME_CONFIG_ASSERT(cOND, ...)         \
+  do {                                       \
+    if (fatal) {                             \
+      AssertFatal(cOND, __VA_ARGS__);        \
+    } else if (!(cOND)) {                    \
+      OAILOG_ERROR(LOG_CONFIG, __VA_ARGS__); \
+      goto error;                            \
+    }                                        \
+  } while (0)
+
+#define MME_CONFIG_IPV4_ADDR(AdDr_StR, InAdDr, MeSsAgE) \
+  MME_CONFIG_ASSERT(inet_aton(AdDr_StR, &InAdDr) > 0, MeSsAgE)
+
+#define MME_CONFIG_IPV6_ADDR(AdDr_StR, InAdDr, MeSsAgE) \
+  MME_CONFIG_ASSERT(inet_pton(AF_INET6, AdDr_StR, &InAdDr) > 0, MeSsAgE)
+
+static int mme_config_parse_string_internal(const char* config_string,
+                                            mme_config_t* config_pP,
+                                            bool fatal);
+
 /****************************************************************************
  **                                                                        **
  ** Name:        mme_config_parse_string()                                 **
@@ -474,6 +797,18 @@ void create_partial_lists(mme_config_t* config_pP) {
  ***************************************************************************/
 int mme_config_parse_string(const char* config_string,
                             mme_config_t* config_pP) {
+  return mme_config_parse_string_internal(config_string, config_pP, true);
+}
+
+//------------------------------------------------------------------------------
+int mme_config_parse_string_nonfatal(const char* config_string,
+                                     mme_config_t* config_pP) {
+  return mme_config_parse_string_internal(config_string, config_pP, false);
+}
+
+static int mme_config_parse_string_internal(const char* config_string,
+                                            mme_config_t* config_pP,
+                                            bool fatal) {
   config_t cfg = {0};
   config_setting_t* setting_mme = NULL;
   config_setting_t* setting = NULL;
@@ -502,6 +837,8 @@ int mme_config_parse_string(const char* config_string,
   bstring address = NULL;
   bstring cidr = NULL;
   bstring mask = NULL;
+  struct bstrList* list = NULL;
+  const char* bad_bool = NULL;
   const char* imsi_prefix = NULL;
   const char* apn_override = NULL;
   struct in_addr in_addr_var = {0};
@@ -522,6 +859,9 @@ int mme_config_parse_string(const char* config_string,
                     bdata(config_pP->config_file), config_error_line(&cfg),
                     config_error_text(&cfg));
     config_destroy(&cfg);
+    if (!fatal) {
+      return -1;
+    }
     Fatal("Failed to parse MME configuration file: %s:%d - %s\n",
           bdata(config_pP->config_file), config_error_line(&cfg),
           config_error_text(&cfg));
@@ -549,7 +889,8 @@ int mme_config_parse_string(const char* config_string,
                                        LOG_CONFIG_STRING_OUTPUT_THREAD_SAFE,
                                        (const char**)&astring)) {
         if (astring != NULL) {
-          config_pP->log_config.is_output_thread_safe = parse_bool(astring);
+          config_pP->log_config.is_output_thread_safe =
+              parse_bool(astring, &bad_bool);
         }
       }
 
@@ -698,30 +1039,36 @@ int mme_config_parse_string(const char* config_string,
     if ((config_setting_lookup_string(setting_mme,
                                       MME_CONFIG_STRING_USE_STATELESS,
                                       (const char**)&astring))) {
-      config_pP->use_stateless = parse_bool(astring);
+      config_pP->use_stateless = parse_bool(astring, &bad_bool);
+    }
+
+    if ((config_setting_lookup_int(
+            setting_mme, MME_CONFIG_STRING_STATE_WRITER_THREADS, &aint))) {
+      config_pP->state_writer_threads = (uint32_t)aint;
     }
 
     if ((config_setting_lookup_string(setting_mme,
                                       MME_CONFIG_STRING_ENABLE5G_FEATURES,
                                       (const char**)&astring))) {
-      config_pP->enable5g_features = parse_bool(astring);
+      config_pP->enable5g_features = parse_bool(astring, &bad_bool);
     }
 
     if ((config_setting_lookup_string(setting_mme, MME_CONFIG_STRING_USE_HA,
                                       (const char**)&astring))) {
-      config_pP->use_ha = parse_bool(astring);
+      config_pP->use_ha = parse_bool(astring, &bad_bool);
     }
 
     if ((config_setting_lookup_string(
             setting_mme, MME_CONFIG_STRING_ENABLE_GTPU_PRIVATE_IP_CORRECTION,
             (const char**)&astring))) {
-      config_pP->enable_gtpu_private_ip_correction = parse_bool(astring);
+      config_pP->enable_gtpu_private_ip_correction =
+          parse_bool(astring, &bad_bool);
     }
 
     if ((config_setting_lookup_string(
             setting_mme, MME_CONFIG_STRING_CONGESTION_CONTROL_ENABLED,
             (const char**)&astring))) {
-      config_pP->enable_congestion_control = parse_bool(astring);
+      config_pP->enable_congestion_control = parse_bool(astring, &bad_bool);
     }
 
     if ((config_setting_lookup_int(setting_mme, MME_CONFIG_STRING_S1AP_ZMQ_TH,
@@ -749,37 +1096,56 @@ int mme_config_parse_string(const char* config_string,
       config_pP->mme_app_zmq_smc_th = (long)aint;
     }
 
+    if ((config_setting_lookup_int(
+            setting_mme, MME_CONFIG_STRING_BULK_SIGNALLING_UES_PER_TICK,
+            &aint))) {
+      config_pP->bulk_signalling_ues_per_tick = (uint32_t)aint;
+    }
+
+    if ((config_setting_lookup_int(
+            setting_mme, MME_CONFIG_STRING_BULK_SIGNALLING_TICK_MS, &aint))) {
+      config_pP->bulk_signalling_tick_ms = (uint32_t)aint;
+    }
+
+    if ((config_setting_lookup_int(
+            setting_mme, MME_CONFIG_STRING_BULK_SIGNALLING_MAX_UES_PER_SEC,
+            &aint))) {
+      config_pP->bulk_signalling_max_ues_per_sec = (uint32_t)aint;
+    }
+
     if ((config_setting_lookup_string(
             setting_mme,
             EPS_NETWORK_FEATURE_SUPPORT_EMERGENCY_BEARER_SERVICES_IN_S1_MODE,
             (const char**)&astring))) {
       config_pP->eps_network_feature_support
-          .emergency_bearer_services_in_s1_mode = parse_bool(astring);
+          .emergency_bearer_services_in_s1_mode =
+          parse_bool(astring, &bad_bool);
     }
     if ((config_setting_lookup_string(
             setting_mme, EPS_NETWORK_FEATURE_SUPPORT_EXTENDED_SERVICE_REQUEST,
             (const char**)&astring))) {
       config_pP->eps_network_feature_support.extended_service_request =
-          parse_bool(astring);
+          parse_bool(astring, &bad_bool);
     }
     if ((config_setting_lookup_string(
             setting_mme,
             EPS_NETWORK_FEATURE_SUPPORT_IMS_VOICE_OVER_PS_SESSION_IN_S1,
             (const char**)&astring))) {
       config_pP->eps_network_feature_support.ims_voice_over_ps_session_in_s1 =
-          parse_bool(astring);
+          parse_bool(astring, &bad_bool);
     }
     if ((config_setting_lookup_string(
             setting_mme, EPS_NETWORK_FEATURE_SUPPORT_LOCATION_SERVICES_VIA_EPC,
             (const char**)&astring))) {
       config_pP->eps_network_feature_support.location_services_via_epc =
-          parse_bool(astring);
+          parse_bool(astring, &bad_bool);
     }
 
     if ((config_setting_lookup_string(
             setting_mme, MME_CONFIG_STRING_UNAUTHENTICATED_IMSI_SUPPORTED,
             (const char**)&astring))) {
-      config_pP->unauthenticated_imsi_supported = parse_bool(astring);
+      config_pP->unauthenticated_imsi_supported =
+          parse_bool(astring, &bad_bool);
     }
 
     // ITTI SETTING
@@ -821,8 +1187,8 @@ int mme_config_parse_string(const char* config_string,
             config_pP->s6a_config.hss_host_name = bfromcstr(astring);
           }
         } else
-          Fatal("You have to provide a valid HSS hostname %s=...\n",
-                MME_CONFIG_STRING_S6A_HSS_HOSTNAME);
+          MME_CONFIG_FATAL("You have to provide a valid HSS hostname %s=...\n",
+                           MME_CONFIG_STRING_S6A_HSS_HOSTNAME);
       }
       if ((config_setting_lookup_string(setting,
                                         MME_CONFIG_STRING_S6A_HSS_REALM,
@@ -834,8 +1200,8 @@ int mme_config_parse_string(const char* config_string,
             config_pP->s6a_config.hss_realm = bfromcstr(astring);
           }
         } else
-          Fatal("You have to provide a valid HSS realm %s=...\n",
-                MME_CONFIG_STRING_S6A_HSS_REALM);
+          MME_CONFIG_FATAL("You have to provide a valid HSS realm %s=...\n",
+                           MME_CONFIG_STRING_S6A_HSS_REALM);
       }
     }
 #endif /* !S6A_OVER_GRPC */
@@ -856,6 +1222,11 @@ int mme_config_parse_string(const char* config_string,
                                      &aint))) {
         config_pP->s1ap_config.port_number = (uint16_t)aint;
       }
+
+      if ((config_setting_lookup_int(
+              setting, MME_CONFIG_STRING_S1AP_DECODER_THREADS, &aint))) {
+        config_pP->s1ap_config.decoder_threads = (uint32_t)aint;
+      }
     }
     // TAI list setting
     setting =
@@ -907,7 +1278,7 @@ int mme_config_parse_string(const char* config_string,
             config_pP->served_tai.plmn_mnc[i] = (uint16_t)atoi(mnc);
             config_pP->served_tai.plmn_mnc_len[i] = strlen(mnc);
 
-            AssertFatal(
+            MME_CONFIG_ASSERT(
                 (config_pP->served_tai.plmn_mnc_len[i] == MIN_MNC_LENGTH) ||
                     (config_pP->served_tai.plmn_mnc_len[i] == MAX_MNC_LENGTH),
                 "Bad MNC length %u, must be %d or %d",
@@ -987,15 +1358,16 @@ int mme_config_parse_string(const char* config_string,
     if (setting != NULL) {
       num = config_setting_length(setting);
       OAILOG_INFO(LOG_MME_APP, "Number of GUMMEIs configured =%d\n", num);
-      AssertFatal(
+      MME_CONFIG_ASSERT(
           num >= MIN_GUMMEI,
           "Not even one GUMMEI is configured, configure minimum one GUMMEI "
           "\n");
-      AssertFatal(num <= MAX_GUMMEI,
-                  "Number of GUMMEIs configured:%d exceeds number of GUMMEIs "
-                  "supported "
-                  ":%d \n",
-                  num, MAX_GUMMEI);
+      MME_CONFIG_ASSERT(
+          num <= MAX_GUMMEI,
+          "Number of GUMMEIs configured:%d exceeds number of GUMMEIs "
+          "supported "
+          ":%d \n",
+          num, MAX_GUMMEI);
 
       for (i = 0; i < num; i++) {
         sub2setting = config_setting_get_elem(setting, i);
@@ -1003,9 +1375,10 @@ int mme_config_parse_string(const char* config_string,
         if (sub2setting != NULL) {
           if ((config_setting_lookup_string(sub2setting, MME_CONFIG_STRING_MCC,
                                             &mcc))) {
-            AssertFatal(strlen(mcc) == MAX_MCC_LENGTH,
-                        "Bad MCC length (%ld), it must be %u digit ex: 001",
-                        strlen(mcc), MAX_MCC_LENGTH);
+            MME_CONFIG_ASSERT(
+                strlen(mcc) == MAX_MCC_LENGTH,
+                "Bad MCC length (%ld), it must be %u digit ex: 001",
+                strlen(mcc), MAX_MCC_LENGTH);
             char c[2] = {mcc[0], 0};
             config_pP->gummei.gummei[i].plmn.mcc_digit1 = (uint8_t)atoi(c);
             c[0] = mcc[1];
@@ -1016,7 +1389,7 @@ int mme_config_parse_string(const char* config_string,
 
           if ((config_setting_lookup_string(sub2setting, MME_CONFIG_STRING_MNC,
                                             &mnc))) {
-            AssertFatal(
+            MME_CONFIG_ASSERT(
                 (strlen(mnc) == MIN_MNC_LENGTH) ||
                     (strlen(mnc) == MAX_MNC_LENGTH),
                 "Bad MNC length (%ld), it must be %u or %u digit ex: 12 or "
@@ -1056,10 +1429,11 @@ int mme_config_parse_string(const char* config_string,
       num = config_setting_length(setting);
       OAILOG_INFO(LOG_MME_APP, "Number of restricted PLMNs configured =%d\n",
                   num);
-      AssertFatal(num <= MAX_RESTRICTED_PLMN,
-                  "Number of restricted PLMNs configured:%d exceeds number of "
-                  "restricted PLMNs supported :%d \n",
-                  num, MAX_RESTRICTED_PLMN);
+      MME_CONFIG_ASSERT(
+          num <= MAX_RESTRICTED_PLMN,
+          "Number of restricted PLMNs configured:%d exceeds number of "
+          "restricted PLMNs supported :%d \n",
+          num, MAX_RESTRICTED_PLMN);
 
       for (i = 0; i < num; i++) {
         sub2setting = config_setting_get_elem(setting, i);
@@ -1067,39 +1441,40 @@ int mme_config_parse_string(const char* config_string,
         if (sub2setting != NULL) {
           if ((config_setting_lookup_string(sub2setting, MME_CONFIG_STRING_MCC,
                                             &mcc))) {
-            AssertFatal(strlen(mcc) == MAX_MCC_LENGTH,
-                        "Bad MCC length (%ld), it must be %u digit ex: 001\n",
-                        strlen(mcc), MAX_MCC_LENGTH);
+            MME_CONFIG_ASSERT(
+                strlen(mcc) == MAX_MCC_LENGTH,
+                "Bad MCC length (%ld), it must be %u digit ex: 001\n",
+                strlen(mcc), MAX_MCC_LENGTH);
             // NULL terminated string
-            AssertFatal(mcc[0] >= '0' && mcc[0] <= '9',
-                        "MCC[0] is not a decimal digit\n");
+            MME_CONFIG_ASSERT(mcc[0] >= '0' && mcc[0] <= '9',
+                              "MCC[0] is not a decimal digit\n");
             config_pP->restricted_plmn.plmn[i].mcc_digit1 = mcc[0] - '0';
-            AssertFatal(mcc[1] >= '0' && mcc[1] <= '9',
-                        "MCC[1] is not a decimal digit\n");
+            MME_CONFIG_ASSERT(mcc[1] >= '0' && mcc[1] <= '9',
+                              "MCC[1] is not a decimal digit\n");
             config_pP->restricted_plmn.plmn[i].mcc_digit2 = mcc[1] - '0';
-            AssertFatal(mcc[2] >= '0' && mcc[2] <= '9',
-                        "MCC[2] is not a decimal digit\n");
+            MME_CONFIG_ASSERT(mcc[2] >= '0' && mcc[2] <= '9',
+                              "MCC[2] is not a decimal digit\n");
             config_pP->restricted_plmn.plmn[i].mcc_digit3 = mcc[2] - '0';
           }
 
           if ((config_setting_lookup_string(sub2setting, MME_CONFIG_STRING_MNC,
                                             &mnc))) {
-            AssertFatal(
+            MME_CONFIG_ASSERT(
                 (strlen(mnc) == MIN_MNC_LENGTH) ||
                     (strlen(mnc) == MAX_MNC_LENGTH),
                 "Bad MNC length (%ld), it must be %u or %u digit ex: 12 or "
                 "123\n",
                 strlen(mnc), MIN_MNC_LENGTH, MAX_MNC_LENGTH);
             // NULL terminated string
-            AssertFatal(mnc[0] >= '0' && mnc[0] <= '9',
-                        "MNC[0] is not a decimal digit\n");
+            MME_CONFIG_ASSERT(mnc[0] >= '0' && mnc[0] <= '9',
+                              "MNC[0] is not a decimal digit\n");
             config_pP->restricted_plmn.plmn[i].mnc_digit1 = mnc[0] - '0';
-            AssertFatal(mnc[1] >= '0' && mnc[1] <= '9',
-                        "MNC[1] is not a decimal digit\n");
+            MME_CONFIG_ASSERT(mnc[1] >= '0' && mnc[1] <= '9',
+                              "MNC[1] is not a decimal digit\n");
             config_pP->restricted_plmn.plmn[i].mnc_digit2 = mnc[1] - '0';
             if (3 == strlen(mnc)) {
-              AssertFatal(mnc[2] >= '0' && mnc[2] <= '9',
-                          "MNC[2] is not a decimal digit\n");
+              MME_CONFIG_ASSERT(mnc[2] >= '0' && mnc[2] <= '9',
+                                "MNC[2] is not a decimal digit\n");
               config_pP->restricted_plmn.plmn[i].mnc_digit3 = mnc[2] - '0';
             } else {
               config_pP->restricted_plmn.plmn[i].mnc_digit3 = 0x0F;
@@ -1118,10 +1493,10 @@ int mme_config_parse_string(const char* config_string,
     if (setting != NULL) {
       num = config_setting_length(setting);
       OAILOG_INFO(LOG_MME_APP, "Number of mode maps configured =%d\n", num);
-      AssertFatal(num <= MAX_FED_MODE_MAP_CONFIG,
-                  "Number of mode maps configured:%d exceeds number of "
-                  "mode maps supported :%d \n",
-                  num, MAX_FED_MODE_MAP_CONFIG);
+      MME_CONFIG_ASSERT(num <= MAX_FED_MODE_MAP_CONFIG,
+                        "Number of mode maps configured:%d exceeds number of "
+                        "mode maps supported :%d \n",
+                        num, MAX_FED_MODE_MAP_CONFIG);
 
       for (i = 0; i < num; i++) {
         sub2setting = config_setting_get_elem(setting, i);
@@ -1146,24 +1521,25 @@ int mme_config_parse_string(const char* config_string,
             n = strlen(astring) - MAX_MCC_LENGTH;
             memcpy(fed_mode_mnc, astring + MAX_MCC_LENGTH, n);
             fed_mode_mnc[n] = '\0';  // null terminated string
-            AssertFatal(strlen(fed_mode_mcc) == MAX_MCC_LENGTH,
-                        "Bad MCC length (%ld), it must be %u digit ex: 001\n",
-                        strlen(fed_mode_mcc), MAX_MCC_LENGTH);
-            AssertFatal(fed_mode_mcc[0] >= '0' && fed_mode_mcc[0] <= '9',
-                        "MCC[0] is not a decimal digit\n");
+            MME_CONFIG_ASSERT(
+                strlen(fed_mode_mcc) == MAX_MCC_LENGTH,
+                "Bad MCC length (%ld), it must be %u digit ex: 001\n",
+                strlen(fed_mode_mcc), MAX_MCC_LENGTH);
+            MME_CONFIG_ASSERT(fed_mode_mcc[0] >= '0' && fed_mode_mcc[0] <= '9',
+                              "MCC[0] is not a decimal digit\n");
             config_pP->mode_map_config.mode_map[i].plmn.mcc_digit1 =
                 fed_mode_mcc[0] - '0';
-            AssertFatal(fed_mode_mcc[1] >= '0' && fed_mode_mcc[1] <= '9',
-                        "MCC[1] is not a decimal digit\n");
+            MME_CONFIG_ASSERT(fed_mode_mcc[1] >= '0' && fed_mode_mcc[1] <= '9',
+                              "MCC[1] is not a decimal digit\n");
             config_pP->mode_map_config.mode_map[i].plmn.mcc_digit2 =
                 fed_mode_mcc[1] - '0';
-            AssertFatal(fed_mode_mcc[2] >= '0' && fed_mode_mcc[2] <= '9',
-                        "MCC[2] is not a decimal digit\n");
+            MME_CONFIG_ASSERT(fed_mode_mcc[2] >= '0' && fed_mode_mcc[2] <= '9',
+                              "MCC[2] is not a decimal digit\n");
             config_pP->mode_map_config.mode_map[i].plmn.mcc_digit3 =
                 fed_mode_mcc[2] - '0';
 
             // MNC
-            AssertFatal(
+            MME_CONFIG_ASSERT(
                 (strlen(fed_mode_mnc) == MIN_MNC_LENGTH) ||
                     (strlen(fed_mode_mnc) == MAX_MNC_LENGTH),
                 "Bad MNC length (%ld), it must be %u or %u digit ex: 12 or "
@@ -1171,17 +1547,18 @@ int mme_config_parse_string(const char* config_string,
                 strlen(fed_mode_mnc), MIN_MNC_LENGTH, MAX_MNC_LENGTH);
 
             // NULL terminated string
-            AssertFatal(fed_mode_mnc[0] >= '0' && fed_mode_mnc[0] <= '9',
-                        "MNC[0] is not a decimal digit\n");
+            MME_CONFIG_ASSERT(fed_mode_mnc[0] >= '0' && fed_mode_mnc[0] <= '9',
+                              "MNC[0] is not a decimal digit\n");
             config_pP->mode_map_config.mode_map[i].plmn.mnc_digit1 =
                 fed_mode_mnc[0] - '0';
-            AssertFatal(fed_mode_mnc[1] >= '0' && fed_mode_mnc[1] <= '9',
-                        "MNC[1] is not a decimal digit\n");
+            MME_CONFIG_ASSERT(fed_mode_mnc[1] >= '0' && fed_mode_mnc[1] <= '9',
+                              "MNC[1] is not a decimal digit\n");
             config_pP->mode_map_config.mode_map[i].plmn.mnc_digit2 =
                 fed_mode_mnc[1] - '0';
             if (3 == strlen(fed_mode_mnc)) {
-              AssertFatal(fed_mode_mnc[2] >= '0' && fed_mode_mnc[2] <= '9',
-                          "MNC[2] is not a decimal digit\n");
+              MME_CONFIG_ASSERT(
+                  fed_mode_mnc[2] >= '0' && fed_mode_mnc[2] <= '9',
+                  "MNC[2] is not a decimal digit\n");
               config_pP->mode_map_config.mode_map[i].plmn.mnc_digit3 =
                   fed_mode_mnc[2] - '0';
             } else {
@@ -1196,16 +1573,17 @@ int mme_config_parse_string(const char* config_string,
               imsi_low_tmp = strsep(&imsi_high_tmp, ":");
               memcpy((char*)config_pP->mode_map_config.mode_map[i].imsi_low,
                      imsi_low_tmp, strlen(imsi_low_tmp));
-              AssertFatal(
+              MME_CONFIG_ASSERT(
                   strlen(
                       (char*)config_pP->mode_map_config.mode_map[i].imsi_low) <=
                       MAX_IMSI_LENGTH,
                   "Invalid imsi_low length\n");
               memcpy((char*)config_pP->mode_map_config.mode_map[i].imsi_high,
                      imsi_high_tmp, strlen(imsi_high_tmp));
-              AssertFatal(strlen((char*)config_pP->mode_map_config.mode_map[i]
-                                     .imsi_high) <= MAX_IMSI_LENGTH,
-                          "Invalid imsi_high length\n");
+              MME_CONFIG_ASSERT(
+                  strlen((char*)config_pP->mode_map_config.mode_map[i]
+                             .imsi_high) <= MAX_IMSI_LENGTH,
+                  "Invalid imsi_high length\n");
             }
           }
           // APN
@@ -1235,8 +1613,8 @@ int mme_config_parse_string(const char* config_string,
         config_pP->blocked_imei.imei_htbl =
             hashtable_uint64_ts_create(MAX_IMEI_HTBL_SZ, NULL, b);
         bdestroy_wrapper(&b);
-        AssertFatal(config_pP->blocked_imei.imei_htbl != NULL,
-                    "Error creating IMEI hashtable\n");
+        MME_CONFIG_ASSERT(config_pP->blocked_imei.imei_htbl != NULL,
+                          "Error creating IMEI hashtable\n");
 
         for (i = 0; i < num; i++) {
           memset(imei_str, 0, (MAX_LEN_IMEI + 1));
@@ -1244,17 +1622,18 @@ int mme_config_parse_string(const char* config_string,
           if (sub2setting != NULL) {
             if ((config_setting_lookup_string(
                     sub2setting, MME_CONFIG_STRING_IMEI_TAC, &tac_str))) {
-              AssertFatal(strlen(tac_str) == MAX_LEN_TAC,
-                          "Bad TAC length (%ld), it must be %u digits\n",
-                          strlen(tac_str), MAX_LEN_TAC);
+              MME_CONFIG_ASSERT(strlen(tac_str) == MAX_LEN_TAC,
+                                "Bad TAC length (%ld), it must be %u digits\n",
+                                strlen(tac_str), MAX_LEN_TAC);
               memcpy(imei_str, tac_str, strlen(tac_str));
             }
             if ((config_setting_lookup_string(
                     sub2setting, MME_CONFIG_STRING_SNR, &snr_str))) {
               if (strlen(snr_str)) {
-                AssertFatal(strlen(snr_str) == MAX_LEN_SNR,
-                            "Bad SNR length (%ld), it must be %u digits\n",
-                            strlen(snr_str), MAX_LEN_SNR);
+                MME_CONFIG_ASSERT(
+                    strlen(snr_str) == MAX_LEN_SNR,
+                    "Bad SNR length (%ld), it must be %u digits\n",
+                    strlen(snr_str), MAX_LEN_SNR);
                 memcpy(&imei_str[strlen(tac_str)], snr_str, strlen(snr_str));
               }
             }
@@ -1263,7 +1642,8 @@ int mme_config_parse_string(const char* config_string,
             IMEI_STRING_TO_IMEI64(imei_str, &imei64);
             h_rc = hashtable_uint64_ts_insert(config_pP->blocked_imei.imei_htbl,
                                               (const hash_key_t)imei64, 0);
-            AssertFatal(h_rc == HASH_TABLE_OK, "Hashtable insertion failed\n");
+            MME_CONFIG_ASSERT(h_rc == HASH_TABLE_OK,
+                              "Hashtable insertion failed\n");
 
             config_pP->blocked_imei.num += 1;
           }
@@ -1289,7 +1669,7 @@ int mme_config_parse_string(const char* config_string,
         if (config_pP->sac_to_tacs_map.sac_to_tacs_map_htbl == NULL) {
           OAILOG_ERROR(LOG_MME_APP,
                        "Error creating SAC_2_TACS_HTBL hashtable \n");
-          return -1;
+          goto error;
         }
         for (i = 0; i < num; i++) {
           sub2setting = config_setting_get_elem(setting, i);
@@ -1307,8 +1687,8 @@ int mme_config_parse_string(const char* config_string,
                 if (num_tacs > 0) {
                   config_pP->sac_to_tacs_map.tac_list =
                       calloc(1, sizeof(tac_list_per_sac_t));
-                  AssertFatal(config_pP->sac_to_tacs_map.tac_list != NULL,
-                              "Memory allocation failed for tac_list\n");
+                  MME_CONFIG_ASSERT(config_pP->sac_to_tacs_map.tac_list != NULL,
+                                    "Memory allocation failed for tac_list\n");
                   config_pP->sac_to_tacs_map.tac_list->num_tac_entries =
                       num_tacs;
                   for (uint8_t itr = 0; itr < num_tacs; itr++) {
@@ -1319,8 +1699,9 @@ int mme_config_parse_string(const char* config_string,
                       config_pP->sac_to_tacs_map.sac_to_tacs_map_htbl,
                       (const void*)&sac_int, sizeof(uint16_t),
                       (void*)config_pP->sac_to_tacs_map.tac_list);
-                  AssertFatal(h_rc == HASH_TABLE_OK,
-                              "SAC_2_TACS_HTBL hashtable insertion failed\n");
+                  MME_CONFIG_ASSERT(
+                      h_rc == HASH_TABLE_OK,
+                      "SAC_2_TACS_HTBL hashtable insertion failed\n");
                 }
               }
             }
@@ -1353,15 +1734,16 @@ int mme_config_parse_string(const char* config_string,
 
         config_pP->ip.if_name_s1_mme = bfromcstr(if_name_s1_mme);
         cidr = bfromcstr(s1_mme);
-        struct bstrList* list = bsplit(cidr, '/');
-        AssertFatal(list->qty == CIDR_SPLIT_LIST_COUNT,
-                    "Bad S1-MME CIDR address: %s", bdata(cidr));
+        list = bsplit(cidr, '/');
+        MME_CONFIG_ASSERT(list->qty == CIDR_SPLIT_LIST_COUNT,
+                          "Bad S1-MME CIDR address: %s", bdata(cidr));
         address = list->entry[0];
         mask = list->entry[1];
-        IPV4_STR_ADDR_TO_INADDR(bdata(address), config_pP->ip.s1_mme_v4,
-                                "BAD IP ADDRESS FORMAT FOR S1-MME !\n");
+        MME_CONFIG_IPV4_ADDR(bdata(address), config_pP->ip.s1_mme_v4,
+                             "BAD IP ADDRESS FORMAT FOR S1-MME !\n");
         config_pP->ip.netmask_s1_mme = atoi((const char*)mask->data);
         bstrListDestroy(list);
+        list = NULL;
         in_addr_var.s_addr = config_pP->ip.s1_mme_v4.s_addr;
         OAILOG_INFO(LOG_MME_APP,
                     "Parsing configuration file found S1-MME: %s/%d on %s\n",
@@ -1374,14 +1756,15 @@ int mme_config_parse_string(const char* config_string,
         config_pP->ip.if_name_s11 = bfromcstr(if_name_s11);
         cidr = bfromcstr(s11);
         list = bsplit(cidr, '/');
-        AssertFatal(list->qty == CIDR_SPLIT_LIST_COUNT,
-                    "Bad MME S11 CIDR address: %s", bdata(cidr));
+        MME_CONFIG_ASSERT(list->qty == CIDR_SPLIT_LIST_COUNT,
+                          "Bad MME S11 CIDR address: %s", bdata(cidr));
         address = list->entry[0];
         mask = list->entry[1];
-        IPV4_STR_ADDR_TO_INADDR(bdata(address), config_pP->ip.s11_mme_v4,
-                                "BAD IP ADDRESS FORMAT FOR S11 !\n");
+        MME_CONFIG_IPV4_ADDR(bdata(address), config_pP->ip.s11_mme_v4,
+                             "BAD IP ADDRESS FORMAT FOR S11 !\n");
         config_pP->ip.netmask_s11 = atoi((const char*)mask->data);
         bstrListDestroy(list);
+        list = NULL;
         bdestroy_wrapper(&cidr);
         in_addr_var.s_addr = config_pP->ip.s11_mme_v4.s_addr;
         OAILOG_INFO(LOG_MME_APP,
@@ -1397,11 +1780,11 @@ int mme_config_parse_string(const char* config_string,
                                        MME_CONFIG_STRING_S1_IPV6_ENABLED,
                                        (const char**)&s1_ipv6_enabled)) {
         // S1AP IPv6 address
-        config_pP->ip.s1_ipv6_enabled = parse_bool(s1_ipv6_enabled);
+        config_pP->ip.s1_ipv6_enabled = parse_bool(s1_ipv6_enabled, &bad_bool);
         if (config_pP->ip.s1_ipv6_enabled) {
           char parsed_ipv6[INET6_ADDRSTRLEN];
 
-          IPV6_STR_ADDR_TO_INADDR(
+          MME_CONFIG_IPV6_ADDR(
               s1_mme_ipv6_addr, config_pP->ip.s1_mme_v6,
               "BAD IPv6 ADDRESS FORMAT FOR S1AP IPv6 address !\n");
           inet_ntop(AF_INET6, (const void*)&config_pP->ip.s1_mme_v6,
@@ -1429,9 +1812,9 @@ int mme_config_parse_string(const char* config_string,
         // Check CSFB MCC. MNC and LAC only if NON-EPS feature is enabled.
         if ((config_setting_lookup_string(setting, MME_CONFIG_STRING_CSFB_MCC,
                                           &csfb_mcc))) {
-          AssertFatal(strlen(csfb_mcc) == MAX_MCC_LENGTH,
-                      "Bad MCC length(%ld), it must be %u digit ex: 001",
-                      strlen(csfb_mcc), MAX_MCC_LENGTH);
+          MME_CONFIG_ASSERT(strlen(csfb_mcc) == MAX_MCC_LENGTH,
+                            "Bad MCC length(%ld), it must be %u digit ex: 001",
+                            strlen(csfb_mcc), MAX_MCC_LENGTH);
           char c[2] = {csfb_mcc[0], 0};
           config_pP->lai.mccdigit1 = (uint8_t)atoi(c);
           c[0] = csfb_mcc[1];
@@ -1441,7 +1824,7 @@ int mme_config_parse_string(const char* config_string,
         }
         if ((config_setting_lookup_string(setting, MME_CONFIG_STRING_CSFB_MNC,
                                           &csfb_mnc))) {
-          AssertFatal(
+          MME_CONFIG_ASSERT(
               (strlen(csfb_mnc) == MIN_MNC_LENGTH) ||
                   (strlen(csfb_mnc) == MAX_MNC_LENGTH),
               "Bad MNC length (%ld), it must be %u or %u digit ex: 12 or 123",
@@ -1468,7 +1851,8 @@ int mme_config_parse_string(const char* config_string,
     if ((config_setting_lookup_string(
             setting_mme, MME_CONFIG_STRING_ACCEPT_COMBINED_ATTACH_TAU_WO_CSFB,
             (const char**)&astring))) {
-      config_pP->accept_combined_attach_tau_wo_csfb = parse_bool(astring);
+      config_pP->accept_combined_attach_tau_wo_csfb =
+          parse_bool(astring, &bad_bool);
     }
 
     // NAS SETTING
@@ -1580,22 +1964,24 @@ int mme_config_parse_string(const char* config_string,
       if ((config_setting_lookup_string(setting,
                                         MME_CONFIG_STRING_NAS_FORCE_REJECT_TAU,
                                         (const char**)&astring))) {
-        config_pP->nas_config.force_reject_tau = parse_bool(astring);
+        config_pP->nas_config.force_reject_tau = parse_bool(astring, &bad_bool);
       }
       if ((config_setting_lookup_string(setting,
                                         MME_CONFIG_STRING_NAS_FORCE_REJECT_SR,
                                         (const char**)&astring))) {
-        config_pP->nas_config.force_reject_sr = parse_bool(astring);
+        config_pP->nas_config.force_reject_sr = parse_bool(astring, &bad_bool);
       }
       if ((config_setting_lookup_string(
               setting, MME_CONFIG_STRING_NAS_DISABLE_ESM_INFORMATION_PROCEDURE,
               (const char**)&astring))) {
-        config_pP->nas_config.disable_esm_information = parse_bool(astring);
+        config_pP->nas_config.disable_esm_information =
+            parse_bool(astring, &bad_bool);
       }
       if ((config_setting_lookup_string(
               setting, MME_CONFIG_STRING_NAS_ENABLE_APN_CORRECTION,
               (const char**)&astring))) {
-        config_pP->nas_config.enable_apn_correction = parse_bool(astring);
+        config_pP->nas_config.enable_apn_correction =
+            parse_bool(astring, &bad_bool);
       }
 
       // Parsing APN CORRECTION MAP
@@ -1607,12 +1993,13 @@ int mme_config_parse_string(const char* config_string,
           num = config_setting_length(subsetting);
           OAILOG_INFO(LOG_MME_APP,
                       "Number of apn correction map configured =%d\n", num);
-          AssertFatal(num <= MAX_APN_CORRECTION_MAP_LIST,
-                      "Number of apn correction map configured:%d exceeds the "
-                      "maximum "
-                      "number supported"
-                      ":%d \n",
-                      num, MAX_APN_CORRECTION_MAP_LIST);
+          MME_CONFIG_ASSERT(
+              num <= MAX_APN_CORRECTION_MAP_LIST,
+              "Number of apn correction map configured:%d exceeds the "
+              "maximum "
+              "number supported"
+              ":%d \n",
+              num, MAX_APN_CORRECTION_MAP_LIST);
 
           for (i = 0; i < num; i++) {
             sub2setting = config_setting_get_elem(subsetting, i);
@@ -1650,6 +2037,27 @@ int mme_config_parse_string(const char* config_string,
           }
         }
       }
+
+      if ((config_setting_lookup_string(
+              setting, MME_CONFIG_STRING_NAS_ENABLE_AUTH_VECTOR_CACHE,
+              (const char**)&astring))) {
+        config_pP->nas_config.auth_vector_cache.enabled =
+            parse_bool(astring, &bad_bool);
+      }
+      if ((config_setting_lookup_int(
+              setting, MME_CONFIG_STRING_NAS_AUTH_VECTOR_CACHE_SIZE, &aint))) {
+        config_pP->nas_config.auth_vector_cache.size = (uint32_t)aint;
+      }
+      if ((config_setting_lookup_int(
+              setting, MME_CONFIG_STRING_NAS_AUTH_VECTOR_CACHE_TTL, &aint))) {
+        config_pP->nas_config.auth_vector_cache.ttl_sec = (uint32_t)aint;
+      }
+      if ((config_setting_lookup_int(
+              setting, MME_CONFIG_STRING_NAS_AUTH_VECTOR_CACHE_REFILL_WATERMARK,
+              &aint))) {
+        config_pP->nas_config.auth_vector_cache.refill_watermark =
+            (uint32_t)aint;
+      }
     }
 
     // Parsing Sentry Config
@@ -1665,7 +2073,8 @@ int mme_config_parse_string(const char* config_string,
       if ((config_setting_lookup_string(setting,
                                         MME_CONFIG_STRING_UPLOAD_MME_LOG,
                                         (const char**)&astring))) {
-        config_pP->sentry_config.upload_mme_log = parse_bool(astring);
+        config_pP->sentry_config.upload_mme_log =
+            parse_bool(astring, &bad_bool);
       }
       if ((config_setting_lookup_string(setting, MME_CONFIG_STRING_URL_NATIVE,
                                         (const char**)&astring))) {
@@ -1711,9 +2120,9 @@ int mme_config_parse_string(const char* config_string,
         OAILOG_DEBUG(LOG_MME_APP, "sgw interface IP information %s\n",
                      sgw_ip_address_for_s11);
 
-        IPV4_STR_ADDR_TO_INADDR(sgw_ip_address_for_s11,
-                                config_pP->e_dns_emulation.sgw_ip_addr[0],
-                                "BAD IP ADDRESS FORMAT FOR SGW S11 !\n");
+        MME_CONFIG_IPV4_ADDR(sgw_ip_address_for_s11,
+                             config_pP->e_dns_emulation.sgw_ip_addr[0],
+                             "BAD IP ADDRESS FORMAT FOR SGW S11 !\n");
 
         OAILOG_INFO(LOG_SPGW_APP,
                     "Parsing configuration file found S-GW S11: %s\n",
@@ -1723,10 +2132,26 @@ int mme_config_parse_string(const char* config_string,
 #endif
   }
 
+  MME_CONFIG_ASSERT(!bad_bool,
+                    "Error in config file: got \"%s\" but expected bool\n",
+                    bad_bool);
   config_destroy(&cfg);
   return 0;
+
+error:
+  if (list) {
+    bstrListDestroy(list);
+  }
+  bdestroy_wrapper(&cidr);
+  config_destroy(&cfg);
+  return -1;
 }
 
+#undef MME_CONFIG_FATAL
+#undef MME_CONFIG_ASSERT
+#undef MME_CONFIG_IPV4_ADDR
+#undef MME_CONFIG_IPV6_ADDR
+
 /****************************************************************************
  **                                                                        **
  ** Name:        mme_config_parse_file()                                   **
@@ -1859,8 +2284,18 @@ void mme_config_display(mme_config_t* config_pP) {
               "- MME APP ZMQ SMC Complete Threshold ...........: %10ld "
               "(microseconds)\n\n",
               config_pP->mme_app_zmq_smc_th);
+  OAILOG_INFO(LOG_CONFIG,
+              "- Bulk signalling pacing .......................: %u UEs "
+              "every %u ms, at most %u UEs/s (0: no limit)\n\n",
+              config_pP->bulk_signalling_ues_per_tick,
+              config_pP->bulk_signalling_tick_ms,
+              config_pP->bulk_signalling_max_ues_per_sec);
   OAILOG_INFO(LOG_CONFIG, "- Use Stateless ........................: %s\n\n",
               config_pP->use_stateless ? "true" : "false");
+  OAILOG_INFO(LOG_CONFIG,
+              "- State writer threads .................: %u (0: MME_APP "
+              "task)\n\n",
+              config_pP->state_writer_threads);
   OAILOG_INFO(LOG_CONFIG, "- enable5g_features .......: %s\n\n",
               config_pP->enable5g_features ? "true" : "false");
   OAILOG_INFO(LOG_CONFIG, "- CSFB:\n");
@@ -1870,6 +2305,8 @@ void mme_config_display(mme_config_t* config_pP) {
   OAILOG_INFO(LOG_CONFIG, "- S1-MME:\n");
   OAILOG_INFO(LOG_CONFIG, "    port number ......: %d\n",
               config_pP->s1ap_config.port_number);
+  OAILOG_INFO(LOG_CONFIG, "    decoder threads ..: %u\n",
+              config_pP->s1ap_config.decoder_threads);
   OAILOG_INFO(LOG_CONFIG, "- IP:\n");
   OAILOG_INFO(LOG_CONFIG, "    s1-MME iface .....: %s\n",
               bdata(config_pP->ip.if_name_s1_mme));
@@ -2058,6 +2495,16 @@ void mme_config_display(mme_config_t* config_pP) {
         bdata(config_pP->nas_config.apn_map_config.apn_map[j].imsi_prefix),
         bdata(config_pP->nas_config.apn_map_config.apn_map[j].apn_override));
   }
+  OAILOG_INFO(
+      LOG_CONFIG, "      Auth vector cache ...........: %s\n",
+      (config_pP->nas_config.auth_vector_cache.enabled) ? "true" : "false");
+  if (config_pP->nas_config.auth_vector_cache.enabled) {
+    OAILOG_INFO(LOG_CONFIG,
+                "        size %u, TTL %u sec, refill watermark %u\n",
+                config_pP->nas_config.auth_vector_cache.size,
+                config_pP->nas_config.auth_vector_cache.ttl_sec,
+                config_pP->nas_config.auth_vector_cache.refill_watermark);
+  }
   OAILOG_INFO(LOG_CONFIG, "- S6A:\n");
 #if S6A_OVER_GRPC
   OAILOG_INFO(LOG_CONFIG, "    protocol .........: gRPC\n");
@@ -2200,14 +2647,16 @@ int mme_config_parse_opt_line(int argc, char* argv[], mme_config_t* config_pP) {
   return 0;
 }
 
-static bool parse_bool(const char* str) {
+// An invalid str is stored in bad_bool, the caller fails the parsing
+static bool parse_bool(const char* str, const char** bad_bool) {
   if (strcasecmp(str, "yes") == 0) return true;
   if (strcasecmp(str, "true") == 0) return true;
   if (strcasecmp(str, "no") == 0) return false;
   if (strcasecmp(str, "false") == 0) return false;
   if (strcasecmp(str, "") == 0) return false;
 
-  Fatal("Error in config file: got \"%s\" but expected bool\n", str);
+  *bad_bool = str;
+  return false;
 }
 
 void clear_served_tai_config(served_tai_t* served_tai) {
@@ -23,6 +23,7 @@
 
 #include "lte/gateway/c/core/common/common_defs.h"
 #include "lte/gateway/c/core/common/dynamic_memory_check.h"
+#include "lte/gateway/c/core/oai/common/TLVDecoder.h"
 #include "lte/gateway/c/core/oai/common/log.h"
 #include "lte/gateway/c/core/oai/include/nas/securityDef.h"
 #include "lte/gateway/c/core/oai/lib/3gpp/3gpp_24.301.h"
@@ -812,7 +813,20 @@ static int nas_message_protected_decode(
     nas_message_decode_status_t* const status) {
   OAILOG_FUNC_IN(LOG_NAS);
   int bytes = TLV_BUFFER_TOO_SHORT;
-  unsigned char* const plain_msg = (unsigned char*)calloc(1, length);
+  /*
+   * Decrypt into the decoder scratch space when a view scope is open, so
+   * that the IEs decoded as views stay valid after we return
+   */
+  bstring scratch = tlv_decoder_views_scratch(length);
+  unsigned char* plain_msg = NULL;
+  bool views = false;
+
+  if (scratch) {
+    plain_msg = scratch->data;
+  } else {
+    views = tlv_decoder_views_enable(false);
+    plain_msg = (unsigned char*)calloc(1, length);
+  }
 
   if (plain_msg) {
     /*
@@ -826,7 +840,11 @@ static int nas_message_protected_decode(
      * Decode the decrypted message as plain NAS message
      */
     bytes = nas_message_plain_decode(plain_msg, header, msg, length);
+  }
+
+  if (!scratch) {
     free_wrapper((void**)&plain_msg);
+    tlv_decoder_views_enable(views);
   }
 
   OAILOG_FUNC_RETURN(LOG_NAS, bytes);
@@ -1036,7 +1054,6 @@ static int nas_message_decrypt_a(
   OAILOG_FUNC_IN(LOG_NAS);
   nas_stream_cipher_t stream_cipher = {0};
   uint32_t count = 0;
-  uint32_t len = 0;
   uint8_t direction = SECU_DIRECTION_UPLINK;
   int size = 0;
   nas_message_security_header_t header = {0};
@@ -1052,8 +1069,6 @@ static int nas_message_decrypt_a(
           "type "
           "0x%02x\n",
           length, security_header_type);
-      len = sizeof(dest);
-      memset(dest, 0, len);
       memcpy(dest, src, length);
       DECODE_U8(dest, *(uint8_t*)(&header), size);
       OAILOG_FUNC_RETURN(LOG_NAS, header.protocol_discriminator);
@@ -1164,8 +1179,6 @@ static int nas_message_decrypt_a(
                 "dl_count.seq_num %d\n",
                 direction, emm_security_context->ul_count.seq_num,
                 emm_security_context->dl_count.seq_num);
-            len = sizeof(dest);
-            memset(dest, 0, len);
             memcpy(dest, src, length);
             /*
              * Decode the first octet (security header type or EPS bearer
@@ -1179,8 +1192,6 @@ static int nas_message_decrypt_a(
           default:
             OAILOG_ERROR(LOG_NAS, "Unknown Cyphering protection algorithm %d\n",
                          emm_security_context->selected_algorithms.encryption);
-            len = sizeof(dest);
-            memset(dest, 0, len);
             memcpy(dest, src, length);
             /*
              * Decode the first octet (security header type or EPS bearer
@@ -1653,15 +1653,15 @@ static int emm_send_attach_accept(emm_context_t* emm_context) {
 
         rc = mme_api_new_guti(&emm_context->_imsi, &old_guti, &guti,
                               &emm_context->originating_tai,
-                              &emm_context->_tai_list);
+                              &emm_sap.u.emm_as.u.establish.tai_list);
         if (RETURNok == rc) {
           emm_ctx_set_guti(emm_context, &guti);
-          emm_ctx_set_attribute_valid(emm_context, EMM_CTXT_MEMBER_TAI_LIST);
           //----------------------------------------
           REQUIREMENT_3GPP_24_301(R10_5_5_1_2_4__6);
           REQUIREMENT_3GPP_24_301(R10_5_5_1_2_4__10);
-          memcpy(&emm_sap.u.emm_as.u.establish.tai_list,
-                 &emm_context->_tai_list, sizeof(tai_list_t));
+          emm_ctx_set_tai_list(emm_context,
+                               &emm_sap.u.emm_as.u.establish.tai_list);
+          emm_ctx_set_attribute_valid(emm_context, EMM_CTXT_MEMBER_TAI_LIST);
         } else {
           OAILOG_ERROR(LOG_NAS_EMM,
                        "Failed to assign mme api new guti for ue_id "
@@ -1671,8 +1671,9 @@ static int emm_send_attach_accept(emm_context_t* emm_context) {
         }
       } else {
         // Set the TAI attributes from the stored context for resends.
-        memcpy(&emm_sap.u.emm_as.u.establish.tai_list, &emm_context->_tai_list,
-               sizeof(tai_list_t));
+        if (emm_context->_tai_list) {
+          emm_sap.u.emm_as.u.establish.tai_list = *emm_context->_tai_list;
+        }
       }
     }
 
@@ -1753,7 +1754,8 @@ static int emm_send_attach_accept(emm_context_t* emm_context) {
         blength(emm_sap.u.emm_as.u.establish.nas_msg));
 
     // Send T3402
-    emm_sap.u.emm_as.u.establish.t3402 = &mme_config.nas_config.t3402_min;
+    emm_sap.u.emm_as.u.establish.t3402 =
+        &mme_config_get()->nas_config.t3402_min;
 
     // Encode CSFB parameters
     encode_csfb_parameters_attach_accept(emm_context,
@@ -1868,8 +1870,9 @@ static int emm_attach_accept_retx(emm_context_t* emm_context) {
     emm_sap.primitive = EMMAS_DATA_REQ;
     emm_sap.u.emm_as.u.data.ue_id = ue_id;
     emm_sap.u.emm_as.u.data.nas_info = EMM_AS_NAS_DATA_ATTACH_ACCEPT;
-    memcpy(&emm_sap.u.emm_as.u.data.tai_list, &emm_context->_tai_list,
-           sizeof(tai_list_t));
+    if (emm_context->_tai_list) {
+      emm_sap.u.emm_as.u.data.tai_list = *emm_context->_tai_list;
+    }
     emm_sap.u.emm_as.u.data.eps_id.guti = &emm_context->_guti;
     OAILOG_DEBUG(LOG_NAS_EMM,
                  "ue_id=" MME_UE_S1AP_ID_FMT
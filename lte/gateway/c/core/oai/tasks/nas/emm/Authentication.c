@@ -39,6 +39,7 @@
 #include "lte/gateway/c/core/oai/lib/3gpp/3gpp_36.401.h"
 #include "lte/gateway/c/core/oai/lib/bstr/bstrlib.h"
 #include "lte/gateway/c/core/oai/lib/itti/intertask_interface.h"
+#include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_auth_vector_cache.h"
 #include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_defs.h"
 #include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_timer.h"
 #include "lte/gateway/c/core/oai/tasks/nas/emm/EmmCommon.h"
@@ -91,6 +92,9 @@ static int start_authentication_information_procedure(
     const_bstring auts);
 static int auth_info_proc_success_cb(struct emm_context_s* emm_ctx);
 static int auth_info_proc_failure_cb(struct emm_context_s* emm_ctx);
+static void set_auth_vector(struct emm_context_s* emm_ctx, int index,
+                            const eutran_vector_t* vector);
+static bool load_cached_auth_vector(struct emm_context_s* emm_context);
 
 static int authentication_check_imsi_5_4_2_5__1(
     struct emm_context_s* emm_context);
@@ -285,6 +289,9 @@ status_code_e emm_proc_authentication(
     auth_proc->emm_com_proc.emm_proc.base_proc.time_out = NULL;
 
     bool run_auth_info_proc = false;
+    if (!IS_EMM_CTXT_VALID_AUTH_VECTORS(emm_context)) {
+      load_cached_auth_vector(emm_context);
+    }
     if (!IS_EMM_CTXT_VALID_AUTH_VECTORS(emm_context)) {
       // Ask upper layer to fetch new security context
       nas_auth_info_proc_t* auth_info_proc =
@@ -365,12 +372,77 @@ static int start_authentication_information_procedure(
                            auth_info_proc->cn_proc.base_proc.time_out);
 
   nas_itti_auth_info_req(ue_id, &emm_context->_imsi, is_initial_req,
-                         &visited_plmn, MAX_EPS_AUTH_VECTORS, auts,
+                         &visited_plmn,
+                         mme_app_auth_vector_cache_nb_vectors_to_fetch(), auts,
                          emm_context->_ue_network_capability.dcnr);
 
   OAILOG_FUNC_RETURN(LOG_NAS_EMM, RETURNok);
 }
 
+//------------------------------------------------------------------------------
+static void set_auth_vector(struct emm_context_s* emm_ctx, int index,
+                            const eutran_vector_t* vector) {
+  memcpy(emm_ctx->_vector[index].kasme, vector->kasme, AUTH_KASME_SIZE);
+  memcpy(emm_ctx->_vector[index].autn, vector->autn, AUTH_AUTN_SIZE);
+  memcpy(emm_ctx->_vector[index].rand, vector->rand, AUTH_RAND_SIZE);
+  memcpy(emm_ctx->_vector[index].xres, vector->xres.data, vector->xres.size);
+  emm_ctx->_vector[index].xres_size = vector->xres.size;
+  OAILOG_DEBUG_UE(LOG_NAS_EMM, emm_ctx->_imsi64,
+                  "EMM-PROC  - Received XRES ..: " XRES_FORMAT "\n",
+                  XRES_DISPLAY(emm_ctx->_vector[index].xres));
+  OAILOG_DEBUG_UE(LOG_NAS_EMM, emm_ctx->_imsi64,
+                  "EMM-PROC  - Received RAND ..: " RAND_FORMAT "\n",
+                  RAND_DISPLAY(emm_ctx->_vector[index].rand));
+  OAILOG_DEBUG_UE(LOG_NAS_EMM, emm_ctx->_imsi64,
+                  "EMM-PROC  - Received AUTN ..: " AUTN_FORMAT "\n",
+                  AUTN_DISPLAY(emm_ctx->_vector[index].autn));
+  OAILOG_DEBUG_UE(
+      LOG_NAS_EMM, emm_ctx->_imsi64,
+      "EMM-PROC  - Received KASME .: " KASME_FORMAT " " KASME_FORMAT "\n",
+      KASME_DISPLAY_1(emm_ctx->_vector[index].kasme),
+      KASME_DISPLAY_2(emm_ctx->_vector[index].kasme));
+  emm_ctx_set_attribute_valid(emm_ctx, EMM_CTXT_MEMBER_AUTH_VECTOR0 + index);
+}
+
+//------------------------------------------------------------------------------
+// Take the next vector from the cache instead of waiting for the HSS, and ask
+// for more in the background when it runs low
+static bool load_cached_auth_vector(struct emm_context_s* emm_context) {
+  OAILOG_FUNC_IN(LOG_NAS_EMM);
+  eutran_vector_t vector = {0};
+
+  if (!mme_app_auth_vector_cache_enabled() ||
+      !IS_EMM_CTXT_PRESENT_IMSI(emm_context)) {
+    OAILOG_FUNC_RETURN(LOG_NAS_EMM, false);
+  }
+  if (!mme_app_auth_vector_cache_pop(emm_context->_imsi64, &vector)) {
+    increment_counter("auth_vector_cache", 1, 1, "result", "miss");
+    OAILOG_FUNC_RETURN(LOG_NAS_EMM, false);
+  }
+  increment_counter("auth_vector_cache", 1, 1, "result", "hit");
+
+  // Same slot as a vector received from the HSS
+  ksi_t eksi = 0;
+  if (emm_context->_security.eksi < KSI_NO_KEY_AVAILABLE) {
+    eksi = (emm_context->_security.eksi + 1) % (EKSI_MAX_VALUE + 1);
+  }
+  set_auth_vector(emm_context, eksi % MAX_EPS_AUTH_VECTORS, &vector);
+  emm_ctx_set_attribute_present(emm_context, EMM_CTXT_MEMBER_AUTH_VECTORS);
+
+  uint8_t nb_vectors =
+      mme_app_auth_vector_cache_start_refill(emm_context->_imsi64);
+  if (nb_vectors) {
+    plmn_t visited_plmn = {0};
+    COPY_PLMN(visited_plmn, emm_context->originating_tai.plmn);
+    nas_itti_auth_info_req(
+        PARENT_STRUCT(emm_context, struct ue_mm_context_s, emm_context)
+            ->mme_ue_s1ap_id,
+        &emm_context->_imsi, true, &visited_plmn, nb_vectors, NULL,
+        emm_context->_ue_network_capability.dcnr);
+  }
+  OAILOG_FUNC_RETURN(LOG_NAS_EMM, true);
+}
+
 //------------------------------------------------------------------------------
 static int start_authentication_information_procedure_synch(
     struct emm_context_s* emm_context, nas_emm_auth_proc_t* const auth_proc,
@@ -423,35 +495,9 @@ static int auth_info_proc_success_cb(struct emm_context_s* emm_ctx) {
     for (int i = 0; i < auth_info_proc->nb_vectors; i++) {
       AssertFatal(MAX_EPS_AUTH_VECTORS > i, " TOO many vectors");
       int destination_index = (i + eksi) % MAX_EPS_AUTH_VECTORS;
-      memcpy(emm_ctx->_vector[destination_index].kasme,
-             auth_info_proc->vector[i]->kasme, AUTH_KASME_SIZE);
-      memcpy(emm_ctx->_vector[destination_index].autn,
-             auth_info_proc->vector[i]->autn, AUTH_AUTN_SIZE);
-      memcpy(emm_ctx->_vector[destination_index].rand,
-             auth_info_proc->vector[i]->rand, AUTH_RAND_SIZE);
-      memcpy(emm_ctx->_vector[destination_index].xres,
-             auth_info_proc->vector[i]->xres.data,
-             auth_info_proc->vector[i]->xres.size);
-      emm_ctx->_vector[destination_index].xres_size =
-          auth_info_proc->vector[i]->xres.size;
       OAILOG_DEBUG_UE(LOG_NAS_EMM, emm_ctx->_imsi64,
                       "EMM-PROC  - Received Vector %u:\n", i);
-      OAILOG_DEBUG_UE(LOG_NAS_EMM, emm_ctx->_imsi64,
-                      "EMM-PROC  - Received XRES ..: " XRES_FORMAT "\n",
-                      XRES_DISPLAY(emm_ctx->_vector[destination_index].xres));
-      OAILOG_DEBUG_UE(LOG_NAS_EMM, emm_ctx->_imsi64,
-                      "EMM-PROC  - Received RAND ..: " RAND_FORMAT "\n",
-                      RAND_DISPLAY(emm_ctx->_vector[destination_index].rand));
-      OAILOG_DEBUG_UE(LOG_NAS_EMM, emm_ctx->_imsi64,
-                      "EMM-PROC  - Received AUTN ..: " AUTN_FORMAT "\n",
-                      AUTN_DISPLAY(emm_ctx->_vector[destination_index].autn));
-      OAILOG_DEBUG_UE(
-          LOG_NAS_EMM, emm_ctx->_imsi64,
-          "EMM-PROC  - Received KASME .: " KASME_FORMAT " " KASME_FORMAT "\n",
-          KASME_DISPLAY_1(emm_ctx->_vector[destination_index].kasme),
-          KASME_DISPLAY_2(emm_ctx->_vector[destination_index].kasme));
-      emm_ctx_set_attribute_valid(
-          emm_ctx, EMM_CTXT_MEMBER_AUTH_VECTOR0 + destination_index);
+      set_auth_vector(emm_ctx, destination_index, auth_info_proc->vector[i]);
     }
 
     nas_emm_auth_proc_t* auth_proc =
@@ -650,6 +696,8 @@ status_code_e emm_proc_authentication_failure(mme_ue_s1ap_id_t ue_id,
                  RAND_LENGTH_OCTETS);
           memcpy((resync_param.data + RAND_LENGTH_OCTETS), auts->data,
                  AUTS_LENGTH);
+          // The cached vectors were generated with the SQN the USIM rejected
+          mme_app_auth_vector_cache_flush(emm_ctx->_imsi64);
           // TODO: Double check this case as there is no identity request being
           // sent.
           start_authentication_information_procedure_synch(emm_ctx, auth_proc,
@@ -196,6 +196,7 @@ void clear_emm_ctxt(emm_context_t* emm_context) {
   emm_ctx_clear_guti(emm_context);
   emm_ctx_clear_imsi(emm_context);
   emm_ctx_clear_imei(emm_context);
+  emm_ctx_clear_tai_list(emm_context);
   emm_ctx_clear_auth_vectors(emm_context);
   emm_ctx_clear_security(emm_context);
   emm_ctx_clear_non_current_security(emm_context);
@@ -519,20 +519,21 @@ partial_list_t* emm_verify_orig_tai(const tai_t orig_tai) {
   partial_list_t* par_list = NULL;
 
   OAILOG_FUNC_IN(LOG_NAS_EMM);
-  if (!mme_config.partial_list) {
+  const mme_config_t* config = mme_config_get();
+  if (!config->partial_list) {
     OAILOG_ERROR(LOG_NAS_EMM, "partial_list in mme_config is NULL\n");
     OAILOG_FUNC_RETURN(LOG_NAS_EMM, par_list);
   }
 
-  for (uint8_t list_i = 0; list_i < mme_config.num_par_lists; list_i++) {
-    for (uint8_t elem_i = 0; elem_i < mme_config.partial_list[list_i].nb_elem;
+  for (uint8_t list_i = 0; list_i < config->num_par_lists; list_i++) {
+    for (uint8_t elem_i = 0; elem_i < config->partial_list[list_i].nb_elem;
          elem_i++) {
-      if (((mme_config.partial_list[list_i].plmn) &&
+      if (((config->partial_list[list_i].plmn) &&
            (IS_PLMN_EQUAL(orig_tai.plmn,
-                          mme_config.partial_list[list_i].plmn[elem_i]))) &&
-          (mme_config.partial_list[list_i].tac &&
-           (orig_tai.tac == mme_config.partial_list[list_i].tac[elem_i]))) {
-        par_list = &mme_config.partial_list[list_i];
+                          config->partial_list[list_i].plmn[elem_i]))) &&
+          (config->partial_list[list_i].tac &&
+           (orig_tai.tac == config->partial_list[list_i].tac[elem_i]))) {
+        par_list = &config->partial_list[list_i];
         OAILOG_FUNC_RETURN(LOG_NAS_EMM, par_list);
       }
     }
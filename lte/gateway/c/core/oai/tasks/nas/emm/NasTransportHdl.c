@@ -39,6 +39,7 @@
 
 *****************************************************************************/
 #include "lte/gateway/c/core/common/common_defs.h"
+#include "lte/gateway/c/core/oai/common/TLVDecoder.h"
 #include "lte/gateway/c/core/oai/common/common_types.h"
 #include "lte/gateway/c/core/oai/common/conversions.h"
 #include "lte/gateway/c/core/oai/common/log.h"
@@ -135,9 +136,11 @@ status_code_e emm_proc_uplink_nas_transport(mme_ue_s1ap_id_t ue_id,
 
         IMSI_TO_STRING(&emm_ctxt_p->_imsi, imsi_str, IMSI_BCD_DIGITS_MAX + 1);
 
+        // The message container may be a view into the decoded uplink NAS
         nas_itti_sgsap_uplink_unitdata(
-            imsi_str, strlen(imsi_str), nas_msg_pP, p_imeisv, p_mob_st_clsMark2,
-            &emm_ctxt_p->originating_tai, &ue_mm_context_p->e_utran_cgi,
+            imsi_str, strlen(imsi_str), tlv_decoder_views_own(&nas_msg_pP),
+            p_imeisv, p_mob_st_clsMark2, &emm_ctxt_p->originating_tai,
+            &ue_mm_context_p->e_utran_cgi,
             _esm_data.conf.features & MME_API_SMS_ORC8R_SUPPORTED);
       } else {
         if (emm_ctxt_p->is_imsi_only_detach == true) {
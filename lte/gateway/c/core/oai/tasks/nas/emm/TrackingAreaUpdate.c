@@ -439,9 +439,14 @@ status_code_e emm_proc_tracking_area_update_request(
         OAILOG_FUNC_RETURN(LOG_MME_APP, RETURNok);
       }
     }
+    // The stored TAI list is shared, it is verified and updated on a copy
+    tai_list_t tai_list = {0};
+    if (ue_mm_context->emm_context._tai_list) {
+      tai_list = *ue_mm_context->emm_context._tai_list;
+    }
     if (verify_tau_tai(ue_mm_context->emm_context._imsi64,
                        ue_mm_context->emm_context._guti, tai,
-                       &ue_mm_context->emm_context._tai_list) != RETURNok) {
+                       &tai_list) != RETURNok) {
       OAILOG_ERROR_UE(LOG_MME_APP, ue_mm_context->emm_context._imsi64,
                       "tac = %d not configured, sending tau_reject "
                       "message "
@@ -460,6 +465,7 @@ status_code_e emm_proc_tracking_area_update_request(
       }
       OAILOG_FUNC_RETURN(LOG_MME_APP, RETURNok);
     }
+    emm_ctx_set_tai_list(&ue_mm_context->emm_context, &tai_list);
     nas_emm_tau_proc_t* tau_proc = get_nas_specific_procedure_tau(emm_context);
     if (!tau_proc) {
       tau_proc = emm_proc_create_procedure_tau(ue_mm_context, ies);
@@ -814,8 +820,9 @@ static int emm_tracking_area_update_accept(nas_emm_tau_proc_t* const tau_proc) {
       emm_sap.u.emm_as.u.establish.new_guti = NULL;
 
       emm_sap.u.emm_as.u.establish.eps_update_result = eps_update_result;
-      memcpy(&emm_sap.u.emm_as.u.establish.tai_list, &emm_context->_tai_list,
-             sizeof(tai_list_t));
+      if (emm_context->_tai_list) {
+        emm_sap.u.emm_as.u.establish.tai_list = *emm_context->_tai_list;
+      }
       emm_sap.u.emm_as.u.establish.nas_info = EMM_AS_NAS_INFO_TAU;
 
       // Send eps_bearer_context_status in TAU Accept if received in TAU Req
@@ -916,8 +923,9 @@ static int emm_tracking_area_update_accept(nas_emm_tau_proc_t* const tau_proc) {
        */
       emm_as->ue_id = tau_proc->ue_id;
       emm_sap.u.emm_as.u.data.eps_update_result = eps_update_result;
-      memcpy(&emm_sap.u.emm_as.u.data.tai_list, &emm_context->_tai_list,
-             sizeof(tai_list_t));
+      if (emm_context->_tai_list) {
+        emm_sap.u.emm_as.u.data.tai_list = *emm_context->_tai_list;
+      }
       // Send eps_bearer_context_status in TAU Accept if received in TAU Req
       if (tau_proc->ies->eps_bearer_context_status &&
           ue_mm_context->tau_accept_eps_ber_cntx_status) {
@@ -1065,6 +1073,7 @@ void free_emm_tau_request_ies(emm_tau_request_ies_t** const ies) {
     free_wrapper((void**)&((*ies)->mobile_station_classmark3));
   }
   if ((*ies)->supported_codecs) {
+    bdestroy_wrapper((*ies)->supported_codecs);
     free_wrapper((void**)&((*ies)->supported_codecs));
   }
   if ((*ies)->additional_updatetype) {
@@ -243,7 +243,9 @@ typedef struct emm_context_s {
   // */
   guti_t _guti;         /* The GUTI assigned to the UE                     */
   guti_t _old_guti;     /* The old GUTI (GUTI REALLOCATION)                */
-  tai_list_t _tai_list; /* TACs the the UE is registered to                */
+  /* TACs the the UE is registered to, shared with the other UEs of the same
+   * TAI list, see emm_ctx_set_tai_list */
+  const tai_list_t* _tai_list;
   tai_t _lvr_tai;
   tai_t originating_tai;
 
@@ -474,6 +476,11 @@ __attribute__((flatten));
 void emm_ctx_set_valid_lvr_tai(emm_context_t* const ctxt, tai_t* lvr_tai)
     __attribute__((nonnull)) __attribute__((flatten));
 
+void emm_ctx_clear_tai_list(emm_context_t* const ctxt) __attribute__((nonnull));
+void emm_ctx_set_tai_list(emm_context_t* const ctxt,
+                          const tai_list_t* const tai_list)
+    __attribute__((nonnull));
+
 void emm_ctx_clear_auth_vectors(emm_context_t* const ctxt)
     __attribute__((nonnull)) __attribute__((flatten));
 void emm_ctx_clear_auth_vector(emm_context_t* const ctxt, ksi_t eksi)
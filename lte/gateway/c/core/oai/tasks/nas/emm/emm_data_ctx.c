@@ -41,6 +41,7 @@
 #include "lte/gateway/c/core/oai/lib/hashtable/hashtable.h"
 #include "lte/gateway/c/core/oai/lib/itti/intertask_interface.h"
 #include "lte/gateway/c/core/oai/lib/secu/secu_defs.h"
+#include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_shared_ue_data.h"
 #include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_timer.h"
 #include "lte/gateway/c/core/oai/tasks/nas/api/mme/mme_api.h"
 #include "lte/gateway/c/core/oai/tasks/nas/emm/emm_data.h"
@@ -281,6 +282,21 @@ inline void emm_ctx_set_valid_lvr_tai(emm_context_t* const ctxt,
   // ue_mm_context_s, emm_context))->mme_ue_s1ap_id, TAI_ARG(&ctxt->_lvr_tai));
 }
 
+//------------------------------------------------------------------------------
+/* Clear TAI list */
+void emm_ctx_clear_tai_list(emm_context_t* const ctxt) {
+  mme_app_release_tai_list(&ctxt->_tai_list);
+  emm_ctx_clear_attribute_present(ctxt, EMM_CTXT_MEMBER_TAI_LIST);
+}
+
+/* Set TAI list, the context keeps a reference to the shared copy */
+void emm_ctx_set_tai_list(emm_context_t* const ctxt,
+                          const tai_list_t* const tai_list) {
+  const tai_list_t* previous = ctxt->_tai_list;
+  ctxt->_tai_list = mme_app_share_tai_list(tai_list);
+  mme_app_release_tai_list(&previous);
+}
+
 //------------------------------------------------------------------------------
 /* Clear AUTH vectors  */
 inline void emm_ctx_clear_auth_vectors(emm_context_t* const ctxt) {
@@ -619,6 +635,7 @@ void free_emm_ctx_memory(emm_context_t* const ctxt,
   }
   nas_delete_all_emm_procedures(ctxt);
   free_esm_context_content(&ctxt->esm_ctx);
+  mme_app_release_tai_list(&ctxt->_tai_list);
 }
 
 //------------------------------------------------------------------------------
@@ -708,6 +725,7 @@ void emm_init_context(struct emm_context_s* const emm_ctx,
   emm_ctx_clear_imei(emm_ctx);
   emm_ctx_clear_imeisv(emm_ctx);
   emm_ctx_clear_lvr_tai(emm_ctx);
+  emm_ctx_clear_tai_list(emm_ctx);
   emm_ctx_clear_security(emm_ctx);
   emm_ctx_clear_non_current_security(emm_ctx);
   emm_ctx_clear_auth_vectors(emm_ctx);
@@ -717,7 +735,7 @@ void emm_init_context(struct emm_context_s* const emm_ctx,
   emm_ctx_clear_mobile_station_clsMark2(emm_ctx);
   emm_ctx_clear_ue_additional_security_capability(emm_ctx);
   emm_ctx->T3422.id = NAS_TIMER_INACTIVE_ID;
-  emm_ctx->T3422.msec = mme_config.nas_config.t3422_msec;
+  emm_ctx->T3422.msec = mme_config_get()->nas_config.t3422_msec;
   emm_ctx->new_attach_info = NULL;
   emm_ctx->emm_context_state = NEW_EMM_CONTEXT_NOT_CREATED;
 
@@ -23,6 +23,7 @@
 
 #include "lte/gateway/c/core/common/common_defs.h"
 #include "lte/gateway/c/core/common/dynamic_memory_check.h"
+#include "lte/gateway/c/core/oai/common/TLVDecoder.h"
 #include "lte/gateway/c/core/oai/common/common_types.h"
 #include "lte/gateway/c/core/oai/common/conversions.h"
 #include "lte/gateway/c/core/oai/common/log.h"
@@ -168,18 +169,25 @@ status_code_e emm_as_send(emm_as_t* msg) {
   int emm_cause = EMM_CAUSE_SUCCESS;
   emm_as_primitive_t primitive = msg->primitive;
   mme_ue_s1ap_id_t ue_id = 0;
+  tlv_decoder_views_t views = {0};
 
   OAILOG_INFO(LOG_NAS_EMM, "EMMAS-SAP - Received primitive %s (%d)\n",
               emm_as_primitive_str[primitive - _EMMAS_START - 1], primitive);
 
   switch (primitive) {
     case _EMMAS_DATA_IND:
+      views = tlv_decoder_views_open();
       rc = emm_as_data_ind(&msg->u.data, &emm_cause);
+      tlv_decoder_views_close(views);
       ue_id = msg->u.data.ue_id;
       break;
 
     case _EMMAS_ESTABLISH_REQ:
+      views = tlv_decoder_views_open();
       rc = emm_as_establish_req(&msg->u.establish, &emm_cause);
+      // The IEs of a plain initial NAS message are views into it
+      bdestroy_wrapper(&msg->u.establish.nas_msg);
+      tlv_decoder_views_close(views);
       ue_id = msg->u.establish.ue_id;
       break;
 
@@ -335,10 +343,13 @@ static int emm_as_recv(mme_ue_s1ap_id_t ue_id, tai_t const* originating_tai,
   }
 
   /*
-   * Decode the received message
+   * Decode the received message, the caller keeps msg for the whole
+   * processing so that its IEs can be views
    */
+  bool views = tlv_decoder_views_enable(true);
   decoder_rc = nas_message_decode(msg->data, &nas_msg, len,
                                   emm_security_context, decode_status);
+  tlv_decoder_views_enable(views);
 
   if (decoder_rc < 0) {
     OAILOG_ERROR(LOG_NAS_EMM,
@@ -629,9 +640,13 @@ static int emm_as_data_ind(emm_as_data_t* msg, int* emm_cause) {
   if (EMM_AS_DATA_DELIVERED_TRUE == msg->delivered) {
     if (blength(msg->nas_msg) > 0) {
       /*
-       * Process the received NAS message
+       * Process the received NAS message, decrypted into the decoder
+       * scratch space if there is room
        */
-      bstring plain_msg = bstrcpy(msg->nas_msg);
+      bstring plain_msg = tlv_decoder_views_scratch(blength(msg->nas_msg));
+      if (!plain_msg) {
+        plain_msg = bstrcpy(msg->nas_msg);
+      }
 
       if (plain_msg) {
         nas_message_security_header_t header = {0};
@@ -777,10 +792,11 @@ static int emm_as_establish_req(emm_as_establish_t* msg, int* emm_cause) {
                "EMMAS-SAP - Decoding Initial NAS message for ue_id "
                "= " MME_UE_S1AP_ID_FMT,
                msg->ue_id);
+  bool views = tlv_decoder_views_enable(true);
   decoder_rc =
       nas_message_decode(msg->nas_msg->data, &nas_msg, blength(msg->nas_msg),
                          emm_security_context, &decode_status);
-  bdestroy_wrapper(&msg->nas_msg);
+  tlv_decoder_views_enable(views);
 
   // TODO conditional IE error
   if (decoder_rc < 0) {
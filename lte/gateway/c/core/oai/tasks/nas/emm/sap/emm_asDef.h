@@ -209,7 +209,7 @@ typedef struct emm_as_establish_s {
                                      included to assign or unassign a new TMSI
                                      to a UE during a combined TA/LA update. */
   int* combined_tau_emm_cause;    /* TAU EMM failure cause code   */
-  uint32_t* t3402;                /* TAU GPRS T3402 timer   */
+  const uint32_t* t3402;          /* TAU GPRS T3402 timer   */
   uint32_t* t3423;                /* TAU GPRS T3423 timer   */
   void* equivalent_plmns;         /* TAU Equivalent PLMNs   */
   void* emergency_number_list;    /* TAU Emergency number list   */
@@ -264,7 +264,7 @@ static int emm_cn_ula_success(emm_cn_ula_success_t* msg_pP) {
   // PDN selection here
   // Because NAS knows APN selected by UE if any
   // default APN selection
-  struct apn_configuration_s* apn_config =
+  const struct apn_configuration_s* apn_config =
       mme_app_select_apn(ue_mm_context, &esm_cause);
 
   if (!apn_config) {
@@ -22,6 +22,7 @@
 
 #include "lte/gateway/c/core/common/common_defs.h"
 #include "lte/gateway/c/core/common/dynamic_memory_check.h"
+#include "lte/gateway/c/core/oai/common/TLVDecoder.h"
 #include "lte/gateway/c/core/oai/common/conversions.h"
 #include "lte/gateway/c/core/oai/common/log.h"
 #include "lte/gateway/c/core/oai/include/3gpp_requirements_24.301.h"
@@ -412,8 +413,8 @@ status_code_e emm_recv_attach_request(
     bdestroy_wrapper(&msg->supportedcodecs);
   }
 
-  params->esm_msg = msg->esmmessagecontainer;
-  msg->esmmessagecontainer = NULL;
+  // Kept by the attach procedure, beyond the life of the decoded message
+  params->esm_msg = tlv_decoder_views_own(&msg->esmmessagecontainer);
 
   params->decode_status = *decode_status;
 
@@ -700,8 +701,7 @@ status_code_e emm_recv_tracking_area_update_request(
   if (msg->presencemask &
       TRACKING_AREA_UPDATE_REQUEST_SUPPORTED_CODECS_PRESENT) {
     ies->supported_codecs = calloc(1, sizeof(*ies->supported_codecs));
-    memcpy(ies->supported_codecs, &msg->supportedcodecs,
-           sizeof(*ies->supported_codecs));
+    *ies->supported_codecs = tlv_decoder_views_own(&msg->supportedcodecs);
   }
   if (msg->presencemask &
       TRACKING_AREA_UPDATE_REQUEST_ADDITIONAL_UPDATE_TYPE_PRESENT) {
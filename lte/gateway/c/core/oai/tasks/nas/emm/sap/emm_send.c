@@ -302,16 +302,17 @@ status_code_e emm_send_attach_accept(const emm_as_establish_t* msg,
    * Mandatory - T3412 value
    */
   size += GPRS_TIMER_IE_MAX_LENGTH;
+  const uint32_t t3412_min = mme_config_get()->nas_config.t3412_min;
   // Check whether Periodic TAU timer is disabled
-  if (mme_config.nas_config.t3412_min == 0) {
+  if (t3412_min == 0) {
     emm_msg->t3412value.unit = GPRS_TIMER_UNIT_0S;
-    emm_msg->t3412value.timervalue = mme_config.nas_config.t3412_min;
-  } else if (mme_config.nas_config.t3412_min <= 31) {
+    emm_msg->t3412value.timervalue = t3412_min;
+  } else if (t3412_min <= 31) {
     emm_msg->t3412value.unit = GPRS_TIMER_UNIT_60S;
-    emm_msg->t3412value.timervalue = mme_config.nas_config.t3412_min;
+    emm_msg->t3412value.timervalue = t3412_min;
   } else {
     emm_msg->t3412value.unit = GPRS_TIMER_UNIT_360S;
-    emm_msg->t3412value.timervalue = mme_config.nas_config.t3412_min / 6;
+    emm_msg->t3412value.timervalue = t3412_min / 6;
   }
   // emm_msg->t3412value.unit = GPRS_TIMER_UNIT_0S;
   OAILOG_DEBUG(
@@ -475,12 +476,12 @@ status_code_e emm_send_attach_accept(const emm_as_establish_t* msg,
   if (msg->t3402) {
     size += GPRS_TIMER_IE_MAX_LENGTH;
     emm_msg->presencemask |= ATTACH_ACCEPT_T3402_VALUE_PRESENT;
-    if (mme_config.nas_config.t3402_min <= 31) {
+    if (*msg->t3402 <= 31) {
       emm_msg->t3402value.unit = GPRS_TIMER_UNIT_60S;
-      emm_msg->t3402value.timervalue = mme_config.nas_config.t3402_min;
+      emm_msg->t3402value.timervalue = *msg->t3402;
     } else {
       emm_msg->t3402value.unit = GPRS_TIMER_UNIT_360S;
-      emm_msg->t3402value.timervalue = mme_config.nas_config.t3402_min / 6;
+      emm_msg->t3402value.timervalue = *msg->t3402 / 6;
     }
   }
 
@@ -593,16 +594,17 @@ status_code_e emm_send_attach_accept_dl_nas(const emm_as_data_t* msg,
    * Mandatory - T3412 value
    */
   size += GPRS_TIMER_IE_MAX_LENGTH;
+  const uint32_t t3412_min = mme_config_get()->nas_config.t3412_min;
   // Check whether Periodic TAU timer is disabled
-  if (mme_config.nas_config.t3412_min == 0) {
+  if (t3412_min == 0) {
     emm_msg->t3412value.unit = GPRS_TIMER_UNIT_0S;
-    emm_msg->t3412value.timervalue = mme_config.nas_config.t3412_min;
-  } else if (mme_config.nas_config.t3412_min <= 31) {
+    emm_msg->t3412value.timervalue = t3412_min;
+  } else if (t3412_min <= 31) {
     emm_msg->t3412value.unit = GPRS_TIMER_UNIT_60S;
-    emm_msg->t3412value.timervalue = mme_config.nas_config.t3412_min;
+    emm_msg->t3412value.timervalue = t3412_min;
   } else {
     emm_msg->t3412value.unit = GPRS_TIMER_UNIT_360S;
-    emm_msg->t3412value.timervalue = mme_config.nas_config.t3412_min / 6;
+    emm_msg->t3412value.timervalue = t3412_min / 6;
   }
   // emm_msg->t3412value.unit = GPRS_TIMER_UNIT_0S;
   OAILOG_INFO(LOG_NAS_EMM,
@@ -568,7 +568,7 @@ static int dedicated_eps_bearer_activate(emm_context_t* emm_context, ebi_t ebi,
      * Start T3485 retransmission timer
      */
     rc = esm_ebr_start_timer(emm_context, ebi, msg_dup,
-                             mme_config.nas_config.t3485_msec,
+                             mme_config_get()->nas_config.t3485_msec,
                              dedicated_eps_bearer_activate_t3485_handler);
   }
   bdestroy_wrapper(&msg_dup);
@@ -624,7 +624,7 @@ static int default_eps_bearer_activate(emm_context_t* emm_context, ebi_t ebi,
      * Start T3485 retransmission timer
      */
     rc = esm_ebr_start_timer(emm_context, ebi, *msg,
-                             mme_config.nas_config.t3485_msec,
+                             mme_config_get()->nas_config.t3485_msec,
                              default_eps_bearer_activate_t3485_handler);
     if (rc != RETURNerror) {
       OAILOG_DEBUG_UE(LOG_NAS_ESM, emm_context->_imsi64,
@@ -691,7 +691,7 @@ static int default_eps_bearer_activate_in_bearer_setup_req(
      * Start T3485 retransmission timer
      */
     rc = esm_ebr_start_timer(emm_context, ebi, msg_dup,
-                             mme_config.nas_config.t3485_msec,
+                             mme_config_get()->nas_config.t3485_msec,
                              default_eps_bearer_activate_t3485_handler);
   }
 
@@ -576,7 +576,7 @@ static int eps_bearer_deactivate(emm_context_t* emm_context_p, ebi_t ebi,
      * Start T3495 retransmission timer
      */
     rc = esm_ebr_start_timer(emm_context_p, ebi, msg_dup,
-                             mme_config.nas_config.t3495_msec,
+                             mme_config_get()->nas_config.t3495_msec,
                              eps_bearer_deactivate_t3495_handler);
   }
   bdestroy_wrapper(&msg_dup);
@@ -305,7 +305,7 @@ esm_cause_t esm_recv_pdn_connectivity_request(
     ue_mm_context_t* ue_mm_context_p =
         mme_ue_context_exists_mme_ue_s1ap_id(ue_id);
     // Select APN
-    struct apn_configuration_s* apn_config =
+    const struct apn_configuration_s* apn_config =
         mme_app_select_apn(ue_mm_context_p, &esm_cause);
 
     /*
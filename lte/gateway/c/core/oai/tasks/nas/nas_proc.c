@@ -46,6 +46,7 @@
 #include "lte/gateway/c/core/oai/lib/3gpp/3gpp_33.401.h"
 #include "lte/gateway/c/core/oai/lib/bstr/bstrlib.h"
 #include "lte/gateway/c/core/oai/lib/hashtable/hashtable.h"
+#include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_auth_vector_cache.h"
 #include "lte/gateway/c/core/oai/tasks/nas/api/mme/mme_api.h"
 #include "lte/gateway/c/core/oai/tasks/nas/emm/emm_data.h"
 #include "lte/gateway/c/core/oai/tasks/nas/emm/emm_main.h"
@@ -69,6 +70,8 @@
 /****************************************************************************/
 
 static nas_cause_t s6a_error_2_nas_cause(uint32_t s6a_error, int experimental);
+static int nas_proc_auth_vector_cache_refill_answer(
+    imsi64_t imsi64, const s6a_auth_info_ans_t* aia);
 
 /****************************************************************************/
 /******************  E X P O R T E D    F U N C T I O N S  ******************/
@@ -358,6 +361,19 @@ status_code_e nas_proc_authentication_info_answer(
     emm_ctxt_p = &ue_mm_context_p->emm_context;
   }
 
+  if (mme_app_auth_vector_cache_enabled()) {
+    if (!emm_ctxt_p || !get_nas_cn_procedure_auth_info(emm_ctxt_p)) {
+      OAILOG_FUNC_RETURN(LOG_NAS_EMM,
+                         nas_proc_auth_vector_cache_refill_answer(imsi64, aia));
+    }
+    if (mme_app_auth_vector_cache_drop_stale_answer(imsi64)) {
+      OAILOG_INFO_UE(LOG_NAS_EMM, imsi64,
+                     "Dropping the stale answer to an authentication vector "
+                     "cache refill\n");
+      OAILOG_FUNC_RETURN(LOG_NAS_EMM, RETURNok);
+    }
+  }
+
   if (!(emm_ctxt_p)) {
     OAILOG_ERROR_UE(LOG_NAS_EMM, imsi64,
                     "That's embarrassing as we don't know this IMSI\n");
@@ -372,18 +388,28 @@ status_code_e nas_proc_authentication_info_answer(
   if ((aia->result.present == S6A_RESULT_BASE) &&
       (aia->result.choice.base == DIAMETER_SUCCESS)) {
     /*
-     * Check that list is not empty and contain at most MAX_EPS_AUTH_VECTORS
+     * Check that list is not empty and contain at most MAX_AUTH_INFO_VECTORS
      * elements
      */
-    DevCheck(aia->auth_info.nb_of_vectors <= MAX_EPS_AUTH_VECTORS,
-             aia->auth_info.nb_of_vectors, MAX_EPS_AUTH_VECTORS, 0);
+    DevCheck(aia->auth_info.nb_of_vectors <= MAX_AUTH_INFO_VECTORS,
+             aia->auth_info.nb_of_vectors, MAX_AUTH_INFO_VECTORS, 0);
     DevCheck(aia->auth_info.nb_of_vectors > 0, aia->auth_info.nb_of_vectors, 1,
              0);
 
     OAILOG_DEBUG_UE(LOG_NAS_EMM, imsi64,
                     "INFORMING NAS ABOUT AUTH RESP SUCCESS got %u vector(s)\n",
                     aia->auth_info.nb_of_vectors);
-    rc = nas_proc_auth_param_res(mme_ue_s1ap_id, aia->auth_info.nb_of_vectors,
+    uint8_t nb_vectors = aia->auth_info.nb_of_vectors;
+    if (nb_vectors > MAX_EPS_AUTH_VECTORS) {
+      // The spare vectors were requested for the cache
+      if (mme_app_auth_vector_cache_enabled()) {
+        mme_app_auth_vector_cache_push(
+            imsi64, &aia->auth_info.eutran_vector[MAX_EPS_AUTH_VECTORS],
+            nb_vectors - MAX_EPS_AUTH_VECTORS);
+      }
+      nb_vectors = MAX_EPS_AUTH_VECTORS;
+    }
+    rc = nas_proc_auth_param_res(mme_ue_s1ap_id, nb_vectors,
                                  aia->auth_info.eutran_vector);
   } else {
     OAILOG_ERROR_UE(LOG_NAS_EMM, imsi64,
@@ -414,6 +440,30 @@ status_code_e nas_proc_authentication_info_answer(
   OAILOG_FUNC_RETURN(LOG_NAS_EMM, rc);
 }
 
+//------------------------------------------------------------------------------
+static int nas_proc_auth_vector_cache_refill_answer(
+    imsi64_t imsi64, const s6a_auth_info_ans_t* aia) {
+  OAILOG_FUNC_IN(LOG_NAS_EMM);
+  if (!mme_app_auth_vector_cache_refill_done(imsi64)) {
+    OAILOG_INFO_UE(LOG_NAS_EMM, imsi64,
+                   "Dropping the stale answer to an authentication vector "
+                   "cache refill\n");
+    OAILOG_FUNC_RETURN(LOG_NAS_EMM, RETURNok);
+  }
+  if ((aia->result.present == S6A_RESULT_BASE) &&
+      (aia->result.choice.base == DIAMETER_SUCCESS)) {
+    OAILOG_DEBUG_UE(LOG_NAS_EMM, imsi64,
+                    "Caching %u authentication vector(s)\n",
+                    aia->auth_info.nb_of_vectors);
+    mme_app_auth_vector_cache_push(imsi64, aia->auth_info.eutran_vector,
+                                   aia->auth_info.nb_of_vectors);
+    OAILOG_FUNC_RETURN(LOG_NAS_EMM, RETURNok);
+  }
+  OAILOG_WARNING_UE(LOG_NAS_EMM, imsi64,
+                    "Failed to refill the authentication vector cache\n");
+  OAILOG_FUNC_RETURN(LOG_NAS_EMM, RETURNerror);
+}
+
 //------------------------------------------------------------------------------
 status_code_e nas_proc_auth_param_res(mme_ue_s1ap_id_t ue_id,
                                       uint8_t nb_vectors,
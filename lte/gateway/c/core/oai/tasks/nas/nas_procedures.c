@@ -618,7 +618,7 @@ nas_emm_attach_proc_t* nas_new_attach_procedure(
   nas_emm_attach_proc_t* proc =
       (nas_emm_attach_proc_t*)emm_context->emm_procedures->emm_specific_proc;
 
-  proc->T3450.msec = mme_config.nas_config.t3450_msec;
+  proc->T3450.msec = mme_config_get()->nas_config.t3450_msec;
   proc->T3450.id = NAS_TIMER_INACTIVE_ID;
 
   OAILOG_TRACE(LOG_NAS_EMM, "New EMM_SPEC_PROC_TYPE_ATTACH\n");
@@ -654,7 +654,7 @@ nas_emm_tau_proc_t* nas_new_tau_procedure(
   nas_emm_tau_proc_t* proc =
       (nas_emm_tau_proc_t*)emm_context->emm_procedures->emm_specific_proc;
 
-  proc->T3450.msec = mme_config.nas_config.t3450_msec;
+  proc->T3450.msec = mme_config_get()->nas_config.t3450_msec;
   proc->T3450.id = NAS_TIMER_INACTIVE_ID;
 
   return proc;
@@ -707,7 +707,7 @@ nas_emm_ident_proc_t* nas_new_identification_procedure(
   ident_proc->emm_com_proc.emm_proc.type = NAS_EMM_PROC_TYPE_COMMON;
   ident_proc->emm_com_proc.type = EMM_COMM_PROC_IDENT;
 
-  ident_proc->T3470.msec = mme_config.nas_config.t3470_msec;
+  ident_proc->T3470.msec = mme_config_get()->nas_config.t3470_msec;
   ident_proc->T3470.id = NAS_TIMER_INACTIVE_ID;
 
   nas_emm_common_procedure_t* wrapper = calloc(1, sizeof(*wrapper));
@@ -738,7 +738,7 @@ nas_emm_auth_proc_t* nas_new_authentication_procedure(
   auth_proc->emm_com_proc.emm_proc.type = NAS_EMM_PROC_TYPE_COMMON;
   auth_proc->emm_com_proc.type = EMM_COMM_PROC_AUTH;
 
-  auth_proc->T3460.msec = mme_config.nas_config.t3460_msec;
+  auth_proc->T3460.msec = mme_config_get()->nas_config.t3460_msec;
   auth_proc->T3460.id = NAS_TIMER_INACTIVE_ID;
 
   nas_emm_common_procedure_t* wrapper = calloc(1, sizeof(*wrapper));
@@ -769,7 +769,7 @@ nas_emm_smc_proc_t* nas_new_smc_procedure(
   smc_proc->emm_com_proc.emm_proc.type = NAS_EMM_PROC_TYPE_COMMON;
   smc_proc->emm_com_proc.type = EMM_COMM_PROC_SMC;
 
-  smc_proc->T3460.msec = mme_config.nas_config.t3460_msec;
+  smc_proc->T3460.msec = mme_config_get()->nas_config.t3460_msec;
   smc_proc->T3460.id = NAS_TIMER_INACTIVE_ID;
 
   nas_emm_common_procedure_t* wrapper = calloc(1, sizeof(*wrapper));
@@ -798,7 +798,7 @@ nas_auth_info_proc_t* nas_new_cn_auth_info_procedure(
       __sync_fetch_and_add(&nas_puid, 1);
   auth_info_proc->cn_proc.base_proc.type = NAS_PROC_TYPE_CN;
   auth_info_proc->cn_proc.type = CN_PROC_AUTH_INFO;
-  auth_info_proc->timer_s6a.msec = mme_config.nas_config.ts6a_msec;
+  auth_info_proc->timer_s6a.msec = mme_config_get()->nas_config.ts6a_msec;
   auth_info_proc->timer_s6a.id = NAS_TIMER_INACTIVE_ID;
 
   nas_cn_procedure_t* wrapper = calloc(1, sizeof(*wrapper));
@@ -1671,8 +1671,10 @@ void NasStateConverter::emm_context_to_proto(
   guti_to_proto(state_emm_context->_guti, emm_context_proto->mutable_guti());
   guti_to_proto(state_emm_context->_old_guti,
                 emm_context_proto->mutable_old_guti());
-  tai_list_to_proto(&state_emm_context->_tai_list,
-                    emm_context_proto->mutable_tai_list());
+  if (state_emm_context->_tai_list) {
+    tai_list_to_proto(state_emm_context->_tai_list,
+                      emm_context_proto->mutable_tai_list());
+  }
   tai_to_proto(&state_emm_context->_lvr_tai,
                emm_context_proto->mutable_lvr_tai());
   tai_to_proto(&state_emm_context->originating_tai,
@@ -1759,8 +1761,12 @@ void NasStateConverter::proto_to_emm_context(
                                 &state_emm_context->_guti);
   StateConverter::proto_to_guti(emm_context_proto.old_guti(),
                                 &state_emm_context->_old_guti);
-  proto_to_tai_list(emm_context_proto.tai_list(),
-                    &state_emm_context->_tai_list);
+  state_emm_context->_tai_list = nullptr;
+  if (emm_context_proto.has_tai_list()) {
+    tai_list_t tai_list = {0};
+    proto_to_tai_list(emm_context_proto.tai_list(), &tai_list);
+    emm_ctx_set_tai_list(state_emm_context, &tai_list);
+  }
   proto_to_tai(emm_context_proto.lvr_tai(), &state_emm_context->_lvr_tai);
   proto_to_tai(emm_context_proto.originating_tai(),
                &state_emm_context->originating_tai);
@@ -759,7 +759,7 @@ status_code_e ngap_amf_handle_initial_context_setup_response(
       OAILOG_FUNC_RETURN(LOG_NGAP, RETURNerror);
     }
   }
-  ue_ref_p->ng_ue_state = NGAP_UE_CONNECTED;
+  ngap_set_ue_state(ue_ref_p, NGAP_UE_CONNECTED);
   message_p =
       itti_alloc_new_message(TASK_NGAP, AMF_APP_INITIAL_CONTEXT_SETUP_RSP);
   AssertFatal(message_p != NULL, "itti_alloc_new_message Failed");
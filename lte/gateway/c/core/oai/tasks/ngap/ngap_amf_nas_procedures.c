@@ -482,7 +482,7 @@ status_code_e ngap_generate_downlink_nas_transport(
           "in NGAP_UE_WAITING_CRR, so dropping the DownlinkNASTransport \n");
       OAILOG_FUNC_RETURN(LOG_NGAP, RETURNerror);
     } else {
-      ue_ref->ng_ue_state = NGAP_UE_CONNECTED;
+      ngap_set_ue_state(ue_ref, NGAP_UE_CONNECTED);
     }
     /*
      * Setting UE informations with the ones found in ue_ref
@@ -907,6 +907,7 @@ void ngap_handle_amf_ue_id_notification(
         ngap_state_get_ue_gnbid(gnb_ref->sctp_assoc_id, gnb_ue_ngap_id);
     if (ue_ref) {
       ue_ref->amf_ue_ngap_id = amf_ue_ngap_id;
+      UE_STATE_MARK_DIRTY(ue_ref);
       hashtable_rc_t h_rc = hashtable_ts_insert(
           &state->amfid2associd, (const hash_key_t)amf_ue_ngap_id,
           (void*)(uintptr_t)sctp_assoc_id);
@@ -146,6 +146,14 @@ bool ngap_ue_compare_by_imsi(__attribute__((unused)) const hash_key_t keyP,
   OAILOG_FUNC_RETURN(LOG_NGAP, false);
 }
 
+void ngap_set_ue_state(m5g_ue_description_t* ue_ref,
+                       enum ng_ue_state_s ng_ue_state) {
+  if (ue_ref->ng_ue_state != ng_ue_state) {
+    ue_ref->ng_ue_state = ng_ue_state;
+    UE_STATE_MARK_DIRTY(ue_ref);
+  }
+}
+
 hash_table_ts_t* get_ngap_ue_state(void) {
   return NgapStateManager::getInstance().get_ue_state_ht();
 }
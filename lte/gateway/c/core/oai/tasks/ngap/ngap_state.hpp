@@ -47,6 +47,14 @@ m5g_ue_description_t* ngap_state_get_ue_amfid(amf_ue_ngap_id_t amf_ue_ngap_id);
 
 m5g_ue_description_t* ngap_state_get_ue_imsi(imsi64_t imsi64);
 
+/**
+ * Sets the NGAP state of a UE, marks the UE state dirty if it changed
+ * @param ue_ref UE context
+ * @param ng_ue_state new NGAP UE state
+ */
+void ngap_set_ue_state(m5g_ue_description_t* ue_ref,
+                       enum ng_ue_state_s ng_ue_state);
+
 /**
  * Return unique composite id for NGAP UE context
  * @param sctp_assoc_id unique SCTP assoc id
@@ -275,14 +275,17 @@ status_code_e NgapStateManager::read_ue_state_from_db() {
   OAILOG_FUNC_RETURN(LOG_NGAP, RETURNok);
 }
 
-void NgapStateManager::write_ue_state_to_db(
-    const m5g_ue_description_t* ue_context, const std::string& imsi_str) {
+void NgapStateManager::write_ue_state_to_db(m5g_ue_description_t* ue_context,
+                                            const std::string& imsi_str) {
 #if !MME_UNIT_TEST
   /* Data store is Redis db. In this case actual call is made to Redis db */
   StateManager::write_ue_state_to_db(ue_context, imsi_str);
 #else
   /* Data store is a map defined in NGAPClientServicer. In this case call is NOT
    * made to Redis db */
+  if (!UE_STATE_IS_DIRTY(ue_context)) {
+    OAILOG_FUNC_OUT(LOG_NGAP);
+  }
   std::string proto_ue_str;
   Ngap_UeDescription ue_proto = Ngap_UeDescription();
   NgapStateConverter::ue_to_proto(ue_context, &ue_proto);
@@ -290,7 +293,7 @@ void NgapStateManager::write_ue_state_to_db(
   std::size_t new_hash = std::hash<std::string>{}(proto_ue_str);
 
   OAILOG_FUNC_IN(LOG_NGAP);
-  if (new_hash != this->ue_state_hash[imsi_str]) {
+  if (new_hash != ue_context->state_sync.hash) {
     std::string key = IMSI_PREFIX + imsi_str + ":" + task_name;
     // Writes to the map_ngap_uestate_proto_str Map
     if (NGAPClientServicer::getInstance().map_ngap_uestate_proto_str.insert(
@@ -300,11 +303,13 @@ void NgapStateManager::write_ue_state_to_db(
       OAILOG_FUNC_OUT(LOG_NGAP);
     }
 
-    this->ue_state_version[imsi_str]++;
-    this->ue_state_hash[imsi_str] = new_hash;
+    ue_context->state_sync.version++;
+    ue_context->state_sync.hash = new_hash;
     OAILOG_DEBUG(log_task, "Finished writing UE state for IMSI %s",
                  imsi_str.c_str());
   }
+  ue_context->state_sync.persisted_generation =
+      ue_context->state_sync.generation;
 #endif
   OAILOG_FUNC_OUT(LOG_NGAP);
 }
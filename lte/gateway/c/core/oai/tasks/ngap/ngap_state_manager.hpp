@@ -94,7 +94,7 @@ class NgapStateManager
    * @return operation response code
    */
   status_code_e read_ue_state_from_db() override;
-  void write_ue_state_to_db(const m5g_ue_description_t* ue_context,
+  void write_ue_state_to_db(m5g_ue_description_t* ue_context,
                             const std::string& imsi_str) override;
   /**
    * Serializes ngap_imsi_map to proto and saves it into data store
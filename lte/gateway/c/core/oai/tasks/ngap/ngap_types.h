@@ -107,6 +107,9 @@ typedef struct m5g_ue_description_s {
 
   // UE Context Release procedure guard timer
   struct ngap_timer_t ngap_ue_context_rel_timer;
+
+  // Persisted copy of this context, see UE_STATE_MARK_DIRTY
+  ue_state_sync_t state_sync;
 } m5g_ue_description_t;
 
 /// typedef struct ngap_imsi_map_s {
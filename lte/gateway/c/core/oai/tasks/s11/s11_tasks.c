@@ -259,6 +259,25 @@ static int handle_message(zloop_t* loop, zsock_t* reader, void* arg) {
       DevAssert(rc == NW_OK);
     } break;
 
+    case UDP_DATA_IND_BATCH: {
+      /*
+       * Several datagrams were read from the same socket in one go
+       */
+      nw_rc_t rc;
+      udp_data_ind_batch_t* udp_data_ind_batch;
+
+      udp_data_ind_batch = &received_message_p->ittiMsg.udp_data_ind_batch;
+      for (uint32_t i = 0; i < udp_data_ind_batch->num_datagrams; i++) {
+        udp_datagram_t* datagram = &udp_data_ind_batch->datagrams[i];
+        rc = nwGtpv2cProcessUdpReq(
+            s11_mme_stack_handle,
+            &udp_data_ind_batch->buffer[datagram->buffer_offset],
+            datagram->buffer_length, udp_data_ind_batch->local_port,
+            datagram->peer_port, (struct sockaddr*)&datagram->sock_addr);
+        DevAssert(rc == NW_OK);
+      }
+    } break;
+
     default:
       OAILOG_ERROR(LOG_S11, "Unknown message ID %d:%s\n",
                    ITTI_MSG_ID(received_message_p),
@@ -321,9 +340,7 @@ static void* s11_mme_thread(void* args) {
    * Set UDP entity
    */
   udp.hUdp = (nw_gtpv2c_udp_handle_t)NULL;
-  mme_config_read_lock(&mme_config);
   udp.gtpv2cStandardPort = mme_config.ip.port_s11;
-  mme_config_unlock(&mme_config);
   udp.udpDataReqCallback = s11_mme_send_udp_msg;
   DevAssert(NW_OK == nwGtpv2cSetUdpEntity(s11_mme_stack_handle, &udp));
   /*
@@ -43,6 +43,7 @@ extern "C" {
 #endif
 #include "lte/gateway/c/core/oai/tasks/s1ap/s1ap_mme.hpp"
 #include "lte/gateway/c/core/oai/tasks/s1ap/s1ap_mme_decoder.hpp"
+#include "lte/gateway/c/core/oai/tasks/s1ap/s1ap_mme_decoder_pool.hpp"
 #include "S1ap_TimeToWait.h"
 #include "asn_internal.h"
 #include "lte/gateway/c/core/common/common_defs.h"
@@ -70,6 +71,10 @@ bool s1ap_congestion_control_enabled = true;
 long s1ap_last_msg_latency = 0;
 long s1ap_zmq_th = LONG_MAX;
 
+static uint32_t s1ap_decoder_threads = 0;
+// Set when the received PDUs are decoded on worker threads
+static std::unique_ptr<magma::lte::S1apDecoderPool> s1ap_decoder_pool;
+
 //------------------------------------------------------------------------------
 static int s1ap_send_init_sctp(void) {
   // Create and alloc new message
@@ -100,9 +105,10 @@ static int s1ap_send_init_sctp(void) {
   return send_msg_to_task(&s1ap_task_zmq_ctx, TASK_SCTP, message_p);
 }
 
-static int handle_message(zloop_t* loop, zsock_t* reader, void* arg) {
+// decoded_pdu is the PDU of an SCTP_DATA_IND decoded by s1ap_decoder_pool
+static void process_message(MessageDef* received_message_p,
+                            S1ap_S1AP_PDU_t* decoded_pdu) {
   s1ap_state_t* state;
-  MessageDef* received_message_p = receive_msg(reader);
   imsi64_t imsi64 = itti_get_associated_imsi(received_message_p);
   state = get_s1ap_state(false);
   AssertFatal(state != NULL, "failed to retrieve s1ap state (was null)");
@@ -133,16 +139,23 @@ static int handle_message(zloop_t* loop, zsock_t* reader, void* arg) {
        * * * * Decode and handle it.
        */
       S1ap_S1AP_PDU_t pdu = {S1ap_S1AP_PDU_PR_NOTHING, {0}};
-
-      // Invoke S1AP message decoder
-      if (s1ap_mme_decode_pdu(&pdu, SCTP_DATA_IND(received_message_p).payload) <
-          0) {
+      S1ap_S1AP_PDU_t* pdu_p = decoded_pdu;
+
+      // Invoke S1AP message decoder, unless a worker already did
+      if (!s1ap_decoder_pool) {
+        if (s1ap_mme_decode_pdu(
+                &pdu, SCTP_DATA_IND(received_message_p).payload) == RETURNok) {
+          pdu_p = &pdu;
+        }
+      }
+      if (pdu_p == NULL) {
         // TODO: Notify eNB of failure with right cause
         OAILOG_ERROR(LOG_S1AP, "Failed to decode new buffer\n");
       } else {
         s1ap_mme_handle_message(state,
                                 SCTP_DATA_IND(received_message_p).assoc_id,
-                                SCTP_DATA_IND(received_message_p).stream, &pdu);
+                                SCTP_DATA_IND(received_message_p).stream,
+                                pdu_p);
       }
 
       // Free received PDU array
@@ -304,15 +317,63 @@ static int handle_message(zloop_t* loop, zsock_t* reader, void* arg) {
 
   itti_free_msg_content(received_message_p);
   free(received_message_p);
+}
+
+static int handle_message(zloop_t* loop, zsock_t* reader, void* arg) {
+  MessageDef* received_message_p = receive_msg(reader);
+
+  if (s1ap_decoder_pool) {
+    // The events of an association keep their order through its worker
+    switch (ITTI_MSG_ID(received_message_p)) {
+      case SCTP_DATA_IND:
+        s1ap_decoder_pool->dispatch(SCTP_DATA_IND(received_message_p).assoc_id,
+                                    received_message_p);
+        return 0;
+      case SCTP_NEW_ASSOCIATION:
+        s1ap_decoder_pool->dispatch(
+            received_message_p->ittiMsg.sctp_new_peer.assoc_id,
+            received_message_p);
+        return 0;
+      case SCTP_CLOSE_ASSOCIATION:
+        s1ap_decoder_pool->dispatch(
+            SCTP_CLOSE_ASSOCIATION(received_message_p).assoc_id,
+            received_message_p);
+        return 0;
+      default:
+        break;
+    }
+  }
+  process_message(received_message_p, NULL);
+  return 0;
+}
+
+static int handle_decoded_pdus(zloop_t* loop, zmq_pollitem_t* item,
+                               void* arg) {
+  s1ap_decoder_pool->process_decoded();
   return 0;
 }
 
+static void start_decoder_pool(void) {
+  if (s1ap_decoder_threads == 0) {
+    return;
+  }
+  s1ap_decoder_pool = std::make_unique<magma::lte::S1apDecoderPool>(
+      s1ap_decoder_threads, process_message);
+  zmq_pollitem_t item = {NULL, s1ap_decoder_pool->event_fd(), ZMQ_POLLIN, 0};
+  int rc = zloop_poller(s1ap_task_zmq_ctx.event_loop, &item,
+                        handle_decoded_pdus, NULL);
+  AssertFatal(rc == 0, "Failed to poll the S1AP decoder pool");
+  OAILOG_INFO(LOG_S1AP, "Decoding S1AP PDUs on %u threads\n",
+              s1ap_decoder_threads);
+}
+
 //------------------------------------------------------------------------------
 static void* s1ap_mme_thread(__attribute__((unused)) void* args) {
   itti_mark_task_ready(TASK_S1AP);
   const task_id_t peer_task_ids[] = {TASK_MME_APP, TASK_SCTP, TASK_SERVICE303};
   init_task_context(TASK_S1AP, peer_task_ids, 3, handle_message,
                     &s1ap_task_zmq_ctx);
+  start_decoder_pool();
 
   if (s1ap_send_init_sctp() < 0) {
     OAILOG_ERROR(LOG_S1AP, "Error while sendind SCTP_INIT_MSG to SCTP \n");
@@ -336,6 +397,7 @@ extern "C" status_code_e s1ap_mme_init(const mme_config_t* mme_config_p) {
 
   s1ap_congestion_control_enabled = mme_config_p->enable_congestion_control;
   s1ap_zmq_th = mme_config_p->s1ap_zmq_th;
+  s1ap_decoder_threads = mme_config_p->s1ap_config.decoder_threads;
 
   // Initialize global stats timer
   epc_stats_timer_sec = (size_t)mme_config_p->stats_timer_sec;
@@ -359,6 +421,7 @@ extern "C" status_code_e s1ap_mme_init(const mme_config_t* mme_config_p) {
 void s1ap_mme_exit(void) {
   OAILOG_DEBUG(LOG_S1AP, "Cleaning S1AP\n");
   stop_timer(&s1ap_task_zmq_ctx, epc_stats_timer_id);
+  s1ap_decoder_pool.reset();
 
   put_s1ap_state();
   put_s1ap_imsi_map();
@@ -0,0 +1,144 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the terms found in the LICENSE file in the root of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#include <stdlib.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <utility>
+
+// The C headers go first, s1ap_common.hpp redeclares some of their globals
+extern "C" {
+#include "lte/gateway/c/core/common/assertions.h"
+#include "lte/gateway/c/core/oai/common/itti_free_defined_msg.h"
+#include "lte/gateway/c/core/oai/common/log.h"
+#include "lte/gateway/c/core/oai/lib/itti/intertask_interface.h"
+}
+
+#include "lte/gateway/c/core/oai/tasks/s1ap/s1ap_mme_decoder.hpp"
+#include "lte/gateway/c/core/oai/tasks/s1ap/s1ap_mme_decoder_pool.hpp"
+
+namespace magma {
+namespace lte {
+
+S1apDecoderPool::S1apDecoderPool(uint32_t num_workers, Handler handler)
+    : handler_(std::move(handler)) {
+  event_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  AssertFatal(event_fd_ != -1, "Failed to create the S1AP decoder eventfd");
+  for (uint32_t i = 0; i < num_workers; i++) {
+    auto worker = std::make_unique<Worker>();
+    worker->thread = std::thread(&S1apDecoderPool::run, this, worker.get());
+    pthread_setname_np(worker->thread.native_handle(), "S1AP_DECODER");
+    workers_.push_back(std::move(worker));
+  }
+}
+
+S1apDecoderPool::~S1apDecoderPool() {
+  for (auto& worker : workers_) {
+    {
+      std::lock_guard<std::mutex> lock(worker->mutex);
+      worker->stopping = true;
+    }
+    worker->queued.notify_one();
+  }
+  for (auto& worker : workers_) {
+    worker->thread.join();
+    for (MessageDef* message : worker->queue) {
+      itti_free_msg_content(message);
+      free(message);
+    }
+  }
+  for (auto& event : decoded_) {
+    free_event(&event);
+  }
+  close(event_fd_);
+}
+
+void S1apDecoderPool::dispatch(sctp_assoc_id_t assoc_id,
+                               MessageDef* message) {
+  Worker& worker = *workers_[assoc_id % workers_.size()];
+  {
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.queue.push_back(message);
+  }
+  worker.queued.notify_one();
+}
+
+void S1apDecoderPool::process_decoded() {
+  uint64_t count;
+  // Reset the eventfd before draining, a worker may add events meanwhile
+  if (read(event_fd_, &count, sizeof(count)) != sizeof(count)) {
+    return;
+  }
+  std::deque<Event> events;
+  {
+    std::lock_guard<std::mutex> lock(decoded_mutex_);
+    events.swap(decoded_);
+  }
+  for (auto& event : events) {
+    handler_(event.message, event.decoded ? &event.pdu : nullptr);
+    ASN_STRUCT_FREE_CONTENTS_ONLY(asn_DEF_S1ap_S1AP_PDU, &event.pdu);
+  }
+}
+
+void S1apDecoderPool::run(Worker* worker) {
+  std::deque<MessageDef*> batch;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(worker->mutex);
+      worker->queued.wait(lock, [worker] {
+        return !worker->queue.empty() || worker->stopping;
+      });
+      if (worker->stopping) {
+        return;
+      }
+      batch.swap(worker->queue);
+    }
+
+    std::deque<Event> events;
+    for (MessageDef* message : batch) {
+      Event event = {message, {S1ap_S1AP_PDU_PR_NOTHING, {0}}, false};
+      if (ITTI_MSG_ID(message) == SCTP_DATA_IND) {
+        event.decoded = s1ap_mme_decode_pdu(
+                            &event.pdu, SCTP_DATA_IND(message).payload) ==
+                        RETURNok;
+      }
+      events.push_back(event);
+    }
+    batch.clear();
+
+    {
+      std::lock_guard<std::mutex> lock(decoded_mutex_);
+      for (auto& event : events) {
+        decoded_.push_back(event);
+      }
+    }
+    uint64_t one = 1;
+    if (write(event_fd_, &one, sizeof(one)) != sizeof(one)) {
+      OAILOG_ERROR(LOG_S1AP, "Failed to signal decoded S1AP PDUs\n");
+    }
+  }
+}
+
+void S1apDecoderPool::free_event(Event* event) {
+  ASN_STRUCT_FREE_CONTENTS_ONLY(asn_DEF_S1ap_S1AP_PDU, &event->pdu);
+  itti_free_msg_content(event->message);
+  free(event->message);
+}
+
+}  // namespace lte
+}  // namespace magma
@@ -0,0 +1,111 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the terms found in the LICENSE file in the root of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+/*! \file s1ap_mme_decoder_pool.hpp
+ * \brief APER decoding of the received S1AP PDUs on worker threads
+ *
+ * The S1AP state is only accessed from the S1AP task thread, the workers
+ * only decode. Each SCTP association is pinned to one worker and the
+ * association events (new association, data, close) all go through it, so
+ * the S1AP task handles the events of one eNB in the order SCTP sent them.
+ * The events of different eNBs may be reordered.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include "lte/gateway/c/core/oai/lib/itti/intertask_interface_types.h"
+}
+
+#include "lte/gateway/c/core/oai/include/sctp_messages_types.h"
+#include "lte/gateway/c/core/oai/tasks/s1ap/s1ap_common.hpp"
+
+namespace magma {
+namespace lte {
+
+class S1apDecoderPool {
+ public:
+  /**
+   * Called on the task thread for each event, in the order of the
+   * association. pdu is the decoded PDU of an SCTP_DATA_IND, NULL for the
+   * other events or when the decoding failed. The handler owns the message,
+   * the PDU contents are freed after it returns.
+   */
+  using Handler =
+      std::function<void(MessageDef* message, S1ap_S1AP_PDU_t* pdu)>;
+
+  S1apDecoderPool(uint32_t num_workers, Handler handler);
+  // Drops the events not handled yet
+  ~S1apDecoderPool();
+
+  S1apDecoderPool(const S1apDecoderPool&) = delete;
+  S1apDecoderPool& operator=(const S1apDecoderPool&) = delete;
+
+  /**
+   * Takes an SCTP_NEW_ASSOCIATION, SCTP_DATA_IND or SCTP_CLOSE_ASSOCIATION
+   * message from the task thread
+   */
+  void dispatch(sctp_assoc_id_t assoc_id, MessageDef* message);
+
+  /**
+   * Readable when decoded events are waiting, for the event loop of the task
+   * thread
+   */
+  int event_fd() const { return event_fd_; }
+
+  // Passes the decoded events to the handler, on the task thread
+  void process_decoded();
+
+  uint32_t num_workers() const { return workers_.size(); }
+
+ private:
+  struct Event {
+    MessageDef* message;
+    S1ap_S1AP_PDU_t pdu;
+    bool decoded;
+  };
+
+  struct Worker {
+    std::mutex mutex;
+    std::condition_variable queued;
+    std::deque<MessageDef*> queue;
+    bool stopping = false;
+    std::thread thread;
+  };
+
+  void run(Worker* worker);
+  static void free_event(Event* event);
+
+  Handler handler_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  int event_fd_;
+  // Decoded events, in the order each worker finished them
+  std::mutex decoded_mutex_;
+  std::deque<Event> decoded_;
+};
+
+}  // namespace lte
+}  // namespace magma
@@ -759,20 +759,20 @@ status_code_e s1ap_generate_s1_setup_response(
   servedGUMMEI = reinterpret_cast<S1ap_ServedGUMMEIsItem_t*>(
       calloc(1, sizeof *servedGUMMEI));
 
-  mme_config_read_lock(&mme_config);
+  const mme_config_t* config = mme_config_get();
   /*
    * Use the gummei parameters provided by configuration
    * that should be sorted
    */
-  for (i = 0; i < mme_config.served_tai.nb_tai; i++) {
+  for (i = 0; i < config->served_tai.nb_tai; i++) {
     bool plmn_added = false;
     for (j = 0; j < i; j++) {
-      if ((mme_config.served_tai.plmn_mcc[j] ==
-           mme_config.served_tai.plmn_mcc[i]) &&
-          (mme_config.served_tai.plmn_mnc[j] ==
-           mme_config.served_tai.plmn_mnc[i]) &&
-          (mme_config.served_tai.plmn_mnc_len[j] ==
-           mme_config.served_tai.plmn_mnc_len[i])) {
+      if ((config->served_tai.plmn_mcc[j] ==
+           config->served_tai.plmn_mcc[i]) &&
+          (config->served_tai.plmn_mnc[j] ==
+           config->served_tai.plmn_mnc[i]) &&
+          (config->served_tai.plmn_mnc_len[j] ==
+           config->served_tai.plmn_mnc_len[i])) {
         plmn_added = true;
         break;
       }
@@ -780,9 +780,9 @@ status_code_e s1ap_generate_s1_setup_response(
     if (false == plmn_added) {
       S1ap_PLMNidentity_t* plmn = NULL;
       plmn = reinterpret_cast<S1ap_PLMNidentity_t*>(calloc(1, sizeof(*plmn)));
-      MCC_MNC_TO_PLMNID(mme_config.served_tai.plmn_mcc[i],
-                        mme_config.served_tai.plmn_mnc[i],
-                        mme_config.served_tai.plmn_mnc_len[i], plmn);
+      MCC_MNC_TO_PLMNID(config->served_tai.plmn_mcc[i],
+                        config->served_tai.plmn_mnc[i],
+                        config->served_tai.plmn_mnc_len[i], plmn);
       ASN_SEQUENCE_ADD(&servedGUMMEI->servedPLMNs.list, plmn);
     }
   }
@@ -810,7 +810,6 @@ status_code_e s1ap_generate_s1_setup_response(
   ie->value.choice.RelativeMMECapacity = mme_config.relative_capacity;
   ASN_SEQUENCE_ADD(&out->protocolIEs.list, ie);
 
-  mme_config_unlock(&mme_config);
   /*
    * The MME is only serving E-UTRAN RAT, so the list contains only one element
    */
@@ -1030,7 +1029,7 @@ status_code_e s1ap_mme_handle_initial_context_setup_response(
   } else {
     OAILOG_FUNC_RETURN(LOG_S1AP, RETURNerror);
   }
-  ue_ref_p->s1_ue_state = S1AP_UE_CONNECTED;
+  s1ap_set_ue_state(ue_ref_p, S1AP_UE_CONNECTED);
   message_p = DEPRECATEDitti_alloc_new_message_fatal(
       TASK_S1AP, MME_APP_INITIAL_CONTEXT_SETUP_RSP);
   MME_APP_INITIAL_CONTEXT_SETUP_RSP(message_p).ue_id = ue_ref_p->mme_ue_s1ap_id;
@@ -1425,6 +1424,7 @@ status_code_e s1ap_mme_generate_ue_context_release_command(
     ue_ref_p->s1ap_ue_context_rel_timer.id = s1ap_start_timer(
         ue_ref_p->s1ap_ue_context_rel_timer.msec, TIMER_REPEAT_ONCE,
         handle_ue_context_rel_timer_expiry, mme_ue_s1ap_id);
+    UE_STATE_MARK_DIRTY(ue_ref_p);
   } else {
     // Remove UE context and inform MME_APP.
     s1ap_mme_release_ue_context(state, ue_ref_p, imsi64);
@@ -2282,6 +2282,7 @@ status_code_e s1ap_mme_handle_handover_failure(s1ap_state_t* state,
     // state.
     ue_ref_p->s1_ue_state = S1AP_UE_CONNECTED;
     ue_ref_p->s1ap_handover_state = (struct s1ap_handover_state_s){0};
+    UE_STATE_MARK_DIRTY(ue_ref_p);
   } else {
     // Not a failure, but nothing for us to do.
     OAILOG_INFO(
@@ -2443,6 +2444,7 @@ status_code_e s1ap_mme_handle_handover_cancel(s1ap_state_t* state,
       bdestroy_wrapper(&e_rab_admitted_list.item[i].transport_layer_address);
     }
     ue_ref_p->s1ap_handover_state = (struct s1ap_handover_state_s){0};
+    UE_STATE_MARK_DIRTY(ue_ref_p);
   } else {
     // Not a failure, but nothing for us to do.
     OAILOG_INFO(
@@ -2549,6 +2551,7 @@ status_code_e s1ap_mme_handle_handover_request(
       target_enb->next_sctp_stream;
   ue_ref_p->s1ap_handover_state.source_sctp_stream_send =
       ue_ref_p->sctp_stream_send;
+  UE_STATE_MARK_DIRTY(ue_ref_p);
 
   // Build and send PDU
   pdu.present = S1ap_S1AP_PDU_PR_initiatingMessage;
@@ -3000,6 +3003,7 @@ status_code_e s1ap_mme_handle_handover_command(
       ho_command_p->tgt_enb_ue_s1ap_id;
   ue_ref_p->s1ap_handover_state.source_enb_ue_s1ap_id =
       ue_ref_p->enb_ue_s1ap_id;
+  UE_STATE_MARK_DIRTY(ue_ref_p);
 
   OAILOG_INFO(LOG_S1AP, "Handover Command received");
   pdu.present = S1ap_S1AP_PDU_PR_successfulOutcome;
@@ -4512,7 +4516,6 @@ status_code_e s1ap_handle_paging_request(
   ASN_SEQUENCE_ADD(&out->protocolIEs.list, ie);
   S1ap_TAIList_t* const tai_list = &ie->value.choice.TAIList;
 
-  mme_config_read_lock(&mme_config);
   for (int tai_idx = 0; tai_idx < tai_list_count; tai_idx++) {
     num_of_tac = paging_request->paging_tai_list[tai_idx].numoftac;
     // Total number of TACs = number of tac + current ENB's tac(1)
@@ -4538,8 +4541,6 @@ status_code_e s1ap_handle_paging_request(
     }
   }
 
-  mme_config_unlock(&mme_config);
-
   // Encoding without allocating, buffer_p is allocated by asn.1c
   int err = 0;
   if (s1ap_mme_encode_pdu(&pdu, &buffer_p, &length) < 0) {
@@ -548,7 +548,7 @@ status_code_e s1ap_generate_downlink_nas_transport(
           "in S1AP_UE_WAITING_CRR, so dropping the DownlinkNASTransport \n");
       OAILOG_FUNC_RETURN(LOG_S1AP, RETURNerror);
     } else {
-      ue_ref->s1_ue_state = S1AP_UE_CONNECTED;
+      s1ap_set_ue_state(ue_ref, S1AP_UE_CONNECTED);
     }
     /*
      * Setting UE informations with the ones found in ue_ref
@@ -656,7 +656,7 @@ status_code_e s1ap_generate_s1ap_e_rab_setup_req(
     pdu.choice.initiatingMessage.value.present =
         S1ap_InitiatingMessage__value_PR_E_RABSetupRequest;
     out = &pdu.choice.initiatingMessage.value.choice.E_RABSetupRequest;
-    ue_ref->s1_ue_state = S1AP_UE_CONNECTED;
+    s1ap_set_ue_state(ue_ref, S1AP_UE_CONNECTED);
     /*
      * Setting UE information with the ones found in ue_ref
      */
@@ -1205,6 +1205,7 @@ void s1ap_handle_mme_ue_id_notification(
         return;
       }
       ue_ref->mme_ue_s1ap_id = mme_ue_s1ap_id;
+      UE_STATE_MARK_DIRTY(ue_ref);
       hashtable_rc_t h_rc = hashtable_ts_insert(
           &state->mmeid2associd, (const hash_key_t)mme_ue_s1ap_id,
           (void*)(uintptr_t)sctp_assoc_id);
@@ -1306,7 +1307,7 @@ status_code_e s1ap_generate_s1ap_e_rab_rel_cmd(
     ie->value.present = S1ap_E_RABReleaseCommandIEs__value_PR_ENB_UE_S1AP_ID;
     ie->value.choice.ENB_UE_S1AP_ID = ue_ref->enb_ue_s1ap_id;
     ASN_SEQUENCE_ADD(&out->protocolIEs.list, ie);
-    ue_ref->s1_ue_state = S1AP_UE_CONNECTED;
+    s1ap_set_ue_state(ue_ref, S1AP_UE_CONNECTED);
 
     ie = (S1ap_E_RABReleaseCommandIEs_t*)calloc(
         1, sizeof(S1ap_E_RABReleaseCommandIEs_t));
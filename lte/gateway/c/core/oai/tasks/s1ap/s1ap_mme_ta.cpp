@@ -52,26 +52,23 @@ static int s1ap_mme_compare_plmn(const S1ap_PLMNidentity_t* const plmn) {
 
   DevAssert(plmn != NULL);
   TBCD_TO_MCC_MNC(plmn, mcc, mnc, mnc_len);
-  mme_config_read_lock(&mme_config);
+  const served_tai_t* served_tai = &mme_config_get()->served_tai;
 
-  for (i = 0; i < mme_config.served_tai.nb_tai; i++) {
+  for (i = 0; i < served_tai->nb_tai; i++) {
     OAILOG_TRACE(
         LOG_S1AP,
         "Comparing plmn_mcc %d/%d, plmn_mnc %d/%d plmn_mnc_len %d/%d\n",
-        mme_config.served_tai.plmn_mcc[i], mcc,
-        mme_config.served_tai.plmn_mnc[i], mnc,
-        mme_config.served_tai.plmn_mnc_len[i], mnc_len);
+        served_tai->plmn_mcc[i], mcc, served_tai->plmn_mnc[i], mnc,
+        served_tai->plmn_mnc_len[i], mnc_len);
 
-    if ((mme_config.served_tai.plmn_mcc[i] == mcc) &&
-        (mme_config.served_tai.plmn_mnc[i] == mnc) &&
-        (mme_config.served_tai.plmn_mnc_len[i] == mnc_len))
+    if ((served_tai->plmn_mcc[i] == mcc) && (served_tai->plmn_mnc[i] == mnc) &&
+        (served_tai->plmn_mnc_len[i] == mnc_len))
       /*
        * There is a matching plmn
        */
       return TA_LIST_AT_LEAST_ONE_MATCH;
   }
 
-  mme_config_unlock(&mme_config);
   return TA_LIST_NO_MATCH;
 }
 
@@ -105,17 +102,15 @@ static int s1ap_mme_compare_tac(const S1ap_TAC_t* const tac) {
 
   DevAssert(tac != NULL);
   OCTET_STRING_TO_TAC(tac, tac_value);
-  mme_config_read_lock(&mme_config);
+  const served_tai_t* served_tai = &mme_config_get()->served_tai;
 
-  for (i = 0; i < mme_config.served_tai.nb_tai; i++) {
+  for (i = 0; i < served_tai->nb_tai; i++) {
     OAILOG_TRACE(LOG_S1AP, "Comparing config tac %d, received tac = %d\n",
-                 mme_config.served_tai.tac[i], tac_value);
+                 served_tai->tac[i], tac_value);
 
-    if (mme_config.served_tai.tac[i] == tac_value)
-      return TA_LIST_AT_LEAST_ONE_MATCH;
+    if (served_tai->tac[i] == tac_value) return TA_LIST_AT_LEAST_ONE_MATCH;
   }
 
-  mme_config_unlock(&mme_config);
   return TA_LIST_NO_MATCH;
 }
 
@@ -135,6 +135,14 @@ bool s1ap_ue_compare_by_imsi(__attribute__((unused)) const hash_key_t keyP,
   return false;
 }
 
+void s1ap_set_ue_state(ue_description_t* ue_ref,
+                       enum s1_ue_state_s s1_ue_state) {
+  if (ue_ref->s1_ue_state != s1_ue_state) {
+    ue_ref->s1_ue_state = s1_ue_state;
+    UE_STATE_MARK_DIRTY(ue_ref);
+  }
+}
+
 hash_table_ts_t* get_s1ap_ue_state(void) {
   return S1apStateManager::getInstance().get_ue_state_ht();
 }
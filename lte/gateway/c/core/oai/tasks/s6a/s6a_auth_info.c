@@ -164,7 +164,7 @@ static inline int s6a_parse_authentication_info_avp(
 
     switch (hdr->avp_code) {
       case AVP_CODE_E_UTRAN_VECTOR: {
-        DevAssert(MAX_EPS_AUTH_VECTORS > authentication_info->nb_of_vectors);
+        DevAssert(MAX_AUTH_INFO_VECTORS > authentication_info->nb_of_vectors);
         CHECK_FCT(s6a_parse_e_utran_vector(
             avp, &authentication_info
                       ->eutran_vector[authentication_info->nb_of_vectors]));
@@ -328,7 +328,6 @@ status_code_e s6a_generate_authentication_info_req(s6a_auth_info_req_t* air_p) {
    * Add Origin_Host & Origin_Realm
    */
   CHECK_FCT(fd_msg_add_origin(msg, 0));
-  mme_config_read_lock(&mme_config);
   /*
    * Destination Host
    */
@@ -350,7 +349,6 @@ status_code_e s6a_generate_authentication_info_req(s6a_auth_info_req_t* air_p) {
     CHECK_FCT(fd_msg_avp_setvalue(avp, &value));
     CHECK_FCT(fd_msg_avp_add(msg, MSG_BRW_LAST_CHILD, avp));
   }
-  mme_config_unlock(&mme_config);
   /*
    * Adding the User-Name (IMSI)
    */
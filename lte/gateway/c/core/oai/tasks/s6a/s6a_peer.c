@@ -62,19 +62,9 @@ status_code_e s6a_fd_new_peer(void) {
 #if !S6A_OVER_GRPC
   int ret = 0;
 
-  if (mme_config_read_lock(&mme_config)) {
-    OAILOG_ERROR(LOG_S6A, "Failed to lock configuration for reading\n");
-    return RETURNerror;
-  }
-
   OAILOG_DEBUG(LOG_S6A, "Diameter identity of MME: %s with length: %zd\n",
                fd_g_config->cnf_diamid, fd_g_config->cnf_diamid_len);
   bstring hss_name = bstrcpy(mme_config.s6a_config.hss_host_name);
-
-  if (mme_config_unlock(&mme_config)) {
-    OAILOG_ERROR(LOG_S6A, "Failed to unlock configuration\n");
-    return RETURNerror;
-  }
   DiamId_t diamid = bdata(hss_name);
   size_t diamidlen = blength(hss_name);
   struct peer_hdr* peer = NULL;
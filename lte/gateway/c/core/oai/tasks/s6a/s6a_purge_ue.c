@@ -200,7 +200,6 @@ status_code_e s6a_generate_purge_ue_req(const char* imsi) {
    * Add Origin_Host & Origin_Realm
    */
   CHECK_FCT(fd_msg_add_origin(msg_p, 0));
-  mme_config_read_lock(&mme_config);
   /*
    * Destination Host
    */
@@ -223,7 +222,6 @@ status_code_e s6a_generate_purge_ue_req(const char* imsi) {
     CHECK_FCT(fd_msg_avp_setvalue(avp_p, &value));
     CHECK_FCT(fd_msg_avp_add(msg_p, MSG_BRW_LAST_CHILD, avp_p));
   }
-  mme_config_unlock(&mme_config);
   /*
    * Adding the User-Name (IMSI)
    */
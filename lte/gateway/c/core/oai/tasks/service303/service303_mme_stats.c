@@ -30,6 +30,10 @@ void service303_mme_app_statistics_read(
   set_gauge("s1u_bearers", stats_msg_p->nb_s1u_bearers, label);
   set_gauge("mme_app_last_msg_latency",
             stats_msg_p->nb_mme_app_last_msg_latency, label);
+  set_gauge("bulk_signalling_ues_pending",
+            stats_msg_p->nb_bulk_signalling_ues_pending, label);
+  set_gauge("bulk_signalling_ues_processed",
+            stats_msg_p->nb_bulk_signalling_ues_processed, label);
 }
 
 void service303_s1ap_statistics_read(
@@ -45,6 +45,17 @@
 #include "lte/gateway/c/core/oai/lib/bstr/bstrlib.h"
 #include "lte/gateway/c/core/oai/lib/hashtable/hashtable.h"
 #include "lte/gateway/c/core/oai/lib/itti/intertask_interface_types.h"
+#include "lte/gateway/c/core/oai/tasks/sgw/pgw_pcef_emulation_nft.h"
+
+// SDF marks are installed with nftables when the kernel supports it, with
+// iptables commands otherwise
+static bool pcef_nft_enabled = false;
+// PCC rules whose marks were installed with nftables, removed the same way
+static bool pcef_nft_rules[SDF_ID_MAX];
+
+static void pgw_pcef_emulation_mark_sdf_filter(
+    sdf_filter_t* sdf_f, sdf_id_t sdf_id, const pgw_config_t* pgw_config_p,
+    const char* iptables_op);
 
 /*
  * Function that adds predefined PCC rules to PGW struct,
@@ -339,6 +350,12 @@ status_code_e pgw_pcef_emulation_init(spgw_state_t* state_p,
     }
   }
 
+  pcef_nft_enabled = (RETURNok == pgw_pcef_emulation_nft_init());
+  if (!pcef_nft_enabled) {
+    OAILOG_WARNING(LOG_SPGW_APP,
+                   "nftables not available, using iptables for SDF marking\n");
+  }
+
   for (int i = 0; i < (SDF_ID_MAX - 1); i++) {
     if (pgw_config_p->pcef.preload_static_sdf_identifiers[i]) {
       pgw_pcef_emulation_apply_rule(
@@ -369,6 +386,13 @@ void pgw_pcef_emulation_apply_rule(spgw_state_t* state_p, const sdf_id_t sdf_id,
     if (!pcc_rule->is_activated) {
       OAILOG_INFO(LOG_SPGW_APP, "Loading PCC rule %s\n", bdata(pcc_rule->name));
       pcc_rule->is_activated = true;
+      pcef_nft_rules[sdf_id] =
+          pcef_nft_enabled &&
+          (RETURNok ==
+           pgw_pcef_emulation_nft_apply_rule(pcc_rule, pgw_config_p));
+      if (pcef_nft_rules[sdf_id]) {
+        return;
+      }
       for (int sdff_i = 0;
            sdff_i < pcc_rule->sdf_template.number_of_packet_filters; sdff_i++) {
         pgw_pcef_emulation_apply_sdf_filter(
@@ -379,10 +403,54 @@ void pgw_pcef_emulation_apply_rule(spgw_state_t* state_p, const sdf_id_t sdf_id,
   }
 }
 
+//------------------------------------------------------------------------------
+void pgw_pcef_emulation_remove_rule(spgw_state_t* state_p,
+                                    const sdf_id_t sdf_id,
+                                    const pgw_config_t* const pgw_config_p) {
+  pcc_rule_t* pcc_rule = NULL;
+  hashtable_rc_t hrc = hashtable_ts_get(
+      state_p->deactivated_predefined_pcc_rules, sdf_id, (void**)&pcc_rule);
+
+  if ((HASH_TABLE_OK == hrc) && pcc_rule->is_activated) {
+    OAILOG_INFO(LOG_SPGW_APP, "Unloading PCC rule %s\n", bdata(pcc_rule->name));
+    pcc_rule->is_activated = false;
+    if (pcef_nft_rules[sdf_id]) {
+      pcef_nft_rules[sdf_id] = false;
+      if (RETURNok != pgw_pcef_emulation_nft_remove_rule(pcc_rule)) {
+        OAILOG_ERROR(LOG_SPGW_APP, "Failed to remove the marks of %s\n",
+                     bdata(pcc_rule->name));
+      }
+      return;
+    }
+    for (int sdff_i = 0;
+         sdff_i < pcc_rule->sdf_template.number_of_packet_filters; sdff_i++) {
+      pgw_pcef_emulation_mark_sdf_filter(
+          &pcc_rule->sdf_template.sdf_filter[sdff_i], pcc_rule->sdf_id,
+          pgw_config_p, "-D");
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void pgw_pcef_emulation_exit(spgw_state_t* state_p,
+                             const pgw_config_t* const pgw_config_p) {
+  for (int sdf_id = 0; sdf_id < SDF_ID_MAX; sdf_id++) {
+    pgw_pcef_emulation_remove_rule(state_p, (sdf_id_t)sdf_id, pgw_config_p);
+  }
+}
+
 //------------------------------------------------------------------------------
 void pgw_pcef_emulation_apply_sdf_filter(
     sdf_filter_t* const sdf_f, const sdf_id_t sdf_id,
     const pgw_config_t* const pgw_config_p) {
+  pgw_pcef_emulation_mark_sdf_filter(sdf_f, sdf_id, pgw_config_p, "-I");
+}
+
+//------------------------------------------------------------------------------
+// Adds (-I) or deletes (-D) the iptables rules of the mark of a filter
+static void pgw_pcef_emulation_mark_sdf_filter(
+    sdf_filter_t* const sdf_f, const sdf_id_t sdf_id,
+    const pgw_config_t* const pgw_config_p, const char* iptables_op) {
   if ((TRAFFIC_FLOW_TEMPLATE_BIDIRECTIONAL == sdf_f->direction) ||
       (TRAFFIC_FLOW_TEMPLATE_DOWNLINK_ONLY == sdf_f->direction)) {
     bstring filter = pgw_pcef_emulation_packet_filter_2_iptable_string(
@@ -393,16 +461,16 @@ void pgw_pcef_emulation_apply_sdf_filter(
          TRAFFIC_FLOW_TEMPLATE_IPV6_REMOTE_ADDR_FLAG) &
         sdf_f->packetfiltercontents.flags) {
       marking_command =
-          bformat("iptables -I POSTROUTING -t mangle  %s -j MARK --set-mark %d",
-                  bdata(filter), sdf_id);
+          bformat("iptables %s POSTROUTING -t mangle  %s -j MARK --set-mark %d",
+                  iptables_op, bdata(filter), sdf_id);
     } else {
       // marking_command = bformat("iptables -I PREROUTING -t mangle
       // --in-interface %s --dest %"PRIu8".%"PRIu8".%"PRIu8".%"PRIu8"/%"PRIu8"
       // %s -j MARK --set-mark %d",
       marking_command =
-          bformat("iptables -I POSTROUTING -t mangle  --dest %" PRIu8 ".%" PRIu8
+          bformat("iptables %s POSTROUTING -t mangle  --dest %" PRIu8 ".%" PRIu8
                   ".%" PRIu8 ".%" PRIu8 "/%" PRIu8 " %s -j MARK --set-mark %d",
-                  NIPADDR(pgw_config_p->ue_pool_addr[0].s_addr),
+                  iptables_op, NIPADDR(pgw_config_p->ue_pool_addr[0].s_addr),
                   pgw_config_p->ue_pool_mask[0], bdata(filter), sdf_id);
     }
     bdestroy_wrapper(&filter);
@@ -418,13 +486,13 @@ void pgw_pcef_emulation_apply_sdf_filter(
          TRAFFIC_FLOW_TEMPLATE_IPV6_REMOTE_ADDR_FLAG) &
         sdf_f->packetfiltercontents.flags) {
       marking_command =
-          bformat("iptables -I OUTPUT -t mangle  %s -j MARK --set-mark %d",
-                  bdata(filter), sdf_id);
+          bformat("iptables %s OUTPUT -t mangle  %s -j MARK --set-mark %d",
+                  iptables_op, bdata(filter), sdf_id);
     } else {
       marking_command =
-          bformat("iptables -I OUTPUT -t mangle  --dest %" PRIu8 ".%" PRIu8
+          bformat("iptables %s OUTPUT -t mangle  --dest %" PRIu8 ".%" PRIu8
                   ".%" PRIu8 ".%" PRIu8 "/%" PRIu8 " %s -j MARK --set-mark %d",
-                  NIPADDR(pgw_config_p->ue_pool_addr[0].s_addr),
+                  iptables_op, NIPADDR(pgw_config_p->ue_pool_addr[0].s_addr),
                   pgw_config_p->ue_pool_mask[0], bdata(filter), sdf_id);
     }
     bdestroy_wrapper(&filter);
@@ -509,9 +577,9 @@ bstring pgw_pcef_emulation_packet_filter_2_iptable_string(
   }
   if (TRAFFIC_FLOW_TEMPLATE_TYPE_OF_SERVICE_TRAFFIC_CLASS_FLAG &
       packetfiltercontents->flags) {
-    // TODO mask
-    bformata(bstr, " -m tos --tos 0x%02X",
-             packetfiltercontents->typdeofservice_trafficclass.value);
+    bformata(bstr, " -m tos --tos 0x%02X/0x%02X",
+             packetfiltercontents->typdeofservice_trafficclass.value,
+             packetfiltercontents->typdeofservice_trafficclass.mask);
   }
   if (TRAFFIC_FLOW_TEMPLATE_FLOW_LABEL_FLAG & packetfiltercontents->flags) {
     Fatal("TODO Implement pgw_pcef_emulation_packet_filter_2_iptable_string");
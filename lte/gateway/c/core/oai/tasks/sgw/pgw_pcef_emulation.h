@@ -39,6 +39,10 @@ status_code_e pgw_pcef_emulation_init(spgw_state_t* state_p,
                                       const pgw_config_t* pgw_config_p);
 void pgw_pcef_emulation_apply_rule(spgw_state_t* state_p, sdf_id_t sdf_id,
                                    const pgw_config_t* pgw_config_p);
+void pgw_pcef_emulation_remove_rule(spgw_state_t* state_p, sdf_id_t sdf_id,
+                                    const pgw_config_t* pgw_config_p);
+void pgw_pcef_emulation_exit(spgw_state_t* state_p,
+                             const pgw_config_t* pgw_config_p);
 void pgw_pcef_emulation_apply_sdf_filter(sdf_filter_t* sdf_f, sdf_id_t sdf_id,
                                          const pgw_config_t* pgw_config_p);
 bstring pgw_pcef_emulation_packet_filter_2_iptable_string(
@@ -0,0 +1,522 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the terms found in the LICENSE file in the root of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+/*! \file pgw_pcef_emulation_nft.c
+  \brief Installs the SDF marks of the PCEF emulation with nf_tables netlink
+  transactions, instead of one iptables process per mark. The rules are the
+  translation of the iptables rules of pgw_pcef_emulation_apply_sdf_filter,
+  in a chain per PCC rule of a table owned by the PGW. The base chains jump
+  to the chain of every PCC rule applied since init, so that removing the
+  marks of a PCC rule only flushes its chain.
+  */
+
+#include "lte/gateway/c/core/oai/tasks/sgw/pgw_pcef_emulation_nft.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <libmnl/libmnl.h>
+#include <linux/netfilter.h>
+#include <linux/netfilter/nf_tables.h>
+#include <linux/netfilter/nfnetlink.h>
+#include <netinet/in.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "lte/gateway/c/core/common/dynamic_memory_check.h"
+#include "lte/gateway/c/core/oai/common/log.h"
+#include "lte/gateway/c/core/oai/lib/bstr/bstrlib.h"
+
+#define PCEF_NFT_TABLE "magma_pcef"
+#define PCEF_NFT_CHAIN_POSTROUTING "postrouting"
+#define PCEF_NFT_CHAIN_OUTPUT "output"
+#define PCEF_NFT_CHAIN_SDF_FORMAT "sdf_%d"
+#define PCEF_NFT_CHAIN_NAME_SIZE 16
+// Priority of the iptables mangle table
+#define PCEF_NFT_PRIORITY_MANGLE (-150)
+#define PCEF_NFT_BATCH_LIMIT (32 * 1024)
+
+// Header fields matched by the packet filters
+#define IPV4_TOS_OFFSET 1
+#define IPV4_PROTOCOL_OFFSET 9
+#define IPV4_SADDR_OFFSET 12
+#define IPV4_DADDR_OFFSET 16
+#define L4_SPORT_OFFSET 0
+#define L4_DPORT_OFFSET 2
+#define ESP_SPI_OFFSET 0
+
+typedef struct pcef_nft_batch_s {
+  char* buf;
+  struct mnl_nlmsg_batch* batch;
+  // Last nf_tables message of the batch, the only one acked by the kernel
+  struct nlmsghdr* last;
+  uint32_t seq;
+} pcef_nft_batch_t;
+
+// Chains of the PCC rules that the base chains jump to, since init
+static bool pcef_nft_sdf_chain_linked[SDF_ID_MAX];
+// Sends the transactions, NULL for the netfilter netlink socket
+static pgw_pcef_emulation_nft_send_t pcef_nft_send = NULL;
+
+//------------------------------------------------------------------------------
+void pgw_pcef_emulation_nft_set_send(pgw_pcef_emulation_nft_send_t send) {
+  pcef_nft_send = send;
+}
+
+//------------------------------------------------------------------------------
+static struct nlmsghdr* pcef_nft_put_msg(pcef_nft_batch_t* b, uint16_t type,
+                                         uint8_t family, uint16_t flags,
+                                         uint16_t res_id) {
+  struct nlmsghdr* nlh =
+      mnl_nlmsg_put_header(mnl_nlmsg_batch_current(b->batch));
+  nlh->nlmsg_type = type;
+  nlh->nlmsg_flags = NLM_F_REQUEST | flags;
+  nlh->nlmsg_seq = b->seq++;
+
+  struct nfgenmsg* nfg = mnl_nlmsg_put_extra_header(nlh, sizeof(*nfg));
+  nfg->nfgen_family = family;
+  nfg->version = NFNETLINK_V0;
+  nfg->res_id = htons(res_id);
+  return nlh;
+}
+
+//------------------------------------------------------------------------------
+static struct nlmsghdr* pcef_nft_put_nft_msg(pcef_nft_batch_t* b,
+                                             uint16_t msg_type,
+                                             uint16_t flags) {
+  b->last = pcef_nft_put_msg(b, (NFNL_SUBSYS_NFTABLES << 8) | msg_type,
+                             NFPROTO_IPV4, flags, 0);
+  return b->last;
+}
+
+//------------------------------------------------------------------------------
+static bool pcef_nft_batch_begin(pcef_nft_batch_t* b) {
+  memset(b, 0, sizeof(*b));
+  // Room for a full message past the limit, see mnl_nlmsg_batch_next
+  b->buf = calloc(1, PCEF_NFT_BATCH_LIMIT + MNL_SOCKET_BUFFER_SIZE);
+  if (!b->buf) {
+    return false;
+  }
+  b->batch = mnl_nlmsg_batch_start(b->buf, PCEF_NFT_BATCH_LIMIT);
+  b->seq = (uint32_t)time(NULL);
+  pcef_nft_put_msg(b, NFNL_MSG_BATCH_BEGIN, AF_UNSPEC, 0,
+                   NFNL_SUBSYS_NFTABLES);
+  return mnl_nlmsg_batch_next(b->batch);
+}
+
+//------------------------------------------------------------------------------
+static void pcef_nft_batch_free(pcef_nft_batch_t* b) {
+  if (b->batch) {
+    mnl_nlmsg_batch_stop(b->batch);
+    b->batch = NULL;
+  }
+  free_wrapper((void**)&b->buf);
+}
+
+//------------------------------------------------------------------------------
+// Sends the batch on a netfilter netlink socket and waits for its result
+static status_code_e pcef_nft_netlink_send(const void* batch, size_t len) {
+  struct mnl_socket* nl = mnl_socket_open(NETLINK_NETFILTER);
+  if (!nl) {
+    OAILOG_ERROR(LOG_SPGW_APP, "Failed to open netfilter netlink socket: %s\n",
+                 strerror(errno));
+    return RETURNerror;
+  }
+  status_code_e rc = RETURNerror;
+  if (mnl_socket_bind(nl, 0, MNL_SOCKET_AUTOPID) < 0) {
+    OAILOG_ERROR(LOG_SPGW_APP, "Failed to bind netfilter netlink socket: %s\n",
+                 strerror(errno));
+  } else if (mnl_socket_sendto(nl, batch, len) < 0) {
+    OAILOG_ERROR(LOG_SPGW_APP, "Failed to send nftables batch: %s\n",
+                 strerror(errno));
+  } else {
+    // The kernel reports the messages that failed, then the ack of the last
+    // message if the whole transaction was applied
+    uint32_t portid = mnl_socket_get_portid(nl);
+    char buf[MNL_SOCKET_BUFFER_SIZE];
+    int ret = MNL_CB_OK;
+    while (ret > MNL_CB_STOP) {
+      ret = mnl_socket_recvfrom(nl, buf, sizeof(buf));
+      if (ret > 0) {
+        ret = mnl_cb_run(buf, ret, 0, portid, NULL, NULL);
+      }
+    }
+    if (ret == MNL_CB_STOP) {
+      rc = RETURNok;
+    } else {
+      OAILOG_ERROR(LOG_SPGW_APP, "nftables transaction failed: %s\n",
+                   strerror(errno));
+    }
+  }
+  mnl_socket_close(nl);
+  return rc;
+}
+
+//------------------------------------------------------------------------------
+// Commits the batch as one nf_tables transaction and waits for its result
+static status_code_e pcef_nft_batch_commit(pcef_nft_batch_t* b) {
+  if (!b->last) {
+    return RETURNok;
+  }
+  b->last->nlmsg_flags |= NLM_F_ACK;
+  pcef_nft_put_msg(b, NFNL_MSG_BATCH_END, AF_UNSPEC, 0, NFNL_SUBSYS_NFTABLES);
+  if (!mnl_nlmsg_batch_next(b->batch)) {
+    OAILOG_ERROR(LOG_SPGW_APP, "nftables batch too large\n");
+    return RETURNerror;
+  }
+  if (pcef_nft_send) {
+    return pcef_nft_send(mnl_nlmsg_batch_head(b->batch),
+                         mnl_nlmsg_batch_size(b->batch));
+  }
+  return pcef_nft_netlink_send(mnl_nlmsg_batch_head(b->batch),
+                               mnl_nlmsg_batch_size(b->batch));
+}
+
+//------------------------------------------------------------------------------
+static void pcef_nft_put_table(struct nlmsghdr* nlh) {
+  mnl_attr_put_strz(nlh, NFTA_TABLE_NAME, PCEF_NFT_TABLE);
+}
+
+//------------------------------------------------------------------------------
+static void pcef_nft_put_base_chain(pcef_nft_batch_t* b, const char* name,
+                                    const char* type, uint32_t hook) {
+  struct nlmsghdr* nlh = pcef_nft_put_nft_msg(b, NFT_MSG_NEWCHAIN,
+                                              NLM_F_CREATE | NLM_F_EXCL);
+  mnl_attr_put_strz(nlh, NFTA_CHAIN_TABLE, PCEF_NFT_TABLE);
+  mnl_attr_put_strz(nlh, NFTA_CHAIN_NAME, name);
+  struct nlattr* nest = mnl_attr_nest_start(nlh, NFTA_CHAIN_HOOK);
+  mnl_attr_put_u32(nlh, NFTA_HOOK_HOOKNUM, htonl(hook));
+  mnl_attr_put_u32(nlh, NFTA_HOOK_PRIORITY,
+                   htonl((uint32_t)PCEF_NFT_PRIORITY_MANGLE));
+  mnl_attr_nest_end(nlh, nest);
+  mnl_attr_put_u32(nlh, NFTA_CHAIN_POLICY, htonl(NF_ACCEPT));
+  mnl_attr_put_strz(nlh, NFTA_CHAIN_TYPE, type);
+  mnl_nlmsg_batch_next(b->batch);
+}
+
+//------------------------------------------------------------------------------
+static void pcef_nft_sdf_chain_name(sdf_id_t sdf_id, char* name, size_t size) {
+  snprintf(name, size, PCEF_NFT_CHAIN_SDF_FORMAT, (int)sdf_id);
+}
+
+//------------------------------------------------------------------------------
+// Regular chain of the marks of a PCC rule, kept if it exists already
+static void pcef_nft_put_sdf_chain(pcef_nft_batch_t* b, const char* name) {
+  struct nlmsghdr* nlh =
+      pcef_nft_put_nft_msg(b, NFT_MSG_NEWCHAIN, NLM_F_CREATE);
+  mnl_attr_put_strz(nlh, NFTA_CHAIN_TABLE, PCEF_NFT_TABLE);
+  mnl_attr_put_strz(nlh, NFTA_CHAIN_NAME, name);
+  mnl_nlmsg_batch_next(b->batch);
+}
+
+//------------------------------------------------------------------------------
+// Deleting the rules of a chain without a rule handle flushes it
+static void pcef_nft_put_flush_chain(pcef_nft_batch_t* b, const char* name) {
+  struct nlmsghdr* nlh = pcef_nft_put_nft_msg(b, NFT_MSG_DELRULE, 0);
+  mnl_attr_put_strz(nlh, NFTA_RULE_TABLE, PCEF_NFT_TABLE);
+  mnl_attr_put_strz(nlh, NFTA_RULE_CHAIN, name);
+  mnl_nlmsg_batch_next(b->batch);
+}
+
+//------------------------------------------------------------------------------
+static void pcef_nft_put_data(struct nlmsghdr* nlh, uint16_t type,
+                              const void* data, size_t len) {
+  struct nlattr* nest = mnl_attr_nest_start(nlh, type);
+  mnl_attr_put(nlh, NFTA_DATA_VALUE, len, data);
+  mnl_attr_nest_end(nlh, nest);
+}
+
+//------------------------------------------------------------------------------
+// Match the len bytes at offset of the header base, masked, with value
+static void pcef_nft_put_match(struct nlmsghdr* nlh, uint32_t base,
+                               uint32_t offset, const uint8_t* value,
+                               const uint8_t* mask, size_t len) {
+  static const uint8_t zero[sizeof(uint32_t)] = {0};
+  bool masked = false;
+  bool wildcard = true;
+  for (size_t i = 0; i < len; i++) {
+    masked |= mask[i] != 0xff;
+    wildcard &= mask[i] == 0;
+  }
+  if (wildcard) {
+    return;
+  }
+
+  struct nlattr* elem = mnl_attr_nest_start(nlh, NFTA_LIST_ELEM);
+  mnl_attr_put_strz(nlh, NFTA_EXPR_NAME, "payload");
+  struct nlattr* data = mnl_attr_nest_start(nlh, NFTA_EXPR_DATA);
+  mnl_attr_put_u32(nlh, NFTA_PAYLOAD_DREG, htonl(NFT_REG_1));
+  mnl_attr_put_u32(nlh, NFTA_PAYLOAD_BASE, htonl(base));
+  mnl_attr_put_u32(nlh, NFTA_PAYLOAD_OFFSET, htonl(offset));
+  mnl_attr_put_u32(nlh, NFTA_PAYLOAD_LEN, htonl(len));
+  mnl_attr_nest_end(nlh, data);
+  mnl_attr_nest_end(nlh, elem);
+
+  if (masked) {
+    elem = mnl_attr_nest_start(nlh, NFTA_LIST_ELEM);
+    mnl_attr_put_strz(nlh, NFTA_EXPR_NAME, "bitwise");
+    data = mnl_attr_nest_start(nlh, NFTA_EXPR_DATA);
+    mnl_attr_put_u32(nlh, NFTA_BITWISE_SREG, htonl(NFT_REG_1));
+    mnl_attr_put_u32(nlh, NFTA_BITWISE_DREG, htonl(NFT_REG_1));
+    mnl_attr_put_u32(nlh, NFTA_BITWISE_LEN, htonl(len));
+    pcef_nft_put_data(nlh, NFTA_BITWISE_MASK, mask, len);
+    pcef_nft_put_data(nlh, NFTA_BITWISE_XOR, zero, len);
+    mnl_attr_nest_end(nlh, data);
+    mnl_attr_nest_end(nlh, elem);
+  }
+
+  elem = mnl_attr_nest_start(nlh, NFTA_LIST_ELEM);
+  mnl_attr_put_strz(nlh, NFTA_EXPR_NAME, "cmp");
+  data = mnl_attr_nest_start(nlh, NFTA_EXPR_DATA);
+  mnl_attr_put_u32(nlh, NFTA_CMP_SREG, htonl(NFT_REG_1));
+  mnl_attr_put_u32(nlh, NFTA_CMP_OP, htonl(NFT_CMP_EQ));
+  pcef_nft_put_data(nlh, NFTA_CMP_DATA, value, len);
+  mnl_attr_nest_end(nlh, data);
+  mnl_attr_nest_end(nlh, elem);
+}
+
+//------------------------------------------------------------------------------
+static void pcef_nft_put_exact_match(struct nlmsghdr* nlh, uint32_t base,
+                                     uint32_t offset, const void* value,
+                                     size_t len) {
+  static const uint8_t exact[sizeof(uint32_t)] = {0xff, 0xff, 0xff, 0xff};
+  pcef_nft_put_match(nlh, base, offset, value, exact, len);
+}
+
+//------------------------------------------------------------------------------
+// Prepended, as iptables -I
+static void pcef_nft_put_jump_rule(pcef_nft_batch_t* b, const char* chain,
+                                   const char* target) {
+  struct nlmsghdr* nlh = pcef_nft_put_nft_msg(b, NFT_MSG_NEWRULE, NLM_F_CREATE);
+  mnl_attr_put_strz(nlh, NFTA_RULE_TABLE, PCEF_NFT_TABLE);
+  mnl_attr_put_strz(nlh, NFTA_RULE_CHAIN, chain);
+  struct nlattr* exprs = mnl_attr_nest_start(nlh, NFTA_RULE_EXPRESSIONS);
+  struct nlattr* elem = mnl_attr_nest_start(nlh, NFTA_LIST_ELEM);
+  mnl_attr_put_strz(nlh, NFTA_EXPR_NAME, "immediate");
+  struct nlattr* data = mnl_attr_nest_start(nlh, NFTA_EXPR_DATA);
+  mnl_attr_put_u32(nlh, NFTA_IMMEDIATE_DREG, htonl(NFT_REG_VERDICT));
+  struct nlattr* imm = mnl_attr_nest_start(nlh, NFTA_IMMEDIATE_DATA);
+  struct nlattr* verdict = mnl_attr_nest_start(nlh, NFTA_DATA_VERDICT);
+  mnl_attr_put_u32(nlh, NFTA_VERDICT_CODE, htonl((uint32_t)NFT_JUMP));
+  mnl_attr_put_strz(nlh, NFTA_VERDICT_CHAIN, target);
+  mnl_attr_nest_end(nlh, verdict);
+  mnl_attr_nest_end(nlh, imm);
+  mnl_attr_nest_end(nlh, data);
+  mnl_attr_nest_end(nlh, elem);
+  mnl_attr_nest_end(nlh, exprs);
+  mnl_nlmsg_batch_next(b->batch);
+}
+
+//------------------------------------------------------------------------------
+static void pcef_nft_put_set_mark(struct nlmsghdr* nlh, uint32_t mark) {
+  struct nlattr* elem = mnl_attr_nest_start(nlh, NFTA_LIST_ELEM);
+  mnl_attr_put_strz(nlh, NFTA_EXPR_NAME, "immediate");
+  struct nlattr* data = mnl_attr_nest_start(nlh, NFTA_EXPR_DATA);
+  mnl_attr_put_u32(nlh, NFTA_IMMEDIATE_DREG, htonl(NFT_REG_1));
+  // Packet marks are in host byte order
+  pcef_nft_put_data(nlh, NFTA_IMMEDIATE_DATA, &mark, sizeof(mark));
+  mnl_attr_nest_end(nlh, data);
+  mnl_attr_nest_end(nlh, elem);
+
+  elem = mnl_attr_nest_start(nlh, NFTA_LIST_ELEM);
+  mnl_attr_put_strz(nlh, NFTA_EXPR_NAME, "meta");
+  data = mnl_attr_nest_start(nlh, NFTA_EXPR_DATA);
+  mnl_attr_put_u32(nlh, NFTA_META_KEY, htonl(NFT_META_MARK));
+  mnl_attr_put_u32(nlh, NFTA_META_SREG, htonl(NFT_REG_1));
+  mnl_attr_nest_end(nlh, data);
+  mnl_attr_nest_end(nlh, elem);
+}
+
+//------------------------------------------------------------------------------
+// Same matches as pgw_pcef_emulation_packet_filter_2_iptable_string for a
+// downlink filter, returns false for the fields it does not implement either
+static bool pcef_nft_put_sdf_filter(
+    struct nlmsghdr* nlh, const packet_filter_contents_t* const pf,
+    sdf_id_t sdf_id, const pgw_config_t* const pgw_config_p) {
+  if ((TRAFFIC_FLOW_TEMPLATE_IPV6_REMOTE_ADDR_FLAG |
+       TRAFFIC_FLOW_TEMPLATE_LOCAL_PORT_RANGE_FLAG |
+       TRAFFIC_FLOW_TEMPLATE_REMOTE_PORT_RANGE_FLAG |
+       TRAFFIC_FLOW_TEMPLATE_FLOW_LABEL_FLAG) &
+      pf->flags) {
+    return false;
+  }
+
+  struct nlattr* exprs = mnl_attr_nest_start(nlh, NFTA_RULE_EXPRESSIONS);
+  uint8_t addr[TRAFFIC_FLOW_TEMPLATE_IPV4_ADDR_SIZE];
+  uint8_t mask[TRAFFIC_FLOW_TEMPLATE_IPV4_ADDR_SIZE];
+  for (int i = 0; i < TRAFFIC_FLOW_TEMPLATE_IPV4_ADDR_SIZE; i++) {
+    addr[i] = pf->ipv4remoteaddr[i].addr & pf->ipv4remoteaddr[i].mask;
+    mask[i] = pf->ipv4remoteaddr[i].mask;
+  }
+  if (TRAFFIC_FLOW_TEMPLATE_IPV4_REMOTE_ADDR_FLAG & pf->flags) {
+    pcef_nft_put_match(nlh, NFT_PAYLOAD_NETWORK_HEADER, IPV4_DADDR_OFFSET, addr,
+                       mask, sizeof(addr));
+  } else {
+    pcef_nft_put_match(nlh, NFT_PAYLOAD_NETWORK_HEADER, IPV4_SADDR_OFFSET, addr,
+                       mask, sizeof(addr));
+    // Traffic to the UEs
+    uint8_t pool_mask_len = pgw_config_p->ue_pool_mask[0];
+    uint32_t pool_mask =
+        pool_mask_len ? htonl(0xFFFFFFFF << (32 - pool_mask_len)) : 0;
+    uint32_t pool_addr = pgw_config_p->ue_pool_addr[0].s_addr & pool_mask;
+    pcef_nft_put_match(nlh, NFT_PAYLOAD_NETWORK_HEADER, IPV4_DADDR_OFFSET,
+                       (const uint8_t*)&pool_addr, (const uint8_t*)&pool_mask,
+                       sizeof(pool_addr));
+  }
+  if (TRAFFIC_FLOW_TEMPLATE_PROTOCOL_NEXT_HEADER_FLAG & pf->flags) {
+    pcef_nft_put_exact_match(nlh, NFT_PAYLOAD_NETWORK_HEADER,
+                             IPV4_PROTOCOL_OFFSET,
+                             &pf->protocolidentifier_nextheader,
+                             sizeof(pf->protocolidentifier_nextheader));
+  }
+  if (TRAFFIC_FLOW_TEMPLATE_SINGLE_LOCAL_PORT_FLAG & pf->flags) {
+    uint16_t port = htons(pf->singlelocalport);
+    pcef_nft_put_exact_match(nlh, NFT_PAYLOAD_TRANSPORT_HEADER, L4_DPORT_OFFSET,
+                             &port, sizeof(port));
+  }
+  if (TRAFFIC_FLOW_TEMPLATE_SINGLE_REMOTE_PORT_FLAG & pf->flags) {
+    uint16_t port = htons(pf->singleremoteport);
+    pcef_nft_put_exact_match(nlh, NFT_PAYLOAD_TRANSPORT_HEADER, L4_SPORT_OFFSET,
+                             &port, sizeof(port));
+  }
+  if (TRAFFIC_FLOW_TEMPLATE_SECURITY_PARAMETER_INDEX_FLAG & pf->flags) {
+    uint32_t spi = htonl(pf->securityparameterindex);
+    pcef_nft_put_exact_match(nlh, NFT_PAYLOAD_TRANSPORT_HEADER, ESP_SPI_OFFSET,
+                             &spi, sizeof(spi));
+  }
+  if (TRAFFIC_FLOW_TEMPLATE_TYPE_OF_SERVICE_TRAFFIC_CLASS_FLAG & pf->flags) {
+    uint8_t tos_mask = pf->typdeofservice_trafficclass.mask;
+    uint8_t tos = pf->typdeofservice_trafficclass.value & tos_mask;
+    pcef_nft_put_match(nlh, NFT_PAYLOAD_NETWORK_HEADER, IPV4_TOS_OFFSET, &tos,
+                       &tos_mask, sizeof(tos));
+  }
+  pcef_nft_put_set_mark(nlh, sdf_id);
+  mnl_attr_nest_end(nlh, exprs);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+status_code_e pgw_pcef_emulation_nft_init(void) {
+  memset(pcef_nft_sdf_chain_linked, 0, sizeof(pcef_nft_sdf_chain_linked));
+  pcef_nft_batch_t b;
+  if (!pcef_nft_batch_begin(&b)) {
+    pcef_nft_batch_free(&b);
+    return RETURNerror;
+  }
+  // Creating the table first makes the delete succeed when it does not exist
+  pcef_nft_put_table(pcef_nft_put_nft_msg(&b, NFT_MSG_NEWTABLE, NLM_F_CREATE));
+  mnl_nlmsg_batch_next(b.batch);
+  pcef_nft_put_table(pcef_nft_put_nft_msg(&b, NFT_MSG_DELTABLE, 0));
+  mnl_nlmsg_batch_next(b.batch);
+  pcef_nft_put_table(pcef_nft_put_nft_msg(&b, NFT_MSG_NEWTABLE, NLM_F_CREATE));
+  mnl_nlmsg_batch_next(b.batch);
+  // Same hooks and chain types as the iptables mangle table
+  pcef_nft_put_base_chain(&b, PCEF_NFT_CHAIN_POSTROUTING, "filter",
+                          NF_INET_POST_ROUTING);
+  pcef_nft_put_base_chain(&b, PCEF_NFT_CHAIN_OUTPUT, "route",
+                          NF_INET_LOCAL_OUT);
+
+  status_code_e rc = pcef_nft_batch_commit(&b);
+  pcef_nft_batch_free(&b);
+  if (rc == RETURNok) {
+    OAILOG_INFO(LOG_SPGW_APP, "Using nftables table %s for SDF marking\n",
+                PCEF_NFT_TABLE);
+  }
+  return rc;
+}
+
+//------------------------------------------------------------------------------
+status_code_e pgw_pcef_emulation_nft_apply_rule(
+    const pcc_rule_t* const pcc_rule, const pgw_config_t* const pgw_config_p) {
+  static const char* const chains[] = {PCEF_NFT_CHAIN_POSTROUTING,
+                                       PCEF_NFT_CHAIN_OUTPUT};
+  if (pcc_rule->sdf_id >= SDF_ID_MAX) {
+    return RETURNerror;
+  }
+  char sdf_chain[PCEF_NFT_CHAIN_NAME_SIZE];
+  pcef_nft_sdf_chain_name(pcc_rule->sdf_id, sdf_chain, sizeof(sdf_chain));
+  pcef_nft_batch_t b;
+  if (!pcef_nft_batch_begin(&b)) {
+    pcef_nft_batch_free(&b);
+    return RETURNerror;
+  }
+  pcef_nft_put_sdf_chain(&b, sdf_chain);
+  pcef_nft_put_flush_chain(&b, sdf_chain);
+  if (!pcef_nft_sdf_chain_linked[pcc_rule->sdf_id]) {
+    for (int c = 0; c < (int)(sizeof(chains) / sizeof(chains[0])); c++) {
+      pcef_nft_put_jump_rule(&b, chains[c], sdf_chain);
+    }
+  }
+  const sdf_template_t* sdf_template = &pcc_rule->sdf_template;
+  for (int sdff_i = 0; sdff_i < sdf_template->number_of_packet_filters;
+       sdff_i++) {
+    const sdf_filter_t* sdf_f = &sdf_template->sdf_filter[sdff_i];
+    if ((TRAFFIC_FLOW_TEMPLATE_BIDIRECTIONAL != sdf_f->direction) &&
+        (TRAFFIC_FLOW_TEMPLATE_DOWNLINK_ONLY != sdf_f->direction)) {
+      continue;
+    }
+    // The filters of a rule set the same mark, their order does not matter
+    struct nlmsghdr* nlh = pcef_nft_put_nft_msg(
+        &b, NFT_MSG_NEWRULE, NLM_F_CREATE | NLM_F_APPEND);
+    mnl_attr_put_strz(nlh, NFTA_RULE_TABLE, PCEF_NFT_TABLE);
+    mnl_attr_put_strz(nlh, NFTA_RULE_CHAIN, sdf_chain);
+    if (!pcef_nft_put_sdf_filter(nlh, &sdf_f->packetfiltercontents,
+                                 pcc_rule->sdf_id, pgw_config_p)) {
+      OAILOG_WARNING(LOG_SPGW_APP,
+                     "No nftables translation of SDF filter %d of PCC rule "
+                     "%s\n",
+                     sdf_f->identifier, bdata(pcc_rule->name));
+      pcef_nft_batch_free(&b);
+      return RETURNerror;
+    }
+    if (!mnl_nlmsg_batch_next(b.batch)) {
+      OAILOG_ERROR(LOG_SPGW_APP, "nftables batch too large\n");
+      pcef_nft_batch_free(&b);
+      return RETURNerror;
+    }
+  }
+  status_code_e rc = pcef_nft_batch_commit(&b);
+  pcef_nft_batch_free(&b);
+  if (rc == RETURNok) {
+    pcef_nft_sdf_chain_linked[pcc_rule->sdf_id] = true;
+  }
+  return rc;
+}
+
+//------------------------------------------------------------------------------
+status_code_e pgw_pcef_emulation_nft_remove_rule(
+    const pcc_rule_t* const pcc_rule) {
+  if (pcc_rule->sdf_id >= SDF_ID_MAX ||
+      !pcef_nft_sdf_chain_linked[pcc_rule->sdf_id]) {
+    return RETURNerror;
+  }
+  char sdf_chain[PCEF_NFT_CHAIN_NAME_SIZE];
+  pcef_nft_sdf_chain_name(pcc_rule->sdf_id, sdf_chain, sizeof(sdf_chain));
+  pcef_nft_batch_t b;
+  if (!pcef_nft_batch_begin(&b)) {
+    pcef_nft_batch_free(&b);
+    return RETURNerror;
+  }
+  // The jumps to the empty chain are kept for the next apply of the rule
+  pcef_nft_put_flush_chain(&b, sdf_chain);
+  status_code_e rc = pcef_nft_batch_commit(&b);
+  pcef_nft_batch_free(&b);
+  return rc;
+}
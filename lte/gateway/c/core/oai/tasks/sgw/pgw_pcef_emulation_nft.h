@@ -0,0 +1,66 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the terms found in the LICENSE file in the root of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+/*! \file pgw_pcef_emulation_nft.h
+ * \brief nftables backend of the PCEF emulation SDF marking
+ */
+
+#ifndef FILE_PGW_PCEF_EMULATION_NFT_SEEN
+#define FILE_PGW_PCEF_EMULATION_NFT_SEEN
+
+#include <stddef.h>
+
+#include "lte/gateway/c/core/common/common_defs.h"
+#include "lte/gateway/c/core/oai/include/pgw_config.h"
+#include "lte/gateway/c/core/oai/include/pgw_types.h"
+
+/*
+ * Replace the nftables table of the SDF marks left by a previous run with an
+ * empty one, in a single netlink transaction. Fails if the kernel has no
+ * nf_tables support or we lack CAP_NET_ADMIN, the caller then falls back to
+ * iptables.
+ */
+status_code_e pgw_pcef_emulation_nft_init(void);
+
+/*
+ * Install the marks of every SDF filter of pcc_rule in a single netlink
+ * transaction, nothing is installed on error. Filters that have no nftables
+ * translation fail the whole rule before anything is sent.
+ */
+status_code_e pgw_pcef_emulation_nft_apply_rule(
+    const pcc_rule_t* pcc_rule, const pgw_config_t* pgw_config_p);
+
+/*
+ * Remove the marks of pcc_rule in a single netlink transaction. Fails if they
+ * were not installed by pgw_pcef_emulation_nft_apply_rule.
+ */
+status_code_e pgw_pcef_emulation_nft_remove_rule(const pcc_rule_t* pcc_rule);
+
+/*
+ * Sends a batch of nf_tables messages as one transaction and returns its
+ * result
+ */
+typedef status_code_e (*pgw_pcef_emulation_nft_send_t)(const void* batch,
+                                                       size_t len);
+
+/*
+ * Replace the netfilter netlink socket the transactions are sent on, for unit
+ * tests. NULL restores the socket.
+ */
+void pgw_pcef_emulation_nft_set_send(pgw_pcef_emulation_nft_send_t send);
+
+#endif /* FILE_PGW_PCEF_EMULATION_NFT_SEEN */
@@ -338,6 +338,16 @@ status_code_e sgw_config_parse_string(const char* config_string,
         config_pP->ebpf_enabled = false;
       }
       OAILOG_INFO(LOG_SPGW_APP, "eBPF enabled: %s\n", ebpf_enabled);
+
+      // Optional, older configs do not have it
+      char* of_bundles = NULL;
+      config_pP->ovs_config.of_bundles =
+          config_setting_lookup_string(ovs_settings,
+                                       SGW_CONFIG_STRING_OVS_OF_BUNDLES,
+                                       (const char**)&of_bundles) &&
+          strcasecmp(of_bundles, "true") == 0;
+      OAILOG_INFO(LOG_SPGW_APP, "Openflow bundles enable: %s\n",
+                  config_pP->ovs_config.of_bundles ? "true" : "false");
     } else {
       Fatal("Couldn't find all ovs settings in spgw config\n");
     }
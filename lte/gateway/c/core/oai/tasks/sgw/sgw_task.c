@@ -61,10 +61,12 @@ static int handle_message(zloop_t* loop, zsock_t* reader, void* arg) {
   spgw_state_t* spgw_state = get_spgw_state(false);
 
   bool is_state_same = false;
+  bool is_ue_state_same = false;
 
   switch (ITTI_MSG_ID(received_message_p)) {
     case MESSAGE_TEST:
       is_state_same = true;  // task state is not changed
+      is_ue_state_same = true;
       OAILOG_DEBUG(LOG_SPGW_APP, "Received MESSAGE_TEST\n");
       break;
 
@@ -205,12 +207,16 @@ static int handle_message(zloop_t* loop, zsock_t* reader, void* arg) {
       OAILOG_DEBUG(LOG_SPGW_APP, "Unknown message ID %d:%s\n",
                    ITTI_MSG_ID(received_message_p),
                    ITTI_MSG_NAME(received_message_p));
+      is_ue_state_same = true;
     } break;
   }
 
   if (!is_state_same) {
     put_spgw_state();
   }
+  if (!is_ue_state_same) {
+    mark_spgw_ue_state_dirty(imsi64);
+  }
   put_spgw_ue_state(imsi64);
 
   itti_free_msg_content(received_message_p);
@@ -271,6 +277,7 @@ status_code_e spgw_app_init(spgw_config_t* spgw_config_pP, bool persist_state) {
 //------------------------------------------------------------------------------
 static void spgw_app_exit(void) {
   OAILOG_DEBUG(LOG_SPGW_APP, "Cleaning SGW\n");
+  pgw_pcef_emulation_exit(get_spgw_state(false), &spgw_config.pgw_config);
   put_spgw_state();
 #if !MME_UNIT_TEST  // No need to initialize OVS data path for unit tests
   gtpv1u_exit();
@@ -57,6 +57,16 @@ void spgw_state_exit() { SpgwStateManager::getInstance().free_state(); }
 
 void put_spgw_state() { SpgwStateManager::getInstance().write_state_to_db(); }
 
+void mark_spgw_ue_state_dirty(imsi64_t imsi64) {
+  spgw_ue_context_t* ue_context_p = nullptr;
+  hash_table_ts_t* spgw_ue_state = get_spgw_ue_state();
+  hashtable_ts_get(spgw_ue_state, (const hash_key_t)imsi64,
+                   (void**)&ue_context_p);
+  if (ue_context_p) {
+    UE_STATE_MARK_DIRTY(ue_context_p);
+  }
+}
+
 void put_spgw_ue_state(imsi64_t imsi64) {
   if (SpgwStateManager::getInstance().is_persist_state_enabled()) {
     spgw_ue_context_t* ue_context_p = nullptr;
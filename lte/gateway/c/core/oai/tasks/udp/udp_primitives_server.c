@@ -22,6 +22,7 @@
   \email: lionel.gauthier@eurecom.fr
 */
 
+#define _GNU_SOURCE /* recvmmsg and sendmmsg */
 #include <arpa/inet.h>
 #include <errno.h>
 #include <fcntl.h>
@@ -45,17 +46,39 @@
 #include "lte/gateway/c/core/oai/include/udp_primitives_server.h"
 #include "lte/gateway/c/core/oai/lib/gtpv2-c/nwgtpv2c-0.11/include/queue.h"
 #include "lte/gateway/c/core/oai/lib/itti/intertask_interface.h"
+#include "orc8r/gateway/c/common/service303/MetricsHelpers.hpp"
 
 task_zmq_ctx_t udp_task_zmq_ctx;
 
+#define UDP_RECV_BATCH_SIZE UDP_DATA_IND_BATCH_MAX_DATAGRAMS
+#define UDP_SEND_BATCH_SIZE (32)
+/* Bound the time spent draining a single socket on one wake-up */
+#define UDP_RECV_MAX_BATCHES_PER_WAKEUP (8)
+/* Number of datagrams per recvmmsg/sendmmsg call, labelled by local port */
+#define UDP_RECV_BATCH_HISTOGRAM "udp_recv_batch_size"
+#define UDP_SEND_BATCH_HISTOGRAM "udp_send_batch_size"
+
 struct udp_socket_desc_s {
-  uint8_t buffer[4096];
+  /* Reusable receive buffers, filled by one recvmmsg call */
+  uint8_t recv_buffers[UDP_RECV_BATCH_SIZE][UDP_DATA_MAX_MSG_LEN];
+  struct mmsghdr recv_msgs[UDP_RECV_BATCH_SIZE];
+  struct iovec recv_iovecs[UDP_RECV_BATCH_SIZE];
+  struct sockaddr_storage recv_addrs[UDP_RECV_BATCH_SIZE];
+
+  /* Outbound datagrams queued until the task mailbox is drained */
+  uint8_t send_buffers[UDP_SEND_BATCH_SIZE][UDP_DATA_MAX_MSG_LEN];
+  struct mmsghdr send_msgs[UDP_SEND_BATCH_SIZE];
+  struct iovec send_iovecs[UDP_SEND_BATCH_SIZE];
+  struct sockaddr_storage send_addrs[UDP_SEND_BATCH_SIZE];
+  unsigned int send_count;
+
   int sd; /* Socket descriptor to use */
 
   pthread_t listener_thread; /* Thread affected to recv */
 
   struct sockaddr local_addr; /* Local ipv4 or ipv6 address to use */
   uint16_t local_port;        /* Local port to use */
+  char port_label[6];         /* local_port, as the metrics label */
 
   task_id_t task_id; /* Task who has requested the new endpoint */
   STAILQ_ENTRY(udp_socket_desc_s) entries;
@@ -115,61 +138,147 @@ static struct udp_socket_desc_s* udp_server_get_socket_desc_by_sd(int sdP) {
   return udp_sock_p;
 }
 
+static void udp_server_init_batch_buffers(
+    struct udp_socket_desc_s* udp_sock_pP) {
+  for (int i = 0; i < UDP_RECV_BATCH_SIZE; i++) {
+    udp_sock_pP->recv_iovecs[i].iov_base = udp_sock_pP->recv_buffers[i];
+    udp_sock_pP->recv_iovecs[i].iov_len = UDP_DATA_MAX_MSG_LEN;
+    udp_sock_pP->recv_msgs[i].msg_hdr.msg_iov = &udp_sock_pP->recv_iovecs[i];
+    udp_sock_pP->recv_msgs[i].msg_hdr.msg_iovlen = 1;
+    udp_sock_pP->recv_msgs[i].msg_hdr.msg_name = &udp_sock_pP->recv_addrs[i];
+  }
+  for (int i = 0; i < UDP_SEND_BATCH_SIZE; i++) {
+    udp_sock_pP->send_iovecs[i].iov_base = udp_sock_pP->send_buffers[i];
+    udp_sock_pP->send_msgs[i].msg_hdr.msg_iov = &udp_sock_pP->send_iovecs[i];
+    udp_sock_pP->send_msgs[i].msg_hdr.msg_iovlen = 1;
+    udp_sock_pP->send_msgs[i].msg_hdr.msg_name = &udp_sock_pP->send_addrs[i];
+  }
+}
+
+/* Buckets: 1, 2-3, 4-7, 8-15, 16-31, 32 and more datagrams */
+static void udp_server_observe_batch_size(
+    const char* histogram, struct udp_socket_desc_s* udp_sock_pP,
+    unsigned int batch_size) {
+  observe_histogram(histogram, batch_size, 1, "port", udp_sock_pP->port_label,
+                    (size_t)5, 1., 3., 7., 15., 31.);
+}
+
+static void udp_server_set_local_port(struct udp_socket_desc_s* udp_sock_pP,
+                                      uint16_t local_port) {
+  udp_sock_pP->local_port = local_port;
+  snprintf(udp_sock_pP->port_label, sizeof(udp_sock_pP->port_label), "%u",
+           local_port);
+}
+
+/* @brief Copy a peer address returned by recvmmsg into the message union
+ */
+static uint16_t udp_server_copy_peer_address(
+    const struct sockaddr_storage* addr_p, void* sock_addr_p) {
+  if (addr_p->ss_family == AF_INET6) {
+    const struct sockaddr_in6* addr6 = (const struct sockaddr_in6*)addr_p;
+    memcpy(sock_addr_p, addr6, sizeof(struct sockaddr_in6));
+    return htons(addr6->sin6_port);
+  }
+  const struct sockaddr_in* addr = (const struct sockaddr_in*)addr_p;
+  memcpy(sock_addr_p, addr, sizeof(struct sockaddr_in));
+  return htons(addr->sin_port);
+}
+
+static void udp_server_send_data_ind(struct udp_socket_desc_s* udp_sock_pP) {
+  MessageDef* message_p = NULL;
+  udp_data_ind_t* udp_data_ind_p;
+  uint32_t bytes_received = udp_sock_pP->recv_msgs[0].msg_len;
+
+  message_p = DEPRECATEDitti_alloc_new_message_fatal(TASK_UDP, UDP_DATA_IND);
+  udp_data_ind_p = &message_p->ittiMsg.udp_data_ind;
+  memcpy(udp_data_ind_p->msgBuf, udp_sock_pP->recv_buffers[0], bytes_received);
+
+  udp_data_ind_p->buffer_length = bytes_received;
+  udp_data_ind_p->local_port = udp_sock_pP->local_port;
+  udp_data_ind_p->peer_port = udp_server_copy_peer_address(
+      &udp_sock_pP->recv_addrs[0], &udp_data_ind_p->sock_addr);
+
+  OAILOG_DEBUG(LOG_UDP, "Msg of length %u received on port %u\n",
+               bytes_received, udp_sock_pP->local_port);
+
+  if (send_msg_to_task(&udp_task_zmq_ctx, udp_sock_pP->task_id, message_p) <
+      0) {
+    OAILOG_DEBUG(LOG_UDP, "Failed to send message %d to task %d\n",
+                 UDP_DATA_IND, udp_sock_pP->task_id);
+  }
+}
+
+static void udp_server_send_data_ind_batch(
+    struct udp_socket_desc_s* udp_sock_pP, int num_datagrams) {
+  MessageDef* message_p = NULL;
+  udp_data_ind_batch_t* batch_p;
+  uint32_t total_length = 0;
+  uint32_t offset = 0;
+
+  for (int i = 0; i < num_datagrams; i++) {
+    total_length += udp_sock_pP->recv_msgs[i].msg_len;
+  }
+
+  message_p =
+      DEPRECATEDitti_alloc_new_message_fatal(TASK_UDP, UDP_DATA_IND_BATCH);
+  batch_p = &message_p->ittiMsg.udp_data_ind_batch;
+  batch_p->buffer = malloc(total_length);
+  AssertFatal(batch_p->buffer != NULL, "UDP batch allocation failed");
+  batch_p->local_port = udp_sock_pP->local_port;
+  batch_p->num_datagrams = num_datagrams;
+
+  for (int i = 0; i < num_datagrams; i++) {
+    udp_datagram_t* datagram = &batch_p->datagrams[i];
+    uint32_t length = udp_sock_pP->recv_msgs[i].msg_len;
+    memcpy(&batch_p->buffer[offset], udp_sock_pP->recv_buffers[i], length);
+    datagram->buffer_offset = offset;
+    datagram->buffer_length = length;
+    datagram->peer_port = udp_server_copy_peer_address(
+        &udp_sock_pP->recv_addrs[i], &datagram->sock_addr);
+    offset += length;
+  }
+
+  OAILOG_DEBUG(LOG_UDP, "%d msgs of total length %u received on port %u\n",
+               num_datagrams, total_length, udp_sock_pP->local_port);
+
+  if (send_msg_to_task(&udp_task_zmq_ctx, udp_sock_pP->task_id, message_p) <
+      0) {
+    OAILOG_DEBUG(LOG_UDP, "Failed to send message %d to task %d\n",
+                 UDP_DATA_IND_BATCH, udp_sock_pP->task_id);
+  }
+}
+
+/* @brief Drain the socket with recvmmsg and forward what was read to the
+ * owning task, as a single UDP_DATA_IND_BATCH per recvmmsg call
+ */
 static void udp_server_receive_and_process(
     struct udp_socket_desc_s* udp_sock_pP) {
-  OAILOG_DEBUG(LOG_UDP, "Inserting new descriptor for task %d, sd %d\n",
-               udp_sock_pP->task_id, udp_sock_pP->sd);
-  {
-    int bytes_received = 0;
-    socklen_t from_len;
-    struct sockaddr_in addr;
-    struct sockaddr_in6 addr6;
-
-    bool ipv6 = udp_sock_pP->local_addr.sa_family == AF_INET6;
-
-    if (ipv6) {
-      from_len = (socklen_t)sizeof(struct sockaddr_in6);
-      memset(&addr6, 0, sizeof(struct sockaddr_in6));
-    } else {
-      from_len = (socklen_t)sizeof(struct sockaddr_in);
-      memset(&addr, 0, sizeof(struct sockaddr_in));
+  for (int round = 0; round < UDP_RECV_MAX_BATCHES_PER_WAKEUP; round++) {
+    for (int i = 0; i < UDP_RECV_BATCH_SIZE; i++) {
+      udp_sock_pP->recv_msgs[i].msg_hdr.msg_namelen =
+          sizeof(struct sockaddr_storage);
+      udp_sock_pP->recv_msgs[i].msg_hdr.msg_flags = 0;
     }
 
-    if ((bytes_received = recvfrom(
-             udp_sock_pP->sd, udp_sock_pP->buffer, sizeof(udp_sock_pP->buffer),
-             0, ipv6 ? (struct sockaddr*)&addr6 : (struct sockaddr*)&addr,
-             &from_len)) <= 0) {
-      OAILOG_ERROR(LOG_UDP, "Recvfrom failed %s\n", strerror(errno));
-      // break;
-    } else {
-      MessageDef* message_p = NULL;
-      udp_data_ind_t* udp_data_ind_p;
-      AssertFatal(sizeof(udp_sock_pP->buffer) >= bytes_received,
-                  "UDP BUFFER OVERFLOW");
-      message_p =
-          DEPRECATEDitti_alloc_new_message_fatal(TASK_UDP, UDP_DATA_IND);
-      udp_data_ind_p = &message_p->ittiMsg.udp_data_ind;
-      memcpy(udp_data_ind_p->msgBuf, udp_sock_pP->buffer, bytes_received);
-
-      udp_data_ind_p->buffer_length = bytes_received;
-      udp_data_ind_p->local_port = udp_sock_pP->local_port;
-      udp_data_ind_p->peer_port =
-          ipv6 ? htons(addr6.sin6_port) : htons(addr.sin_port);
-      memcpy((void*)&udp_data_ind_p->sock_addr,
-             (ipv6) ? (void*)&addr6 : (void*)&addr,
-             (ipv6) ? sizeof(struct sockaddr_in6) : sizeof(struct sockaddr_in));
-
-      OAILOG_DEBUG(LOG_UDP, "Msg of length %d received from %s:%u\n",
-                   bytes_received,
-                   (!ipv6) ? inet_ntoa(addr.sin_addr) : "TODO_IPV6",
-                   ntohs(addr.sin_port));
-
-      if (send_msg_to_task(&udp_task_zmq_ctx, udp_sock_pP->task_id, message_p) <
-          0) {
-        OAILOG_DEBUG(LOG_UDP, "Failed to send message %d to task %d\n",
-                     UDP_DATA_IND, udp_sock_pP->task_id);
-        // break;
+    int received = recvmmsg(udp_sock_pP->sd, udp_sock_pP->recv_msgs,
+                            UDP_RECV_BATCH_SIZE, MSG_DONTWAIT, NULL);
+    if (received <= 0) {
+      if (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+        OAILOG_ERROR(LOG_UDP, "Recvmmsg failed %s\n", strerror(errno));
       }
+      return;
+    }
+    udp_server_observe_batch_size(UDP_RECV_BATCH_HISTOGRAM, udp_sock_pP,
+                                  received);
+
+    if (received == 1) {
+      udp_server_send_data_ind(udp_sock_pP);
+    } else {
+      udp_server_send_data_ind_batch(udp_sock_pP, received);
+    }
+
+    if (received < UDP_RECV_BATCH_SIZE) {
+      return;  // The socket is drained
     }
   }
 }
@@ -257,9 +366,10 @@ static int udp_server_create_socket_v4(uint16_t port, struct in_addr* address,
   socket_desc_p = calloc(1, sizeof(struct udp_socket_desc_s));
   DevAssert(socket_desc_p != NULL);
   socket_desc_p->sd = sd;
+  udp_server_init_batch_buffers(socket_desc_p);
   ((struct sockaddr_in*)&socket_desc_p->local_addr)->sin_addr = *address;
   socket_desc_p->local_addr.sa_family = AF_INET;
-  socket_desc_p->local_port = ntohs(addr_check.sin_port);
+  udp_server_set_local_port(socket_desc_p, ntohs(addr_check.sin_port));
   socket_desc_p->task_id = task_id;
   OAILOG_DEBUG(LOG_UDP, "(IPv4) Inserting new descriptor for task %d, sd %d\n",
                socket_desc_p->task_id, socket_desc_p->sd);
@@ -335,11 +445,12 @@ static int udp_server_create_socket_v6(uint16_t port, struct in6_addr* address,
   socket_desc_p = calloc(1, sizeof(struct udp_socket_desc_s));
   DevAssert(socket_desc_p != NULL);
   socket_desc_p->sd = sd;
+  udp_server_init_batch_buffers(socket_desc_p);
   ((struct sockaddr_in6*)&socket_desc_p->local_addr)->sin6_addr = *address;
   socket_desc_p->local_addr.sa_family = AF_INET6;
 
   //  ((struct sockaddr_in6*)&socket_desc_p->local_addr)->sin6_family = AF_INET;
-  socket_desc_p->local_port = ntohs(addr_check.sin_port);
+  udp_server_set_local_port(socket_desc_p, ntohs(addr_check.sin_port));
   socket_desc_p->task_id = task_id;
   OAILOG_DEBUG(LOG_UDP, "(IPv6) Inserting new descriptor for task %d, sd %d\n",
                socket_desc_p->task_id, socket_desc_p->sd);
@@ -353,6 +464,66 @@ static int udp_server_create_socket_v6(uint16_t port, struct in6_addr* address,
   return sd;
 }
 
+/* @brief Send all datagrams queued on the socket with sendmmsg
+ */
+static void udp_server_flush_send_queue(struct udp_socket_desc_s* udp_sock_pP) {
+  unsigned int sent = 0;
+
+  if (udp_sock_pP->send_count == 0) {
+    return;
+  }
+  udp_server_observe_batch_size(UDP_SEND_BATCH_HISTOGRAM, udp_sock_pP,
+                                udp_sock_pP->send_count);
+
+  while (sent < udp_sock_pP->send_count) {
+    int rc = sendmmsg(udp_sock_pP->sd, &udp_sock_pP->send_msgs[sent],
+                      udp_sock_pP->send_count - sent, 0);
+    if (rc < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      OAILOG_ERROR(LOG_UDP,
+                   "There was an error while writing to socket "
+                   "(%d:%s)\n",
+                   errno, strerror(errno));
+      // Skip the datagram that failed, as sendto would have
+      sent++;
+      continue;
+    }
+    sent += rc;
+  }
+  udp_sock_pP->send_count = 0;
+}
+
+static void udp_server_flush_all_send_queues(void) {
+  struct udp_socket_desc_s* udp_sock_p = NULL;
+
+  pthread_mutex_lock(&udp_socket_list_mutex);
+  STAILQ_FOREACH(udp_sock_p, &udp_socket_list, entries) {
+    udp_server_flush_send_queue(udp_sock_p);
+  }
+  pthread_mutex_unlock(&udp_socket_list_mutex);
+}
+
+/* @brief Copy a datagram into the send queue of the socket, flushing the
+ * queue first if it is full
+ */
+static void udp_server_queue_datagram(struct udp_socket_desc_s* udp_sock_pP,
+                                      const uint8_t* buffer, uint32_t length,
+                                      const struct sockaddr_storage* peer_addr,
+                                      socklen_t peer_addr_len) {
+  AssertFatal(length <= UDP_DATA_MAX_MSG_LEN, "UDP BUFFER OVERFLOW");
+  if (udp_sock_pP->send_count == UDP_SEND_BATCH_SIZE) {
+    udp_server_flush_send_queue(udp_sock_pP);
+  }
+
+  unsigned int index = udp_sock_pP->send_count++;
+  memcpy(udp_sock_pP->send_buffers[index], buffer, length);
+  udp_sock_pP->send_iovecs[index].iov_len = length;
+  memcpy(&udp_sock_pP->send_addrs[index], peer_addr, peer_addr_len);
+  udp_sock_pP->send_msgs[index].msg_hdr.msg_namelen = peer_addr_len;
+}
+
 static int handle_message(zloop_t* loop, zsock_t* reader, void* arg) {
   MessageDef* received_message_p = receive_msg(reader);
 
@@ -378,102 +549,58 @@ static int handle_message(zloop_t* loop, zsock_t* reader, void* arg) {
     } break;
 
     case UDP_DATA_REQ: {
-      int udp_sd = -1;
-      ssize_t bytes_written;
       struct udp_socket_desc_s* udp_sock_p = NULL;
       udp_data_req_t* udp_data_req_p;
-      struct sockaddr_in peer_addr;
-      struct sockaddr_in6 peer_addr6;
+      struct sockaddr_storage peer_addr;
+      socklen_t peer_addr_len;
 
       udp_data_req_p = &received_message_p->ittiMsg.udp_data_req;
-      // UDP_DEBUG("-- UDP_DATA_REQ
-      // -----------------------------------------------------\n%s :\n",
-      //        __FUNCTION__);
-      // udp_print_hex_octets(&udp_data_req_p->buffer[udp_data_req_p->buffer_offset],
-      //        udp_data_req_p->buffer_length);
+      memset(&peer_addr, 0, sizeof(peer_addr));
       if (udp_data_req_p->peer_address->sa_family == AF_INET) {
-        memset(&peer_addr, 0, sizeof(struct sockaddr_in));
-        peer_addr.sin_family = AF_INET;
-        peer_addr.sin_port = htons(udp_data_req_p->peer_port);
-        peer_addr.sin_addr =
+        struct sockaddr_in* peer_addr4 = (struct sockaddr_in*)&peer_addr;
+        peer_addr4->sin_family = AF_INET;
+        peer_addr4->sin_port = htons(udp_data_req_p->peer_port);
+        peer_addr4->sin_addr =
             ((struct sockaddr_in*)udp_data_req_p->peer_address)->sin_addr;
-        pthread_mutex_lock(&udp_socket_list_mutex);
-        udp_sock_p = udp_server_get_socket_desc(
-            ITTI_MSG_ORIGIN_ID(received_message_p), udp_data_req_p->local_port,
-            udp_data_req_p->peer_port, AF_INET);
-
-        if (udp_sock_p == NULL) {
-          OAILOG_ERROR(LOG_UDP,
-                       "Failed to retrieve the udp socket descriptor for IPv4 "
-                       "associated with task %d\n",
-                       ITTI_MSG_ORIGIN_ID(received_message_p));
-          pthread_mutex_unlock(&udp_socket_list_mutex);
-          // no free udp_data_req_p->buffer, statically allocated
-          break;
-        }
-
-        udp_sd = udp_sock_p->sd;
-        pthread_mutex_unlock(&udp_socket_list_mutex);
+        peer_addr_len = sizeof(struct sockaddr_in);
         OAILOG_DEBUG(
             LOG_UDP,
-            "[%d] Sending message of size %u to " IN_ADDR_FMT " and port %u\n",
-            udp_sd, udp_data_req_p->buffer_length,
-            PRI_IN_ADDR(
-                ((struct sockaddr_in*)udp_data_req_p->peer_address)->sin_addr),
+            "Queueing message of size %u to " IN_ADDR_FMT " and port %u\n",
+            udp_data_req_p->buffer_length, PRI_IN_ADDR(peer_addr4->sin_addr),
             udp_data_req_p->peer_port);
-        bytes_written = sendto(
-            udp_sd, &udp_data_req_p->buffer[udp_data_req_p->buffer_offset],
-            udp_data_req_p->buffer_length, 0, (struct sockaddr*)&peer_addr,
-            sizeof(struct sockaddr_in));
-        // no free udp_data_req_p->buffer, statically allocated
-
-        if (bytes_written != udp_data_req_p->buffer_length) {
-          OAILOG_ERROR(LOG_UDP,
-                       "There was an error while writing to socket "
-                       "(%d:%s)\n",
-                       errno, strerror(errno));
-        }
       } else if (udp_data_req_p->peer_address->sa_family == AF_INET6) {
-        memset(&peer_addr6, 0, sizeof(struct sockaddr_in6));
-        peer_addr6.sin6_family = AF_INET6;
-        peer_addr6.sin6_port = htons(udp_data_req_p->peer_port);
-        peer_addr6.sin6_addr =
+        struct sockaddr_in6* peer_addr6 = (struct sockaddr_in6*)&peer_addr;
+        peer_addr6->sin6_family = AF_INET6;
+        peer_addr6->sin6_port = htons(udp_data_req_p->peer_port);
+        peer_addr6->sin6_addr =
             ((struct sockaddr_in6*)udp_data_req_p->peer_address)->sin6_addr;
-        pthread_mutex_lock(&udp_socket_list_mutex);
-        udp_sock_p = udp_server_get_socket_desc(
-            ITTI_MSG_ORIGIN_ID(received_message_p), udp_data_req_p->local_port,
-            udp_data_req_p->peer_port, AF_INET6);
-
-        if (udp_sock_p == NULL) {
-          OAILOG_ERROR(LOG_UDP,
-                       "Failed to retrieve the udp socket descriptor for IPv6 "
-                       "associated with task %d\n",
-                       ITTI_MSG_ORIGIN_ID(received_message_p));
-          pthread_mutex_unlock(&udp_socket_list_mutex);
-          // no free udp_data_req_p->buffer, statically allocated
-          break;
-        }
+        peer_addr_len = sizeof(struct sockaddr_in6);
+      } else {
+        OAILOG_DEBUG(LOG_UDP, "Unknown address type");
+        break;
+      }
 
-        udp_sd = udp_sock_p->sd;
+      pthread_mutex_lock(&udp_socket_list_mutex);
+      udp_sock_p = udp_server_get_socket_desc(
+          ITTI_MSG_ORIGIN_ID(received_message_p), udp_data_req_p->local_port,
+          udp_data_req_p->peer_port, peer_addr.ss_family);
+
+      if (udp_sock_p == NULL) {
+        OAILOG_ERROR(LOG_UDP,
+                     "Failed to retrieve the udp socket descriptor for %s "
+                     "associated with task %d\n",
+                     peer_addr.ss_family == AF_INET ? "IPv4" : "IPv6",
+                     ITTI_MSG_ORIGIN_ID(received_message_p));
         pthread_mutex_unlock(&udp_socket_list_mutex);
-        bytes_written = sendto(
-            udp_sd, &udp_data_req_p->buffer[udp_data_req_p->buffer_offset],
-            udp_data_req_p->buffer_length, 0, (struct sockaddr*)&peer_addr6,
-            sizeof(struct sockaddr_in6));
         // no free udp_data_req_p->buffer, statically allocated
-
-        if (bytes_written != udp_data_req_p->buffer_length) {
-          OAILOG_ERROR(LOG_UDP,
-                       "There was an error while writing to socket "
-                       "(%d:%s)\n",
-                       errno, strerror(errno));
-        }
-      }
-
-      else {
-        OAILOG_DEBUG(LOG_UDP, "Unknown address type");
+        break;
       }
 
+      // The payload is copied, so no free udp_data_req_p->buffer
+      udp_server_queue_datagram(
+          udp_sock_p, &udp_data_req_p->buffer[udp_data_req_p->buffer_offset],
+          udp_data_req_p->buffer_length, &peer_addr, peer_addr_len);
+      pthread_mutex_unlock(&udp_socket_list_mutex);
     } break;
 
     default: {
@@ -485,6 +612,12 @@ static int handle_message(zloop_t* loop, zsock_t* reader, void* arg) {
 
   itti_free_msg_content(received_message_p);
   free(received_message_p);
+
+  /* Keep queueing while more requests are waiting in the mailbox, so that
+   * back to back UDP_DATA_REQs go out with a single sendmmsg */
+  if (!(zsock_events(reader) & ZMQ_POLLIN)) {
+    udp_server_flush_all_send_queues();
+  }
   return 0;
 }
 
@@ -517,6 +650,7 @@ int udp_init(void) {
 void udp_exit(void) {
   struct udp_socket_desc_s* socket_desc_p = NULL;
   while ((socket_desc_p = STAILQ_FIRST(&udp_socket_list))) {
+    udp_server_flush_send_queue(socket_desc_p);
     close(socket_desc_p->sd);
     pthread_mutex_destroy(&udp_socket_list_mutex);
     STAILQ_REMOVE_HEAD(&udp_socket_list, entries);
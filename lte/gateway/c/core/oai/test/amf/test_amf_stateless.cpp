@@ -736,6 +736,27 @@ TEST_F(AMFAppStatelessTest, TestAfterRegistrationComplete) {
   put_amf_ue_state(amf_app_desc_p, imsi64, false);
   EXPECT_EQ(AMFClientServicer::getInstance().map_imsi_ue_proto_str.size(), 1);
 
+  // An unchanged UE context is neither serialized nor written again
+  uint64_t version = ue_context_p->state_sync.version;
+  AMFClientServicer::getInstance().map_imsi_ue_proto_str.clear();
+  put_amf_ue_state(amf_app_desc_p, imsi64, false);
+  EXPECT_TRUE(AMFClientServicer::getInstance().map_imsi_ue_proto_str.isEmpty());
+  EXPECT_EQ(ue_context_p->state_sync.version, version);
+
+  // It is written again once a message handler marked it modified
+  n2cause_e rel_cause = ue_context_p->ue_context_rel_cause;
+  ue_context_p->ue_context_rel_cause = NGAP_NAS_DEREGISTER;
+  mark_amf_ue_state_dirty(amf_app_desc_p, imsi64);
+  put_amf_ue_state(amf_app_desc_p, imsi64, false);
+  EXPECT_EQ(AMFClientServicer::getInstance().map_imsi_ue_proto_str.size(), 1);
+  EXPECT_EQ(ue_context_p->state_sync.version, version + 1);
+
+  ue_context_p->ue_context_rel_cause = rel_cause;
+  mark_amf_ue_state_dirty(amf_app_desc_p, imsi64);
+  AMFClientServicer::getInstance().map_imsi_ue_proto_str.clear();
+  put_amf_ue_state(amf_app_desc_p, imsi64, false);
+  EXPECT_EQ(ue_context_p->state_sync.version, version + 2);
+
   // Calling pseudo_amf_stop() and SetUp() simulates a service restart.
   AMFAppStatelessTest::pseudo_amf_stop();
   // Check if state data is cleared in AMF after pseudo_amf_stop()
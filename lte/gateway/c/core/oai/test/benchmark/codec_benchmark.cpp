@@ -0,0 +1,377 @@
+/**
+ * Copyright 2022 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <benchmark/benchmark.h>
+#include <poll.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+extern "C" {
+#include "lte/gateway/c/core/common/dynamic_memory_check.h"
+#include "lte/gateway/c/core/oai/common/itti_free_defined_msg.h"
+#include "lte/gateway/c/core/oai/common/TLVDecoder.h"
+#include "lte/gateway/c/core/oai/lib/3gpp/3gpp_24.007.h"
+#include "lte/gateway/c/core/oai/lib/3gpp/3gpp_24.301.h"
+#include "lte/gateway/c/core/oai/lib/bstr/bstrlib.h"
+#include "lte/gateway/c/core/oai/lib/itti/intertask_interface.h"
+#include "lte/gateway/c/core/oai/lib/secu/secu_defs.h"
+#include "lte/gateway/c/core/oai/tasks/nas/api/network/nas_message.h"
+#include "lte/gateway/c/core/oai/tasks/nas/emm/emm_data.h"
+#include "lte/gateway/c/core/oai/tasks/nas/emm/msg/AttachRequest.h"
+#include "lte/gateway/c/core/oai/tasks/nas/esm/msg/esm_msg.h"
+#include "lte/gateway/c/core/oai/tasks/nas/ies/NasSecurityAlgorithms.h"
+}
+
+#include "lte/gateway/c/core/oai/tasks/s1ap/s1ap_mme_decoder.hpp"
+#include "lte/gateway/c/core/oai/tasks/s1ap/s1ap_mme_decoder_pool.hpp"
+
+/**
+ * Benchmarks for the S1AP APER and NAS codecs and for the NAS security
+ * algorithms.
+ *
+ * The S1AP PDUs are the eNB captures replayed by the S1AP handler tests in
+ * test/s1ap_task.
+ */
+namespace magma {
+namespace lte {
+
+namespace {
+
+const std::vector<uint8_t> kS1SetupRequest = {
+    0x00, 0x11, 0x00, 0x2f, 0x00, 0x00, 0x04, 0x00, 0x3b, 0x00, 0x09,
+    0x00, 0x00, 0xf1, 0x10, 0x40, 0x00, 0x00, 0x00, 0xa0, 0x00, 0x3c,
+    0x40, 0x0b, 0x80, 0x09, 0x22, 0x52, 0x41, 0x44, 0x49, 0x53, 0x59,
+    0x53, 0x22, 0x00, 0x40, 0x00, 0x07, 0x00, 0x00, 0x00, 0x40, 0x00,
+    0xf1, 0x10, 0x00, 0x89, 0x40, 0x01, 0x00};
+
+const std::vector<uint8_t> kInitialUeMessage = {
+    0x00, 0x0c, 0x40, 0x48, 0x00, 0x00, 0x05, 0x00, 0x08, 0x00, 0x02,
+    0x00, 0x01, 0x00, 0x1a, 0x00, 0x20, 0x1f, 0x07, 0x41, 0x71, 0x08,
+    0x09, 0x10, 0x10, 0x00, 0x00, 0x00, 0x00, 0x10, 0x02, 0xe0, 0xe0,
+    0x00, 0x04, 0x02, 0x01, 0xd0, 0x11, 0x40, 0x08, 0x04, 0x02, 0x60,
+    0x04, 0x00, 0x02, 0x1c, 0x00, 0x00, 0x43, 0x00, 0x06, 0x00, 0x00,
+    0xf1, 0x10, 0x00, 0x01, 0x00, 0x64, 0x40, 0x08, 0x00, 0x00, 0xf1,
+    0x10, 0x00, 0x00, 0x00, 0xa0, 0x00, 0x86, 0x40, 0x01, 0x30};
+
+const std::vector<uint8_t> kUplinkNasTransport = {
+    0x00, 0x0d, 0x40, 0x3d, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x02,
+    0x00, 0x07, 0x00, 0x08, 0x00, 0x02, 0x00, 0x01, 0x00, 0x1a, 0x00,
+    0x14, 0x13, 0x07, 0x53, 0x10, 0x1e, 0x63, 0x7e, 0x5c, 0x58, 0xec,
+    0x5a, 0xa8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x64, 0x40, 0x08, 0x00, 0x00, 0xf1, 0x10, 0x00, 0x00, 0x00, 0xa0,
+    0x00, 0x43, 0x40, 0x06, 0x00, 0x00, 0xf1, 0x10, 0x00, 0x01};
+
+const std::vector<uint8_t> kInitialContextSetupResponse = {
+    0x20, 0x09, 0x00, 0x22, 0x00, 0x00, 0x03, 0x00, 0x00, 0x40,
+    0x02, 0x00, 0x07, 0x00, 0x08, 0x40, 0x02, 0x00, 0x01, 0x00,
+    0x33, 0x40, 0x0f, 0x00, 0x00, 0x32, 0x40, 0x0a, 0x0a, 0x1f,
+    0xc0, 0xa8, 0x3c, 0x8d, 0x0a, 0x00, 0x01, 0x28};
+
+const std::vector<uint8_t> kUeContextReleaseRequest = {
+    0x00, 0x12, 0x40, 0x15, 0x00, 0x00, 0x03, 0x00, 0x00,
+    0x00, 0x02, 0x00, 0x07, 0x00, 0x08, 0x00, 0x02, 0x00,
+    0x01, 0x00, 0x02, 0x40, 0x02, 0x02, 0x80};
+
+// Combined attach request, after the EMM header, from the s1ap tester
+const std::vector<uint8_t> kAttachRequest = {
+    0x72, 0x08, 0x09, 0x10, 0x10, 0x00, 0x00, 0x00, 0x00, 0x10,
+    0x02, 0xe0, 0xe0, 0x00, 0x04, 0x02, 0x01, 0xd0, 0x11, 0x40,
+    0x08, 0x04, 0x02, 0x60, 0x04, 0x00, 0x02, 0x1c, 0x00};
+
+// PDN connectivity request carried by the attach request above
+const std::vector<uint8_t> kPdnConnectivityRequest = {0x02, 0x01, 0xd0, 0x11};
+
+const size_t NAS_BUFFER_LEN = 1024;
+
+}  // namespace
+
+static void BM_S1apDecode(benchmark::State& state,
+                          const std::vector<uint8_t>& bytes) {
+  bstring raw = blk2bstr(bytes.data(), bytes.size());
+  for (auto _ : state) {
+    S1ap_S1AP_PDU_t pdu = {};
+    if (s1ap_mme_decode_pdu(&pdu, raw) != RETURNok) {
+      state.SkipWithError("Failed to decode the PDU");
+      break;
+    }
+    ASN_STRUCT_FREE_CONTENTS_ONLY(asn_DEF_S1ap_S1AP_PDU, &pdu);
+  }
+  state.SetBytesProcessed(state.iterations() * bytes.size());
+  bdestroy_wrapper(&raw);
+}
+BENCHMARK_CAPTURE(BM_S1apDecode, s1_setup_request, kS1SetupRequest);
+BENCHMARK_CAPTURE(BM_S1apDecode, initial_ue_message, kInitialUeMessage);
+BENCHMARK_CAPTURE(BM_S1apDecode, uplink_nas_transport, kUplinkNasTransport);
+BENCHMARK_CAPTURE(BM_S1apDecode, initial_context_setup_response,
+                  kInitialContextSetupResponse);
+BENCHMARK_CAPTURE(BM_S1apDecode, ue_context_release_request,
+                  kUeContextReleaseRequest);
+
+// s1ap_mme_encode_pdu only takes the procedures the MME sends and frees the
+// PDU, so the captures are encoded with the APER encoder it calls
+static void BM_S1apEncode(benchmark::State& state,
+                          const std::vector<uint8_t>& bytes) {
+  bstring raw = blk2bstr(bytes.data(), bytes.size());
+  S1ap_S1AP_PDU_t pdu = {};
+  if (s1ap_mme_decode_pdu(&pdu, raw) != RETURNok) {
+    state.SkipWithError("Failed to decode the PDU");
+  }
+  bdestroy_wrapper(&raw);
+  for (auto _ : state) {
+    asn_encode_to_new_buffer_result_t res = asn_encode_to_new_buffer(
+        NULL, ATS_ALIGNED_CANONICAL_PER, &asn_DEF_S1ap_S1AP_PDU, &pdu);
+    if (res.buffer == NULL) {
+      state.SkipWithError("Failed to encode the PDU");
+      break;
+    }
+    free(res.buffer);
+  }
+  state.SetBytesProcessed(state.iterations() * bytes.size());
+  ASN_STRUCT_FREE_CONTENTS_ONLY(asn_DEF_S1ap_S1AP_PDU, &pdu);
+}
+BENCHMARK_CAPTURE(BM_S1apEncode, s1_setup_request, kS1SetupRequest);
+BENCHMARK_CAPTURE(BM_S1apEncode, initial_ue_message, kInitialUeMessage);
+BENCHMARK_CAPTURE(BM_S1apEncode, initial_context_setup_response,
+                  kInitialContextSetupResponse);
+
+static MessageDef* make_sctp_data_ind(sctp_assoc_id_t assoc_id,
+                                      const std::vector<uint8_t>& bytes) {
+  MessageDef* message = static_cast<MessageDef*>(calloc(1, sizeof(*message)));
+  ITTI_MSG_ID(message) = SCTP_DATA_IND;
+  SCTP_DATA_IND(message).assoc_id = assoc_id;
+  SCTP_DATA_IND(message).payload = blk2bstr(bytes.data(), bytes.size());
+  return message;
+}
+
+// Initial UE messages of 16 eNBs decoded by the S1apDecoderPool, the
+// argument is the number of decoder threads. The handler only counts the
+// PDUs, as the S1AP task would handle them on its own thread.
+static void BM_S1apDecoderPool(benchmark::State& state) {
+  const int64_t burst = 256;
+  const sctp_assoc_id_t nb_enbs = 16;
+  int64_t handled = 0;
+  int64_t failed = 0;
+  S1apDecoderPool pool(state.range(0),
+                       [&handled, &failed](MessageDef* message,
+                                           S1ap_S1AP_PDU_t* pdu) {
+                         handled++;
+                         failed += pdu == nullptr;
+                         itti_free_msg_content(message);
+                         free(message);
+                       });
+  struct pollfd pfd = {pool.event_fd(), POLLIN, 0};
+  for (auto _ : state) {
+    const int64_t expected = handled + burst;
+    for (int64_t i = 0; i < burst; i++) {
+      pool.dispatch(1 + i % nb_enbs,
+                    make_sctp_data_ind(1 + i % nb_enbs, kInitialUeMessage));
+    }
+    while (handled < expected) {
+      poll(&pfd, 1, -1);
+      pool.process_decoded();
+    }
+  }
+  if (failed > 0) {
+    state.SkipWithError("Failed to decode the PDU");
+  }
+  state.SetItemsProcessed(handled);
+}
+BENCHMARK(BM_S1apDecoderPool)
+    ->ArgName("threads")
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime();
+
+// The argument decodes the variable length IEs as views into the buffer
+static void BM_NasAttachRequestDecode(benchmark::State& state) {
+  std::vector<uint8_t> buffer = kAttachRequest;
+  for (auto _ : state) {
+    tlv_decoder_views_t views = tlv_decoder_views_open();
+    tlv_decoder_views_enable(state.range(0));
+    attach_request_msg attach_request = {};
+    int decoded =
+        decode_attach_request(&attach_request, buffer.data(), buffer.size());
+    bdestroy_wrapper(&attach_request.esmmessagecontainer);
+    bdestroy_wrapper(&attach_request.supportedcodecs);
+    tlv_decoder_views_close(views);
+    if (decoded < 0) {
+      state.SkipWithError("Failed to decode the attach request");
+      break;
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK(BM_NasAttachRequestDecode)->ArgName("views")->Arg(0)->Arg(1);
+
+static void BM_NasAttachRequestEncode(benchmark::State& state) {
+  std::vector<uint8_t> buffer = kAttachRequest;
+  attach_request_msg attach_request = {};
+  int decoded =
+      decode_attach_request(&attach_request, buffer.data(), buffer.size());
+  uint8_t out[NAS_BUFFER_LEN];
+  for (auto _ : state) {
+    int encoded = encode_attach_request(&attach_request, out, NAS_BUFFER_LEN);
+    benchmark::DoNotOptimize(encoded);
+  }
+  state.SetBytesProcessed(state.iterations() * decoded);
+  bdestroy_wrapper(&attach_request.esmmessagecontainer);
+  bdestroy_wrapper(&attach_request.supportedcodecs);
+}
+BENCHMARK(BM_NasAttachRequestEncode);
+
+static void BM_NasEsmDecode(benchmark::State& state) {
+  std::vector<uint8_t> buffer = kPdnConnectivityRequest;
+  for (auto _ : state) {
+    ESM_msg msg = {};
+    if (esm_msg_decode(&msg, buffer.data(), buffer.size()) < 0) {
+      state.SkipWithError("Failed to decode the ESM message");
+      break;
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK(BM_NasEsmDecode);
+
+static void BM_NasEsmEncode(benchmark::State& state) {
+  std::vector<uint8_t> buffer = kPdnConnectivityRequest;
+  ESM_msg msg = {};
+  esm_msg_decode(&msg, buffer.data(), buffer.size());
+  uint8_t out[NAS_BUFFER_LEN];
+  for (auto _ : state) {
+    int encoded = esm_msg_encode(&msg, out, NAS_BUFFER_LEN);
+    benchmark::DoNotOptimize(encoded);
+  }
+  state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK(BM_NasEsmEncode);
+
+// Security context with the given EEA and EIA, both taken as arguments
+static emm_security_context_t make_security_context(
+    const benchmark::State& state) {
+  emm_security_context_t security = {};
+  for (int i = 0; i < AUTH_KNAS_ENC_SIZE; i++) {
+    security.knas_enc[i] = i;
+  }
+  for (int i = 0; i < AUTH_KNAS_INT_SIZE; i++) {
+    security.knas_int[i] = 0xff - i;
+  }
+  security.selected_algorithms.encryption = state.range(0);
+  security.selected_algorithms.integrity = state.range(1);
+  security.activated = 1;
+  security.direction_encode = SECU_DIRECTION_UPLINK;
+  security.direction_decode = SECU_DIRECTION_UPLINK;
+  return security;
+}
+
+static nas_message_security_header_t make_security_header() {
+  nas_message_security_header_t header = {};
+  header.protocol_discriminator = EPS_MOBILITY_MANAGEMENT_MESSAGE;
+  header.security_header_type =
+      SECURITY_HEADER_TYPE_INTEGRITY_PROTECTED_CYPHERED;
+  header.sequence_number = 1;
+  return header;
+}
+
+static void nas_security_args(benchmark::internal::Benchmark* b) {
+  const int algorithms[] = {0, 1, 2};
+  for (int eea : algorithms) {
+    for (int eia : algorithms) {
+      b->Args({eea, eia});
+    }
+  }
+}
+
+// The plain message is the attach request, with its EMM header
+static std::vector<uint8_t> plain_nas_message() {
+  std::vector<uint8_t> plain = {0x07, 0x41};
+  plain.insert(plain.end(), kAttachRequest.begin(), kAttachRequest.end());
+  return plain;
+}
+
+static void BM_NasEncrypt(benchmark::State& state) {
+  const emm_security_context_t initial = make_security_context(state);
+  const nas_message_security_header_t header = make_security_header();
+  std::vector<uint8_t> plain = plain_nas_message();
+  const size_t length = plain.size() + NAS_MESSAGE_SECURITY_HEADER_SIZE;
+  uint8_t out[NAS_BUFFER_LEN];
+  for (auto _ : state) {
+    // The counts move with every message, start from the same ones each time
+    emm_security_context_t security = initial;
+    int bytes = nas_message_encrypt(plain.data(), out, &header, length,
+                                    &security);
+    benchmark::DoNotOptimize(bytes);
+  }
+  state.SetBytesProcessed(state.iterations() * plain.size());
+}
+BENCHMARK(BM_NasEncrypt)->Apply(nas_security_args);
+
+static void BM_NasDecrypt(benchmark::State& state) {
+  const emm_security_context_t initial = make_security_context(state);
+  nas_message_security_header_t header = make_security_header();
+  std::vector<uint8_t> plain = plain_nas_message();
+  const size_t length = plain.size() + NAS_MESSAGE_SECURITY_HEADER_SIZE;
+  uint8_t protected_msg[NAS_BUFFER_LEN];
+  emm_security_context_t security = initial;
+  nas_message_encrypt(plain.data(), protected_msg, &header, length, &security);
+
+  uint8_t out[NAS_BUFFER_LEN];
+  for (auto _ : state) {
+    security = initial;
+    nas_message_decode_status_t status = {};
+    int bytes = nas_message_decrypt(protected_msg, out, &header, length,
+                                    &security, &status);
+    benchmark::DoNotOptimize(bytes);
+  }
+  state.SetBytesProcessed(state.iterations() * plain.size());
+}
+BENCHMARK(BM_NasDecrypt)->Apply(nas_security_args);
+
+// Full decode of the protected attach request, the last argument decrypts
+// into the decoder scratch space and decodes the IEs as views
+static void BM_NasMessageDecode(benchmark::State& state) {
+  const emm_security_context_t initial = make_security_context(state);
+  nas_message_security_header_t header = make_security_header();
+  std::vector<uint8_t> plain = plain_nas_message();
+  const size_t length = plain.size() + NAS_MESSAGE_SECURITY_HEADER_SIZE;
+  uint8_t protected_msg[NAS_BUFFER_LEN];
+  emm_security_context_t security = initial;
+  nas_message_encrypt(plain.data(), protected_msg, &header, length, &security);
+
+  for (auto _ : state) {
+    security = initial;
+    tlv_decoder_views_t views = tlv_decoder_views_open();
+    tlv_decoder_views_enable(state.range(2));
+    nas_message_t msg = {};
+    nas_message_decode_status_t status = {};
+    int bytes =
+        nas_message_decode(protected_msg, &msg, length, &security, &status);
+    bdestroy_wrapper(&msg.plain.emm.attach_request.esmmessagecontainer);
+    bdestroy_wrapper(&msg.plain.emm.attach_request.supportedcodecs);
+    tlv_decoder_views_close(views);
+    if (bytes < 0) {
+      state.SkipWithError("Failed to decode the NAS message");
+      break;
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * plain.size());
+}
+BENCHMARK(BM_NasMessageDecode)
+    ->ArgNames({"eea", "eia", "views"})
+    ->Args({2, 2, 0})
+    ->Args({2, 2, 1});
+
+}  // namespace lte
+}  // namespace magma
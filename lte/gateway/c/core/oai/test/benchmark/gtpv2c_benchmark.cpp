@@ -0,0 +1,196 @@
+/**
+ * Copyright 2022 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <arpa/inet.h>
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include <vector>
+
+extern "C" {
+#include "lte/gateway/c/core/oai/lib/gtpv2-c/nwgtpv2c-0.11/include/NwGtpv2c.h"
+#include "lte/gateway/c/core/oai/lib/gtpv2-c/nwgtpv2c-0.11/include/NwGtpv2cPrivate.h"
+#include "lte/gateway/c/core/oai/lib/gtpv2-c/nwgtpv2c-0.11/shared/NwGtpv2cMsg.h"
+}
+
+/**
+ * Benchmarks for the nwgtpv2c stack: the cost of a request/response
+ * transaction, with its retransmission timer and duplicate detection, sent
+ * by the MME stack and answered by a stand-in peer stack in the same thread.
+ * The UDP and timer manager entities are replaced by in-memory stand-ins so
+ * that no socket or event loop is measured.
+ */
+namespace magma {
+namespace lte {
+
+namespace {
+
+constexpr int MME = 0;
+constexpr int PEER = 1;
+constexpr uint16_t GTPV2C_PORT = 2123;
+
+struct packet_t {
+  uint8_t buf[NW_GTPV2C_MAX_MSG_LEN];
+  uint32_t len;
+};
+
+struct endpoint_t {
+  nw_gtpv2c_stack_handle_t stack;
+  struct sockaddr_in addr;
+  // Packets sent to this endpoint and not yet processed
+  std::vector<packet_t> rx_queue;
+  // The stack runs one Timer Manager timer at a time
+  bool timer_armed;
+  uint64_t timer_deadline_ms;
+};
+
+endpoint_t endpoints[2];
+int64_t responses = 0;
+
+uint64_t now_ms() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000ULL + ts.tv_nsec / 1000000;
+}
+
+nw_rc_t udp_data_req(nw_gtpv2c_udp_handle_t udp_handle, uint8_t* buf,
+                     uint32_t len, uint16_t local_port, struct sockaddr* peer,
+                     uint16_t peer_port) {
+  packet_t packet;
+  memcpy(packet.buf, buf, len);
+  packet.len = len;
+  endpoints[1 - udp_handle].rx_queue.push_back(packet);
+  return NW_OK;
+}
+
+nw_rc_t timer_start(nw_gtpv2c_timer_mgr_handle_t tmr_mgr_handle,
+                    uint32_t timeout_ms, uint32_t tmr_type, void* timeout_arg,
+                    nw_gtpv2c_timer_handle_t* timer_handle) {
+  endpoint_t* endpoint = &endpoints[tmr_mgr_handle];
+  endpoint->timer_armed = true;
+  endpoint->timer_deadline_ms = now_ms() + timeout_ms;
+  *timer_handle = 1;
+  return NW_OK;
+}
+
+nw_rc_t timer_stop(nw_gtpv2c_timer_mgr_handle_t tmr_mgr_handle,
+                   nw_gtpv2c_timer_handle_t timer_handle) {
+  endpoints[tmr_mgr_handle].timer_armed = false;
+  return NW_OK;
+}
+
+nw_rc_t ulp_req(nw_gtpv2c_ulp_handle_t ulp_handle,
+                nw_gtpv2c_ulp_api_t* api) {
+  nw_gtpv2c_stack_handle_t stack = endpoints[ulp_handle].stack;
+  switch (api->apiType & 0x00FFFFFF) {
+    case NW_GTPV2C_ULP_API_INITIAL_REQ_IND: {
+      // The peer answers each Modify Bearer Request right away
+      nw_gtpv2c_ulp_api_t rsp;
+      memset(&rsp, 0, sizeof(rsp));
+      nwGtpv2cMsgDelete(stack, api->hMsg);
+      rsp.apiType = NW_GTPV2C_ULP_API_TRIGGERED_RSP;
+      rsp.u_api_info.triggeredRspInfo.hTrxn =
+          api->u_api_info.initialReqIndInfo.hTrxn;
+      nwGtpv2cMsgNew(stack, true, NW_GTP_MODIFY_BEARER_RSP, 0, 0, &rsp.hMsg);
+      nwGtpv2cProcessUlpReq(stack, &rsp);
+    } break;
+    case NW_GTPV2C_ULP_API_TRIGGERED_RSP_IND:
+      responses++;
+      nwGtpv2cMsgDelete(stack, api->hMsg);
+      break;
+    default:
+      break;
+  }
+  return NW_OK;
+}
+
+void init_endpoint(int index) {
+  endpoint_t* endpoint = &endpoints[index];
+  endpoint->addr.sin_family = AF_INET;
+  endpoint->addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK + index);
+  endpoint->timer_armed = false;
+  nwGtpv2cInitialize(&endpoint->stack);
+
+  nw_gtpv2c_ulp_entity_t ulp = {};
+  ulp.hUlp = index;
+  ulp.ulpReqCallback = ulp_req;
+  nwGtpv2cSetUlpEntity(endpoint->stack, &ulp);
+  nw_gtpv2c_udp_entity_t udp = {};
+  udp.hUdp = index;
+  udp.gtpv2cStandardPort = GTPV2C_PORT;
+  udp.udpDataReqCallback = udp_data_req;
+  nwGtpv2cSetUdpEntity(endpoint->stack, &udp);
+  nw_gtpv2c_timer_mgr_entity_t tmr_mgr = {};
+  tmr_mgr.tmrMgrHandle = index;
+  tmr_mgr.tmrStartCallback = timer_start;
+  tmr_mgr.tmrStopCallback = timer_stop;
+  nwGtpv2cSetTimerMgrEntity(endpoint->stack, &tmr_mgr);
+}
+
+// Deliver the queued packets, then fire the stack timer if it is due
+void pump(int index) {
+  endpoint_t* endpoint = &endpoints[index];
+  std::vector<packet_t> packets;
+  packets.swap(endpoint->rx_queue);
+  for (packet_t& packet : packets) {
+    nwGtpv2cProcessUdpReq(endpoint->stack, packet.buf, packet.len,
+                          GTPV2C_PORT, GTPV2C_PORT,
+                          (struct sockaddr*)&endpoints[1 - index].addr);
+  }
+  if (endpoint->timer_armed && now_ms() >= endpoint->timer_deadline_ms) {
+    endpoint->timer_armed = false;
+    nwGtpv2cProcessTimeout((void*)endpoint->stack);
+  }
+}
+
+void send_request() {
+  nw_gtpv2c_ulp_api_t req;
+  memset(&req, 0, sizeof(req));
+  req.apiType = NW_GTPV2C_ULP_API_INITIAL_REQ;
+  nwGtpv2cMsgNew(endpoints[MME].stack, true, NW_GTP_MODIFY_BEARER_REQ, 0, 0,
+                 &req.hMsg);
+  req.u_api_info.initialReqInfo.edns_peer_ip =
+      (struct sockaddr*)&endpoints[PEER].addr;
+  req.u_api_info.initialReqInfo.teidLocal = 1;
+  nwGtpv2cProcessUlpReq(endpoints[MME].stack, &req);
+}
+
+}  // namespace
+
+// The argument is the number of transactions outstanding at once, each one
+// holds a timer and an entry in the transaction maps of both stacks
+static void BM_Gtpv2cTransaction(benchmark::State& state) {
+  init_endpoint(MME);
+  init_endpoint(PEER);
+  responses = 0;
+
+  const int64_t burst = state.range(0);
+  for (auto _ : state) {
+    for (int64_t i = 0; i < burst; i++) {
+      send_request();
+    }
+    pump(PEER);
+    pump(MME);
+  }
+  state.SetItemsProcessed(responses);
+
+  nwGtpv2cFinalize(endpoints[MME].stack);
+  nwGtpv2cFinalize(endpoints[PEER].stack);
+  endpoints[MME].rx_queue.clear();
+  endpoints[PEER].rx_queue.clear();
+}
+BENCHMARK(BM_Gtpv2cTransaction)->Arg(1)->Arg(64)->Arg(1024);
+
+}  // namespace lte
+}  // namespace magma
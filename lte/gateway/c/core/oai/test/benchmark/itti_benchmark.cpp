@@ -0,0 +1,153 @@
+/**
+ * Copyright 2022 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+extern "C" {
+#include "lte/gateway/c/core/common/dynamic_memory_check.h"
+#include "lte/gateway/c/core/oai/common/log.h"
+#define CHECK_PROTOTYPE_ONLY
+#include "lte/gateway/c/core/oai/lib/itti/intertask_interface_init.h"
+#undef CHECK_PROTOTYPE_ONLY
+#include "lte/gateway/c/core/oai/common/itti_free_defined_msg.h"
+#include "lte/gateway/c/core/oai/lib/bstr/bstrlib.h"
+#include "lte/gateway/c/core/oai/lib/hashtable/hashtable.h"
+#include "lte/gateway/c/core/oai/lib/itti/intertask_interface.h"
+#include "lte/gateway/c/core/oai/lib/itti/intertask_interface_types.h"
+}
+
+/**
+ * Benchmarks for the ITTI message passing and the thread safe hashtable, the
+ * two structures every OAI task goes through for each procedure.
+ */
+const task_info_t tasks_info[] = {
+    {THREAD_NULL, "TASK_UNKNOWN", "ipc://IPC_TASK_UNKNOWN"},
+#define TASK_DEF(tHREADiD) \
+  {THREAD_##tHREADiD, #tHREADiD, "ipc://IPC_" #tHREADiD},
+#include "lte/gateway/c/core/oai/include/tasks_def.h"
+#undef TASK_DEF
+};
+
+/* Map message id to message information */
+const message_info_t messages_info[] = {
+#define MESSAGE_DEF(iD, sTRUCT, fIELDnAME) {iD, sizeof(sTRUCT), #iD},
+#include "lte/gateway/c/core/oai/include/messages_def.h"
+#undef MESSAGE_DEF
+};
+
+namespace magma {
+namespace lte {
+
+namespace {
+
+void free_msg(MessageDef* msg) {
+  itti_free_msg_content(msg);
+  free(msg);
+}
+
+// The table only holds fake pointers to the UE index
+void free_nothing(void** element) {}
+
+}  // namespace
+
+// Both tasks live in the benchmark thread, so that only the cost of ITTI is
+// measured and not the scheduling of the receiving thread. The argument is
+// the number of messages queued before the receiver drains them.
+static void BM_IttiSendReceive(benchmark::State& state) {
+  itti_init(TASK_MAX, THREAD_MAX, MESSAGES_ID_MAX, tasks_info, messages_info,
+            NULL, NULL);
+  task_zmq_ctx_t sender = {}, receiver = {};
+  task_id_t sender_peers[] = {TASK_TEST_2};
+  task_id_t receiver_peers[] = {TASK_TEST_1};
+  init_task_context(TASK_TEST_1, sender_peers, 1, NULL, &sender);
+  init_task_context(TASK_TEST_2, receiver_peers, 1, NULL, &receiver);
+
+  const int64_t burst = state.range(0);
+  for (auto _ : state) {
+    for (int64_t i = 0; i < burst; i++) {
+      MessageDef* msg =
+          DEPRECATEDitti_alloc_new_message_fatal(TASK_TEST_1, TEST_MESSAGE);
+      send_msg_to_task(&sender, TASK_TEST_2, msg);
+    }
+    for (int64_t i = 0; i < burst; i++) {
+      free_msg(receive_msg(receiver.pull_sock));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * burst);
+
+  destroy_task_context(&sender);
+  destroy_task_context(&receiver);
+  itti_free_desc_threads();
+}
+BENCHMARK(BM_IttiSendReceive)->Arg(1)->Arg(64)->Arg(1024);
+
+static void BM_IttiAllocFree(benchmark::State& state) {
+  itti_init(TASK_MAX, THREAD_MAX, MESSAGES_ID_MAX, tasks_info, messages_info,
+            NULL, NULL);
+  for (auto _ : state) {
+    MessageDef* msg = DEPRECATEDitti_alloc_new_message_fatal(
+        TASK_S1AP, MME_APP_INITIAL_CONTEXT_SETUP_RSP);
+    benchmark::DoNotOptimize(msg);
+    free_msg(msg);
+  }
+  state.SetItemsProcessed(state.iterations());
+  itti_free_desc_threads();
+}
+BENCHMARK(BM_IttiAllocFree);
+
+// The hashtable benchmarks take the number of UEs in the table as argument
+static hash_table_ts_t* create_filled_table(int64_t num_ues) {
+  bstring name = bfromcstr("benchmark_ht");
+  hash_table_ts_t* table =
+      hashtable_ts_create(num_ues, NULL, free_nothing, name);
+  bdestroy_wrapper(&name);
+  for (int64_t i = 0; i < num_ues; i++) {
+    hashtable_ts_insert(table, (hash_key_t)i, (void*)(i + 1));
+  }
+  return table;
+}
+
+static void BM_HashtableTsGet(benchmark::State& state) {
+  const int64_t num_ues = state.range(0);
+  hash_table_ts_t* table = create_filled_table(num_ues);
+  hash_key_t key = 0;
+  void* element = nullptr;
+  for (auto _ : state) {
+    hashtable_ts_get(table, key, &element);
+    benchmark::DoNotOptimize(element);
+    // Walk the keys with a stride so that consecutive lookups miss the cache
+    key = (key + 7919) % num_ues;
+  }
+  state.SetItemsProcessed(state.iterations());
+  hashtable_ts_destroy(table);
+}
+BENCHMARK(BM_HashtableTsGet)->Arg(1000)->Arg(10000)->Arg(100000);
+
+static void BM_HashtableTsInsertRemove(benchmark::State& state) {
+  const int64_t num_ues = state.range(0);
+  hash_table_ts_t* table = create_filled_table(num_ues);
+  hash_key_t key = num_ues;
+  void* element = nullptr;
+  for (auto _ : state) {
+    hashtable_ts_insert(table, key, (void*)1);
+    hashtable_ts_remove(table, key, &element);
+    key++;
+  }
+  state.SetItemsProcessed(state.iterations());
+  hashtable_ts_destroy(table);
+}
+BENCHMARK(BM_HashtableTsInsertRemove)->Arg(1000)->Arg(10000)->Arg(100000);
+
+}  // namespace lte
+}  // namespace magma
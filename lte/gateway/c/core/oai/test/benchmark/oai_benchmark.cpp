@@ -0,0 +1,36 @@
+/**
+ * Copyright 2022 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <benchmark/benchmark.h>
+
+extern "C" {
+#include "lte/gateway/c/core/oai/common/log.h"
+}
+
+/**
+ * Benchmarks for the OAI core hot paths: ITTI, hashtables, S1AP and NAS
+ * codecs, NAS security and state conversion.
+ *
+ * Run with --benchmark_format=json (or --benchmark_out=<file>
+ * --benchmark_out_format=json) to track results between releases, and
+ * --benchmark_filter=<regex> to run some of them.
+ */
+int main(int argc, char** argv) {
+  // Only errors are logged, so that logging does not skew the results
+  OAILOG_INIT("MME", OAILOG_LEVEL_ERROR, MAX_LOG_PROTOS);
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  ::benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
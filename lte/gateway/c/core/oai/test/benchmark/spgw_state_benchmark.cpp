@@ -0,0 +1,127 @@
+/**
+ * Copyright 2022 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+extern "C" {
+#include "lte/gateway/c/core/oai/common/conversions.h"
+#include "lte/gateway/c/core/oai/include/sgw_context_manager.h"
+#include "lte/gateway/c/core/oai/include/spgw_config.h"
+}
+
+#include "lte/gateway/c/core/oai/include/spgw_state.hpp"
+#include "lte/gateway/c/core/oai/tasks/sgw/spgw_state_converter.hpp"
+#include "lte/protos/oai/spgw_state.pb.h"
+
+/**
+ * Benchmarks for the conversion of the SPGW UE contexts to and from the
+ * protos stored in Redis, at 1k, 10k and 100k UEs.
+ */
+namespace magma {
+namespace lte {
+
+namespace {
+
+const uint64_t kFirstImsi = 1010000000000;
+const teid_t kFirstTeid = 100;
+
+class SpgwStateGuard {
+ public:
+  SpgwStateGuard() {
+    spgw_config_init(&config_);
+    spgw_state_init(false, &config_);
+  }
+  ~SpgwStateGuard() { spgw_state_exit(); }
+
+  // The UE contexts restored from protos go into the global state, which is
+  // emptied between iterations
+  void reset() {
+    spgw_state_exit();
+    spgw_state_init(false, &config_);
+  }
+
+ private:
+  spgw_config_t config_ = {};
+};
+
+// UE with one S11 bearer context, like make_bearer_context of the SPGW tests
+spgw_ue_context_t* make_spgw_ue_context(uint32_t index) {
+  imsi64_t imsi64 = kFirstImsi + index;
+  teid_t teid = kFirstTeid + index;
+  spgw_ue_context_t* ue_context = spgw_create_or_get_ue_context(imsi64);
+  spgw_update_teid_in_ue_context(imsi64, teid);
+
+  s_plus_p_gw_eps_bearer_context_information_t* ctx =
+      sgw_cm_create_bearer_context_information_in_collection(teid);
+  auto sgw = &ctx->sgw_eps_bearer_context_information;
+  auto pgw = &ctx->pgw_eps_bearer_context_information;
+  IMSI64_TO_STRING(imsi64, (char*)(&pgw->imsi.digit), IMSI_BCD_DIGITS_MAX);
+  strncpy(pgw->msisdn, "msisdn", sizeof(pgw->msisdn) - 1);
+  sgw->imsi64 = imsi64;
+  IMSI64_TO_STRING(imsi64, (char*)(&sgw->imsi.digit), IMSI_BCD_DIGITS_MAX);
+  sgw->mme_teid_S11 = teid;
+  sgw->s_gw_teid_S11_S4 = teid;
+  return ue_context;
+}
+
+void ue_count_args(benchmark::internal::Benchmark* b) {
+  b->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+}
+
+}  // namespace
+
+static void BM_SpgwUeContextToProto(benchmark::State& state) {
+  SpgwStateGuard spgw_state;
+  const uint32_t num_ues = state.range(0);
+  std::vector<spgw_ue_context_t*> contexts;
+  for (uint32_t i = 0; i < num_ues; i++) {
+    contexts.push_back(make_spgw_ue_context(i));
+  }
+  std::vector<oai::SpgwUeContext> protos(num_ues);
+  for (auto _ : state) {
+    for (uint32_t i = 0; i < num_ues; i++) {
+      protos[i].Clear();
+      SpgwStateConverter::ue_to_proto(contexts[i], &protos[i]);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_ues);
+}
+BENCHMARK(BM_SpgwUeContextToProto)->Apply(ue_count_args);
+
+static void BM_SpgwUeContextFromProto(benchmark::State& state) {
+  SpgwStateGuard spgw_state;
+  const uint32_t num_ues = state.range(0);
+  std::vector<oai::SpgwUeContext> protos(num_ues);
+  for (uint32_t i = 0; i < num_ues; i++) {
+    SpgwStateConverter::ue_to_proto(make_spgw_ue_context(i), &protos[i]);
+  }
+  for (auto _ : state) {
+    state.PauseTiming();
+    spgw_state.reset();
+    state.ResumeTiming();
+    for (uint32_t i = 0; i < num_ues; i++) {
+      // The UE context is owned by the state once restored
+      spgw_ue_context_t* ue_context =
+          (spgw_ue_context_t*)calloc(1, sizeof(spgw_ue_context_t));
+      SpgwStateConverter::proto_to_ue(protos[i], ue_context);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_ues);
+}
+BENCHMARK(BM_SpgwUeContextFromProto)->Apply(ue_count_args);
+
+}  // namespace lte
+}  // namespace magma
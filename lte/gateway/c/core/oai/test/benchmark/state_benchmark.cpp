@@ -0,0 +1,311 @@
+/**
+ * Copyright 2022 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "lte/gateway/c/core/common/dynamic_memory_check.h"
+#include "lte/gateway/c/core/oai/include/mme_config.h"
+#include "lte/gateway/c/core/oai/lib/3gpp/3gpp_23.003.h"
+#include "lte/gateway/c/core/oai/tasks/nas/emm/emm_data.h"
+#include "lte/gateway/c/core/oai/tasks/nas/esm/esm_proc.h"
+}
+
+#include "lte/gateway/c/core/oai/common/redis_utils/redis_client.hpp"
+#include "lte/gateway/c/core/oai/common/redis_utils/redis_writer_pool.hpp"
+#include "lte/gateway/c/core/oai/include/mme_app_ue_context.h"
+#include "lte/gateway/c/core/oai/include/s1ap_state.hpp"
+#include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_state_converter.hpp"
+#include "lte/gateway/c/core/oai/tasks/s1ap/s1ap_state_converter.hpp"
+#include "lte/protos/oai/mme_nas_state.pb.h"
+#include "lte/protos/oai/s1ap_state.pb.h"
+
+/**
+ * Benchmarks for the conversion of the MME and S1AP UE contexts to and from
+ * the protos stored in Redis, as done for every UE when the MME writes or
+ * reads back its state.
+ *
+ * Every benchmark takes the number of UEs as argument and converts all of
+ * them in one iteration, except BM_MmeUeStateWrite.
+ */
+namespace magma {
+namespace lte {
+
+namespace {
+
+const uint64_t kFirstImsi = 1010000000000;
+
+void ue_count_args(benchmark::internal::Benchmark* b) {
+  b->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+}
+
+imsi_t make_imsi(imsi64_t imsi64) {
+  imsi_t imsi = {};
+  uint8_t digits[15];
+  for (int i = 14; i >= 0; i--) {
+    digits[i] = imsi64 % 10;
+    imsi64 /= 10;
+  }
+  imsi.u.num.digit1 = digits[0];
+  imsi.u.num.digit2 = digits[1];
+  imsi.u.num.digit3 = digits[2];
+  imsi.u.num.digit4 = digits[3];
+  imsi.u.num.digit5 = digits[4];
+  imsi.u.num.digit6 = digits[5];
+  imsi.u.num.digit7 = digits[6];
+  imsi.u.num.digit8 = digits[7];
+  imsi.u.num.digit9 = digits[8];
+  imsi.u.num.digit10 = digits[9];
+  imsi.u.num.digit11 = digits[10];
+  imsi.u.num.digit12 = digits[11];
+  imsi.u.num.digit13 = digits[12];
+  imsi.u.num.digit14 = digits[13];
+  imsi.u.num.digit15 = digits[14];
+  imsi.u.num.parity = 0xF;
+  return imsi;
+}
+
+// Registered UE with a PDN connectivity in progress, like the ones
+// mme_app_test_protobuf_serialization creates
+ue_mm_context_t* make_ue_mm_context(uint32_t index) {
+  ue_mm_context_t* ue_context = mme_create_new_ue_context();
+  emm_context_t* emm_ctx = &ue_context->emm_context;
+  imsi64_t imsi64 = kFirstImsi + index;
+  imsi_t imsi = make_imsi(imsi64);
+  emm_ctx->saved_imsi64 = imsi64;
+  emm_ctx_set_valid_imsi(emm_ctx, &imsi, imsi64);
+
+  guti_t guti = {};
+  guti.gummei.plmn.mcc_digit1 = 0;
+  guti.gummei.plmn.mcc_digit2 = 0;
+  guti.gummei.plmn.mcc_digit3 = 1;
+  guti.gummei.plmn.mnc_digit1 = 0;
+  guti.gummei.plmn.mnc_digit2 = 1;
+  guti.gummei.plmn.mnc_digit3 = 0xF;
+  guti.gummei.mme_gid = 1;
+  guti.gummei.mme_code = 1;
+  guti.m_tmsi = index;
+  emm_ctx_set_valid_guti(emm_ctx, &guti);
+  emm_ctx->emm_cause = -1;
+  emm_ctx->_emm_fsm_state = EMM_REGISTERED;
+
+  esm_context_t* esm_ctx = &emm_ctx->esm_ctx;
+  esm_ctx->n_active_ebrs = 1;
+  esm_ctx->esm_proc_data =
+      (struct esm_proc_data_s*)calloc(1, sizeof(struct esm_proc_data_s));
+  esm_ctx->esm_proc_data->pti = 1;
+  esm_ctx->esm_proc_data->request_type = 1;
+  esm_ctx->esm_proc_data->apn = bfromcstr("internet");
+  esm_ctx->esm_proc_data->pdn_type = ESM_PDN_TYPE_IPV4;
+  esm_ctx->esm_proc_data->bearer_qos.qci = 9;
+
+  ue_context->mme_ue_s1ap_id = index + 1;
+  ue_context->enb_ue_s1ap_id = index & 0x00FFFFFF;
+  MME_APP_ENB_S1AP_ID_KEY(ue_context->enb_s1ap_id_key, 1,
+                          ue_context->enb_ue_s1ap_id);
+  return ue_context;
+}
+
+void free_ue_mm_contexts(std::vector<ue_mm_context_t*>* contexts) {
+  for (ue_mm_context_t*& ue_context : *contexts) {
+    mme_app_state_free_ue_context((void**)&ue_context);
+  }
+  contexts->clear();
+}
+
+class MmeConfigGuard {
+ public:
+  MmeConfigGuard() { mme_config_init(&mme_config); }
+  ~MmeConfigGuard() { free_mme_config(&mme_config); }
+};
+
+}  // namespace
+
+static void BM_MmeUeContextToProto(benchmark::State& state) {
+  MmeConfigGuard config;
+  const uint32_t num_ues = state.range(0);
+  std::vector<ue_mm_context_t*> contexts;
+  for (uint32_t i = 0; i < num_ues; i++) {
+    contexts.push_back(make_ue_mm_context(i));
+  }
+  std::vector<oai::UeContext> protos(num_ues);
+  for (auto _ : state) {
+    for (uint32_t i = 0; i < num_ues; i++) {
+      protos[i].Clear();
+      MmeNasStateConverter::ue_to_proto(contexts[i], &protos[i]);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_ues);
+  free_ue_mm_contexts(&contexts);
+}
+BENCHMARK(BM_MmeUeContextToProto)->Apply(ue_count_args);
+
+static void BM_MmeUeContextFromProto(benchmark::State& state) {
+  MmeConfigGuard config;
+  const uint32_t num_ues = state.range(0);
+  std::vector<oai::UeContext> protos(num_ues);
+  for (uint32_t i = 0; i < num_ues; i++) {
+    ue_mm_context_t* ue_context = make_ue_mm_context(i);
+    MmeNasStateConverter::ue_to_proto(ue_context, &protos[i]);
+    mme_app_state_free_ue_context((void**)&ue_context);
+  }
+  std::vector<ue_mm_context_t*> contexts;
+  contexts.reserve(num_ues);
+  for (auto _ : state) {
+    for (uint32_t i = 0; i < num_ues; i++) {
+      ue_mm_context_t* ue_context =
+          (ue_mm_context_t*)calloc(1, sizeof(ue_mm_context_t));
+      MmeNasStateConverter::proto_to_ue(protos[i], ue_context);
+      contexts.push_back(ue_context);
+    }
+    state.PauseTiming();
+    free_ue_mm_contexts(&contexts);
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * num_ues);
+}
+BENCHMARK(BM_MmeUeContextFromProto)->Apply(ue_count_args);
+
+/**
+ * Writes the state of 1000 UEs to the redis configured in redis.yml the way
+ * MME_APP does after each message, through STATE_WRITER_THREADS writers (the
+ * argument) or synchronously for 0. Each iteration waits for the writes to
+ * land, so the items per second are the UE state writes MME_APP can sustain.
+ */
+static void BM_MmeUeStateWrite(benchmark::State& state) {
+  MmeConfigGuard config;
+  const uint32_t num_ues = 1000;
+  const uint32_t num_writers = state.range(0);
+  std::unique_ptr<RedisClient> client;
+  std::unique_ptr<RedisWriterPool> writers;
+  try {
+    client = std::make_unique<RedisClient>(true);
+    if (num_writers > 0) {
+      writers =
+          std::make_unique<RedisWriterPool>(num_writers, true, LOG_MME_APP);
+    }
+  } catch (const std::exception& e) {
+    state.SkipWithError(e.what());
+    return;
+  }
+  std::vector<ue_mm_context_t*> contexts;
+  // Not the keys of MME_APP, the benchmark may run next to a live MME
+  std::vector<std::string> keys;
+  for (uint32_t i = 0; i < num_ues; i++) {
+    contexts.push_back(make_ue_mm_context(i));
+    keys.push_back("IMSI" + std::to_string(kFirstImsi + i) + ":BENCHMARK");
+  }
+  uint64_t version = 0;
+  for (auto _ : state) {
+    for (uint32_t i = 0; i < num_ues; i++) {
+      oai::UeContext proto;
+      std::string proto_str;
+      MmeNasStateConverter::ue_to_proto(contexts[i], &proto);
+      RedisClient::serialize(proto, proto_str);
+      benchmark::DoNotOptimize(std::hash<std::string>{}(proto_str));
+      if (writers) {
+        writers->write_proto_str(keys[i], std::move(proto_str), version);
+      } else if (client->write_proto_str(keys[i], proto_str, version) !=
+                 RETURNok) {
+        state.SkipWithError("Failed to write UE state to redis");
+        break;
+      }
+    }
+    if (writers) {
+      writers->flush();
+    }
+    version++;
+  }
+  state.SetItemsProcessed(state.iterations() * num_ues);
+  writers.reset();
+  client->clear_keys(keys);
+  free_ue_mm_contexts(&contexts);
+}
+BENCHMARK(BM_MmeUeStateWrite)
+    ->ArgName("writers")
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+static ue_description_t* make_ue_description(uint32_t index) {
+  ue_description_t* ue = (ue_description_t*)calloc(1, sizeof(ue_description_t));
+  ue->s1_ue_state = S1AP_UE_CONNECTED;
+  ue->enb_ue_s1ap_id = index & 0x00FFFFFF;
+  ue->mme_ue_s1ap_id = index + 1;
+  ue->sctp_assoc_id = 1;
+  ue->comp_s1ap_id = S1AP_GENERATE_COMP_S1AP_ID(ue->sctp_assoc_id,
+                                                ue->enb_ue_s1ap_id);
+  ue->sctp_stream_recv = 1;
+  ue->sctp_stream_send = 1;
+  return ue;
+}
+
+static void BM_S1apUeDescriptionToProto(benchmark::State& state) {
+  const uint32_t num_ues = state.range(0);
+  std::vector<ue_description_t*> ues;
+  for (uint32_t i = 0; i < num_ues; i++) {
+    ues.push_back(make_ue_description(i));
+  }
+  std::vector<oai::UeDescription> protos(num_ues);
+  for (auto _ : state) {
+    for (uint32_t i = 0; i < num_ues; i++) {
+      protos[i].Clear();
+      S1apStateConverter::ue_to_proto(ues[i], &protos[i]);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_ues);
+  for (ue_description_t* ue : ues) {
+    free(ue);
+  }
+}
+BENCHMARK(BM_S1apUeDescriptionToProto)->Apply(ue_count_args);
+
+static void BM_S1apUeDescriptionFromProto(benchmark::State& state) {
+  const uint32_t num_ues = state.range(0);
+  std::vector<oai::UeDescription> protos(num_ues);
+  for (uint32_t i = 0; i < num_ues; i++) {
+    ue_description_t* ue = make_ue_description(i);
+    S1apStateConverter::ue_to_proto(ue, &protos[i]);
+    free(ue);
+  }
+  std::vector<ue_description_t*> ues;
+  ues.reserve(num_ues);
+  for (auto _ : state) {
+    for (uint32_t i = 0; i < num_ues; i++) {
+      ue_description_t* ue =
+          (ue_description_t*)calloc(1, sizeof(ue_description_t));
+      S1apStateConverter::proto_to_ue(protos[i], ue);
+      ues.push_back(ue);
+    }
+    state.PauseTiming();
+    for (ue_description_t* ue : ues) {
+      free(ue);
+    }
+    ues.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * num_ues);
+}
+BENCHMARK(BM_S1apUeDescriptionFromProto)->Apply(ue_count_args);
+
+}  // namespace lte
+}  // namespace magma
@@ -0,0 +1,160 @@
+/**
+ * Copyright 2022 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <vector>
+
+extern "C" {
+#include "lte/gateway/c/core/oai/lib/gtpv2-c/nwgtpv2c-0.11/include/NwGtpv2c.h"
+#include "lte/gateway/c/core/oai/lib/gtpv2-c/nwgtpv2c-0.11/include/NwGtpv2cPrivate.h"
+#include "lte/gateway/c/core/oai/lib/gtpv2-c/nwgtpv2c-0.11/include/NwGtpv2cTrxn.h"
+}
+
+namespace magma {
+namespace lte {
+
+// Stand-in Timer Manager, the stack runs at most one timer through it
+static bool timer_armed = false;
+static uint32_t timer_timeout_ms = 0;
+static int nb_expired = 0;
+
+static nw_rc_t timer_start(nw_gtpv2c_timer_mgr_handle_t tmr_mgr_handle,
+                           uint32_t timeout_ms, uint32_t tmr_type,
+                           void* timeout_arg,
+                           nw_gtpv2c_timer_handle_t* timer_handle) {
+  EXPECT_FALSE(timer_armed);
+  timer_armed = true;
+  timer_timeout_ms = timeout_ms;
+  *timer_handle = 1;
+  return NW_OK;
+}
+
+static nw_rc_t timer_stop(nw_gtpv2c_timer_mgr_handle_t tmr_mgr_handle,
+                          nw_gtpv2c_timer_handle_t timer_handle) {
+  timer_armed = false;
+  return NW_OK;
+}
+
+static nw_rc_t count_expiry(void* arg) {
+  nb_expired++;
+  return NW_OK;
+}
+
+class Gtpv2cStackTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    timer_armed = false;
+    nb_expired = 0;
+    ASSERT_EQ(NW_OK, nwGtpv2cInitialize(&stack_handle));
+    stack = reinterpret_cast<nw_gtpv2c_stack_t*>(stack_handle);
+    nw_gtpv2c_timer_mgr_entity_t tmr_mgr = {};
+    tmr_mgr.tmrStartCallback = timer_start;
+    tmr_mgr.tmrStopCallback = timer_stop;
+    ASSERT_EQ(NW_OK, nwGtpv2cSetTimerMgrEntity(stack_handle, &tmr_mgr));
+  }
+
+  void TearDown() override { nwGtpv2cFinalize(stack_handle); }
+
+  nw_gtpv2c_stack_handle_t stack_handle = 0;
+  nw_gtpv2c_stack_t* stack = nullptr;
+};
+
+// More timers than the 10000 of the former fixed size timer heap
+TEST_F(Gtpv2cStackTest, TestTimerWheelGrows) {
+  const int nb_timers = 20000;
+  std::vector<nw_gtpv2c_timer_handle_t> timers(nb_timers);
+  for (int i = 0; i < nb_timers; i++) {
+    ASSERT_EQ(NW_OK, nwGtpv2cStartTimer(stack, 0, 10000 + (i % 7) * 1000,
+                                        NW_GTPV2C_TMR_TYPE_ONE_SHOT,
+                                        count_expiry, nullptr, &timers[i]));
+  }
+  EXPECT_EQ(nb_timers, stack->timerWheel.count);
+  EXPECT_GE(stack->timerWheel.size,
+            nb_timers / NW_GTPV2C_TMR_WHEEL_LOAD_FACTOR);
+  // A single timer of the Timer Manager for the earliest expiry
+  EXPECT_TRUE(timer_armed);
+  EXPECT_LE(timer_timeout_ms, 20);
+
+  for (int i = 0; i < nb_timers; i += 2) {
+    EXPECT_EQ(NW_OK, nwGtpv2cStopTimer(stack, timers[i]));
+  }
+  EXPECT_EQ(NW_FAILURE, nwGtpv2cStopTimer(stack, timers[0]));
+  EXPECT_EQ(nb_timers / 2, stack->timerWheel.count);
+  for (int i = 1; i < nb_timers; i += 2) {
+    EXPECT_EQ(NW_OK, nwGtpv2cStopTimer(stack, timers[i]));
+  }
+  EXPECT_EQ(0, stack->timerWheel.count);
+  EXPECT_FALSE(timer_armed);
+  EXPECT_EQ(0, nb_expired);
+}
+
+TEST_F(Gtpv2cStackTest, TestTimerExpiry) {
+  nw_gtpv2c_timer_handle_t timer = 0;
+  ASSERT_EQ(NW_OK, nwGtpv2cStartTimer(stack, 0, 1, NW_GTPV2C_TMR_TYPE_ONE_SHOT,
+                                      count_expiry, nullptr, &timer));
+  ASSERT_TRUE(timer_armed);
+  usleep(NW_GTPV2C_TMR_WHEEL_TICK_MS * 2 * 1000);
+  timer_armed = false;
+  EXPECT_EQ(NW_OK, nwGtpv2cProcessTimeout(stack));
+  EXPECT_EQ(1, nb_expired);
+  EXPECT_EQ(0, stack->timerWheel.count);
+  EXPECT_FALSE(timer_armed);
+  // An expired timer is no longer running
+  EXPECT_EQ(NW_FAILURE, nwGtpv2cStopTimer(stack, timer));
+}
+
+TEST_F(Gtpv2cStackTest, TestOutstandingRxTransactionMap) {
+  struct sockaddr_in peer = {};
+  peer.sin_family = AF_INET;
+  peer.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  struct sockaddr* peer_addr = reinterpret_cast<struct sockaddr*>(&peer);
+
+  // Enough transactions for the map to grow a few times
+  const uint32_t nb_trxns = 4 * NW_GTPV2C_TRXN_MAP_INITIAL_SIZE *
+                            NW_GTPV2C_TRXN_MAP_LOAD_FACTOR;
+  for (uint32_t seq = 0; seq < nb_trxns; seq++) {
+    EXPECT_NE(nullptr,
+              nwGtpv2cTrxnOutstandingRxNew(stack, 0, peer_addr, 2123, seq));
+  }
+  EXPECT_EQ(nb_trxns, stack->outstandingRxSeqNumMap.count);
+  EXPECT_GT(stack->outstandingRxSeqNumMap.size,
+            NW_GTPV2C_TRXN_MAP_INITIAL_SIZE);
+
+  // Same peer and sequence number: a duplicate request
+  EXPECT_EQ(nullptr, nwGtpv2cTrxnOutstandingRxNew(stack, 0, peer_addr, 2123,
+                                                  nb_trxns / 2));
+  // The peer port is part of the key of received requests
+  EXPECT_NE(nullptr, nwGtpv2cTrxnOutstandingRxNew(stack, 0, peer_addr, 40000,
+                                                  nb_trxns / 2));
+  EXPECT_EQ(nb_trxns + 1, stack->outstandingRxSeqNumMap.count);
+
+  nw_gtpv2c_trxn_t key = {};
+  key.seqNum = 7;
+  memcpy(&key.peer_ip, &peer, sizeof(peer));
+  key.peerPort = 2123;
+  nw_gtpv2c_trxn_t* trxn =
+      nwGtpv2cTrxnMapFind(&stack->outstandingRxSeqNumMap, &key);
+  ASSERT_NE(nullptr, trxn);
+  EXPECT_EQ(7, trxn->seqNum);
+  nwGtpv2cTrxnMapRemove(&stack->outstandingRxSeqNumMap, trxn);
+  nwGtpv2cTrxnDelete(&trxn);
+  EXPECT_EQ(nullptr, nwGtpv2cTrxnMapFind(&stack->outstandingRxSeqNumMap, &key));
+  EXPECT_EQ(nb_trxns, stack->outstandingRxSeqNumMap.count);
+  // The transactions left are freed by nwGtpv2cFinalize()
+}
+
+}  // namespace lte
+}  // namespace magma
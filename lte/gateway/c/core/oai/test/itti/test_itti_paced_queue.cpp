@@ -0,0 +1,143 @@
+/**
+ * Copyright 2020 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "lte/gateway/c/core/oai/lib/itti/itti_paced_queue.h"
+
+namespace {
+
+struct test_job_t {
+  std::string name;
+  std::vector<std::string>* trace;
+  uint32_t processed = 0;
+  int done_count = 0;
+  bool completed = false;
+};
+
+void record_item(void* ctx, uint32_t item_index) {
+  auto* job = static_cast<test_job_t*>(ctx);
+  EXPECT_EQ(item_index, job->processed);
+  job->processed++;
+  job->trace->push_back(job->name);
+}
+
+void record_done(void* ctx, bool completed) {
+  auto* job = static_cast<test_job_t*>(ctx);
+  job->done_count++;
+  job->completed = completed;
+}
+
+class PacedQueueTest : public ::testing::Test {
+ protected:
+  void init(uint32_t items_per_tick, uint32_t max_items_per_sec) {
+    paced_queue_config_t config = {};
+    config.items_per_tick = items_per_tick;
+    config.tick_ms = 10;
+    config.max_items_per_sec = max_items_per_sec;
+    paced_queue_init(&queue, nullptr, LOG_MME_APP, &config);
+  }
+
+  void submit(test_job_t* job, const std::string& name,
+              paced_queue_priority_t priority, uint32_t num_items) {
+    job->name = name;
+    job->trace = &trace;
+    paced_queue_submit(&queue, name.c_str(), priority, num_items, record_item,
+                       record_done, job);
+  }
+
+  virtual void TearDown() { paced_queue_destroy(&queue); }
+
+  paced_queue_t queue;
+  std::vector<std::string> trace;
+};
+
+TEST_F(PacedQueueTest, TestItemsPerTick) {
+  init(4, 0);
+  test_job_t job;
+  submit(&job, "reset", PACED_QUEUE_PRIORITY_NORMAL, 10);
+  EXPECT_EQ(queue.stats.items_pending, 10);
+  EXPECT_EQ(job.processed, 0);
+
+  EXPECT_EQ(paced_queue_run_slice(&queue, 0), 4);
+  EXPECT_EQ(paced_queue_run_slice(&queue, 0), 4);
+  EXPECT_EQ(job.done_count, 0);
+  EXPECT_EQ(paced_queue_run_slice(&queue, 0), 2);
+  EXPECT_EQ(job.processed, 10);
+  EXPECT_EQ(job.done_count, 1);
+  EXPECT_TRUE(job.completed);
+  EXPECT_EQ(paced_queue_run_slice(&queue, 0), 0);
+
+  EXPECT_EQ(queue.stats.items_pending, 0);
+  EXPECT_EQ(queue.stats.jobs_pending, 0);
+  EXPECT_EQ(queue.stats.items_processed, 10);
+  EXPECT_EQ(queue.stats.jobs_completed, 1);
+}
+
+TEST_F(PacedQueueTest, TestPriorities) {
+  init(3, 0);
+  test_job_t low, normal, high;
+  submit(&low, "low", PACED_QUEUE_PRIORITY_LOW, 2);
+  submit(&normal, "normal", PACED_QUEUE_PRIORITY_NORMAL, 2);
+  paced_queue_run_slice(&queue, 0);
+  // The high priority job overtakes the rest of the low priority one
+  submit(&high, "high", PACED_QUEUE_PRIORITY_HIGH, 2);
+  paced_queue_run_slice(&queue, 0);
+
+  std::vector<std::string> expected = {"normal", "normal", "low",
+                                       "high",   "high",   "low"};
+  EXPECT_EQ(trace, expected);
+  EXPECT_EQ(low.done_count, 1);
+  EXPECT_EQ(normal.done_count, 1);
+  EXPECT_EQ(high.done_count, 1);
+}
+
+TEST_F(PacedQueueTest, TestRateLimit) {
+  init(100, 1000);
+  test_job_t job;
+  submit(&job, "deregister", PACED_QUEUE_PRIORITY_NORMAL, 1000);
+
+  // The bucket starts full with one slice
+  uint64_t now_us = queue.last_refill_us;
+  EXPECT_EQ(paced_queue_run_slice(&queue, now_us), 100);
+  EXPECT_EQ(paced_queue_run_slice(&queue, now_us), 0);
+  // 1000 items per second is one item per millisecond
+  now_us += 10 * 1000;
+  EXPECT_EQ(paced_queue_run_slice(&queue, now_us), 10);
+  now_us += 500;
+  EXPECT_EQ(paced_queue_run_slice(&queue, now_us), 0);
+  now_us += 500;
+  EXPECT_EQ(paced_queue_run_slice(&queue, now_us), 1);
+  // An idle period does not allow more than one slice
+  now_us += 10 * 1000 * 1000;
+  EXPECT_EQ(paced_queue_run_slice(&queue, now_us), 100);
+}
+
+TEST_F(PacedQueueTest, TestEmptyAndDroppedJobs) {
+  init(2, 0);
+  test_job_t empty, dropped;
+  submit(&empty, "empty", PACED_QUEUE_PRIORITY_NORMAL, 0);
+  EXPECT_EQ(empty.done_count, 1);
+  EXPECT_TRUE(empty.completed);
+
+  submit(&dropped, "dropped", PACED_QUEUE_PRIORITY_NORMAL, 5);
+  paced_queue_run_slice(&queue, 0);
+  paced_queue_destroy(&queue);
+  EXPECT_EQ(dropped.processed, 2);
+  EXPECT_EQ(dropped.done_count, 1);
+  EXPECT_FALSE(dropped.completed);
+  EXPECT_EQ(queue.stats.items_pending, 0);
+}
+
+}  // namespace
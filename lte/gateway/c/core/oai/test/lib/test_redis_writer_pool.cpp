@@ -0,0 +1,232 @@
+/**
+ * Copyright 2022 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lte/gateway/c/core/oai/common/redis_utils/redis_writer_pool.hpp"
+
+namespace magma {
+namespace lte {
+
+namespace {
+
+// Version recorded for the removal of a key
+const uint64_t kCleared = UINT64_MAX;
+
+// What the fake clients applied, shared by all the workers of a pool
+class FakeRedis {
+ public:
+  status_code_e apply(const std::string& key, uint64_t version) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    blocked_.wait(lock, [this] { return !blocking_; });
+    applied_[key].push_back(version);
+    return failing_keys_.count(key) ? RETURNerror : RETURNok;
+  }
+
+  // Holds the workers in their next operation until unblock()
+  void block() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    blocking_ = true;
+  }
+
+  void unblock() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      blocking_ = false;
+    }
+    blocked_.notify_all();
+  }
+
+  void set_failing(const std::string& key, bool failing) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (failing) {
+      failing_keys_.insert(key);
+    } else {
+      failing_keys_.erase(key);
+    }
+  }
+
+  std::map<std::string, std::vector<uint64_t>> applied() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return applied_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable blocked_;
+  bool blocking_ = false;
+  std::set<std::string> failing_keys_;
+  std::map<std::string, std::vector<uint64_t>> applied_;
+};
+
+class FakeRedisClient : public RedisClient {
+ public:
+  explicit FakeRedisClient(FakeRedis* redis)
+      : RedisClient(false), redis_(redis) {}
+
+  status_code_e write_proto_str(const std::string& key,
+                                const std::string& proto_msg,
+                                uint64_t version) override {
+    return redis_->apply(key, version);
+  }
+
+  status_code_e clear_keys(
+      const std::vector<std::string>& keys_to_clear) override {
+    status_code_e rc = RETURNok;
+    for (const auto& key : keys_to_clear) {
+      if (redis_->apply(key, kCleared) != RETURNok) {
+        rc = RETURNerror;
+      }
+    }
+    return rc;
+  }
+
+ private:
+  FakeRedis* redis_;
+};
+
+}  // namespace
+
+class RedisWriterPoolTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<RedisWriterPool> make_pool(uint32_t num_workers) {
+    return std::make_unique<RedisWriterPool>(
+        num_workers,
+        [this] { return std::make_unique<FakeRedisClient>(&redis_); },
+        LOG_MME_APP);
+  }
+
+  FakeRedis redis_;
+};
+
+TEST_F(RedisWriterPoolTest, TestWritesOfKeyStayOrdered) {
+  auto pool = make_pool(4);
+  const size_t num_keys = 32;
+  const uint64_t num_versions = 50;
+
+  for (uint64_t version = 0; version < num_versions; version++) {
+    for (size_t i = 0; i < num_keys; i++) {
+      pool->write_proto_str("IMSI" + std::to_string(i), "state", version);
+    }
+  }
+  pool->clear_keys({"IMSI0", "IMSI1"});
+  pool->flush();
+
+  auto applied = redis_.applied();
+  ASSERT_EQ(applied.size(), num_keys);
+  for (size_t i = 0; i < num_keys; i++) {
+    const auto& versions = applied["IMSI" + std::to_string(i)];
+    size_t expected_size = num_versions + (i < 2 ? 1 : 0);
+    ASSERT_EQ(versions.size(), expected_size);
+    for (uint64_t version = 0; version < num_versions; version++) {
+      EXPECT_EQ(versions[version], version);
+    }
+    if (i < 2) {
+      EXPECT_EQ(versions.back(), kCleared);
+    }
+  }
+  EXPECT_EQ(pool->failed_operations(), 0u);
+}
+
+TEST_F(RedisWriterPoolTest, TestFlushWaitsForQueuedWrites) {
+  auto pool = make_pool(2);
+
+  redis_.block();
+  pool->write_proto_str("IMSI0", "state", 1);
+  pool->write_proto_str("IMSI1", "state", 1);
+  EXPECT_TRUE(redis_.applied().empty());
+  std::thread unblocker([this] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    redis_.unblock();
+  });
+  pool->flush();
+  auto applied = redis_.applied();
+  unblocker.join();
+
+  EXPECT_EQ(applied["IMSI0"], std::vector<uint64_t>{1});
+  EXPECT_EQ(applied["IMSI1"], std::vector<uint64_t>{1});
+}
+
+TEST_F(RedisWriterPoolTest, TestDestructorAppliesQueuedWrites) {
+  auto pool = make_pool(3);
+
+  redis_.block();
+  for (uint64_t version = 0; version < 10; version++) {
+    pool->write_proto_str("IMSI0", "state", version);
+    pool->write_proto_str("IMSI1", "state", version);
+  }
+  pool->clear_keys({"IMSI1"});
+  std::thread unblocker([this] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    redis_.unblock();
+  });
+  pool.reset();
+  unblocker.join();
+
+  auto applied = redis_.applied();
+  EXPECT_EQ(applied["IMSI0"].size(), 10u);
+  EXPECT_EQ(applied["IMSI0"].back(), 9u);
+  EXPECT_EQ(applied["IMSI1"].size(), 11u);
+  EXPECT_EQ(applied["IMSI1"].back(), kCleared);
+}
+
+TEST_F(RedisWriterPoolTest, TestFailedWriteIsReported) {
+  auto pool = make_pool(2);
+
+  redis_.set_failing("IMSI0", true);
+  pool->write_proto_str("IMSI0", "state", 1);
+  pool->write_proto_str("IMSI1", "state", 1);
+  pool->flush();
+
+  EXPECT_EQ(pool->failed_operations(), 1u);
+  EXPECT_FALSE(pool->take_failed("IMSI1"));
+  EXPECT_TRUE(pool->take_failed("IMSI0"));
+  // Reported once, the caller writes the key again
+  EXPECT_FALSE(pool->take_failed("IMSI0"));
+
+  pool->write_proto_str("IMSI0", "state", 2);
+  pool->flush();
+  EXPECT_TRUE(pool->take_failed("IMSI0"));
+
+  // A later successful write supersedes a failed one
+  pool->write_proto_str("IMSI0", "state", 3);
+  redis_.set_failing("IMSI0", false);
+  pool->write_proto_str("IMSI0", "state", 4);
+  pool->flush();
+  EXPECT_FALSE(pool->take_failed("IMSI0"));
+}
+
+TEST_F(RedisWriterPoolTest, TestFailedRemovalIsNotReported) {
+  auto pool = make_pool(1);
+
+  redis_.set_failing("IMSI0", true);
+  pool->write_proto_str("IMSI0", "state", 1);
+  pool->clear_keys({"IMSI0"});
+  pool->flush();
+
+  EXPECT_EQ(pool->failed_operations(), 2u);
+  EXPECT_FALSE(pool->take_failed("IMSI0"));
+}
+
+}  // namespace lte
+}  // namespace magma
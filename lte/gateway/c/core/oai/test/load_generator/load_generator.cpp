@@ -0,0 +1,734 @@
+/**
+ * Copyright 2022 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "lte/gateway/c/core/oai/test/load_generator/load_generator.h"
+
+#include <arpa/inet.h>
+#include <pthread.h>
+#include <algorithm>
+#include <thread>
+
+extern "C" {
+#include "lte/gateway/c/core/common/assertions.h"
+#include "lte/gateway/c/core/common/dynamic_memory_check.h"
+#include "lte/gateway/c/core/oai/common/conversions.h"
+#include "lte/gateway/c/core/oai/common/itti_free_defined_msg.h"
+#include "lte/gateway/c/core/oai/lib/3gpp/3gpp_24.301.h"
+#include "lte/gateway/c/core/oai/tasks/nas/api/network/nas_message.h"
+}
+
+#include "lte/gateway/c/core/oai/lib/mobility_client/MobilityClientAPI.hpp"
+#include "lte/gateway/c/core/oai/lib/pcef/pcef_handlers.hpp"
+#include "lte/gateway/c/core/oai/tasks/s1ap/s1ap_mme_decoder.hpp"
+#include "lte/gateway/c/core/oai/test/mme_app_task/mme_app_test_util.h"
+#include "lte/gateway/c/core/oai/test/s1ap_task/s1ap_enb_test_utils.h"
+
+namespace magma {
+namespace lte {
+
+namespace {
+
+const tac_t kTac = 1;
+const uint32_t kEnbId = 1;
+const sctp_assoc_id_t kAssocId = 1;
+const uint16_t kStreams = 2;
+// The S1 Setup is sent on stream 0, the UE associated signalling on stream 1
+const sctp_stream_id_t kUeStream = 1;
+// S1-U address of the eNB, 192.168.60.141
+const uint32_t kEnbIpv4 = 0xc0a83c8d;
+const uint32_t kS1SetupTimeoutMs = 5000;
+// UE addresses are allocated from 10.0.0.1 by index
+const uint32_t kFirstUeIpv4 = 0x0a000001;
+// Only stored by the MME
+const uint8_t kUeRadioCapability[16] = {0};
+
+using Clock = std::chrono::steady_clock;
+
+uint32_t elapsed_us(Clock::time_point since) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() -
+                                                               since)
+      .count();
+}
+
+// Nearest rank percentile of sorted samples
+double percentile_ms(const std::vector<uint32_t>& sorted, double percentile) {
+  if (sorted.empty()) {
+    return 0;
+  }
+  size_t rank = (size_t)(percentile / 100 * sorted.size() + 0.5);
+  rank = std::min(std::max(rank, (size_t)1), sorted.size());
+  return sorted[rank - 1] / 1000.0;
+}
+
+}  // namespace
+
+const char* procedure_name(Procedure procedure) {
+  switch (procedure) {
+    case Procedure::PROC_ATTACH:
+      return "attach";
+    case Procedure::PROC_S1_RELEASE:
+      return "s1_release";
+    case Procedure::PROC_SERVICE_REQUEST:
+      return "service_request";
+    case Procedure::PROC_PAGING:
+      return "paging";
+    case Procedure::PROC_TAU:
+      return "tau";
+    case Procedure::PROC_DETACH:
+      return "detach";
+    default:
+      return "unknown";
+  }
+}
+
+LoadGenerator::LoadGenerator(const LoadGeneratorConfig& config)
+    : config_(config), tai_{}, ecgi_{}, random_(config.seed) {
+  // 001/01, the PLMN of the MME procedure tests
+  tai_.plmn.mcc_digit1 = 0;
+  tai_.plmn.mcc_digit2 = 0;
+  tai_.plmn.mcc_digit3 = 1;
+  tai_.plmn.mnc_digit1 = 0;
+  tai_.plmn.mnc_digit2 = 1;
+  tai_.plmn.mnc_digit3 = 0xf;
+  tai_.tac = kTac;
+  ecgi_.plmn = tai_.plmn;
+  ecgi_.cell_identity.enb_id = kEnbId;
+  for (uint32_t i = 0; i < config_.num_ues; i++) {
+    std::string imsi = std::to_string(config_.first_imsi + i);
+    // IMSIs are 15 digits long, left padded with the leading zeros of the
+    // MCC
+    imsi.insert(0, IMSI_BCD_DIGITS_MAX - std::min(imsi.size(),
+                                                  (size_t)IMSI_BCD_DIGITS_MAX),
+                '0');
+    ues_.emplace_back(new Ue(imsi, htonl(kFirstUeIpv4 + i)));
+    ue_by_imsi_[imsi] = i;
+  }
+}
+
+bool LoadGenerator::setup_enb() {
+  uint32_t enb_ipv4 = htonl(kEnbIpv4);
+  MessageDef* message_p =
+      itti_alloc_new_message(TASK_SCTP, SCTP_NEW_ASSOCIATION);
+  SCTP_NEW_ASSOCIATION(message_p).instreams = kStreams;
+  SCTP_NEW_ASSOCIATION(message_p).outstreams = kStreams;
+  SCTP_NEW_ASSOCIATION(message_p).assoc_id = kAssocId;
+  SCTP_NEW_ASSOCIATION(message_p).ran_cp_ipaddr =
+      blk2bstr(&enb_ipv4, sizeof(enb_ipv4));
+  send_msg_to_task(&task_zmq_ctx_main, TASK_S1AP, message_p);
+
+  bstring payload = nullptr;
+  if (generate_s1_setup_request(kEnbId, tai_, &payload) != RETURNok) {
+    return false;
+  }
+  send_to_s1ap(0, payload);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  return enb_ready_cv_.wait_for(lock,
+                                std::chrono::milliseconds(kS1SetupTimeoutMs),
+                                [this] { return enb_ready_; });
+}
+
+void LoadGenerator::start() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  started_ = Clock::now();
+  for (uint32_t i = 0; i < ues_.size(); i++) {
+    start_procedure(i);
+  }
+}
+
+void LoadGenerator::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  while (true) {
+    check_timeouts();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!running_) {
+        stopped_ = Clock::now();
+        return;
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+}
+
+void LoadGenerator::check_timeouts() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& ue : ues_) {
+    if (ue->running && elapsed_us(ue->started) / 1000 > config_.timeout_ms) {
+      stats_[(int)ue->procedure].timeouts++;
+      ue->running = false;
+      ue->retired = true;
+      running_--;
+    }
+  }
+}
+
+void LoadGenerator::print_report(FILE* out) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  double duration_sec =
+      std::chrono::duration_cast<std::chrono::milliseconds>(stopped_ -
+                                                            started_)
+          .count() /
+      1000.0;
+  uint32_t retired = 0;
+  for (auto& ue : ues_) {
+    retired += ue->retired;
+  }
+  fprintf(out, "%u UEs, %.1f s, %u UEs retired on timeout\n", config_.num_ues,
+          duration_sec, retired);
+  fprintf(out, "%-16s %8s %8s %8s %10s %8s %8s %8s %8s\n", "procedure",
+          "count", "failed", "timeout", "per_sec", "p50_ms", "p90_ms",
+          "p99_ms", "max_ms");
+  for (int i = 0; i < (int)Procedure::PROC_COUNT; i++) {
+    std::vector<uint32_t> sorted = stats_[i].latencies_us;
+    std::sort(sorted.begin(), sorted.end());
+    fprintf(out, "%-16s %8zu %8u %8u %10.1f %8.2f %8.2f %8.2f %8.2f\n",
+            procedure_name((Procedure)i), sorted.size(), stats_[i].failures,
+            stats_[i].timeouts,
+            duration_sec > 0 ? sorted.size() / duration_sec : 0,
+            percentile_ms(sorted, 50), percentile_ms(sorted, 90),
+            percentile_ms(sorted, 99), percentile_ms(sorted, 100));
+  }
+}
+
+bool LoadGenerator::find_ue(mme_ue_s1ap_id_t mme_ue_s1ap_id,
+                            uint32_t* index) const {
+  auto it = ue_by_mme_ue_s1ap_id_.find(mme_ue_s1ap_id);
+  if (it == ue_by_mme_ue_s1ap_id_.end()) {
+    return false;
+  }
+  *index = it->second;
+  return true;
+}
+
+bool LoadGenerator::find_ue(mme_ue_s1ap_id_t mme_ue_s1ap_id,
+                            enb_ue_s1ap_id_t enb_ue_s1ap_id, uint32_t* index) {
+  if (enb_ue_s1ap_id == 0 || enb_ue_s1ap_id > ues_.size()) {
+    return false;
+  }
+  *index = enb_ue_s1ap_id - 1;
+  Ue& ue = *ues_[*index];
+  if (ue.mme_ue_s1ap_id != mme_ue_s1ap_id) {
+    ue_by_mme_ue_s1ap_id_.erase(ue.mme_ue_s1ap_id);
+    ue.mme_ue_s1ap_id = mme_ue_s1ap_id;
+    ue_by_mme_ue_s1ap_id_[mme_ue_s1ap_id] = *index;
+  }
+  return true;
+}
+
+Procedure LoadGenerator::next_procedure(const Ue& ue) {
+  if (!ue.registered) {
+    return Procedure::PROC_ATTACH;
+  }
+  if (ue.connected) {
+    return Procedure::PROC_S1_RELEASE;
+  }
+  uint32_t total = 0;
+  for (uint32_t weight : config_.weights) {
+    total += weight;
+  }
+  if (!total) {
+    return Procedure::PROC_TAU;
+  }
+  uint32_t pick =
+      std::uniform_int_distribution<uint32_t>(0, total - 1)(random_);
+  for (int i = 0; i < (int)Procedure::PROC_COUNT; i++) {
+    if (pick < config_.weights[i]) {
+      return (Procedure)i;
+    }
+    pick -= config_.weights[i];
+  }
+  return Procedure::PROC_TAU;
+}
+
+void LoadGenerator::start_procedure(uint32_t index) {
+  Ue& ue = *ues_[index];
+  if (stopping_ || ue.retired) {
+    return;
+  }
+  ue.procedure = next_procedure(ue);
+  ue.running = true;
+  ue.failed = false;
+  ue.started = Clock::now();
+  running_++;
+
+  std::vector<uint8_t> nas;
+  long rrc_cause = S1ap_RRC_Establishment_Cause_mo_Signalling;
+  switch (ue.procedure) {
+    case Procedure::PROC_ATTACH:
+      ue.nas.reset();
+      nas = ue.nas.attach_request();
+      break;
+    case Procedure::PROC_S1_RELEASE: {
+      bstring payload = nullptr;
+      if (generate_ue_context_release_request(
+              ue.mme_ue_s1ap_id, enb_ue_s1ap_id(index),
+              S1ap_CauseRadioNetwork_user_inactivity, &payload) == RETURNok) {
+        send_to_s1ap(kUeStream, payload);
+      }
+    }
+      return;
+    case Procedure::PROC_PAGING:
+      // As if pipelined had seen downlink data for the UE, the service
+      // request is sent on the paging
+      ue.paged = false;
+      send_paging_request(ue.ipv4);
+      return;
+    case Procedure::PROC_SERVICE_REQUEST:
+      nas = ue.nas.service_request();
+      rrc_cause = S1ap_RRC_Establishment_Cause_mo_Data;
+      break;
+    case Procedure::PROC_TAU:
+      nas = ue.nas.tau_request();
+      break;
+    case Procedure::PROC_DETACH:
+      nas = ue.nas.detach_request();
+      break;
+    default:
+      return;
+  }
+  // Only the attaching UE has no GUTI to identify with
+  send_initial_ue_message(index, nas, rrc_cause,
+                          ue.procedure != Procedure::PROC_ATTACH);
+}
+
+void LoadGenerator::complete_procedure(uint32_t index, bool success) {
+  Ue& ue = *ues_[index];
+  if (!ue.running) {
+    return;
+  }
+  ue.running = false;
+  running_--;
+  Stats& stats = stats_[(int)ue.procedure];
+  if (!success) {
+    stats.failures++;
+    // Start over from a fresh attach
+    ue.registered = false;
+    ue.connected = false;
+  } else {
+    stats.latencies_us.push_back(elapsed_us(ue.started));
+    switch (ue.procedure) {
+      case Procedure::PROC_ATTACH:
+      case Procedure::PROC_SERVICE_REQUEST:
+      case Procedure::PROC_PAGING:
+        ue.registered = true;
+        ue.connected = true;
+        break;
+      case Procedure::PROC_S1_RELEASE:
+      case Procedure::PROC_TAU:
+        ue.connected = false;
+        break;
+      case Procedure::PROC_DETACH:
+        ue.registered = false;
+        ue.connected = false;
+        break;
+      default:
+        break;
+    }
+  }
+  if (!ue.registered) {
+    ue_by_m_tmsi_.erase(ue.nas.guti().m_tmsi);
+  }
+  start_procedure(index);
+}
+
+void LoadGenerator::send_to_s1ap(sctp_stream_id_t stream, bstring payload) {
+  MessageDef* message_p = itti_alloc_new_message(TASK_SCTP, SCTP_DATA_IND);
+  SCTP_DATA_IND(message_p).payload = payload;
+  SCTP_DATA_IND(message_p).assoc_id = kAssocId;
+  SCTP_DATA_IND(message_p).stream = stream;
+  SCTP_DATA_IND(message_p).instreams = kStreams;
+  SCTP_DATA_IND(message_p).outstreams = kStreams;
+  send_msg_to_task(&task_zmq_ctx_main, TASK_S1AP, message_p);
+}
+
+void LoadGenerator::send_initial_ue_message(uint32_t index,
+                                            const std::vector<uint8_t>& nas,
+                                            long rrc_cause, bool with_s_tmsi) {
+  Ue& ue = *ues_[index];
+  s_tmsi_t s_tmsi = {ue.nas.guti().mme_code, ue.nas.guti().m_tmsi};
+  bstring payload = nullptr;
+  if (generate_initial_ue_message(enb_ue_s1ap_id(index), nas.data(),
+                                  nas.size(), tai_, ecgi_, rrc_cause,
+                                  with_s_tmsi ? &s_tmsi : nullptr,
+                                  &payload) == RETURNok) {
+    send_to_s1ap(kUeStream, payload);
+  }
+}
+
+void LoadGenerator::send_uplink_nas(uint32_t index,
+                                    const std::vector<uint8_t>& nas) {
+  bstring payload = nullptr;
+  if (generate_uplink_nas_transport(ues_[index]->mme_ue_s1ap_id,
+                                    enb_ue_s1ap_id(index), nas.data(),
+                                    nas.size(), tai_, ecgi_,
+                                    &payload) == RETURNok) {
+    send_to_s1ap(kUeStream, payload);
+  }
+}
+
+void LoadGenerator::handle_sctp_data_req(const sctp_data_req_t& data_req) {
+  S1ap_S1AP_PDU_t pdu = {S1ap_S1AP_PDU_PR_NOTHING, {0}};
+  if (s1ap_mme_decode_pdu(&pdu, data_req.payload) != RETURNok) {
+    ASN_STRUCT_FREE_CONTENTS_ONLY(asn_DEF_S1ap_S1AP_PDU, &pdu);
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (pdu.present == S1ap_S1AP_PDU_PR_successfulOutcome &&
+      pdu.choice.successfulOutcome.procedureCode ==
+          S1ap_ProcedureCode_id_S1Setup) {
+    enb_ready_ = true;
+    enb_ready_cv_.notify_all();
+  } else if (pdu.present == S1ap_S1AP_PDU_PR_initiatingMessage) {
+    auto& value = pdu.choice.initiatingMessage.value;
+    switch (pdu.choice.initiatingMessage.procedureCode) {
+      case S1ap_ProcedureCode_id_downlinkNASTransport:
+        handle_dl_nas(&value.choice.DownlinkNASTransport);
+        break;
+      case S1ap_ProcedureCode_id_InitialContextSetup:
+        handle_ics_request(&value.choice.InitialContextSetupRequest);
+        break;
+      case S1ap_ProcedureCode_id_UEContextRelease:
+        handle_release_command(&value.choice.UEContextReleaseCommand);
+        break;
+      case S1ap_ProcedureCode_id_Paging:
+        handle_paging(&value.choice.Paging);
+        break;
+      default:
+        break;
+    }
+  }
+  ASN_STRUCT_FREE_CONTENTS_ONLY(asn_DEF_S1ap_S1AP_PDU, &pdu);
+}
+
+void LoadGenerator::handle_dl_nas(
+    const S1ap_DownlinkNASTransport_t* container) {
+  S1ap_DownlinkNASTransport_IEs_t* ie = nullptr;
+  S1AP_FIND_PROTOCOLIE_BY_ID(S1ap_DownlinkNASTransport_IEs_t, ie, container,
+                             S1ap_ProtocolIE_ID_id_MME_UE_S1AP_ID, true);
+  if (!ie) {
+    return;
+  }
+  mme_ue_s1ap_id_t mme_ue_s1ap_id = ie->value.choice.MME_UE_S1AP_ID;
+  S1AP_FIND_PROTOCOLIE_BY_ID(S1ap_DownlinkNASTransport_IEs_t, ie, container,
+                             S1ap_ProtocolIE_ID_id_eNB_UE_S1AP_ID, true);
+  uint32_t index = 0;
+  if (!ie ||
+      !find_ue(mme_ue_s1ap_id, ie->value.choice.ENB_UE_S1AP_ID, &index)) {
+    return;
+  }
+  S1AP_FIND_PROTOCOLIE_BY_ID(S1ap_DownlinkNASTransport_IEs_t, ie, container,
+                             S1ap_ProtocolIE_ID_id_NAS_PDU, true);
+  if (!ie) {
+    return;
+  }
+  const uint8_t* nas = ie->value.choice.NAS_PDU.buf;
+  size_t length = ie->value.choice.NAS_PDU.size;
+
+  Ue& ue = *ues_[index];
+  std::vector<uint8_t> response;
+  switch (UeSimulator::downlink_message_type(nas, length)) {
+    case AUTHENTICATION_REQUEST:
+      response = ue.nas.authentication_response(nas, length);
+      break;
+    case SECURITY_MODE_COMMAND:
+      response = ue.nas.security_mode_complete(nas, length);
+      break;
+    case ATTACH_REJECT:
+    case AUTHENTICATION_REJECT:
+    case SERVICE_REJECT:
+    case TRACKING_AREA_UPDATE_REJECT:
+      ue.failed = true;
+      break;
+    default:
+      // EMM information, TAU accept and detach accept need no response, the
+      // procedure completes on the PDU following them
+      break;
+  }
+  if (!response.empty()) {
+    send_uplink_nas(index, response);
+  }
+}
+
+void LoadGenerator::handle_ics_request(
+    const S1ap_InitialContextSetupRequest_t* container) {
+  S1ap_InitialContextSetupRequestIEs_t* ie = nullptr;
+  S1AP_FIND_PROTOCOLIE_BY_ID(S1ap_InitialContextSetupRequestIEs_t, ie,
+                             container, S1ap_ProtocolIE_ID_id_MME_UE_S1AP_ID,
+                             true);
+  if (!ie) {
+    return;
+  }
+  mme_ue_s1ap_id_t mme_ue_s1ap_id = ie->value.choice.MME_UE_S1AP_ID;
+  S1AP_FIND_PROTOCOLIE_BY_ID(S1ap_InitialContextSetupRequestIEs_t, ie,
+                             container, S1ap_ProtocolIE_ID_id_eNB_UE_S1AP_ID,
+                             true);
+  uint32_t index = 0;
+  if (!ie ||
+      !find_ue(mme_ue_s1ap_id, ie->value.choice.ENB_UE_S1AP_ID, &index)) {
+    return;
+  }
+  S1AP_FIND_PROTOCOLIE_BY_ID(S1ap_InitialContextSetupRequestIEs_t, ie,
+                             container,
+                             S1ap_ProtocolIE_ID_id_E_RABToBeSetupListCtxtSUReq,
+                             true);
+  if (!ie || ie->value.choice.E_RABToBeSetupListCtxtSUReq.list.count < 1) {
+    return;
+  }
+  const S1ap_E_RABToBeSetupItemCtxtSUReq_t& e_rab =
+      reinterpret_cast<S1ap_E_RABToBeSetupItemCtxtSUReqIEs_t*>(
+          ie->value.choice.E_RABToBeSetupListCtxtSUReq.list.array[0])
+          ->value.choice.E_RABToBeSetupItemCtxtSUReq;
+
+  Ue& ue = *ues_[index];
+  bool attach = ue.running && ue.procedure == Procedure::PROC_ATTACH;
+  if (attach && !e_rab.nAS_PDU) {
+    ue.failed = true;
+  } else if (attach) {
+    // The attach accept carries the GUTI the UE uses in the next procedures
+    nas_message_t nas_msg_decoded = {0};
+    emm_security_context_t emm_security_context = {};
+    nas_message_decode_status_t decode_status = {0};
+    nas_message_decode(e_rab.nAS_PDU->buf, &nas_msg_decoded,
+                       e_rab.nAS_PDU->size, &emm_security_context,
+                       &decode_status);
+    ue.nas.set_guti(nas_msg_decoded.plain.emm.attach_accept.guti.guti);
+    bdestroy_wrapper(
+        &nas_msg_decoded.plain.emm.attach_accept.esmmessagecontainer);
+    ue_by_m_tmsi_[ue.nas.guti().m_tmsi] = index;
+  }
+
+  // The S1-U TEID of the eNB is the eNB UE S1AP id
+  bstring payload = nullptr;
+  if (generate_initial_context_setup_response(
+          ue.mme_ue_s1ap_id, enb_ue_s1ap_id(index), e_rab.e_RAB_ID,
+          enb_ue_s1ap_id(index), kEnbIpv4, &payload) == RETURNok) {
+    send_to_s1ap(kUeStream, payload);
+  }
+  if (attach && !ue.failed) {
+    if (generate_ue_capability_info_indication(
+            ue.mme_ue_s1ap_id, enb_ue_s1ap_id(index), kUeRadioCapability,
+            sizeof(kUeRadioCapability), &payload) == RETURNok) {
+      send_to_s1ap(kUeStream, payload);
+    }
+    send_uplink_nas(index, ue.nas.attach_complete());
+  }
+
+  // Last PDU of the procedures bringing the UE to connected
+  if (ue.running && (ue.procedure == Procedure::PROC_ATTACH ||
+                     ue.procedure == Procedure::PROC_SERVICE_REQUEST ||
+                     ue.procedure == Procedure::PROC_PAGING)) {
+    complete_procedure(index, !ue.failed);
+  }
+}
+
+void LoadGenerator::handle_release_command(
+    const S1ap_UEContextReleaseCommand_t* container) {
+  S1ap_UEContextReleaseCommand_IEs_t* ie = nullptr;
+  S1AP_FIND_PROTOCOLIE_BY_ID(S1ap_UEContextReleaseCommand_IEs_t, ie,
+                             container, S1ap_ProtocolIE_ID_id_UE_S1AP_IDs,
+                             true);
+  if (!ie) {
+    return;
+  }
+  const S1ap_UE_S1AP_IDs_t& ids = ie->value.choice.UE_S1AP_IDs;
+  uint32_t index = 0;
+  if (ids.present == S1ap_UE_S1AP_IDs_PR_uE_S1AP_ID_pair) {
+    if (!find_ue(ids.choice.uE_S1AP_ID_pair.mME_UE_S1AP_ID,
+                 ids.choice.uE_S1AP_ID_pair.eNB_UE_S1AP_ID, &index)) {
+      return;
+    }
+  } else if (!find_ue(ids.choice.mME_UE_S1AP_ID, &index)) {
+    return;
+  }
+
+  Ue& ue = *ues_[index];
+  bstring payload = nullptr;
+  if (generate_ue_context_release_complete(ue.mme_ue_s1ap_id,
+                                           enb_ue_s1ap_id(index),
+                                           &payload) == RETURNok) {
+    send_to_s1ap(kUeStream, payload);
+  }
+  ue.connected = false;
+  if (!ue.running) {
+    return;
+  }
+  switch (ue.procedure) {
+    case Procedure::PROC_S1_RELEASE:
+    case Procedure::PROC_TAU:
+    case Procedure::PROC_DETACH:
+      complete_procedure(index, !ue.failed);
+      break;
+    default:
+      // The MME released a procedure that should have kept the UE connected
+      complete_procedure(index, false);
+      break;
+  }
+}
+
+void LoadGenerator::handle_paging(const S1ap_Paging_t* container) {
+  S1ap_PagingIEs_t* ie = nullptr;
+  S1AP_FIND_PROTOCOLIE_BY_ID(S1ap_PagingIEs_t, ie, container,
+                             S1ap_ProtocolIE_ID_id_UEPagingID, true);
+  if (!ie) {
+    return;
+  }
+  const S1ap_UEPagingID_t& paging_id = ie->value.choice.UEPagingID;
+  uint32_t index = 0;
+  if (paging_id.present == S1ap_UEPagingID_PR_s_TMSI) {
+    tmsi_t m_tmsi = 0;
+    OCTET_STRING_TO_M_TMSI(&paging_id.choice.s_TMSI.m_TMSI, m_tmsi);
+    auto it = ue_by_m_tmsi_.find(m_tmsi);
+    if (it == ue_by_m_tmsi_.end()) {
+      return;
+    }
+    index = it->second;
+  } else if (paging_id.present == S1ap_UEPagingID_PR_iMSI) {
+    // TBCD digits, the low nibble first and 0xf filling the last byte of an
+    // odd number of digits
+    std::string imsi;
+    for (size_t i = 0; i < paging_id.choice.iMSI.size; i++) {
+      uint8_t octet = paging_id.choice.iMSI.buf[i];
+      imsi += (char)('0' + (octet & 0x0f));
+      if ((octet >> 4) != 0x0f) {
+        imsi += (char)('0' + (octet >> 4));
+      }
+    }
+    auto it = ue_by_imsi_.find(imsi);
+    if (it == ue_by_imsi_.end()) {
+      return;
+    }
+    index = it->second;
+  } else {
+    return;
+  }
+  Ue& ue = *ues_[index];
+  // Only the first paging is answered, the MME pages again on timeout
+  if (!ue.running || ue.procedure != Procedure::PROC_PAGING || ue.paged) {
+    return;
+  }
+  ue.paged = true;
+  send_initial_ue_message(index, ue.nas.service_request(),
+                          S1ap_RRC_Establishment_Cause_mt_Access, true);
+}
+
+// The HSS accepts every subscriber
+void LoadGenerator::handle_s6a_message(MessageDef* message) {
+  switch (ITTI_MSG_ID(message)) {
+    case S6A_AUTH_INFO_REQ: {
+      send_authentication_info_resp(S6A_AUTH_INFO_REQ(message).imsi, true);
+    } break;
+
+    case S6A_UPDATE_LOCATION_REQ: {
+      send_s6a_ula(S6A_UPDATE_LOCATION_REQ(message).imsi, true);
+    } break;
+
+    default: {
+    } break;
+  }
+}
+
+// Called by the SPGW task, the UE addresses do not change once constructed
+void LoadGenerator::allocate_ip_address(const char* imsi,
+                                        teid_t context_teid,
+                                        ebi_t eps_bearer_id) {
+  MessageDef* message_p =
+      itti_alloc_new_message(TASK_GRPC_SERVICE, IP_ALLOCATION_RESPONSE);
+  itti_ip_allocation_response_t* response =
+      &message_p->ittiMsg.ip_allocation_response;
+  response->context_teid = context_teid;
+  response->eps_bearer_id = eps_bearer_id;
+  auto it = ue_by_imsi_.find(std::string(imsi));
+  if (it == ue_by_imsi_.end()) {
+    response->status = SGI_STATUS_ERROR_ALL_DYNAMIC_ADDRESSES_OCCUPIED;
+  } else {
+    response->paa.ipv4_address.s_addr = ues_[it->second]->ipv4;
+    response->paa.pdn_type = IPv4;
+    response->status = SGI_STATUS_OK;
+  }
+  IMSI_STRING_TO_IMSI64(imsi, &message_p->ittiMsgHeader.imsi);
+  send_msg_to_task(&task_zmq_ctx_main, TASK_SPGW_APP, message_p);
+}
+
+void LoadGenerator::create_session(
+    const char* imsi, s5_create_session_request_t session_request) {
+  MessageDef* message_p =
+      itti_alloc_new_message(TASK_GRPC_SERVICE, PCEF_CREATE_SESSION_RESPONSE);
+  itti_pcef_create_session_response_t* response =
+      &message_p->ittiMsg.pcef_create_session_response;
+  response->rpc_status = PCEF_STATUS_OK;
+  response->teid = session_request.context_teid;
+  response->eps_bearer_id = session_request.eps_bearer_id;
+  response->sgi_status = session_request.status;
+  IMSI_STRING_TO_IMSI64(imsi, &message_p->ittiMsgHeader.imsi);
+  send_msg_to_task(&task_zmq_ctx_main, TASK_SPGW_APP, message_p);
+}
+
+namespace {
+
+LoadGenerator* generator_ = nullptr;
+task_zmq_ctx_t task_zmq_ctx_s6a_stub;
+
+// Returns true when the task has to stop
+bool forward_message(zsock_t* reader,
+                     void (LoadGenerator::*handler)(MessageDef*)) {
+  MessageDef* received_message_p = receive_msg(reader);
+  bool terminate = ITTI_MSG_ID(received_message_p) == TERMINATE_MESSAGE;
+  if (!terminate) {
+    (generator_->*handler)(received_message_p);
+  }
+  itti_free_msg_content(received_message_p);
+  free(received_message_p);
+  return terminate;
+}
+
+int handle_s6a_message(zloop_t* loop, zsock_t* reader, void* arg) {
+  if (forward_message(reader, &LoadGenerator::handle_s6a_message)) {
+    destroy_task_context(&task_zmq_ctx_s6a_stub);
+    pthread_exit(NULL);
+  }
+  return 0;
+}
+
+int handle_ip_allocation(const char* subscriber_id, const char* apn,
+                         const char* pdn_type, teid_t context_teid,
+                         ebi_t eps_bearer_id) {
+  generator_->allocate_ip_address(subscriber_id, context_teid, eps_bearer_id);
+  return RETURNok;
+}
+
+void handle_create_session(const char* imsi, const char* ip4, const char* ip6,
+                           const struct pcef_create_session_data* session_data,
+                           s5_create_session_request_t session_request) {
+  generator_->create_session(imsi, session_request);
+}
+
+}  // namespace
+
+void start_s6a_stub_task(LoadGenerator* generator) {
+  generator_ = generator;
+  init_task_context(TASK_S6A, nullptr, 0, handle_s6a_message,
+                    &task_zmq_ctx_s6a_stub);
+  zloop_start(task_zmq_ctx_s6a_stub.event_loop);
+}
+
+void set_pgw_handlers(LoadGenerator* generator) {
+  generator_ = generator;
+  pgw_set_ip_allocation_handler(handle_ip_allocation);
+  pcef_set_create_session_handler(handle_create_session);
+}
+
+}  // namespace lte
+}  // namespace magma
@@ -0,0 +1,183 @@
+/**
+ * Copyright 2022 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+extern "C" {
+#include "lte/gateway/c/core/oai/common/common_types.h"
+#include "lte/gateway/c/core/oai/common/log.h"
+#include "lte/gateway/c/core/oai/include/TrackingAreaIdentity.h"
+#include "lte/gateway/c/core/oai/include/sctp_messages_types.h"
+#include "lte/gateway/c/core/oai/include/spgw_types.h"
+#include "lte/gateway/c/core/oai/lib/3gpp/3gpp_23.003.h"
+#include "lte/gateway/c/core/oai/lib/bstr/bstrlib.h"
+#include "lte/gateway/c/core/oai/lib/itti/intertask_interface.h"
+}
+
+#include "lte/gateway/c/core/oai/tasks/s1ap/s1ap_common.hpp"
+
+#include "lte/gateway/c/core/oai/test/load_generator/ue_simulator.h"
+
+namespace magma {
+namespace lte {
+
+enum class Procedure {
+  PROC_ATTACH = 0,
+  PROC_S1_RELEASE,
+  PROC_SERVICE_REQUEST,
+  PROC_PAGING,
+  PROC_TAU,
+  PROC_DETACH,
+  PROC_COUNT,
+};
+
+const char* procedure_name(Procedure procedure);
+
+struct LoadGeneratorConfig {
+  uint32_t num_ues = 100;
+  uint32_t duration_sec = 10;
+  uint32_t timeout_ms = 5000;
+  uint64_t first_imsi = 1010000000001;
+  uint32_t seed = 1;
+  // Relative weights of the procedures run by a registered idle UE, the
+  // attach and S1 release are scheduled by the state of the UE
+  uint32_t weights[(int)Procedure::PROC_COUNT] = {0, 0, 4, 2, 2, 1};
+};
+
+/**
+ * Runs the UE procedures against the S1AP, MME_APP, NAS and SPGW tasks in
+ * closed loop: as soon as a procedure of a UE completes, the next one is
+ * started. The generator is the eNB of all the UEs behind the SCTP mock, it
+ * sends APER encoded S1AP PDUs and decodes the ones S1AP sends back. It also
+ * answers for the HSS, for mobilityd and sessiond, and for pipelined when a
+ * UE is paged.
+ *
+ * A deregistered UE attaches, a connected UE is released to idle and an idle
+ * UE runs one of TAU, service request, paging and detach picked by weight.
+ * The latency of a procedure is measured from its first uplink PDU to the
+ * last PDU the MME sends for it: the Initial Context Setup Request for the
+ * procedures bringing the UE to connected, the UE Context Release Command for
+ * the others. The Modify Bearer exchange between MME_APP and SPGW that
+ * follows the Initial Context Setup Response is not seen by the eNB, its cost
+ * shows in the throughput and in the latency of the next procedure of the UE,
+ * which it is ordered ahead of.
+ */
+class LoadGenerator {
+ public:
+  explicit LoadGenerator(const LoadGeneratorConfig& config);
+
+  // Connects the eNB to S1AP and waits for the S1 Setup Response, returns
+  // false if it is not received
+  bool setup_enb();
+  // Starts the first procedure of every UE
+  void start();
+  // Stops starting procedures and waits for the running ones to complete
+  void stop();
+  // Retires the UEs whose procedure has been running for longer than the
+  // timeout, they do not run any further procedure
+  void check_timeouts();
+  void print_report(FILE* out) const;
+
+  // Downlink PDU sent by S1AP to the eNB
+  void handle_sctp_data_req(const sctp_data_req_t& data_req);
+  void handle_s6a_message(MessageDef* message);
+  // Requests of the SPGW task to mobilityd and sessiond, the UE gets the IP
+  // address of its index and the session is always created
+  void allocate_ip_address(const char* imsi, teid_t context_teid,
+                           ebi_t eps_bearer_id);
+  void create_session(const char* imsi,
+                      s5_create_session_request_t session_request);
+
+ private:
+  struct Stats {
+    std::vector<uint32_t> latencies_us;
+    uint32_t failures = 0;
+    uint32_t timeouts = 0;
+  };
+
+  struct Ue {
+    Ue(const std::string& imsi, in_addr_t ipv4) : nas(imsi), ipv4(ipv4) {}
+
+    UeSimulator nas;
+    mme_ue_s1ap_id_t mme_ue_s1ap_id = INVALID_MME_UE_S1AP_ID;
+    in_addr_t ipv4;
+    bool registered = false;
+    bool connected = false;
+    bool retired = false;
+    bool running = false;
+    // The MME rejected the procedure, it completes on the release command
+    bool failed = false;
+    bool paged = false;
+    Procedure procedure = Procedure::PROC_ATTACH;
+    std::chrono::steady_clock::time_point started;
+  };
+
+  // All the following methods are called with mutex_ held
+  bool find_ue(mme_ue_s1ap_id_t mme_ue_s1ap_id, uint32_t* index) const;
+  // Finds the UE of a PDU carrying both S1AP ids and records its
+  // mme_ue_s1ap_id
+  bool find_ue(mme_ue_s1ap_id_t mme_ue_s1ap_id,
+               enb_ue_s1ap_id_t enb_ue_s1ap_id, uint32_t* index);
+  Procedure next_procedure(const Ue& ue);
+  void start_procedure(uint32_t index);
+  void complete_procedure(uint32_t index, bool success);
+  enb_ue_s1ap_id_t enb_ue_s1ap_id(uint32_t index) const { return index + 1; }
+
+  void send_to_s1ap(sctp_stream_id_t stream, bstring payload);
+  void send_initial_ue_message(uint32_t index, const std::vector<uint8_t>& nas,
+                               long rrc_cause, bool with_s_tmsi);
+  void send_uplink_nas(uint32_t index, const std::vector<uint8_t>& nas);
+
+  void handle_dl_nas(const S1ap_DownlinkNASTransport_t* container);
+  void handle_ics_request(const S1ap_InitialContextSetupRequest_t* container);
+  void handle_release_command(
+      const S1ap_UEContextReleaseCommand_t* container);
+  void handle_paging(const S1ap_Paging_t* container);
+
+  LoadGeneratorConfig config_;
+  tai_t tai_;
+  ecgi_t ecgi_;
+  mutable std::mutex mutex_;
+  std::condition_variable enb_ready_cv_;
+  bool enb_ready_ = false;
+  std::mt19937 random_;
+  std::vector<std::unique_ptr<Ue>> ues_;
+  std::unordered_map<mme_ue_s1ap_id_t, uint32_t> ue_by_mme_ue_s1ap_id_;
+  std::unordered_map<tmsi_t, uint32_t> ue_by_m_tmsi_;
+  std::unordered_map<std::string, uint32_t> ue_by_imsi_;
+  Stats stats_[(int)Procedure::PROC_COUNT];
+  bool stopping_ = false;
+  uint32_t running_ = 0;
+  std::chrono::steady_clock::time_point started_;
+  std::chrono::steady_clock::time_point stopped_;
+};
+
+// Task standing in for S6A, it forwards the messages of MME_APP to the
+// generator
+void start_s6a_stub_task(LoadGenerator* generator);
+// Sends the requests of the SPGW task to mobilityd and sessiond to the
+// generator
+void set_pgw_handlers(LoadGenerator* generator);
+
+}  // namespace lte
+}  // namespace magma
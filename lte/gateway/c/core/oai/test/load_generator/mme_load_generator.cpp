@@ -0,0 +1,239 @@
+/**
+ * Copyright 2022 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "lte/gateway/c/core/oai/test/load_generator/load_generator.h"
+#include "lte/gateway/c/core/oai/test/mme_app_task/mme_app_test_util.h"
+#include "lte/gateway/c/core/oai/test/mock_tasks/mock_tasks.hpp"
+
+extern "C" {
+#include "lte/gateway/c/core/oai/common/log.h"
+#include "lte/gateway/c/core/oai/include/spgw_config.h"
+#include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_extern.h"
+#include "lte/gateway/c/core/oai/tasks/sgw/sgw_defs.h"
+}
+
+#include "lte/gateway/c/core/oai/tasks/s1ap/s1ap_mme.hpp"
+
+extern bool mme_hss_associated;
+extern bool mme_sctp_bounded;
+
+/**
+ * Drives MME_APP and NAS with simulated UEs and reports the throughput and
+ * latency of every procedure, e.g.:
+ *
+ *   mme_load_generator --ues 1000 --duration 30 \
+ *       --mix tau=2,service_request=4,paging=2,detach=1
+ *
+ * S1AP, MME_APP, NAS and SPGW run as in their own tests. The generator is
+ * the eNB behind the mocked sctpd and answers for the HSS, mobilityd,
+ * sessiond and pipelined.
+ */
+namespace magma {
+namespace lte {
+
+namespace {
+
+const struct option kOptions[] = {
+    {"ues", required_argument, nullptr, 'u'},
+    {"duration", required_argument, nullptr, 'd'},
+    {"mix", required_argument, nullptr, 'm'},
+    {"timeout-ms", required_argument, nullptr, 't'},
+    {"first-imsi", required_argument, nullptr, 'i'},
+    {"seed", required_argument, nullptr, 's'},
+    {"help", no_argument, nullptr, 'h'},
+    {nullptr, 0, nullptr, 0},
+};
+
+void usage(const char* program) {
+  fprintf(stderr,
+          "Usage: %s [--ues N] [--duration SEC] [--timeout-ms MS]\n"
+          "          [--mix tau=W,service_request=W,paging=W,detach=W]\n"
+          "          [--first-imsi IMSI] [--seed SEED]\n",
+          program);
+}
+
+// Parses the comma separated list of procedure=weight, the procedures not in
+// the list are not run
+bool parse_mix(const char* mix, LoadGeneratorConfig* config) {
+  for (uint32_t& weight : config->weights) {
+    weight = 0;
+  }
+  std::stringstream stream(mix);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    size_t equal = item.find('=');
+    if (equal == std::string::npos) {
+      return false;
+    }
+    std::string name = item.substr(0, equal);
+    bool found = false;
+    for (int i = (int)Procedure::PROC_SERVICE_REQUEST;
+         i < (int)Procedure::PROC_COUNT; i++) {
+      if (name == procedure_name((Procedure)i)) {
+        config->weights[i] = strtoul(item.c_str() + equal + 1, nullptr, 10);
+        found = true;
+      }
+    }
+    if (!found) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool parse_options(int argc, char** argv, LoadGeneratorConfig* config) {
+  int c;
+  while ((c = getopt_long(argc, argv, "u:d:m:t:i:s:h", kOptions, nullptr)) !=
+         -1) {
+    switch (c) {
+      case 'u':
+        config->num_ues = strtoul(optarg, nullptr, 10);
+        break;
+      case 'd':
+        config->duration_sec = strtoul(optarg, nullptr, 10);
+        break;
+      case 'm':
+        if (!parse_mix(optarg, config)) {
+          fprintf(stderr, "Invalid procedure mix %s\n", optarg);
+          return false;
+        }
+        break;
+      case 't':
+        config->timeout_ms = strtoul(optarg, nullptr, 10);
+        break;
+      case 'i':
+        config->first_imsi = strtoull(optarg, nullptr, 10);
+        break;
+      case 's':
+        config->seed = strtoul(optarg, nullptr, 10);
+        break;
+      default:
+        return false;
+    }
+  }
+  return config->num_ues > 0;
+}
+
+int handle_message(zloop_t* loop, zsock_t* reader, void* arg) {
+  MessageDef* received_message_p = receive_msg(reader);
+  itti_free_msg_content(received_message_p);
+  free(received_message_p);
+  return 0;
+}
+
+// Same setup as MmeAppProcedureTest, with the S1AP and SPGW_APP tasks also
+// running
+void start_mme(LoadGenerator* generator, uint32_t num_ues) {
+  mme_hss_associated = false;
+  mme_sctp_bounded = false;
+  hss_associated = true;
+  itti_init(TASK_MAX, THREAD_MAX, MESSAGES_ID_MAX, tasks_info, messages_info,
+            NULL, NULL);
+
+  mme_config_init(&mme_config);
+  spgw_config_init(&spgw_config);
+  create_partial_lists(&mme_config);
+  mme_config.max_ues = num_ues;
+  mme_config.nas_config.prefered_integrity_algorithm[0] = EIA2_128_ALG_ID;
+  // The UEs read the downlink NAS messages, which are then not ciphered
+  mme_config.nas_config.prefered_ciphering_algorithm[0] = EEA0_ALG_ID;
+
+  task_id_t task_id_list[11] = {
+      TASK_MME_APP, TASK_HA,     TASK_S1AP,     TASK_S6A,       TASK_S11,
+      TASK_SERVICE303, TASK_SGS, TASK_SGW_S8, TASK_SPGW_APP, TASK_SMS_ORC8R,
+      TASK_SCTP};
+  init_task_context(TASK_MAIN, task_id_list, 11, handle_message,
+                    &task_zmq_ctx_main);
+
+  auto sctp_handler = std::make_shared<testing::NiceMock<MockSctpHandler>>();
+  ON_CALL(*sctp_handler, sctpd_send_dl(testing::_))
+      .WillByDefault(
+          testing::Invoke(generator, &LoadGenerator::handle_sctp_data_req));
+  auto service303_handler =
+      std::make_shared<testing::NiceMock<MockService303Handler>>();
+  auto s8_handler = std::make_shared<testing::NiceMock<MockS8Handler>>();
+  set_pgw_handlers(generator);
+  std::thread(start_mock_sctp_task, sctp_handler).detach();
+  std::thread(start_s6a_stub_task, generator).detach();
+  std::thread(start_mock_ha_task).detach();
+  std::thread(start_mock_s11_task).detach();
+  std::thread(start_mock_service303_task, service303_handler).detach();
+  std::thread(start_mock_sgs_task).detach();
+  std::thread(start_mock_sgw_s8_task, s8_handler).detach();
+  std::thread(start_mock_sms_orc8r_task).detach();
+
+  // Make sure all tasks are running before the MME starts
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  // S1AP and SPGW would connect to redis when stateless, as in their tests
+  mme_config.use_stateless = false;
+  s1ap_mme_init(&mme_config);
+  spgw_app_init(&spgw_config, mme_config.use_stateless);
+  mme_config.use_stateless = true;
+  mme_app_init(&mme_config);
+  send_sctp_mme_server_initialized();
+  send_activate_message_to_mme_app();
+}
+
+void stop_mme() {
+  send_terminate_message_fatal(&task_zmq_ctx_main);
+  // Sleep to ensure that messages are received and contexts are released
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  destroy_task_context(&task_zmq_ctx_main);
+  itti_free_desc_threads();
+  free_spgw_config(&spgw_config);
+}
+
+}  // namespace
+
+}  // namespace lte
+}  // namespace magma
+
+int main(int argc, char** argv) {
+  magma::lte::LoadGeneratorConfig config;
+  if (!magma::lte::parse_options(argc, argv, &config)) {
+    magma::lte::usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+  OAILOG_INIT("MME", OAILOG_LEVEL_ERROR, MAX_LOG_PROTOS);
+
+  magma::lte::LoadGenerator generator(config);
+  magma::lte::start_mme(&generator, config.num_ues);
+  if (!generator.setup_enb()) {
+    fprintf(stderr, "No S1 Setup Response from S1AP\n");
+    magma::lte::stop_mme();
+    return EXIT_FAILURE;
+  }
+
+  generator.start();
+  auto end = std::chrono::steady_clock::now() +
+             std::chrono::seconds(config.duration_sec);
+  while (std::chrono::steady_clock::now() < end) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    generator.check_timeouts();
+  }
+  generator.stop();
+  generator.print_report(stdout);
+
+  magma::lte::stop_mme();
+  return EXIT_SUCCESS;
+}
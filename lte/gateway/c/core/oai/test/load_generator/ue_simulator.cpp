@@ -0,0 +1,236 @@
+/**
+ * Copyright 2022 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "lte/gateway/c/core/oai/test/load_generator/ue_simulator.h"
+
+#include <string.h>
+
+extern "C" {
+#include "lte/gateway/c/core/oai/lib/3gpp/3gpp_24.007.h"
+#include "lte/gateway/c/core/oai/lib/3gpp/3gpp_24.301.h"
+#include "lte/gateway/c/core/oai/lib/secu/secu_defs.h"
+#include "lte/gateway/c/core/oai/tasks/nas/api/network/nas_message.h"
+#include "lte/gateway/c/core/oai/tasks/nas/ies/NasSecurityAlgorithms.h"
+}
+
+namespace magma {
+namespace lte {
+
+namespace {
+
+// KASME and RES of the vector sent by send_authentication_info_resp
+const uint8_t kKasme[AUTH_KASME_SIZE] = {
+    0xc3, 0x5f, 0x03, 0x8f, 0x5f, 0xbe, 0xcc, 0x23, 0xc4, 0xd1, 0xa7,
+    0xd6, 0x8a, 0xf7, 0x05, 0x32, 0xf2, 0x37, 0xf6, 0x40, 0x47, 0xdd,
+    0x29, 0x6e, 0x7d, 0x0e, 0xf6, 0xe9, 0x26, 0x5f, 0x24, 0x39};
+const uint8_t kRes[] = {0x66, 0xff, 0x47, 0x2d, 0xd4, 0x93, 0xf1, 0x5a,
+                        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+// Attach request of the MME procedure tests, the IMSI is patched in bytes 4
+// to 11
+const uint8_t kAttachRequest[] = {
+    0x07, 0x41, 0x71, 0x08, 0x09, 0x10, 0x10, 0x00, 0x00, 0x00, 0x00,
+    0x10, 0x02, 0xe0, 0xe0, 0x00, 0x04, 0x02, 0x01, 0xd0, 0x11, 0x40,
+    0x08, 0x04, 0x02, 0x60, 0x04, 0x00, 0x02, 0x1c, 0x00};
+const size_t kAttachRequestImsiOffset = 4;
+
+// Security mode complete with IMEISV
+const uint8_t kSecurityModeComplete[] = {0x07, 0x5e, 0x23, 0x09, 0x33,
+                                         0x08, 0x45, 0x86, 0x34, 0x12,
+                                         0x31, 0x71, 0xf2};
+
+// Attach complete carrying the default bearer context accept for EBI 5
+const uint8_t kAttachComplete[] = {0x07, 0x43, 0x00, 0x03, 0x52, 0x00, 0xc2};
+
+const uint8_t kEpsUpdateTypePeriodic = 0x03;
+const uint8_t kDetachTypeSwitchOffEps = 0x09;
+const uint8_t kMobileIdentityGuti = 0xf6;
+const uint8_t kGutiIeLength = 11;
+
+}  // namespace
+
+UeSimulator::UeSimulator(const std::string& imsi) : imsi_(imsi) { reset(); }
+
+void UeSimulator::reset() {
+  memset(&guti_, 0, sizeof(guti_));
+  memset(&security_, 0, sizeof(security_));
+  ksi_ = KSI_NO_KEY_AVAILABLE;
+}
+
+std::vector<uint8_t> UeSimulator::attach_request() const {
+  std::vector<uint8_t> nas(kAttachRequest,
+                           kAttachRequest + sizeof(kAttachRequest));
+  uint8_t digits[IMSI_BCD_DIGITS_MAX] = {0};
+  for (size_t i = 0; i < imsi_.size() && i < IMSI_BCD_DIGITS_MAX; i++) {
+    digits[i] = imsi_[i] - '0';
+  }
+  // First digit with the odd indicator and the IMSI type, then two digits
+  // per byte
+  nas[kAttachRequestImsiOffset] = (digits[0] << 4) | 0x09;
+  for (int i = 1; i < IMSI_BCD_DIGITS_MAX; i += 2) {
+    nas[kAttachRequestImsiOffset + 1 + i / 2] =
+        (digits[i + 1] << 4) | digits[i];
+  }
+  return nas;
+}
+
+std::vector<uint8_t> UeSimulator::authentication_response(
+    const uint8_t* auth_request, size_t length) {
+  if (length > 2) {
+    ksi_ = auth_request[2] & 0x07;
+  }
+  std::vector<uint8_t> nas = {EPS_MOBILITY_MANAGEMENT_MESSAGE,
+                              AUTHENTICATION_RESPONSE, sizeof(kRes)};
+  nas.insert(nas.end(), kRes, kRes + sizeof(kRes));
+  return nas;
+}
+
+std::vector<uint8_t> UeSimulator::security_mode_complete(const uint8_t* smc,
+                                                         size_t length) {
+  // Selected algorithms follow the message type in the plain message
+  if (length < NAS_MESSAGE_SECURITY_HEADER_SIZE + 3) {
+    return std::vector<uint8_t>();
+  }
+  uint8_t algorithms = smc[NAS_MESSAGE_SECURITY_HEADER_SIZE + 2];
+  memset(&security_, 0, sizeof(security_));
+  security_.selected_algorithms.encryption = (algorithms >> 4) & 0x07;
+  security_.selected_algorithms.integrity = algorithms & 0x07;
+  derive_key_nas(NAS_ENC_ALG, security_.selected_algorithms.encryption,
+                 kKasme, security_.knas_enc);
+  derive_key_nas(NAS_INT_ALG, security_.selected_algorithms.integrity,
+                 kKasme, security_.knas_int);
+  security_.eksi = ksi_;
+  security_.activated = 1;
+  security_.direction_encode = SECU_DIRECTION_UPLINK;
+  security_.direction_decode = SECU_DIRECTION_DOWNLINK;
+
+  std::vector<uint8_t> plain(
+      kSecurityModeComplete,
+      kSecurityModeComplete + sizeof(kSecurityModeComplete));
+  return protect(plain, SECURITY_HEADER_TYPE_INTEGRITY_PROTECTED_CYPHERED_NEW);
+}
+
+std::vector<uint8_t> UeSimulator::attach_complete() {
+  std::vector<uint8_t> plain(kAttachComplete,
+                             kAttachComplete + sizeof(kAttachComplete));
+  return protect(plain, SECURITY_HEADER_TYPE_INTEGRITY_PROTECTED_CYPHERED);
+}
+
+// Both are sent in an initial UE message from idle, so they are only
+// integrity protected
+std::vector<uint8_t> UeSimulator::tau_request() {
+  std::vector<uint8_t> plain = {
+      EPS_MOBILITY_MANAGEMENT_MESSAGE, TRACKING_AREA_UPDATE_REQUEST,
+      (uint8_t)((ksi_ << 4) | kEpsUpdateTypePeriodic)};
+  std::vector<uint8_t> guti = guti_ie();
+  plain.insert(plain.end(), guti.begin(), guti.end());
+  return protect(plain, SECURITY_HEADER_TYPE_INTEGRITY_PROTECTED);
+}
+
+std::vector<uint8_t> UeSimulator::detach_request() {
+  std::vector<uint8_t> plain = {
+      EPS_MOBILITY_MANAGEMENT_MESSAGE, DETACH_REQUEST,
+      (uint8_t)((ksi_ << 4) | kDetachTypeSwitchOffEps)};
+  std::vector<uint8_t> guti = guti_ie();
+  plain.insert(plain.end(), guti.begin(), guti.end());
+  return protect(plain, SECURITY_HEADER_TYPE_INTEGRITY_PROTECTED);
+}
+
+// The service request carries the 5 LSBs of the sequence number and the 2
+// LSBs of the MAC computed over its first 2 bytes
+std::vector<uint8_t> UeSimulator::service_request() {
+  std::vector<uint8_t> nas = {
+      (SECURITY_HEADER_TYPE_SERVICE_REQUEST << 4) |
+          EPS_MOBILITY_MANAGEMENT_MESSAGE,
+      (uint8_t)(((ksi_ & 0x07) << 5) | (security_.ul_count.seq_num & 0x1f))};
+  uint32_t mac = uplink_mac(nas.data(), nas.size());
+  nas.push_back((mac >> 8) & 0xff);
+  nas.push_back(mac & 0xff);
+  increment_ul_count();
+  return nas;
+}
+
+uint8_t UeSimulator::downlink_message_type(const uint8_t* nas, size_t length) {
+  if (length < 2 || (nas[0] & 0x0f) != EPS_MOBILITY_MANAGEMENT_MESSAGE) {
+    return 0;
+  }
+  size_t offset = 0;
+  if ((nas[0] >> 4) != SECURITY_HEADER_TYPE_NOT_PROTECTED) {
+    offset = NAS_MESSAGE_SECURITY_HEADER_SIZE;
+  }
+  if (length < offset + 2) {
+    return 0;
+  }
+  return nas[offset + 1];
+}
+
+std::vector<uint8_t> UeSimulator::protect(const std::vector<uint8_t>& plain,
+                                          uint8_t security_header_type) {
+  nas_message_security_header_t header = {};
+  header.protocol_discriminator = EPS_MOBILITY_MANAGEMENT_MESSAGE;
+  header.security_header_type = security_header_type;
+  header.sequence_number = security_.ul_count.seq_num;
+  std::vector<uint8_t> nas(plain.size() + NAS_MESSAGE_SECURITY_HEADER_SIZE);
+  // Computes the MAC with the uplink count and increments it
+  nas_message_encrypt(plain.data(), nas.data(), &header, nas.size(),
+                      &security_);
+  return nas;
+}
+
+std::vector<uint8_t> UeSimulator::guti_ie() const {
+  return {kGutiIeLength,
+          kMobileIdentityGuti,
+          (uint8_t)((guti_.mcc_digit2 << 4) | guti_.mcc_digit1),
+          (uint8_t)((guti_.mnc_digit3 << 4) | guti_.mcc_digit3),
+          (uint8_t)((guti_.mnc_digit2 << 4) | guti_.mnc_digit1),
+          (uint8_t)(guti_.mme_group_id >> 8),
+          (uint8_t)(guti_.mme_group_id & 0xff),
+          guti_.mme_code,
+          (uint8_t)(guti_.m_tmsi >> 24),
+          (uint8_t)((guti_.m_tmsi >> 16) & 0xff),
+          (uint8_t)((guti_.m_tmsi >> 8) & 0xff),
+          (uint8_t)(guti_.m_tmsi & 0xff)};
+}
+
+uint32_t UeSimulator::uplink_mac(const uint8_t* buffer, size_t length) const {
+  uint8_t mac[4] = {0};
+  nas_stream_cipher_t stream_cipher = {};
+  stream_cipher.key = (uint8_t*)security_.knas_int;
+  stream_cipher.key_length = AUTH_KNAS_INT_SIZE;
+  stream_cipher.count = ((security_.ul_count.overflow & 0xffff) << 8) |
+                        security_.ul_count.seq_num;
+  stream_cipher.bearer = 0;
+  stream_cipher.direction = SECU_DIRECTION_UPLINK;
+  stream_cipher.message = (uint8_t*)buffer;
+  stream_cipher.blength = length << 3;
+  switch (security_.selected_algorithms.integrity) {
+    case NAS_SECURITY_ALGORITHMS_EIA1:
+      nas_stream_encrypt_eia1(&stream_cipher, mac);
+      break;
+    case NAS_SECURITY_ALGORITHMS_EIA2:
+      nas_stream_encrypt_eia2(&stream_cipher, mac);
+      break;
+    default:
+      break;
+  }
+  return (mac[0] << 24) | (mac[1] << 16) | (mac[2] << 8) | mac[3];
+}
+
+void UeSimulator::increment_ul_count() {
+  security_.ul_count.seq_num += 1;
+  if (!security_.ul_count.seq_num) {
+    security_.ul_count.overflow += 1;
+  }
+}
+
+}  // namespace lte
+}  // namespace magma
@@ -0,0 +1,81 @@
+/**
+ * Copyright 2022 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "lte/gateway/c/core/oai/tasks/nas/emm/emm_data.h"
+#include "lte/gateway/c/core/oai/tasks/nas/ies/EpsMobileIdentity.h"
+}
+
+namespace magma {
+namespace lte {
+
+/**
+ * NAS side of a simulated UE: builds the uplink NAS messages of the attach,
+ * detach, TAU and service request procedures and keeps the NAS security
+ * context that the MME negotiates with the UE.
+ *
+ * Every UE authenticates with the vector of send_authentication_info_resp,
+ * so only the IMSI and the GUTI differ between the UEs.
+ */
+class UeSimulator {
+ public:
+  explicit UeSimulator(const std::string& imsi);
+
+  const std::string& imsi() const { return imsi_; }
+  const guti_eps_mobile_identity_t& guti() const { return guti_; }
+  void set_guti(const guti_eps_mobile_identity_t& guti) { guti_ = guti; }
+
+  // Plain messages sent before the security mode procedure
+  std::vector<uint8_t> attach_request() const;
+  std::vector<uint8_t> authentication_response(const uint8_t* auth_request,
+                                               size_t length);
+
+  // Derives the NAS keys from the algorithms of the security mode command
+  // and protects the response with the new security context
+  std::vector<uint8_t> security_mode_complete(const uint8_t* smc,
+                                              size_t length);
+
+  // Integrity protected messages of a registered UE
+  std::vector<uint8_t> attach_complete();
+  std::vector<uint8_t> tau_request();
+  std::vector<uint8_t> detach_request();
+  std::vector<uint8_t> service_request();
+
+  // Forgets the security context, as after a detach
+  void reset();
+
+  // Returns the EMM message type of a downlink NAS message, whether it is
+  // security protected or not, or 0 if it is not an EMM message
+  static uint8_t downlink_message_type(const uint8_t* nas, size_t length);
+
+ private:
+  std::vector<uint8_t> protect(const std::vector<uint8_t>& plain,
+                               uint8_t security_header_type);
+  std::vector<uint8_t> guti_ie() const;
+  uint32_t uplink_mac(const uint8_t* buffer, size_t length) const;
+  void increment_ul_count();
+
+  std::string imsi_;
+  guti_eps_mobile_identity_t guti_;
+  ksi_t ksi_;
+  emm_security_context_t security_;
+};
+
+}  // namespace lte
+}  // namespace magma
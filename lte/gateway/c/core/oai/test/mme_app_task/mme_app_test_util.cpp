@@ -31,11 +31,6 @@ namespace lte {
 
 task_zmq_ctx_t task_zmq_ctx_main;
 
-#define DEFAULT_TEID 1
-#define DEFAULT_MME_S1AP_UE_ID 1
-
-#define DEFAULT_UE_IPv4 1000
-
 void nas_config_timer_reinit(nas_config_t* nas_conf, uint32_t timeout_msec) {
   nas_conf->t3402_min = 1;
   nas_conf->t3412_min = 1;
@@ -71,12 +66,13 @@ void send_activate_message_to_mme_app() {
 
 void send_mme_app_initial_ue_msg(const uint8_t* nas_msg, uint8_t nas_msg_length,
                                  const plmn_t& plmn,
-                                 guti_eps_mobile_identity_t& guti, tac_t tac) {
+                                 guti_eps_mobile_identity_t& guti, tac_t tac,
+                                 enb_ue_s1ap_id_t enb_ue_s1ap_id) {
   MessageDef* message_p =
       itti_alloc_new_message(TASK_S1AP, S1AP_INITIAL_UE_MESSAGE);
   ITTI_MSG_LASTHOP_LATENCY(message_p) = 0;
   S1AP_INITIAL_UE_MESSAGE(message_p).sctp_assoc_id = DEFAULT_SCTP_ASSOC_ID;
-  S1AP_INITIAL_UE_MESSAGE(message_p).enb_ue_s1ap_id = DEFAULT_eNB_S1AP_UE_ID;
+  S1AP_INITIAL_UE_MESSAGE(message_p).enb_ue_s1ap_id = enb_ue_s1ap_id;
   S1AP_INITIAL_UE_MESSAGE(message_p).enb_id = DEFAULT_ENB_ID;
   S1AP_INITIAL_UE_MESSAGE(message_p).nas = blk2bstr(nas_msg, nas_msg_length);
   S1AP_INITIAL_UE_MESSAGE(message_p).tai.plmn = plmn;
@@ -93,11 +89,12 @@ void send_mme_app_initial_ue_msg(const uint8_t* nas_msg, uint8_t nas_msg_length,
 }
 
 void send_mme_app_uplink_data_ind(const uint8_t* nas_msg,
-                                  uint8_t nas_msg_length, const plmn_t& plmn) {
+                                  uint8_t nas_msg_length, const plmn_t& plmn,
+                                  mme_ue_s1ap_id_t ue_id) {
   MessageDef* message_p =
       itti_alloc_new_message(TASK_S1AP, MME_APP_UPLINK_DATA_IND);
   ITTI_MSG_LASTHOP_LATENCY(message_p) = 0;
-  MME_APP_UL_DATA_IND(message_p).ue_id = 1;
+  MME_APP_UL_DATA_IND(message_p).ue_id = ue_id;
   MME_APP_UL_DATA_IND(message_p).nas_msg = blk2bstr(nas_msg, nas_msg_length);
   MME_APP_UL_DATA_IND(message_p).tai.plmn = plmn;
   MME_APP_UL_DATA_IND(message_p).tai.tac = 1;
@@ -183,13 +180,14 @@ void send_s6a_ula(const std::string& imsi, bool success) {
   return;
 }
 
-void send_create_session_resp(gtpv2c_cause_value_t cause_value, ebi_t ebi) {
+void send_create_session_resp(gtpv2c_cause_value_t cause_value, ebi_t ebi,
+                              teid_t teid, in_addr_t ue_ipv4) {
   MessageDef* message_p =
       itti_alloc_new_message(TASK_SPGW_APP, S11_CREATE_SESSION_RESPONSE);
   itti_s11_create_session_response_t* create_session_response_p =
       &message_p->ittiMsg.s11_create_session_response;
 
-  create_session_response_p->teid = 1;
+  create_session_response_p->teid = teid;
   create_session_response_p->cause.cause_value = cause_value;
   create_session_response_p->bearer_contexts_created.bearer_contexts[0]
       .cause.cause_value = cause_value;
@@ -197,7 +195,7 @@ void send_create_session_resp(gtpv2c_cause_value_t cause_value, ebi_t ebi) {
 
   if (cause_value == REQUEST_ACCEPTED) {
     create_session_response_p->paa.pdn_type = IPv4;
-    create_session_response_p->paa.ipv4_address.s_addr = DEFAULT_UE_IPv4;
+    create_session_response_p->paa.ipv4_address.s_addr = ue_ipv4;
     create_session_response_p->bearer_contexts_created.bearer_contexts[0]
         .s1u_sgw_fteid.teid = 1000;
     create_session_response_p->bearer_contexts_created.bearer_contexts[0]
@@ -216,23 +214,23 @@ void send_create_session_resp(gtpv2c_cause_value_t cause_value, ebi_t ebi) {
   return;
 }
 
-void send_delete_session_resp(ebi_t lbi) {
+void send_delete_session_resp(ebi_t lbi, teid_t teid) {
   MessageDef* message_p =
       itti_alloc_new_message(TASK_SPGW_APP, S11_DELETE_SESSION_RESPONSE);
   itti_s11_delete_session_response_t* delete_session_resp_p =
       &message_p->ittiMsg.s11_delete_session_response;
   delete_session_resp_p->cause.cause_value = REQUEST_ACCEPTED;
-  delete_session_resp_p->teid = 1;
+  delete_session_resp_p->teid = teid;
   delete_session_resp_p->peer_ip.s_addr = 100;
   delete_session_resp_p->lbi = lbi;
   send_msg_to_task(&task_zmq_ctx_main, TASK_MME_APP, message_p);
   return;
 }
 
-void send_ics_response() {
+void send_ics_response(mme_ue_s1ap_id_t ue_id) {
   MessageDef* message_p =
       itti_alloc_new_message(TASK_S1AP, MME_APP_INITIAL_CONTEXT_SETUP_RSP);
-  MME_APP_INITIAL_CONTEXT_SETUP_RSP(message_p).ue_id = 1;
+  MME_APP_INITIAL_CONTEXT_SETUP_RSP(message_p).ue_id = ue_id;
   MME_APP_INITIAL_CONTEXT_SETUP_RSP(message_p).e_rab_setup_list.no_of_items = 1;
   MME_APP_INITIAL_CONTEXT_SETUP_RSP(message_p)
       .e_rab_setup_list.item[0]
@@ -256,20 +254,21 @@ void send_ics_failure() {
   return;
 }
 
-void send_ue_ctx_release_complete() {
+void send_ue_ctx_release_complete(mme_ue_s1ap_id_t ue_id) {
   MessageDef* message_p =
       itti_alloc_new_message(TASK_S1AP, S1AP_UE_CONTEXT_RELEASE_COMPLETE);
-  S1AP_UE_CONTEXT_RELEASE_COMPLETE(message_p).mme_ue_s1ap_id = 1;
+  S1AP_UE_CONTEXT_RELEASE_COMPLETE(message_p).mme_ue_s1ap_id = ue_id;
   send_msg_to_task(&task_zmq_ctx_main, TASK_MME_APP, message_p);
   return;
 }
 
-void send_ue_capabilities_ind() {
+void send_ue_capabilities_ind(mme_ue_s1ap_id_t ue_id,
+                              enb_ue_s1ap_id_t enb_ue_s1ap_id) {
   MessageDef* message_p =
       itti_alloc_new_message(TASK_S1AP, S1AP_UE_CAPABILITIES_IND);
   itti_s1ap_ue_cap_ind_t* ue_cap_ind_p = &message_p->ittiMsg.s1ap_ue_cap_ind;
-  ue_cap_ind_p->enb_ue_s1ap_id = 0;
-  ue_cap_ind_p->mme_ue_s1ap_id = 1;
+  ue_cap_ind_p->enb_ue_s1ap_id = enb_ue_s1ap_id;
+  ue_cap_ind_p->mme_ue_s1ap_id = ue_id;
   ue_cap_ind_p->radio_capabilities_length = 200;
   // using malloc to create uninitialized buffer
   ue_cap_ind_p->radio_capabilities =
@@ -278,13 +277,13 @@ void send_ue_capabilities_ind() {
   return;
 }
 
-void send_context_release_req(s1cause rel_cause, task_id_t TASK_ID) {
+void send_context_release_req(s1cause rel_cause, task_id_t TASK_ID,
+                              mme_ue_s1ap_id_t ue_id,
+                              enb_ue_s1ap_id_t enb_ue_s1ap_id) {
   MessageDef* message_p =
       itti_alloc_new_message(TASK_ID, S1AP_UE_CONTEXT_RELEASE_REQ);
-  S1AP_UE_CONTEXT_RELEASE_REQ(message_p).mme_ue_s1ap_id =
-      DEFAULT_MME_S1AP_UE_ID;
-  S1AP_UE_CONTEXT_RELEASE_REQ(message_p).enb_ue_s1ap_id =
-      DEFAULT_eNB_S1AP_UE_ID;
+  S1AP_UE_CONTEXT_RELEASE_REQ(message_p).mme_ue_s1ap_id = ue_id;
+  S1AP_UE_CONTEXT_RELEASE_REQ(message_p).enb_ue_s1ap_id = enb_ue_s1ap_id;
   S1AP_UE_CONTEXT_RELEASE_REQ(message_p).enb_id = DEFAULT_ENB_ID;
   S1AP_UE_CONTEXT_RELEASE_REQ(message_p).relCause = rel_cause;
   send_msg_to_task(&task_zmq_ctx_main, TASK_MME_APP, message_p);
@@ -292,12 +291,13 @@ void send_context_release_req(s1cause rel_cause, task_id_t TASK_ID) {
 }
 
 void send_modify_bearer_resp(const std::vector<int>& bearer_to_modify,
-                             const std::vector<int>& bearer_to_remove) {
+                             const std::vector<int>& bearer_to_remove,
+                             teid_t teid) {
   MessageDef* message_p =
       itti_alloc_new_message(TASK_SPGW_APP, S11_MODIFY_BEARER_RESPONSE);
   itti_s11_modify_bearer_response_t* modify_response_p =
       &message_p->ittiMsg.s11_modify_bearer_response;
-  modify_response_p->teid = 1;
+  modify_response_p->teid = teid;
   modify_response_p->cause.cause_value = REQUEST_ACCEPTED;
   for (int i = 0; i < bearer_to_modify.size(); ++i) {
     modify_response_p->bearer_contexts_modified.bearer_contexts[i]
@@ -319,13 +319,14 @@ void send_modify_bearer_resp(const std::vector<int>& bearer_to_modify,
   return;
 }
 
-void sgw_send_release_access_bearer_response(gtpv2c_cause_value_t cause) {
+void sgw_send_release_access_bearer_response(gtpv2c_cause_value_t cause,
+                                             teid_t teid) {
   MessageDef* message_p = itti_alloc_new_message(
       TASK_SPGW_APP, S11_RELEASE_ACCESS_BEARERS_RESPONSE);
   itti_s11_release_access_bearers_response_t* release_access_bearers_resp_p =
       &message_p->ittiMsg.s11_release_access_bearers_response;
   release_access_bearers_resp_p->cause.cause_value = cause;
-  release_access_bearers_resp_p->teid = 1;
+  release_access_bearers_resp_p->teid = teid;
   send_msg_to_task(&task_zmq_ctx_main, TASK_MME_APP, message_p);
   return;
 }
@@ -430,12 +431,12 @@ void send_erab_release_rsp() {
   return;
 }
 
-void send_paging_request() {
+void send_paging_request(in_addr_t ue_ipv4) {
   MessageDef* message_p =
       itti_alloc_new_message(TASK_SPGW_APP, S11_PAGING_REQUEST);
   itti_s11_paging_request_t* paging_request_p =
       &message_p->ittiMsg.s11_paging_request;
-  paging_request_p->address.ipv4_addr.sin_addr.s_addr = DEFAULT_UE_IPv4;
+  paging_request_p->address.ipv4_addr.sin_addr.s_addr = ue_ipv4;
   paging_request_p->ip_addr_type = IPV4_ADDR_TYPE;
   send_msg_to_task(&task_zmq_ctx_main, TASK_MME_APP, message_p);
   return;
@@ -574,5 +575,16 @@ void send_s6a_reset(void) {
   return;
 }
 
+void send_agw_offload_ues_req(offload_type_t offload_type, uint32_t enb_id,
+                              sctp_assoc_id_t sctp_assoc_id) {
+  MessageDef* message_p = itti_alloc_new_message(TASK_HA, AGW_OFFLOAD_UES_REQ);
+  AGW_OFFLOAD_UES_REQ(message_p).request.eNB_id = enb_id;
+  AGW_OFFLOAD_UES_REQ(message_p).request.enb_offload_type = offload_type;
+  AGW_OFFLOAD_UES_REQ(message_p).nb_sctp_assoc = 1;
+  AGW_OFFLOAD_UES_REQ(message_p).sctp_assoc_id[0] = sctp_assoc_id;
+  send_msg_to_task(&task_zmq_ctx_main, TASK_MME_APP, message_p);
+  return;
+}
+
 }  // namespace lte
 }  // namespace magma
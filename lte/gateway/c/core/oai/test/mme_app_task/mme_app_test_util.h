@@ -17,6 +17,7 @@
 extern "C" {
 #include "lte/gateway/c/core/oai/lib/itti/intertask_interface.h"
 #include "lte/gateway/c/core/oai/lib/3gpp/3gpp_29.274.h"
+#include "lte/gateway/c/core/oai/include/ha_messages_types.h"
 #include "lte/gateway/c/core/oai/include/mme_config.h"
 #include "lte/gateway/c/core/oai/lib/itti/intertask_interface_types.h"
 #include "lte/gateway/c/core/oai/include/s1ap_messages_types.h"
@@ -38,6 +39,9 @@ extern task_zmq_ctx_t task_zmq_ctx_main;
 #define DEFAULT_eNB_S1AP_UE_ID 0
 #define DEFAULT_SCTP_ASSOC_ID 0U
 #define DEFAULT_ENB_ID 0
+#define DEFAULT_TEID 1
+#define DEFAULT_MME_S1AP_UE_ID 1
+#define DEFAULT_UE_IPv4 1000
 
 #define MME_APP_EXPECT_CALLS(dlNas, connEstConf, ctxRel, air, ulr, purgeReq,   \
                              csr, mbr, relBearer, dsr, setAppHealth)           \
@@ -80,35 +84,49 @@ void send_sctp_mme_server_initialized();
 
 void send_activate_message_to_mme_app();
 
-void send_mme_app_initial_ue_msg(const uint8_t* nas_msg, uint8_t nas_msg_length,
-                                 const plmn_t& plmn,
-                                 guti_eps_mobile_identity_t& guti, tac_t tac);
+// The UE identifiers default to the ones of the single UE the procedure tests
+// attach, the load generator passes its own for each simulated UE
+void send_mme_app_initial_ue_msg(
+    const uint8_t* nas_msg, uint8_t nas_msg_length, const plmn_t& plmn,
+    guti_eps_mobile_identity_t& guti, tac_t tac,
+    enb_ue_s1ap_id_t enb_ue_s1ap_id = DEFAULT_eNB_S1AP_UE_ID);
 
-void send_mme_app_uplink_data_ind(const uint8_t* nas_msg,
-                                  uint8_t nas_msg_length, const plmn_t& plmn);
+void send_mme_app_uplink_data_ind(
+    const uint8_t* nas_msg, uint8_t nas_msg_length, const plmn_t& plmn,
+    mme_ue_s1ap_id_t ue_id = DEFAULT_MME_S1AP_UE_ID);
 
 void send_authentication_info_resp(const std::string& imsi, bool success);
 
 void send_s6a_ula(const std::string& imsi, bool success);
 
-void send_create_session_resp(gtpv2c_cause_value_t cause_value, ebi_t ebi);
+void send_create_session_resp(gtpv2c_cause_value_t cause_value, ebi_t ebi,
+                              teid_t teid = DEFAULT_TEID,
+                              in_addr_t ue_ipv4 = DEFAULT_UE_IPv4);
 
-void send_delete_session_resp(ebi_t lbi);
+void send_delete_session_resp(ebi_t lbi, teid_t teid = DEFAULT_TEID);
 
-void send_ics_response();
+void send_ics_response(mme_ue_s1ap_id_t ue_id = DEFAULT_MME_S1AP_UE_ID);
 
 void send_ics_failure();
 
-void send_ue_ctx_release_complete();
+void send_ue_ctx_release_complete(
+    mme_ue_s1ap_id_t ue_id = DEFAULT_MME_S1AP_UE_ID);
 
-void send_ue_capabilities_ind();
+void send_ue_capabilities_ind(
+    mme_ue_s1ap_id_t ue_id = DEFAULT_MME_S1AP_UE_ID,
+    enb_ue_s1ap_id_t enb_ue_s1ap_id = DEFAULT_eNB_S1AP_UE_ID);
 
-void send_context_release_req(s1cause rel_cause, task_id_t TASK_ID);
+void send_context_release_req(
+    s1cause rel_cause, task_id_t TASK_ID,
+    mme_ue_s1ap_id_t ue_id = DEFAULT_MME_S1AP_UE_ID,
+    enb_ue_s1ap_id_t enb_ue_s1ap_id = DEFAULT_eNB_S1AP_UE_ID);
 
 void send_modify_bearer_resp(const std::vector<int>& bearer_to_modify,
-                             const std::vector<int>& bearer_to_remove);
+                             const std::vector<int>& bearer_to_remove,
+                             teid_t teid = DEFAULT_TEID);
 
-void sgw_send_release_access_bearer_response(gtpv2c_cause_value_t cause);
+void sgw_send_release_access_bearer_response(gtpv2c_cause_value_t cause,
+                                             teid_t teid = DEFAULT_TEID);
 
 void send_s11_deactivate_bearer_req(uint8_t no_of_bearers_to_be_deact,
                                     uint8_t* ebi_to_be_deactivated,
@@ -120,7 +138,7 @@ void send_erab_setup_rsp(ebi_t ebi);
 
 void send_erab_release_rsp();
 
-void send_paging_request();
+void send_paging_request(in_addr_t ue_ipv4 = DEFAULT_UE_IPv4);
 
 void send_s1ap_path_switch_req(const uint32_t sctp_assoc_id,
                                const uint32_t enb_id,
@@ -148,5 +166,8 @@ void send_s1ap_handover_notify(const uint32_t tgt_sctp_assoc_id,
 void send_s6a_clr(const std::string& imsi);
 
 void send_s6a_reset(void);
+
+void send_agw_offload_ues_req(offload_type_t offload_type, uint32_t enb_id,
+                              sctp_assoc_id_t sctp_assoc_id);
 }  // namespace lte
 }  // namespace magma
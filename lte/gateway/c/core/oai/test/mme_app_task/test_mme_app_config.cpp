@@ -11,6 +11,10 @@
  * limitations under the License.
  */
 #include <gtest/gtest.h>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "lte/gateway/c/core/oai/lib/bstr/bstrlib.h"
 
 extern "C" {
@@ -956,5 +960,94 @@ TEST(MMEConfigTest, TestCopyAmfConfigFromMMEConfig) {
   clear_amf_config(&amf_config);
   free_mme_config(&mme_config);
 }
+
+// config with the first occurrence of from replaced by to
+static std::string replace_first(std::string config, const std::string& from,
+                                 const std::string& to) {
+  config.replace(config.find(from), from.size(), to);
+  return config;
+}
+
+class MMEConfigReloadTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    mme_config_init(&::mme_config);
+    ASSERT_EQ(mme_config_parse_string(kHealthyConfig, &::mme_config), 0);
+  }
+
+  virtual void TearDown() { mme_config_exit(); }
+};
+
+TEST_F(MMEConfigReloadTest, TestReloadServedTaisAndTimers) {
+  std::string config =
+      replace_first(kHealthyConfig, R"(TAC="1"; })",
+                    R"(TAC="1"; }, { MCC="001" ; MNC="01" ; TAC="2"; })");
+  config = replace_first(config, "T3412                                 =  54",
+                         "T3412 = 30");
+
+  EXPECT_EQ(mme_config_reload_string(config.c_str()), RETURNok);
+
+  const mme_config_t* snapshot = mme_config_get();
+  EXPECT_NE(snapshot, &::mme_config);
+  ASSERT_EQ(snapshot->served_tai.nb_tai, 2);
+  EXPECT_EQ(snapshot->served_tai.tac[0], 1);
+  EXPECT_EQ(snapshot->served_tai.tac[1], 2);
+  ASSERT_NE(snapshot->partial_list, nullptr);
+  EXPECT_EQ(snapshot->partial_list[0].nb_elem, 2);
+  EXPECT_EQ(snapshot->nas_config.t3412_min, 30);
+  // Settings that are not reloadable are shared with the global
+  EXPECT_EQ(snapshot->realm, ::mme_config.realm);
+  EXPECT_EQ(::mme_config.served_tai.nb_tai, 1);
+  EXPECT_EQ(::mme_config.nas_config.t3412_min, 54);
+}
+
+TEST_F(MMEConfigReloadTest, TestReloadRejectsGummeiChange) {
+  std::string config =
+      replace_first(kHealthyConfig, R"(MME_CODE="1")", R"(MME_CODE="2")");
+
+  EXPECT_EQ(mme_config_reload_string(config.c_str()), RETURNerror);
+  EXPECT_EQ(mme_config_get(), &::mme_config);
+}
+
+TEST_F(MMEConfigReloadTest, TestReloadRejectsSyntaxError) {
+  EXPECT_EQ(mme_config_reload_string("MME : { TAI_LIST = ( };"), RETURNerror);
+  EXPECT_EQ(mme_config_get(), &::mme_config);
+}
+
+TEST_F(MMEConfigReloadTest, TestReloadSurvivesFatalConfig) {
+  // A bad MCC length is fatal at startup
+  std::string config =
+      replace_first(kHealthyConfig, R"(MCC="001" ; MNC="01"; MME_GID)",
+                    R"(MCC="01" ; MNC="01"; MME_GID)");
+
+  EXPECT_EQ(mme_config_reload_string(config.c_str()), RETURNerror);
+  EXPECT_EQ(mme_config_get(), &::mme_config);
+}
+
+TEST(MMEConfigTest, TestParseNonfatalHealthyConfig) {
+  mme_config_t mme_config = {0};
+  EXPECT_EQ(mme_config_parse_string_nonfatal(kHealthyConfig, &mme_config), 0);
+  free_mme_config(&mme_config);
+}
+
+TEST(MMEConfigTest, TestParseNonfatalRejectsInvalidSettings) {
+  const std::vector<std::pair<std::string, std::string>> invalid = {
+      {R"(USE_STATELESS = "True")", R"(USE_STATELESS = "maybe")"},
+      {"\"192.168.60.142/24\"", "\"192.168.60.142\""},
+      {"\"192.168.60.142/24\"", "\"192.168.60.1422/24\""},
+      {R"(MCC="001" ; MNC="01"; MME_GID)", R"(MCC="01" ; MNC="01"; MME_GID)"},
+      {"RELATIVE_CAPACITY                         = 11;",
+       "RELATIVE_CAPACITY = ;"},
+  };
+  for (const auto& setting : invalid) {
+    std::string config =
+        replace_first(kHealthyConfig, setting.first, setting.second);
+    mme_config_t mme_config = {0};
+    EXPECT_EQ(mme_config_parse_string_nonfatal(config.c_str(), &mme_config),
+              -1)
+        << setting.second;
+    free_mme_config(&mme_config);
+  }
+}
 }  // namespace lte
 }  // namespace magma
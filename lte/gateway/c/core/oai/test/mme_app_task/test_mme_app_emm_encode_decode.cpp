@@ -14,6 +14,7 @@
 
 extern "C" {
 #include "lte/gateway/c/core/common/dynamic_memory_check.h"
+#include "lte/gateway/c/core/oai/common/TLVDecoder.h"
 #include "lte/gateway/c/core/oai/common/log.h"
 #include "lte/gateway/c/core/oai/tasks/nas/emm/msg/AttachAccept.h"
 #include "lte/gateway/c/core/oai/tasks/nas/emm/msg/AttachRequest.h"
@@ -196,6 +197,84 @@ TEST_F(EMMEncodeDecodeTest, TestDecodeAttachRequestPixel) {
   bdestroy_wrapper(&attach_request.supportedcodecs);
 }
 
+TEST_F(EMMEncodeDecodeTest, TestDecodeAttachRequestViews) {
+  //   Combined attach, NAS message generated from s1ap tester
+  uint8_t buffer[] = {0x72, 0x08, 0x09, 0x10, 0x10, 0x00, 0x00, 0x00,
+                      0x00, 0x10, 0x02, 0xe0, 0xe0, 0x00, 0x04, 0x02,
+                      0x01, 0xd0, 0x11, 0x40, 0x08, 0x04, 0x02, 0x60,
+                      0x04, 0x00, 0x02, 0x1c, 0x00};
+  uint32_t len = 29;
+  attach_request_msg attach_request = {0};
+
+  tlv_decoder_views_t views = tlv_decoder_views_open();
+  tlv_decoder_views_enable(true);
+  int decoded = decode_attach_request(&attach_request, buffer, len);
+  tlv_decoder_views_enable(false);
+  ASSERT_EQ(decoded, len);
+
+  // The variable length IEs point into the buffer
+  bstring container = attach_request.esmmessagecontainer;
+  ASSERT_NE(container, nullptr);
+  EXPECT_LE(container->mlen, 0);
+  EXPECT_GE(container->data, buffer);
+  EXPECT_LE(container->data + blength(container), buffer + len);
+  EXPECT_LE(attach_request.supportedcodecs->mlen, 0);
+
+  // Encoding back is unchanged
+  int encoded = encode_attach_request(&attach_request, temp_buffer, decoded);
+  ASSERT_EQ(encoded, decoded);
+  EXPECT_ARRAY_EQ(buffer, temp_buffer, encoded);
+
+  // Taking the container copies it out of the buffer
+  bstring owned = tlv_decoder_views_own(&attach_request.esmmessagecontainer);
+  EXPECT_EQ(attach_request.esmmessagecontainer, nullptr);
+  ASSERT_NE(owned, nullptr);
+  EXPECT_GT(owned->mlen, 0);
+  ASSERT_EQ(blength(owned), blength(container));
+  EXPECT_EQ(memcmp(owned->data, container->data, blength(owned)), 0);
+
+  // Destroying a view leaves the buffer alone
+  bdestroy_wrapper(&attach_request.supportedcodecs);
+  tlv_decoder_views_close(views);
+  bdestroy_wrapper(&owned);
+
+  // Outside of a scope the IEs are heap copies again
+  attach_request_msg copied = {0};
+  tlv_decoder_views_enable(true);
+  decoded = decode_attach_request(&copied, buffer, len);
+  tlv_decoder_views_enable(false);
+  ASSERT_EQ(decoded, len);
+  EXPECT_GT(copied.esmmessagecontainer->mlen, 0);
+  bdestroy_wrapper(&copied.esmmessagecontainer);
+  bdestroy_wrapper(&copied.supportedcodecs);
+}
+
+TEST_F(EMMEncodeDecodeTest, TestDecoderViewsScratch) {
+  EXPECT_EQ(tlv_decoder_views_scratch(BUFFER_LEN), nullptr);
+
+  tlv_decoder_views_t views = tlv_decoder_views_open();
+  bstring first = tlv_decoder_views_scratch(BUFFER_LEN);
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(blength(first), BUFFER_LEN);
+  bstring second = tlv_decoder_views_scratch(BUFFER_LEN);
+  ASSERT_NE(second, nullptr);
+  EXPECT_GE(second->data, first->data + BUFFER_LEN);
+  // Larger than the arena
+  EXPECT_EQ(tlv_decoder_views_scratch(1 << 20), nullptr);
+
+  // A nested scope gives its space back when closed
+  tlv_decoder_views_t nested = tlv_decoder_views_open();
+  bstring third = tlv_decoder_views_scratch(BUFFER_LEN);
+  ASSERT_NE(third, nullptr);
+  tlv_decoder_views_close(nested);
+  bstring fourth = tlv_decoder_views_scratch(BUFFER_LEN);
+  ASSERT_NE(fourth, nullptr);
+  EXPECT_EQ(fourth->data, third->data);
+
+  tlv_decoder_views_close(views);
+  EXPECT_EQ(tlv_decoder_views_scratch(BUFFER_LEN), nullptr);
+}
+
 TEST_F(EMMEncodeDecodeTest, TestEncodeDecodeEmmInformation) {
   emm_information_msg original_msg = {0};
   emm_information_msg decoded_msg = {0};
@@ -22,6 +22,8 @@ extern "C" {
 #include "lte/gateway/c/core/oai/common/conversions.h"
 #include "lte/gateway/c/core/oai/include/mme_app_ue_context.h"
 #include "lte/gateway/c/core/oai/lib/3gpp/3gpp_23.003.h"
+#include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_auth_vector_cache.h"
+#include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_shared_ue_data.h"
 }
 
 #define TEST_CASE_COMMON_CONVERT_MAX 10
@@ -272,3 +274,109 @@ TEST(imsi_equal_test, ok) {
   ASSERT_EQ(mme_app_imsi_compare(&imsi_mme_b, &imsi_mme_a), false);
   ASSERT_EQ(mme_app_imsi_compare(&imsi_mme_a, &imsi_mme_a), true);
 }
+
+TEST(shared_apn_config_profile_test, ok) {
+  apn_config_profile_t profile = {};
+  profile.context_identifier = 1;
+  profile.nb_apns = 1;
+  profile.apn_configuration[0].context_identifier = 1;
+  profile.apn_configuration[0].pdn_type = IPv4_AND_v6;
+  uint32_t count = mme_app_shared_apn_config_profiles_count();
+
+  const apn_config_profile_t* first =
+      mme_app_share_apn_config_profile(&profile);
+  ASSERT_NE(first, nullptr);
+  // Configurations past nb_apns are ignored
+  profile.apn_configuration[1].context_identifier = 2;
+  const apn_config_profile_t* second =
+      mme_app_share_apn_config_profile(&profile);
+  ASSERT_EQ(first, second);
+  ASSERT_EQ(mme_app_shared_apn_config_profiles_count(), count + 1);
+
+  profile.apn_configuration[0].pdn_type = IPv4;
+  const apn_config_profile_t* other =
+      mme_app_share_apn_config_profile(&profile);
+  ASSERT_NE(other, first);
+  ASSERT_EQ(other->apn_configuration[0].pdn_type, IPv4);
+  ASSERT_EQ(mme_app_shared_apn_config_profiles_count(), count + 2);
+
+  // The copy is freed with its last reference
+  mme_app_release_apn_config_profile(&first);
+  ASSERT_EQ(first, nullptr);
+  ASSERT_EQ(mme_app_shared_apn_config_profiles_count(), count + 2);
+  mme_app_release_apn_config_profile(&second);
+  ASSERT_EQ(mme_app_shared_apn_config_profiles_count(), count + 1);
+  mme_app_release_apn_config_profile(&other);
+  ASSERT_EQ(mme_app_shared_apn_config_profiles_count(), count);
+}
+
+TEST(shared_tai_list_test, ok) {
+  tai_list_t tai_list = {};
+  tai_list.numberoflists = 1;
+  tai_list.partial_tai_list[0].typeoflist =
+      TRACKING_AREA_IDENTITY_LIST_ONE_PLMN_CONSECUTIVE_TACS;
+  tai_list.partial_tai_list[0].u.tai_one_plmn_consecutive_tacs.tac = 1;
+  uint32_t count = mme_app_shared_tai_lists_count();
+
+  const tai_list_t* first = mme_app_share_tai_list(&tai_list);
+  tai_list.partial_tai_list[1].numberofelements = 3;
+  const tai_list_t* second = mme_app_share_tai_list(&tai_list);
+  ASSERT_NE(first, nullptr);
+  ASSERT_EQ(first, second);
+  ASSERT_EQ(mme_app_shared_tai_lists_count(), count + 1);
+
+  mme_app_release_tai_list(&first);
+  mme_app_release_tai_list(&second);
+  ASSERT_EQ(second, nullptr);
+  ASSERT_EQ(mme_app_shared_tai_lists_count(), count);
+}
+
+TEST(auth_vector_cache_test, ok) {
+  auth_vector_cache_config_t config = {true, 4, 3600, 2};
+  eutran_vector_t vectors[MAX_AUTH_INFO_VECTORS] = {};
+  eutran_vector_t vector = {};
+  for (int i = 0; i < MAX_AUTH_INFO_VECTORS; i++) {
+    vectors[i].rand[0] = i;
+  }
+  // A refill stays pending for the S6a timeout
+  mme_config.nas_config.ts6a_msec = 5000;
+  mme_app_auth_vector_cache_init(&config, 64);
+  ASSERT_EQ(mme_app_auth_vector_cache_nb_vectors_to_fetch(), 5);
+
+  // Vectors are handed out oldest first
+  ASSERT_FALSE(mme_app_auth_vector_cache_pop(1, &vector));
+  mme_app_auth_vector_cache_push(1, &vectors[1], 4);
+  ASSERT_TRUE(mme_app_auth_vector_cache_pop(1, &vector));
+  ASSERT_EQ(vector.rand[0], 1);
+  ASSERT_EQ(mme_app_auth_vector_cache_start_refill(1), 0);
+  ASSERT_TRUE(mme_app_auth_vector_cache_pop(1, &vector));
+  ASSERT_TRUE(mme_app_auth_vector_cache_pop(1, &vector));
+  ASSERT_EQ(vector.rand[0], 3);
+
+  // Below the watermark a single refill is requested
+  ASSERT_EQ(mme_app_auth_vector_cache_start_refill(1), 3);
+  ASSERT_EQ(mme_app_auth_vector_cache_start_refill(1), 0);
+
+  // The answer of a refill sent before a flush is stale
+  mme_app_auth_vector_cache_flush(1);
+  ASSERT_TRUE(mme_app_auth_vector_cache_drop_stale_answer(1));
+  ASSERT_FALSE(mme_app_auth_vector_cache_drop_stale_answer(1));
+  ASSERT_TRUE(mme_app_auth_vector_cache_refill_done(1));
+
+  // A full cache keeps the newest vectors
+  mme_app_auth_vector_cache_push(1, vectors, MAX_AUTH_INFO_VECTORS);
+  ASSERT_TRUE(mme_app_auth_vector_cache_pop(1, &vector));
+  ASSERT_EQ(vector.rand[0], 1);
+  mme_app_auth_vector_cache_push(2, vectors, 1);
+  ASSERT_EQ(mme_app_auth_vector_cache_nb_subscribers(), 2);
+  mme_app_auth_vector_cache_exit();
+
+  // Expired vectors are never handed out and get purged
+  config.ttl_sec = 0;
+  mme_app_auth_vector_cache_init(&config, 64);
+  mme_app_auth_vector_cache_push(3, vectors, 2);
+  ASSERT_FALSE(mme_app_auth_vector_cache_pop(3, &vector));
+  mme_app_auth_vector_cache_purge_expired();
+  ASSERT_EQ(mme_app_auth_vector_cache_nb_subscribers(), 0);
+  mme_app_auth_vector_cache_exit();
+}
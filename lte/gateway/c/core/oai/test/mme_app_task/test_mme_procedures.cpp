@@ -829,6 +829,49 @@ TEST_F(MmeAppProcedureTest, TestAttachIdleDetach) {
   detach_ue(cv, lock, mme_state_p, guti, false);
 }
 
+TEST_F(MmeAppProcedureTest, TestAttachHaOffloadEnbDetach) {
+  mme_app_desc_t* mme_state_p =
+      magma::lte::MmeNasStateManager::getInstance().get_state(false);
+  std::condition_variable cv;
+  std::mutex mx;
+  std::unique_lock<std::mutex> lock(mx);
+
+  MME_APP_EXPECT_CALLS(3, 1, 2, 1, 1, 1, 1, 1, 0, 1, 3);
+  // The UEs of the eNB are offloaded from the bulk signalling queue, so wait
+  // for the Release Access Bearer Request before answering it
+  EXPECT_CALL(*spgw_handler, sgw_handle_release_access_bearers_request())
+      .WillOnce(ReturnFromAsyncTask(&cv));
+
+  // Attach the UE
+  guti = {0};
+  attach_ue(cv, lock, mme_state_p, &guti);
+
+  // Send the offload request of the UE's eNB mimicing HA
+  send_agw_offload_ues_req(ALL, DEFAULT_ENB_ID, DEFAULT_SCTP_ASSOC_ID);
+  cv.wait_for(lock, std::chrono::milliseconds(STATE_MAX_WAIT_MS));
+
+  // Constructing and sending Release Access Bearer Response to mme_app
+  // mimicing SPGW
+  sgw_send_release_access_bearer_response(REQUEST_ACCEPTED);
+
+  // Wait for context release command
+  cv.wait_for(lock, std::chrono::milliseconds(STATE_MAX_WAIT_MS));
+  // Constructing and sending CONTEXT RELEASE COMPLETE to mme_app
+  // mimicing S1AP task
+  send_ue_ctx_release_complete();
+
+  // Check MME state after the UE is offloaded
+  send_activate_message_to_mme_app();
+  cv.wait_for(lock, std::chrono::milliseconds(STATE_MAX_WAIT_MS));
+  EXPECT_EQ(mme_state_p->nb_ue_attached, 1);
+  EXPECT_EQ(mme_state_p->nb_ue_connected, 0);
+  EXPECT_EQ(mme_state_p->nb_default_eps_bearers, 1);
+  EXPECT_EQ(mme_state_p->nb_ue_idle, 1);
+  EXPECT_EQ(mme_state_p->nb_s1u_bearers, 0);
+
+  detach_ue(cv, lock, mme_state_p, guti, false);
+}
+
 TEST_F(MmeAppProcedureTest, TestAttachIdleServiceReqDetach) {
   mme_app_desc_t* mme_state_p =
       magma::lte::MmeNasStateManager::getInstance().get_state(false);
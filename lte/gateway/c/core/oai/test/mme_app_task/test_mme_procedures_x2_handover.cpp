@@ -19,6 +19,7 @@
 #include <condition_variable>
 #include <stdio.h>
 
+#include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_enb_ue_index.hpp"
 #include "lte/gateway/c/core/oai/tasks/mme_app/mme_app_state_manager.hpp"
 #include "lte/gateway/c/core/oai/test/mme_app_task/mme_app_test_util.h"
 #include "lte/gateway/c/core/oai/test/mme_app_task/mme_procedure_test_fixture.h"
@@ -118,7 +119,12 @@ TEST_F(MmeAppProcedureTest, TestX2HandoverPathSwitchSuccess) {
   EXPECT_EQ(mme_state_p->nb_ue_idle, 0);
   EXPECT_EQ(mme_state_p->nb_s1u_bearers, 1);
 
+  // The UE is now indexed under the target eNB only
+  EXPECT_EQ(mme_app_enb_ue_index_get_ues(DEFAULT_SCTP_ASSOC_ID, NULL), 0);
+  EXPECT_EQ(mme_app_enb_ue_index_get_ues(new_sctp_assoc_id, NULL), 1);
+
   detach_ue(cv, lock, mme_state_p, guti, false);
+  EXPECT_EQ(mme_app_enb_ue_index_get_ues(new_sctp_assoc_id, NULL), 0);
 }
 
 }  // namespace lte
@@ -25,6 +25,7 @@ extern "C" {
 #include "lte/gateway/c/core/oai/common/itti_free_defined_msg.h"
 #include "lte/gateway/c/core/oai/include/s11_messages_types.h"
 #include "lte/gateway/c/core/oai/include/s1ap_messages_types.h"
+#include "lte/gateway/c/core/oai/include/sctp_messages_types.h"
 }
 
 const task_info_t tasks_info[] = {
@@ -92,7 +93,7 @@ class MockMmeAppHandler {
 
 class MockSctpHandler {
  public:
-  MOCK_METHOD0(sctpd_send_dl, void());
+  MOCK_METHOD1(sctpd_send_dl, void(sctp_data_req_t data_req));
 };
 
 class MockS6aHandler {
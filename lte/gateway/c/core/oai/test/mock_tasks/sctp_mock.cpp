@@ -28,7 +28,7 @@ static int handle_message(zloop_t* loop, zsock_t* reader, void* arg) {
     } break;
 
     case SCTP_DATA_REQ: {
-      sctp_handler_->sctpd_send_dl();
+      sctp_handler_->sctpd_send_dl(SCTP_DATA_REQ(received_message_p));
     } break;
 
     case MESSAGE_TEST: {
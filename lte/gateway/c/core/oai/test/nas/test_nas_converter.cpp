@@ -31,7 +31,7 @@ namespace magma {
 namespace lte {
 
 TEST(NasStateConverterTest, TestEmmContextConversion) {
-  emm_context_t emm_context;
+  emm_context_t emm_context = {};
 
   emm_init_context(&emm_context, true);
 
@@ -75,7 +75,19 @@ TEST(NasStateConverterTest, TestEmmContextConversion) {
   emm_context.esm_ctx.esm_proc_data->apn = bstr_apn;
   emm_context.esm_ctx.T3489.id = NAS_TIMER_INACTIVE_ID;
 
-  emm_context._tai_list.numberoflists = 0;
+  tai_list_t tai_list = {};
+  tai_list.numberoflists = 1;
+  tai_list.partial_tai_list[0].typeoflist =
+      TRACKING_AREA_IDENTITY_LIST_ONE_PLMN_CONSECUTIVE_TACS;
+  tai_t* tai = &tai_list.partial_tai_list[0].u.tai_one_plmn_consecutive_tacs;
+  tai->plmn.mcc_digit1 = 3;
+  tai->plmn.mcc_digit2 = 1;
+  tai->plmn.mcc_digit3 = 0;
+  tai->plmn.mnc_digit1 = 1;
+  tai->plmn.mnc_digit2 = 5;
+  tai->plmn.mnc_digit3 = 0;
+  tai->tac = 1;
+  emm_ctx_set_tai_list(&emm_context, &tai_list);
 
   emm_context.new_attach_info =
       (new_attach_info_t*)calloc(1, sizeof(new_attach_info_t));
@@ -90,10 +102,12 @@ TEST(NasStateConverterTest, TestEmmContextConversion) {
   oai::EmmContext proto_state;
   NasStateConverter::emm_context_to_proto(&emm_context, &proto_state);
 
-  emm_context_t final_state;
+  emm_context_t final_state = {};
   NasStateConverter::proto_to_emm_context(proto_state, &final_state);
 
   EXPECT_EQ(emm_context._imsi64, final_state._imsi64);
+  // Both contexts hold the same shared TAI list
+  EXPECT_EQ(emm_context._tai_list, final_state._tai_list);
 
   EXPECT_STREQ((char*)emm_context.esm_ctx.esm_proc_data->pdn_addr->data,
                (char*)final_state.esm_ctx.esm_proc_data->pdn_addr->data);
@@ -0,0 +1,173 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the terms found in the LICENSE file in the root of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "lte/gateway/c/core/oai/lib/openflow/controller/FlowModBatch.hpp"
+
+using namespace openflow;
+
+namespace {
+
+// A flow mod is enough like any other message for the batch
+const uint8_t OFPT_FLOW_MOD = 14;
+
+std::vector<uint8_t> make_msg(uint8_t type, uint16_t len) {
+  std::vector<uint8_t> msg(len, 0xab);
+  msg[0] = FlowModBatch::OF_13_VERSION;
+  msg[1] = type;
+  msg[2] = len >> 8;
+  msg[3] = len & 0xff;
+  msg[4] = msg[5] = msg[6] = 0;
+  msg[7] = 1;
+  return msg;
+}
+
+uint16_t read_u16(const std::vector<uint8_t>& buf, size_t offset) {
+  return (buf[offset] << 8) | buf[offset + 1];
+}
+
+uint32_t read_u32(const std::vector<uint8_t>& buf, size_t offset) {
+  return ((uint32_t)read_u16(buf, offset) << 16) | read_u16(buf, offset + 2);
+}
+
+struct Msg {
+  uint8_t type;
+  uint16_t len;
+  uint32_t xid;
+  size_t offset;
+};
+
+std::vector<Msg> split(const std::vector<uint8_t>& buf) {
+  std::vector<Msg> msgs;
+  size_t offset = 0;
+  while (offset + 8 <= buf.size()) {
+    Msg msg = {buf[offset + 1], read_u16(buf, offset + 2),
+               read_u32(buf, offset + 4), offset};
+    EXPECT_EQ(buf[offset], FlowModBatch::OF_13_VERSION);
+    msgs.push_back(msg);
+    offset += msg.len;
+  }
+  EXPECT_EQ(offset, buf.size());
+  return msgs;
+}
+
+TEST(FlowModBatchTest, TestCoalesceAndXids) {
+  FlowModBatch batch;
+  auto fm = make_msg(OFPT_FLOW_MOD, 56);
+  batch.add_message(fm.data(), fm.size());
+  batch.add_message(fm.data(), fm.size());
+  EXPECT_EQ(batch.size(), 112);
+
+  auto buf = batch.take();
+  EXPECT_TRUE(batch.empty());
+  auto msgs = split(buf);
+  ASSERT_EQ(msgs.size(), 2);
+  EXPECT_EQ(msgs[0].type, OFPT_FLOW_MOD);
+  EXPECT_NE(msgs[0].xid, msgs[1].xid);
+  // The body is copied untouched
+  EXPECT_EQ(buf[8], 0xab);
+  EXPECT_EQ(buf[111], 0xab);
+}
+
+TEST(FlowModBatchTest, TestBundle) {
+  FlowModBatch batch;
+  auto fm = make_msg(OFPT_FLOW_MOD, 56);
+  batch.open_bundle();
+  EXPECT_TRUE(batch.in_bundle());
+  batch.add_message(fm.data(), fm.size());
+  batch.commit_bundle();
+  EXPECT_FALSE(batch.in_bundle());
+
+  auto buf = batch.take();
+  auto msgs = split(buf);
+  ASSERT_EQ(msgs.size(), 3);
+  for (const auto& msg : msgs) {
+    EXPECT_EQ(msg.type, FlowModBatch::OFPT_EXPERIMENTER);
+    EXPECT_EQ(read_u32(buf, msg.offset + 8), FlowModBatch::ONF_EXPERIMENTER_ID);
+  }
+  uint32_t bundle_id = read_u32(buf, msgs[0].offset + 16);
+  EXPECT_EQ(read_u32(buf, msgs[0].offset + 12),
+            FlowModBatch::ONFT_BUNDLE_CONTROL);
+  EXPECT_EQ(read_u16(buf, msgs[0].offset + 20),
+            FlowModBatch::BUNDLE_OPEN_REQUEST);
+
+  // The wrapped flow mod carries the xid of the bundle add
+  EXPECT_EQ(read_u32(buf, msgs[1].offset + 12),
+            FlowModBatch::ONFT_BUNDLE_ADD_MESSAGE);
+  EXPECT_EQ(read_u32(buf, msgs[1].offset + 16), bundle_id);
+  EXPECT_EQ(msgs[1].len, 24 + fm.size());
+  EXPECT_EQ(buf[msgs[1].offset + 25], OFPT_FLOW_MOD);
+  EXPECT_EQ(read_u32(buf, msgs[1].offset + 28), msgs[1].xid);
+
+  EXPECT_EQ(read_u32(buf, msgs[2].offset + 16), bundle_id);
+  EXPECT_EQ(read_u16(buf, msgs[2].offset + 20),
+            FlowModBatch::BUNDLE_COMMIT_REQUEST);
+
+  // Each bundle gets a new id
+  batch.open_bundle();
+  buf = batch.take();
+  EXPECT_NE(read_u32(buf, 16), bundle_id);
+}
+
+TEST(FlowModBatchTest, TestBarriers) {
+  FlowModBatch batch;
+  auto fm = make_msg(OFPT_FLOW_MOD, 56);
+  std::vector<int> results;
+  batch.add_message(fm.data(), fm.size());
+  batch.add_barrier([&results](bool success) { results.push_back(success); });
+  batch.add_message(fm.data(), fm.size());
+  batch.add_message(fm.data(), fm.size());
+  batch.add_barrier([&results](bool success) { results.push_back(success); });
+  EXPECT_EQ(batch.pending_barriers(), 2);
+
+  auto msgs = split(batch.take());
+  ASSERT_EQ(msgs.size(), 5);
+  EXPECT_EQ(msgs[1].type, FlowModBatch::OFPT_BARRIER_REQUEST);
+  EXPECT_EQ(msgs[1].len, 8);
+
+  // The error of the third message only fails the second barrier, and
+  // errors of messages the batch did not send are ignored
+  batch.handle_error(msgs[3].xid);
+  batch.handle_error(1);
+  EXPECT_FALSE(batch.handle_barrier_reply(1));
+  batch.handle_barrier_reply(msgs[1].xid)();
+  batch.handle_barrier_reply(msgs[4].xid)();
+  EXPECT_EQ(results, std::vector<int>({true, false}));
+  EXPECT_EQ(batch.pending_barriers(), 0);
+}
+
+TEST(FlowModBatchTest, TestFailAll) {
+  FlowModBatch batch;
+  auto fm = make_msg(OFPT_FLOW_MOD, 56);
+  std::vector<int> results;
+  batch.open_bundle();
+  batch.add_message(fm.data(), fm.size());
+  batch.commit_bundle();
+  batch.add_barrier([&results](bool success) { results.push_back(success); });
+
+  auto completions = batch.fail_all();
+  EXPECT_TRUE(results.empty());
+  for (auto& completion : completions) {
+    completion();
+  }
+  EXPECT_EQ(results, std::vector<int>({false}));
+  EXPECT_TRUE(batch.empty());
+  EXPECT_EQ(batch.pending_barriers(), 0);
+}
+
+}  // namespace
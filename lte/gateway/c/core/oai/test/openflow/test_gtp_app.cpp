@@ -26,6 +26,7 @@
 #include <fluid/util/ethaddr.hh>     // for fluid_msg
 #include <fluid/util/ipaddr.hh>      // for IPAddress
 #include <memory>                    // for shared_ptr, __shared_ptr
+#include <vector>                    // for vector
 #include "lte/gateway/c/core/oai/lib/openflow/controller/ControllerEvents.hpp"  // for AddGTPTunnelEvent, Delet...
 #include "lte/gateway/c/core/oai/lib/openflow/controller/GTPApplication.hpp"  // for GTPApplication
 #include "lte/gateway/c/core/oai/lib/openflow/controller/OpenflowController.hpp"  // for OpenflowController
@@ -69,6 +70,7 @@ class GTPApplicationTest : public ::testing::Test {
     controller->register_for_event(gtp_app, openflow::EVENT_ADD_GTP_S8_TUNNEL);
     controller->register_for_event(gtp_app,
                                    openflow::EVENT_DELETE_GTP_S8_TUNNEL);
+    controller->register_for_event(gtp_app, openflow::EVENT_SEND_END_MARKER);
   }
 
   virtual void TearDown() {
@@ -132,6 +134,127 @@ MATCHER_P(CheckEthType, eth_type, "") {
   return eth_type_field->value() == eth_type;
 }
 
+MATCHER_P(CheckMsgType, type, "") { return arg.type() == type; }
+
+// Decoding of packet outs, libfluid does not unpack the experimenter fields
+
+const size_t PACKET_OUT_LEN = 24;
+const uint16_t OFPAT_OUTPUT = 0;
+const uint16_t OFPAT_SET_FIELD = 25;
+const uint16_t OXM_CLASS_OPENFLOW_BASIC = 0x8000;
+const uint16_t OXM_CLASS_NXM_1 = 0x0001;
+const uint16_t OXM_CLASS_EXPERIMENTER = 0xffff;
+const uint8_t OXM_FIELD_TUNNEL_ID = 38;
+const uint8_t NXM_FIELD_TUN_IPV4_DST = 31;
+const uint8_t NXOXM_FIELD_GTPU_FLAGS = 15;
+const uint8_t NXOXM_FIELD_GTPU_MSGTYPE = 16;
+const uint32_t NX_VENDOR_ID = 0x00002320;
+
+uint32_t read_be(const uint8_t* buf, size_t len) {
+  uint32_t value = 0;
+  for (size_t i = 0; i < len; i++) {
+    value = (value << 8) | buf[i];
+  }
+  return value;
+}
+
+struct PacketOutAction {
+  uint16_t type;
+  std::vector<uint8_t> body;
+};
+
+/*
+ * Pack the packet out and split its action list
+ */
+std::vector<PacketOutAction> decode_packet_out_actions(OFMsg& msg,
+                                                       uint32_t* in_port) {
+  std::vector<PacketOutAction> actions;
+  uint8_t* buffer = msg.pack();
+  *in_port = read_be(buffer + 12, 4);
+  size_t actions_len = read_be(buffer + 16, 2);
+  const uint8_t* action = buffer + PACKET_OUT_LEN;
+  const uint8_t* end = action + actions_len;
+  while (action + 4 <= end) {
+    uint16_t len = read_be(action + 2, 2);
+    if (len < 4 || action + len > end) {
+      break;
+    }
+    actions.push_back({static_cast<uint16_t>(read_be(action, 2)),
+                       std::vector<uint8_t>(action + 4, action + len)});
+    action += len;
+  }
+  OFMsg::free_buffer(buffer);
+  return actions;
+}
+
+/*
+ * Payload of the set field action of the OXM class and field, empty if the
+ * packet out has none or its OXM length overflows the action
+ */
+std::vector<uint8_t> get_set_field(const std::vector<PacketOutAction>& actions,
+                                   uint16_t oxm_class, uint8_t field) {
+  for (const auto& action : actions) {
+    if (action.type != OFPAT_SET_FIELD || action.body.size() < 4) {
+      continue;
+    }
+    uint32_t header = read_be(action.body.data(), 4);
+    size_t len = header & 0xff;
+    if ((header >> 16) != oxm_class || ((header >> 9) & 0x7f) != field ||
+        len + 4 > action.body.size()) {
+      continue;
+    }
+    return std::vector<uint8_t>(action.body.begin() + 4,
+                                action.body.begin() + 4 + len);
+  }
+  return std::vector<uint8_t>();
+}
+
+MATCHER_P(CheckPacketOutTunnelId, tunnel_id, "") {
+  uint32_t in_port;
+  auto value =
+      get_set_field(decode_packet_out_actions(arg, &in_port),
+                    OXM_CLASS_OPENFLOW_BASIC, OXM_FIELD_TUNNEL_ID);
+  return value.size() == 8 && read_be(value.data(), 4) == 0 &&
+         read_be(value.data() + 4, 4) == tunnel_id;
+}
+
+MATCHER_P(CheckPacketOutTunnelDst, ip, "") {
+  uint32_t in_port;
+  auto value = get_set_field(decode_packet_out_actions(arg, &in_port),
+                             OXM_CLASS_NXM_1, NXM_FIELD_TUN_IPV4_DST);
+  return value.size() == 4 && read_be(value.data(), 4) == ntohl(ip.s_addr);
+}
+
+MATCHER_P2(CheckPacketOutGtpuField, field, field_value, "") {
+  uint32_t in_port;
+  auto value = get_set_field(decode_packet_out_actions(arg, &in_port),
+                             OXM_CLASS_EXPERIMENTER, field);
+  return value.size() == 5 && read_be(value.data(), 4) == NX_VENDOR_ID &&
+         value[4] == field_value;
+}
+
+MATCHER_P(CheckPacketOutOutput, port_num, "") {
+  uint32_t in_port;
+  auto actions = decode_packet_out_actions(arg, &in_port);
+  // The output has to come last, after the tunnel metadata is set
+  return in_port == of13::OFPP_LOCAL && !actions.empty() &&
+         actions.back().type == OFPAT_OUTPUT &&
+         actions.back().body.size() >= 4 &&
+         read_be(actions.back().body.data(), 4) == port_num;
+}
+
+/**
+ * Messenger of a switch without the GTP patch of OVS, that rejects every
+ * message before a barrier
+ */
+class RejectingMessenger : public MockMessenger {
+ public:
+  void send_barrier(fluid_base::OFConnection* ofconn,
+                    FlowModBatch::BarrierCallback cb) const {
+    cb(false);
+  }
+};
+
 MATCHER_P(CheckCommandType, command_type, "") {
   auto msg = static_cast<of13::FlowMod*>(&arg);
   return msg->command() == command_type;
@@ -1001,4 +1124,54 @@ TEST_F(GTPApplicationTest, TestDeleteTunnelS8DlFlowGtpPort) {
 
   controller->dispatch_event(del_tunnel);
 }
+
+/*
+ * Test that end markers are sent to the gtp port as packet outs, with the
+ * tunnel metadata of the end marker set
+ */
+TEST_F(GTPApplicationTest, TestSendEndMarker) {
+  struct in_addr enb_ip;
+  enb_ip.s_addr = inet_addr("0.0.0.2");
+  uint32_t tei = 0x12345678;
+  SendEndMarkerEvent end_marker(enb_ip, tei);
+
+  EXPECT_CALL(*messenger,
+              send_of_msg(AllOf(CheckMsgType(of13::OFPT_PACKET_OUT),
+                                CheckPacketOutTunnelId(tei),
+                                CheckPacketOutTunnelDst(enb_ip),
+                                CheckPacketOutGtpuField(
+                                    NXOXM_FIELD_GTPU_MSGTYPE, 0xfe),
+                                CheckPacketOutGtpuField(
+                                    NXOXM_FIELD_GTPU_FLAGS, 0x30),
+                                CheckPacketOutOutput(TEST_GTP_PORT)),
+                          _))
+      .Times(2);
+
+  controller->dispatch_event(end_marker);
+  controller->dispatch_event(end_marker);
+  EXPECT_TRUE(gtp_app->is_end_marker_supported());
+}
+
+/*
+ * Test that end markers are disabled once the switch rejects one
+ */
+TEST_F(GTPApplicationTest, TestSendEndMarkerUnsupported) {
+  auto rejecting_messenger =
+      std::shared_ptr<RejectingMessenger>(new RejectingMessenger());
+  OpenflowController rejecting_controller("127.0.0.1", 6666, 2, false,
+                                          rejecting_messenger);
+  rejecting_controller.register_for_event(gtp_app,
+                                          openflow::EVENT_SEND_END_MARKER);
+  struct in_addr enb_ip;
+  enb_ip.s_addr = inet_addr("0.0.0.2");
+  SendEndMarkerEvent end_marker(enb_ip, 2);
+
+  EXPECT_CALL(*rejecting_messenger,
+              send_of_msg(CheckMsgType(of13::OFPT_PACKET_OUT), _))
+      .Times(1);
+
+  rejecting_controller.dispatch_event(end_marker);
+  rejecting_controller.dispatch_event(end_marker);
+  EXPECT_FALSE(gtp_app->is_end_marker_supported());
+}
 }  // namespace
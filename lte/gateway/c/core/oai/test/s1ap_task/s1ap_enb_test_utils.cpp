@@ -0,0 +1,352 @@
+/**
+ * Copyright 2022 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "lte/gateway/c/core/oai/test/s1ap_task/s1ap_enb_test_utils.h"
+
+#include <cstdlib>
+
+extern "C" {
+#include "lte/gateway/c/core/oai/common/log.h"
+}
+
+#include "lte/gateway/c/core/oai/common/conversions.h"
+#include "lte/gateway/c/core/oai/tasks/s1ap/s1ap_common.hpp"
+
+namespace magma {
+namespace lte {
+
+namespace {
+
+// Appends a new IE to the protocol IEs of the message
+template <typename IE, typename Message>
+IE* add_ie(Message* message, S1ap_ProtocolIE_ID_t id,
+           S1ap_Criticality_t criticality) {
+  IE* ie = reinterpret_cast<IE*>(calloc(1, sizeof(IE)));
+  ie->id = id;
+  ie->criticality = criticality;
+  ASN_SEQUENCE_ADD(&message->protocolIEs.list, ie);
+  return ie;
+}
+
+void fill_tai(const tai_t& tai, S1ap_TAI_t* out) {
+  PLMN_T_TO_PLMNID(tai.plmn, &out->pLMNidentity);
+  TAC_TO_ASN1(tai.tac, &out->tAC);
+}
+
+void fill_ecgi(const ecgi_t& ecgi, S1ap_EUTRAN_CGI_t* out) {
+  PLMN_T_TO_PLMNID(ecgi.plmn, &out->pLMNidentity);
+  MACRO_ENB_ID_TO_CELL_IDENTITY(ecgi.cell_identity.enb_id,
+                                ecgi.cell_identity.cell_id, &out->cell_ID);
+}
+
+// Encodes and frees the content of the PDU. s1ap_mme_encode_pdu only takes
+// the procedures the MME initiates or answers, so the eNB side calls the
+// codec directly.
+status_code_e encode_pdu(S1ap_S1AP_PDU_t* pdu, bstring* payload) {
+  asn_encode_to_new_buffer_result_t res = asn_encode_to_new_buffer(
+      NULL, ATS_ALIGNED_CANONICAL_PER, &asn_DEF_S1ap_S1AP_PDU, pdu);
+  ASN_STRUCT_FREE_CONTENTS_ONLY(asn_DEF_S1ap_S1AP_PDU, pdu);
+  if (!res.buffer) {
+    return RETURNerror;
+  }
+  *payload = blk2bstr(res.buffer, res.result.encoded);
+  free(res.buffer);
+  return RETURNok;
+}
+
+}  // namespace
+
+status_code_e generate_s1_setup_request(uint32_t enb_id, const tai_t& tai,
+                                        bstring* payload) {
+  S1ap_S1AP_PDU_t pdu = {S1ap_S1AP_PDU_PR_NOTHING, {0}};
+  pdu.present = S1ap_S1AP_PDU_PR_initiatingMessage;
+  pdu.choice.initiatingMessage.procedureCode = S1ap_ProcedureCode_id_S1Setup;
+  pdu.choice.initiatingMessage.criticality = S1ap_Criticality_reject;
+  pdu.choice.initiatingMessage.value.present =
+      S1ap_InitiatingMessage__value_PR_S1SetupRequest;
+  S1ap_S1SetupRequest_t* out =
+      &pdu.choice.initiatingMessage.value.choice.S1SetupRequest;
+
+  auto ie = add_ie<S1ap_S1SetupRequestIEs_t>(
+      out, S1ap_ProtocolIE_ID_id_Global_ENB_ID, S1ap_Criticality_reject);
+  ie->value.present = S1ap_S1SetupRequestIEs__value_PR_Global_ENB_ID;
+  PLMN_T_TO_PLMNID(tai.plmn, &ie->value.choice.Global_ENB_ID.pLMNidentity);
+  ie->value.choice.Global_ENB_ID.eNB_ID.present = S1ap_ENB_ID_PR_macroENB_ID;
+  MACRO_ENB_ID_TO_BIT_STRING(
+      enb_id, &ie->value.choice.Global_ENB_ID.eNB_ID.choice.macroENB_ID);
+
+  ie = add_ie<S1ap_S1SetupRequestIEs_t>(out, S1ap_ProtocolIE_ID_id_SupportedTAs,
+                                        S1ap_Criticality_reject);
+  ie->value.present = S1ap_S1SetupRequestIEs__value_PR_SupportedTAs;
+  S1ap_SupportedTAs_Item_t* ta = reinterpret_cast<S1ap_SupportedTAs_Item_t*>(
+      calloc(1, sizeof(S1ap_SupportedTAs_Item_t)));
+  TAC_TO_ASN1(tai.tac, &ta->tAC);
+  S1ap_PLMNidentity_t* plmn = reinterpret_cast<S1ap_PLMNidentity_t*>(
+      calloc(1, sizeof(S1ap_PLMNidentity_t)));
+  PLMN_T_TO_PLMNID(tai.plmn, plmn);
+  ASN_SEQUENCE_ADD(&ta->broadcastPLMNs.list, plmn);
+  ASN_SEQUENCE_ADD(&ie->value.choice.SupportedTAs.list, ta);
+
+  ie = add_ie<S1ap_S1SetupRequestIEs_t>(
+      out, S1ap_ProtocolIE_ID_id_DefaultPagingDRX, S1ap_Criticality_ignore);
+  ie->value.present = S1ap_S1SetupRequestIEs__value_PR_PagingDRX;
+  ie->value.choice.PagingDRX = S1ap_PagingDRX_v128;
+
+  return encode_pdu(&pdu, payload);
+}
+
+status_code_e generate_initial_ue_message(enb_ue_s1ap_id_t enb_ue_id,
+                                          const uint8_t* nas,
+                                          size_t nas_length, const tai_t& tai,
+                                          const ecgi_t& ecgi, long rrc_cause,
+                                          const s_tmsi_t* s_tmsi,
+                                          bstring* payload) {
+  S1ap_S1AP_PDU_t pdu = {S1ap_S1AP_PDU_PR_NOTHING, {0}};
+  pdu.present = S1ap_S1AP_PDU_PR_initiatingMessage;
+  pdu.choice.initiatingMessage.procedureCode =
+      S1ap_ProcedureCode_id_initialUEMessage;
+  pdu.choice.initiatingMessage.criticality = S1ap_Criticality_ignore;
+  pdu.choice.initiatingMessage.value.present =
+      S1ap_InitiatingMessage__value_PR_InitialUEMessage;
+  S1ap_InitialUEMessage_t* out =
+      &pdu.choice.initiatingMessage.value.choice.InitialUEMessage;
+
+  auto ie = add_ie<S1ap_InitialUEMessage_IEs_t>(
+      out, S1ap_ProtocolIE_ID_id_eNB_UE_S1AP_ID, S1ap_Criticality_reject);
+  ie->value.present = S1ap_InitialUEMessage_IEs__value_PR_ENB_UE_S1AP_ID;
+  ie->value.choice.ENB_UE_S1AP_ID = enb_ue_id;
+
+  ie = add_ie<S1ap_InitialUEMessage_IEs_t>(out, S1ap_ProtocolIE_ID_id_NAS_PDU,
+                                           S1ap_Criticality_reject);
+  ie->value.present = S1ap_InitialUEMessage_IEs__value_PR_NAS_PDU;
+  OCTET_STRING_fromBuf(&ie->value.choice.NAS_PDU, (const char*)nas,
+                       nas_length);
+
+  ie = add_ie<S1ap_InitialUEMessage_IEs_t>(out, S1ap_ProtocolIE_ID_id_TAI,
+                                           S1ap_Criticality_reject);
+  ie->value.present = S1ap_InitialUEMessage_IEs__value_PR_TAI;
+  fill_tai(tai, &ie->value.choice.TAI);
+
+  ie = add_ie<S1ap_InitialUEMessage_IEs_t>(
+      out, S1ap_ProtocolIE_ID_id_EUTRAN_CGI, S1ap_Criticality_ignore);
+  ie->value.present = S1ap_InitialUEMessage_IEs__value_PR_EUTRAN_CGI;
+  fill_ecgi(ecgi, &ie->value.choice.EUTRAN_CGI);
+
+  ie = add_ie<S1ap_InitialUEMessage_IEs_t>(
+      out, S1ap_ProtocolIE_ID_id_RRC_Establishment_Cause,
+      S1ap_Criticality_ignore);
+  ie->value.present =
+      S1ap_InitialUEMessage_IEs__value_PR_RRC_Establishment_Cause;
+  ie->value.choice.RRC_Establishment_Cause = rrc_cause;
+
+  if (s_tmsi) {
+    ie = add_ie<S1ap_InitialUEMessage_IEs_t>(out, S1ap_ProtocolIE_ID_id_S_TMSI,
+                                             S1ap_Criticality_reject);
+    ie->value.present = S1ap_InitialUEMessage_IEs__value_PR_S_TMSI;
+    MME_CODE_TO_OCTET_STRING(s_tmsi->mme_code, &ie->value.choice.S_TMSI.mMEC);
+    M_TMSI_TO_OCTET_STRING(s_tmsi->m_tmsi, &ie->value.choice.S_TMSI.m_TMSI);
+  }
+
+  return encode_pdu(&pdu, payload);
+}
+
+status_code_e generate_uplink_nas_transport(mme_ue_s1ap_id_t mme_ue_id,
+                                            enb_ue_s1ap_id_t enb_ue_id,
+                                            const uint8_t* nas,
+                                            size_t nas_length,
+                                            const tai_t& tai,
+                                            const ecgi_t& ecgi,
+                                            bstring* payload) {
+  S1ap_S1AP_PDU_t pdu = {S1ap_S1AP_PDU_PR_NOTHING, {0}};
+  pdu.present = S1ap_S1AP_PDU_PR_initiatingMessage;
+  pdu.choice.initiatingMessage.procedureCode =
+      S1ap_ProcedureCode_id_uplinkNASTransport;
+  pdu.choice.initiatingMessage.criticality = S1ap_Criticality_ignore;
+  pdu.choice.initiatingMessage.value.present =
+      S1ap_InitiatingMessage__value_PR_UplinkNASTransport;
+  S1ap_UplinkNASTransport_t* out =
+      &pdu.choice.initiatingMessage.value.choice.UplinkNASTransport;
+
+  auto ie = add_ie<S1ap_UplinkNASTransport_IEs_t>(
+      out, S1ap_ProtocolIE_ID_id_MME_UE_S1AP_ID, S1ap_Criticality_reject);
+  ie->value.present = S1ap_UplinkNASTransport_IEs__value_PR_MME_UE_S1AP_ID;
+  ie->value.choice.MME_UE_S1AP_ID = mme_ue_id;
+
+  ie = add_ie<S1ap_UplinkNASTransport_IEs_t>(
+      out, S1ap_ProtocolIE_ID_id_eNB_UE_S1AP_ID, S1ap_Criticality_reject);
+  ie->value.present = S1ap_UplinkNASTransport_IEs__value_PR_ENB_UE_S1AP_ID;
+  ie->value.choice.ENB_UE_S1AP_ID = enb_ue_id;
+
+  ie = add_ie<S1ap_UplinkNASTransport_IEs_t>(
+      out, S1ap_ProtocolIE_ID_id_NAS_PDU, S1ap_Criticality_reject);
+  ie->value.present = S1ap_UplinkNASTransport_IEs__value_PR_NAS_PDU;
+  OCTET_STRING_fromBuf(&ie->value.choice.NAS_PDU, (const char*)nas,
+                       nas_length);
+
+  ie = add_ie<S1ap_UplinkNASTransport_IEs_t>(
+      out, S1ap_ProtocolIE_ID_id_EUTRAN_CGI, S1ap_Criticality_ignore);
+  ie->value.present = S1ap_UplinkNASTransport_IEs__value_PR_EUTRAN_CGI;
+  fill_ecgi(ecgi, &ie->value.choice.EUTRAN_CGI);
+
+  ie = add_ie<S1ap_UplinkNASTransport_IEs_t>(out, S1ap_ProtocolIE_ID_id_TAI,
+                                             S1ap_Criticality_ignore);
+  ie->value.present = S1ap_UplinkNASTransport_IEs__value_PR_TAI;
+  fill_tai(tai, &ie->value.choice.TAI);
+
+  return encode_pdu(&pdu, payload);
+}
+
+status_code_e generate_initial_context_setup_response(
+    mme_ue_s1ap_id_t mme_ue_id, enb_ue_s1ap_id_t enb_ue_id, e_rab_id_t e_rab_id,
+    teid_t gtp_teid, uint32_t enb_ipv4, bstring* payload) {
+  S1ap_S1AP_PDU_t pdu = {S1ap_S1AP_PDU_PR_NOTHING, {0}};
+  pdu.present = S1ap_S1AP_PDU_PR_successfulOutcome;
+  pdu.choice.successfulOutcome.procedureCode =
+      S1ap_ProcedureCode_id_InitialContextSetup;
+  pdu.choice.successfulOutcome.criticality = S1ap_Criticality_reject;
+  pdu.choice.successfulOutcome.value.present =
+      S1ap_SuccessfulOutcome__value_PR_InitialContextSetupResponse;
+  S1ap_InitialContextSetupResponse_t* out =
+      &pdu.choice.successfulOutcome.value.choice.InitialContextSetupResponse;
+
+  auto ie = add_ie<S1ap_InitialContextSetupResponseIEs_t>(
+      out, S1ap_ProtocolIE_ID_id_MME_UE_S1AP_ID, S1ap_Criticality_ignore);
+  ie->value.present =
+      S1ap_InitialContextSetupResponseIEs__value_PR_MME_UE_S1AP_ID;
+  ie->value.choice.MME_UE_S1AP_ID = mme_ue_id;
+
+  ie = add_ie<S1ap_InitialContextSetupResponseIEs_t>(
+      out, S1ap_ProtocolIE_ID_id_eNB_UE_S1AP_ID, S1ap_Criticality_ignore);
+  ie->value.present =
+      S1ap_InitialContextSetupResponseIEs__value_PR_ENB_UE_S1AP_ID;
+  ie->value.choice.ENB_UE_S1AP_ID = enb_ue_id;
+
+  ie = add_ie<S1ap_InitialContextSetupResponseIEs_t>(
+      out, S1ap_ProtocolIE_ID_id_E_RABSetupListCtxtSURes,
+      S1ap_Criticality_ignore);
+  ie->value.present =
+      S1ap_InitialContextSetupResponseIEs__value_PR_E_RABSetupListCtxtSURes;
+  S1ap_E_RABSetupItemCtxtSUResIEs_t* item =
+      reinterpret_cast<S1ap_E_RABSetupItemCtxtSUResIEs_t*>(
+          calloc(1, sizeof(S1ap_E_RABSetupItemCtxtSUResIEs_t)));
+  item->id = S1ap_ProtocolIE_ID_id_E_RABSetupItemCtxtSURes;
+  item->criticality = S1ap_Criticality_ignore;
+  item->value.present =
+      S1ap_E_RABSetupItemCtxtSUResIEs__value_PR_E_RABSetupItemCtxtSURes;
+  S1ap_E_RABSetupItemCtxtSURes_t* e_rab =
+      &item->value.choice.E_RABSetupItemCtxtSURes;
+  e_rab->e_RAB_ID = e_rab_id;
+  INT32_TO_BIT_STRING(enb_ipv4, &e_rab->transportLayerAddress);
+  GTP_TEID_TO_ASN1(gtp_teid, &e_rab->gTP_TEID);
+  ASN_SEQUENCE_ADD(&ie->value.choice.E_RABSetupListCtxtSURes.list, item);
+
+  return encode_pdu(&pdu, payload);
+}
+
+status_code_e generate_ue_capability_info_indication(
+    mme_ue_s1ap_id_t mme_ue_id, enb_ue_s1ap_id_t enb_ue_id,
+    const uint8_t* capability, size_t capability_length, bstring* payload) {
+  S1ap_S1AP_PDU_t pdu = {S1ap_S1AP_PDU_PR_NOTHING, {0}};
+  pdu.present = S1ap_S1AP_PDU_PR_initiatingMessage;
+  pdu.choice.initiatingMessage.procedureCode =
+      S1ap_ProcedureCode_id_UECapabilityInfoIndication;
+  pdu.choice.initiatingMessage.criticality = S1ap_Criticality_ignore;
+  pdu.choice.initiatingMessage.value.present =
+      S1ap_InitiatingMessage__value_PR_UECapabilityInfoIndication;
+  S1ap_UECapabilityInfoIndication_t* out =
+      &pdu.choice.initiatingMessage.value.choice.UECapabilityInfoIndication;
+
+  auto ie = add_ie<S1ap_UECapabilityInfoIndicationIEs_t>(
+      out, S1ap_ProtocolIE_ID_id_MME_UE_S1AP_ID, S1ap_Criticality_reject);
+  ie->value.present =
+      S1ap_UECapabilityInfoIndicationIEs__value_PR_MME_UE_S1AP_ID;
+  ie->value.choice.MME_UE_S1AP_ID = mme_ue_id;
+
+  ie = add_ie<S1ap_UECapabilityInfoIndicationIEs_t>(
+      out, S1ap_ProtocolIE_ID_id_eNB_UE_S1AP_ID, S1ap_Criticality_reject);
+  ie->value.present =
+      S1ap_UECapabilityInfoIndicationIEs__value_PR_ENB_UE_S1AP_ID;
+  ie->value.choice.ENB_UE_S1AP_ID = enb_ue_id;
+
+  ie = add_ie<S1ap_UECapabilityInfoIndicationIEs_t>(
+      out, S1ap_ProtocolIE_ID_id_UERadioCapability, S1ap_Criticality_ignore);
+  ie->value.present =
+      S1ap_UECapabilityInfoIndicationIEs__value_PR_UERadioCapability;
+  OCTET_STRING_fromBuf(&ie->value.choice.UERadioCapability,
+                       (const char*)capability, capability_length);
+
+  return encode_pdu(&pdu, payload);
+}
+
+status_code_e generate_ue_context_release_request(mme_ue_s1ap_id_t mme_ue_id,
+                                                  enb_ue_s1ap_id_t enb_ue_id,
+                                                  long radio_cause,
+                                                  bstring* payload) {
+  S1ap_S1AP_PDU_t pdu = {S1ap_S1AP_PDU_PR_NOTHING, {0}};
+  pdu.present = S1ap_S1AP_PDU_PR_initiatingMessage;
+  pdu.choice.initiatingMessage.procedureCode =
+      S1ap_ProcedureCode_id_UEContextReleaseRequest;
+  pdu.choice.initiatingMessage.criticality = S1ap_Criticality_ignore;
+  pdu.choice.initiatingMessage.value.present =
+      S1ap_InitiatingMessage__value_PR_UEContextReleaseRequest;
+  S1ap_UEContextReleaseRequest_t* out =
+      &pdu.choice.initiatingMessage.value.choice.UEContextReleaseRequest;
+
+  auto ie = add_ie<S1ap_UEContextReleaseRequest_IEs_t>(
+      out, S1ap_ProtocolIE_ID_id_MME_UE_S1AP_ID, S1ap_Criticality_reject);
+  ie->value.present = S1ap_UEContextReleaseRequest_IEs__value_PR_MME_UE_S1AP_ID;
+  ie->value.choice.MME_UE_S1AP_ID = mme_ue_id;
+
+  ie = add_ie<S1ap_UEContextReleaseRequest_IEs_t>(
+      out, S1ap_ProtocolIE_ID_id_eNB_UE_S1AP_ID, S1ap_Criticality_reject);
+  ie->value.present = S1ap_UEContextReleaseRequest_IEs__value_PR_ENB_UE_S1AP_ID;
+  ie->value.choice.ENB_UE_S1AP_ID = enb_ue_id;
+
+  ie = add_ie<S1ap_UEContextReleaseRequest_IEs_t>(
+      out, S1ap_ProtocolIE_ID_id_Cause, S1ap_Criticality_ignore);
+  ie->value.present = S1ap_UEContextReleaseRequest_IEs__value_PR_Cause;
+  ie->value.choice.Cause.present = S1ap_Cause_PR_radioNetwork;
+  ie->value.choice.Cause.choice.radioNetwork = radio_cause;
+
+  return encode_pdu(&pdu, payload);
+}
+
+status_code_e generate_ue_context_release_complete(mme_ue_s1ap_id_t mme_ue_id,
+                                                   enb_ue_s1ap_id_t enb_ue_id,
+                                                   bstring* payload) {
+  S1ap_S1AP_PDU_t pdu = {S1ap_S1AP_PDU_PR_NOTHING, {0}};
+  pdu.present = S1ap_S1AP_PDU_PR_successfulOutcome;
+  pdu.choice.successfulOutcome.procedureCode =
+      S1ap_ProcedureCode_id_UEContextRelease;
+  pdu.choice.successfulOutcome.criticality = S1ap_Criticality_reject;
+  pdu.choice.successfulOutcome.value.present =
+      S1ap_SuccessfulOutcome__value_PR_UEContextReleaseComplete;
+  S1ap_UEContextReleaseComplete_t* out =
+      &pdu.choice.successfulOutcome.value.choice.UEContextReleaseComplete;
+
+  auto ie = add_ie<S1ap_UEContextReleaseComplete_IEs_t>(
+      out, S1ap_ProtocolIE_ID_id_MME_UE_S1AP_ID, S1ap_Criticality_ignore);
+  ie->value.present =
+      S1ap_UEContextReleaseComplete_IEs__value_PR_MME_UE_S1AP_ID;
+  ie->value.choice.MME_UE_S1AP_ID = mme_ue_id;
+
+  ie = add_ie<S1ap_UEContextReleaseComplete_IEs_t>(
+      out, S1ap_ProtocolIE_ID_id_eNB_UE_S1AP_ID, S1ap_Criticality_ignore);
+  ie->value.present =
+      S1ap_UEContextReleaseComplete_IEs__value_PR_ENB_UE_S1AP_ID;
+  ie->value.choice.ENB_UE_S1AP_ID = enb_ue_id;
+
+  return encode_pdu(&pdu, payload);
+}
+
+}  // namespace lte
+}  // namespace magma
@@ -0,0 +1,71 @@
+/**
+ * Copyright 2022 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "lte/gateway/c/core/oai/common/common_types.h"
+extern "C" {
+#include "lte/gateway/c/core/oai/include/TrackingAreaIdentity.h"
+#include "lte/gateway/c/core/oai/lib/3gpp/3gpp_23.003.h"
+#include "lte/gateway/c/core/oai/lib/3gpp/3gpp_36.401.h"
+#include "lte/gateway/c/core/oai/lib/3gpp/3gpp_36.413.h"
+#include "lte/gateway/c/core/oai/lib/bstr/bstrlib.h"
+}
+
+namespace magma {
+namespace lte {
+
+// The PDUs an eNB sends to the MME, APER encoded into a new *payload as
+// sctpd hands them to S1AP in SCTP_DATA_IND. The caller owns *payload.
+
+status_code_e generate_s1_setup_request(uint32_t enb_id, const tai_t& tai,
+                                        bstring* payload);
+
+// s_tmsi is NULL when the UE identifies itself in the NAS message only
+status_code_e generate_initial_ue_message(enb_ue_s1ap_id_t enb_ue_id,
+                                          const uint8_t* nas,
+                                          size_t nas_length, const tai_t& tai,
+                                          const ecgi_t& ecgi, long rrc_cause,
+                                          const s_tmsi_t* s_tmsi,
+                                          bstring* payload);
+
+status_code_e generate_uplink_nas_transport(mme_ue_s1ap_id_t mme_ue_id,
+                                            enb_ue_s1ap_id_t enb_ue_id,
+                                            const uint8_t* nas,
+                                            size_t nas_length,
+                                            const tai_t& tai,
+                                            const ecgi_t& ecgi,
+                                            bstring* payload);
+
+// enb_ipv4 is the S1-U address of the eNB in host byte order
+status_code_e generate_initial_context_setup_response(
+    mme_ue_s1ap_id_t mme_ue_id, enb_ue_s1ap_id_t enb_ue_id, e_rab_id_t e_rab_id,
+    teid_t gtp_teid, uint32_t enb_ipv4, bstring* payload);
+
+status_code_e generate_ue_capability_info_indication(
+    mme_ue_s1ap_id_t mme_ue_id, enb_ue_s1ap_id_t enb_ue_id,
+    const uint8_t* capability, size_t capability_length, bstring* payload);
+
+status_code_e generate_ue_context_release_request(mme_ue_s1ap_id_t mme_ue_id,
+                                                  enb_ue_s1ap_id_t enb_ue_id,
+                                                  long radio_cause,
+                                                  bstring* payload);
+
+status_code_e generate_ue_context_release_complete(mme_ue_s1ap_id_t mme_ue_id,
+                                                   enb_ue_s1ap_id_t enb_ue_id,
+                                                   bstring* payload);
+
+}  // namespace lte
+}  // namespace magma
@@ -26,9 +26,12 @@ extern "C" {
 #include "lte/gateway/c/core/oai/tasks/s1ap/s1ap_mme_decoder.hpp"
 #include "lte/gateway/c/core/oai/tasks/s1ap/s1ap_mme_nas_procedures.hpp"
 #include "lte/gateway/c/core/oai/tasks/s1ap/s1ap_mme_handlers.hpp"
+#include "lte/gateway/c/core/oai/test/s1ap_task/s1ap_enb_test_utils.h"
 #include "lte/gateway/c/core/oai/test/s1ap_task/s1ap_mme_test_utils.h"
 #include "lte/gateway/c/core/oai/tasks/s1ap/s1ap_state_manager.hpp"
 
+using ::testing::_;
+
 extern bool hss_associated;
 extern task_zmq_ctx_t task_zmq_ctx_mme;
 
@@ -109,7 +112,7 @@ class S1apMmeHandlersTest : public ::testing::Test {
 };
 
 TEST_F(S1apMmeHandlersTest, HandleS1SetupRequestFailureHss) {
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(1);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(1);
 
   hss_associated = false;
 
@@ -131,7 +134,7 @@ TEST_F(S1apMmeHandlersTest, HandleS1SetupRequestFailureHss) {
 }
 
 TEST_F(S1apMmeHandlersTest, HandleS1SetupRequestFailureReseting) {
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(1);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(1);
 
   enb_description_t* enb_associated = NULL;
   hashtable_ts_get(&state->enbs, (const hash_key_t)assoc_id,
@@ -158,7 +161,7 @@ TEST_F(S1apMmeHandlersTest, HandleS1SetupRequestFailureReseting) {
 TEST_F(S1apMmeHandlersTest, HandleCloseSctpAssociation) {
   ASSERT_EQ(task_zmq_ctx_main_s1ap.ready, true);
 
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(1);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_s1ap_ue_context_release_req())
       .Times(0);
@@ -200,7 +203,7 @@ TEST_F(S1apMmeHandlersTest, HandleICSResponseICSRelease) {
 
   bool is_state_same = false;
 
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(2);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(2);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_s1ap_ue_context_release_req())
       .Times(1);
@@ -290,7 +293,7 @@ TEST_F(S1apMmeHandlersTest, HandleICSFailure) {
 
   bool is_state_same = false;
 
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(2);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(2);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_s1ap_ue_context_release_req())
       .Times(0);
@@ -360,7 +363,7 @@ TEST_F(S1apMmeHandlersTest, HandleICSFailure) {
 TEST_F(S1apMmeHandlersTest, HandleUECapIndication) {
   ASSERT_EQ(task_zmq_ctx_main_s1ap.ready, true);
 
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(1);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
 
   ASSERT_TRUE(is_enb_state_valid(state, assoc_id, S1AP_INIT, 0));
@@ -428,7 +431,7 @@ TEST_F(S1apMmeHandlersTest, GenerateUEContextReleaseCommand) {
 
   ue_ref_p.s1ap_ue_context_rel_timer.id = -1;
   ue_ref_p.s1ap_ue_context_rel_timer.msec = 1000;
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(2);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(2);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
 
   ASSERT_TRUE(is_enb_state_valid(state, assoc_id, S1AP_INIT, 0));
@@ -474,7 +477,7 @@ TEST_F(S1apMmeHandlersTest, GenerateUEContextReleaseCommand) {
 TEST_F(S1apMmeHandlersTest, HandleUEContextRelease) {
   ASSERT_EQ(task_zmq_ctx_main_s1ap.ready, true);
 
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(1);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
 
   ASSERT_TRUE(is_enb_state_valid(state, assoc_id, S1AP_INIT, 0));
@@ -547,7 +550,7 @@ TEST_F(S1apMmeHandlersTest, HandleConnectionEstCnf) {
   ASSERT_EQ(task_zmq_ctx_main_s1ap.ready, true);
   itti_mme_app_connection_establishment_cnf_t* establishment_cnf_p = NULL;
 
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(2);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(2);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_s1ap_ue_context_release_req())
       .Times(0);
@@ -591,7 +594,7 @@ TEST_F(S1apMmeHandlersTest, HandleConnectionEstCnf) {
 TEST_F(S1apMmeHandlersTest, HandleConnectionEstCnfExtUEAMBR) {
   ASSERT_EQ(task_zmq_ctx_main_s1ap.ready, true);
 
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(2);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(2);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_s1ap_ue_context_release_req())
       .Times(0);
@@ -634,7 +637,7 @@ TEST_F(S1apMmeHandlersTest, HandleConnectionEstCnfExtUEAMBR) {
 TEST_F(S1apMmeHandlersTest, HandleS1apErabRelCmd) {
   ASSERT_EQ(task_zmq_ctx_main_s1ap.ready, true);
 
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(2);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(2);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_s1ap_ue_context_release_req())
       .Times(0);
@@ -677,7 +680,7 @@ TEST_F(S1apMmeHandlersTest, HandleS1apErabRelCmd) {
 TEST_F(S1apMmeHandlersTest, HandleS1apErabSetupReq) {
   ASSERT_EQ(task_zmq_ctx_main_s1ap.ready, true);
 
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(2);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(2);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
 
   ASSERT_TRUE(is_enb_state_valid(state, assoc_id, S1AP_INIT, 0));
@@ -717,7 +720,7 @@ TEST_F(S1apMmeHandlersTest, HandleS1apErabSetupReq) {
 TEST_F(S1apMmeHandlersTest, HandleS1apErabReleaseComplete) {
   ASSERT_EQ(task_zmq_ctx_main_s1ap.ready, true);
 
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(3);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(3);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_e_rab_setup_rsp()).Times(1);
 
@@ -784,7 +787,7 @@ TEST_F(S1apMmeHandlersTest, HandleS1apErabReleaseComplete) {
 TEST_F(S1apMmeHandlersTest, HandleS1apErabResetReq) {
   ASSERT_EQ(task_zmq_ctx_main_s1ap.ready, true);
 
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(2);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(2);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_s1ap_ue_context_release_req())
       .Times(0);
@@ -827,7 +830,7 @@ TEST_F(S1apMmeHandlersTest, HandleS1apErabResetReq) {
 TEST_F(S1apMmeHandlersTest, HandleS1apUeCtxtModification) {
   ASSERT_EQ(task_zmq_ctx_main_s1ap.ready, true);
 
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(2);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(2);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_s1ap_ue_context_release_req())
       .Times(0);
@@ -873,7 +876,7 @@ TEST_F(S1apMmeHandlersTest, HandleS1apUeCtxtModification) {
 TEST_F(S1apMmeHandlersTest, HandleS1apPathSwitchRequest) {
   ASSERT_EQ(task_zmq_ctx_main_s1ap.ready, true);
 
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(2);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(2);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_s1ap_ue_context_release_req())
       .Times(0);
@@ -919,7 +922,7 @@ TEST_F(S1apMmeHandlersTest, HandleS1apPathSwitchRequest) {
 TEST_F(S1apMmeHandlersTest, HandleS1apPathSwitchFailure) {
   ASSERT_EQ(task_zmq_ctx_main_s1ap.ready, true);
 
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(2);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(2);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_s1ap_ue_context_release_req())
       .Times(0);
@@ -960,7 +963,7 @@ TEST_F(S1apMmeHandlersTest, HandleS1apPathSwitchFailure) {
 TEST_F(S1apMmeHandlersTest, HandleMmeHandoverRequest) {
   ASSERT_EQ(task_zmq_ctx_main_s1ap.ready, true);
 
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(2);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(2);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_s1ap_ue_context_release_req())
       .Times(0);
@@ -1007,7 +1010,7 @@ TEST_F(S1apMmeHandlersTest, HandleS1apHandoverCommand) {
 
   ASSERT_TRUE(is_enb_state_valid(state, assoc_id, S1AP_INIT, 0));
 
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(2);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(2);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_s1ap_ue_context_release_req())
       .Times(0);
@@ -1061,7 +1064,7 @@ TEST_F(S1apMmeHandlersTest, HandleMmeHandover) {
   sctp_assoc_id_t target_assoc_id = 2;
   setup_new_association(state, target_assoc_id);
 
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(6);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(6);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_s1ap_ue_context_release_req())
       .Times(0);
@@ -1250,7 +1253,7 @@ TEST_F(S1apMmeHandlersTest, HandleMmeHandoverFailure) {
   sctp_assoc_id_t target_assoc_id = 2;
   setup_new_association(state, target_assoc_id);
 
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(4);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(4);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_s1ap_ue_context_release_req())
       .Times(0);
@@ -1395,7 +1398,7 @@ TEST_F(S1apMmeHandlersTest, HandleMmeHandoverCancel) {
   sctp_assoc_id_t target_assoc_id = 2;
   setup_new_association(state, target_assoc_id);
 
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(5);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(5);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_s1ap_ue_context_release_req())
       .Times(0);
@@ -1557,7 +1560,7 @@ TEST_F(S1apMmeHandlersTest, HandleErabSetupResponse) {
 
   bool is_state_same = true;
 
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(2);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(2);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_e_rab_setup_rsp()).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_s1ap_ue_context_release_req())
@@ -1684,7 +1687,7 @@ TEST_F(S1apMmeHandlersTest, HandleErrorIndicationMessage) {
 
   bool is_state_same = true;
 
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(2);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(2);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_s1ap_ue_context_release_req())
       .Times(1);
@@ -1808,7 +1811,7 @@ TEST_F(S1apMmeHandlersTest, HandleEnbResetPartial) {
 
   bool is_state_same = true;
 
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(2);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(2);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_s1ap_ue_context_release_req())
       .Times(0);
@@ -1919,7 +1922,7 @@ TEST_F(S1apMmeHandlersTest, HandleS1apPagingRequest) {
 
   ASSERT_TRUE(is_enb_state_valid(state, assoc_id, S1AP_INIT, 0));
 
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(1);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_s1ap_ue_context_release_req())
       .Times(0);
@@ -1972,7 +1975,7 @@ TEST_F(S1apMmeHandlersTest, HandleS1apErabModificationCnf) {
 
   ASSERT_TRUE(is_enb_state_valid(state, assoc_id, S1AP_INIT, 0));
 
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(2);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(2);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_s1ap_ue_context_release_req())
       .Times(0);
@@ -2020,7 +2023,7 @@ TEST_F(S1apMmeHandlersTest, HandlePathSwitchRequestSuccess) {
 
   ASSERT_TRUE(is_enb_state_valid(state, assoc_id, S1AP_INIT, 0));
 
-  EXPECT_CALL(*sctp_handler, sctpd_send_dl()).Times(5);
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(5);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
   EXPECT_CALL(*mme_app_handler, mme_app_handle_path_switch_request()).Times(1);
 
@@ -2272,5 +2275,124 @@ TEST_F(S1apMmeHandlersTest, HandleS1apNasNonDelivery) {
   ASN_STRUCT_FREE_CONTENTS_ONLY(asn_DEF_S1ap_S1AP_PDU, &pdu_s1);
 }
 
+TEST_F(S1apMmeHandlersTest, HandleGeneratedEnbPdus) {
+  ASSERT_EQ(task_zmq_ctx_main_s1ap.ready, true);
+
+  bool is_state_same = false;
+
+  EXPECT_CALL(*sctp_handler, sctpd_send_dl(_)).Times(3);
+  EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_ue_message()).Times(1);
+  EXPECT_CALL(*mme_app_handler, mme_app_handle_s1ap_ue_context_release_req())
+      .Times(1);
+  EXPECT_CALL(*mme_app_handler, mme_app_handle_initial_context_setup_failure())
+      .Times(0);
+
+  // Served TAI of the default MME config
+  tai_t tai = {};
+  tai.plmn.mcc_digit3 = 1;
+  tai.plmn.mnc_digit2 = 1;
+  tai.plmn.mnc_digit3 = 0xf;
+  tai.tac = 1;
+  ecgi_t ecgi = {};
+  ecgi.plmn = tai.plmn;
+  ecgi.cell_identity.enb_id = 1;
+
+  bstring payload = NULL;
+  ASSERT_EQ(RETURNok, generate_s1_setup_request(1, tai, &payload));
+  ASSERT_EQ(simulate_pdu_s1_message(payload->data, blength(payload), state,
+                                    assoc_id, stream_id),
+            RETURNok);
+  bdestroy_wrapper(&payload);
+  ASSERT_TRUE(is_enb_state_valid(state, assoc_id, S1AP_READY, 0));
+
+  // Attach request
+  uint8_t attach_bytes[] = {0x07, 0x41, 0x71, 0x08, 0x09, 0x10, 0x10, 0x00,
+                            0x00, 0x00, 0x00, 0x10, 0x02, 0xe0, 0xe0, 0x00,
+                            0x04, 0x02, 0x01, 0xd0, 0x11, 0x40, 0x08, 0x04,
+                            0x02, 0x60, 0x04, 0x00, 0x02, 0x1c, 0x00};
+  ASSERT_EQ(RETURNok,
+            generate_initial_ue_message(
+                1, attach_bytes, sizeof(attach_bytes), tai, ecgi,
+                S1ap_RRC_Establishment_Cause_mo_Signalling, NULL, &payload));
+  ASSERT_EQ(simulate_pdu_s1_message(payload->data, blength(payload), state,
+                                    assoc_id, 1),
+            RETURNok);
+  bdestroy_wrapper(&payload);
+
+  handle_mme_ue_id_notification(state, assoc_id);
+
+  // Generate downlink nas transport with dummy payload
+  bstring p;
+  std::string test_str = "test";
+  STRING_TO_BSTRING(test_str, p);
+  s1ap_generate_downlink_nas_transport(state, 1, 7, &p, 1, &is_state_same);
+  bdestroy_wrapper(&p);
+  ASSERT_TRUE(is_ue_state_valid(assoc_id, 1, S1AP_UE_CONNECTED));
+
+  // Authentication response
+  uint8_t auth_bytes[] = {0x07, 0x53, 0x10, 0x1e, 0x63, 0x7e, 0x5c,
+                          0x58, 0xec, 0x5a, 0xa8, 0x00, 0x00, 0x00,
+                          0x00, 0x00, 0x00, 0x00, 0x00};
+  ASSERT_EQ(RETURNok,
+            generate_uplink_nas_transport(7, 1, auth_bytes, sizeof(auth_bytes),
+                                          tai, ecgi, &payload));
+  ASSERT_EQ(simulate_pdu_s1_message(payload->data, blength(payload), state,
+                                    assoc_id, 1),
+            RETURNok);
+  bdestroy_wrapper(&payload);
+
+  ASSERT_EQ(RETURNok, generate_initial_context_setup_response(
+                          7, 1, 5, 1, 0xc0a83c8d, &payload));
+  ASSERT_EQ(simulate_pdu_s1_message(payload->data, blength(payload), state,
+                                    assoc_id, 1),
+            RETURNok);
+  bdestroy_wrapper(&payload);
+
+  uint8_t capability_bytes[] = {0x01, 0x02, 0x03, 0x04};
+  ASSERT_EQ(RETURNok, generate_ue_capability_info_indication(
+                          7, 1, capability_bytes, sizeof(capability_bytes),
+                          &payload));
+  ASSERT_EQ(simulate_pdu_s1_message(payload->data, blength(payload), state,
+                                    assoc_id, 1),
+            RETURNok);
+  bdestroy_wrapper(&payload);
+
+  ASSERT_EQ(RETURNok,
+            generate_ue_context_release_request(
+                7, 1, S1ap_CauseRadioNetwork_user_inactivity, &payload));
+  ASSERT_EQ(simulate_pdu_s1_message(payload->data, blength(payload), state,
+                                    assoc_id, 1),
+            RETURNok);
+  bdestroy_wrapper(&payload);
+
+  // State validation
+  ASSERT_TRUE(is_enb_state_valid(state, assoc_id, S1AP_READY, 1));
+  ASSERT_TRUE(is_ue_state_valid(assoc_id, 1, S1AP_UE_CONNECTED));
+
+  // Send UE context release command mimicing MME_APP
+  MessageDef* message_p =
+      itti_alloc_new_message(TASK_MME_APP, S1AP_UE_CONTEXT_RELEASE_COMMAND);
+  S1AP_UE_CONTEXT_RELEASE_COMMAND(message_p).mme_ue_s1ap_id = 7;
+  S1AP_UE_CONTEXT_RELEASE_COMMAND(message_p).enb_ue_s1ap_id = 1;
+  S1AP_UE_CONTEXT_RELEASE_COMMAND(message_p).cause =
+      S1AP_RADIO_EUTRAN_GENERATED_REASON;
+  ASSERT_EQ(send_msg_to_task(&task_zmq_ctx_main_s1ap, TASK_S1AP, message_p),
+            RETURNok);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  ASSERT_TRUE(is_ue_state_valid(assoc_id, 1, S1AP_UE_WAITING_CRR));
+
+  ASSERT_EQ(RETURNok, generate_ue_context_release_complete(7, 1, &payload));
+  ASSERT_EQ(simulate_pdu_s1_message(payload->data, blength(payload), state,
+                                    assoc_id, 1),
+            RETURNok);
+  bdestroy_wrapper(&payload);
+
+  // Sleep to ensure that messages are received and contexts are released
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+  ASSERT_EQ(state->mmeid2associd.num_elements, 0);
+}
+
 }  // namespace lte
 }  // namespace magma
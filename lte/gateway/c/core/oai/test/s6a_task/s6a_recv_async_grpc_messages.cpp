@@ -25,7 +25,7 @@ extern "C" {
 using grpc::ServerContext;
 using ::testing::Test;
 task_zmq_ctx_t task_zmq_ctx_main_s6a;
-struct mme_config_s mme_config = {.rw_lock = PTHREAD_RWLOCK_INITIALIZER, 0};
+struct mme_config_s mme_config = {0};
 
 static int handle_message(zloop_t* loop, zsock_t* reader, void* arg);
 
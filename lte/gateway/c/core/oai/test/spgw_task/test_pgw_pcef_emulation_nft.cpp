@@ -0,0 +1,353 @@
+/**
+ * Copyright 2022 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <arpa/inet.h>
+#include <gtest/gtest.h>
+#include <libmnl/libmnl.h>
+#include <linux/netfilter/nf_tables.h>
+#include <linux/netfilter/nfnetlink.h>
+#include <string.h>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "lte/gateway/c/core/oai/test/mock_tasks/mock_tasks.hpp"
+
+extern "C" {
+#include "lte/gateway/c/core/common/common_defs.h"
+#include "lte/gateway/c/core/common/dynamic_memory_check.h"
+#include "lte/gateway/c/core/oai/include/spgw_config.h"
+#include "lte/gateway/c/core/oai/include/spgw_state.hpp"
+#include "lte/gateway/c/core/oai/lib/3gpp/3gpp_24.008.h"
+#include "lte/gateway/c/core/oai/lib/bstr/bstrlib.h"
+#include "lte/gateway/c/core/oai/lib/hashtable/hashtable.h"
+#include "lte/gateway/c/core/oai/tasks/sgw/pgw_pcef_emulation.h"
+#include "lte/gateway/c/core/oai/tasks/sgw/pgw_pcef_emulation_nft.h"
+}
+
+namespace magma {
+namespace lte {
+
+#define TEST_PCC_RULE_HT_SIZE 32
+
+// Expression of a rule, with the value of each of its attributes. Data
+// attributes hold the value nested in them.
+struct NftExpr {
+  std::string name;
+  std::map<uint16_t, std::vector<uint8_t>> attrs;
+};
+
+// nf_tables message of a batch, with the attributes the tests check
+struct NftMsg {
+  uint16_t type;
+  uint16_t flags;
+  std::string chain;
+  std::vector<NftExpr> exprs;
+};
+
+static std::vector<std::vector<NftMsg>> sent_batches;
+static status_code_e send_result = RETURNok;
+
+static std::vector<uint8_t> attr_value(const struct nlattr* attr) {
+  if (attr->nla_type & NLA_F_NESTED) {
+    // NFTA_DATA_VALUE or NFTA_DATA_VERDICT
+    attr = (const struct nlattr*)mnl_attr_get_payload(attr);
+  }
+  const uint8_t* value = (const uint8_t*)mnl_attr_get_payload(attr);
+  return std::vector<uint8_t>(value, value + mnl_attr_get_payload_len(attr));
+}
+
+static int parse_expr_data(const struct nlattr* attr, void* data) {
+  NftExpr* expr = (NftExpr*)data;
+  expr->attrs[mnl_attr_get_type(attr)] = attr_value(attr);
+  return MNL_CB_OK;
+}
+
+static int parse_expr(const struct nlattr* attr, void* data) {
+  NftExpr* expr = (NftExpr*)data;
+  if (mnl_attr_get_type(attr) == NFTA_EXPR_NAME) {
+    expr->name = mnl_attr_get_str(attr);
+  } else if (mnl_attr_get_type(attr) == NFTA_EXPR_DATA) {
+    mnl_attr_parse_nested(attr, parse_expr_data, expr);
+  }
+  return MNL_CB_OK;
+}
+
+static int parse_expr_list(const struct nlattr* attr, void* data) {
+  NftMsg* msg = (NftMsg*)data;
+  NftExpr expr;
+  mnl_attr_parse_nested(attr, parse_expr, &expr);
+  msg->exprs.push_back(expr);
+  return MNL_CB_OK;
+}
+
+static int parse_msg_attr(const struct nlattr* attr, void* data) {
+  NftMsg* msg = (NftMsg*)data;
+  uint16_t chain_attr = (msg->type == NFT_MSG_NEWCHAIN) ? NFTA_CHAIN_NAME
+                                                        : NFTA_RULE_CHAIN;
+  if (mnl_attr_get_type(attr) == chain_attr) {
+    msg->chain = mnl_attr_get_str(attr);
+  } else if (msg->type == NFT_MSG_NEWRULE &&
+             mnl_attr_get_type(attr) == NFTA_RULE_EXPRESSIONS) {
+    mnl_attr_parse_nested(attr, parse_expr_list, msg);
+  }
+  return MNL_CB_OK;
+}
+
+// Captures the batches instead of sending them to the kernel
+static status_code_e capture_batch(const void* batch, size_t len) {
+  std::vector<NftMsg> msgs;
+  const struct nlmsghdr* nlh = (const struct nlmsghdr*)batch;
+  int remaining = len;
+  while (mnl_nlmsg_ok(nlh, remaining)) {
+    NftMsg msg = {};
+    msg.flags = nlh->nlmsg_flags;
+    if ((nlh->nlmsg_type >> 8) == NFNL_SUBSYS_NFTABLES) {
+      msg.type = nlh->nlmsg_type & 0xff;
+      mnl_attr_parse(nlh, sizeof(struct nfgenmsg), parse_msg_attr, &msg);
+    } else {
+      msg.type = nlh->nlmsg_type;
+    }
+    msgs.push_back(msg);
+    nlh = mnl_nlmsg_next(nlh, &remaining);
+  }
+  sent_batches.push_back(msgs);
+  return send_result;
+}
+
+static std::vector<uint8_t> u32_value(uint32_t value) {
+  value = htonl(value);
+  return std::vector<uint8_t>((uint8_t*)&value, (uint8_t*)&value + 4);
+}
+
+class PgwPcefEmulationNftTest : public ::testing::Test {
+  virtual void SetUp() {
+    itti_init(TASK_MAX, THREAD_MAX, MESSAGES_ID_MAX, tasks_info, messages_info,
+              NULL, NULL);
+    memset(&pgw_config, 0, sizeof(pgw_config));
+    inet_pton(AF_INET, "192.168.128.0", &pgw_config.ue_pool_addr[0]);
+    pgw_config.ue_pool_mask[0] = 24;
+    state.deactivated_predefined_pcc_rules = hashtable_ts_create(
+        TEST_PCC_RULE_HT_SIZE, nullptr, pgw_free_pcc_rule, nullptr);
+
+    sent_batches.clear();
+    send_result = RETURNok;
+    pgw_pcef_emulation_nft_set_send(capture_batch);
+    ASSERT_EQ(pgw_pcef_emulation_init(&state, &pgw_config), RETURNok);
+    // The table of the marks is replaced at init
+    ASSERT_EQ(sent_batches.size(), 1);
+    sent_batches.clear();
+
+    memset(&pcc_rule, 0, sizeof(pcc_rule));
+    pcc_rule.name = bfromcstr("TEST_PCC_RULE");
+    pcc_rule.sdf_id = SDF_ID_TEST_PING;
+    pcc_rule.sdf_template.number_of_packet_filters = 1;
+    sdf_filter_t* sdf_f = &pcc_rule.sdf_template.sdf_filter[0];
+    sdf_f->direction = TRAFFIC_FLOW_TEMPLATE_BIDIRECTIONAL;
+    packet_filter_contents_t* pf = &sdf_f->packetfiltercontents;
+    pf->flags = TRAFFIC_FLOW_TEMPLATE_IPV4_REMOTE_ADDR_FLAG |
+                TRAFFIC_FLOW_TEMPLATE_PROTOCOL_NEXT_HEADER_FLAG |
+                TRAFFIC_FLOW_TEMPLATE_SINGLE_REMOTE_PORT_FLAG |
+                TRAFFIC_FLOW_TEMPLATE_TYPE_OF_SERVICE_TRAFFIC_CLASS_FLAG;
+    const uint8_t addr[4] = {10, 1, 2, 3};
+    const uint8_t mask[4] = {255, 255, 255, 0};
+    for (int i = 0; i < 4; i++) {
+      pf->ipv4remoteaddr[i].addr = addr[i];
+      pf->ipv4remoteaddr[i].mask = mask[i];
+    }
+    pf->protocolidentifier_nextheader = IPPROTO_UDP;
+    pf->singleremoteport = 5060;
+    pf->typdeofservice_trafficclass.value = 0xb9;
+    pf->typdeofservice_trafficclass.mask = 0xfc;
+  }
+
+  virtual void TearDown() {
+    pgw_pcef_emulation_nft_set_send(NULL);
+    bdestroy_wrapper(&pcc_rule.name);
+    hashtable_ts_destroy(state.deactivated_predefined_pcc_rules);
+    itti_free_desc_threads();
+  }
+
+ protected:
+  spgw_state_t state = {};
+  pgw_config_t pgw_config;
+  pcc_rule_t pcc_rule;
+
+  static void expect_payload(const NftExpr& expr, uint32_t base,
+                             uint32_t offset, uint32_t len) {
+    EXPECT_EQ(expr.name, "payload");
+    EXPECT_EQ(expr.attrs.at(NFTA_PAYLOAD_BASE), u32_value(base));
+    EXPECT_EQ(expr.attrs.at(NFTA_PAYLOAD_OFFSET), u32_value(offset));
+    EXPECT_EQ(expr.attrs.at(NFTA_PAYLOAD_LEN), u32_value(len));
+  }
+
+  static void expect_bitwise(const NftExpr& expr,
+                             const std::vector<uint8_t>& mask) {
+    EXPECT_EQ(expr.name, "bitwise");
+    EXPECT_EQ(expr.attrs.at(NFTA_BITWISE_MASK), mask);
+    EXPECT_EQ(expr.attrs.at(NFTA_BITWISE_XOR),
+              std::vector<uint8_t>(mask.size(), 0));
+  }
+
+  static void expect_cmp(const NftExpr& expr,
+                         const std::vector<uint8_t>& value) {
+    EXPECT_EQ(expr.name, "cmp");
+    EXPECT_EQ(expr.attrs.at(NFTA_CMP_OP), u32_value(NFT_CMP_EQ));
+    EXPECT_EQ(expr.attrs.at(NFTA_CMP_DATA), value);
+  }
+};
+
+TEST_F(PgwPcefEmulationNftTest, TestApplyRuleLayout) {
+  ASSERT_EQ(pgw_pcef_emulation_nft_apply_rule(&pcc_rule, &pgw_config),
+            RETURNok);
+  ASSERT_EQ(sent_batches.size(), 1);
+  const std::vector<NftMsg>& msgs = sent_batches[0];
+  ASSERT_EQ(msgs.size(), 7);
+  EXPECT_EQ(msgs[0].type, NFNL_MSG_BATCH_BEGIN);
+  EXPECT_EQ(msgs[1].type, NFT_MSG_NEWCHAIN);
+  EXPECT_EQ(msgs[1].chain, "sdf_" + std::to_string(SDF_ID_TEST_PING));
+  // The chain of the rule is flushed, then linked from the base chains
+  EXPECT_EQ(msgs[2].type, NFT_MSG_DELRULE);
+  EXPECT_EQ(msgs[2].chain, msgs[1].chain);
+  EXPECT_EQ(msgs[3].type, NFT_MSG_NEWRULE);
+  EXPECT_EQ(msgs[3].chain, "postrouting");
+  EXPECT_EQ(msgs[4].type, NFT_MSG_NEWRULE);
+  EXPECT_EQ(msgs[4].chain, "output");
+  for (int i = 3; i <= 4; i++) {
+    ASSERT_EQ(msgs[i].exprs.size(), 1);
+    EXPECT_EQ(msgs[i].exprs[0].name, "immediate");
+    EXPECT_EQ(msgs[i].exprs[0].attrs.at(NFTA_IMMEDIATE_DREG),
+              u32_value(NFT_REG_VERDICT));
+  }
+  EXPECT_EQ(msgs[6].type, NFNL_MSG_BATCH_END);
+  // Only the last message of the transaction is acked
+  EXPECT_TRUE(msgs[5].flags & NLM_F_ACK);
+  EXPECT_FALSE(msgs[4].flags & NLM_F_ACK);
+
+  const NftMsg& rule = msgs[5];
+  EXPECT_EQ(rule.type, NFT_MSG_NEWRULE);
+  EXPECT_EQ(rule.chain, msgs[1].chain);
+  ASSERT_EQ(rule.exprs.size(), 12);
+  // Remote address, masked
+  expect_payload(rule.exprs[0], NFT_PAYLOAD_NETWORK_HEADER, 16, 4);
+  expect_bitwise(rule.exprs[1], {255, 255, 255, 0});
+  expect_cmp(rule.exprs[2], {10, 1, 2, 0});
+  // Protocol and remote port, exact
+  expect_payload(rule.exprs[3], NFT_PAYLOAD_NETWORK_HEADER, 9, 1);
+  expect_cmp(rule.exprs[4], {IPPROTO_UDP});
+  expect_payload(rule.exprs[5], NFT_PAYLOAD_TRANSPORT_HEADER, 0, 2);
+  expect_cmp(rule.exprs[6], {5060 >> 8, 5060 & 0xff});
+  // Type of service, with the mask of the filter
+  expect_payload(rule.exprs[7], NFT_PAYLOAD_NETWORK_HEADER, 1, 1);
+  expect_bitwise(rule.exprs[8], {0xfc});
+  expect_cmp(rule.exprs[9], {0xb8});
+  // Mark, in host byte order
+  EXPECT_EQ(rule.exprs[10].name, "immediate");
+  uint32_t mark = SDF_ID_TEST_PING;
+  EXPECT_EQ(rule.exprs[10].attrs.at(NFTA_IMMEDIATE_DATA),
+            std::vector<uint8_t>((uint8_t*)&mark, (uint8_t*)&mark + 4));
+  EXPECT_EQ(rule.exprs[11].name, "meta");
+  EXPECT_EQ(rule.exprs[11].attrs.at(NFTA_META_KEY), u32_value(NFT_META_MARK));
+}
+
+TEST_F(PgwPcefEmulationNftTest, TestApplyRuleUePool) {
+  packet_filter_contents_t* pf =
+      &pcc_rule.sdf_template.sdf_filter[0].packetfiltercontents;
+  pf->flags = TRAFFIC_FLOW_TEMPLATE_PROTOCOL_NEXT_HEADER_FLAG;
+  for (int i = 0; i < 4; i++) {
+    pf->ipv4remoteaddr[i].mask = 0;
+  }
+
+  ASSERT_EQ(pgw_pcef_emulation_nft_apply_rule(&pcc_rule, &pgw_config),
+            RETURNok);
+  ASSERT_EQ(sent_batches.size(), 1);
+  const NftMsg& rule = sent_batches[0][5];
+  // The wildcard source is skipped, the destination is the UE pool
+  ASSERT_EQ(rule.exprs.size(), 7);
+  expect_payload(rule.exprs[0], NFT_PAYLOAD_NETWORK_HEADER, 16, 4);
+  expect_bitwise(rule.exprs[1], {255, 255, 255, 0});
+  expect_cmp(rule.exprs[2], {192, 168, 128, 0});
+  expect_payload(rule.exprs[3], NFT_PAYLOAD_NETWORK_HEADER, 9, 1);
+  expect_cmp(rule.exprs[4], {IPPROTO_UDP});
+}
+
+TEST_F(PgwPcefEmulationNftTest, TestRemoveRule) {
+  // Nothing to remove before the rule is applied
+  EXPECT_EQ(pgw_pcef_emulation_nft_remove_rule(&pcc_rule), RETURNerror);
+  EXPECT_EQ(sent_batches.size(), 0);
+
+  ASSERT_EQ(pgw_pcef_emulation_nft_apply_rule(&pcc_rule, &pgw_config),
+            RETURNok);
+  ASSERT_EQ(pgw_pcef_emulation_nft_remove_rule(&pcc_rule), RETURNok);
+  ASSERT_EQ(sent_batches.size(), 2);
+  const std::vector<NftMsg>& msgs = sent_batches[1];
+  ASSERT_EQ(msgs.size(), 3);
+  EXPECT_EQ(msgs[1].type, NFT_MSG_DELRULE);
+  EXPECT_EQ(msgs[1].chain, "sdf_" + std::to_string(SDF_ID_TEST_PING));
+  EXPECT_TRUE(msgs[1].flags & NLM_F_ACK);
+
+  // The base chains still jump to the chain of the rule when it is applied
+  // again
+  ASSERT_EQ(pgw_pcef_emulation_nft_apply_rule(&pcc_rule, &pgw_config),
+            RETURNok);
+  ASSERT_EQ(sent_batches.size(), 3);
+  ASSERT_EQ(sent_batches[2].size(), 5);
+  EXPECT_EQ(sent_batches[2][3].chain, msgs[1].chain);
+}
+
+TEST_F(PgwPcefEmulationNftTest, TestApplyRuleWithoutTranslation) {
+  pcc_rule.sdf_template.sdf_filter[0].packetfiltercontents.flags |=
+      TRAFFIC_FLOW_TEMPLATE_REMOTE_PORT_RANGE_FLAG;
+
+  EXPECT_EQ(pgw_pcef_emulation_nft_apply_rule(&pcc_rule, &pgw_config),
+            RETURNerror);
+  EXPECT_EQ(sent_batches.size(), 0);
+}
+
+TEST_F(PgwPcefEmulationNftTest, TestFallbackToIptables) {
+  send_result = RETURNerror;
+  pgw_pcef_emulation_apply_rule(&state, SDF_ID_GBR_VOLTE_40K, &pgw_config);
+  ASSERT_EQ(sent_batches.size(), 1);
+
+  // The rule is active with the iptables marks, which are also used to
+  // remove it
+  bearer_qos_t bearer_qos;
+  packet_filter_t
+      packet_filter[SERVICE_DATA_FLOW_TEMPLATE_NB_PACKET_FILTERS_MAX];
+  uint8_t num_pf = 0;
+  EXPECT_EQ(pgw_pcef_get_sdf_parameters(&state, SDF_ID_GBR_VOLTE_40K,
+                                        &bearer_qos, packet_filter, &num_pf),
+            RETURNok);
+  send_result = RETURNok;
+  pgw_pcef_emulation_remove_rule(&state, SDF_ID_GBR_VOLTE_40K, &pgw_config);
+  EXPECT_EQ(sent_batches.size(), 1);
+  EXPECT_EQ(pgw_pcef_get_sdf_parameters(&state, SDF_ID_GBR_VOLTE_40K,
+                                        &bearer_qos, packet_filter, &num_pf),
+            RETURNerror);
+}
+
+TEST_F(PgwPcefEmulationNftTest, TestRemoveNftRule) {
+  pgw_pcef_emulation_apply_rule(&state, SDF_ID_GBR_VOLTE_40K, &pgw_config);
+  ASSERT_EQ(sent_batches.size(), 1);
+
+  pgw_pcef_emulation_remove_rule(&state, SDF_ID_GBR_VOLTE_40K, &pgw_config);
+  ASSERT_EQ(sent_batches.size(), 2);
+  EXPECT_EQ(sent_batches[1][1].type, NFT_MSG_DELRULE);
+  // Removing it again does nothing
+  pgw_pcef_emulation_remove_rule(&state, SDF_ID_GBR_VOLTE_40K, &pgw_config);
+  EXPECT_EQ(sent_batches.size(), 2);
+}
+
+}  // namespace lte
+}  // namespace magma
@@ -124,7 +124,8 @@ void AsyncAAAClient::add_sessions_rpc(
   auto local_resp = new magma::AsyncLocalResponse<acct_resp>(
       std::move(callback), RESPONSE_TIMEOUT);
   local_resp->set_response_reader(
-      stub_->Asyncadd_sessions(local_resp->get_context(), request, &queue_));
+      stub_->Asyncadd_sessions(local_resp->get_context(), request, &queue_),
+      this);
 }
 
 void AsyncAAAClient::terminate_session_rpc(
@@ -132,8 +133,10 @@ void AsyncAAAClient::terminate_session_rpc(
     std::function<void(Status, acct_resp)> callback) {
   auto local_resp = new magma::AsyncLocalResponse<acct_resp>(
       std::move(callback), RESPONSE_TIMEOUT);
-  local_resp->set_response_reader(stub_->Asyncterminate_session(
-      local_resp->get_context(), request, &queue_));
+  local_resp->set_response_reader(
+      stub_->Asyncterminate_session(local_resp->get_context(), request,
+                                    &queue_),
+      this);
 }
 
 }  // namespace aaa
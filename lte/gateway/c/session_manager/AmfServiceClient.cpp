@@ -42,8 +42,10 @@ bool AsyncAmfServiceClient::handle_response_to_access(
   PrintGrpcMessage(static_cast<const google::protobuf::Message&>(response));
   auto local_resp = new AsyncLocalResponse<SmContextVoid>(std::move(callback),
                                                           RESPONSE_TIMEOUT);
-  local_resp->set_response_reader(stub_->AsyncSetSmfSessionContext(
-      local_resp->get_context(), response, &queue_));
+  local_resp->set_response_reader(
+      stub_->AsyncSetSmfSessionContext(local_resp->get_context(), response,
+                                       &queue_),
+      this);
   return true;
 }
 
@@ -52,8 +54,9 @@ bool AsyncAmfServiceClient::handle_notification_to_access(
   MLOG(MDEBUG) << "Sending Set SM Session Notification from SMF ";
   auto local_resp = new AsyncLocalResponse<SmContextVoid>(std::move(callback),
                                                           RESPONSE_TIMEOUT);
-  local_resp->set_response_reader(stub_->AsyncSetAmfNotification(
-      local_resp->get_context(), notif, &queue_));
+  local_resp->set_response_reader(
+      stub_->AsyncSetAmfNotification(local_resp->get_context(), notif, &queue_),
+      this);
   return true;
 }
 
@@ -120,4 +120,13 @@ inline bool ccEqual(const CreditKey& l, const CreditKey& r) {
           (l.service_identifier == r.service_identifier));
 };
 
+// Exact match on rating group and service identifier, which is how keys that
+// hash differently compare in the hashed containers above
+struct CreditKeyEqual {
+  bool operator()(const CreditKey& l, const CreditKey& r) const {
+    return l.rating_group == r.rating_group &&
+           l.service_identifier == r.service_identifier;
+  }
+};
+
 }  // namespace magma
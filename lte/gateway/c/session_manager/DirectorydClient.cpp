@@ -46,8 +46,9 @@ void AsyncDirectorydClient::update_directoryd_record(
   auto local_response =
       new AsyncLocalResponse<Void>(std::move(callback), RESPONSE_TIMEOUT);
   PrintGrpcMessage(static_cast<const google::protobuf::Message&>(request));
-  local_response->set_response_reader(stub_->AsyncUpdateRecord(
-      local_response->get_context(), request, &queue_));
+  local_response->set_response_reader(
+      stub_->AsyncUpdateRecord(local_response->get_context(), request, &queue_),
+      this);
 }
 
 void AsyncDirectorydClient::delete_directoryd_record(
@@ -56,8 +57,9 @@ void AsyncDirectorydClient::delete_directoryd_record(
   auto local_response =
       new AsyncLocalResponse<Void>(std::move(callback), RESPONSE_TIMEOUT);
   PrintGrpcMessage(static_cast<const google::protobuf::Message&>(request));
-  local_response->set_response_reader(stub_->AsyncDeleteRecord(
-      local_response->get_context(), request, &queue_));
+  local_response->set_response_reader(
+      stub_->AsyncDeleteRecord(local_response->get_context(), request, &queue_),
+      this);
 }
 
 void AsyncDirectorydClient::get_all_directoryd_records(
@@ -65,7 +67,9 @@ void AsyncDirectorydClient::get_all_directoryd_records(
   magma::Void request;
   auto local_resp = new AsyncLocalResponse<AllDirectoryRecords>(
       std::move(callback), RESPONSE_TIMEOUT);
-  local_resp->set_response_reader(stub_->AsyncGetAllDirectoryRecords(
-      local_resp->get_context(), request, &queue_));
+  local_resp->set_response_reader(
+      stub_->AsyncGetAllDirectoryRecords(local_resp->get_context(), request,
+                                         &queue_),
+      this);
 }
 }  // namespace magma
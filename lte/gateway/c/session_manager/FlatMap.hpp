@@ -0,0 +1,91 @@
+/**
+ * Copyright 2020 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace magma {
+
+/**
+ * FlatMap is a map for a handful of small keys, stored as one contiguous
+ * vector of key/value pairs and searched linearly. A session only has a few
+ * credits and monitors, so this is both smaller and faster to search than an
+ * unordered_map, which allocates a node per entry and a bucket array per map.
+ *
+ * Iteration is in insertion order. Inserting or erasing invalidates all
+ * iterators and references into the map.
+ */
+template <typename KeyType, typename ValueType,
+          typename equal = std::equal_to<KeyType>>
+class FlatMap {
+ public:
+  using value_type = std::pair<KeyType, ValueType>;
+  using iterator = typename std::vector<value_type>::iterator;
+  using const_iterator = typename std::vector<value_type>::const_iterator;
+
+  iterator begin() { return entries_.begin(); }
+  iterator end() { return entries_.end(); }
+  const_iterator begin() const { return entries_.begin(); }
+  const_iterator end() const { return entries_.end(); }
+
+  size_t size() const { return entries_.size(); }
+  bool empty() const { return entries_.empty(); }
+  void clear() { entries_.clear(); }
+
+  iterator find(const KeyType& key) {
+    auto it = entries_.begin();
+    for (; it != entries_.end(); ++it) {
+      if (equal_(it->first, key)) break;
+    }
+    return it;
+  }
+
+  const_iterator find(const KeyType& key) const {
+    auto it = entries_.begin();
+    for (; it != entries_.end(); ++it) {
+      if (equal_(it->first, key)) break;
+    }
+    return it;
+  }
+
+  size_t count(const KeyType& key) const { return find(key) != end() ? 1 : 0; }
+
+  ValueType& operator[](const KeyType& key) {
+    auto it = find(key);
+    if (it != entries_.end()) {
+      return it->second;
+    }
+    entries_.emplace_back(key, ValueType());
+    return entries_.back().second;
+  }
+
+  iterator erase(const_iterator pos) { return entries_.erase(pos); }
+
+  size_t erase(const KeyType& key) {
+    auto it = find(key);
+    if (it == entries_.end()) {
+      return 0;
+    }
+    entries_.erase(it);
+    return 1;
+  }
+
+ private:
+  std::vector<value_type> entries_;
+  equal equal_;
+};
+
+}  // namespace magma
@@ -0,0 +1,191 @@
+/**
+ * Copyright 2020 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "lte/gateway/c/session_manager/FlowUpdateAccumulator.hpp"
+
+#include <set>
+#include <utility>
+
+namespace magma {
+
+namespace {
+
+template <typename RequestType>
+std::string session_key(const RequestType& request) {
+  return request.sid().id() + "|" + request.ip_addr() + "|" +
+         request.ipv6_addr();
+}
+
+bool is_same_bearer(const ActivateFlowsRequest& a,
+                    const ActivateFlowsRequest& b) {
+  return a.uplink_tunnel() == b.uplink_tunnel() &&
+         a.downlink_tunnel() == b.downlink_tunnel() &&
+         a.request_origin().type() == b.request_origin().type() &&
+         a.msisdn() == b.msisdn() && a.shard_id() == b.shard_id();
+}
+
+bool is_same_bearer(const DeactivateFlowsRequest& a,
+                    const DeactivateFlowsRequest& b) {
+  return a.uplink_tunnel() == b.uplink_tunnel() &&
+         a.downlink_tunnel() == b.downlink_tunnel() &&
+         a.request_origin().type() == b.request_origin().type() &&
+         a.remove_default_drop_flows() == b.remove_default_drop_flows();
+}
+
+bool deactivation_applies_to(const DeactivateFlowsRequest& deactivate,
+                             const ActivateFlowsRequest& activate) {
+  auto type = deactivate.request_origin().type();
+  return type == RequestOriginType::WILDCARD ||
+         type == activate.request_origin().type();
+}
+
+// Add the policies of from to to, replacing those with the same rule ID
+void merge_policies(const ActivateFlowsRequest& from,
+                    ActivateFlowsRequest* to) {
+  for (const auto& policy : from.policies()) {
+    bool replaced = false;
+    for (auto& existing : *to->mutable_policies()) {
+      if (existing.rule().id() == policy.rule().id()) {
+        existing.CopyFrom(policy);
+        replaced = true;
+        break;
+      }
+    }
+    if (!replaced) {
+      to->add_policies()->CopyFrom(policy);
+    }
+  }
+  if (from.has_apn_ambr()) {
+    to->mutable_apn_ambr()->CopyFrom(from.apn_ambr());
+  }
+}
+
+void merge_policies(const DeactivateFlowsRequest& from,
+                    DeactivateFlowsRequest* to) {
+  std::set<std::string> existing_ids;
+  for (const auto& policy : to->policies()) {
+    existing_ids.insert(policy.rule_id());
+  }
+  for (const auto& policy : from.policies()) {
+    if (existing_ids.insert(policy.rule_id()).second) {
+      to->add_policies()->CopyFrom(policy);
+    }
+  }
+}
+
+}  // namespace
+
+void FlowUpdateAccumulator::add_activate(const ActivateFlowsRequest& request,
+                                         ActivateCallback callback) {
+  auto& indices = entries_by_session_[session_key(request)];
+  if (!indices.empty()) {
+    auto& last = entries_[indices.back()];
+    if (!last.cancelled && last.update.has_activate() &&
+        is_same_bearer(last.update.activate(), request)) {
+      merge_policies(request, last.update.mutable_activate());
+      last.callbacks.push_back(std::move(callback));
+      last.has_empty_activation |= request.policies_size() == 0;
+      return;
+    }
+  }
+  Entry entry;
+  entry.update.mutable_activate()->CopyFrom(request);
+  entry.callbacks.push_back(std::move(callback));
+  entry.has_empty_activation = request.policies_size() == 0;
+  entries_.push_back(std::move(entry));
+  indices.push_back(entries_.size() - 1);
+}
+
+void FlowUpdateAccumulator::add_deactivate(
+    const DeactivateFlowsRequest& request) {
+  auto& indices = entries_by_session_[session_key(request)];
+  for (auto index : indices) {
+    auto& entry = entries_[index];
+    if (!entry.cancelled && entry.update.has_activate() &&
+        deactivation_applies_to(request, entry.update.activate())) {
+      cancel_activation(request, entry);
+    }
+  }
+
+  if (!indices.empty()) {
+    auto& last = entries_[indices.back()];
+    // Deactivations without rules remove everything, so they are only
+    // merged with identical requests
+    bool both_have_rules =
+        last.update.has_deactivate() &&
+        last.update.deactivate().policies_size() > 0 &&
+        request.policies_size() > 0;
+    bool both_remove_all = last.update.has_deactivate() &&
+                           last.update.deactivate().policies_size() == 0 &&
+                           request.policies_size() == 0;
+    if (!last.cancelled && last.update.has_deactivate() &&
+        is_same_bearer(last.update.deactivate(), request) &&
+        (both_have_rules || both_remove_all)) {
+      merge_policies(request, last.update.mutable_deactivate());
+      return;
+    }
+  }
+  Entry entry;
+  entry.update.mutable_deactivate()->CopyFrom(request);
+  entries_.push_back(std::move(entry));
+  indices.push_back(entries_.size() - 1);
+}
+
+void FlowUpdateAccumulator::cancel_activation(
+    const DeactivateFlowsRequest& request, Entry& entry) {
+  auto* activate = entry.update.mutable_activate();
+  if (activate->policies_size() == 0) {
+    return;
+  }
+  if (request.policies_size() == 0) {
+    activate->clear_policies();
+  } else {
+    std::set<std::string> deactivated_ids;
+    for (const auto& policy : request.policies()) {
+      deactivated_ids.insert(policy.rule_id());
+    }
+    auto* policies = activate->mutable_policies();
+    for (int i = policies->size() - 1; i >= 0; --i) {
+      if (deactivated_ids.count(policies->Get(i).rule().id())) {
+        policies->DeleteSubrange(i, 1);
+      }
+    }
+  }
+  if (activate->policies_size() == 0 && !entry.has_empty_activation) {
+    entry.cancelled = true;
+    for (auto& callback : entry.callbacks) {
+      cancelled_callbacks_.push_back(std::move(callback));
+    }
+    entry.callbacks.clear();
+  }
+}
+
+FlowUpdateAccumulator::Batch FlowUpdateAccumulator::take_batch() {
+  Batch batch;
+  for (auto& entry : entries_) {
+    if (entry.cancelled) {
+      continue;
+    }
+    if (entry.update.has_activate()) {
+      batch.activate_callbacks.push_back(std::move(entry.callbacks));
+    }
+    batch.request.add_updates()->Swap(&entry.update);
+  }
+  batch.cancelled_callbacks = std::move(cancelled_callbacks_);
+
+  entries_.clear();
+  entries_by_session_.clear();
+  cancelled_callbacks_.clear();
+  return batch;
+}
+
+}  // namespace magma
@@ -0,0 +1,82 @@
+/**
+ * Copyright 2020 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <grpcpp/impl/codegen/status.h>
+#include <lte/protos/pipelined.pb.h>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace magma {
+using namespace lte;
+
+/**
+ * FlowUpdateAccumulator collects the ActivateFlows and DeactivateFlows
+ * requests made during one event loop iteration so that they can be sent to
+ * PipelineD as a single FlowUpdateBatch.
+ *
+ * Requests are kept in order. A request for the same session (IMSI and UE
+ * IPs) and bearer as the previous request of that session is merged into it.
+ * A deactivation removes the rules it deactivates from earlier pending
+ * activations of the session, since PipelineD would remove them right after
+ * installing them. The deactivation itself is still sent, as the rules may
+ * have been installed before this iteration.
+ */
+class FlowUpdateAccumulator {
+ public:
+  using ActivateCallback =
+      std::function<void(grpc::Status, ActivateFlowsResult)>;
+
+  struct Batch {
+    FlowUpdateBatch request;
+    // Callbacks of the activations in request, in the same order
+    std::vector<std::vector<ActivateCallback>> activate_callbacks;
+    // Callbacks of activations that were entirely cancelled by a later
+    // deactivation and are not part of request
+    std::vector<ActivateCallback> cancelled_callbacks;
+  };
+
+  void add_activate(const ActivateFlowsRequest& request,
+                    ActivateCallback callback);
+
+  void add_deactivate(const DeactivateFlowsRequest& request);
+
+  bool empty() const { return entries_.empty(); }
+
+  /**
+   * Return everything accumulated so far and reset the accumulator
+   */
+  Batch take_batch();
+
+ private:
+  struct Entry {
+    FlowUpdate update;
+    std::vector<ActivateCallback> callbacks;
+    // Whether one of the merged activations carried no rules. Such a request
+    // still installs the session's default flows, so it is never cancelled.
+    bool has_empty_activation = false;
+    bool cancelled = false;
+  };
+
+  // Remove the rules deactivated by request from a pending activation
+  void cancel_activation(const DeactivateFlowsRequest& request, Entry& entry);
+
+  std::vector<Entry> entries_;
+  // Session key -> indices into entries_ for that session, in order
+  std::unordered_map<std::string, std::vector<size_t>> entries_by_session_;
+  std::vector<ActivateCallback> cancelled_callbacks_;
+};
+
+}  // namespace magma
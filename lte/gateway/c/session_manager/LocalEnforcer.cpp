@@ -794,8 +794,7 @@ void LocalEnforcer::schedule_static_rule_activation(
                          << "during installation of static rule " << rule_id;
           return;
         }
-        PolicyRule rule;
-        if (!rule_store_->get_rule(rule_id, &rule)) {
+        if (!rule_store_->get_rule(rule_id, nullptr)) {
           MLOG(MWARNING) << "Could not find static rules definition for "
                          << rule_id;
           return;
@@ -914,8 +913,7 @@ void LocalEnforcer::schedule_static_rule_deactivation(
         if (session->should_rule_be_active(rule_id, time(nullptr))) {
           return;
         }
-        PolicyRule rule;
-        if (!rule_store_->get_rule(rule_id, &rule)) {
+        if (!rule_store_->get_rule(rule_id, nullptr)) {
           MLOG(MERROR) << "static rule " << rule_id
                        << " is not found, skipping deactivation...";
           return;
@@ -995,13 +993,13 @@ void LocalEnforcer::filter_rule_installs(
       static_installs.begin(), static_installs.end(),
       [&](StaticRuleInstall& rule_install) {
         auto& id = rule_install.rule_id();
-        PolicyRule rule;
-        if (!rule_store_->get_rule(id, &rule)) {
+        auto rule = rule_store_->get_rule_ptr(id);
+        if (rule == nullptr) {
           LOG(ERROR) << "Not activating rule " << id
                      << " because it could not be found";
           return true;
         }
-        return !should_activate(rule, successful_credits, online);
+        return !should_activate(*rule, successful_credits, online);
       });
   static_installs.erase(end_of_valid_st_rules, static_installs.end());
 
@@ -47,7 +47,9 @@ void AsyncMobilitydClient::get_subscriberid_from_ipv4(
     std::function<void(Status status, SubscriberID)> callback) {
   auto local_resp = new AsyncLocalResponse<SubscriberID>(std::move(callback),
                                                          RESPONSE_TIMEOUT);
-  local_resp->set_response_reader(stub_->AsyncGetSubscriberIDFromIP(
-      local_resp->get_context(), ue_ip_addr, &queue_));
+  local_resp->set_response_reader(
+      stub_->AsyncGetSubscriberIDFromIP(local_resp->get_context(), ue_ip_addr,
+                                        &queue_),
+      this);
 }
 }  // namespace magma
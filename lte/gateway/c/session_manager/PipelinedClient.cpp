@@ -13,6 +13,7 @@
 
 #include "lte/gateway/c/session_manager/PipelinedClient.hpp"
 
+#include <folly/io/async/EventBase.h>
 #include <glog/logging.h>
 #include <grpcpp/channel.h>
 #include <grpcpp/impl/codegen/status.h>
@@ -337,7 +338,9 @@ namespace magma {
 
 AsyncPipelinedClient::AsyncPipelinedClient(
     std::shared_ptr<grpc::Channel> channel)
-    : stub_(Pipelined::NewStub(channel)) {
+    : stub_(Pipelined::NewStub(channel)),
+      batch_evb_(nullptr),
+      batching_enabled_(false) {
   teid = M5G_MIN_TEID;
 }
 
@@ -345,6 +348,11 @@ AsyncPipelinedClient::AsyncPipelinedClient()
     : AsyncPipelinedClient(ServiceRegistrySingleton::Instance()->GetGrpcChannel(
           "pipelined", ServiceRegistrySingleton::LOCAL)) {}
 
+void AsyncPipelinedClient::enable_flow_batching(folly::EventBase* evb) {
+  batch_evb_ = evb;
+  batching_enabled_ = true;
+}
+
 void AsyncPipelinedClient::setup_cwf(
     const std::vector<SessionState::SessionInfo>& infos,
     const std::vector<SubscriberQuotaUpdate>& quota_updates,
@@ -422,6 +430,14 @@ void AsyncPipelinedClient::deactivate_flows_for_rules(
 }
 
 void AsyncPipelinedClient::deactivate_flows(DeactivateFlowsRequest& request) {
+  if (batching_enabled_) {
+    std::lock_guard<std::mutex> lock(batch_mutex_);
+    if (pending_flow_updates_.empty()) {
+      batch_evb_->runInEventBaseThread([this] { flush_flow_updates(); });
+    }
+    pending_flow_updates_.add_deactivate(request);
+    return;
+  }
   auto imsi = request.sid().id();
   deactivate_flows_rpc(
       request, [imsi](Status status, DeactivateFlowsResult resp) {
@@ -445,7 +461,92 @@ void AsyncPipelinedClient::activate_flows_for_rules(
       make_activate_req_by_teid(imsi, ip_addr, ipv6_addr, teids, msisdn, ambr,
                                 to_process, RequestOriginType::GX);
   for (auto& activate_pair : reqs) {
-    activate_flows_rpc(activate_pair.second, callback);
+    activate_flows(activate_pair.second, callback);
+  }
+}
+
+void AsyncPipelinedClient::activate_flows(
+    const ActivateFlowsRequest& request,
+    std::function<void(Status, ActivateFlowsResult)> callback) {
+  if (batching_enabled_) {
+    std::lock_guard<std::mutex> lock(batch_mutex_);
+    if (pending_flow_updates_.empty()) {
+      batch_evb_->runInEventBaseThread([this] { flush_flow_updates(); });
+    }
+    pending_flow_updates_.add_activate(request, std::move(callback));
+    return;
+  }
+  activate_flows_rpc(request, std::move(callback));
+}
+
+void AsyncPipelinedClient::flush_flow_updates() {
+  FlowUpdateAccumulator::Batch batch;
+  {
+    std::lock_guard<std::mutex> lock(batch_mutex_);
+    batch = pending_flow_updates_.take_batch();
+  }
+  // Activations cancelled by a later deactivation have nothing left to install
+  for (auto& callback : batch.cancelled_callbacks) {
+    callback(Status::OK, ActivateFlowsResult());
+  }
+  if (batch.request.updates_size() == 0) {
+    return;
+  }
+  MLOG(MDEBUG) << "Sending " << batch.request.updates_size()
+               << " flow updates to PipelineD in one batch";
+  auto batch_ptr =
+      std::make_shared<FlowUpdateAccumulator::Batch>(std::move(batch));
+  update_flows_batch_rpc(
+      batch_ptr->request,
+      [this, batch_ptr](Status status, FlowUpdateBatchResult result) {
+        handle_flow_update_batch_response(std::move(*batch_ptr), status,
+                                          result);
+      });
+}
+
+void AsyncPipelinedClient::handle_flow_update_batch_response(
+    FlowUpdateAccumulator::Batch batch, Status status,
+    FlowUpdateBatchResult result) {
+  if (status.error_code() == grpc::StatusCode::UNIMPLEMENTED) {
+    MLOG(MWARNING) << "PipelineD does not support batched flow updates, "
+                   << "sending them individually";
+    batching_enabled_ = false;
+    send_flow_updates_individually(std::move(batch));
+    return;
+  }
+  if (!status.ok()) {
+    MLOG(MERROR) << "Could not update flows for "
+                 << batch.request.updates_size()
+                 << " requests in PipelineD: " << status.error_message();
+  }
+  for (size_t i = 0; i < batch.activate_callbacks.size(); ++i) {
+    ActivateFlowsResult activate_result;
+    if (status.ok() &&
+        i < static_cast<size_t>(result.activate_results_size())) {
+      activate_result = result.activate_results(i);
+    }
+    for (auto& callback : batch.activate_callbacks[i]) {
+      callback(status, activate_result);
+    }
+  }
+}
+
+void AsyncPipelinedClient::send_flow_updates_individually(
+    FlowUpdateAccumulator::Batch batch) {
+  size_t activate_index = 0;
+  for (auto& update : *batch.request.mutable_updates()) {
+    if (update.has_activate()) {
+      auto callbacks = std::move(batch.activate_callbacks[activate_index++]);
+      activate_flows_rpc(
+          update.activate(),
+          [callbacks](Status status, ActivateFlowsResult result) {
+            for (auto& callback : callbacks) {
+              callback(status, result);
+            }
+          });
+    } else if (update.has_deactivate()) {
+      deactivate_flows(*update.mutable_deactivate());
+    }
   }
 }
 
@@ -523,7 +624,7 @@ void AsyncPipelinedClient::add_gy_final_action_flow(
   };
 
   for (auto& activate_pair : reqs) {
-    activate_flows_rpc(activate_pair.second, cb);
+    activate_flows(activate_pair.second, cb);
   }
 }
 
@@ -535,7 +636,8 @@ void AsyncPipelinedClient::set_upf_session_rpc(
       std::move(callback), RESPONSE_TIMEOUT);
   PrintGrpcMessage(static_cast<const google::protobuf::Message&>(request));
   local_resp->set_response_reader(
-      stub_->AsyncSetSMFSessions(local_resp->get_context(), request, &queue_));
+      stub_->AsyncSetSMFSessions(local_resp->get_context(), request, &queue_),
+      this);
 }
 
 void AsyncPipelinedClient::setup_default_controllers_rpc(
@@ -544,8 +646,10 @@ void AsyncPipelinedClient::setup_default_controllers_rpc(
   auto local_resp = new AsyncLocalResponse<SetupFlowsResult>(
       std::move(callback), RESPONSE_TIMEOUT);
   PrintGrpcMessage(static_cast<const google::protobuf::Message&>(request));
-  local_resp->set_response_reader(stub_->AsyncSetupDefaultControllers(
-      local_resp->get_context(), request, &queue_));
+  local_resp->set_response_reader(
+      stub_->AsyncSetupDefaultControllers(local_resp->get_context(), request,
+                                          &queue_),
+      this);
 }
 
 void AsyncPipelinedClient::setup_policy_rpc(
@@ -554,8 +658,9 @@ void AsyncPipelinedClient::setup_policy_rpc(
   auto local_resp = new AsyncLocalResponse<SetupFlowsResult>(
       std::move(callback), RESPONSE_TIMEOUT);
   PrintGrpcMessage(static_cast<const google::protobuf::Message&>(request));
-  local_resp->set_response_reader(stub_->AsyncSetupPolicyFlows(
-      local_resp->get_context(), request, &queue_));
+  local_resp->set_response_reader(
+      stub_->AsyncSetupPolicyFlows(local_resp->get_context(), request, &queue_),
+      this);
 }
 
 void AsyncPipelinedClient::setup_ue_mac_rpc(
@@ -565,7 +670,8 @@ void AsyncPipelinedClient::setup_ue_mac_rpc(
       std::move(callback), RESPONSE_TIMEOUT);
   PrintGrpcMessage(static_cast<const google::protobuf::Message&>(request));
   local_resp->set_response_reader(
-      stub_->AsyncSetupUEMacFlows(local_resp->get_context(), request, &queue_));
+      stub_->AsyncSetupUEMacFlows(local_resp->get_context(), request, &queue_),
+      this);
 }
 
 void AsyncPipelinedClient::deactivate_flows_rpc(
@@ -575,7 +681,8 @@ void AsyncPipelinedClient::deactivate_flows_rpc(
       std::move(callback), RESPONSE_TIMEOUT);
   PrintGrpcMessage(static_cast<const google::protobuf::Message&>(request));
   local_resp->set_response_reader(
-      stub_->AsyncDeactivateFlows(local_resp->get_context(), request, &queue_));
+      stub_->AsyncDeactivateFlows(local_resp->get_context(), request, &queue_),
+      this);
 }
 
 void AsyncPipelinedClient::activate_flows_rpc(
@@ -585,7 +692,19 @@ void AsyncPipelinedClient::activate_flows_rpc(
       std::move(callback), RESPONSE_TIMEOUT);
   PrintGrpcMessage(static_cast<const google::protobuf::Message&>(request));
   local_resp->set_response_reader(
-      stub_->AsyncActivateFlows(local_resp->get_context(), request, &queue_));
+      stub_->AsyncActivateFlows(local_resp->get_context(), request, &queue_),
+      this);
+}
+
+void AsyncPipelinedClient::update_flows_batch_rpc(
+    const FlowUpdateBatch& request,
+    std::function<void(Status, FlowUpdateBatchResult)> callback) {
+  auto local_resp = new AsyncLocalResponse<FlowUpdateBatchResult>(
+      std::move(callback), RESPONSE_TIMEOUT);
+  PrintGrpcMessage(static_cast<const google::protobuf::Message&>(request));
+  local_resp->set_response_reader(
+      stub_->AsyncUpdateFlowsBatch(local_resp->get_context(), request, &queue_),
+      this);
 }
 
 void AsyncPipelinedClient::add_ue_mac_flow_rpc(
@@ -595,7 +714,8 @@ void AsyncPipelinedClient::add_ue_mac_flow_rpc(
                                                          RESPONSE_TIMEOUT);
   PrintGrpcMessage(static_cast<const google::protobuf::Message&>(request));
   local_resp->set_response_reader(
-      stub_->AsyncAddUEMacFlow(local_resp->get_context(), request, &queue_));
+      stub_->AsyncAddUEMacFlow(local_resp->get_context(), request, &queue_),
+      this);
 }
 
 void AsyncPipelinedClient::update_ipfix_flow_rpc(
@@ -605,7 +725,8 @@ void AsyncPipelinedClient::update_ipfix_flow_rpc(
                                                          RESPONSE_TIMEOUT);
   PrintGrpcMessage(static_cast<const google::protobuf::Message&>(request));
   local_resp->set_response_reader(
-      stub_->AsyncUpdateIPFIXFlow(local_resp->get_context(), request, &queue_));
+      stub_->AsyncUpdateIPFIXFlow(local_resp->get_context(), request, &queue_),
+      this);
 }
 
 void AsyncPipelinedClient::delete_ue_mac_flow_rpc(
@@ -615,7 +736,8 @@ void AsyncPipelinedClient::delete_ue_mac_flow_rpc(
                                                          RESPONSE_TIMEOUT);
   PrintGrpcMessage(static_cast<const google::protobuf::Message&>(request));
   local_resp->set_response_reader(
-      stub_->AsyncDeleteUEMacFlow(local_resp->get_context(), request, &queue_));
+      stub_->AsyncDeleteUEMacFlow(local_resp->get_context(), request, &queue_),
+      this);
 }
 
 void AsyncPipelinedClient::update_subscriber_quota_state_rpc(
@@ -624,8 +746,10 @@ void AsyncPipelinedClient::update_subscriber_quota_state_rpc(
   auto local_resp = new AsyncLocalResponse<FlowResponse>(std::move(callback),
                                                          RESPONSE_TIMEOUT);
   PrintGrpcMessage(static_cast<const google::protobuf::Message&>(request));
-  local_resp->set_response_reader(stub_->AsyncUpdateSubscriberQuotaState(
-      local_resp->get_context(), request, &queue_));
+  local_resp->set_response_reader(
+      stub_->AsyncUpdateSubscriberQuotaState(local_resp->get_context(), request,
+                                             &queue_),
+      this);
 }
 
 void AsyncPipelinedClient::poll_stats_rpc(
@@ -635,7 +759,7 @@ void AsyncPipelinedClient::poll_stats_rpc(
                                                             RESPONSE_TIMEOUT);
   PrintGrpcMessage(static_cast<const google::protobuf::Message&>(request));
   local_resp->set_response_reader(
-      stub_->AsyncGetStats(local_resp->get_context(), request, &queue_));
+      stub_->AsyncGetStats(local_resp->get_context(), request, &queue_), this);
 }
 
 uint32_t AsyncPipelinedClient::get_next_teid() {
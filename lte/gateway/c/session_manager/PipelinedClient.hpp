@@ -19,6 +19,7 @@
 #include <lte/protos/policydb.pb.h>
 #include <lte/protos/subscriberdb.pb.h>
 #include <stdint.h>
+#include <atomic>
 #include <experimental/optional>
 #include <functional>
 #include <memory>
@@ -27,10 +28,14 @@
 #include <unordered_map>
 #include <vector>
 
+#include "lte/gateway/c/session_manager/FlowUpdateAccumulator.hpp"
 #include "lte/gateway/c/session_manager/SessionState.hpp"
 #include "lte/gateway/c/session_manager/Types.hpp"
 #include "orc8r/gateway/c/common/async_grpc/GRPCReceiver.hpp"
 
+namespace folly {
+class EventBase;
+}  // namespace folly
 namespace grpc {
 class Channel;
 class Status;
@@ -249,6 +254,15 @@ class AsyncPipelinedClient : public GRPCReceiver, public PipelinedClient {
   explicit AsyncPipelinedClient(
       std::shared_ptr<grpc::Channel> pipelined_channel);
 
+  /**
+   * @brief Send the ActivateFlows and DeactivateFlows requests made during one
+   * iteration of evb as a single UpdateFlowsBatch call. Falls back to
+   * individual calls if PipelineD does not support batches.
+   *
+   * @param evb event base the requests are made from
+   */
+  void enable_flow_batching(folly::EventBase* evb);
+
   void setup_cwf(const std::vector<SessionState::SessionInfo>& infos,
                  const std::vector<SubscriberQuotaUpdate>& quota_updates,
                  const std::vector<std::string> ue_mac_addrs,
@@ -336,8 +350,28 @@ class AsyncPipelinedClient : public GRPCReceiver, public PipelinedClient {
   static const uint32_t RESPONSE_TIMEOUT = 6;  // seconds
   std::unique_ptr<Pipelined::Stub> stub_;
   uint32_t teid;
+  folly::EventBase* batch_evb_;
+  std::atomic<bool> batching_enabled_;
+  std::mutex batch_mutex_;
+  FlowUpdateAccumulator pending_flow_updates_;
 
  private:
+  void activate_flows(
+      const ActivateFlowsRequest& request,
+      std::function<void(Status, ActivateFlowsResult)> callback);
+
+  void flush_flow_updates();
+
+  void send_flow_updates_individually(FlowUpdateAccumulator::Batch batch);
+
+  void handle_flow_update_batch_response(FlowUpdateAccumulator::Batch batch,
+                                         Status status,
+                                         FlowUpdateBatchResult result);
+
+  void update_flows_batch_rpc(
+      const FlowUpdateBatch& request,
+      std::function<void(Status, FlowUpdateBatchResult)> callback);
+
   void setup_default_controllers_rpc(
       const SetupDefaultRequest& request,
       std::function<void(Status, SetupFlowsResult)> callback);
@@ -25,8 +25,8 @@
 namespace magma {
 
 template <typename KeyType, typename hash, typename equal>
-void PoliciesByKeyMap<KeyType, hash, equal>::insert(
-    const KeyType& key, std::shared_ptr<PolicyRule> rule_p) {
+void PoliciesByKeyMap<KeyType, hash, equal>::insert(const KeyType& key,
+                                                    PolicyRulePtr rule_p) {
   auto iter = rules_by_key_.find(key);
   if (iter == rules_by_key_.end()) {
     rules_by_key_[key] = {rule_p};
@@ -36,25 +36,24 @@ void PoliciesByKeyMap<KeyType, hash, equal>::insert(
 }
 
 template <typename KeyType, typename hash, typename equal>
-void PoliciesByKeyMap<KeyType, hash, equal>::remove(
-    const KeyType& key, std::shared_ptr<PolicyRule> rule_p) {
+void PoliciesByKeyMap<KeyType, hash, equal>::remove(const KeyType& key,
+                                                    PolicyRulePtr rule_p) {
   auto iter = rules_by_key_.find(key);
   if (iter == rules_by_key_.end()) {
     return;
   }
 
-  auto rules = iter->second;
+  auto& rules = iter->second;
   auto found = std::find(rules.begin(), rules.end(), rule_p);
   if (found == rules.end()) {
     return;
   }
   rules.erase(found);
-  rules_by_key_[key] = rules;
 }
 
 template <typename KeyType, typename hash, typename equal>
 bool PoliciesByKeyMap<KeyType, hash, equal>::get_rule_ids_for_key(
-    const KeyType& key, std::vector<std::string>& rules_out) {
+    const KeyType& key, std::vector<std::string>& rules_out) const {
   auto iter = rules_by_key_.find(key);
   if (iter == rules_by_key_.end()) {
     return false;
@@ -68,7 +67,7 @@ bool PoliciesByKeyMap<KeyType, hash, equal>::get_rule_ids_for_key(
 
 template <typename KeyType, typename hash, typename equal>
 bool PoliciesByKeyMap<KeyType, hash, equal>::get_rule_definitions_for_key(
-    const KeyType& key, std::vector<PolicyRule>& rules_out) {
+    const KeyType& key, std::vector<PolicyRule>& rules_out) const {
   auto iter = rules_by_key_.find(key);
   if (iter == rules_by_key_.end()) {
     return false;
@@ -81,7 +80,19 @@ bool PoliciesByKeyMap<KeyType, hash, equal>::get_rule_definitions_for_key(
 }
 
 template <typename KeyType, typename hash, typename equal>
-uint32_t PoliciesByKeyMap<KeyType, hash, equal>::policy_count() {
+bool PoliciesByKeyMap<KeyType, hash, equal>::get_rule_ptrs_for_key(
+    const KeyType& key, std::vector<PolicyRulePtr>& rules_out) const {
+  auto iter = rules_by_key_.find(key);
+  if (iter == rules_by_key_.end()) {
+    return false;
+  }
+
+  rules_out.insert(rules_out.end(), iter->second.begin(), iter->second.end());
+  return true;
+}
+
+template <typename KeyType, typename hash, typename equal>
+uint32_t PoliciesByKeyMap<KeyType, hash, equal>::policy_count() const {
   uint32_t count = 0;
   for (auto const& kv : rules_by_key_) {
     count += kv.second.size();
@@ -100,59 +111,125 @@ static bool should_track_monitoring_key(
          tracking_type == PolicyRule::OCS_AND_PCRF;
 }
 
-void PolicyRuleBiMap::sync_rules(const std::vector<PolicyRule>& rules) {
-  std::lock_guard<std::mutex> lock(map_mutex_);
-  rules_by_rule_id_.clear();
-  rules_by_charging_key_ =
-      PoliciesByKeyMap<CreditKey, decltype(&ccHash), decltype(&ccEqual)>(
-          &ccHash, &ccEqual);
-  rules_by_monitoring_key_ = PoliciesByKeyMap<std::string>();
+static void add_to_snapshot(PolicyRuleSnapshot* snapshot,
+                            PolicyRulePtr rule_p) {
+  PolicyRuleEntry entry;
+  entry.rule = rule_p;
+  if (should_track_charging_key(rule_p->tracking_type())) {
+    snapshot->rules_by_charging_key.insert(CreditKey(rule_p.get()), rule_p);
+    entry.usage_keys.tracks_charging_key = true;
+    entry.usage_keys.charging_key = CreditKey(rule_p.get());
+  }
+  if (should_track_monitoring_key(rule_p->tracking_type())) {
+    snapshot->rules_by_monitoring_key.insert(rule_p->monitoring_key(), rule_p);
+    entry.usage_keys.tracks_monitoring_key = true;
+    entry.usage_keys.monitoring_key = rule_p->monitoring_key();
+  }
+  snapshot->rules_by_rule_id[rule_p->id()] = std::move(entry);
+}
+
+static void remove_from_snapshot(PolicyRuleSnapshot* snapshot,
+                                 PolicyRulePtr rule_p) {
+  snapshot->rules_by_rule_id.erase(rule_p->id());
+  if (should_track_charging_key(rule_p->tracking_type())) {
+    snapshot->rules_by_charging_key.remove(CreditKey(rule_p.get()), rule_p);
+  }
+  if (should_track_monitoring_key(rule_p->tracking_type())) {
+    snapshot->rules_by_monitoring_key.remove(rule_p->monitoring_key(), rule_p);
+  }
+}
+
+std::shared_ptr<const PolicyRuleSnapshot> PolicyRuleBiMap::build_snapshot(
+    const std::vector<PolicyRule>& rules) {
+  auto snapshot = std::make_shared<PolicyRuleSnapshot>();
+  snapshot->rules_by_rule_id.reserve(rules.size());
   for (const auto& rule : rules) {
-    auto rule_p = std::make_shared<PolicyRule>(rule);
-    rules_by_rule_id_[rule.id()] = rule_p;
-    if (should_track_charging_key(rule.tracking_type())) {
-      rules_by_charging_key_.insert(CreditKey(rule), rule_p);
-    }
-    if (should_track_monitoring_key(rule.tracking_type())) {
-      rules_by_monitoring_key_.insert(rule.monitoring_key(), rule_p);
+    auto existing = snapshot->rules_by_rule_id.find(rule.id());
+    if (existing != snapshot->rules_by_rule_id.end()) {
+      // Last definition wins, same as inserting the rules one by one
+      remove_from_snapshot(snapshot.get(), existing->second.rule);
     }
+    add_to_snapshot(snapshot.get(), std::make_shared<const PolicyRule>(rule));
   }
+  return snapshot;
+}
+
+void PolicyRuleBiMap::publish_snapshot(
+    std::shared_ptr<const PolicyRuleSnapshot> snapshot) {
+  std::lock_guard<std::mutex> lock(map_mutex_);
+  std::atomic_store(&snapshot_, std::move(snapshot));
+}
+
+std::shared_ptr<const PolicyRuleSnapshot> PolicyRuleBiMap::get_snapshot()
+    const {
+  return std::atomic_load(&snapshot_);
+}
+
+void PolicyRuleBiMap::sync_rules(const std::vector<PolicyRule>& rules) {
+  // The expensive part happens before any writer lock is taken, and readers
+  // keep using the previous snapshot until the swap
+  publish_snapshot(build_snapshot(rules));
 }
 
 void PolicyRuleBiMap::insert_rule(const PolicyRule& rule) {
-  auto rule_p = std::make_shared<PolicyRule>(rule);
+  auto rule_p = std::make_shared<const PolicyRule>(rule);
   std::lock_guard<std::mutex> lock(map_mutex_);
-  rules_by_rule_id_[rule.id()] = rule_p;
-  if (should_track_charging_key(rule.tracking_type())) {
-    rules_by_charging_key_.insert(CreditKey(rule), rule_p);
-  }
-  if (should_track_monitoring_key(rule.tracking_type())) {
-    rules_by_monitoring_key_.insert(rule.monitoring_key(), rule_p);
+  // Copy-on-write: only the maps are copied, rules are shared between the old
+  // and new snapshot
+  auto next = std::make_shared<PolicyRuleSnapshot>(*get_snapshot());
+  auto existing = next->rules_by_rule_id.find(rule.id());
+  if (existing != next->rules_by_rule_id.end()) {
+    remove_from_snapshot(next.get(), existing->second.rule);
   }
+  add_to_snapshot(next.get(), rule_p);
+  std::atomic_store(&snapshot_,
+                    std::shared_ptr<const PolicyRuleSnapshot>(std::move(next)));
 }
 
 bool PolicyRuleBiMap::get_rule(const std::string& rule_id,
                                PolicyRule* rule_out) {
-  std::lock_guard<std::mutex> lock(map_mutex_);
-  auto it = rules_by_rule_id_.find(rule_id);
-  if (it == rules_by_rule_id_.end()) {
+  auto rule_p = get_rule_ptr(rule_id);
+  if (rule_p == nullptr) {
     return false;
   }
   if (rule_out != NULL) {
-    rule_out->CopyFrom(*it->second);
+    rule_out->CopyFrom(*rule_p);
   }
   return true;
 }
 
+PolicyRulePtr PolicyRuleBiMap::get_rule_ptr(const std::string& rule_id) {
+  auto snapshot = get_snapshot();
+  auto it = snapshot->rules_by_rule_id.find(rule_id);
+  if (it == snapshot->rules_by_rule_id.end()) {
+    return nullptr;
+  }
+  return it->second.rule;
+}
+
 bool PolicyRuleBiMap::get_rules_by_ids(const std::vector<std::string>& rule_ids,
                                        std::vector<PolicyRule>& rules_out) {
-  std::lock_guard<std::mutex> lock(map_mutex_);
+  auto snapshot = get_snapshot();
   for (const std::string& rule_id : rule_ids) {
-    auto it = rules_by_rule_id_.find(rule_id);
-    if (it == rules_by_rule_id_.end()) {
+    auto it = snapshot->rules_by_rule_id.find(rule_id);
+    if (it == snapshot->rules_by_rule_id.end()) {
       return false;
     }
-    rules_out.push_back(*it->second);
+    rules_out.push_back(*it->second.rule);
+  }
+  return true;
+}
+
+bool PolicyRuleBiMap::get_rule_ptrs_by_ids(
+    const std::vector<std::string>& rule_ids,
+    std::vector<PolicyRulePtr>& rules_out) {
+  auto snapshot = get_snapshot();
+  for (const std::string& rule_id : rule_ids) {
+    auto it = snapshot->rules_by_rule_id.find(rule_id);
+    if (it == snapshot->rules_by_rule_id.end()) {
+      return false;
+    }
+    rules_out.push_back(it->second.rule);
   }
   return true;
 }
@@ -160,37 +237,33 @@ bool PolicyRuleBiMap::get_rules_by_ids(const std::vector<std::string>& rule_ids,
 bool PolicyRuleBiMap::remove_rule(const std::string& rule_id,
                                   PolicyRule* rule_out) {
   std::lock_guard<std::mutex> lock(map_mutex_);
-  auto it = rules_by_rule_id_.find(rule_id);
-  if (it == rules_by_rule_id_.end()) {
+  auto current = get_snapshot();
+  auto it = current->rules_by_rule_id.find(rule_id);
+  if (it == current->rules_by_rule_id.end()) {
     return false;
   }
 
-  auto rule_ptr = it->second;
+  auto rule_ptr = it->second.rule;
   if (rule_out != NULL) {
     rule_out->CopyFrom(*rule_ptr);
   }
 
   // Remove the rule from all mappings
-  rules_by_rule_id_.erase(it);
-  if (should_track_charging_key(rule_ptr->tracking_type())) {
-    rules_by_charging_key_.remove(CreditKey(rule_ptr.get()), rule_ptr);
-  }
-  if (should_track_monitoring_key(rule_ptr->tracking_type())) {
-    rules_by_monitoring_key_.remove(rule_ptr->monitoring_key(), rule_ptr);
-  }
-
+  auto next = std::make_shared<PolicyRuleSnapshot>(*current);
+  remove_from_snapshot(next.get(), rule_ptr);
+  std::atomic_store(&snapshot_,
+                    std::shared_ptr<const PolicyRuleSnapshot>(std::move(next)));
   return true;
 }
 
 bool PolicyRuleBiMap::get_charging_key_for_rule_id(const std::string& rule_id,
                                                    CreditKey* charging_key) {
-  std::lock_guard<std::mutex> lock(map_mutex_);
-  auto it = rules_by_rule_id_.find(rule_id);
-  if (it == rules_by_rule_id_.end()) {
+  auto rule_p = get_rule_ptr(rule_id);
+  if (rule_p == nullptr) {
     return false;
   }
-  if (should_track_charging_key(it->second->tracking_type())) {
-    charging_key->set(it->second.get());
+  if (should_track_charging_key(rule_p->tracking_type())) {
+    charging_key->set(rule_p.get());
     return true;
   }
   return false;
@@ -198,52 +271,63 @@ bool PolicyRuleBiMap::get_charging_key_for_rule_id(const std::string& rule_id,
 
 bool PolicyRuleBiMap::get_monitoring_key_for_rule_id(
     const std::string& rule_id, std::string* monitoring_key) {
-  std::lock_guard<std::mutex> lock(map_mutex_);
-  auto it = rules_by_rule_id_.find(rule_id);
-  if (it == rules_by_rule_id_.end() ||
-      !should_track_monitoring_key(it->second->tracking_type())) {
+  auto rule_p = get_rule_ptr(rule_id);
+  if (rule_p == nullptr ||
+      !should_track_monitoring_key(rule_p->tracking_type())) {
     return false;
   }
   // nullptr means the caller does not care about retrieving the value
   if (monitoring_key != nullptr) {
-    monitoring_key->assign(it->second->monitoring_key());
+    monitoring_key->assign(rule_p->monitoring_key());
+  }
+  return true;
+}
+
+bool PolicyRuleBiMap::get_usage_keys_for_rule_id(const std::string& rule_id,
+                                                 RuleUsageKeys* usage_keys) {
+  auto snapshot = get_snapshot();
+  auto it = snapshot->rules_by_rule_id.find(rule_id);
+  if (it == snapshot->rules_by_rule_id.end()) {
+    return false;
   }
+  *usage_keys = it->second.usage_keys;
   return true;
 }
 
 bool PolicyRuleBiMap::get_rule_ids_for_charging_key(
     const CreditKey& charging_key, std::vector<std::string>& rules_out) {
-  std::lock_guard<std::mutex> lock(map_mutex_);
-  bool success =
-      rules_by_charging_key_.get_rule_ids_for_key(charging_key, rules_out);
-  return success;
+  return get_snapshot()->rules_by_charging_key.get_rule_ids_for_key(
+      charging_key, rules_out);
 }
 
 bool PolicyRuleBiMap::get_rule_definitions_for_charging_key(
     const CreditKey& charging_key, std::vector<PolicyRule>& rules_out) {
-  std::lock_guard<std::mutex> lock(map_mutex_);
-  bool success = rules_by_charging_key_.get_rule_definitions_for_key(
+  return get_snapshot()->rules_by_charging_key.get_rule_definitions_for_key(
+      charging_key, rules_out);
+}
+
+bool PolicyRuleBiMap::get_rule_ptrs_for_charging_key(
+    const CreditKey& charging_key, std::vector<PolicyRulePtr>& rules_out) {
+  return get_snapshot()->rules_by_charging_key.get_rule_ptrs_for_key(
       charging_key, rules_out);
-  return success;
 }
 
 uint32_t PolicyRuleBiMap::monitored_rules_count() {
-  std::lock_guard<std::mutex> lock(map_mutex_);
-  return rules_by_monitoring_key_.policy_count();
+  return get_snapshot()->rules_by_monitoring_key.policy_count();
 }
 
 bool PolicyRuleBiMap::get_rule_ids(std::vector<std::string>& rules_ids_out) {
-  std::lock_guard<std::mutex> lock(map_mutex_);
-  for (auto kv : rules_by_rule_id_) {
+  auto snapshot = get_snapshot();
+  for (const auto& kv : snapshot->rules_by_rule_id) {
     rules_ids_out.push_back(kv.first);
   }
   return true;
 }
 
 bool PolicyRuleBiMap::get_rules(std::vector<PolicyRule>& rules_out) {
-  std::lock_guard<std::mutex> lock(map_mutex_);
-  for (auto kv : rules_by_rule_id_) {
-    rules_out.push_back(*kv.second);
+  auto snapshot = get_snapshot();
+  for (const auto& kv : snapshot->rules_by_rule_id) {
+    rules_out.push_back(*kv.second.rule);
   }
   return true;
 }
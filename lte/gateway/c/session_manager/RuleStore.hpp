@@ -34,6 +34,10 @@ class SetGroupPDR;
 }  // namespace lte
 
 using namespace lte;
+
+// Shared, read-only handle to a rule owned by a rule store snapshot
+using PolicyRulePtr = std::shared_ptr<const PolicyRule>;
+
 /**
  * Template class for keeping track of a map of one key to many policy rules
  */
@@ -44,31 +48,92 @@ class PoliciesByKeyMap {
   PoliciesByKeyMap() {}
   PoliciesByKeyMap(hash hasher, equal eq) : rules_by_key_(4, hasher, eq) {}
 
-  void insert(const KeyType& key, std::shared_ptr<PolicyRule> rule_p);
+  void insert(const KeyType& key, PolicyRulePtr rule_p);
 
-  void remove(const KeyType& key, std::shared_ptr<PolicyRule> rule_p);
+  void remove(const KeyType& key, PolicyRulePtr rule_p);
 
-  uint32_t policy_count();
+  uint32_t policy_count() const;
 
   bool get_rule_ids_for_key(const KeyType& key,
-                            std::vector<std::string>& rules_out);
+                            std::vector<std::string>& rules_out) const;
 
   bool get_rule_definitions_for_key(const KeyType& key,
-                                    std::vector<PolicyRule>& rules_out);
+                                    std::vector<PolicyRule>& rules_out) const;
+
+  bool get_rule_ptrs_for_key(const KeyType& key,
+                             std::vector<PolicyRulePtr>& rules_out) const;
 
  private:
-  std::unordered_map<KeyType, std::vector<std::shared_ptr<PolicyRule>>, hash,
-                     equal>
+  std::unordered_map<KeyType, std::vector<PolicyRulePtr>, hash, equal>
       rules_by_key_;
 };
 
+/**
+ * The keys that usage reported for a rule is added to, resolved once when the
+ * rule is stored so that usage reporting needs a single lookup per rule
+ */
+struct RuleUsageKeys {
+  bool tracks_charging_key = false;
+  CreditKey charging_key;
+  bool tracks_monitoring_key = false;
+  std::string monitoring_key;
+};
+
+struct PolicyRuleEntry {
+  PolicyRulePtr rule;
+  RuleUsageKeys usage_keys;
+};
+
+/**
+ * PolicyRuleSnapshot is an immutable view of all rules in a PolicyRuleBiMap.
+ * A published snapshot is never modified. Writers build the next snapshot and
+ * swap it in atomically, so readers can hold on to a snapshot (or to any rule
+ * in it) without taking a lock.
+ */
+struct PolicyRuleSnapshot {
+  PolicyRuleSnapshot() : rules_by_charging_key(&ccHash, &ccEqual) {}
+
+  // rule_id -> PolicyRule
+  std::unordered_map<std::string, PolicyRuleEntry> rules_by_rule_id;
+  // charging key -> [PolicyRule]
+  PoliciesByKeyMap<CreditKey, decltype(&ccHash), decltype(&ccEqual)>
+      rules_by_charging_key;
+  // monitoring key -> [PolicyRule]
+  PoliciesByKeyMap<std::string> rules_by_monitoring_key;
+};
+
 /**
  * RuleChargingKeyMapper is a class for querying a bi-directional map of
  * rule_id <-> charging_key
+ *
+ * Reads never block: every lookup works on the snapshot that was current when
+ * it started. Writes are serialized among themselves and publish a new
+ * snapshot when done.
  */
 class PolicyRuleBiMap {
  public:
-  PolicyRuleBiMap() : rules_by_charging_key_(&ccHash, &ccEqual) {}
+  PolicyRuleBiMap()
+      : snapshot_(std::make_shared<const PolicyRuleSnapshot>()) {}
+
+  /**
+   * Build a snapshot holding exactly the given rules. This does not touch any
+   * store, so it can be done on a loader thread ahead of publish_snapshot.
+   */
+  static std::shared_ptr<const PolicyRuleSnapshot> build_snapshot(
+      const std::vector<PolicyRule>& rules);
+
+  /**
+   * Replace the current rules with the given snapshot
+   */
+  virtual void publish_snapshot(
+      std::shared_ptr<const PolicyRuleSnapshot> snapshot);
+
+  /**
+   * Get the current snapshot. The returned snapshot stays valid and unchanged
+   * for as long as the caller holds it, regardless of later writes.
+   */
+  std::shared_ptr<const PolicyRuleSnapshot> get_snapshot() const;
+
   /**
    * Clear the maps and add in the given rules
    */
@@ -82,9 +147,16 @@ class PolicyRuleBiMap {
   // If the output rule param is NULL, the rule object is not copied.
   virtual bool get_rule(const std::string& rule_id, PolicyRule* rule_out);
 
+  // Get a shared handle to the rule definition associated with the given
+  // rule_id, without copying it. Returns nullptr if the rule is not found.
+  virtual PolicyRulePtr get_rule_ptr(const std::string& rule_id);
+
   virtual bool get_rules_by_ids(const std::vector<std::string>& rule_ids,
                                 std::vector<PolicyRule>& rules_out);
 
+  virtual bool get_rule_ptrs_by_ids(const std::vector<std::string>& rule_ids,
+                                    std::vector<PolicyRulePtr>& rules_out);
+
   // Remove a rule from the store by ID. Returns true if the rule ID was found.
   // The removed rule will be copied into rule_out.
   // If the output rule param is NULL, the rule object is not copied.
@@ -101,6 +173,13 @@ class PolicyRuleBiMap {
   virtual bool get_monitoring_key_for_rule_id(const std::string& rule_id,
                                               std::string* monitoring_key);
 
+  /**
+   * Get the charging and monitoring key of a rule in one lookup
+   * @returns false if the rule doesn't exist, true if so
+   */
+  virtual bool get_usage_keys_for_rule_id(const std::string& rule_id,
+                                          RuleUsageKeys* usage_keys);
+
   /**
    * Get all the rules for a given key. Rule ids are copied into rules_out
    */
@@ -113,6 +192,12 @@ class PolicyRuleBiMap {
   virtual bool get_rule_definitions_for_charging_key(
       const CreditKey& charging_key, std::vector<PolicyRule>& rules_out);
 
+  /**
+   * Get shared handles to all the rules for a given key
+   */
+  virtual bool get_rule_ptrs_for_charging_key(
+      const CreditKey& charging_key, std::vector<PolicyRulePtr>& rules_out);
+
   /**
    * Get the number of rules tracked by a monitoring key
    */
@@ -123,16 +208,10 @@ class PolicyRuleBiMap {
   virtual bool get_rules(std::vector<PolicyRule>& rules_out);
 
  protected:
-  // guards all three maps below
+  // serializes writers; readers only load snapshot_
   std::mutex map_mutex_;
-  // rule_id -> PolicyRule
-  std::unordered_map<std::string, std::shared_ptr<PolicyRule>>
-      rules_by_rule_id_;
-  // charging key -> [PolicyRule]
-  PoliciesByKeyMap<CreditKey, decltype(&ccHash), decltype(&ccEqual)>
-      rules_by_charging_key_;
-  // monitoring key -> [PolicyRule]
-  PoliciesByKeyMap<std::string> rules_by_monitoring_key_;
+  // only ever accessed through std::atomic_load / std::atomic_store
+  std::shared_ptr<const PolicyRuleSnapshot> snapshot_;
 };
 
 /**
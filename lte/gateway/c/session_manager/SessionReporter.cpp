@@ -18,6 +18,7 @@
 #include <lte/protos/session_manager.grpc.pb.h>
 #include <lte/protos/session_manager.pb.h>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -64,19 +65,44 @@ SessionReporter::get_terminate_logging_cb(
   };
 }
 
-SessionReporterImpl::SessionReporterImpl(folly::EventBase* base,
-                                         std::shared_ptr<grpc::Channel> channel)
-    : base_(base), stub_(CentralSessionController::NewStub(channel)) {}
+SessionReporterImpl::SessionReporterImpl(
+    folly::EventBase* base, std::shared_ptr<grpc::Channel> channel,
+    UpdateSessionBatchConfig batch_config)
+    : base_(base), stub_(CentralSessionController::NewStub(channel)) {
+  if (batch_config.is_enabled()) {
+    MLOG(MINFO) << "Batching UpdateSession requests up to "
+                << batch_config.max_updates << " updates or "
+                << batch_config.window_ms << "ms";
+    update_batcher_ = std::make_unique<UpdateSessionBatcher>(
+        base, batch_config,
+        [this](const UpdateSessionRequest& request,
+               ReporterCallbackFn<UpdateSessionResponse> callback) {
+          send_update_session(request, std::move(callback));
+        });
+  }
+}
 
 void SessionReporterImpl::report_updates(
     const UpdateSessionRequest& request,
     ReporterCallbackFn<UpdateSessionResponse> callback) {
+  if (update_batcher_) {
+    update_batcher_->add(request, std::move(callback));
+    return;
+  }
+  send_update_session(request, std::move(callback));
+}
+
+void SessionReporterImpl::send_update_session(
+    const UpdateSessionRequest& request,
+    ReporterCallbackFn<UpdateSessionResponse> callback) {
   PrintGrpcMessage(static_cast<const google::protobuf::Message&>(request));
 
   auto controller_response = new AsyncEvbResponse<UpdateSessionResponse>(
       base_, callback, RESPONSE_TIMEOUT);
-  controller_response->set_response_reader(stub_->AsyncUpdateSession(
-      controller_response->get_context(), request, &queue_));
+  controller_response->set_response_reader(
+      stub_->AsyncUpdateSession(controller_response->get_context(), request,
+                                &queue_),
+      this);
 }
 
 void SessionReporterImpl::report_create_session(
@@ -85,8 +111,10 @@ void SessionReporterImpl::report_create_session(
   PrintGrpcMessage(static_cast<const google::protobuf::Message&>(request));
   auto controller_response = new AsyncEvbResponse<CreateSessionResponse>(
       base_, callback, RESPONSE_TIMEOUT);
-  controller_response->set_response_reader(stub_->AsyncCreateSession(
-      controller_response->get_context(), request, &queue_));
+  controller_response->set_response_reader(
+      stub_->AsyncCreateSession(controller_response->get_context(), request,
+                                &queue_),
+      this);
 }
 
 void SessionReporterImpl::report_terminate_session(
@@ -96,8 +124,9 @@ void SessionReporterImpl::report_terminate_session(
   auto controller_response = new AsyncEvbResponse<SessionTerminateResponse>(
       base_, callback, RESPONSE_TIMEOUT);
   controller_response->set_response_reader(
-      std::move(stub_->AsyncTerminateSession(controller_response->get_context(),
-                                             request, &queue_)));
+      stub_->AsyncTerminateSession(controller_response->get_context(), request,
+                                   &queue_),
+      this);
 }
 
 }  // namespace magma
@@ -20,6 +20,7 @@
 #include <functional>
 #include <memory>
 
+#include "lte/gateway/c/session_manager/UpdateSessionBatcher.hpp"
 #include "orc8r/gateway/c/common/async_grpc/GRPCReceiver.hpp"
 
 namespace folly {
@@ -105,8 +106,13 @@ class SessionReporter : public GRPCReceiver {
 
 class SessionReporterImpl : public SessionReporter {
  public:
-  SessionReporterImpl(folly::EventBase* base,
-                      std::shared_ptr<grpc::Channel> channel);
+  /**
+   * @param batch_config when enabled, UpdateSession requests reported within
+   *                     the batch window are sent as a single request
+   */
+  SessionReporterImpl(
+      folly::EventBase* base, std::shared_ptr<grpc::Channel> channel,
+      UpdateSessionBatchConfig batch_config = UpdateSessionBatchConfig());
 
   void report_updates(
       const UpdateSessionRequest& request,
@@ -121,8 +127,13 @@ class SessionReporterImpl : public SessionReporter {
       std::function<void(grpc::Status, SessionTerminateResponse)> callback);
 
  private:
+  void send_update_session(
+      const UpdateSessionRequest& request,
+      std::function<void(grpc::Status, UpdateSessionResponse)> callback);
+
   folly::EventBase* base_;
   std::unique_ptr<CentralSessionController::Stub> stub_;
+  std::unique_ptr<UpdateSessionBatcher> update_batcher_;
   static const uint32_t RESPONSE_TIMEOUT = 6;  // seconds
 };
 
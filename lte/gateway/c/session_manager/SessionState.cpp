@@ -147,7 +147,6 @@ SessionState::SessionState(const StoredSessionState& marshaled,
       static_rules_(rule_store),
       pending_event_triggers_(marshaled.pending_event_triggers),
       revalidation_time_(marshaled.revalidation_time),
-      credit_map_(4, &ccHash, &ccEqual),
       bearer_id_by_policy_(marshaled.bearer_id_by_policy),
       shard_id_(marshaled.shard_id) {
   session_level_key_ = marshaled.session_level_key;
@@ -202,7 +201,6 @@ SessionState::SessionState(const std::string& session_id,
       rtx_counter_(0),
       subscriber_quota_state_(SubscriberQuotaUpdate_Type_VALID_QUOTA),
       static_rules_(rule_store),
-      credit_map_(4, &ccHash, &ccEqual),
       session_level_key_("") {}
 
 /*For 5G which doesn't have response context*/
@@ -221,7 +219,6 @@ SessionState::SessionState(const std::string& imsi,
       rtx_counter_(0),
       subscriber_quota_state_(SubscriberQuotaUpdate_Type_VALID_QUOTA),
       static_rules_(rule_store),
-      credit_map_(4, &ccHash, &ccEqual),
       session_level_key_("") {}
 
 /* get-set methods of new messages  for 5G*/
@@ -614,8 +611,6 @@ void SessionState::add_rule_usage(const std::string& rule_id,
                                   uint64_t used_rx, uint64_t dropped_tx,
                                   uint64_t dropped_rx,
                                   SessionStateUpdateCriteria* session_uc) {
-  CreditKey charging_key;
-
   if (rule_id.compare(DROP_ALL_RULE) == 0) {
     set_data_metrics(UE_DROPPED_GAUGE_NAME, dropped_tx, dropped_rx);
     return;
@@ -629,8 +624,28 @@ void SessionState::add_rule_usage(const std::string& rule_id,
   }
   RuleStats delta = rule_delta.value();
 
-  if (dynamic_rules_.get_charging_key_for_rule_id(rule_id, &charging_key) ||
-      static_rules_.get_charging_key_for_rule_id(rule_id, &charging_key)) {
+  // Resolve both keys with one lookup per rule store. Like the individual key
+  // lookups, a key the dynamic rule does not track falls back to the static
+  // rule with the same ID.
+  RuleUsageKeys usage_keys;
+  bool is_dynamic_rule =
+      dynamic_rules_.get_usage_keys_for_rule_id(rule_id, &usage_keys);
+  RuleUsageKeys static_keys;
+  if ((!usage_keys.tracks_charging_key ||
+       !usage_keys.tracks_monitoring_key) &&
+      static_rules_.get_usage_keys_for_rule_id(rule_id, &static_keys)) {
+    if (!usage_keys.tracks_charging_key) {
+      usage_keys.tracks_charging_key = static_keys.tracks_charging_key;
+      usage_keys.charging_key = static_keys.charging_key;
+    }
+    if (!usage_keys.tracks_monitoring_key) {
+      usage_keys.tracks_monitoring_key = static_keys.tracks_monitoring_key;
+      usage_keys.monitoring_key = static_keys.monitoring_key;
+    }
+  }
+
+  if (usage_keys.tracks_charging_key) {
+    const auto& charging_key = usage_keys.charging_key;
     MLOG(MINFO) << "Updating used charging credit for Rule=" << rule_id
                 << " Rating Group=" << charging_key.rating_group
                 << " Service Identifier=" << charging_key.service_identifier;
@@ -647,18 +662,17 @@ void SessionState::add_rule_usage(const std::string& rule_id,
                    << " not found, not adding the usage";
     }
   }
-  std::string monitoring_key;
-  if (dynamic_rules_.get_monitoring_key_for_rule_id(rule_id, &monitoring_key) ||
-      static_rules_.get_monitoring_key_for_rule_id(rule_id, &monitoring_key)) {
+  if (usage_keys.tracks_monitoring_key) {
     MLOG(MINFO) << "Updating used monitoring credit for Rule=" << rule_id
-                << " Monitoring Key=" << monitoring_key;
-    add_to_monitor(monitoring_key, delta.tx, delta.rx, session_uc);
+                << " Monitoring Key=" << usage_keys.monitoring_key;
+    add_to_monitor(usage_keys.monitoring_key, delta.tx, delta.rx, session_uc);
   }
-  if (session_level_key_ != "" && monitoring_key != session_level_key_) {
+  if (session_level_key_ != "" &&
+      usage_keys.monitoring_key != session_level_key_) {
     // Update session level key if its different
     add_to_monitor(session_level_key_, delta.tx, delta.rx, session_uc);
   }
-  if (is_dynamic_rule_installed(rule_id) || is_static_rule_installed(rule_id)) {
+  if (is_dynamic_rule || is_static_rule_installed(rule_id)) {
     increment_data_metrics(UE_USED_COUNTER_NAME, delta.tx, delta.rx);
   }
   set_data_metrics(UE_DROPPED_GAUGE_NAME, dropped_tx, dropped_rx);
@@ -787,7 +801,7 @@ void SessionState::get_monitor_updates(UpdateSessionRequest* update_request_out,
       continue;  // no update
     }
 
-    auto mkey = monitor_pair.first;
+    const auto& mkey = monitor_pair.first;
     auto& credit = monitor_pair.second->credit;
     auto credit_uc = get_monitor_uc(mkey, session_uc);
 
@@ -911,11 +925,12 @@ SessionTerminateRequest SessionState::make_termination_request(
 
   // gx monitors
   for (auto& credit_pair : monitor_map_) {
-    auto credit_uc = get_monitor_uc(credit_pair.first, session_uc);
+    const auto& mkey = credit_pair.first;
+    auto credit_uc = get_monitor_uc(mkey, session_uc);
     req.mutable_monitor_usages()->Add()->CopyFrom(make_usage_monitor_update(
         credit_pair.second->credit.get_all_unreported_usage_for_reporting(
             credit_uc),
-        credit_pair.first, credit_pair.second->level));
+        mkey, credit_pair.second->level));
   }
   // gy credits
   for (auto& credit_pair : credit_map_) {
@@ -1197,9 +1212,7 @@ RuleToProcess SessionState::insert_gy_rule(
 RuleToProcess SessionState::activate_static_rule(
     const std::string& rule_id, const RuleLifetime& lifetime,
     SessionStateUpdateCriteria* session_uc) {
-  RuleToProcess to_process;
-  PolicyRule rule;
-  static_rules_.get_rule(rule_id, &rule);
+  auto rule = static_rules_.get_rule_ptr(rule_id);
 
   rule_lifetimes_[rule_id] = lifetime;
   if (!is_static_rule_installed(rule_id)) {
@@ -1211,7 +1224,7 @@ RuleToProcess SessionState::activate_static_rule(
   }
   increment_rule_stats(rule_id, session_uc);
 
-  return make_rule_to_process(rule);
+  return make_rule_to_process(rule ? *rule : PolicyRule::default_instance());
 }
 
 optional<RuleToProcess> SessionState::remove_dynamic_rule(
@@ -1709,12 +1722,13 @@ void SessionState::handle_update_failure(
   }
   for (const auto& failed_monitor : failed_requests.monitor_requests) {
     const auto key = failed_monitor.update().monitoring_key();
-    if (monitor_map_.find(key) == monitor_map_.end()) {
+    auto it = monitor_map_.find(key);
+    if (it == monitor_map_.end()) {
       MLOG(MERROR) << "Could not find monitor:" << key << " to reset for "
                    << session_id_;
       continue;
     }
-    monitor_map_[key]->credit.reset_reporting_credit(
+    it->second->credit.reset_reporting_credit(
         get_monitor_uc(key, session_uc));
   }
 }
@@ -1826,23 +1840,21 @@ bool SessionState::is_credit_ready_to_be_activated(
 void SessionState::get_rules_per_credit_key(
     const CreditKey& charging_key, RulesToProcess* to_process,
     SessionStateUpdateCriteria* session_uc) {
-  std::vector<PolicyRule> static_rules, dynamic_rules;
-  static_rules_.get_rule_definitions_for_charging_key(charging_key,
-                                                      static_rules);
-  for (PolicyRule rule : static_rules) {
+  std::vector<PolicyRulePtr> static_rules, dynamic_rules;
+  static_rules_.get_rule_ptrs_for_charging_key(charging_key, static_rules);
+  for (const auto& rule : static_rules) {
     // Since the static rule store is shared across sessions, we should check
     // that the rule is activated for the session
-    bool is_installed = is_static_rule_installed(rule.id());
+    bool is_installed = is_static_rule_installed(rule->id());
     if (is_installed) {
-      increment_rule_stats(rule.id(), session_uc);
-      to_process->push_back(make_rule_to_process(rule));
+      increment_rule_stats(rule->id(), session_uc);
+      to_process->push_back(make_rule_to_process(*rule));
     }
   }
-  dynamic_rules_.get_rule_definitions_for_charging_key(charging_key,
-                                                       dynamic_rules);
-  for (PolicyRule rule : dynamic_rules) {
-    increment_rule_stats(rule.id(), session_uc);
-    to_process->push_back(make_rule_to_process(rule));
+  dynamic_rules_.get_rule_ptrs_for_charging_key(charging_key, dynamic_rules);
+  for (const auto& rule : dynamic_rules) {
+    increment_rule_stats(rule->id(), session_uc);
+    to_process->push_back(make_rule_to_process(*rule));
   }
 }
 
@@ -2082,20 +2094,20 @@ optional<CreditUsageUpdate> SessionState::get_update_for_continue_service(
 void SessionState::fill_service_action_for_activate(
     std::unique_ptr<ServiceAction>& action_p, const CreditKey& key,
     SessionStateUpdateCriteria* session_uc) {
-  std::vector<PolicyRule> static_rules, dynamic_rules;
+  std::vector<PolicyRulePtr> static_rules, dynamic_rules;
   fill_service_action_with_context(action_p, ACTIVATE_SERVICE, key);
-  static_rules_.get_rules_by_ids(active_static_rules_, static_rules);
-  dynamic_rules_.get_rule_definitions_for_charging_key(key, dynamic_rules);
+  static_rules_.get_rule_ptrs_by_ids(active_static_rules_, static_rules);
+  dynamic_rules_.get_rule_ptrs_for_charging_key(key, dynamic_rules);
 
   RulesToProcess* to_install = action_p->get_mutable_gx_rules_to_install();
-  for (PolicyRule rule : static_rules) {
+  for (const auto& rule : static_rules) {
     RuleLifetime lifetime;
     to_install->push_back(
-        activate_static_rule(rule.id(), lifetime, session_uc));
+        activate_static_rule(rule->id(), lifetime, session_uc));
   }
-  for (PolicyRule rule : dynamic_rules) {
+  for (const auto& rule : dynamic_rules) {
     RuleLifetime lifetime;
-    to_install->push_back(insert_dynamic_rule(rule, lifetime, session_uc));
+    to_install->push_back(insert_dynamic_rule(*rule, lifetime, session_uc));
   }
 }
 
@@ -2222,7 +2234,7 @@ void SessionState::apply_monitor_updates(
       session_level_key_ = "";
     }
     MLOG(MINFO) << session_id_ << " Erasing monitor " << key;
-    monitor_map_.erase(key);
+    monitor_map_.erase(it);
     return;
   }
 
@@ -2329,11 +2341,6 @@ void SessionState::update_session_level_key(
     MLOG(MINFO) << "Session level monitoring key is updated from "
                 << session_level_key_ << " to " << new_key;
   }
-  if (update.credit().action() == UsageMonitoringCredit::DISABLE) {
-    session_level_key_ = "";
-  } else {
-    session_level_key_ = new_key;
-  }
   set_session_level_key(new_key, session_uc);
 }
 
@@ -2434,7 +2441,7 @@ SessionCreditUpdateCriteria* SessionState::get_monitor_uc(
   if (session_uc->monitor_credit_map.find(key) ==
       session_uc->monitor_credit_map.end()) {
     session_uc->monitor_credit_map[key] =
-        monitor_map_[key]->credit.get_update_criteria();
+        monitor_map_.find(key)->second->credit.get_update_criteria();
   }
   return &(session_uc->monitor_credit_map[key]);
 }
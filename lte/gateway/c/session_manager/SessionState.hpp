@@ -35,6 +35,7 @@
 
 #include "lte/gateway/c/session_manager/ChargingGrant.hpp"
 #include "lte/gateway/c/session_manager/CreditKey.hpp"
+#include "lte/gateway/c/session_manager/FlatMap.hpp"
 #include "lte/gateway/c/session_manager/Monitor.hpp"
 #include "lte/gateway/c/session_manager/RuleStore.hpp"
 #include "lte/gateway/c/session_manager/ServiceAction.hpp"
@@ -52,13 +53,15 @@ struct ChargingGrant;
 struct Monitor;
 
 using std::experimental::optional;
-typedef std::unordered_map<CreditKey, std::unique_ptr<ChargingGrant>,
-                           decltype(&ccHash), decltype(&ccEqual)>
+typedef FlatMap<CreditKey, std::unique_ptr<ChargingGrant>, CreditKeyEqual>
     CreditMap;
 typedef std::unordered_map<CreditKey, SessionCredit::Summary, decltype(&ccHash),
                            decltype(&ccEqual)>
     ChargingCreditSummaries;
-typedef std::unordered_map<std::string, std::unique_ptr<Monitor>> MonitorMap;
+// Keyed by the monitoring key itself rather than by an interned ID. The keys
+// come from the static rules, the session's dynamic rules and the PCRF, so no
+// single store could number all of them.
+typedef FlatMap<std::string, std::unique_ptr<Monitor>> MonitorMap;
 
 // Used to transform the proto message RuleSet into a more useful structure
 struct RuleSetToApply {
@@ -565,7 +568,9 @@ class SessionState {
   void set_session_level_key(const std::string new_key,
                              SessionStateUpdateCriteria* session_uc);
 
-  std::string& get_session_level_key() { return session_level_key_; }
+  const std::string& get_session_level_key() const {
+    return session_level_key_;
+  }
 
   bool apply_update_criteria(SessionStateUpdateCriteria session_uc);
 
@@ -16,6 +16,7 @@
 #include <glog/logging.h>
 #include <lte/protos/session_manager.pb.h>
 #include <lte/protos/subscriberdb.pb.h>
+#include <algorithm>
 #include <ostream>
 #include <utility>
 #include <vector>
@@ -50,7 +51,13 @@ SessionStore::SessionStore(
       metering_reporter_(metering_reporter) {}
 
 bool SessionStore::raw_write_sessions(SessionMap session_map) {
-  // return true;
+  return write_sessions(std::move(session_map));
+}
+
+bool SessionStore::write_sessions(SessionMap session_map) {
+  for (const auto& it : session_map) {
+    session_index_.index_sessions(it.first, it.second);
+  }
   return store_client_->write_sessions(std::move(session_map));
 }
 
@@ -118,7 +125,7 @@ void SessionStore::set_and_save_reporting_flag(
     }
   }
 
-  store_client_->write_sessions(std::move(session_map));
+  write_sessions(std::move(session_map));
 }
 
 void SessionStore::sync_request_numbers(const SessionUpdate& update_criteria) {
@@ -145,7 +152,7 @@ void SessionStore::sync_request_numbers(const SessionUpdate& update_criteria) {
     }
   }
   MLOG(MDEBUG) << "sync_request_numbers: Writing into session store";
-  store_client_->write_sessions(std::move(session_map));
+  write_sessions(std::move(session_map));
 }
 
 SessionMap SessionStore::read_sessions_for_deletion(const SessionRead& req) {
@@ -157,7 +164,7 @@ SessionMap SessionStore::read_sessions_for_deletion(const SessionRead& req) {
       session->increment_request_number(1);
     }
   }
-  store_client_->write_sessions(std::move(session_map_2));
+  write_sessions(std::move(session_map_2));
   return session_map;
 }
 
@@ -165,7 +172,7 @@ bool SessionStore::create_sessions(const std::string& subscriber_id,
                                    SessionVector sessions) {
   auto session_map = SessionMap{};
   session_map[subscriber_id] = std::move(sessions);
-  store_client_->write_sessions(std::move(session_map));
+  write_sessions(std::move(session_map));
   return true;
 }
 
@@ -207,7 +214,7 @@ bool SessionStore::update_sessions(const SessionUpdate& update_criteria) {
       ++it2;
     }
   }
-  return store_client_->write_sessions(std::move(session_map));
+  return write_sessions(std::move(session_map));
 }
 
 void SessionStore::initialize_metering_counter() {
@@ -228,6 +235,225 @@ void SessionStore::initialize_metering_counter() {
   }
 }
 
+void SessionIndex::index_sessions(const std::string& imsi,
+                                  const SessionVector& sessions) {
+  if (sessions.empty()) {
+    subscribers_.erase(imsi);
+    return;
+  }
+  SubscriberEntry entry;
+  entry.first_wlan = sessions.size();
+  for (size_t i = 0; i < sessions.size(); ++i) {
+    const auto& session = sessions[i];
+    const auto& config = session->get_config();
+    const auto& context = config.common_context;
+    const std::string session_id = session->get_session_id();
+
+    entry.session_ids.push_back(session_id);
+    entry.rat_types.push_back(context.rat_type());
+    entry.by_session_id[session_id].push_back(i);
+    entry.by_ue_ipv4[context.ue_ipv4()].push_back(i);
+    entry.by_ue_ipv6[context.ue_ipv6()].push_back(i);
+    switch (context.rat_type()) {
+      case RATType::TGPP_WLAN:
+        entry.first_wlan = std::min(entry.first_wlan, i);
+        break;
+      case RATType::TGPP_NR:
+        entry.by_upf_teid[session->get_upf_local_teid()].push_back(i);
+        break;
+      default:
+        break;
+    }
+  }
+  subscribers_[imsi] = std::move(entry);
+}
+
+optional<size_t> SessionIndex::lookup(
+    const SessionSearchCriteria& criteria) const {
+  auto sub_it = subscribers_.find(criteria.imsi);
+  if (sub_it == subscribers_.end()) {
+    return {};
+  }
+  const SubscriberEntry& entry = sub_it->second;
+  const size_t not_found = entry.session_ids.size();
+
+  // Position lists are in SessionVector order, so the first element that
+  // passes the filter is what a linear search would have found
+  auto first_of = [&](const auto& positions_by_key, const auto& key,
+                      bool lte_only) {
+    auto it = positions_by_key.find(key);
+    if (it == positions_by_key.end()) {
+      return not_found;
+    }
+    for (size_t position : it->second) {
+      if (!lte_only || entry.rat_types[position] == RATType::TGPP_LTE) {
+        return position;
+      }
+    }
+    return not_found;
+  };
+
+  size_t position = not_found;
+  switch (criteria.search_type) {
+    case IMSI_AND_SESSION_ID:
+      position = first_of(entry.by_session_id, criteria.secondary_key, false);
+      break;
+    case IMSI_AND_UE_IPV4:
+      position = first_of(entry.by_ue_ipv4, criteria.secondary_key, false);
+      break;
+    case IMSI_AND_UE_IPV4_OR_IPV6:
+      // WLAN sessions match regardless of IP
+      position = std::min(
+          {entry.first_wlan,
+           first_of(entry.by_ue_ipv4, criteria.secondary_key, false),
+           first_of(entry.by_ue_ipv6, criteria.secondary_key, false)});
+      break;
+    case IMSI_AND_UE_IPV4_OR_IPV6_OR_UPF_TEID:
+      position = std::min(
+          {entry.first_wlan,
+           first_of(entry.by_ue_ipv4, criteria.secondary_key, true),
+           first_of(entry.by_ue_ipv6, criteria.tertiary_key, true),
+           first_of(entry.by_upf_teid, criteria.quaternary_key_unit32,
+                    false)});
+      break;
+    default:
+      // Not indexed
+      break;
+  }
+  if (position == not_found) {
+    return {};
+  }
+  return position;
+}
+
+bool SessionIndex::is_consistent(const std::string& imsi,
+                                 const SessionVector& sessions,
+                                 size_t position) const {
+  auto sub_it = subscribers_.find(imsi);
+  if (sub_it == subscribers_.end()) {
+    return false;
+  }
+  const auto& session_ids = sub_it->second.session_ids;
+  return sessions.size() == session_ids.size() && position < sessions.size() &&
+         sessions[position]->get_session_id() == session_ids[position];
+}
+
+static bool matches_criteria(SessionState& session,
+                             const SessionSearchCriteria& criteria) {
+  const auto& context = session.get_config().common_context;
+  switch (criteria.search_type) {
+    case IMSI_AND_SESSION_ID:
+      if (session.get_session_id() == criteria.secondary_key) {
+        return true;
+      }
+      break;
+
+    case IMSI_AND_APN:
+      if (context.apn() == criteria.secondary_key) {
+        return true;
+      }
+      break;
+
+    case IMSI_AND_UE_IPV4:
+      if (context.ue_ipv4() == criteria.secondary_key) {
+        return true;
+      }
+      break;
+
+    case IMSI_AND_UE_IPV4_OR_IPV6:
+      // cwag case (cwag doesn't store ip)
+      if (context.rat_type() == RATType::TGPP_WLAN) {
+        return true;
+      }
+      // other case(lte,5g)
+      if (context.ue_ipv4() == criteria.secondary_key ||
+          context.ue_ipv6() == criteria.secondary_key) {
+        return true;
+      }
+      break;
+
+    case IMSI_AND_BEARER:
+      switch (context.rat_type()) {
+        case RATType::TGPP_LTE:
+          // lte case
+          if (session.get_config()
+                      .rat_specific_context.lte_context()
+                      .bearer_id() == criteria.secondary_key_unit32 &&
+              session.is_active()) {
+            return true;
+          }
+          break;
+        case RATType::TGPP_WLAN:
+          return true;
+        default:
+        case RATType::TGPP_NR:
+          MLOG(MERROR) << "Search criteria for IMSI_AND_BEARER "
+                          "not implemented for this RAT "
+                       << context.rat_type();
+          break;
+      }
+      break;  // break IMSI_AND_BEARER
+
+    case IMSI_AND_TEID:
+      switch (context.rat_type()) {
+        case RATType::TGPP_WLAN:
+          return true;
+          break;
+        case RATType::TGPP_LTE:
+          if (context.teids().enb_teid() == criteria.secondary_key_unit32 ||
+              context.teids().agw_teid() == criteria.secondary_key_unit32) {
+            return true;
+          }
+          break;
+        case RATType::TGPP_NR:
+          if (session.get_upf_local_teid() == criteria.secondary_key_unit32) {
+            return true;
+          }
+          break;
+        default:
+          MLOG(MERROR) << "Search criteria for IMSI_AND_TEID not implemented"
+                          "for this RAT "
+                       << context.rat_type();
+          break;
+      }
+      break;  // break IMSI_AND_TEID
+
+    case IMSI_AND_PDUID:
+      if (session.get_config()
+              .rat_specific_context.m5gsm_session_context()
+              .pdu_session_id() == criteria.secondary_key_unit32) {
+        return true;
+      }
+      break;  // break IMSI_AND_PDUID
+
+    case IMSI_AND_UE_IPV4_OR_IPV6_OR_UPF_TEID:
+      switch (context.rat_type()) {
+        case RATType::TGPP_WLAN:
+          return true;
+          break;
+        case RATType::TGPP_LTE:
+          if (context.ue_ipv4() == criteria.secondary_key ||
+              context.ue_ipv6() == criteria.tertiary_key) {
+            return true;
+          }
+          break;
+        case RATType::TGPP_NR:
+          if (session.get_upf_local_teid() == criteria.quaternary_key_unit32) {
+            return true;
+          }
+          break;
+        default:
+          MLOG(MERROR)
+              << "Search criteria for IMSI_AND_UE_IPV4_OR_IPV6_OR_UPF_TEID"
+                 " not implemented for this RAT "
+              << context.rat_type();
+          break;
+      }
+      break;  // break  IMSI_AND_UE_IPV4_OR_IPV6_OR_TEID
+  }
+  return false;
+}
+
 optional<SessionVector::iterator> SessionStore::find_session(
     SessionMap& session_map, SessionSearchCriteria criteria) {
   auto sm_it = session_map.find(criteria.imsi);
@@ -235,120 +461,20 @@ optional<SessionVector::iterator> SessionStore::find_session(
     return {};
   }
   auto& sessions = sm_it->second;
+  auto position = session_index_.lookup(criteria);
+  if (position &&
+      session_index_.is_consistent(criteria.imsi, sessions, *position)) {
+    auto it = sessions.begin() + *position;
+    if (matches_criteria(**it, criteria)) {
+      return it;
+    }
+  }
+  // The index does not cover this criteria or the SessionMap has diverged
+  // from what was last written, so fall back to checking every session
   for (auto it = sessions.begin(); it != sessions.end(); ++it) {
-    const auto& context = (*it)->get_config().common_context;
-    switch (criteria.search_type) {
-      case IMSI_AND_SESSION_ID:
-        if ((*it)->get_session_id() == criteria.secondary_key) {
-          return it;
-        }
-        break;
-
-      case IMSI_AND_APN:
-        if (context.apn() == criteria.secondary_key) {
-          return it;
-        }
-        break;
-
-      case IMSI_AND_UE_IPV4:
-        if (context.ue_ipv4() == criteria.secondary_key) {
-          return it;
-        }
-        break;
-
-      case IMSI_AND_UE_IPV4_OR_IPV6:
-        // cwag case (cwag doesn't store ip)
-        if (context.rat_type() == RATType::TGPP_WLAN) {
-          return it;
-        }
-        // other case(lte,5g)
-        if (context.ue_ipv4() == criteria.secondary_key ||
-            context.ue_ipv6() == criteria.secondary_key) {
-          return it;
-        }
-        break;
-
-      case IMSI_AND_BEARER:
-        switch (context.rat_type()) {
-          case RATType::TGPP_LTE:
-            // lte case
-            if ((*it)->get_config()
-                        .rat_specific_context.lte_context()
-                        .bearer_id() == criteria.secondary_key_unit32 &&
-                (*it)->is_active()) {
-              return it;
-            }
-            break;
-          case RATType::TGPP_WLAN:
-            return it;
-          default:
-          case RATType::TGPP_NR:
-            MLOG(MERROR) << "Search criteria for IMSI_AND_BEARER "
-                            "not implemented for this RAT "
-                         << context.rat_type();
-            break;
-        }
-        break;  // break IMSI_AND_BEARER
-
-      case IMSI_AND_TEID:
-        switch (context.rat_type()) {
-          case RATType::TGPP_WLAN:
-            return it;
-            break;
-          case RATType::TGPP_LTE:
-            if (context.teids().enb_teid() == criteria.secondary_key_unit32 ||
-                context.teids().agw_teid() == criteria.secondary_key_unit32) {
-              return it;
-            }
-            break;
-          case RATType::TGPP_NR:
-            if ((*it)->get_upf_local_teid() == criteria.secondary_key_unit32) {
-              return it;
-            }
-            break;
-          default:
-            MLOG(MERROR) << "Search criteria for IMSI_AND_TEID not implemented"
-                            "for this RAT "
-                         << context.rat_type();
-            break;
-        }
-        break;  // break IMSI_AND_TEID
-
-      case IMSI_AND_PDUID:
-        if ((*it)
-                ->get_config()
-                .rat_specific_context.m5gsm_session_context()
-                .pdu_session_id() == criteria.secondary_key_unit32) {
-          return it;
-        }
-        break;  // break IMSI_AND_PDUID
-
-      case IMSI_AND_UE_IPV4_OR_IPV6_OR_UPF_TEID:
-        switch (context.rat_type()) {
-          case RATType::TGPP_WLAN:
-            return it;
-            break;
-          case RATType::TGPP_LTE:
-            if (context.ue_ipv4() == criteria.secondary_key ||
-                context.ue_ipv6() == criteria.tertiary_key) {
-              return it;
-            }
-            break;
-          case RATType::TGPP_NR:
-            if ((*it)->get_upf_local_teid() == criteria.quaternary_key_unit32) {
-              return it;
-            }
-            break;
-          default:
-            MLOG(MERROR)
-                << "Search criteria for IMSI_AND_UE_IPV4_OR_IPV6_OR_UPF_TEID"
-                   " not implemented for this RAT "
-                << context.rat_type();
-            break;
-        }
-        break;  // break  IMSI_AND_UE_IPV4_OR_IPV6_OR_TEID
+    if (matches_criteria(**it, criteria)) {
+      return it;
     }
-    continue;
   }
   return {};
 }
@@ -19,6 +19,7 @@
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "lte/gateway/c/session_manager/MemoryStoreClient.hpp"
 #include "lte/gateway/c/session_manager/MeteringReporter.hpp"
@@ -87,6 +88,56 @@ struct SessionSearchCriteria {
         quaternary_key_unit32(p_quaternary_key_unit32) {}
 };
 
+/**
+ * SessionIndex is a secondary index over what SessionStore last wrote for
+ * each subscriber. It maps session ID, UE IPv4/IPv6 and UPF TEID to positions
+ * in the subscriber's SessionVector, so that the common search criteria can be
+ * answered without copying and comparing the config of every session.
+ *
+ * The index is only a hint: a SessionMap that was read and then modified in
+ * memory may no longer line up with it, so results have to be checked with
+ * is_consistent before they are used.
+ */
+class SessionIndex {
+ public:
+  /**
+   * Replace the entries for a subscriber with the given sessions. An empty
+   * vector removes the subscriber from the index.
+   */
+  void index_sessions(const std::string& imsi, const SessionVector& sessions);
+
+  void clear() { subscribers_.clear(); }
+
+  /**
+   * @return the position of the first session of the subscriber that matches
+   * the criteria, as of the last indexed write. Returns an empty value if
+   * nothing matches or if the criteria type is not indexed.
+   */
+  optional<size_t> lookup(const SessionSearchCriteria& criteria) const;
+
+  /**
+   * @return true if the given SessionVector still has the session the index
+   * expects at that position
+   */
+  bool is_consistent(const std::string& imsi, const SessionVector& sessions,
+                     size_t position) const;
+
+ private:
+  using Positions = std::vector<size_t>;
+  struct SubscriberEntry {
+    std::vector<std::string> session_ids;
+    std::vector<RATType> rat_types;
+    std::unordered_map<std::string, Positions> by_session_id;
+    std::unordered_map<std::string, Positions> by_ue_ipv4;
+    std::unordered_map<std::string, Positions> by_ue_ipv6;
+    // only 5G sessions are indexed by UPF TEID
+    std::unordered_map<uint32_t, Positions> by_upf_teid;
+    size_t first_wlan;
+  };
+
+  std::unordered_map<std::string, SubscriberEntry> subscribers_;
+};
+
 /**
  * SessionStore acts as a broker to storage of sessiond state.
  *
@@ -225,10 +276,18 @@ class SessionStore {
    */
   void initialize_metering_counter();
 
+ private:
+  /**
+   * Write through to the store client and keep session_index_ in sync with
+   * what was written
+   */
+  bool write_sessions(SessionMap session_map);
+
  private:
   std::shared_ptr<StaticRuleStore> rule_store_;
   std::shared_ptr<StoreClient> store_client_;
   std::shared_ptr<MeteringReporter> metering_reporter_;
+  SessionIndex session_index_;
 };
 
 }  // namespace lte
@@ -137,7 +137,8 @@ void AsyncSpgwServiceClient::delete_bearer_rpc(
   auto local_resp = new AsyncLocalResponse<DeleteBearerResult>(
       std::move(callback), RESPONSE_TIMEOUT);
   local_resp->set_response_reader(
-      stub_->AsyncDeleteBearer(local_resp->get_context(), request, &queue_));
+      stub_->AsyncDeleteBearer(local_resp->get_context(), request, &queue_),
+      this);
 }
 
 void AsyncSpgwServiceClient::create_dedicated_bearer_rpc(
@@ -146,7 +147,8 @@ void AsyncSpgwServiceClient::create_dedicated_bearer_rpc(
   auto local_resp = new AsyncLocalResponse<CreateBearerResult>(
       std::move(callback), RESPONSE_TIMEOUT);
   local_resp->set_response_reader(
-      stub_->AsyncCreateBearer(local_resp->get_context(), request, &queue_));
+      stub_->AsyncCreateBearer(local_resp->get_context(), request, &queue_),
+      this);
 }
 
 }  // namespace magma
@@ -0,0 +1,222 @@
+/**
+ * Copyright 2020 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "lte/gateway/c/session_manager/UpdateSessionBatcher.hpp"
+
+#include <folly/io/async/EventBase.h>
+#include <glog/logging.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "orc8r/gateway/c/common/logging/magma_logging.hpp"
+
+namespace magma {
+
+namespace {
+
+/**
+ * Maps the keys of a merged request back to the index of the original request
+ * that carried them. The first request wins if several carry the same key.
+ */
+class RequestIndex {
+ public:
+  explicit RequestIndex(const std::vector<UpdateSessionRequest>& requests) {
+    for (size_t i = 0; i < requests.size(); ++i) {
+      for (const auto& update : requests[i].updates()) {
+        const auto& sid = update.common_context().sid().id();
+        credits_.emplace(
+            std::make_pair(update.session_id(), update.usage().charging_key()),
+            i);
+        add_session(update.session_id(), sid, i);
+      }
+      for (const auto& update : requests[i].usage_monitors()) {
+        monitors_.emplace(std::make_pair(update.session_id(),
+                                         update.update().monitoring_key()),
+                          i);
+        add_session(update.session_id(), update.sid(), i);
+      }
+    }
+  }
+
+  size_t find_credit(const CreditUpdateResponse& credit) const {
+    auto it = credits_.find(
+        std::make_pair(credit.session_id(), credit.charging_key()));
+    if (it != credits_.end()) return it->second;
+    return find_session(credit.session_id(), credit.sid());
+  }
+
+  size_t find_monitor(const UsageMonitoringUpdateResponse& monitor) const {
+    auto it = monitors_.find(std::make_pair(monitor.session_id(),
+                                            monitor.credit().monitoring_key()));
+    if (it != monitors_.end()) return it->second;
+    return find_session(monitor.session_id(), monitor.sid());
+  }
+
+ private:
+  void add_session(const std::string& session_id, const std::string& sid,
+                   size_t request_index) {
+    by_session_.emplace(session_id, request_index);
+    by_sid_.emplace(sid, request_index);
+  }
+
+  size_t find_session(const std::string& session_id,
+                      const std::string& sid) const {
+    auto it = by_session_.find(session_id);
+    if (it != by_session_.end()) return it->second;
+    it = by_sid_.find(sid);
+    if (it != by_sid_.end()) return it->second;
+
+    MLOG(MWARNING) << "UpdateSession response for " << session_id
+                   << " does not match any batched request";
+    return 0;
+  }
+
+  std::map<std::pair<std::string, uint32_t>, size_t> credits_;
+  std::map<std::pair<std::string, std::string>, size_t> monitors_;
+  std::map<std::string, size_t> by_session_;
+  std::map<std::string, size_t> by_sid_;
+};
+
+uint32_t count_updates(const UpdateSessionRequest& request) {
+  return request.updates_size() + request.usage_monitors_size();
+}
+
+}  // namespace
+
+UpdateSessionBatcher::UpdateSessionBatcher(folly::EventBase* base,
+                                           UpdateSessionBatchConfig config,
+                                           SendFn send)
+    : base_(base), config_(config), send_(std::move(send)), generation_(0) {}
+
+void UpdateSessionBatcher::add(const UpdateSessionRequest& request,
+                               UpdateCallback callback) {
+  Batch full_batch;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pending_.requests.empty()) {
+      schedule_window(generation_);
+    }
+    pending_.requests.push_back(request);
+    pending_.callbacks.push_back(std::move(callback));
+    pending_.update_count += count_updates(request);
+    if (pending_.update_count < config_.max_updates) {
+      return;
+    }
+    full_batch = std::move(pending_);
+    pending_ = Batch();
+    ++generation_;
+  }
+  send_batch(std::move(full_batch));
+}
+
+void UpdateSessionBatcher::schedule_window(uint64_t generation) {
+  auto start_timer = [this, generation] {
+    base_->runAfterDelay(
+        [this, generation] { handle_window_expired(generation); },
+        config_.window_ms);
+  };
+  // Timers can only be scheduled from the event base thread
+  if (base_->isInEventBaseThread()) {
+    start_timer();
+  } else {
+    base_->runInEventBaseThread(start_timer);
+  }
+}
+
+void UpdateSessionBatcher::flush() {
+  Batch batch;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pending_.requests.empty()) {
+      return;
+    }
+    batch = std::move(pending_);
+    pending_ = Batch();
+    ++generation_;
+  }
+  send_batch(std::move(batch));
+}
+
+void UpdateSessionBatcher::handle_window_expired(uint64_t generation) {
+  Batch batch;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (generation != generation_ || pending_.requests.empty()) {
+      return;  // this batch was already sent
+    }
+    batch = std::move(pending_);
+    pending_ = Batch();
+    ++generation_;
+  }
+  send_batch(std::move(batch));
+}
+
+void UpdateSessionBatcher::send_batch(Batch batch) {
+  if (batch.requests.size() == 1) {
+    send_(batch.requests.front(), std::move(batch.callbacks.front()));
+    return;
+  }
+  MLOG(MDEBUG) << "Sending " << batch.update_count << " updates from "
+               << batch.requests.size()
+               << " reporting rounds in one UpdateSession request";
+  auto merged = merge_requests(batch.requests);
+  auto requests = std::make_shared<std::vector<UpdateSessionRequest>>(
+      std::move(batch.requests));
+  auto callbacks =
+      std::make_shared<std::vector<UpdateCallback>>(std::move(batch.callbacks));
+  send_(merged, [requests, callbacks](grpc::Status status,
+                                      UpdateSessionResponse response) {
+    if (!status.ok()) {
+      for (auto& callback : *callbacks) {
+        callback(status, UpdateSessionResponse());
+      }
+      return;
+    }
+    auto responses = split_response(*requests, response);
+    for (size_t i = 0; i < callbacks->size(); ++i) {
+      (*callbacks)[i](status, std::move(responses[i]));
+    }
+  });
+}
+
+UpdateSessionRequest UpdateSessionBatcher::merge_requests(
+    const std::vector<UpdateSessionRequest>& requests) {
+  UpdateSessionRequest merged;
+  for (const auto& request : requests) {
+    merged.MergeFrom(request);
+  }
+  return merged;
+}
+
+std::vector<UpdateSessionResponse> UpdateSessionBatcher::split_response(
+    const std::vector<UpdateSessionRequest>& requests,
+    const UpdateSessionResponse& response) {
+  std::vector<UpdateSessionResponse> responses(requests.size());
+  if (requests.empty()) {
+    return responses;
+  }
+
+  RequestIndex index(requests);
+  for (const auto& credit : response.responses()) {
+    responses[index.find_credit(credit)].add_responses()->CopyFrom(credit);
+  }
+  for (const auto& monitor : response.usage_monitor_responses()) {
+    responses[index.find_monitor(monitor)]
+        .add_usage_monitor_responses()
+        ->CopyFrom(monitor);
+  }
+  return responses;
+}
+
+}  // namespace magma
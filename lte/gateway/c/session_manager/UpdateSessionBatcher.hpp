@@ -0,0 +1,116 @@
+/**
+ * Copyright 2020 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <grpcpp/impl/codegen/status.h>
+#include <lte/protos/session_manager.pb.h>
+#include <stdint.h>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace folly {
+class EventBase;
+}  // namespace folly
+
+namespace magma {
+using namespace lte;
+
+struct UpdateSessionBatchConfig {
+  // A batch is sent as soon as it holds this many credit and monitor updates
+  uint32_t max_updates = 0;
+  // Maximum time in ms the first update of a batch waits for others to join
+  uint32_t window_ms = 0;
+
+  bool is_enabled() const { return max_updates > 1 && window_ms > 0; }
+};
+
+/**
+ * UpdateSessionBatcher coalesces the UpdateSessionRequests built by separate
+ * reporting rounds into a single UpdateSession call. A batch is sent once it
+ * holds max_updates updates or window_ms after its first request was added,
+ * whichever comes first.
+ *
+ * Each caller gets back only the part of the response that answers its own
+ * request, so per-request bookkeeping like the credit reporting flags works
+ * the same as if the request had been sent on its own. If the call fails,
+ * every caller receives the error status.
+ */
+class UpdateSessionBatcher {
+ public:
+  using UpdateCallback =
+      std::function<void(grpc::Status, UpdateSessionResponse)>;
+  using SendFn =
+      std::function<void(const UpdateSessionRequest&, UpdateCallback)>;
+
+  /**
+   * @param base event base the batch window timer runs on
+   * @param config batch size and time bounds
+   * @param send function used to send a (merged) request
+   */
+  UpdateSessionBatcher(folly::EventBase* base, UpdateSessionBatchConfig config,
+                       SendFn send);
+
+  /**
+   * Queue a request to be sent with the current batch. callback is called
+   * with the response to this request once the batch is answered.
+   */
+  void add(const UpdateSessionRequest& request, UpdateCallback callback);
+
+  /**
+   * Send the current batch right away, if there is one
+   */
+  void flush();
+
+  /**
+   * Concatenate the credit and monitor updates of all requests
+   */
+  static UpdateSessionRequest merge_requests(
+      const std::vector<UpdateSessionRequest>& requests);
+
+  /**
+   * Split the response to a merged request into one response per original
+   * request. Credit responses are matched on session ID and charging key and
+   * monitor responses on session ID and monitoring key. When the OCS/PCRF
+   * answers for a key that was not reported, the response goes to a request
+   * of the same session, then of the same subscriber, then to the first one.
+   */
+  static std::vector<UpdateSessionResponse> split_response(
+      const std::vector<UpdateSessionRequest>& requests,
+      const UpdateSessionResponse& response);
+
+ private:
+  struct Batch {
+    std::vector<UpdateSessionRequest> requests;
+    std::vector<UpdateCallback> callbacks;
+    uint32_t update_count = 0;
+  };
+
+  // Send a batch that was taken out of pending_. Called with mutex_ unlocked.
+  void send_batch(Batch batch);
+  // Start the window timer for the batch with the given generation
+  void schedule_window(uint64_t generation);
+  // Flush the batch with the given generation if it is still pending
+  void handle_window_expired(uint64_t generation);
+
+  folly::EventBase* base_;
+  UpdateSessionBatchConfig config_;
+  SendFn send_;
+  std::mutex mutex_;
+  Batch pending_;
+  // Incremented on every flush, so that the window timer of a batch that was
+  // already sent for its size does not flush the next one early
+  uint64_t generation_;
+};
+
+}  // namespace magma
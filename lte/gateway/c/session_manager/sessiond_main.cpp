@@ -59,6 +59,7 @@
 #include "lte/gateway/c/session_manager/SpgwServiceClient.hpp"
 #include "lte/gateway/c/session_manager/StatsPoller.hpp"
 #include "lte/gateway/c/session_manager/UpfMsgManageHandler.hpp"
+#include "orc8r/gateway/c/common/async_grpc/GRPCReceiver.hpp"
 #include "orc8r/gateway/c/common/config/MConfigLoader.hpp"
 #include "orc8r/gateway/c/common/config/ServiceConfigLoader.hpp"
 #include "orc8r/gateway/c/common/eventd/EventdClient.hpp"
@@ -267,7 +268,8 @@ int main(int argc, char* argv[]) {
   folly::EventBase* evb = folly::EventBaseManager::get()->getEventBase();
 
   // Start off a thread to periodically load policy definitions from Redis into
-  // RuleStore
+  // RuleStore. The next rule snapshot is built on this thread and swapped in
+  // atomically, so enforcement never waits on a sync.
   auto rule_store = std::make_shared<magma::StaticRuleStore>();
   magma::PolicyLoader policy_loader;
   std::thread policy_loader_thread([&]() {
@@ -279,19 +281,45 @@ int main(int argc, char* argv[]) {
     policy_loader.stop();
   });
 
+  // With response threads configured, the gRPC clients share a pool of threads
+  // draining their responses instead of each running its own loop, and the
+  // client response loops below return right away.
+  std::shared_ptr<magma::CompletionQueuePool> response_pool;
+  if (config["grpc_response_threads"].IsDefined() &&
+      config["grpc_response_threads"].as<uint32_t>() > 0) {
+    response_pool = std::make_shared<magma::CompletionQueuePool>(
+        config["grpc_response_threads"].as<uint32_t>());
+    magma::CompletionQueuePool::set_shared(response_pool);
+  }
+
   auto pipelined_client = std::make_shared<magma::AsyncPipelinedClient>();
+  pipelined_client->set_client_name("pipelined");
+  if (response_pool) {
+    // Stats and flow responses update sessions, which belong to the main loop
+    pipelined_client->set_response_executor(
+        [evb](std::function<void()> handle) {
+          evb->runInEventBaseThread(std::move(handle));
+        });
+  }
+  if (config["batch_pipelined_flow_updates"].IsDefined() &&
+      config["batch_pipelined_flow_updates"].as<bool>()) {
+    MLOG(MINFO) << "Batching flow updates to PipelineD";
+    pipelined_client->enable_flow_batching(evb);
+  }
   std::thread pipelined_response_handling_thread([&]() {
     MLOG(MINFO) << "Started PipelineD response thread";
     pipelined_client->rpc_response_loop();
   });
 
   auto directoryd_client = std::make_shared<magma::AsyncDirectorydClient>();
+  directoryd_client->set_client_name("directoryd");
   std::thread directoryd_response_handling_thread([&]() {
     MLOG(MINFO) << "Started DirectoryD response thread";
     directoryd_client->rpc_response_loop();
   });
 
   auto& eventd_client = magma::AsyncEventdClient::getInstance();
+  eventd_client.set_client_name("eventd");
   auto events_reporter =
       std::make_shared<magma::lte::EventsReporterImpl>(eventd_client);
   std::thread eventd_response_handling_thread([&]() {
@@ -300,6 +328,7 @@ int main(int argc, char* argv[]) {
   });
 
   auto mobilityd_client = std::make_shared<magma::AsyncMobilitydClient>();
+  mobilityd_client->set_client_name("mobilityd");
   std::thread mobilityd_response_handling_thread([&]() {
     MLOG(MINFO) << "Started MobilityD response thread";
     mobilityd_client->rpc_response_loop();
@@ -312,6 +341,7 @@ int main(int argc, char* argv[]) {
   if (enable_5g_features) {
     // AMF service client to handle response message
     amf_srv_client = std::make_shared<magma::AsyncAmfServiceClient>();
+    amf_srv_client->set_client_name("amf");
     spgw_client = nullptr;
     aaa_client = nullptr;
   }
@@ -319,6 +349,7 @@ int main(int argc, char* argv[]) {
   std::thread access_response_handling_thread;
   if (config["support_carrier_wifi"].as<bool>()) {
     aaa_client = std::make_shared<aaa::AsyncAAAClient>();
+    aaa_client->set_client_name("aaa");
     access_response_handling_thread = std::thread([&]() {
       MLOG(MINFO) << "Started AAA Client response thread";
       aaa_client->rpc_response_loop();
@@ -327,6 +358,7 @@ int main(int argc, char* argv[]) {
     amf_srv_client = nullptr;
   } else {
     spgw_client = std::make_shared<magma::AsyncSpgwServiceClient>();
+    spgw_client->set_client_name("spgw");
     access_response_handling_thread = std::thread([&]() {
       MLOG(MINFO) << "Started SPGW response thread";
       spgw_client->rpc_response_loop();
@@ -337,8 +369,23 @@ int main(int argc, char* argv[]) {
   // Setup SessionReporter which talks to the policy component
   // (FeG+PCRF/PolicyDB).
   bool gx_gy_relay_enabled = mconfig.gx_gy_relay_enabled();
+  magma::UpdateSessionBatchConfig update_batch_config;
+  if (config["update_session_batch_max_updates"].IsDefined()) {
+    update_batch_config.max_updates =
+        config["update_session_batch_max_updates"].as<uint32_t>();
+  }
+  if (config["update_session_batch_window_ms"].IsDefined()) {
+    update_batch_config.window_ms =
+        config["update_session_batch_window_ms"].as<uint32_t>();
+  }
   auto reporter = std::make_shared<magma::SessionReporterImpl>(
-      evb, get_controller_channel(config, gx_gy_relay_enabled));
+      evb, get_controller_channel(config, gx_gy_relay_enabled),
+      update_batch_config);
+  reporter->set_client_name("session_controller");
+  if (response_pool) {
+    magma::CompletionQueuePool::set_shared(nullptr);
+    response_pool->start();
+  }
   std::thread policy_response_handler([&]() {
     MLOG(MINFO) << "Started reporter thread";
     reporter->rpc_response_loop();
@@ -554,6 +601,9 @@ int main(int argc, char* argv[]) {
     free(conv_upf_message_service);
   }
   mobilityd_response_handling_thread.join();
+  if (response_pool) {
+    response_pool->stop();
+  }
   delete session_store;
 
   shutdown_sentry();
@@ -0,0 +1,242 @@
+/**
+ * Copyright 2020 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <benchmark/benchmark.h>
+#include <lte/protos/pipelined.pb.h>
+#include <lte/protos/session_manager.pb.h>
+#include <malloc.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "lte/gateway/c/session_manager/LocalEnforcer.hpp"
+#include "lte/gateway/c/session_manager/MeteringReporter.hpp"
+#include "lte/gateway/c/session_manager/RuleStore.hpp"
+#include "lte/gateway/c/session_manager/SessionState.hpp"
+#include "lte/gateway/c/session_manager/SessionStore.hpp"
+#include "lte/gateway/c/session_manager/ShardTracker.hpp"
+#include "lte/gateway/c/session_manager/StoreClient.hpp"
+#include "lte/gateway/c/session_manager/test/ProtobufCreators.hpp"
+#include "lte/gateway/c/session_manager/test/SessiondMocks.hpp"
+
+/**
+ * Benchmarks for sessiond hot paths at large subscriber populations.
+ *
+ * Every benchmark takes (number of subscribers, PDN sessions per subscriber)
+ * as arguments. Run with --benchmark_format=json to track results between
+ * releases.
+ */
+namespace magma {
+
+namespace {
+
+const char* STATIC_RULE_ID = "bench_rule";
+const char* MONITORING_KEY = "m1";
+const uint32_t RATING_GROUP = 1;
+const uint64_t GRANTED_VOLUME = 1024 * 1024 * 1024;
+
+std::string bench_imsi(int64_t subscriber) {
+  auto digits = std::to_string(subscriber);
+  return "IMSI" + std::string(15 - digits.size(), '0') + digits;
+}
+
+std::string bench_ipv4(int64_t subscriber, int64_t pdn) {
+  // 10.<pdn>.<subscriber / 256>.<subscriber % 256> is unique for up to 64k
+  // subscribers per PDN
+  return "10." + std::to_string(pdn) + "." +
+         std::to_string((subscriber / 256) % 256) + "." +
+         std::to_string(subscriber % 256);
+}
+
+/**
+ * Sessions for a population of LTE subscribers with one or more PDN sessions
+ * each, written through a SessionStore, plus one RuleRecord per session as
+ * PipelineD would report them.
+ */
+class SessionPopulation {
+ public:
+  SessionPopulation(int64_t subscribers, int64_t pdns)
+      : rule_store(std::make_shared<StaticRuleStore>()),
+        session_store(std::make_shared<SessionStore>(
+            rule_store, std::make_shared<MeteringReporter>())) {
+    rule_store->insert_rule(
+        create_policy_rule(STATIC_RULE_ID, MONITORING_KEY, RATING_GROUP));
+    for (int64_t sub = 0; sub < subscribers; ++sub) {
+      const std::string imsi = bench_imsi(sub);
+      SessionVector sessions;
+      for (int64_t pdn = 0; pdn < pdns; ++pdn) {
+        const std::string ipv4 = bench_ipv4(sub, pdn);
+        sessions.push_back(make_session(imsi, pdn, ipv4));
+
+        RuleRecord* record = records.mutable_records()->Add();
+        create_rule_record(imsi, ipv4, STATIC_RULE_ID, 1000, 1000, record);
+      }
+      session_store->create_sessions(imsi, std::move(sessions));
+    }
+  }
+
+  std::unique_ptr<SessionState> make_session(const std::string& imsi,
+                                             int64_t pdn,
+                                             const std::string& ipv4) {
+    Teids teids;
+    teids.set_agw_teid(pdn + 1);
+    teids.set_enb_teid(pdn + 1);
+    SessionConfig cfg;
+    cfg.common_context = build_common_context(
+        imsi, ipv4, "", teids, "apn" + std::to_string(pdn), "", TGPP_LTE);
+    QosInformationRequest qos_info;
+    cfg.rat_specific_context.mutable_lte_context()->CopyFrom(
+        build_lte_context("", "", "", "", "", pdn + 5, &qos_info));
+    const std::string session_id = imsi + "-" + std::to_string(pdn);
+    auto session =
+        std::make_unique<SessionState>(session_id, cfg, *rule_store, 0);
+    session->set_fsm_state(SESSION_ACTIVE, nullptr);
+    session->activate_static_rule(STATIC_RULE_ID, RuleLifetime(), nullptr);
+
+    // One charging credit and one monitor the rule's usage is counted against
+    CreditUpdateResponse credit;
+    create_credit_update_response(imsi, session_id, RATING_GROUP,
+                                  GRANTED_VOLUME, &credit);
+    session->receive_charging_credit(credit, nullptr);
+    UsageMonitoringUpdateResponse monitor;
+    create_monitor_update_response(imsi, session_id, MONITORING_KEY,
+                                   MonitoringLevel::PCC_RULE_LEVEL,
+                                   GRANTED_VOLUME, &monitor);
+    session->receive_monitor(monitor, nullptr);
+    return session;
+  }
+
+  std::shared_ptr<StaticRuleStore> rule_store;
+  std::shared_ptr<SessionStore> session_store;
+  RuleRecordTable records;
+};
+
+std::unique_ptr<LocalEnforcer> make_enforcer(SessionPopulation& population) {
+  return std::make_unique<LocalEnforcer>(
+      std::make_shared<MockSessionReporter>(), population.rule_store,
+      *population.session_store, std::make_shared<MockPipelinedClient>(),
+      std::make_shared<MockEventsReporter>(),
+      std::make_shared<MockSpgwServiceClient>(),
+      std::make_shared<MockAAAClient>(), std::make_shared<ShardTracker>(), 0,
+      0, get_default_mconfig());
+}
+
+}  // namespace
+
+static void BM_AggregateRecords(benchmark::State& state) {
+  SessionPopulation population(state.range(0), state.range(1));
+  auto enforcer = make_enforcer(population);
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto session_map = population.session_store->read_all_sessions();
+    auto session_update =
+        SessionStore::get_default_session_update(session_map);
+    state.ResumeTiming();
+    enforcer->aggregate_records(session_map, population.records,
+                                session_update);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          population.records.records_size());
+}
+
+// Lookups against a store that wrote the sessions and has them indexed
+static void BM_FindSessionIndexed(benchmark::State& state) {
+  SessionPopulation population(state.range(0), state.range(1));
+  auto session_map = population.session_store->read_all_sessions();
+  for (auto _ : state) {
+    for (const RuleRecord& record : population.records.records()) {
+      SessionSearchCriteria criteria(
+          record.sid(), IMSI_AND_UE_IPV4_OR_IPV6_OR_UPF_TEID, record.ue_ipv4(),
+          record.ue_ipv6(), record.teid());
+      benchmark::DoNotOptimize(
+          population.session_store->find_session(session_map, criteria));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          population.records.records_size());
+}
+
+// Same lookups through a store that has no index for the sessions, which
+// exercises the linear search
+static void BM_FindSessionLinear(benchmark::State& state) {
+  SessionPopulation population(state.range(0), state.range(1));
+  auto session_map = population.session_store->read_all_sessions();
+  SessionStore unindexed_store(population.rule_store,
+                               std::make_shared<MeteringReporter>());
+  for (auto _ : state) {
+    for (const RuleRecord& record : population.records.records()) {
+      SessionSearchCriteria criteria(
+          record.sid(), IMSI_AND_UE_IPV4_OR_IPV6_OR_UPF_TEID, record.ue_ipv4(),
+          record.ue_ipv6(), record.teid());
+      benchmark::DoNotOptimize(
+          unindexed_store.find_session(session_map, criteria));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          population.records.records_size());
+}
+
+// Heap memory held by the sessions of a population, reported per session
+static void BM_SessionMemory(benchmark::State& state) {
+  for (auto _ : state) {
+    size_t before = mallinfo().uordblks;
+    SessionPopulation population(state.range(0), state.range(1));
+    auto session_map = population.session_store->read_all_sessions();
+    size_t after = mallinfo().uordblks;
+    state.counters["bytes_per_session"] =
+        static_cast<double>(after - before) /
+        population.records.records_size();
+  }
+}
+
+// The per record usage accounting of aggregate_records on its own, without
+// the session lookup
+static void BM_AddRuleUsage(benchmark::State& state) {
+  SessionPopulation population(state.range(0), state.range(1));
+  auto session_map = population.session_store->read_all_sessions();
+  auto session_update = SessionStore::get_default_session_update(session_map);
+  uint64_t used = 0;
+  for (auto _ : state) {
+    // Usage is cumulative, so every round reports a little more
+    used += 1000;
+    for (auto& it : session_map) {
+      for (auto& session : it.second) {
+        auto& uc = session_update[it.first][session->get_session_id()];
+        session->add_rule_usage(STATIC_RULE_ID, 1, used, used, 0, 0, &uc);
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          population.records.records_size());
+}
+
+static void population_sizes(benchmark::internal::Benchmark* b) {
+  b->Args({1000, 1})
+      ->Args({1000, 4})
+      ->Args({10000, 1})
+      ->Args({10000, 4})
+      ->Args({10000, 11})
+      ->Args({50000, 1})
+      ->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK(BM_AggregateRecords)->Apply(population_sizes);
+BENCHMARK(BM_FindSessionIndexed)->Apply(population_sizes);
+BENCHMARK(BM_FindSessionLinear)->Apply(population_sizes);
+BENCHMARK(BM_SessionMemory)->Apply(population_sizes)->Iterations(1);
+BENCHMARK(BM_AddRuleUsage)->Apply(population_sizes);
+
+}  // namespace magma
+
+BENCHMARK_MAIN();
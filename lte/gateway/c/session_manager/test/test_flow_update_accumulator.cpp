@@ -0,0 +1,137 @@
+/**
+ * Copyright 2020 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <grpcpp/impl/codegen/status.h>
+#include <gtest/gtest.h>
+#include <lte/protos/pipelined.pb.h>
+#include <string>
+#include <vector>
+
+#include "lte/gateway/c/session_manager/FlowUpdateAccumulator.hpp"
+#include "lte/gateway/c/session_manager/test/Consts.hpp"
+
+using grpc::Status;
+using ::testing::Test;
+
+namespace magma {
+
+class FlowUpdateAccumulatorTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() { callback_count = 0; }
+
+  ActivateFlowsRequest make_activate(const std::string& imsi,
+                                     const std::string& ip,
+                                     const std::vector<std::string>& rules) {
+    ActivateFlowsRequest request;
+    request.mutable_sid()->set_id(imsi);
+    request.set_ip_addr(ip);
+    request.mutable_request_origin()->set_type(RequestOriginType::GX);
+    for (const auto& rule_id : rules) {
+      request.add_policies()->mutable_rule()->set_id(rule_id);
+    }
+    return request;
+  }
+
+  DeactivateFlowsRequest make_deactivate(
+      const std::string& imsi, const std::string& ip,
+      const std::vector<std::string>& rules) {
+    DeactivateFlowsRequest request;
+    request.mutable_sid()->set_id(imsi);
+    request.set_ip_addr(ip);
+    request.mutable_request_origin()->set_type(RequestOriginType::GX);
+    for (const auto& rule_id : rules) {
+      request.add_policies()->set_rule_id(rule_id);
+    }
+    return request;
+  }
+
+  FlowUpdateAccumulator::ActivateCallback counting_callback() {
+    return [this](Status status, ActivateFlowsResult result) {
+      callback_count++;
+    };
+  }
+
+ protected:
+  FlowUpdateAccumulator accumulator;
+  int callback_count;
+};
+
+TEST_F(FlowUpdateAccumulatorTest, test_merge_by_session) {
+  accumulator.add_activate(make_activate(IMSI1, IP1, {"rule1"}),
+                           counting_callback());
+  accumulator.add_activate(make_activate(IMSI2, IP2, {"rule1"}),
+                           counting_callback());
+  accumulator.add_activate(make_activate(IMSI1, IP1, {"rule2", "rule1"}),
+                           counting_callback());
+  EXPECT_FALSE(accumulator.empty());
+
+  auto batch = accumulator.take_batch();
+  EXPECT_TRUE(accumulator.empty());
+  // IMSI1's second activation is merged into its first one
+  ASSERT_EQ(batch.request.updates_size(), 2);
+  const auto& merged = batch.request.updates(0).activate();
+  EXPECT_EQ(merged.sid().id(), IMSI1);
+  ASSERT_EQ(merged.policies_size(), 2);
+  EXPECT_EQ(merged.policies(0).rule().id(), "rule1");
+  EXPECT_EQ(merged.policies(1).rule().id(), "rule2");
+  EXPECT_EQ(batch.request.updates(1).activate().sid().id(), IMSI2);
+
+  ASSERT_EQ(batch.activate_callbacks.size(), 2);
+  EXPECT_EQ(batch.activate_callbacks[0].size(), 2);
+  EXPECT_EQ(batch.activate_callbacks[1].size(), 1);
+  EXPECT_TRUE(batch.cancelled_callbacks.empty());
+}
+
+TEST_F(FlowUpdateAccumulatorTest, test_deactivation_cancels_activation) {
+  accumulator.add_activate(make_activate(IMSI1, IP1, {"rule1", "rule2"}),
+                           counting_callback());
+  accumulator.add_activate(make_activate(IMSI2, IP2, {"rule1"}),
+                           counting_callback());
+  accumulator.add_deactivate(make_deactivate(IMSI1, IP1, {"rule1"}));
+  accumulator.add_deactivate(make_deactivate(IMSI2, IP2, {"rule1"}));
+
+  auto batch = accumulator.take_batch();
+  // IMSI1 keeps rule2 and IMSI2's activation is dropped entirely, but both
+  // deactivations are still sent, in order
+  ASSERT_EQ(batch.request.updates_size(), 3);
+  const auto& activate = batch.request.updates(0).activate();
+  ASSERT_EQ(activate.policies_size(), 1);
+  EXPECT_EQ(activate.policies(0).rule().id(), "rule2");
+  EXPECT_EQ(batch.request.updates(1).deactivate().sid().id(), IMSI1);
+  EXPECT_EQ(batch.request.updates(2).deactivate().sid().id(), IMSI2);
+
+  ASSERT_EQ(batch.activate_callbacks.size(), 1);
+  ASSERT_EQ(batch.cancelled_callbacks.size(), 1);
+  batch.cancelled_callbacks[0](Status::OK, ActivateFlowsResult());
+  EXPECT_EQ(callback_count, 1);
+}
+
+TEST_F(FlowUpdateAccumulatorTest, test_remove_all_is_not_merged) {
+  accumulator.add_activate(make_activate(IMSI1, IP1, {}),
+                           counting_callback());
+  accumulator.add_deactivate(make_deactivate(IMSI1, IP1, {"rule1"}));
+  accumulator.add_deactivate(make_deactivate(IMSI1, IP1, {}));
+  accumulator.add_deactivate(make_deactivate(IMSI1, IP1, {"rule2"}));
+  accumulator.add_deactivate(make_deactivate(IMSI1, IP1, {"rule3"}));
+
+  auto batch = accumulator.take_batch();
+  // An activation without rules sets up the default flows and is kept
+  ASSERT_EQ(batch.request.updates_size(), 4);
+  EXPECT_TRUE(batch.request.updates(0).has_activate());
+  EXPECT_EQ(batch.request.updates(1).deactivate().policies_size(), 1);
+  EXPECT_EQ(batch.request.updates(2).deactivate().policies_size(), 0);
+  // Rule deactivations after the remove-all are merged with each other only
+  EXPECT_EQ(batch.request.updates(3).deactivate().policies_size(), 2);
+  EXPECT_TRUE(batch.cancelled_callbacks.empty());
+}
+
+}  // namespace magma
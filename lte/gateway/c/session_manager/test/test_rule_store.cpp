@@ -0,0 +1,128 @@
+/**
+ * Copyright 2020 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <lte/protos/policydb.pb.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "lte/gateway/c/session_manager/CreditKey.hpp"
+#include "lte/gateway/c/session_manager/RuleStore.hpp"
+#include "lte/gateway/c/session_manager/test/ProtobufCreators.hpp"
+
+using ::testing::Test;
+
+namespace magma {
+
+class RuleStoreTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() { rule_store = std::make_shared<StaticRuleStore>(); }
+
+ protected:
+  std::shared_ptr<StaticRuleStore> rule_store;
+};
+
+TEST_F(RuleStoreTest, test_insert_and_remove) {
+  rule_store->insert_rule(create_policy_rule("rule1", "m1", 1));
+  rule_store->insert_rule(create_policy_rule("rule2", "", 1));
+
+  PolicyRule rule_out;
+  EXPECT_TRUE(rule_store->get_rule("rule1", &rule_out));
+  EXPECT_EQ(rule_out.monitoring_key(), "m1");
+  EXPECT_EQ(rule_store->monitored_rules_count(), 1);
+
+  std::vector<std::string> rule_ids;
+  EXPECT_TRUE(
+      rule_store->get_rule_ids_for_charging_key(CreditKey(1), rule_ids));
+  EXPECT_EQ(rule_ids.size(), 2);
+
+  EXPECT_TRUE(rule_store->remove_rule("rule1", nullptr));
+  EXPECT_FALSE(rule_store->get_rule("rule1", nullptr));
+  EXPECT_EQ(rule_store->monitored_rules_count(), 0);
+
+  std::vector<PolicyRulePtr> rules;
+  EXPECT_TRUE(
+      rule_store->get_rule_ptrs_for_charging_key(CreditKey(1), rules));
+  EXPECT_EQ(rules.size(), 1);
+  EXPECT_EQ(rules[0]->id(), "rule2");
+}
+
+TEST_F(RuleStoreTest, test_reinsert_replaces_key_mappings) {
+  rule_store->insert_rule(create_policy_rule("rule1", "m1", 1));
+  rule_store->insert_rule(create_policy_rule("rule1", "", 2));
+
+  std::vector<std::string> rule_ids;
+  EXPECT_TRUE(
+      rule_store->get_rule_ids_for_charging_key(CreditKey(1), rule_ids));
+  EXPECT_EQ(rule_ids.size(), 0);
+  EXPECT_TRUE(
+      rule_store->get_rule_ids_for_charging_key(CreditKey(2), rule_ids));
+  EXPECT_EQ(rule_ids.size(), 1);
+  EXPECT_EQ(rule_store->monitored_rules_count(), 0);
+}
+
+TEST_F(RuleStoreTest, test_handles_survive_sync) {
+  rule_store->insert_rule(create_policy_rule("rule1", "m1", 1));
+  auto snapshot = rule_store->get_snapshot();
+  auto rule_p = rule_store->get_rule_ptr("rule1");
+  ASSERT_NE(rule_p, nullptr);
+
+  rule_store->sync_rules({create_policy_rule("rule2", "m2", 2)});
+
+  // Readers keep the view they started with
+  EXPECT_EQ(rule_p->monitoring_key(), "m1");
+  EXPECT_EQ(snapshot->rules_by_rule_id.count("rule1"), 1);
+  EXPECT_EQ(snapshot->rules_by_rule_id.count("rule2"), 0);
+
+  // While new readers see the synced rules
+  EXPECT_EQ(rule_store->get_rule_ptr("rule1"), nullptr);
+  EXPECT_NE(rule_store->get_rule_ptr("rule2"), nullptr);
+}
+
+TEST_F(RuleStoreTest, test_publish_prebuilt_snapshot) {
+  std::vector<PolicyRule> rules{create_policy_rule("rule1", "m1", 1),
+                                create_policy_rule("rule2", "m2", 0)};
+  auto snapshot = PolicyRuleBiMap::build_snapshot(rules);
+  EXPECT_FALSE(rule_store->get_rule("rule1", nullptr));
+
+  rule_store->publish_snapshot(snapshot);
+  std::vector<PolicyRulePtr> rules_out;
+  EXPECT_TRUE(
+      rule_store->get_rule_ptrs_by_ids({"rule1", "rule2"}, rules_out));
+  EXPECT_EQ(rules_out.size(), 2);
+  EXPECT_FALSE(rule_store->get_rule_ptrs_by_ids({"rule3"}, rules_out));
+  EXPECT_EQ(rule_store->monitored_rules_count(), 2);
+}
+
+TEST_F(RuleStoreTest, test_usage_keys) {
+  rule_store->insert_rule(create_policy_rule("rule1", "m1", 1));
+  rule_store->insert_rule(create_policy_rule("rule2", "m1", 0));
+  rule_store->insert_rule(create_policy_rule("rule3", "", 2));
+
+  RuleUsageKeys keys1, keys2, keys3;
+  EXPECT_TRUE(rule_store->get_usage_keys_for_rule_id("rule1", &keys1));
+  EXPECT_TRUE(rule_store->get_usage_keys_for_rule_id("rule2", &keys2));
+  EXPECT_TRUE(rule_store->get_usage_keys_for_rule_id("rule3", &keys3));
+  EXPECT_FALSE(rule_store->get_usage_keys_for_rule_id("rule4", &keys3));
+
+  EXPECT_TRUE(keys1.tracks_charging_key);
+  EXPECT_EQ(keys1.charging_key.rating_group, 1);
+  EXPECT_TRUE(keys1.tracks_monitoring_key);
+  EXPECT_EQ(keys1.monitoring_key, "m1");
+  EXPECT_EQ(keys2.monitoring_key, "m1");
+  EXPECT_FALSE(keys2.tracks_charging_key);
+  EXPECT_TRUE(keys3.tracks_charging_key);
+  EXPECT_FALSE(keys3.tracks_monitoring_key);
+}
+
+}  // namespace magma
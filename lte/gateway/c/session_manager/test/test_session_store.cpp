@@ -645,4 +645,69 @@ TEST_F(SessionStoreTest, test_get_session) {
   auto optional_it7 = session_store->find_session(session_map, id7_success_sid);
   EXPECT_FALSE(optional_it7);
 }
+
+TEST_F(SessionStoreTest, test_find_session_indexed) {
+  Teids teid3;
+  teid3.set_enb_teid(TEID_3_DL);
+  teid3.set_agw_teid(TEID_3_UL);
+  Teids teid4;
+  teid4.set_enb_teid(TEID_4_DL);
+  teid4.set_agw_teid(TEID_4_UL);
+
+  // 1) Write two LTE PDN sessions for one subscriber through the store so
+  // that they get indexed. Session 4 has no IPv6 address.
+  auto sessions = SessionVector{};
+  sessions.push_back(
+      get_lte_session(IMSI3, SESSION_ID_3, IP3, IPv6_3, teid3, "APN1"));
+  sessions.push_back(
+      get_lte_session(IMSI3, SESSION_ID_4, IP4, "", teid4, "APN2"));
+  session_store->create_sessions(IMSI3, std::move(sessions));
+
+  // 2) Lookups on a freshly read map return the same session a linear search
+  // would
+  auto session_map = session_store->read_sessions({IMSI3});
+  SessionSearchCriteria by_id(IMSI3, IMSI_AND_SESSION_ID, SESSION_ID_4);
+  auto session_it = session_store->find_session(session_map, by_id);
+  ASSERT_TRUE(session_it);
+  EXPECT_EQ((**session_it)->get_session_id(), SESSION_ID_4);
+
+  SessionSearchCriteria by_ipv4(IMSI3, IMSI_AND_UE_IPV4_OR_IPV6_OR_UPF_TEID,
+                                IP4, IPv6_5, 0);
+  session_it = session_store->find_session(session_map, by_ipv4);
+  ASSERT_TRUE(session_it);
+  EXPECT_EQ((**session_it)->get_session_id(), SESSION_ID_4);
+
+  SessionSearchCriteria by_ipv6(IMSI3, IMSI_AND_UE_IPV4_OR_IPV6, IPv6_3);
+  session_it = session_store->find_session(session_map, by_ipv6);
+  ASSERT_TRUE(session_it);
+  EXPECT_EQ((**session_it)->get_session_id(), SESSION_ID_3);
+
+  SessionSearchCriteria not_found(IMSI3, IMSI_AND_UE_IPV4, IP1);
+  EXPECT_FALSE(session_store->find_session(session_map, not_found));
+
+  // 3) End the first session. The index follows the write, so the remaining
+  // session is still found at its new position.
+  auto session_update = SessionStore::get_default_session_update(session_map);
+  session_update[IMSI3][SESSION_ID_3].is_session_ended = true;
+  EXPECT_TRUE(session_store->update_sessions(session_update));
+
+  session_map = session_store->read_sessions({IMSI3});
+  EXPECT_EQ(session_map[IMSI3].size(), 1);
+  session_it = session_store->find_session(session_map, by_ipv4);
+  ASSERT_TRUE(session_it);
+  EXPECT_EQ((**session_it)->get_session_id(), SESSION_ID_4);
+  EXPECT_FALSE(session_store->find_session(session_map, by_ipv6));
+
+  // 4) A map modified in memory after the read is still searched correctly
+  session_map[IMSI3].insert(
+      session_map[IMSI3].begin(),
+      get_lte_session(IMSI3, SESSION_ID_1, IP1, IPv6_1, teid3, "APN3"));
+  session_it = session_store->find_session(session_map, by_ipv4);
+  ASSERT_TRUE(session_it);
+  EXPECT_EQ((**session_it)->get_session_id(), SESSION_ID_4);
+  SessionSearchCriteria new_session(IMSI3, IMSI_AND_UE_IPV4, IP1);
+  session_it = session_store->find_session(session_map, new_session);
+  ASSERT_TRUE(session_it);
+  EXPECT_EQ((**session_it)->get_session_id(), SESSION_ID_1);
+}
 }  // namespace magma
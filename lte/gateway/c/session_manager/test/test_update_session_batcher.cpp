@@ -0,0 +1,169 @@
+/**
+ * Copyright 2020 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/io/async/EventBase.h>
+#include <grpcpp/impl/codegen/status.h>
+#include <gtest/gtest.h>
+#include <lte/protos/session_manager.pb.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "lte/gateway/c/session_manager/UpdateSessionBatcher.hpp"
+#include "lte/gateway/c/session_manager/test/Consts.hpp"
+#include "lte/gateway/c/session_manager/test/ProtobufCreators.hpp"
+
+using grpc::Status;
+using ::testing::Test;
+
+namespace magma {
+
+class UpdateSessionBatcherTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    evb = std::make_unique<folly::EventBase>();
+    sent_requests.clear();
+    sent_callbacks.clear();
+  }
+
+  std::unique_ptr<UpdateSessionBatcher> make_batcher(uint32_t max_updates,
+                                                     uint32_t window_ms) {
+    UpdateSessionBatchConfig config;
+    config.max_updates = max_updates;
+    config.window_ms = window_ms;
+    return std::make_unique<UpdateSessionBatcher>(
+        evb.get(), config,
+        [this](const UpdateSessionRequest& request,
+               UpdateSessionBatcher::UpdateCallback callback) {
+          sent_requests.push_back(request);
+          sent_callbacks.push_back(callback);
+        });
+  }
+
+  UpdateSessionRequest make_request(const std::string& imsi,
+                                    const std::string& session_id,
+                                    uint32_t charging_key,
+                                    const std::string& monitoring_key) {
+    UpdateSessionRequest request;
+    auto credit_update = request.add_updates();
+    create_usage_update(imsi, charging_key, 1024, 2048, CreditUsage::THRESHOLD,
+                        credit_update);
+    credit_update->set_session_id(session_id);
+    if (!monitoring_key.empty()) {
+      auto monitor_update = request.add_usage_monitors();
+      create_usage_monitoring_update_request(imsi, monitoring_key, 1024, 2048,
+                                             monitor_update);
+      monitor_update->set_sid(imsi);
+      monitor_update->set_session_id(session_id);
+    }
+    return request;
+  }
+
+ protected:
+  std::unique_ptr<folly::EventBase> evb;
+  std::vector<UpdateSessionRequest> sent_requests;
+  std::vector<UpdateSessionBatcher::UpdateCallback> sent_callbacks;
+};
+
+TEST_F(UpdateSessionBatcherTest, test_split_response) {
+  std::vector<UpdateSessionRequest> requests{
+      make_request(IMSI1, SESSION_ID_1, 1, "m1"),
+      make_request(IMSI2, SESSION_ID_2, 1, "")};
+
+  UpdateSessionResponse response;
+  create_credit_update_response(IMSI2, SESSION_ID_2, 1, 1000,
+                                response.add_responses());
+  create_credit_update_response(IMSI1, SESSION_ID_1, 1, 1000,
+                                response.add_responses());
+  create_monitor_update_response(IMSI1, SESSION_ID_1, "m1", SESSION_LEVEL,
+                                 1000, response.add_usage_monitor_responses());
+  // A monitor that was not reported goes to the request of its session
+  create_monitor_update_response(IMSI2, SESSION_ID_2, "m2", SESSION_LEVEL,
+                                 1000, response.add_usage_monitor_responses());
+
+  auto responses = UpdateSessionBatcher::split_response(requests, response);
+  ASSERT_EQ(responses.size(), 2);
+  ASSERT_EQ(responses[0].responses_size(), 1);
+  EXPECT_EQ(responses[0].responses(0).session_id(), SESSION_ID_1);
+  ASSERT_EQ(responses[0].usage_monitor_responses_size(), 1);
+  EXPECT_EQ(responses[0].usage_monitor_responses(0).credit().monitoring_key(),
+            "m1");
+  ASSERT_EQ(responses[1].responses_size(), 1);
+  EXPECT_EQ(responses[1].responses(0).session_id(), SESSION_ID_2);
+  ASSERT_EQ(responses[1].usage_monitor_responses_size(), 1);
+  EXPECT_EQ(responses[1].usage_monitor_responses(0).credit().monitoring_key(),
+            "m2");
+}
+
+TEST_F(UpdateSessionBatcherTest, test_flush_on_max_updates) {
+  auto batcher = make_batcher(3, 10000);
+  std::vector<UpdateSessionResponse> received(2);
+
+  // 2 updates, below the limit
+  batcher->add(make_request(IMSI1, SESSION_ID_1, 1, "m1"),
+               [&received](Status status, UpdateSessionResponse response) {
+                 EXPECT_TRUE(status.ok());
+                 received[0] = response;
+               });
+  EXPECT_EQ(sent_requests.size(), 0);
+
+  // 3 updates, sent as one request
+  batcher->add(make_request(IMSI2, SESSION_ID_2, 1, ""),
+               [&received](Status status, UpdateSessionResponse response) {
+                 EXPECT_TRUE(status.ok());
+                 received[1] = response;
+               });
+  ASSERT_EQ(sent_requests.size(), 1);
+  EXPECT_EQ(sent_requests[0].updates_size(), 2);
+  EXPECT_EQ(sent_requests[0].usage_monitors_size(), 1);
+
+  UpdateSessionResponse response;
+  create_credit_update_response(IMSI1, SESSION_ID_1, 1, 1000,
+                                response.add_responses());
+  create_credit_update_response(IMSI2, SESSION_ID_2, 1, 1000,
+                                response.add_responses());
+  sent_callbacks[0](Status::OK, response);
+  ASSERT_EQ(received[0].responses_size(), 1);
+  EXPECT_EQ(received[0].responses(0).sid(), IMSI1);
+  ASSERT_EQ(received[1].responses_size(), 1);
+  EXPECT_EQ(received[1].responses(0).sid(), IMSI2);
+
+  // Nothing left to send
+  batcher->flush();
+  EXPECT_EQ(sent_requests.size(), 1);
+}
+
+TEST_F(UpdateSessionBatcherTest, test_flush_on_window) {
+  auto batcher = make_batcher(100, 10);
+  int callback_count = 0;
+  auto callback = [&callback_count](Status status,
+                                    UpdateSessionResponse response) {
+    EXPECT_FALSE(status.ok());
+    callback_count++;
+  };
+  batcher->add(make_request(IMSI1, SESSION_ID_1, 1, "m1"), callback);
+  batcher->add(make_request(IMSI2, SESSION_ID_2, 1, "m2"), callback);
+  EXPECT_EQ(sent_requests.size(), 0);
+
+  // Runs until the window timer has fired
+  evb->loop();
+  ASSERT_EQ(sent_requests.size(), 1);
+  EXPECT_EQ(sent_requests[0].updates_size(), 2);
+  EXPECT_EQ(sent_requests[0].usage_monitors_size(), 2);
+
+  // A failure is reported to every request of the batch
+  sent_callbacks[0](Status(grpc::UNAVAILABLE, "unavailable"),
+                    UpdateSessionResponse());
+  EXPECT_EQ(callback_count, 2);
+}
+
+}  // namespace magma
@@ -33,6 +33,7 @@ from lte.protos.pipelined_pb2 import (
     DeactivateFlowsRequest,
     DeactivateFlowsResult,
     FlowResponse,
+    FlowUpdateBatchResult,
     OffendingIE,
     PdrState,
     RequestOriginType,
@@ -494,6 +495,66 @@ class PipelinedRpcServicer(pipelined_pb2_grpc.PipelinedServicer):
             if self._should_remove_from_gy(request):
                 self._deactivate_flows_gy(request, ipv6)
 
+    def UpdateFlowsBatch(self, request, context):
+        """
+        Activate and deactivate flows for many subscribers, in request order
+        """
+        self._log_grpc_payload(request)
+        if not self._service_manager.is_app_enabled(
+                EnforcementController.APP_NAME,
+        ):
+            context.set_code(grpc.StatusCode.UNAVAILABLE)
+            context.set_details('Service not enabled!')
+            return None
+
+        for controller in [
+            self._gy_app, self._enforcer_app,
+            self._enforcement_stats,
+        ]:
+            if not controller.is_controller_ready():
+                context.set_code(grpc.StatusCode.UNAVAILABLE)
+                context.set_details('Enforcement service not initialized!')
+                return FlowUpdateBatchResult()
+
+        fut = Future()  # type: Future[FlowUpdateBatchResult]
+        self._loop.call_soon_threadsafe(self._update_flows_batch, request, fut)
+        try:
+            return fut.result(timeout=self._call_timeout)
+        except concurrent.futures.TimeoutError:
+            logging.error(
+                "UpdateFlowsBatch request processing timed out",
+                extra=EXCLUDE_FROM_ERROR_MONITORING,
+            )
+            context.set_code(grpc.StatusCode.DEADLINE_EXCEEDED)
+            context.set_details('UpdateFlowsBatch processing timed out')
+            # Like ActivateFlows, remove the flows sessiond is going to retry
+            self._loop.call_soon_threadsafe(
+                self._rollback_flows_batch,
+                request,
+            )
+            return FlowUpdateBatchResult()
+
+    def _update_flows_batch(
+        self, request, fut: Future[FlowUpdateBatchResult],
+    ) -> None:
+        ret = FlowUpdateBatchResult()
+        for update in request.updates:
+            if update.HasField('activate'):
+                activate_fut = Future()  # type: Future[ActivateFlowsResult]
+                self._activate_flows(update.activate, activate_fut)
+                ret.activate_results.add().CopyFrom(activate_fut.result())
+            elif update.HasField('deactivate'):
+                self._deactivate_flows(update.deactivate)
+        fut.set_result(ret)
+
+    def _rollback_flows_batch(self, request) -> None:
+        """
+        Deactivate the flows activated by a batch, in reverse order
+        """
+        for update in reversed(request.updates):
+            if update.HasField('activate'):
+                self._deactivate_flows(get_deactivate_req(update.activate))
+
     def _should_remove_from_gy(self, request: DeactivateFlowsRequest) -> bool:
         is_gy = request.request_origin.type == RequestOriginType.GY
         is_wildcard = request.request_origin.type == RequestOriginType.WILDCARD
@@ -14,10 +14,15 @@ limitations under the License.
 import unittest
 from unittest.mock import MagicMock
 
+import grpc
+
 from lte.protos.mobilityd_pb2 import IPAddress
 from lte.protos.pipelined_pb2 import (
     ActivateFlowsRequest,
+    ActivateFlowsResult,
     DeactivateFlowsRequest,
+    FlowUpdate,
+    FlowUpdateBatch,
     RequestOriginType,
     SetupPolicyRequest,
     VersionedPolicy,
@@ -155,6 +160,54 @@ class RPCServicerTest(unittest.TestCase):
         assert self._enforcer_app.deactivate_rules.call_args.args[1].address == ip_addr.address
         assert self._enforcer_app.deactivate_rules.call_args.args[2] == ["rule1"]
 
+    def _flows_batch(self):
+        rule = PolicyRule(id="rule1", priority=100, flow_list=[])
+        activate = ActivateFlowsRequest(
+            sid=SubscriberID(id="imsi12345"),
+            ip_addr="1.2.3.4",
+            policies=[VersionedPolicy(rule=rule, version=1)],
+        )
+        deactivate = DeactivateFlowsRequest(
+            sid=SubscriberID(id="imsi67890"),
+            ip_addr="1.2.3.5",
+            policies=[VersionedPolicyID(rule_id="rule2", version=1)],
+        )
+        return FlowUpdateBatch(
+            updates=[
+                FlowUpdate(activate=activate),
+                FlowUpdate(deactivate=deactivate),
+            ],
+        )
+
+    def test_update_flows_batch_req(self):
+        self._enforcer_app.activate_rules.return_value = ActivateFlowsResult()
+        context = MagicMock()
+        res = self.pipelined_srv.UpdateFlowsBatch(self._flows_batch(), context)
+
+        # One result per activation, the updates are applied in order
+        assert len(res.activate_results) == 1
+        context.set_code.assert_not_called()
+        assert self._enforcer_app.activate_rules.call_args.args[0] == "imsi12345"
+        assert self._enforcer_app.deactivate_rules.call_args.args[0] == "imsi67890"
+        assert self._enforcer_app.deactivate_rules.call_args.args[2] == ["rule2"]
+
+    def test_update_flows_batch_timeout(self):
+        # The batch is never processed by the event loop
+        def call_soon_threadsafe(func, arg, fut=None):
+            if fut is None:
+                func(arg)
+        self._loop.call_soon_threadsafe.side_effect = call_soon_threadsafe
+        self.pipelined_srv._call_timeout = 0.01
+        context = MagicMock()
+        res = self.pipelined_srv.UpdateFlowsBatch(self._flows_batch(), context)
+
+        assert len(res.activate_results) == 0
+        context.set_code.assert_called_with(grpc.StatusCode.DEADLINE_EXCEEDED)
+        # The activation of the batch is rolled back, not the deactivation
+        self._enforcer_app.deactivate_rules.assert_called_once()
+        assert self._enforcer_app.deactivate_rules.call_args.args[0] == "imsi12345"
+        assert self._enforcer_app.deactivate_rules.call_args.args[2] == ["rule1"]
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -15,12 +15,147 @@
 
 #include <glog/logging.h>
 #include <ostream>  // for operator<<, char_traits
+#include <utility>  // for move
 
 #include "orc8r/gateway/c/common/logging/magma_logging.hpp"  // for MLOG
+#include "orc8r/gateway/c/common/service303/MetricsHelpers.hpp"
 
 namespace magma {
 
+namespace {
+const char* INFLIGHT_GAUGE = "grpc_client_inflight_requests";
+const char* LATENCY_HISTOGRAM = "grpc_client_response_latency_ms";
+const char* LABEL_CLIENT = "client";
+
+std::mutex shared_pool_mutex;
+std::shared_ptr<CompletionQueuePool> shared_pool;
+}  // namespace
+
+void AsyncResponse::track(GRPCReceiver* receiver) {
+  if (receiver == nullptr) {
+    return;
+  }
+  receiver_ = receiver;
+  start_ = std::chrono::steady_clock::now();
+  receiver->on_request();
+}
+
+void AsyncResponse::dispatch(bool ok) {
+  GRPCReceiver* receiver = receiver_;
+  if (receiver != nullptr) {
+    receiver->on_response(std::chrono::steady_clock::now() - start_);
+  }
+  if (!ok) {
+    MLOG(MINFO) << "gRPC receiver encountered error while processing request";
+    return;
+  }
+  if (receiver != nullptr && receiver->executor_) {
+    receiver->executor_([this]() { handle_response(); });
+    return;
+  }
+  handle_response();
+}
+
+CompletionQueuePool::CompletionQueuePool(uint32_t num_threads)
+    : num_threads_(num_threads), stopped_(false) {}
+
+CompletionQueuePool::~CompletionQueuePool() { stop(); }
+
+void CompletionQueuePool::start() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (stopped_ || !threads_.empty()) {
+    return;
+  }
+  for (uint32_t i = 0; i < num_threads_; i++) {
+    threads_.emplace_back([this]() { poll_loop(); });
+  }
+  MLOG(MINFO) << "Started " << num_threads_ << " gRPC response threads";
+}
+
+void CompletionQueuePool::stop() {
+  std::vector<std::thread> threads;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopped_) {
+      return;
+    }
+    stopped_ = true;
+    threads.swap(threads_);
+  }
+  queue_.Shutdown();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  if (threads.empty()) {
+    // Never started, the queue still has to be drained before it is destroyed
+    poll_loop();
+  }
+}
+
+void CompletionQueuePool::poll_loop() {
+  void* tag;
+  bool ok = false;
+  while (queue_.Next(&tag, &ok)) {
+    static_cast<AsyncResponse*>(tag)->dispatch(ok);
+  }
+}
+
+void CompletionQueuePool::set_shared(
+    std::shared_ptr<CompletionQueuePool> pool) {
+  std::lock_guard<std::mutex> lock(shared_pool_mutex);
+  shared_pool = std::move(pool);
+}
+
+std::shared_ptr<CompletionQueuePool> CompletionQueuePool::get_shared() {
+  std::lock_guard<std::mutex> lock(shared_pool_mutex);
+  return shared_pool;
+}
+
+GRPCReceiver::GRPCReceiver()
+    : GRPCReceiver(CompletionQueuePool::get_shared()) {}
+
+GRPCReceiver::GRPCReceiver(std::shared_ptr<CompletionQueuePool> pool)
+    : pool_(std::move(pool)),
+      own_queue_(pool_ ? nullptr : new grpc::CompletionQueue()),
+      queue_(pool_ ? *pool_->get_queue() : *own_queue_),
+      running_(false),
+      inflight_(0) {}
+
+void GRPCReceiver::set_client_name(const std::string& name) {
+  client_name_ = name;
+}
+
+void GRPCReceiver::set_response_executor(ResponseExecutor executor) {
+  executor_ = std::move(executor);
+}
+
+void GRPCReceiver::on_request() {
+  inflight_++;
+  if (!client_name_.empty()) {
+    increment_gauge(INFLIGHT_GAUGE, 1, size_t(1), LABEL_CLIENT,
+                    client_name_.c_str());
+  }
+}
+
+void GRPCReceiver::on_response(std::chrono::steady_clock::duration latency) {
+  inflight_--;
+  if (client_name_.empty()) {
+    return;
+  }
+  decrement_gauge(INFLIGHT_GAUGE, 1, size_t(1), LABEL_CLIENT,
+                  client_name_.c_str());
+  double latency_ms =
+      std::chrono::duration<double, std::milli>(latency).count();
+  observe_histogram(LATENCY_HISTOGRAM, latency_ms, size_t(1), LABEL_CLIENT,
+                    client_name_.c_str(), size_t(7), 1., 5., 10., 50., 100.,
+                    500., 1000.);
+}
+
 void GRPCReceiver::rpc_response_loop() {
+  if (pool_) {
+    // The threads of the pool drain the queue
+    return;
+  }
   running_ = true;
   void* tag;
   bool ok = false;
@@ -28,16 +163,16 @@ void GRPCReceiver::rpc_response_loop() {
     if (!queue_.Next(&tag, &ok)) {
       return;
     }
-    if (!ok) {
-      MLOG(MINFO) << "gRPC receiver encountered error while processing request";
-      continue;
-    }
-    static_cast<AsyncResponse*>(tag)->handle_response();
+    static_cast<AsyncResponse*>(tag)->dispatch(ok);
   }
 }
 
 void GRPCReceiver::stop() {
   running_ = false;
+  if (pool_) {
+    // The queue is shut down with the pool
+    return;
+  }
   queue_.Shutdown();
   // Pop all items in the queue until it is empty
   // https://github.com/grpc/grpc/issues/8610
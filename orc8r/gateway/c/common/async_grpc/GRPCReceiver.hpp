@@ -20,6 +20,10 @@
 #include <chrono>                                  // for operator+, seconds
 #include <functional>                              // for function
 #include <memory>                                  // for unique_ptr
+#include <mutex>                                   // for mutex
+#include <string>                                  // for string
+#include <thread>                                  // for thread
+#include <vector>                                  // for vector
 
 namespace grpc {
 template <class R>
@@ -28,41 +32,147 @@ class ClientAsyncResponseReader;
 
 namespace magma {
 
+class GRPCReceiver;
+
 /**
- * GRPCReceiver is the base class for receiving responses asynchronously from
- * the cloud. It uses a completion queue to wait for new responses, and call
- * the virtual handle_response callback on them
+ * ResponseExecutor runs the handling of a response somewhere else than on the
+ * thread draining the completion queue, e.g. on a folly EventBase or by
+ * sending it to an ITTI task.
  */
-class GRPCReceiver {
+using ResponseExecutor = std::function<void(std::function<void()>)>;
+
+/**
+ * AsyncResponse is the base class that all tags in the completion queue will
+ * be cast to.
+ */
+class AsyncResponse {
  public:
+  virtual ~AsyncResponse() = default;
   /**
-   * Begin the receiver loop, blocks
+   * Override handle_response to be called when a response comes into the queue
    */
-  void rpc_response_loop();
+  virtual void handle_response() = 0;
 
   /**
-   * Stop the receiver loop
+   * Called by the thread that took the response from the completion queue.
+   * Records the metrics of the receiver the response is tracked by, and calls
+   * handle_response on the executor of that receiver if it has one.
    */
-  void stop();
+  void dispatch(bool ok);
 
  protected:
-  grpc::CompletionQueue queue_;
+  /**
+   * Count the response as in flight for the receiver, must be called before
+   * the response can come out of the completion queue. Does nothing for a
+   * null receiver.
+   */
+  void track(GRPCReceiver* receiver);
 
  private:
-  std::atomic<bool> running_;
+  GRPCReceiver* receiver_ = nullptr;
+  std::chrono::steady_clock::time_point start_;
 };
 
 /**
- * AsyncResponse is the base class that all tags in the completion queue will
- * be cast to.
+ * CompletionQueuePool drains a single completion queue with a pool of
+ * threads, so that clients can share threads instead of running one response
+ * loop each, and one slow callback only holds up one of the threads.
+ * Responses of a client may then be handled concurrently.
  */
-class AsyncResponse {
+class CompletionQueuePool {
  public:
-  virtual ~AsyncResponse() = default;
+  explicit CompletionQueuePool(uint32_t num_threads);
+  ~CompletionQueuePool();
+
+  CompletionQueuePool(const CompletionQueuePool&) = delete;
+  void operator=(const CompletionQueuePool&) = delete;
+
+  void start();
+
   /**
-   * Override handle_response to be called when a response comes into the queue
+   * Shut the queue down and wait for the responses in flight to be handled.
+   * The pool cannot be started again.
    */
-  virtual void handle_response() = 0;
+  void stop();
+
+  grpc::CompletionQueue* get_queue() { return &queue_; }
+
+  /**
+   * Set the pool used by the receivers constructed after this call
+   */
+  static void set_shared(std::shared_ptr<CompletionQueuePool> pool);
+
+  static std::shared_ptr<CompletionQueuePool> get_shared();
+
+ private:
+  void poll_loop();
+
+  const uint32_t num_threads_;
+  grpc::CompletionQueue queue_;
+  std::mutex mutex_;
+  bool stopped_;
+  std::vector<std::thread> threads_;
+};
+
+/**
+ * GRPCReceiver is the base class for receiving responses asynchronously from
+ * the cloud. It uses a completion queue to wait for new responses, and call
+ * the virtual handle_response callback on them.
+ * The queue is either owned by the receiver and drained by
+ * rpc_response_loop, or the one of a CompletionQueuePool.
+ */
+class GRPCReceiver {
+ public:
+  /**
+   * Use the shared pool if one is set, an own queue otherwise
+   */
+  GRPCReceiver();
+
+  explicit GRPCReceiver(std::shared_ptr<CompletionQueuePool> pool);
+
+  /**
+   * Begin the receiver loop, blocks. Returns right away when the receiver
+   * uses a pool.
+   */
+  void rpc_response_loop();
+
+  /**
+   * Stop the receiver loop
+   */
+  void stop();
+
+  /**
+   * Name the client in the grpc_client_* metrics, the receiver reports no
+   * metrics without a name. Must be called before the first RPC.
+   */
+  void set_client_name(const std::string& name);
+
+  /**
+   * Handle the responses on executor instead of the thread draining the
+   * queue. Must be called before the first RPC.
+   */
+  void set_response_executor(ResponseExecutor executor);
+
+  uint32_t get_inflight() const { return inflight_; }
+
+ private:
+  friend class AsyncResponse;
+
+  void on_request();
+  void on_response(std::chrono::steady_clock::duration latency);
+
+  // Declared before queue_, which refers to one of them
+  std::shared_ptr<CompletionQueuePool> pool_;
+  std::unique_ptr<grpc::CompletionQueue> own_queue_;
+
+ protected:
+  grpc::CompletionQueue& queue_;
+
+ private:
+  std::atomic<bool> running_;
+  std::atomic<uint32_t> inflight_;
+  std::string client_name_;
+  ResponseExecutor executor_;
 };
 
 /**
@@ -90,9 +200,13 @@ class AsyncGRPCResponse : public AsyncResponse {
   /**
    * Set the response reader which waits for the response back from the gRPC
    * call
+   * @param receiver - the receiver to count the request for, in its metrics
+   *                   and to handle the response on its executor
    */
   void set_response_reader(
-      std::unique_ptr<grpc::ClientAsyncResponseReader<ResponseType>> reader) {
+      std::unique_ptr<grpc::ClientAsyncResponseReader<ResponseType>> reader,
+      GRPCReceiver* receiver = nullptr) {
+    track(receiver);
     response_reader_ = std::move(reader);
     response_reader_->Finish(&response_, &status_, this);
   }
@@ -114,7 +228,8 @@ class AsyncGRPCResponse : public AsyncResponse {
 
 /**
  * AsyncLocalResponse is an example provided response that takes the callback
- * passed and executes it directly in the response loop's thread
+ * passed and executes it directly in the response loop's thread, or on the
+ * executor of its receiver
  * It is important that when using this, the callback can be executed quickly,
  * because it blocks the response queue.
  * Here is an example usage:
@@ -122,7 +237,7 @@ class AsyncGRPCResponse : public AsyncResponse {
  *   callback, RESPONSE_TIMEOUT);
  * auto response_reader = stub_->AsyncYourRPCCall(
  *   local_response->get_context(), request_val, &completion_queue);
- * local_response->set_response_reader(std::move(response_reader));
+ * local_response->set_response_reader(std::move(response_reader), this);
  */
 template <typename ResponseType>
 class AsyncLocalResponse : public AsyncGRPCResponse<ResponseType> {
@@ -0,0 +1,286 @@
+/**
+ * Copyright 2022 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace magma {
+
+struct ReportQueueConfig {
+  // Reports kept waiting, newer ones are dropped beyond that
+  size_t max_pending = 10000;
+  // Pending reports that trigger a flush before the interval is over, also
+  // the most reports sent by one flush
+  size_t max_batch = 64;
+  // Reports sent and not answered yet
+  size_t max_in_flight = 128;
+  std::chrono::milliseconds flush_interval{100};
+  // Sends of a report before it is dropped
+  uint32_t max_attempts = 3;
+  // Wait before the first resend of a report, doubled for each later one
+  std::chrono::milliseconds retry_backoff{500};
+};
+
+struct ReportQueueStats {
+  uint64_t queued = 0;
+  uint64_t merged = 0;
+  uint64_t sent = 0;
+  uint64_t retried = 0;
+  uint64_t dropped_full = 0;
+  uint64_t dropped_failed = 0;
+  size_t pending = 0;
+  size_t in_flight = 0;
+};
+
+enum class ReportResult { DELIVERED, RETRY, FAILED };
+
+/**
+ * ReportQueue sends fire-and-forget reports, e.g. directoryd updates or
+ * eventd events, from a background thread instead of one RPC per call.
+ *
+ * Reports are queued per key: a report for a key that is already waiting is
+ * merged into the waiting one, so that bursts for the same subscriber cost a
+ * single RPC. Pending reports are sent every flush interval, or as soon as
+ * max_batch of them are waiting, with at most max_in_flight unanswered at any
+ * time. Reports of the same key are never in flight together, which keeps
+ * them in order. A report whose RPC fails with a retryable error is queued
+ * again, until max_attempts, and is not sent before its backoff has passed.
+ *
+ * Every method is thread safe. The send and drop callbacks are called
+ * without the queue lock held, the merge callback with it.
+ */
+template <typename Key, typename Report, typename Hash = std::hash<Key>>
+class ReportQueue {
+ public:
+  // Merge a newer report into the one already waiting for the same key
+  using MergeFn = std::function<void(Report& pending, Report&& newer)>;
+  // Send a report, done must be called once with the result of the RPC
+  using DoneFn = std::function<void(ReportResult)>;
+  using SendFn =
+      std::function<void(const Key& key, const Report& report, DoneFn done)>;
+  // Called for every dropped report, with "queue_full" or "send_failed"
+  using DropFn = std::function<void(const char* reason)>;
+
+  ReportQueue(const ReportQueueConfig& config, MergeFn merge, SendFn send,
+              DropFn on_drop = nullptr)
+      : config_(config),
+        merge_(std::move(merge)),
+        send_(std::move(send)),
+        on_drop_(std::move(on_drop)),
+        running_(false) {}
+
+  ~ReportQueue() { stop(); }
+
+  ReportQueue(const ReportQueue&) = delete;
+  void operator=(const ReportQueue&) = delete;
+
+  /**
+   * Start the thread flushing the queue every flush interval. Without it the
+   * queue is only flushed by calls to flush.
+   */
+  void start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) return;
+    running_ = true;
+    flusher_ = std::thread([this]() { flush_loop(); });
+  }
+
+  /**
+   * Stop the flush thread. Pending reports stay queued.
+   */
+  void stop() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!running_) return;
+      running_ = false;
+    }
+    cv_.notify_all();
+    flusher_.join();
+  }
+
+  /**
+   * Queue a report
+   * @return false if the report was dropped because the queue is full
+   */
+  bool enqueue(const Key& key, Report report) {
+    bool full = false;
+    bool notify = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = index_.find(key);
+      if (it != index_.end()) {
+        merge_(it->second->report, std::move(report));
+        stats_.merged++;
+        return true;
+      }
+      if (pending_.size() >= config_.max_pending) {
+        stats_.dropped_full++;
+        full = true;
+      } else {
+        pending_.push_back(Entry{key, std::move(report), 0, {}});
+        index_[key] = std::prev(pending_.end());
+        stats_.queued++;
+        notify = batch_ready_locked();
+      }
+    }
+    if (full) {
+      drop("queue_full");
+      return false;
+    }
+    if (notify) cv_.notify_all();
+    return true;
+  }
+
+  /**
+   * Send up to max_batch pending reports, within the in-flight limit
+   * @return the number of reports sent
+   */
+  size_t flush() {
+    std::vector<Entry> batch;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto now = std::chrono::steady_clock::now();
+      auto it = pending_.begin();
+      while (it != pending_.end() && batch.size() < config_.max_batch &&
+             in_flight_.size() < config_.max_in_flight) {
+        if (in_flight_.count(it->key) || it->retry_at > now) {
+          ++it;
+          continue;
+        }
+        in_flight_.insert(it->key);
+        index_.erase(it->key);
+        batch.push_back(std::move(*it));
+        it = pending_.erase(it);
+      }
+      stats_.sent += batch.size();
+    }
+    for (auto& entry : batch) {
+      send_entry(std::move(entry));
+    }
+    return batch.size();
+  }
+
+  ReportQueueStats stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ReportQueueStats stats = stats_;
+    stats.pending = pending_.size();
+    stats.in_flight = in_flight_.size();
+    return stats;
+  }
+
+ private:
+  struct Entry {
+    Key key;
+    Report report;
+    uint32_t attempts;
+    std::chrono::steady_clock::time_point retry_at;
+  };
+
+  bool batch_ready_locked() const {
+    return pending_.size() >= config_.max_batch &&
+           in_flight_.size() < config_.max_in_flight;
+  }
+
+  void drop(const char* reason) {
+    if (on_drop_) on_drop_(reason);
+  }
+
+  void send_entry(Entry entry) {
+    // The entry is kept by the completion, for a retry
+    auto shared = std::make_shared<Entry>(std::move(entry));
+    shared->attempts++;
+    send_(shared->key, shared->report,
+          [this, shared](ReportResult result) { complete(shared, result); });
+  }
+
+  void complete(std::shared_ptr<Entry> entry, ReportResult result) {
+    bool dropped = false;
+    bool notify = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      in_flight_.erase(entry->key);
+      if (result == ReportResult::RETRY &&
+          entry->attempts < config_.max_attempts) {
+        stats_.retried++;
+        entry->retry_at = std::chrono::steady_clock::now() +
+                          config_.retry_backoff * (1 << (entry->attempts - 1));
+        auto it = index_.find(entry->key);
+        if (it != index_.end()) {
+          // Newer reports of the key go on top of the one to resend
+          merge_(entry->report, std::move(it->second->report));
+          it->second->report = std::move(entry->report);
+          it->second->attempts = entry->attempts;
+          it->second->retry_at = entry->retry_at;
+        } else {
+          pending_.push_front(std::move(*entry));
+          index_[pending_.front().key] = pending_.begin();
+        }
+      } else if (result != ReportResult::DELIVERED) {
+        stats_.dropped_failed++;
+        dropped = true;
+      }
+      notify = batch_ready_locked();
+    }
+    if (dropped) drop("send_failed");
+    if (notify) cv_.notify_all();
+  }
+
+  void flush_loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    bool sent = true;
+    while (running_) {
+      if (sent) {
+        cv_.wait_for(lock, config_.flush_interval,
+                     [this]() { return !running_ || batch_ready_locked(); });
+      } else {
+        // The pending reports wait for reports of their key in flight, or
+        // for their retry backoff
+        cv_.wait_for(lock, config_.flush_interval,
+                     [this]() { return !running_; });
+      }
+      if (!running_) break;
+      lock.unlock();
+      sent = flush() > 0;
+      lock.lock();
+    }
+  }
+
+  const ReportQueueConfig config_;
+  MergeFn merge_;
+  SendFn send_;
+  DropFn on_drop_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  bool running_;
+  std::thread flusher_;
+  ReportQueueStats stats_;
+  // Oldest report first
+  std::list<Entry> pending_;
+  std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> index_;
+  std::unordered_set<Key, Hash> in_flight_;
+};
+
+}  // namespace magma
@@ -0,0 +1,147 @@
+/**
+ * Copyright 2022 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <grpcpp/alarm.h>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "orc8r/gateway/c/common/async_grpc/GRPCReceiver.hpp"
+
+namespace magma {
+
+namespace {
+
+class TestReceiver : public GRPCReceiver {
+ public:
+  TestReceiver() = default;
+  explicit TestReceiver(std::shared_ptr<CompletionQueuePool> pool)
+      : GRPCReceiver(pool) {}
+
+  grpc::CompletionQueue* get_queue() { return &queue_; }
+};
+
+// Stands for an RPC response, an alarm puts it in the completion queue
+class TestResponse : public AsyncResponse {
+ public:
+  TestResponse(TestReceiver* receiver, std::function<void()> on_response)
+      : on_response_(on_response) {
+    track(receiver);
+    alarm_.Set(receiver->get_queue(), std::chrono::system_clock::now(), this);
+  }
+
+  void handle_response() override {
+    on_response_();
+    delete this;
+  }
+
+ private:
+  std::function<void()> on_response_;
+  grpc::Alarm alarm_;
+};
+
+void wait_for(std::future<void>& future) {
+  ASSERT_EQ(future.wait_for(std::chrono::seconds(5)),
+            std::future_status::ready);
+}
+
+TEST(GRPCReceiverTest, TestOwnQueue) {
+  TestReceiver receiver;
+  std::thread loop([&receiver]() { receiver.rpc_response_loop(); });
+  std::promise<void> handled;
+  new TestResponse(&receiver, [&handled]() { handled.set_value(); });
+  auto future = handled.get_future();
+  wait_for(future);
+  EXPECT_EQ(receiver.get_inflight(), 0);
+  receiver.stop();
+  loop.join();
+}
+
+TEST(GRPCReceiverTest, TestSharedPool) {
+  auto pool = std::make_shared<CompletionQueuePool>(2);
+  CompletionQueuePool::set_shared(pool);
+  TestReceiver receiver1;
+  TestReceiver receiver2;
+  CompletionQueuePool::set_shared(nullptr);
+  EXPECT_EQ(receiver1.get_queue(), pool->get_queue());
+  EXPECT_EQ(receiver2.get_queue(), pool->get_queue());
+  // The pool drains the queue
+  receiver1.rpc_response_loop();
+
+  pool->start();
+  std::promise<void> handled1, handled2;
+  new TestResponse(&receiver1, [&handled1]() { handled1.set_value(); });
+  new TestResponse(&receiver2, [&handled2]() { handled2.set_value(); });
+  auto future1 = handled1.get_future();
+  auto future2 = handled2.get_future();
+  wait_for(future1);
+  wait_for(future2);
+  EXPECT_EQ(receiver1.get_inflight(), 0);
+  EXPECT_EQ(receiver2.get_inflight(), 0);
+  pool->stop();
+}
+
+TEST(GRPCReceiverTest, TestSlowCallback) {
+  auto pool = std::make_shared<CompletionQueuePool>(2);
+  TestReceiver receiver(pool);
+  pool->start();
+  std::promise<void> release, slow_done, fast_done;
+  auto release_future = release.get_future();
+  new TestResponse(&receiver, [&release_future, &slow_done]() {
+    release_future.wait();
+    slow_done.set_value();
+  });
+  new TestResponse(&receiver, [&fast_done]() { fast_done.set_value(); });
+
+  // The second response is handled while the first one blocks its thread
+  auto fast_future = fast_done.get_future();
+  wait_for(fast_future);
+  EXPECT_EQ(receiver.get_inflight(), 0);
+  release.set_value();
+  auto slow_future = slow_done.get_future();
+  wait_for(slow_future);
+  pool->stop();
+}
+
+TEST(GRPCReceiverTest, TestExecutor) {
+  auto pool = std::make_shared<CompletionQueuePool>(1);
+  TestReceiver receiver(pool);
+  std::mutex mutex;
+  std::vector<std::function<void()>> posted;
+  std::promise<void> posted_once;
+  receiver.set_response_executor(
+      [&mutex, &posted, &posted_once](std::function<void()> fn) {
+        std::lock_guard<std::mutex> lock(mutex);
+        posted.push_back(fn);
+        posted_once.set_value();
+      });
+  pool->start();
+  bool handled = false;
+  new TestResponse(&receiver, [&handled]() { handled = true; });
+  auto future = posted_once.get_future();
+  wait_for(future);
+  pool->stop();
+
+  // Nothing is handled until the executor runs it
+  EXPECT_FALSE(handled);
+  ASSERT_EQ(posted.size(), 1);
+  posted[0]();
+  EXPECT_TRUE(handled);
+}
+
+}  // namespace
+
+}  // namespace magma
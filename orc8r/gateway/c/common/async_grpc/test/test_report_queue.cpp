@@ -0,0 +1,181 @@
+/**
+ * Copyright 2022 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "orc8r/gateway/c/common/async_grpc/ReportQueue.hpp"
+
+namespace magma {
+
+namespace {
+
+struct SentReport {
+  std::string key;
+  std::string report;
+  ReportQueue<std::string, std::string>::DoneFn done;
+};
+
+class ReportQueueTest : public ::testing::Test {
+ protected:
+  void init(const ReportQueueConfig& config) {
+    queue_.reset(new ReportQueue<std::string, std::string>(
+        config,
+        [](std::string& pending, std::string&& newer) {
+          pending += "+" + newer;
+        },
+        [this](const std::string& key, const std::string& report,
+               ReportQueue<std::string, std::string>::DoneFn done) {
+          std::lock_guard<std::mutex> lock(mutex_);
+          sent_.push_back(SentReport{key, report, done});
+        },
+        [this](const char* reason) {
+          std::lock_guard<std::mutex> lock(mutex_);
+          drops_.push_back(reason);
+        }));
+  }
+
+  size_t sent_count() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return sent_.size();
+  }
+
+  std::mutex mutex_;
+  std::vector<SentReport> sent_;
+  std::vector<std::string> drops_;
+  std::unique_ptr<ReportQueue<std::string, std::string>> queue_;
+};
+
+TEST_F(ReportQueueTest, TestMergePerKey) {
+  init(ReportQueueConfig());
+  queue_->enqueue("IMSI1", "update");
+  queue_->enqueue("IMSI2", "update");
+  queue_->enqueue("IMSI1", "delete");
+
+  EXPECT_EQ(queue_->flush(), 2);
+  ASSERT_EQ(sent_.size(), 2);
+  EXPECT_EQ(sent_[0].key, "IMSI1");
+  EXPECT_EQ(sent_[0].report, "update+delete");
+  EXPECT_EQ(sent_[1].report, "update");
+
+  auto stats = queue_->stats();
+  EXPECT_EQ(stats.queued, 2);
+  EXPECT_EQ(stats.merged, 1);
+  EXPECT_EQ(stats.in_flight, 2);
+  sent_[0].done(ReportResult::DELIVERED);
+  sent_[1].done(ReportResult::DELIVERED);
+  EXPECT_EQ(queue_->stats().in_flight, 0);
+}
+
+TEST_F(ReportQueueTest, TestLimits) {
+  ReportQueueConfig config;
+  config.max_pending = 3;
+  config.max_batch = 2;
+  config.max_in_flight = 3;
+  init(config);
+  EXPECT_TRUE(queue_->enqueue("a", "1"));
+  EXPECT_TRUE(queue_->enqueue("b", "1"));
+  EXPECT_TRUE(queue_->enqueue("c", "1"));
+  EXPECT_FALSE(queue_->enqueue("d", "1"));
+  EXPECT_EQ(drops_, std::vector<std::string>({"queue_full"}));
+
+  EXPECT_EQ(queue_->flush(), 2);
+  EXPECT_TRUE(queue_->enqueue("d", "1"));
+  EXPECT_TRUE(queue_->enqueue("e", "1"));
+  // Only one more report fits in flight
+  EXPECT_EQ(queue_->flush(), 1);
+  EXPECT_EQ(queue_->flush(), 0);
+  sent_[0].done(ReportResult::DELIVERED);
+  EXPECT_EQ(queue_->flush(), 1);
+  EXPECT_EQ(queue_->stats().pending, 1);
+}
+
+TEST_F(ReportQueueTest, TestRetry) {
+  ReportQueueConfig config;
+  config.max_attempts = 2;
+  config.retry_backoff = std::chrono::milliseconds(0);
+  init(config);
+  queue_->enqueue("IMSI1", "update");
+  queue_->flush();
+  // Reports of a key in flight wait for it
+  queue_->enqueue("IMSI1", "field");
+  EXPECT_EQ(queue_->flush(), 0);
+
+  sent_[0].done(ReportResult::RETRY);
+  EXPECT_EQ(queue_->flush(), 1);
+  EXPECT_EQ(sent_[1].report, "update+field");
+  sent_[1].done(ReportResult::RETRY);
+  EXPECT_EQ(queue_->flush(), 0);
+
+  queue_->enqueue("IMSI2", "update");
+  queue_->flush();
+  sent_[2].done(ReportResult::FAILED);
+  EXPECT_EQ(drops_,
+            std::vector<std::string>({"send_failed", "send_failed"}));
+  auto stats = queue_->stats();
+  EXPECT_EQ(stats.retried, 1);
+  EXPECT_EQ(stats.dropped_failed, 2);
+  EXPECT_EQ(stats.pending, 0);
+}
+
+TEST_F(ReportQueueTest, TestRetryBackoff) {
+  ReportQueueConfig config;
+  config.retry_backoff = std::chrono::milliseconds(100);
+  init(config);
+  queue_->enqueue("IMSI1", "update");
+  queue_->enqueue("IMSI2", "update");
+  EXPECT_EQ(queue_->flush(), 2);
+
+  sent_[0].done(ReportResult::RETRY);
+  sent_[1].done(ReportResult::DELIVERED);
+  // Other keys are not held back by the report waiting for its backoff
+  queue_->enqueue("IMSI3", "update");
+  EXPECT_EQ(queue_->flush(), 1);
+  EXPECT_EQ(sent_[2].key, "IMSI3");
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(110));
+  EXPECT_EQ(queue_->flush(), 1);
+  EXPECT_EQ(sent_[3].key, "IMSI1");
+
+  // The second resend waits twice as long
+  sent_[3].done(ReportResult::RETRY);
+  std::this_thread::sleep_for(std::chrono::milliseconds(110));
+  EXPECT_EQ(queue_->flush(), 0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(queue_->flush(), 1);
+  EXPECT_EQ(sent_[4].key, "IMSI1");
+  EXPECT_EQ(queue_->stats().retried, 2);
+}
+
+TEST_F(ReportQueueTest, TestFlushThread) {
+  ReportQueueConfig config;
+  config.max_batch = 2;
+  config.flush_interval = std::chrono::milliseconds(20);
+  init(config);
+  queue_->start();
+  queue_->enqueue("a", "1");
+  for (int i = 0; i < 100 && sent_count() < 1; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  EXPECT_EQ(sent_count(), 1);
+  queue_->stop();
+  queue_->enqueue("b", "1");
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(sent_count(), 1);
+}
+
+}  // namespace
+
+}  // namespace magma
@@ -0,0 +1,254 @@
+/**
+ * Copyright 2022 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <errno.h>
+#include <linux/bpf.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace magma {
+namespace ebpf {
+
+/**
+ * MapBackend is the access to one eBPF map with fixed size keys and values.
+ * The syscall implementation below talks to a pinned kernel map; tests use an
+ * in-memory map instead.
+ */
+template <typename Key, typename Value>
+class MapBackend {
+ public:
+  virtual ~MapBackend() = default;
+
+  /**
+   * Insert or replace the entries keys[i] -> values[i]
+   * @return the number of entries written, or -errno on failure
+   */
+  virtual int update(const std::vector<Key>& keys,
+                     const std::vector<Value>& values) = 0;
+
+  /**
+   * Delete the entries of keys. Keys that are not in the map are ignored.
+   * @return the number of entries deleted, or -errno on failure
+   */
+  virtual int remove(const std::vector<Key>& keys) = 0;
+
+  /**
+   * Read every entry of the map
+   * @return 0, or -errno on failure
+   */
+  virtual int read_all(std::vector<Key>* keys, std::vector<Value>* values) = 0;
+};
+
+/**
+ * SyscallMapBackend uses the BPF_MAP_*_BATCH commands, which write or read
+ * up to max_batch entries per syscall. Kernels older than 5.6 and map types
+ * without batch support reject them, in which case the backend falls back to
+ * one syscall per entry for the rest of its life.
+ */
+template <typename Key, typename Value>
+class SyscallMapBackend : public MapBackend<Key, Value> {
+ public:
+  explicit SyscallMapBackend(int fd, uint32_t max_batch = 256)
+      : fd_(fd), max_batch_(max_batch), batch_supported_(true) {}
+
+  ~SyscallMapBackend() {
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+
+  /**
+   * Open a map pinned on the bpf filesystem
+   * @return nullptr if the map does not exist
+   */
+  static std::unique_ptr<SyscallMapBackend> open_pinned(const char* path) {
+    union bpf_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.pathname = (uint64_t)path;
+    int fd = sys_bpf(BPF_OBJ_GET, &attr);
+    if (fd < 0) {
+      return nullptr;
+    }
+    return std::unique_ptr<SyscallMapBackend>(new SyscallMapBackend(fd));
+  }
+
+  bool batch_supported() const { return batch_supported_; }
+
+  int update(const std::vector<Key>& keys,
+             const std::vector<Value>& values) override {
+    uint32_t done = 0;
+    while (batch_supported_ && done < keys.size()) {
+      union bpf_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.batch.map_fd = fd_;
+      attr.batch.keys = (uint64_t)&keys[done];
+      attr.batch.values = (uint64_t)&values[done];
+      attr.batch.count = std::min<uint32_t>(max_batch_, keys.size() - done);
+      if (sys_bpf(BPF_MAP_UPDATE_BATCH, &attr) == 0) {
+        done += attr.batch.count;
+      } else if (is_batch_unsupported(errno)) {
+        // Rewriting the entries of the failed batch one by one is harmless
+        batch_supported_ = false;
+      } else {
+        return -errno;
+      }
+    }
+    for (; done < keys.size(); done++) {
+      union bpf_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.map_fd = fd_;
+      attr.key = (uint64_t)&keys[done];
+      attr.value = (uint64_t)&values[done];
+      attr.flags = BPF_ANY;
+      if (sys_bpf(BPF_MAP_UPDATE_ELEM, &attr) < 0) return -errno;
+    }
+    return done;
+  }
+
+  int remove(const std::vector<Key>& keys) override {
+    uint32_t next = 0;
+    int deleted = 0;
+    while (batch_supported_ && next < keys.size()) {
+      union bpf_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.batch.map_fd = fd_;
+      attr.batch.keys = (uint64_t)&keys[next];
+      attr.batch.count = std::min<uint32_t>(max_batch_, keys.size() - next);
+      if (sys_bpf(BPF_MAP_DELETE_BATCH, &attr) == 0) {
+        next += attr.batch.count;
+        deleted += attr.batch.count;
+      } else if (errno == ENOENT) {
+        // The batch stops at a missing key, count is the keys deleted before
+        next += attr.batch.count + 1;
+        deleted += attr.batch.count;
+      } else if (is_batch_unsupported(errno)) {
+        batch_supported_ = false;
+      } else {
+        return -errno;
+      }
+    }
+    for (; next < keys.size(); next++) {
+      union bpf_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.map_fd = fd_;
+      attr.key = (uint64_t)&keys[next];
+      if (sys_bpf(BPF_MAP_DELETE_ELEM, &attr) == 0) {
+        deleted++;
+      } else if (errno != ENOENT) {
+        return -errno;
+      }
+    }
+    return deleted;
+  }
+
+  int read_all(std::vector<Key>* keys, std::vector<Value>* values) override {
+    keys->clear();
+    values->clear();
+    if (batch_supported_) {
+      int rc = read_all_batched(keys, values);
+      if (rc != -EINVAL && rc != -ENOTSUPP_ && rc != -EOPNOTSUPP) return rc;
+      batch_supported_ = false;
+      keys->clear();
+      values->clear();
+    }
+    return read_all_by_key(keys, values);
+  }
+
+ private:
+  // ENOTSUPP is kernel internal and has no userspace definition
+  static constexpr int ENOTSUPP_ = 524;
+
+  static int sys_bpf(enum bpf_cmd cmd, union bpf_attr* attr) {
+    return syscall(__NR_bpf, cmd, attr, sizeof(*attr));
+  }
+
+  static bool is_batch_unsupported(int err) {
+    return err == EINVAL || err == ENOTSUPP_ || err == EOPNOTSUPP;
+  }
+
+  int read_all_batched(std::vector<Key>* keys, std::vector<Value>* values) {
+    // The batch position is opaque, hash maps use a 32 bit bucket index
+    uint64_t in_batch = 0;
+    uint64_t out_batch = 0;
+    bool first = true;
+    while (true) {
+      size_t offset = keys->size();
+      keys->resize(offset + max_batch_);
+      values->resize(offset + max_batch_);
+      union bpf_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.batch.map_fd = fd_;
+      attr.batch.in_batch = first ? 0 : (uint64_t)&in_batch;
+      attr.batch.out_batch = (uint64_t)&out_batch;
+      attr.batch.keys = (uint64_t)&(*keys)[offset];
+      attr.batch.values = (uint64_t)&(*values)[offset];
+      attr.batch.count = max_batch_;
+      int rc = sys_bpf(BPF_MAP_LOOKUP_BATCH, &attr);
+      int err = errno;
+      if (rc < 0 && err != ENOENT) {
+        keys->resize(offset);
+        values->resize(offset);
+        return -err;
+      }
+      keys->resize(offset + attr.batch.count);
+      values->resize(offset + attr.batch.count);
+      if (rc < 0) {
+        return 0;  // ENOENT: the whole map has been read
+      }
+      in_batch = out_batch;
+      first = false;
+    }
+  }
+
+  int read_all_by_key(std::vector<Key>* keys, std::vector<Value>* values) {
+    Key key;
+    Key next_key;
+    bool first = true;
+    while (true) {
+      union bpf_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.map_fd = fd_;
+      attr.key = first ? 0 : (uint64_t)&key;
+      attr.next_key = (uint64_t)&next_key;
+      if (sys_bpf(BPF_MAP_GET_NEXT_KEY, &attr) < 0) {
+        return errno == ENOENT ? 0 : -errno;
+      }
+      Value value;
+      memset(&attr, 0, sizeof(attr));
+      attr.map_fd = fd_;
+      attr.key = (uint64_t)&next_key;
+      attr.value = (uint64_t)&value;
+      // The entry may have been deleted since it was listed
+      if (sys_bpf(BPF_MAP_LOOKUP_ELEM, &attr) == 0) {
+        keys->push_back(next_key);
+        values->push_back(value);
+      }
+      key = next_key;
+      first = false;
+    }
+  }
+
+  int fd_;
+  uint32_t max_batch_;
+  bool batch_supported_;
+};
+
+}  // namespace ebpf
+}  // namespace magma
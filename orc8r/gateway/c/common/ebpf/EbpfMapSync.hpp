@@ -0,0 +1,175 @@
+/**
+ * Copyright 2022 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "orc8r/gateway/c/common/ebpf/EbpfMapBackend.hpp"
+
+namespace magma {
+namespace ebpf {
+
+// Orders plain-old-data map keys by their bytes
+template <typename Key>
+struct KeyBytesLess {
+  bool operator()(const Key& a, const Key& b) const {
+    return memcmp(&a, &b, sizeof(Key)) < 0;
+  }
+};
+
+/**
+ * MapSync queues the writes to an eBPF map and applies them in batches.
+ * Only the last write of a key is kept, so an entry that is added and
+ * deleted before a flush never reaches the kernel.
+ *
+ * It can also reconcile the map with a desired set of entries, e.g. the
+ * sessions restored from state after a restart: entries that are missing or
+ * differ are written and the others are deleted, leaving the entries that
+ * are already right untouched, including the counters the datapath keeps in
+ * them.
+ */
+template <typename Key, typename Value>
+class MapSync {
+ public:
+  using Entries = std::map<Key, Value, KeyBytesLess<Key>>;
+  // Whether the current value of an entry already matches the desired one
+  using SameEntryFn =
+      std::function<bool(const Value& desired, const Value& current)>;
+
+  MapSync(std::unique_ptr<MapBackend<Key, Value>> backend,
+          SameEntryFn same_entry)
+      : backend_(std::move(backend)), same_entry_(std::move(same_entry)) {}
+
+  void set(const Key& key, const Value& value) {
+    auto& op = pending_[key];
+    op.remove = false;
+    op.value = value;
+  }
+
+  void erase(const Key& key) { pending_[key].remove = true; }
+
+  size_t pending() const { return pending_.size(); }
+
+  /**
+   * Apply the queued writes
+   * @return 0, or -errno if the backend failed. Failed writes are dropped.
+   */
+  int flush() {
+    std::vector<Key> update_keys;
+    std::vector<Value> update_values;
+    std::vector<Key> remove_keys;
+    for (const auto& it : pending_) {
+      if (it.second.remove) {
+        remove_keys.push_back(it.first);
+      } else {
+        update_keys.push_back(it.first);
+        update_values.push_back(it.second.value);
+      }
+    }
+    pending_.clear();
+    return apply(update_keys, update_values, remove_keys);
+  }
+
+  /**
+   * Make the map hold exactly the desired entries. Queued writes are
+   * dropped, desired is expected to already account for them.
+   * @return the number of entries written or deleted, or -errno
+   */
+  int reconcile(const Entries& desired) {
+    pending_.clear();
+    std::vector<Key> keys;
+    std::vector<Value> values;
+    int rc = backend_->read_all(&keys, &values);
+    if (rc < 0) {
+      return rc;
+    }
+    Entries current;
+    for (size_t i = 0; i < keys.size(); i++) {
+      current.emplace(keys[i], values[i]);
+    }
+
+    std::vector<Key> update_keys;
+    std::vector<Value> update_values;
+    std::vector<Key> remove_keys;
+    for (const auto& it : desired) {
+      auto found = current.find(it.first);
+      if (found == current.end() || !same_entry_(it.second, found->second)) {
+        update_keys.push_back(it.first);
+        update_values.push_back(it.second);
+      }
+    }
+    for (const auto& it : current) {
+      if (desired.find(it.first) == desired.end()) {
+        remove_keys.push_back(it.first);
+      }
+    }
+    rc = apply(update_keys, update_values, remove_keys);
+    if (rc < 0) {
+      return rc;
+    }
+    return update_keys.size() + remove_keys.size();
+  }
+
+  /**
+   * Read the current entries of the map, e.g. for their counters
+   * @return 0, or -errno
+   */
+  int read_all(Entries* entries) {
+    std::vector<Key> keys;
+    std::vector<Value> values;
+    int rc = backend_->read_all(&keys, &values);
+    if (rc < 0) {
+      return rc;
+    }
+    entries->clear();
+    for (size_t i = 0; i < keys.size(); i++) {
+      entries->emplace(keys[i], values[i]);
+    }
+    return 0;
+  }
+
+ private:
+  struct PendingOp {
+    bool remove;
+    Value value;
+  };
+
+  int apply(const std::vector<Key>& update_keys,
+            const std::vector<Value>& update_values,
+            const std::vector<Key>& remove_keys) {
+    int rc = 0;
+    if (!update_keys.empty()) {
+      rc = backend_->update(update_keys, update_values);
+    }
+    if (!remove_keys.empty()) {
+      int remove_rc = backend_->remove(remove_keys);
+      if (rc >= 0) {
+        rc = remove_rc;
+      }
+    }
+    return rc < 0 ? rc : 0;
+  }
+
+  std::unique_ptr<MapBackend<Key, Value>> backend_;
+  SameEntryFn same_entry_;
+  std::map<Key, PendingOp, KeyBytesLess<Key>> pending_;
+};
+
+}  // namespace ebpf
+}  // namespace magma
@@ -0,0 +1,148 @@
+/**
+ * Copyright 2022 The Magma Authors.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "orc8r/gateway/c/common/ebpf/EbpfMapBackend.hpp"
+#include "orc8r/gateway/c/common/ebpf/EbpfMapSync.hpp"
+
+namespace magma {
+namespace ebpf {
+
+struct TestKey {
+  uint32_t ip;
+};
+
+struct TestValue {
+  uint32_t teid;
+  uint64_t bytes;
+};
+
+// In-memory map that counts the calls made to it
+class FakeMapBackend : public MapBackend<TestKey, TestValue> {
+ public:
+  int update(const std::vector<TestKey>& keys,
+             const std::vector<TestValue>& values) override {
+    update_calls++;
+    for (size_t i = 0; i < keys.size(); i++) {
+      entries[keys[i].ip] = values[i];
+    }
+    return keys.size();
+  }
+
+  int remove(const std::vector<TestKey>& keys) override {
+    remove_calls++;
+    int deleted = 0;
+    for (const auto& key : keys) {
+      deleted += entries.erase(key.ip);
+    }
+    return deleted;
+  }
+
+  int read_all(std::vector<TestKey>* keys,
+               std::vector<TestValue>* values) override {
+    for (const auto& it : entries) {
+      keys->push_back({it.first});
+      values->push_back(it.second);
+    }
+    return 0;
+  }
+
+  std::map<uint32_t, TestValue> entries;
+  int update_calls = 0;
+  int remove_calls = 0;
+};
+
+class MapSyncTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    backend = new FakeMapBackend();
+    sync.reset(new MapSync<TestKey, TestValue>(
+        std::unique_ptr<MapBackend<TestKey, TestValue>>(backend),
+        [](const TestValue& desired, const TestValue& current) {
+          return desired.teid == current.teid;
+        }));
+  }
+
+  FakeMapBackend* backend;
+  std::unique_ptr<MapSync<TestKey, TestValue>> sync;
+};
+
+TEST_F(MapSyncTest, TestFlushBatchesWrites) {
+  for (uint32_t ip = 1; ip <= 100; ip++) {
+    sync->set({ip}, {ip + 1000, 0});
+  }
+  sync->erase({7});
+  EXPECT_EQ(sync->pending(), 100);
+  EXPECT_EQ(backend->entries.size(), 0);
+
+  EXPECT_EQ(sync->flush(), 0);
+  EXPECT_EQ(sync->pending(), 0);
+  EXPECT_EQ(backend->update_calls, 1);
+  EXPECT_EQ(backend->remove_calls, 1);
+  EXPECT_EQ(backend->entries.size(), 99);
+  EXPECT_EQ(backend->entries[42].teid, 1042);
+
+  // Nothing pending, nothing written
+  EXPECT_EQ(sync->flush(), 0);
+  EXPECT_EQ(backend->update_calls, 1);
+}
+
+TEST_F(MapSyncTest, TestLastWriteWins) {
+  sync->set({1}, {10, 0});
+  sync->erase({1});
+  sync->set({2}, {20, 0});
+  sync->set({2}, {21, 0});
+  EXPECT_EQ(sync->pending(), 2);
+  sync->flush();
+  EXPECT_EQ(backend->entries.count(1), 0);
+  EXPECT_EQ(backend->entries[2].teid, 21);
+}
+
+TEST_F(MapSyncTest, TestReconcile) {
+  backend->entries[1] = {10, 500};  // still active, keeps its counter
+  backend->entries[2] = {20, 600};  // active with a new tunnel
+  backend->entries[3] = {30, 700};  // released while the service was down
+
+  MapSync<TestKey, TestValue>::Entries desired;
+  desired[{1}] = {10, 0};
+  desired[{2}] = {21, 0};
+  desired[{4}] = {40, 0};
+  sync->set({5}, {50, 0});  // dropped, desired is the whole content
+
+  EXPECT_EQ(sync->reconcile(desired), 3);
+  EXPECT_EQ(sync->pending(), 0);
+  EXPECT_EQ(backend->entries.size(), 3);
+  EXPECT_EQ(backend->entries[1].bytes, 500);
+  EXPECT_EQ(backend->entries[2].teid, 21);
+  EXPECT_EQ(backend->entries.count(3), 0);
+  EXPECT_EQ(backend->entries[4].teid, 40);
+
+  // A second pass finds nothing to change
+  EXPECT_EQ(sync->reconcile(desired), 0);
+}
+
+TEST_F(MapSyncTest, TestReadAll) {
+  backend->entries[1] = {10, 500};
+  backend->entries[2] = {20, 600};
+  MapSync<TestKey, TestValue>::Entries entries;
+  EXPECT_EQ(sync->read_all(&entries), 0);
+  EXPECT_EQ(entries.size(), 2);
+  EXPECT_EQ(entries[{2}].bytes, 600);
+}
+
+}  // namespace ebpf
+}  // namespace magma
@@ -50,8 +50,9 @@ void AsyncEventdClient::log_event(
     const Event& request, std::function<void(Status status, Void)> callback) {
   auto local_response =
       new AsyncLocalResponse<Void>(std::move(callback), RESPONSE_TIMEOUT_SEC);
-  local_response->set_response_reader(std::move(
-      stub_->AsyncLogEvent(local_response->get_context(), request, &queue_)));
+  local_response->set_response_reader(
+      stub_->AsyncLogEvent(local_response->get_context(), request, &queue_),
+      this);
 }
 
 }  // namespace magma